@@ -178,6 +178,16 @@ typedef struct EbSvtIOFormat //former EbSvtEncInput
 
     EbColorFormat color_fmt;
     EbBitDepth    bit_depth;
+
+    // Hosts the 2 LSBs of 10bit input when compressed_ten_bit_format is set in the encoder
+    // configuration, luma / cb / cr then host the 8 MSBs. The LSBs of 4 consecutive samples are
+    // packed in one byte, the first sample in bits 7:6. Strides are in bytes.
+    uint8_t *luma_lsb;
+    uint8_t *cb_lsb;
+    uint8_t *cr_lsb;
+    uint32_t y_lsb_stride;
+    uint32_t cb_lsb_stride;
+    uint32_t cr_lsb_stride;
 } EbSvtIOFormat;
 
 typedef struct EbOperatingParametersInfo {
@@ -67,8 +67,9 @@ typedef enum ATTRIBUTE_PACKED {
 #define EB_BUFFERFLAG_SHOW_EXT 0x00000002 // signals that the packet contains a show existing frame at the end
 #define EB_BUFFERFLAG_HAS_TD 0x00000004 // signals that the packet contains a TD
 #define EB_BUFFERFLAG_IS_ALT_REF 0x00000008 // signals that the packet contains an ALT_REF frame
+#define EB_BUFFERFLAG_LAST_FRAGMENT 0x00000010 // signals the packet that ends the frame with tile group output
 #define EB_BUFFERFLAG_ERROR_MASK \
-    0xFFFFFFF0 // mask for signalling error assuming top flags fit in 4 bits. To be changed, if more flags are added.
+    0xFFFFFFE0 // mask for signalling error assuming top flags fit in 5 bits. To be changed, if more flags are added.
 
 /*
  * Struct for storing content light level information
@@ -151,6 +152,9 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    SVT_AV1_STREAM_INFO_MEMORY_USAGE, /**< info is a SvtAv1MemoryUsage */
+    SVT_AV1_STREAM_INFO_DEADLINE_STATS, /**< info is a SvtAv1DeadlineStats */
+    SVT_AV1_STREAM_INFO_CHECKPOINT, /**< info is a SvtAv1Checkpoint */
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
@@ -164,6 +168,104 @@ typedef struct SvtAv1FixedBuf {
     uint64_t sz; /**< Length of the buffer, in chars */
 } SvtAv1FixedBuf; /**< alias for struct aom_fixed_buf */
 
+#define SVT_AV1_MAX_MEMORY_POOLS 16
+
+/*!\brief Memory held by one group of encoder buffers
+ */
+typedef struct SvtAv1MemoryPoolUsage {
+    const char *name; /**< Name of the pool, e.g. "reference" */
+    uint32_t    total_count; /**< Number of objects allocated in the pool so far */
+    uint32_t    in_use_count; /**< Number of objects currently held by the pipeline */
+    uint64_t    bytes; /**< Memory allocated for the whole pool, in bytes */
+} SvtAv1MemoryPoolUsage;
+
+/*!\brief Memory usage of an encoder instance, returned by
+ * svt_av1_enc_get_stream_info() with SVT_AV1_STREAM_INFO_MEMORY_USAGE
+ * once svt_av1_enc_init() has been called.
+ */
+typedef struct SvtAv1MemoryUsage {
+    uint64_t              total_bytes; /**< Memory allocated by the encoder so far, in bytes */
+    uint64_t              estimated_bytes; /**< Estimate used to size the pools, in bytes */
+    uint64_t              budget_bytes; /**< max_memory_mb in bytes, 0 if no budget is set */
+    uint32_t              pool_count; /**< Number of valid entries in pools */
+    SvtAv1MemoryPoolUsage pools[SVT_AV1_MAX_MEMORY_POOLS];
+} SvtAv1MemoryUsage;
+
+/* Pipeline stages timed by the deadline mode, see SvtAv1DeadlineStats */
+typedef enum SvtAv1DeadlineStage {
+    SVT_AV1_DEADLINE_STAGE_LOOKAHEAD, /**< Input to picture decision, i.e. waiting for the lookahead */
+    SVT_AV1_DEADLINE_STAGE_MOTION, /**< Temporal filtering and motion estimation */
+    SVT_AV1_DEADLINE_STAGE_RATE_CONTROL, /**< TPL and rate control, incl. waiting for the references */
+    SVT_AV1_DEADLINE_STAGE_ENCODE, /**< Mode decision and encode */
+    SVT_AV1_DEADLINE_STAGE_POST, /**< In-loop filters, entropy coding and packetization */
+    SVT_AV1_DEADLINE_STAGES
+} SvtAv1DeadlineStage;
+
+/*!\brief Speed adaptation report of the deadline mode, returned by
+ * svt_av1_enc_get_stream_info() with SVT_AV1_STREAM_INFO_DEADLINE_STATS.
+ * All fields are 0 when the deadline mode is off.
+ */
+typedef struct SvtAv1DeadlineStats {
+    double   target_fps; /**< deadline_fps_numerator / deadline_fps_denominator */
+    double   achieved_fps; /**< Pictures output per second of wall-clock time since the first picture */
+    double   average_preset; /**< Average preset of the output pictures */
+    uint64_t frame_count; /**< Number of pictures output, overlays excluded */
+    uint32_t speed_changes; /**< Number of times the speed was changed */
+    /** Number of pictures coded at each preset, index 0 is ENC_MR */
+    uint64_t preset_frame_count[MAX_ENC_PRESET + 2];
+    /** Average wall-clock time spent by a picture in each SvtAv1DeadlineStage, in ms */
+    double stage_ms[SVT_AV1_DEADLINE_STAGES];
+} SvtAv1DeadlineStats;
+
+/*!\brief Encoder state at a key frame, returned by svt_av1_enc_get_stream_info() with
+ * SVT_AV1_STREAM_INFO_CHECKPOINT for the last key frame returned by svt_av1_enc_get_packet().
+ * An encoder created with the same configuration and resume_checkpoint set to the state, and fed
+ * the input from picture_number on, continues the stream from the key frame on: its packets are
+ * the ones of the key frame and of the pictures after it, to be written at byte_offset.
+ * Only closed GOP key frames (intra_refresh_type SVT_AV1_KF_REFRESH) are checkpointed.
+ */
+typedef struct SvtAv1Checkpoint {
+    uint64_t picture_number; /**< Display order number of the key frame in the stream */
+    uint64_t byte_offset; /**< Size of the packets of the stream before the key frame */
+    /** Opaque state, owned by the encoder and valid until the next svt_av1_enc_get_packet() */
+    SvtAv1FixedBuf state;
+} SvtAv1Checkpoint;
+
+/*!\brief Statistics of one coded picture, passed to picture_stats_cb as soon as the picture is
+ * entropy coded, which is close to but not always in coding order. Times are wall-clock.
+ */
+typedef struct SvtAv1PictureStats {
+    uint64_t         picture_number; /**< Display order number of the picture in the stream */
+    uint64_t         decode_order; /**< Coding order number of the picture */
+    int64_t          pts; /**< pts of the input picture */
+    EbAv1PictureType pic_type; /**< Same as pic_type of the output buffer */
+    uint8_t          temporal_layer; /**< Temporal layer index, 0 is the base layer */
+    uint8_t          show_frame; /**< 0 for the pictures shown later, e.g. alt-refs */
+    uint8_t          is_overlay; /**< Overlay coded in addition to the input picture */
+    int8_t           enc_mode; /**< Preset the picture was coded at */
+    uint8_t          qindex; /**< Base qindex of the frame header, [0-255] */
+    uint8_t          qp; /**< Same as qp of the output buffer, [0-63] */
+    uint8_t          recode_count; /**< Number of times the picture was coded again */
+    uint8_t          tpl_valid; /**< 1 when the TPL ran on the picture and tpl_r0 is set */
+    uint64_t         bits; /**< Size of the frame OBUs of the picture, in bits */
+    int64_t          target_bits; /**< Frame target of the rate control, 0 when there is none */
+    double           tpl_r0; /**< TPL ratio of the intra cost to the propagated cost, lower is more referenced */
+    uint64_t         me_distortion; /**< Average ME distortion of the 64x64 blocks, 0 on intra pictures */
+    /** Number of references of the picture in each list, 0 on intra pictures */
+    uint8_t ref_count[2];
+    /** Display order numbers of the references, ref_count[list] valid entries per list */
+    uint64_t ref_picture_number[2][REF_LIST_MAX_DEPTH];
+    /** Time from the input of the picture to the end of its entropy coding, in microseconds */
+    uint64_t latency_us;
+    /** Time spent by the picture in each SvtAv1DeadlineStage, in microseconds */
+    uint64_t stage_us[SVT_AV1_DEADLINE_STAGES];
+} SvtAv1PictureStats;
+
+/*!\brief Callback receiving the SvtAv1PictureStats of each coded picture. It is called from an
+ * encoder thread, one picture at a time, and must return quickly: the pictures after it wait.
+ * stats is only valid during the call. */
+typedef void (*SvtAv1PictureStatsCallback)(const SvtAv1PictureStats *stats, void *user_data);
+
 /** Indicates how an S-Frame should be inserted.
 */
 typedef enum EbSFrameMode {
@@ -954,8 +1056,79 @@ typedef struct EbSvtAv1EncConfiguration {
      *  Default is 6 */
     uint8_t variance_octile;
 
+    /* @brief Memory budget of the encoder, in MiB
+     * The pipeline depth, the pool sizes, the lookahead and the TPL lookahead are reduced
+     * until the estimated memory of the encoder fits the budget. svt_av1_enc_init() fails with
+     * EB_ErrorInsufficientResources if the smallest configuration still does not fit. The
+     * memory actually allocated can be read back with SVT_AV1_STREAM_INFO_MEMORY_USAGE.
+     * 0 = no budget
+     * Default is 0. */
+    uint32_t max_memory_mb;
+
+    /* @brief Wall-clock deadline mode, target output frame rate as a fraction
+     * The preset of each picture is adapted at mini-GOP boundaries to hold the
+     * encoding speed at the target: preset (enc_mode) is the slowest preset used and
+     * deadline_max_preset the fastest. The adaptation can be read back with
+     * SVT_AV1_STREAM_INFO_DEADLINE_STATS. Only available in single pass.
+     * 0 = off
+     * Default is 0. */
+    uint32_t deadline_fps_numerator;
+    uint32_t deadline_fps_denominator;
+
+    /* @brief Fastest preset the deadline mode can switch to, mapped like the preset:
+     * presets above 11 run preset 11, and 10 for 4K and higher in random access
+     * Default is MAX_ENC_PRESET. */
+    uint8_t deadline_max_preset;
+
+    /* @brief 10bit input in the split format of the encoder: 8 MSBs in luma / cb / cr and the
+     * compressed 2 LSBs in luma_lsb / cb_lsb / cr_lsb of EbSvtIOFormat, which is copied as is
+     * instead of being unpacked from 16-bit samples. n_filled_len of the input buffer then counts
+     * 1.25 bytes per sample. Only available with encoder_bit_depth 10.
+     * Default is 0. */
+    uint8_t compressed_ten_bit_format;
+
+    /* @brief In-frame rate control of CBR: the qindex of each superblock is moved during
+     * encoding from the bits spent so far against the bits predicted from the motion
+     * complexity, to hold the frame target within the level of the rate control buffer.
+     * The frame is recoded only when it still overflows the buffer.
+     * Only available with rate_control_mode CBR.
+     * Default is 0. */
+    uint8_t sb_rate_control;
+
+    /* @brief Sub-frame output for low-delay: the frame header and the tiles are sent in separate
+     * tile group OBUs, each output as a packet as soon as the tiles it holds are entropy coded, in
+     * tile order. The last packet of a frame carries EB_BUFFERFLAG_LAST_FRAGMENT. Use tile rows
+     * or columns to set the granularity: with a single tile, each frame is still one packet.
+     * Only available with the low-delay prediction structures.
+     * Default is 0. */
+    uint8_t tile_group_output;
+
+    /* @brief Pipelined two pass for 1-pass VBR: a first pass encoder runs in its own threads on
+     * the same input, ahead of the final encode by the lookahead distance, and its frame sizes
+     * feed the look-ahead rate control instead of the motion estimation estimates. The lookahead
+     * distance sets the window of first pass statistics the rate control sees.
+     * Only available with rate_control_mode VBR in single pass.
+     * Default is 0. */
+    uint8_t pipelined_two_pass;
+
+    /* @brief State of a SvtAv1Checkpoint to resume the stream from. The encoder codes the input
+     * it is sent as the pictures from the checkpoint key frame on. The configuration must be the
+     * one of the checkpointed encoder. The buffer must be valid until svt_av1_enc_init() returns.
+     * Not available with max_bit_rate or pipelined_two_pass.
+     * Default is empty. */
+    SvtAv1FixedBuf resume_checkpoint;
+
+    /* @brief Callback called with the SvtAv1PictureStats of each picture as soon as it is
+     * entropy coded, with picture_stats_user_data. Collecting the statistics costs a few clock
+     * reads per picture, so it can be left on.
+     * Default is NULL. */
+    SvtAv1PictureStatsCallback picture_stats_cb;
+    void                      *picture_stats_user_data;
+
     /*Add 128 Byte Padding to Struct to avoid changing the size of the public configuration struct*/
-    uint8_t padding[128 - sizeof(Bool) - 2 * sizeof(uint8_t)];
+    /* 1 byte of the padding is taken by the alignment of max_memory_mb, 3 by the one of resume_checkpoint */
+    uint8_t padding[128 - sizeof(Bool) - 7 * sizeof(uint8_t) - 1 - 3 * sizeof(uint32_t) - 3 - sizeof(SvtAv1FixedBuf) -
+                    sizeof(SvtAv1PictureStatsCallback) - sizeof(void *)];
 
 } EbSvtAv1EncConfiguration;
 
@@ -993,6 +1166,30 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
     EbSvtAv1EncConfiguration
         *pComponentParameterStructure); // pComponentParameterStructure contents will be copied to the library
 
+/**
+ * Allocator of the output packet buffers
+ * The encoder writes each packet (p_buffer of the EbBufferHeaderType returned by
+ * svt_av1_enc_get_packet) into a buffer taken from the caller, and gives it back with release
+ * once the packet is released with svt_av1_enc_release_out_buffer, or dropped by the encoder.
+ * Both callbacks can be called from the encoder threads.
+ */
+typedef struct SvtAv1OutputBufferAllocator {
+    /* Returns a buffer of at least size bytes, or NULL when out of memory */
+    uint8_t *(*alloc)(void *context, uint32_t size);
+    /* Takes back a buffer returned by alloc */
+    void (*release)(void *context, uint8_t *buffer);
+    /* Passed back to both callbacks */
+    void *context;
+} SvtAv1OutputBufferAllocator;
+
+/* OPTIONAL: Use caller memory for the output packets, must be called before svt_av1_enc_init.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *allocator          Callbacks, copied to the library. NULL restores the internal allocator. */
+EB_API EbErrorType svt_av1_enc_set_output_buffer_allocator(EbComponentType                   *svt_enc_component,
+                                                           const SvtAv1OutputBufferAllocator *allocator);
+
 /* OPTIONAL: Set a single configuration parameter.
      *
      * Parameter:
@@ -1023,6 +1220,8 @@ EB_API EbErrorType svt_av1_enc_stream_header(EbComponentType     *svt_enc_compon
 EB_API EbErrorType svt_av1_enc_stream_header_release(EbBufferHeaderType *stream_header_ptr);
 
 /* STEP 4: Send the picture.
+     * Returns EB_ErrorInsufficientResources once the encoder stopped because a picture buffer could
+     * not be allocated, svt_av1_enc_get_packet() then returns EB_ErrorMax.
      *
      * Parameter:
      * @ *svt_enc_component  Encoder handler.
@@ -1064,6 +1263,7 @@ EB_API EbErrorType svt_av1_get_recon(EbComponentType *svt_enc_component, EbBuffe
 EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *svt_enc_component, uint32_t stream_info_id, void *info);
 
 /* STEP 6: Deinitialize encoder library.
+     * Returns EB_ErrorMax when the encoder stopped on an error, its threads are joined all the same.
      *
      * Parameter:
      * @ *svt_enc_component  Encoder handler. */
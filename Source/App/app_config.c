@@ -20,6 +20,7 @@
 #include "app_config.h"
 #include "app_context.h"
 #include "app_input_y4m.h"
+#include "app_input_synthetic.h"
 #ifdef _WIN32
 #include <windows.h>
 #include <io.h>
@@ -40,7 +41,7 @@
 #define HELP_TOKEN "--help"
 #define VERSION_TOKEN "--version"
 #define CHANNEL_NUMBER_TOKEN "--nch"
-#define COMMAND_LINE_MAX_SIZE 2048
+#define JOBS_FILE_TOKEN "--jobs"
 #define CONFIG_FILE_TOKEN "-c"
 #define CONFIG_FILE_LONG_TOKEN "--config"
 #define INPUT_FILE_TOKEN "-i"
@@ -53,6 +54,7 @@
 #define TWO_PASS_STATS_TOKEN "--stats"
 #define PASSES_TOKEN "--passes"
 #define STAT_FILE_TOKEN "--stat-file"
+#define PICTURE_STATS_FILE_TOKEN "--picture-stats-file"
 #define WIDTH_TOKEN "-w"
 #define HEIGHT_TOKEN "-h"
 #define NUMBER_OF_PICTURES_TOKEN "-n"
@@ -131,9 +133,12 @@
 #define BUFFER_INITIAL_SIZE_TOKEN "--buf-initial-sz"
 #define BUFFER_OPTIMAL_SIZE_TOKEN "--buf-optimal-sz"
 #define RECODE_LOOP_TOKEN "--recode-loop"
+#define SB_RATE_CONTROL_TOKEN "--sb-rate-control"
+#define PIPELINED_TWO_PASS_TOKEN "--pipelined-two-pass"
 #define ENABLE_TPL_LA_TOKEN "--enable-tpl-la"
 #define TILE_ROW_TOKEN "--tile-rows"
 #define TILE_COL_TOKEN "--tile-columns"
+#define TILE_GROUP_OUTPUT_TOKEN "--tile-group-output"
 
 #define SCENE_CHANGE_DETECTION_TOKEN "--scd"
 #define INJECTOR_TOKEN "--inj" // no Eval
@@ -142,6 +147,9 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define MAX_MEMORY_TOKEN "--max-memory"
+#define DEADLINE_FPS_TOKEN "--deadline-fps"
+#define DEADLINE_MAX_PRESET_TOKEN "--deadline-max-preset"
 #define RESTRICTED_MOTION_VECTOR "--rmv"
 
 //double dash
@@ -161,6 +169,11 @@
 #define ADAPTIVE_QP_ENABLE_NEW_TOKEN "--aq-mode"
 #define INPUT_FILE_LONG_TOKEN "--input"
 #define OUTPUT_BITSTREAM_LONG_TOKEN "--output"
+#define OUTPUT_FORMAT_TOKEN "--output-format"
+#define CHECKPOINT_TOKEN "--checkpoint"
+#define RESUME_TOKEN "--resume"
+#define SYNTHETIC_INPUT_TOKEN "--synthetic-input"
+#define SOAK_INTERVAL_TOKEN "--soak-interval"
 #define OUTPUT_RECON_LONG_TOKEN "--recon"
 #define WIDTH_LONG_TOKEN "--width"
 #define HEIGHT_LONG_TOKEN "--height"
@@ -197,10 +210,20 @@
 #define VARIANCE_BOOST_STRENGTH_TOKEN "--variance-boost-strength"
 #define VARIANCE_OCTILE_TOKEN "--variance-octile"
 
+#ifdef _WIN32
+static __declspec(thread) FILE *console_stream;
+#else
+static __thread FILE *console_stream;
+#endif
+
+FILE *app_console(void) { return console_stream ? console_stream : stderr; }
+
+void set_app_console(FILE *stream) { console_stream = stream; }
+
 static EbErrorType validate_error(EbErrorType err, const char *token, const char *value) {
     switch (err) {
     case EB_ErrorNone: return EB_ErrorNone;
-    default: fprintf(stderr, "Error: Invalid parameter '%s' with value '%s'\n", token, value); return err;
+    default: fprintf(app_console(), "Error: Invalid parameter '%s' with value '%s'\n", token, value); return err;
     }
 }
 
@@ -236,7 +259,7 @@ static EbErrorType str_to_uint(const char *token, const char *nptr, uint32_t *ou
     uint32_t val;
 
     if (strtol(nptr, NULL, 0) < 0) {
-        fprintf(stderr,
+        fprintf(app_console(),
                 "Error: Invalid parameter '%s' with value '%s'. Token unable to accept negative "
                 "values\n",
                 token,
@@ -295,7 +318,7 @@ static Bool fopen_and_lock(FILE **file, const char *name, Bool write) {
     if (flock(fd, LOCK_EX | LOCK_NB) == 0)
         return TRUE;
 #endif
-    fprintf(stderr, "ERROR: locking %s failed, is it used by other encoder?\n", name);
+    fprintf(app_console(), "ERROR: locking %s failed, is it used by other encoder?\n", name);
     return FALSE;
 }
 
@@ -365,14 +388,38 @@ static EbErrorType set_cfg_stream_file(EbConfig *cfg, const char *token, const c
         cfg->bitstream_file = stdout;
         return EB_ErrorNone;
     }
-    return open_file(&cfg->bitstream_file, token, value, "wb");
+    // an explicit --output-format takes precedence over the extension
+    const char *ext = strrchr(value, '.');
+    if (ext && cfg->output_format == OUTPUT_FORMAT_AUTO) {
+        if (!strcmp(ext, ".obu"))
+            cfg->output_format = OUTPUT_FORMAT_OBU;
+        else if (!strcmp(ext, ".mp4") || !strcmp(ext, ".m4s") || !strcmp(ext, ".cmfv"))
+            cfg->output_format = OUTPUT_FORMAT_MP4;
+    }
+    // a resumed stream is written over the output of the checkpointed encode, from the key frame on
+    return open_file(&cfg->bitstream_file, token, value, cfg->resume ? "r+b" : "wb");
+}
+static EbErrorType set_cfg_output_format(EbConfig *cfg, const char *token, const char *value) {
+    if (!strcmp(value, "ivf"))
+        cfg->output_format = OUTPUT_FORMAT_IVF;
+    else if (!strcmp(value, "obu"))
+        cfg->output_format = OUTPUT_FORMAT_OBU;
+    else if (!strcmp(value, "annexb"))
+        cfg->output_format = OUTPUT_FORMAT_ANNEXB;
+    else if (!strcmp(value, "mp4"))
+        cfg->output_format = OUTPUT_FORMAT_MP4;
+    else {
+        fprintf(app_console(), "Error: Invalid value %s for %s, expected ivf, obu, annexb or mp4\n", value, token);
+        return EB_ErrorBadParameter;
+    }
+    return EB_ErrorNone;
 }
 static EbErrorType set_cfg_error_file(EbConfig *cfg, const char *token, const char *value) {
     if (!strcmp(value, "stderr")) {
-        if (cfg->error_log_file && cfg->error_log_file != stderr) {
+        if (cfg->error_log_file && cfg->error_log_file != app_console()) {
             fclose(cfg->error_log_file);
         }
-        cfg->error_log_file = stderr;
+        cfg->error_log_file = app_console();
         return EB_ErrorNone;
     }
     return open_file(&cfg->error_log_file, token, value, "w+");
@@ -386,6 +433,9 @@ static EbErrorType set_cfg_qp_file(EbConfig *cfg, const char *token, const char
 static EbErrorType set_cfg_stat_file(EbConfig *cfg, const char *token, const char *value) {
     return open_file(&cfg->stat_file, token, value, "wb");
 }
+static EbErrorType set_cfg_picture_stats_file(EbConfig *cfg, const char *token, const char *value) {
+    return open_file(&cfg->picture_stats_file, token, value, "wb");
+}
 static EbErrorType set_cfg_roi_map_file(EbConfig *cfg, const char *token, const char *value) {
     return open_file(&cfg->roi_map_file, token, value, "r");
 }
@@ -401,6 +451,24 @@ static EbErrorType set_cfg_fgs_table_path(EbConfig *cfg, const char *token, cons
     return EB_ErrorNone;
 }
 
+static EbErrorType set_cfg_checkpoint(EbConfig *cfg, const char *token, const char *value) {
+    return str_to_str(value, (char **)&cfg->checkpoint, token);
+}
+static EbErrorType set_cfg_resume(EbConfig *cfg, const char *token, const char *value) {
+    return str_to_str(value, (char **)&cfg->resume, token);
+}
+static EbErrorType set_cfg_synthetic_input(EbConfig *cfg, const char *token, const char *value) {
+    uint32_t    enable = 0;
+    EbErrorType ret    = str_to_uint(token, value, &enable);
+    if (ret == EB_ErrorNone && enable > 1)
+        return validate_error(EB_ErrorBadParameter, token, value);
+    cfg->synthetic_input = enable;
+    return ret;
+}
+static EbErrorType set_cfg_soak_interval(EbConfig *cfg, const char *token, const char *value) {
+    return str_to_uint(token, value, &cfg->soak_interval);
+}
+
 static EbErrorType set_two_pass_stats(EbConfig *cfg, const char *token, const char *value) {
     return str_to_str(value, (char **)&cfg->stats, token);
 }
@@ -413,6 +481,14 @@ static EbErrorType set_passes(EbConfig *cfg, const char *token, const char *valu
     return EB_ErrorNone;
 }
 
+static EbErrorType set_jobs_file(EbConfig *cfg, const char *token, const char *value) {
+    (void)cfg;
+    (void)token;
+    (void)value;
+    /* empty function, the job file is handled at higher level*/
+    return EB_ErrorNone;
+}
+
 static EbErrorType set_cfg_frames_to_be_encoded(EbConfig *cfg, const char *token, const char *value) {
     return str_to_int64(token, value, &cfg->frames_to_be_encoded);
 }
@@ -466,7 +542,7 @@ static EbErrorType set_cfg_force_key_frames(EbConfig *cfg, const char *token, co
     svt_av1_enc_parse_parameter(&cfg->config, "enable-force-key-frames", "true");
     return EB_ErrorNone;
 err:
-    fputs("Error parsing forced key frames list\n", stderr);
+    fputs("Error parsing forced key frames list\n", app_console());
     for (size_t i = 0; i < fkf.count; ++i) free(fkf.specifiers[i]);
     free(fkf.specifiers);
     return EB_ErrorBadParameter;
@@ -551,7 +627,7 @@ static EbErrorType parse_svtav1_params(EbConfig *cfg, const char *token, const c
             continue;
         err = (EbErrorType)(err | svt_av1_enc_parse_parameter(&cfg->config, opt.key, opt.val));
         if (err != EB_ErrorNone) {
-            fprintf(stderr, "Warning: failed to set parameter '%s' with key '%s'\n", opt.key, opt.val);
+            fprintf(app_console(), "Warning: failed to set parameter '%s' with key '%s'\n", opt.key, opt.val);
         }
         free(opt.key);
         free(opt.val);
@@ -625,12 +701,34 @@ ConfigEntry config_entry_options[] = {
 
     {SINGLE_INPUT,
      OUTPUT_BITSTREAM_TOKEN,
-     "Output compressed (ivf) file path, use `stdout` or `-` to write to pipe",
+     "Output compressed file path, use `stdout` or `-` to write to pipe",
      set_cfg_stream_file},
     {SINGLE_INPUT,
      OUTPUT_BITSTREAM_LONG_TOKEN,
-     "Output compressed (ivf) file path, use `stdout` or `-` to write to pipe",
+     "Output compressed file path, use `stdout` or `-` to write to pipe",
      set_cfg_stream_file},
+    {SINGLE_INPUT,
+     OUTPUT_FORMAT_TOKEN,
+     "Output container, default is taken from the output file extension (.obu, .mp4/.m4s/.cmfv), ivf "
+     "otherwise [ivf, obu: Section 5 obus, annexb: Annex B length delimited obus, mp4: fragmented mp4]",
+     set_cfg_output_format},
+    {SINGLE_INPUT,
+     CHECKPOINT_TOKEN,
+     "Checkpoint file path, rewritten with the encoder state at each key frame, ivf output and closed GOP only",
+     set_cfg_checkpoint},
+    {SINGLE_INPUT,
+     RESUME_TOKEN,
+     "Checkpoint file path to resume the encode from, with the same options, input and output file",
+     set_cfg_resume},
+    {SINGLE_INPUT,
+     SYNTHETIC_INPUT_TOKEN,
+     "Encode generated frames of gradients, noise and text with scene cuts in place of `-i`, needs `-w`, "
+     "`-h` and `-n`, default is 0 [0-1]",
+     set_cfg_synthetic_input},
+    {SINGLE_INPUT,
+     SOAK_INTERVAL_TOKEN,
+     "Print the speed and the memory use every `n` seconds, default is 0 [0: off, 1-`(2^32)-1`]",
+     set_cfg_soak_interval},
 
     {SINGLE_INPUT, CONFIG_FILE_TOKEN, "Configuration file path", set_cfg_input_file},
     {SINGLE_INPUT, CONFIG_FILE_LONG_TOKEN, "Configuration file path", set_cfg_input_file},
@@ -643,6 +741,10 @@ ConfigEntry config_entry_options[] = {
      STAT_FILE_TOKEN,
      "PSNR / SSIM per picture stat output file path, requires `--enable-stat-report 1`",
      set_cfg_stat_file},
+    {SINGLE_INPUT,
+     PICTURE_STATS_FILE_TOKEN,
+     "Per picture timing, size, qindex, references and recode count output file path, in csv",
+     set_cfg_picture_stats_file},
 
     {SINGLE_INPUT,
      PROGRESS_TOKEN,
@@ -664,6 +766,12 @@ ConfigEntry config_entry_options[] = {
      "colon separated list of key=value pairs of parameters with keys based on config file options",
      parse_svtav1_params},
 
+    {SINGLE_INPUT,
+     JOBS_FILE_TOKEN,
+     "Job file path, one encode per line given by its command line options. The other options apply to "
+     "every job and `--nch` sets the number of jobs encoded at the same time",
+     set_jobs_file},
+
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
 ConfigEntry config_entry_global_options[] = {
@@ -789,6 +897,21 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     MAX_MEMORY_TOKEN,
+     "Approximate memory budget in MB, buffering and lookahead are reduced to fit. Refer to "
+     "Appendix A.1 of the user guide, default is 0 [0: unlimited, 1-2^32-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     DEADLINE_FPS_TOKEN,
+     "Target encoding speed in frames per second, e.g. 30, 29.97 or 30000/1001. The preset of each "
+     "mini-GOP is adapted between " PRESET_TOKEN " and " DEADLINE_MAX_PRESET_TOKEN " to hold it. Refer to "
+     "Appendix A.1 of the user guide, default is 0 [0: off]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     DEADLINE_MAX_PRESET_TOKEN,
+     "Fastest preset used by " DEADLINE_FPS_TOKEN ", default is 13 [preset-13]",
+     set_cfg_generic_token},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -908,6 +1031,16 @@ ConfigEntry config_entry_rc[] = {
      "Recode loop level, refer to \"Recode loop level table\" in the user guide for more info [0: "
      "off, 4: preset based]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     SB_RATE_CONTROL_TOKEN,
+     "Adapt the superblock qindex during encoding to hold the frame target in the buffer, only "
+     "applicable for CBR, default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     PIPELINED_TWO_PASS_TOKEN,
+     "Run a first pass ahead of the encode by the lookahead distance to feed the rate control, only "
+     "applicable for 1-pass VBR, default is 0 [0-1]",
+     set_cfg_generic_token},
 #if !SVT_AV1_CHECK_VERSION(2, 0, 0)
     /* DEPRECATED: to be removed in 2.0.0. */
     {SINGLE_INPUT,
@@ -1008,6 +1141,11 @@ ConfigEntry config_entry_specific[] = {
      "Number of tile columns to use, `TileCol == log2(x)`, default changes per resolution but is 1 "
      "[0-4]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     TILE_GROUP_OUTPUT_TOKEN,
+     "Output each tile group as soon as it is entropy coded, only applicable for low delay, default "
+     "is 0 [0-1]",
+     set_cfg_generic_token},
 
     // DLF
     {SINGLE_INPUT, LOOP_FILTER_ENABLE, "Deblocking loop filter control, default is 1 [0-1]", set_cfg_generic_token},
@@ -1190,12 +1328,19 @@ ConfigEntry config_entry[] = {
     // Options
     {SINGLE_INPUT, INPUT_FILE_TOKEN, "InputFile", set_cfg_input_file},
     {SINGLE_INPUT, INPUT_FILE_LONG_TOKEN, "InputFile", set_cfg_input_file},
+    // before the output file, opened for update when resuming
+    {SINGLE_INPUT, RESUME_TOKEN, "Resume", set_cfg_resume},
     {SINGLE_INPUT, OUTPUT_BITSTREAM_TOKEN, "StreamFile", set_cfg_stream_file},
     {SINGLE_INPUT, OUTPUT_BITSTREAM_LONG_TOKEN, "StreamFile", set_cfg_stream_file},
+    {SINGLE_INPUT, OUTPUT_FORMAT_TOKEN, "OutputFormat", set_cfg_output_format},
+    {SINGLE_INPUT, CHECKPOINT_TOKEN, "Checkpoint", set_cfg_checkpoint},
+    {SINGLE_INPUT, SYNTHETIC_INPUT_TOKEN, "SyntheticInput", set_cfg_synthetic_input},
+    {SINGLE_INPUT, SOAK_INTERVAL_TOKEN, "SoakInterval", set_cfg_soak_interval},
     {SINGLE_INPUT, ERROR_FILE_TOKEN, "ErrorFile", set_cfg_error_file},
     {SINGLE_INPUT, OUTPUT_RECON_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, OUTPUT_RECON_LONG_TOKEN, "ReconFile", set_cfg_recon_file},
     {SINGLE_INPUT, STAT_FILE_TOKEN, "StatFile", set_cfg_stat_file},
+    {SINGLE_INPUT, PICTURE_STATS_FILE_TOKEN, "PictureStatsFile", set_cfg_picture_stats_file},
     {SINGLE_INPUT, PROGRESS_TOKEN, "Progress", set_progress},
     {SINGLE_INPUT, NO_PROGRESS_TOKEN, "NoProgress", set_no_progress},
     {SINGLE_INPUT, PRESET_TOKEN, "EncoderMode", set_cfg_generic_token},
@@ -1244,6 +1389,9 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_cfg_generic_token},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_cfg_generic_token},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_cfg_generic_token},
+    {SINGLE_INPUT, MAX_MEMORY_TOKEN, "MaxMemory", set_cfg_generic_token},
+    {SINGLE_INPUT, DEADLINE_FPS_TOKEN, "DeadlineFps", set_cfg_generic_token},
+    {SINGLE_INPUT, DEADLINE_MAX_PRESET_TOKEN, "DeadlineMaxPreset", set_cfg_generic_token},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_cfg_generic_token},
@@ -1281,6 +1429,8 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, BUFFER_INITIAL_SIZE_TOKEN, "BufInitialSz", set_cfg_generic_token},
     {SINGLE_INPUT, BUFFER_OPTIMAL_SIZE_TOKEN, "BufOptimalSz", set_cfg_generic_token},
     {SINGLE_INPUT, RECODE_LOOP_TOKEN, "RecodeLoop", set_cfg_generic_token},
+    {SINGLE_INPUT, SB_RATE_CONTROL_TOKEN, "SbRateControl", set_cfg_generic_token},
+    {SINGLE_INPUT, PIPELINED_TWO_PASS_TOKEN, "PipelinedTwoPass", set_cfg_generic_token},
 #if !SVT_AV1_CHECK_VERSION(2, 0, 0)
     /* DEPRECATED: to be removed in 2.0.0. */
     {SINGLE_INPUT, VBR_BIAS_PCT_TOKEN, "VBRBiasPct", set_cfg_generic_token},
@@ -1308,6 +1458,7 @@ ConfigEntry config_entry[] = {
     // AV1 Specific Options
     {SINGLE_INPUT, TILE_ROW_TOKEN, "TileRow", set_cfg_generic_token},
     {SINGLE_INPUT, TILE_COL_TOKEN, "TileCol", set_cfg_generic_token},
+    {SINGLE_INPUT, TILE_GROUP_OUTPUT_TOKEN, "TileGroupOutput", set_cfg_generic_token},
     {SINGLE_INPUT, LOOP_FILTER_ENABLE, "LoopFilterEnable", set_cfg_generic_token},
     {SINGLE_INPUT, CDEF_ENABLE_TOKEN, "CDEFLevel", set_cdef_enable},
     {SINGLE_INPUT, ENABLE_RESTORATION_TOKEN, "EnableRestoration", set_cfg_generic_token},
@@ -1375,7 +1526,7 @@ EbConfig *svt_config_ctor() {
     EbConfig *app_cfg = (EbConfig *)calloc(1, sizeof(EbConfig));
     if (!app_cfg)
         return NULL;
-    app_cfg->error_log_file      = stderr;
+    app_cfg->error_log_file      = app_console();
     app_cfg->buffered_input      = -1;
     app_cfg->progress            = 1;
     app_cfg->injector_frame_rate = 60;
@@ -1399,8 +1550,10 @@ void svt_config_dtor(EbConfig *app_cfg) {
     }
 
     if (app_cfg->bitstream_file) {
-        if (!fseek(app_cfg->bitstream_file, 0, SEEK_SET))
-            write_ivf_stream_header(app_cfg, app_cfg->frames_encoded);
+        // update the frame count of the ivf header
+        if ((app_cfg->output_format == OUTPUT_FORMAT_AUTO || app_cfg->output_format == OUTPUT_FORMAT_IVF) &&
+            !fseek(app_cfg->bitstream_file, 0, SEEK_SET))
+            write_ivf_stream_header(app_cfg, app_cfg->frames_encoded + (int32_t)app_cfg->resume_picture_number);
         fclose(app_cfg->bitstream_file);
         app_cfg->bitstream_file = (FILE *)NULL;
     }
@@ -1410,7 +1563,7 @@ void svt_config_dtor(EbConfig *app_cfg) {
         app_cfg->recon_file = (FILE *)NULL;
     }
 
-    if (app_cfg->error_log_file && app_cfg->error_log_file != stderr) {
+    if (app_cfg->error_log_file && app_cfg->error_log_file != app_console()) {
         fclose(app_cfg->error_log_file);
         app_cfg->error_log_file = (FILE *)NULL;
     }
@@ -1425,6 +1578,11 @@ void svt_config_dtor(EbConfig *app_cfg) {
         app_cfg->stat_file = (FILE *)NULL;
     }
 
+    if (app_cfg->picture_stats_file) {
+        fclose(app_cfg->picture_stats_file);
+        app_cfg->picture_stats_file = (FILE *)NULL;
+    }
+
     if (app_cfg->output_stat_file) {
         fclose(app_cfg->output_stat_file);
         app_cfg->output_stat_file = (FILE *)NULL;
@@ -1443,8 +1601,13 @@ void svt_config_dtor(EbConfig *app_cfg) {
     for (size_t i = 0; i < app_cfg->forced_keyframes.count; ++i) free(app_cfg->forced_keyframes.specifiers[i]);
     free(app_cfg->forced_keyframes.specifiers);
     free(app_cfg->forced_keyframes.frames);
+    free(app_cfg->fragment_buffer);
 
     free((void *)app_cfg->stats);
+    free((void *)app_cfg->checkpoint);
+    free((void *)app_cfg->resume);
+    free(app_cfg->resume_state.buf);
+    synthetic_source_destroy(app_cfg->synthetic_source);
     free(app_cfg);
     return;
 }
@@ -1566,12 +1729,12 @@ static char *read_word(FILE *fp) {
 static EbErrorType set_config_value(EbConfig *app_cfg, const char *word, const char *value, unsigned instance_idx) {
     const ConfigEntry *entry = find_entry(word);
     if (!entry) {
-        fprintf(stderr, "Error channel %u: Config File contains unknown token %s\n", instance_idx + 1, word);
+        fprintf(app_console(), "Error channel %u: Config File contains unknown token %s\n", instance_idx + 1, word);
         return EB_ErrorBadParameter;
     }
     const EbErrorType err = entry->scf(app_cfg, entry->token, value);
     if (err != EB_ErrorNone) {
-        fprintf(stderr,
+        fprintf(app_console(),
                 "Error channel %u: Config File contains invalid value %s for token %s\n",
                 instance_idx + 1,
                 value,
@@ -1590,7 +1753,7 @@ static EbErrorType read_config_file(EbConfig *app_cfg, const char *config_path,
     // Open the config file
     FOPEN(config_file, config_path, "rb");
     if (!config_file) {
-        fprintf(stderr, "Error channel %u: Couldn't open Config File: %s\n", instance_idx + 1, config_path);
+        fprintf(app_console(), "Error channel %u: Couldn't open Config File: %s\n", instance_idx + 1, config_path);
         return EB_ErrorBadParameter;
     }
 
@@ -1604,7 +1767,7 @@ static EbErrorType read_config_file(EbConfig *app_cfg, const char *config_path,
             value = read_word(config_file);
         }
         if (!value) {
-            fprintf(stderr,
+            fprintf(app_console(),
                     "Error channel %u: Config File: %s is missing a value for %s\n",
                     instance_idx + 1,
                     config_path,
@@ -1718,7 +1881,26 @@ static EbErrorType app_verify_config(EbConfig *app_cfg, uint32_t channel_number)
     EbErrorType return_error = EB_ErrorNone;
 
     // Check Input File
-    if (app_cfg->input_file == (FILE *)NULL) {
+    if (app_cfg->synthetic_input) {
+        if (app_cfg->input_file) {
+            fprintf(app_cfg->error_log_file,
+                    "Error instance %u: The synthetic input cannot be used with an input file\n",
+                    channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (app_cfg->frames_to_be_encoded <= 0) {
+            fprintf(app_cfg->error_log_file,
+                    "Error instance %u: The synthetic input needs the number of frames to encode\n",
+                    channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (app_cfg->buffered_input != -1) {
+            fprintf(app_cfg->error_log_file,
+                    "Error instance %u: Buffered input is not available with the synthetic input\n",
+                    channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    } else if (app_cfg->input_file == (FILE *)NULL) {
         fprintf(app_cfg->error_log_file, "Error instance %u: Invalid Input File\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
@@ -1850,14 +2032,14 @@ static bool find_token_multiple_inputs(unsigned nch, int argc, char *const argv[
     if (return_error && !strcmp(configStr[0], " ")) {
         // if no argument was found, print an error message
         // we don't support flip switches, so this will need to be changed if we ever do.
-        fprintf(stderr, "[SVT-Error]: No argument found for token `%s`\n", token);
+        fprintf(app_console(), "[SVT-Error]: No argument found for token `%s`\n", token);
         strcpy_s(configStr[0], COMMAND_LINE_MAX_SIZE, TOKEN_ERROR_MARKER);
     }
 
     if (has_duplicates) {
-        fprintf(stderr, "\n[SVT-Warning]: Duplicate option %s specified, only `%s", token, token);
-        for (unsigned count = 0; count < nch; ++count) fprintf(stderr, " %s", configStr[count]);
-        fprintf(stderr, "` will apply\n\n");
+        fprintf(app_console(), "\n[SVT-Warning]: Duplicate option %s specified, only `%s", token, token);
+        for (unsigned count = 0; count < nch; ++count) fprintf(app_console(), " %s", configStr[count]);
+        fprintf(app_console(), "` will apply\n\n");
     }
 
     return return_error;
@@ -2026,8 +2208,9 @@ uint32_t get_number_of_channels(int32_t argc, char *const argv[]) {
         // Set the input file
         uint32_t channel_number = strtol(config_string, NULL, 0);
         if ((channel_number > MAX_CHANNEL_NUMBER) || channel_number == 0) {
-            fprintf(
-                stderr, "[SVT-Error]: The number of channels has to be within the range [1,%u]\n", MAX_CHANNEL_NUMBER);
+            fprintf(app_console(),
+                    "[SVT-Error]: The number of channels has to be within the range [1,%u]\n",
+                    MAX_CHANNEL_NUMBER);
             return 0;
         }
         return channel_number;
@@ -2035,6 +2218,10 @@ uint32_t get_number_of_channels(int32_t argc, char *const argv[]) {
     return 1;
 }
 
+Bool get_jobs_file(int32_t argc, char *const argv[], char *path) {
+    return find_token(argc, argv, JOBS_FILE_TOKEN, path) == 0 && path[0] != '\0';
+}
+
 static Bool check_two_pass_conflicts(int32_t argc, char *const argv[]) {
     char        config_string[COMMAND_LINE_MAX_SIZE];
     const char *conflicts[] = {
@@ -2045,7 +2232,7 @@ static Bool check_two_pass_conflicts(int32_t argc, char *const argv[]) {
     const char *token;
     while ((token = conflicts[i])) {
         if (find_token(argc, argv, token, config_string) == 0) {
-            fprintf(stderr, "[SVT-Error]: --passes is not accepted in combination with %s\n", token);
+            fprintf(app_console(), "[SVT-Error]: --passes is not accepted in combination with %s\n", token);
             return TRUE;
         }
         i++;
@@ -2084,7 +2271,7 @@ uint32_t get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_P
             }
         }
         if (rc_mode > 2 || rc_mode < 0) {
-            fprintf(stderr, "Error: The rate control mode must be [0 - 2] \n");
+            fprintf(app_console(), "Error: The rate control mode must be [0 - 2] \n");
             return 0;
         }
     }
@@ -2112,13 +2299,13 @@ uint32_t get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_P
     if (find_token(argc, argv, PRESET_TOKEN, config_string) == 0) {
         enc_mode = strtol(config_string, NULL, 0);
         if (enc_mode > MAX_ENC_PRESET || enc_mode < -1) {
-            fprintf(stderr, "Error: EncoderMode must be in the range of [-1-%d]\n", MAX_ENC_PRESET);
+            fprintf(app_console(), "Error: EncoderMode must be in the range of [-1-%d]\n", MAX_ENC_PRESET);
             return 0;
         }
     }
 
     if (!find_token(argc, argv, INTRA_PERIOD_TOKEN, NULL) && !find_token(argc, argv, KEYINT_TOKEN, NULL)) {
-        fprintf(stderr,
+        fprintf(app_console(),
                 "[SVT-Warning]: --keyint and --intra-period specified, --keyint will take "
                 "precedence!\n");
     }
@@ -2136,13 +2323,13 @@ uint32_t get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_P
         // we don't know the fps at this point, so we can't get the actual keyint at this point
         ip = c.multiply_keyint && c.intra_period_length > 0 ? max_keyint : c.intra_period_length;
         if (!is_keyint)
-            fputs("[SVT-Warning]: --intra-period is deprecated for --keyint\n", stderr);
+            fputs("[SVT-Warning]: --intra-period is deprecated for --keyint\n", app_console());
         if ((ip < -2 || ip > max_keyint) && rc_mode == 0) {
-            fprintf(stderr, "[SVT-Error]: The intra period must be [-2, 2^31-2], input %d\n", ip);
+            fprintf(app_console(), "[SVT-Error]: The intra period must be [-2, 2^31-2], input %d\n", ip);
             return 0;
         }
         if ((ip < 0) && rc_mode == 1) {
-            fprintf(stderr, "[SVT-Error]: The intra period must be > 0 for RateControlMode %d \n", rc_mode);
+            fprintf(app_console(), "[SVT-Error]: The intra period must be > 0 for RateControlMode %d \n", rc_mode);
             return 0;
         }
     }
@@ -2151,7 +2338,7 @@ uint32_t get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_P
         if (str_to_int(PASSES_TOKEN, config_string, &passes))
             return 0;
         if (passes == 0 || passes > 2) {
-            fprintf(stderr,
+            fprintf(app_console(),
                     "[SVT-Error]: The number of passes has to be within the range [1,2], 2 being "
                     "multi-pass encoding\n");
             return 0;
@@ -2165,14 +2352,14 @@ uint32_t get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_P
     passes = (passes == -1) ? 1 : passes;
 
     if (using_fifo && passes > 1) {
-        fprintf(stderr, "[SVT-Warning]: The number of passes has to be 1 when using a fifo, using 1-pass\n");
+        fprintf(app_console(), "[SVT-Warning]: The number of passes has to be 1 when using a fifo, using 1-pass\n");
         multi_pass_mode = SINGLE_PASS;
         passes          = 1;
     }
     // Determine the number of passes in CRF mode
     if (rc_mode == 0) {
         if (passes != 1) {
-            fprintf(stderr, "[SVT-Error]: Multipass CRF is not supported.\n\n");
+            fprintf(app_console(), "[SVT-Error]: Multipass CRF is not supported.\n\n");
             return 0;
         }
         multi_pass_mode = SINGLE_PASS;
@@ -2184,7 +2371,7 @@ uint32_t get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_P
         else if (passes > 1) {
             // M12 and M13 are mapped to M11, so treat M12 and M13 the same as M11
             if (enc_mode > ENC_M10) {
-                fprintf(stderr, "[SVT-Error]:  Multipass VBR is not supported for preset %d.\n\n", enc_mode);
+                fprintf(app_console(), "[SVT-Error]:  Multipass VBR is not supported for preset %d.\n\n", enc_mode);
                 return 0;
             } else {
                 passes          = 2;
@@ -2193,7 +2380,7 @@ uint32_t get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_P
         }
     } else {
         if (passes > 1) {
-            fprintf(stderr, "[SVT-Error]: Multipass CBR is not supported.\n\n");
+            fprintf(app_console(), "[SVT-Error]: Multipass CBR is not supported.\n\n");
             return 0;
         }
         multi_pass_mode = SINGLE_PASS;
@@ -2268,7 +2455,7 @@ static Bool warn_legacy_token(const char *const token) {
     for (struct warn_set *tok = warning_set; tok->old_token; ++tok) {
         if (strcmp(token, tok->old_token))
             continue;
-        fprintf(stderr, "[SVT-Error]: %s has been removed, use %s instead\n", tok->old_token, tok->new_token);
+        fprintf(app_console(), "[SVT-Error]: %s has been removed, use %s instead\n", tok->old_token, tok->new_token);
         return TRUE;
     }
     return FALSE;
@@ -2278,6 +2465,58 @@ static void free_config_strings(unsigned nch, char *config_strings[MAX_CHANNEL_N
     for (unsigned i = 0; i < nch; ++i) free(config_strings[i]);
 }
 
+static EbErrorType read_checkpoint(EbConfig *cfg) {
+    if (!cfg->bitstream_file || cfg->bitstream_file == stdout ||
+        (cfg->output_format != OUTPUT_FORMAT_AUTO && cfg->output_format != OUTPUT_FORMAT_IVF)) {
+        fprintf(app_console(), "Error: %s needs an ivf output file\n", RESUME_TOKEN);
+        return EB_ErrorBadParameter;
+    }
+    FILE *file;
+    FOPEN(file, cfg->resume, "rb");
+    if (!file) {
+        fprintf(app_console(), "Error: can't open the checkpoint file %s\n", cfg->resume);
+        return EB_ErrorBadParameter;
+    }
+    AppCheckpointHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, APP_CHECKPOINT_MAGIC, 8) ||
+        !header.state_size || !(cfg->resume_state.buf = malloc(header.state_size)) ||
+        fread(cfg->resume_state.buf, 1, header.state_size, file) != header.state_size) {
+        fprintf(app_console(), "Error: invalid checkpoint file %s\n", cfg->resume);
+        fclose(file);
+        return EB_ErrorBadParameter;
+    }
+    fclose(file);
+    cfg->resume_state.sz           = header.state_size;
+    cfg->config.resume_checkpoint  = cfg->resume_state;
+    cfg->resume_picture_number     = header.picture_number;
+    cfg->checkpoint_picture_number = header.picture_number;
+    cfg->ivf_count                 = header.ivf_count;
+    // the number of frames to encode counts from the start of the stream
+    if (cfg->frames_to_be_encoded > 0) {
+        if ((uint64_t)cfg->frames_to_be_encoded <= header.picture_number) {
+            fprintf(app_console(), "Error: the checkpoint %s is past the frames to encode\n", cfg->resume);
+            return EB_ErrorBadParameter;
+        }
+        cfg->frames_to_be_encoded -= (int64_t)header.picture_number;
+    }
+    // the input picture of the key frame is the first one sent
+    cfg->frames_to_be_skipped += (int64_t)header.picture_number;
+    cfg->need_to_skip = true;
+
+    // drop the output after the key frame
+    fflush(cfg->bitstream_file);
+#ifdef _WIN32
+    const int truncated = _chsize_s(_fileno(cfg->bitstream_file), (__int64)header.file_offset);
+#else
+    const int truncated = ftruncate(fileno(cfg->bitstream_file), (off_t)header.file_offset);
+#endif
+    if (truncated || fseeko(cfg->bitstream_file, (int64_t)header.file_offset, SEEK_SET)) {
+        fprintf(app_console(), "Error: the output file can't be resumed from the checkpoint %s\n", cfg->resume);
+        return EB_ErrorBadParameter;
+    }
+    return EB_ErrorNone;
+}
+
 static EbErrorType read_fgs_table(EbConfig *cfg) {
     EbErrorType   ret = EB_ErrorBadParameter;
     AomFilmGrain *film_grain;
@@ -2290,7 +2529,7 @@ static EbErrorType read_fgs_table(EbConfig *cfg) {
     // Read in one extra character as there should be a newline
     char magic[9];
     if (!fread(magic, 9, 1, file) || strncmp(magic, "filmgrn1", 8)) {
-        fprintf(stderr, "invalid grain table magic %s\n", cfg->fgs_table_path);
+        fprintf(app_console(), "invalid grain table magic %s\n", cfg->fgs_table_path);
         fclose(file);
         return ret;
     }
@@ -2305,11 +2544,11 @@ static EbErrorType read_fgs_table(EbConfig *cfg) {
                               &film_grain->update_parameters);
 
         if (num_read == 0 && feof(file)) {
-            fprintf(stderr, "invalid grain table %s\n", cfg->fgs_table_path);
+            fprintf(app_console(), "invalid grain table %s\n", cfg->fgs_table_path);
             goto fail;
         }
         if (num_read != 3) {
-            fprintf(stderr, "Unable to read entry header. Read %d != 3\n", num_read);
+            fprintf(app_console(), "Unable to read entry header. Read %d != 3\n", num_read);
             goto fail;
         }
 
@@ -2329,71 +2568,71 @@ static EbErrorType read_fgs_table(EbConfig *cfg) {
                               &film_grain->cr_luma_mult,
                               &film_grain->cr_offset);
             if (num_read != 12) {
-                fprintf(stderr, "Unable to read entry header. Read %d != 12\n", num_read);
+                fprintf(app_console(), "Unable to read entry header. Read %d != 12\n", num_read);
                 goto fail;
             }
             if (!fscanf(file, "\tsY %d ", &film_grain->num_y_points)) {
-                fprintf(stderr, "Unable to read num y points\n");
+                fprintf(app_console(), "Unable to read num y points\n");
                 goto fail;
             }
             for (int i = 0; i < film_grain->num_y_points; ++i) {
                 if (2 !=
                     fscanf(file, "%d %d", &film_grain->scaling_points_y[i][0], &film_grain->scaling_points_y[i][1])) {
-                    fprintf(stderr, "Unable to read y scaling points\n");
+                    fprintf(app_console(), "Unable to read y scaling points\n");
                     goto fail;
                 }
             }
             if (!fscanf(file, "\n\tsCb %d", &film_grain->num_cb_points)) {
-                fprintf(stderr, "Unable to read num cb points\n");
+                fprintf(app_console(), "Unable to read num cb points\n");
                 goto fail;
             }
             for (int i = 0; i < film_grain->num_cb_points; ++i) {
                 if (2 !=
                     fscanf(file, "%d %d", &film_grain->scaling_points_cb[i][0], &film_grain->scaling_points_cb[i][1])) {
-                    fprintf(stderr, "Unable to read cb scaling points\n");
+                    fprintf(app_console(), "Unable to read cb scaling points\n");
                     goto fail;
                 }
             }
             if (!fscanf(file, "\n\tsCr %d", &film_grain->num_cr_points)) {
-                fprintf(stderr, "Unable to read num cr points\n");
+                fprintf(app_console(), "Unable to read num cr points\n");
                 goto fail;
             }
             for (int i = 0; i < film_grain->num_cr_points; ++i) {
                 if (2 !=
                     fscanf(file, "%d %d", &film_grain->scaling_points_cr[i][0], &film_grain->scaling_points_cr[i][1])) {
-                    fprintf(stderr, "Unable to read cr scaling points\n");
+                    fprintf(app_console(), "Unable to read cr scaling points\n");
                     goto fail;
                 }
             }
 
             if (fscanf(file, "\n\tcY")) {
-                fprintf(stderr, "Unable to read Y coeffs header (cY)\n");
+                fprintf(app_console(), "Unable to read Y coeffs header (cY)\n");
                 goto fail;
             }
             const int n = 2 * film_grain->ar_coeff_lag * (film_grain->ar_coeff_lag + 1);
             for (int i = 0; i < n; ++i) {
                 if (1 != fscanf(file, "%d", &film_grain->ar_coeffs_y[i])) {
-                    fprintf(stderr, "Unable to read Y coeffs\n");
+                    fprintf(app_console(), "Unable to read Y coeffs\n");
                     goto fail;
                 }
             }
             if (fscanf(file, "\n\tcCb")) {
-                fprintf(stderr, "Unable to read Cb coeffs header (cCb)\n");
+                fprintf(app_console(), "Unable to read Cb coeffs header (cCb)\n");
                 goto fail;
             }
             for (int i = 0; i <= n; ++i) {
                 if (1 != fscanf(file, "%d", &film_grain->ar_coeffs_cb[i])) {
-                    fprintf(stderr, "Unable to read Cb coeffs\n");
+                    fprintf(app_console(), "Unable to read Cb coeffs\n");
                     goto fail;
                 }
             }
             if (fscanf(file, "\n\tcCr")) {
-                fprintf(stderr, "Unable read to Cr coeffs header (cCr)\n");
+                fprintf(app_console(), "Unable read to Cr coeffs header (cCr)\n");
                 goto fail;
             }
             for (int i = 0; i <= n; ++i) {
                 if (1 != fscanf(file, "%d", &film_grain->ar_coeffs_cr[i])) {
-                    fprintf(stderr, "Unable to read Cr coeffs\n");
+                    fprintf(app_console(), "Unable to read Cr coeffs\n");
                     goto fail;
                 }
             }
@@ -2474,7 +2713,7 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
         }
     } else {
         if (find_token(argc, argv, CONFIG_FILE_TOKEN, config_string) == 0) {
-            fprintf(stderr, "Error: Config File Token Not Found\n");
+            fprintf(app_console(), "Error: Config File Token Not Found\n");
             free_config_strings(num_channels, config_strings);
             return EB_ErrorBadParameter;
         }
@@ -2505,7 +2744,7 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
             }
             // exclude single letter tokens
             if ((*indx)[0] == '-' && (*indx)[1] != '-' && (*indx)[2] != '\0') {
-                fprintf(stderr, "[SVT-Error]: single dash long tokens have been removed!\n");
+                fprintf(app_console(), "[SVT-Error]: single dash long tokens have been removed!\n");
                 free_config_strings(num_channels, config_strings);
                 return EB_ErrorBadParameter;
             }
@@ -2545,7 +2784,7 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
         if (c->app_cfg->y4m_input == TRUE) {
             ret_y4m = read_y4m_header(c->app_cfg);
             if (ret_y4m == EB_ErrorBadParameter) {
-                fprintf(stderr, "Error found when reading the y4m file parameters.\n");
+                fprintf(app_console(), "Error found when reading the y4m file parameters.\n");
                 free_config_strings(num_channels, config_strings);
                 return EB_ErrorBadParameter;
             }
@@ -2557,7 +2796,7 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
         EbConfig   *cfg = c->app_cfg;
         if (cfg->fgs_table_path) {
             if (cfg->config.film_grain_denoise_strength > 0) {
-                fprintf(stderr,
+                fprintf(app_console(),
                         "Warning: Both film-grain-denoise and fgs-table were specified\nfilm-grain-denoise will be "
                         "disabled\n");
                 cfg->config.film_grain_denoise_strength = 0;
@@ -2565,6 +2804,17 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
             c->return_error = read_fgs_table(cfg);
             return_error    = (EbErrorType)(return_error & c->return_error);
         }
+        if (cfg->checkpoint &&
+            (!cfg->bitstream_file || cfg->bitstream_file == stdout ||
+             (cfg->output_format != OUTPUT_FORMAT_AUTO && cfg->output_format != OUTPUT_FORMAT_IVF))) {
+            fprintf(app_console(), "Error: %s needs an ivf output file\n", CHECKPOINT_TOKEN);
+            c->return_error = EB_ErrorBadParameter;
+            return_error    = (EbErrorType)(return_error & c->return_error);
+        }
+        if (cfg->resume) {
+            c->return_error = read_checkpoint(cfg);
+            return_error    = (EbErrorType)(return_error & c->return_error);
+        }
     }
 
     /***************************************************************************************************/
@@ -2623,13 +2873,13 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
     for (int i = 0; i < argc; ++i) {
         if (cmd_copy[i] && strcmp(TOKEN_READ_MARKER, cmd_copy[i])) {
             if (!has_cmd_notread)
-                fprintf(stderr, "Unprocessed tokens: ");
-            fprintf(stderr, "%s ", argv[i]);
+                fprintf(app_console(), "Unprocessed tokens: ");
+            fprintf(app_console(), "%s ", argv[i]);
             has_cmd_notread = true;
         }
     }
     if (has_cmd_notread) {
-        fprintf(stderr, "\n\n");
+        fprintf(app_console(), "\n\n");
         return_error = EB_ErrorBadParameter;
     }
     bool has_arg_notread = false;
@@ -2637,17 +2887,17 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EncChannel *chan
     for (int i = 0; i < argc; ++i) {
         if (arg_copy[i] && strcmp(TOKEN_READ_MARKER, arg_copy[i])) {
             if (!has_arg_notread)
-                fprintf(stderr, "Unprocessed arguments: ");
-            fprintf(stderr, "%s ", argv[i]);
+                fprintf(app_console(), "Unprocessed arguments: ");
+            fprintf(app_console(), "%s ", argv[i]);
             maybe_token |= !!strchr(arg_copy[i], '-');
             has_arg_notread = true;
         }
     }
     if (maybe_token) {
-        fprintf(stderr, "\nMaybe missing spacing between tokens");
+        fprintf(app_console(), "\nMaybe missing spacing between tokens");
     }
     if (has_arg_notread) {
-        fprintf(stderr, "\n\n");
+        fprintf(app_console(), "\n\n");
         return_error = EB_ErrorBadParameter;
     }
 
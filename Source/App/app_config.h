@@ -49,6 +49,7 @@ typedef enum EncPass {
 
 #define MAX_CHANNEL_NUMBER 6U
 #define MAX_NUM_TOKENS 210
+#define COMMAND_LINE_MAX_SIZE 2048
 
 #ifdef _WIN32
 #define FOPEN(f, s, m) fopen_s(&f, s, m)
@@ -114,6 +115,25 @@ struct forced_key_frames {
     size_t    count;
 };
 
+// Container of the output bitstream
+typedef enum AppOutputFormat {
+    OUTPUT_FORMAT_AUTO = 0, // from the output file extension, ivf otherwise
+    OUTPUT_FORMAT_IVF,
+    OUTPUT_FORMAT_OBU, // low overhead obus (Section 5)
+    OUTPUT_FORMAT_ANNEXB, // length delimited obus (Annex B)
+    OUTPUT_FORMAT_MP4, // fragmented mp4
+} AppOutputFormat;
+
+// Checkpoint file: the header, then the state of the encoder
+#define APP_CHECKPOINT_MAGIC "svtckpt1"
+typedef struct AppCheckpointHeader {
+    char     magic[8];
+    uint64_t picture_number; // key frame the stream resumes from
+    uint64_t file_offset; // of the key frame in the output file
+    uint64_t ivf_count; // ivf frames before the key frame
+    uint64_t state_size;
+} AppCheckpointHeader;
+
 typedef struct EbConfig {
     /****************************************
      * File I/O
@@ -122,22 +142,38 @@ typedef struct EbConfig {
     MemMapFile mmap; //memory mapped file handler
     Bool       input_file_is_fifo;
     FILE      *bitstream_file;
+    AppOutputFormat output_format;
     FILE      *recon_file;
     FILE      *error_log_file;
     FILE      *stat_file;
+    FILE      *picture_stats_file;
     FILE      *qp_file;
+    /* checkpoint at the key frames, and resume from it */
+    const char    *checkpoint;
+    const char    *resume;
+    SvtAv1FixedBuf resume_state;
+    uint64_t       resume_picture_number;
+    uint64_t       checkpoint_picture_number; // last key frame written to the checkpoint file
     /* two pass */
     const char *stats;
     FILE       *input_stat_file;
     FILE       *output_stat_file;
     Bool        y4m_input;
     char        y4m_buf[9];
+    /* procedural input, in place of the input file */
+    Bool                    synthetic_input;
+    struct SyntheticSource *synthetic_source;
+    uint64_t                synthetic_frame; // index of the next frame to produce
 
     uint8_t progress; // 0 = no progress output, 1 = normal, 2 = aomenc style verbose progress
     /****************************************
      * Computational Performance Data
      ****************************************/
     EbPerformanceContext performance_context;
+    /* soak test: report the speed and the memory use every soak_interval seconds */
+    uint32_t soak_interval;
+    uint64_t soak_time[2]; // [sec, micro_sec] of the last report
+    uint64_t soak_frame_count; // frames output at the last report
 
     uint32_t input_padded_width;
     uint32_t input_padded_height;
@@ -161,6 +197,12 @@ typedef struct EbConfig {
     uint64_t processed_byte_count;
 
     uint64_t ivf_count;
+    // fragmented mp4 output, the sequence number is 0 until the moov box is written
+    uint32_t mp4_sequence_number;
+    uint64_t mp4_decode_time;
+    // tile group output, fragments of the frame received so far
+    uint8_t *fragment_buffer;
+    uint32_t fragment_size;
 
     struct forced_key_frames forced_keyframes;
 
@@ -207,6 +249,10 @@ typedef enum MultiPassModes {
 typedef struct EncApp {
     SvtAv1FixedBuf rc_twopasses_stats;
 } EncApp;
+/* Stream of the console output of the app: stderr, or the stream set by the calling thread.
+ * In job file mode each job thread writes to its own stream, printed once the job is done. */
+FILE *app_console(void);
+void  set_app_console(FILE *stream);
 EbConfig *svt_config_ctor();
 void      svt_config_dtor(EbConfig *app_cfg);
 
@@ -216,6 +262,7 @@ EbErrorType     read_command_line(int32_t argc, char *const argv[], EncChannel *
 int             get_version(int argc, char *argv[]);
 extern uint32_t get_help(int32_t argc, char *const argv[]);
 extern uint32_t get_number_of_channels(int32_t argc, char *const argv[]);
+Bool            get_jobs_file(int32_t argc, char *const argv[], char *path);
 uint32_t        get_passes(int32_t argc, char *const argv[], EncPass enc_pass[MAX_ENC_PASS]);
 EbErrorType     handle_stats_file(EbConfig *app_cfg, EncPass pass, const SvtAv1FixedBuf *rc_stats_buffer,
                                   uint32_t channel_number);
@@ -17,13 +17,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <inttypes.h>
 
 #include "EbSvtAv1.h"
 #include "app_context.h"
 #include "app_config.h"
-#if DEBUG_ROI
-#include <inttypes.h>
-#endif
 
 /*************************************
 **************************************
@@ -216,7 +214,7 @@ static EbErrorType parse_rio_map_file(EbConfig *app_cfg) {
 
     while (fgets(buf, (int)buf_size, file)) {
         if (strlen(buf) == buf_size - 1) {
-            fprintf(stderr, "Warning - May exceed the line length limitation of ROI map file\n");
+            fprintf(app_console(), "Warning - May exceed the line length limitation of ROI map file\n");
         }
         if (buf[0] != '\n') {
             char    *p              = buf;
@@ -278,14 +276,14 @@ static EbErrorType parse_rio_map_file(EbConfig *app_cfg) {
                         evt->max_seg_id     = seg_id;
                     } else if (seg_id > evt->max_seg_id && evt->max_seg_id >= MAX_SEGMENTS) {
                         ret = EB_ErrorBadParameter;
-                        fprintf(stderr,
+                        fprintf(app_console(),
                                 "Error: Invalid ROI map file - Maximum number of segment supported "
                                 "by AV1 spec is eight\n");
                         break;
                     }
                 } else {
                     ret = EB_ErrorBadParameter;
-                    fprintf(stderr,
+                    fprintf(app_console(),
                             "Error: Invalid ROI map file - Invalid qp offset %ld. The expected "
                             "range is between -255 and 255\n",
                             val);
@@ -294,7 +292,7 @@ static EbErrorType parse_rio_map_file(EbConfig *app_cfg) {
             }
             if (i < b64_num) {
                 ret = EB_ErrorBadParameter;
-                fprintf(stderr, "Error: Invalid ROI map file - not enough qp offset within a ROI event\n");
+                fprintf(app_console(), "Error: Invalid ROI map file - not enough qp offset within a ROI event\n");
             }
             if (ret != EB_ErrorNone) {
                 break;
@@ -303,7 +301,7 @@ static EbErrorType parse_rio_map_file(EbConfig *app_cfg) {
             // sort seg_qp array in descending order
             qsort(evt->seg_qp, evt->max_seg_id + 1, sizeof(evt->seg_qp[0]), compare_seg_qp);
             if (evt->seg_qp[0] < 0) {
-                fprintf(stderr, "Warning: All qp offsets are negative may result in undecodable bitstream\n");
+                fprintf(app_console(), "Warning: All qp offsets are negative may result in undecodable bitstream\n");
             }
 
             // translate the qp offset map provided in the ROI map file to a segment id map.
@@ -383,6 +381,37 @@ static void deallocate_buffers(EbConfig *app_cfg) {
     }
 }
 
+/* Called by the encoder for each coded picture, writes a csv line to the picture stats file */
+static void write_picture_stats(const SvtAv1PictureStats *stats, void *user_data) {
+    FILE *f = (FILE *)user_data;
+    fprintf(f,
+            "%" PRIu64 ",%" PRIu64 ",%" PRId64 ",%d,%u,%u,%u,%d,%u,%u,%u,%" PRIu64 ",%" PRId64 ",%.4f,%" PRIu64 ",",
+            stats->picture_number,
+            stats->decode_order,
+            stats->pts,
+            (int)stats->pic_type,
+            stats->temporal_layer,
+            stats->show_frame,
+            stats->is_overlay,
+            stats->enc_mode,
+            stats->qindex,
+            stats->qp,
+            stats->recode_count,
+            stats->bits,
+            stats->target_bits,
+            stats->tpl_r0,
+            stats->me_distortion);
+    // references as space separated picture numbers, one field per list
+    for (int list = 0; list < 2; list++) {
+        for (int i = 0; i < stats->ref_count[list]; i++)
+            fprintf(f, i ? " %" PRIu64 : "%" PRIu64, stats->ref_picture_number[list][i]);
+        fputc(',', f);
+    }
+    fprintf(f, "%" PRIu64, stats->latency_us);
+    for (int s = 0; s < SVT_AV1_DEADLINE_STAGES; s++) fprintf(f, ",%" PRIu64, stats->stage_us[s]);
+    fputc('\n', f);
+}
+
 /***************************************
 * Functions Implementation
 ***************************************/
@@ -404,6 +433,15 @@ EbErrorType init_encoder(EbConfig *app_cfg, uint32_t instance_idx) {
         }
     }
 
+    if (app_cfg->picture_stats_file) {
+        fprintf(app_cfg->picture_stats_file,
+                "picture,decode_order,pts,pic_type,layer,show_frame,overlay,preset,qindex,qp,recodes,bits,"
+                "target_bits,tpl_r0,me_distortion,refs_list0,refs_list1,latency_us,lookahead_us,motion_us,"
+                "rate_control_us,encode_us,post_us\n");
+        app_cfg->config.picture_stats_cb        = write_picture_stats;
+        app_cfg->config.picture_stats_user_data = app_cfg->picture_stats_file;
+    }
+
     // Send over all configuration parameters
     // Set the Parameters
     EbErrorType return_error = svt_av1_enc_set_parameter(app_cfg->svt_encoder_handle, &app_cfg->config);
@@ -0,0 +1,321 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_input_synthetic.h"
+
+#define GRAIN_SIZE 256 // period of the grain table, a power of 2
+#define GLYPH_WIDTH 8
+#define GLYPH_HEIGHT 16
+
+typedef enum SceneKind {
+    SCENE_GRADIENT, // moving gradients
+    SCENE_NOISE, // panned noise texture with grain
+    SCENE_TEXT, // screen content: text scrolling next to a side bar
+    SCENE_KINDS
+} SceneKind;
+
+struct SyntheticSource {
+    uint32_t  width;
+    uint32_t  height;
+    uint32_t  bit_depth;
+    uint32_t  ss_x;
+    uint32_t  ss_y;
+    uint32_t  scene_length;
+    uint16_t *canvas[3]; // scene drawn with 16-bit samples, per plane
+    uint16_t *grain; // GRAIN_SIZE x GRAIN_SIZE white noise
+    uint16_t *row; // one row of the frame being written
+    // scene drawn in the canvas
+    int       scene_valid;
+    uint64_t  scene;
+    uint64_t  scene_start;
+    uint64_t  scene_end;
+    SceneKind kind;
+    int32_t   pan_x; // luma samples per frame, even
+    int32_t   pan_y;
+    uint32_t  object_width; // inverted rectangle moving over the canvas
+    uint32_t  object_height;
+    int32_t   object_x;
+    int32_t   object_y;
+    int32_t   object_vx;
+    int32_t   object_vy;
+};
+
+static uint32_t hash2(uint32_t a, uint32_t b) {
+    uint32_t h = a * 0x9E3779B1u ^ (b + 0x7F4A7C15u) * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    h *= 0x297A2D39u;
+    h ^= h >> 15;
+    return h;
+}
+
+// Triangle wave of period 0x20000 over [0, 0xFFFF]
+static uint32_t triangle(uint32_t phase) {
+    phase &= 0x1FFFF;
+    return phase < 0x10000 ? phase : 0x1FFFF - phase;
+}
+
+// Position of an object bouncing in [0, range]
+static int32_t bounce(int64_t pos, int32_t range) {
+    if (range <= 0)
+        return 0;
+    const int64_t period = 2 * (int64_t)range;
+    const int64_t m      = ((pos % period) + period) % period;
+    return (int32_t)(m <= range ? m : period - m);
+}
+
+static uint32_t wrap(int64_t pos, uint32_t size) { return (uint32_t)(((pos % size) + size) % size); }
+
+static uint32_t scene_frames(const SyntheticSource *src, uint64_t scene) {
+    return src->scene_length / 2 + hash2((uint32_t)scene, 0) % src->scene_length + 1;
+}
+
+static uint32_t plane_width(const SyntheticSource *src, int plane) {
+    return plane ? src->width >> src->ss_x : src->width;
+}
+
+static uint32_t plane_height(const SyntheticSource *src, int plane) {
+    return plane ? src->height >> src->ss_y : src->height;
+}
+
+// Chroma is drawn with a quarter of the luma contrast, around the neutral value
+static uint16_t chroma_of(uint32_t v) { return (uint16_t)(0x6000 + (v >> 2)); }
+
+static void draw_gradient(SyntheticSource *src, uint32_t seed) {
+    for (int plane = 0; plane < 3; plane++) {
+        const uint32_t w      = plane_width(src, plane);
+        const uint32_t h      = plane_height(src, plane);
+        const uint32_t ps     = hash2(seed, plane);
+        const uint64_t kx     = 1 + ps % 3;
+        const uint64_t ky     = (ps >> 8) % 3;
+        const uint32_t phase0 = ps >> 15;
+        for (uint32_t y = 0; y < h; y++) {
+            uint16_t      *out     = src->canvas[plane] + (size_t)y * w;
+            const uint32_t phase_y = (uint32_t)(ky * 0x20000 * y / h) + phase0;
+            for (uint32_t x = 0; x < w; x++) {
+                const uint32_t v = triangle((uint32_t)(kx * 0x20000 * x / w) + phase_y);
+                out[x]           = plane ? chroma_of(v) : (uint16_t)v;
+            }
+        }
+    }
+}
+
+// Bilinear interpolation of random values on a lattice of cells of about cell x cell luma samples, that
+// tiles the frame so that panning it shows no seam
+static uint32_t value_noise(const SyntheticSource *src, uint32_t x, uint32_t y, uint32_t cell, uint32_t seed) {
+    const uint32_t nx = src->width / cell ? src->width / cell : 1;
+    const uint32_t ny = src->height / cell ? src->height / cell : 1;
+    const uint64_t px = (uint64_t)x * nx * 256 / src->width, py = (uint64_t)y * ny * 256 / src->height;
+    const uint32_t i0 = (uint32_t)(px >> 8) % nx, i1 = (i0 + 1) % nx;
+    const uint32_t j0 = (uint32_t)(py >> 8) % ny, j1 = (j0 + 1) % ny;
+    const uint32_t fx = px & 255, fy = py & 255;
+    const uint32_t v00 = hash2(hash2(i0, j0), seed) & 0xFFFF;
+    const uint32_t v10 = hash2(hash2(i1, j0), seed) & 0xFFFF;
+    const uint32_t v01 = hash2(hash2(i0, j1), seed) & 0xFFFF;
+    const uint32_t v11 = hash2(hash2(i1, j1), seed) & 0xFFFF;
+    const uint32_t top = v00 * (256 - fx) + v10 * fx;
+    const uint32_t bot = v01 * (256 - fx) + v11 * fx;
+    return (uint32_t)(((uint64_t)top * (256 - fy) + (uint64_t)bot * fy) >> 16);
+}
+
+static void draw_noise(SyntheticSource *src, uint32_t seed) {
+    const uint32_t cell = 8u << (hash2(seed, 3) % 3);
+    for (int plane = 0; plane < 3; plane++) {
+        const uint32_t w  = plane_width(src, plane);
+        const uint32_t h  = plane_height(src, plane);
+        const uint32_t sx = plane ? src->ss_x : 0;
+        const uint32_t sy = plane ? src->ss_y : 0;
+        const uint32_t ps = hash2(seed, plane);
+        for (uint32_t y = 0; y < h; y++) {
+            uint16_t *out = src->canvas[plane] + (size_t)y * w;
+            for (uint32_t x = 0; x < w; x++) {
+                // coarse and fine octaves, in luma samples
+                const uint32_t lx = x << sx, ly = y << sy;
+                const uint32_t v  = (2 * value_noise(src, lx, ly, cell, ps) + value_noise(src, lx, ly, cell / 4, ps + 1)) /
+                    3;
+                out[x] = plane ? chroma_of(v) : (uint16_t)v;
+            }
+        }
+    }
+}
+
+// Text on a dark or light theme, in luma samples; returns 0 for the background, 1 for the side bar,
+// 2 for the text
+static int text_sample(uint32_t x, uint32_t y, uint32_t bar_width, uint32_t seed) {
+    if (x < bar_width)
+        return 1;
+    x -= bar_width;
+    const uint32_t col = x / GLYPH_WIDTH, row = y / GLYPH_HEIGHT;
+    const uint32_t gx = x % GLYPH_WIDTH, gy = y % GLYPH_HEIGHT;
+    const uint32_t line = hash2(row, seed);
+    // empty lines, indentation and line length
+    if (line % 5 == 0 || col < (line >> 4) % 4 * 2 || col >= (line >> 8) % 80)
+        return 0;
+    const uint32_t ch = hash2(row * 4096 + col, seed + 1);
+    if (ch % 6 == 0 || gx < 1 || gx > 6 || gy < 3 || gy > 12)
+        return 0; // space, or outside the glyph box
+    const uint32_t bits = hash2(ch % 64, gy);
+    return ((bits >> gx) | (bits >> (gx + 1))) & 1 ? 2 : 0;
+}
+
+static void draw_text(SyntheticSource *src, uint32_t seed) {
+    const int      dark      = hash2(seed, 4) & 1;
+    const uint32_t bar_width = src->width / 6 / GLYPH_WIDTH * GLYPH_WIDTH;
+    const uint16_t luma[3]   = {dark ? 0x1800 : 0xF000, dark ? 0x3000 : 0xD800, dark ? 0xE000 : 0x2000};
+    for (int plane = 0; plane < 3; plane++) {
+        const uint32_t w  = plane_width(src, plane);
+        const uint32_t h  = plane_height(src, plane);
+        const uint32_t sx = plane ? src->ss_x : 0;
+        const uint32_t sy = plane ? src->ss_y : 0;
+        uint16_t       value[3];
+        for (int i = 0; i < 3; i++)
+            value[i] = plane ? chroma_of(0x8000 + (hash2(seed, 8 + plane * 3 + i) & 0x3FFF) - 0x2000) : luma[i];
+        for (uint32_t y = 0; y < h; y++) {
+            uint16_t *out = src->canvas[plane] + (size_t)y * w;
+            for (uint32_t x = 0; x < w; x++) out[x] = value[text_sample(x << sx, y << sy, bar_width, seed)];
+        }
+    }
+}
+
+static void draw_scene(SyntheticSource *src) {
+    const uint32_t seed = hash2((uint32_t)src->scene, 1);
+    src->kind           = (SceneKind)(seed % SCENE_KINDS);
+    const uint32_t p    = hash2(seed, 2);
+    if (src->kind == SCENE_TEXT) {
+        // scrolling, or still
+        src->pan_x = 0;
+        src->pan_y = (int32_t)(p % 3) * 2;
+    } else {
+        src->pan_x = ((int32_t)(p % 9) - 4) * 2;
+        src->pan_y = ((int32_t)((p >> 8) % 5) - 2) * 2;
+    }
+    src->object_width  = (src->width / 8) & ~1u;
+    src->object_height = (src->height / 8) & ~1u;
+    src->object_x      = (int32_t)(hash2(seed, 5) % src->width);
+    src->object_y      = (int32_t)(hash2(seed, 6) % src->height);
+    src->object_vx     = (int32_t)(hash2(seed, 7) % 7) - 3;
+    src->object_vy     = (int32_t)((hash2(seed, 7) >> 8) % 5) - 2;
+
+    switch (src->kind) {
+    case SCENE_GRADIENT: draw_gradient(src, seed); break;
+    case SCENE_NOISE: draw_noise(src, seed); break;
+    default: draw_text(src, seed); break;
+    }
+}
+
+static void select_scene(SyntheticSource *src, uint64_t index) {
+    if (src->scene_valid && index >= src->scene_start && index < src->scene_end)
+        return;
+    if (!src->scene_valid || index < src->scene_start) {
+        src->scene       = 0;
+        src->scene_start = 0;
+        src->scene_end   = scene_frames(src, 0);
+    }
+    while (index >= src->scene_end) {
+        src->scene++;
+        src->scene_start = src->scene_end;
+        src->scene_end += scene_frames(src, src->scene);
+    }
+    draw_scene(src);
+    src->scene_valid = 1;
+}
+
+SyntheticSource *synthetic_source_create(uint32_t width, uint32_t height, uint32_t bit_depth, uint32_t ss_x,
+                                         uint32_t ss_y, uint32_t scene_length) {
+    if (!width || !height || bit_depth < 8 || bit_depth > 16)
+        return NULL;
+    SyntheticSource *src = (SyntheticSource *)calloc(1, sizeof(*src));
+    if (!src)
+        return NULL;
+    src->width        = width;
+    src->height       = height;
+    src->bit_depth    = bit_depth;
+    src->ss_x         = ss_x;
+    src->ss_y         = ss_y;
+    src->scene_length = scene_length ? scene_length : 1;
+    int ok            = 1;
+    for (int plane = 0; plane < 3; plane++) {
+        src->canvas[plane] = (uint16_t *)malloc(sizeof(uint16_t) * plane_width(src, plane) * plane_height(src, plane));
+        ok &= src->canvas[plane] != NULL;
+    }
+    src->grain = (uint16_t *)malloc(sizeof(uint16_t) * GRAIN_SIZE * GRAIN_SIZE);
+    src->row   = (uint16_t *)malloc(sizeof(uint16_t) * width);
+    if (!ok || !src->grain || !src->row) {
+        synthetic_source_destroy(src);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < GRAIN_SIZE * GRAIN_SIZE; i++) src->grain[i] = (uint16_t)hash2(i, 0x6772);
+    return src;
+}
+
+void synthetic_source_destroy(SyntheticSource *src) {
+    if (!src)
+        return;
+    for (int plane = 0; plane < 3; plane++) free(src->canvas[plane]);
+    free(src->grain);
+    free(src->row);
+    free(src);
+}
+
+void synthetic_source_fill(SyntheticSource *src, uint64_t index, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                           uint32_t y_stride, uint32_t cb_stride, uint32_t cr_stride) {
+    select_scene(src, index);
+    const int64_t t = (int64_t)(index - src->scene_start);
+    // pan of the canvas and position of the object, in luma samples
+    const uint32_t pan_x    = wrap(src->pan_x * t, src->width);
+    const uint32_t pan_y    = wrap(src->pan_y * t, src->height);
+    const int32_t  object_x = bounce(src->object_x + src->object_vx * t, (int32_t)(src->width - src->object_width));
+    const int32_t  object_y = bounce(src->object_y + src->object_vy * t, (int32_t)(src->height - src->object_height));
+    const uint32_t shift    = 16 - src->bit_depth;
+
+    uint8_t *const planes[3]  = {luma, cb, cr};
+    const uint32_t strides[3] = {y_stride, cb_stride, cr_stride};
+    for (int plane = 0; plane < 3; plane++) {
+        const uint32_t w        = plane_width(src, plane);
+        const uint32_t h        = plane_height(src, plane);
+        const uint32_t sx       = plane ? src->ss_x : 0;
+        const uint32_t sy       = plane ? src->ss_y : 0;
+        const uint32_t ox       = (pan_x >> sx) % w;
+        const uint32_t oy       = (pan_y >> sy) % h;
+        const uint32_t obj_x0   = (uint32_t)object_x >> sx;
+        const uint32_t obj_x1   = (uint32_t)(object_x + src->object_width) >> sx;
+        const uint32_t obj_y0   = (uint32_t)object_y >> sy;
+        const uint32_t obj_y1   = (uint32_t)(object_y + src->object_height) >> sy;
+        const int      grain_on = src->kind == SCENE_NOISE && plane == 0;
+        uint16_t      *row      = src->row;
+        for (uint32_t y = 0; y < h; y++) {
+            const uint16_t *in = src->canvas[plane] + (size_t)((y + oy) % h) * w;
+            memcpy(row, in + ox, sizeof(*row) * (w - ox));
+            memcpy(row + w - ox, in, sizeof(*row) * ox);
+            if (grain_on) {
+                const uint16_t *g = src->grain + (size_t)((y + t * 37) & (GRAIN_SIZE - 1)) * GRAIN_SIZE;
+                for (uint32_t x = 0; x < w; x++) {
+                    const int32_t v = row[x] + (((int32_t)g[(x + t * 91) & (GRAIN_SIZE - 1)] - 0x8000) >> 6);
+                    row[x]          = (uint16_t)(v < 0 ? 0 : v > 0xFFFF ? 0xFFFF : v);
+                }
+            }
+            if (y >= obj_y0 && y < obj_y1) {
+                for (uint32_t x = obj_x0; x < obj_x1 && x < w; x++) row[x] = 0xFFFF - row[x];
+            }
+            if (src->bit_depth > 8) {
+                uint16_t *out = (uint16_t *)planes[plane] + (size_t)y * strides[plane];
+                for (uint32_t x = 0; x < w; x++) out[x] = row[x] >> shift;
+            } else {
+                uint8_t *out = planes[plane] + (size_t)y * strides[plane];
+                for (uint32_t x = 0; x < w; x++) out[x] = (uint8_t)(row[x] >> 8);
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef AppInputSynthetic_h
+#define AppInputSynthetic_h
+
+#include <stdint.h>
+
+/* Procedural input: a sequence of scenes of moving gradients, noise textures and scrolling text, cut
+ * at irregular intervals. Each scene is drawn once into a canvas, the frames pan it and move an object
+ * over it, so that producing a frame costs about as much as copying it.
+ * The frames only depend on their index, so they can be produced in any order. */
+typedef struct SyntheticSource SyntheticSource;
+
+/* scene_length is the average number of frames of a scene; planes are subsampled by ss_x / ss_y */
+SyntheticSource *synthetic_source_create(uint32_t width, uint32_t height, uint32_t bit_depth, uint32_t ss_x,
+                                         uint32_t ss_y, uint32_t scene_length);
+void             synthetic_source_destroy(SyntheticSource *src);
+
+/* Writes frame `index`; samples are 16-bit when bit_depth > 8, strides are in samples */
+void synthetic_source_fill(SyntheticSource *src, uint64_t index, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                           uint32_t y_stride, uint32_t cb_stride, uint32_t cr_stride);
+
+#endif // AppInputSynthetic_h
@@ -39,7 +39,7 @@ EbErrorType read_y4m_header(EbConfig *cfg) {
 
     /* print header */
     if (PRINT_HEADER) {
-        fprintf(stderr, "y4m header:");
+        fprintf(app_console(), "y4m header:");
         fputs(buffer, stdout);
     }
 
@@ -50,12 +50,12 @@ EbErrorType read_y4m_header(EbConfig *cfg) {
         case 'W': /* width, required. */
             width = strtol(tokstart, &tokstart, 10);
             if (PRINT_HEADER)
-                fprintf(stderr, "width = %lu\n", width);
+                fprintf(app_console(), "width = %lu\n", width);
             break;
         case 'H': /* height, required. */
             height = strtol(tokstart, &tokstart, 10);
             if (PRINT_HEADER)
-                fprintf(stderr, "height = %lu\n", height);
+                fprintf(app_console(), "height = %lu\n", height);
             break;
         case 'I': /* scan type, not required, default: 'p' */
             switch (*tokstart++) {
@@ -66,7 +66,7 @@ EbErrorType read_y4m_header(EbConfig *cfg) {
             default: fprintf(cfg->error_log_file, "interlace type not supported\n"); return EB_ErrorBadParameter;
             }
             if (PRINT_HEADER)
-                fprintf(stderr, "scan_type = %c\n", scan_type);
+                fprintf(app_console(), "scan_type = %c\n", scan_type);
             break;
         case 'C': /* color space, not required: default "420" */
 #define chroma_compare(a, b) !strncmp(a, b, sizeof(a) - 1)
@@ -161,21 +161,21 @@ EbErrorType read_y4m_header(EbConfig *cfg) {
 #undef chroma_compare
             while (*tokstart != 0x20 && *tokstart != '\n') tokstart++;
             if (PRINT_HEADER)
-                fprintf(stderr, "chroma = %s, bitdepth = %u\n", chroma, bitdepth);
+                fprintf(app_console(), "chroma = %s, bitdepth = %u\n", chroma, bitdepth);
             break;
         case 'F': /* frame rate, required */
             fr_n = strtol(tokstart, &tokstart, 10);
             fr_d = strtol(++tokstart, &tokstart, 10);
             ++tokstart;
             if (PRINT_HEADER)
-                fprintf(stderr, "framerate_n = %ld\nframerate_d = %ld\n", fr_n, fr_d);
+                fprintf(app_console(), "framerate_n = %ld\nframerate_d = %ld\n", fr_n, fr_d);
             break;
         case 'A': /* aspect ratio, not required */
             aspect_n = strtol(tokstart, &tokstart, 10);
             aspect_d = strtol(++tokstart, &tokstart, 10);
             ++tokstart;
             if (PRINT_HEADER)
-                fprintf(stderr, "aspect_n = %ld\naspect_d = %ld\n", aspect_n, aspect_d);
+                fprintf(app_console(), "aspect_n = %ld\naspect_d = %ld\n", aspect_n, aspect_d);
             break;
         default:
             /* Unknown section: skip it */
@@ -26,6 +26,7 @@
 #include <signal.h>
 #include <stdint.h>
 #include <string.h>
+#include <ctype.h>
 #include "app_config.h"
 #include "app_context.h"
 #include "svt_time.h"
@@ -63,10 +64,27 @@ void process_output_recon_buffer(EncChannel* c);
 
 void process_output_stream_buffer(EncChannel* c, EncApp* enc_app, int32_t* frame_count);
 
-void init_reader(EbConfig* app_cfg);
+EbErrorType init_reader(EbConfig* app_cfg);
 
 volatile int32_t keep_running = 1;
 
+#ifdef _WIN32
+typedef CRITICAL_SECTION AppMutex;
+#define app_mutex_init(m) InitializeCriticalSection(m)
+#define app_mutex_destroy(m) DeleteCriticalSection(m)
+#define app_mutex_lock(m) EnterCriticalSection(m)
+#define app_mutex_unlock(m) LeaveCriticalSection(m)
+#else
+typedef pthread_mutex_t AppMutex;
+#define app_mutex_init(m) pthread_mutex_init(m, NULL)
+#define app_mutex_destroy(m) pthread_mutex_destroy(m)
+#define app_mutex_lock(m) pthread_mutex_lock(m)
+#define app_mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
+// In job file mode, the job reports share the console
+static AppMutex print_mutex;
+
 void event_handler(int32_t dummy) {
     (void)dummy;
     keep_running = 0;
@@ -100,7 +118,7 @@ typedef struct EncContext {
 
 //initilize memory mapped file handler
 static void init_memory_file_map(EbConfig* app_cfg) {
-    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo;
+    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo && app_cfg->input_file != NULL;
 
     if (!app_cfg->mmap.enable)
         return;
@@ -184,8 +202,8 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
     // Read all configuration files.
     return_error = read_command_line(argc, argv, enc_context->channels, num_channels);
     if (return_error != EB_ErrorNone) {
-        fprintf(stderr, "Error in configuration, could not begin encoding! ... \n");
-        fprintf(stderr, "Run %s --help for a list of options\n", argv[0]);
+        fprintf(app_console(), "Error in configuration, could not begin encoding! ... \n");
+        fprintf(app_console(), "Run %s --help for a list of options\n", argv[0]);
         return return_error;
     }
     // Set main thread affinity
@@ -225,7 +243,7 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
                       compar_uint64);
             }
             init_memory_file_map(app_cfg);
-            init_reader(app_cfg);
+            c->return_error = init_reader(app_cfg);
 
             app_svt_av1_get_time(&app_cfg->performance_context.lib_start_time[0],
                                  &app_cfg->performance_context.lib_start_time[1]);
@@ -233,7 +251,8 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
             app_cfg->config.pass = passes == 1 ? app_cfg->config.pass // Single-Pass
                                                : (int)enc_pass; // Multi-Pass
 
-            c->return_error = handle_stats_file(app_cfg, enc_pass, &enc_app->rc_twopasses_stats, num_channels);
+            if (c->return_error == EB_ErrorNone)
+                c->return_error = handle_stats_file(app_cfg, enc_pass, &enc_app->rc_twopasses_stats, num_channels);
             if (c->return_error == EB_ErrorNone) {
                 c->return_error = init_encoder(app_cfg, inst_cnt);
             }
@@ -309,12 +328,12 @@ static void print_summary(const EncContext* const enc_context) {
                          (app_cfg->frames_encoded * 1000)));
             }
 
-            fprintf(stderr,
+            fprintf(app_console(),
                     "\nSUMMARY --------------------------------- Channel %u  "
                     "--------------------------------\n",
                     inst_cnt + 1);
-            fprintf(stderr, "Total Frames\t\tFrame Rate\t\tByte Count\t\tBitrate\n");
-            fprintf(stderr,
+            fprintf(app_console(), "Total Frames\t\tFrame Rate\t\tByte Count\t\tBitrate\n");
+            fprintf(app_console(),
                     "%12d\t\t%4.2f fps\t\t%10.0f\t\t%5.2f kbps\n",
                     (int32_t)frame_count,
                     frame_rate,
@@ -323,15 +342,15 @@ static void print_summary(const EncContext* const enc_context) {
                      (app_cfg->frames_encoded * 1000)));
 
             if (app_cfg->config.stat_report) {
-                fprintf(stderr,
+                fprintf(app_console(),
                         "\n\t\tAverage PSNR (using per-frame "
                         "PSNR)\t\t|\tOverall PSNR (using per-frame MSE)\t\t|\t"
                         "Average SSIM\n");
-                fprintf(stderr,
+                fprintf(app_console(),
                         "Average "
                         "QP\tY-PSNR\t\tU-PSNR\t\tV-PSNR\t\t|\tY-PSNR\t\tU-"
                         "PSNR\t\tV-PSNR\t\t|\tY-SSIM\tU-SSIM\tV-SSIM\n");
-                fprintf(stderr,
+                fprintf(app_console(),
                         "%11.2f\t%4.2f dB\t%4.2f dB\t%4.2f dB\t|\t%4.2f "
                         "dB\t%4.2f dB\t%4.2f dB\t|\t%1.5f\t%1.5f\t%1.5f\n",
                         (float)app_cfg->performance_context.sum_qp / frame_count,
@@ -349,7 +368,7 @@ static void print_summary(const EncContext* const enc_context) {
             fflush(stdout);
         }
     }
-    fprintf(stderr, "\n");
+    fprintf(app_console(), "\n");
     fflush(stdout);
 }
 
@@ -362,7 +381,7 @@ static void print_performance(const EncContext* const enc_context) {
                 if ((app_cfg->config.pass == 0 ||
                      (app_cfg->config.pass == 2 && app_cfg->config.rate_control_mode == SVT_AV1_RC_MODE_CQP_OR_CRF) ||
                      app_cfg->config.pass == 3))
-                    fprintf(stderr,
+                    fprintf(app_console(),
                             "\nChannel %u\nAverage Speed:\t\t%.3f fps\nTotal Encoding Time:\t%.0f "
                             "ms\nTotal Execution Time:\t%.0f ms\nAverage Latency:\t%.0f ms\nMax "
                             "Latency:\t\t%u ms\n",
@@ -373,11 +392,11 @@ static void print_performance(const EncContext* const enc_context) {
                             app_cfg->performance_context.average_latency,
                             (uint32_t)(app_cfg->performance_context.max_latency));
             } else
-                fprintf(stderr, "\nChannel %u Encoding Interrupted\n", (uint32_t)(inst_cnt + 1));
+                fprintf(app_console(), "\nChannel %u Encoding Interrupted\n", (uint32_t)(inst_cnt + 1));
         } else if (c->return_error == EB_ErrorInsufficientResources)
-            fprintf(stderr, "Could not allocate enough memory for channel %u\n", inst_cnt + 1);
+            fprintf(app_console(), "Could not allocate enough memory for channel %u\n", inst_cnt + 1);
         else
-            fprintf(stderr,
+            fprintf(app_console(),
                     "Error encoding at channel %u! Check error log file for more details "
                     "... \n",
                     inst_cnt + 1);
@@ -388,7 +407,7 @@ static void print_warnnings(const EncContext* const enc_context) {
     char* const* warning = enc_context->warning;
     for (uint32_t warning_id = 0;; warning_id++) {
         if (*warning[warning_id] == '-')
-            fprintf(stderr, "warning: %s\n", warning[warning_id]);
+            fprintf(app_console(), "warning: %s\n", warning[warning_id]);
         else if (*warning[warning_id + 1] != '-')
             break;
     }
@@ -411,14 +430,15 @@ static void enc_channel_step(EncChannel* c, EncApp* enc_app, EncContext* enc_con
 
     if (app_cfg->need_to_skip) {
         bool skip   = !process_skip(app_cfg, app_cfg->input_buffer_pool);
-        int  next_c = fgetc(app_cfg->input_file);
+        int  next_c = app_cfg->input_file ? fgetc(app_cfg->input_file) : 0;
         if (!skip && next_c == EOF) {
-            fputs("\n[SVT-Error]: Skipped all available frames!\n", stderr);
+            fputs("\n[SVT-Error]: Skipped all available frames!\n", app_console());
             c->exit_cond_input = APP_ExitConditionFinished;
             c->active          = FALSE;
             return;
         }
-        ungetc(next_c, app_cfg->input_file);
+        if (app_cfg->input_file)
+            ungetc(next_c, app_cfg->input_file);
     }
 
     process_input_buffer(c);
@@ -466,7 +486,7 @@ static EbErrorType encode(EncApp* enc_app, EncContext* enc_context) {
     for (uint32_t inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt)
         enc_channel_start(enc_context->channels + inst_cnt);
     print_warnnings(enc_context);
-    fprintf(stderr, "%sEncoding          ", get_pass_name(enc_pass));
+    fprintf(app_console(), "%sEncoding          ", get_pass_name(enc_pass));
 
     while (has_active_channel(enc_context)) {
         for (uint32_t inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
@@ -488,28 +508,14 @@ EbErrorType enc_app_ctor(EncApp* enc_app) {
 
 void enc_app_dctor(EncApp* enc_app) { free(enc_app->rc_twopasses_stats.buf); }
 
-/***************************************
- * Encoder App Main
- ***************************************/
-int32_t main(int32_t argc, char* argv[]) {
-#ifdef _WIN32
-    _setmode(_fileno(stdin), _O_BINARY);
-    _setmode(_fileno(stdout), _O_BINARY);
-#endif
-    // GLOBAL VARIABLES
-    EbErrorType return_error = EB_ErrorNone; // Error Handling
+/* Runs all the passes of the encode described by argv */
+static EbErrorType run_encode(int32_t argc, char* argv[]) {
+    EbErrorType return_error = EB_ErrorNone;
     uint32_t    passes;
     EncPass     enc_pass[MAX_ENC_PASS];
     EncApp      enc_app;
     EncContext  enc_context;
 
-    signal(SIGINT, event_handler);
-    if (get_version(argc, argv))
-        return 0;
-
-    if (get_help(argc, argv))
-        return 0;
-
     enc_app_ctor(&enc_app);
     passes = get_passes(argc, argv, enc_pass);
     for (uint8_t pass_idx = 0; pass_idx < passes; pass_idx++) {
@@ -527,6 +533,307 @@ int32_t main(int32_t argc, char* argv[]) {
 #endif
     }
     enc_app_dctor(&enc_app);
+    return return_error;
+}
+
+/***************************************
+ * Job File Mode
+ ***************************************/
+typedef struct EncJob {
+    char*       line; // job line, for the reports
+    int32_t     argc;
+    char*       argv[MAX_NUM_TOKENS]; // common options followed by the job options, NULL terminated
+    char*       storage; // tokens of the job line
+    EbErrorType return_error;
+} EncJob;
+
+typedef struct EncJobQueue {
+    EncJob*  jobs;
+    uint32_t job_count;
+    uint32_t next_job;
+    uint32_t failed_count;
+    AppMutex mutex;
+} EncJobQueue;
+
+static Bool is_job_option(const char* arg) { return arg[0] == '-' && arg[1] != '\0' && !isdigit(arg[1]); }
+
+static Bool job_has_option(const EncJob* job, int32_t first_job_arg, const char* option) {
+    for (int32_t i = first_job_arg; i < job->argc; i++)
+        if (!strcmp(job->argv[i], option))
+            return TRUE;
+    return FALSE;
+}
+
+/* Splits a job line in whitespace separated tokens, double quotes group a token with spaces */
+static int32_t tokenize_job_line(char* str, char** tokens, int32_t max_tokens) {
+    int32_t count = 0;
+    while (*str) {
+        while (isspace((unsigned char)*str)) str++;
+        if (!*str)
+            break;
+        if (count == max_tokens)
+            return -1;
+        char* dst       = str;
+        tokens[count++] = dst;
+        Bool in_quotes  = FALSE;
+        while (*str && (in_quotes || !isspace((unsigned char)*str))) {
+            if (*str == '"')
+                in_quotes = !in_quotes;
+            else
+                *dst++ = *str;
+            str++;
+        }
+        if (*str)
+            str++;
+        *dst = '\0';
+    }
+    return count;
+}
+
+/* Builds the command line of a job: the common options minus --jobs, --nch and the
+ * options set by the job, then the job options. Progress is off unless requested. */
+static EbErrorType build_job(EncJob* job, int32_t argc, char* argv[], const char* line) {
+    char*   job_tokens[MAX_NUM_TOKENS];
+    int32_t job_token_count;
+
+    job->line    = strdup(line);
+    job->storage = strdup(line);
+    if (!job->line || !job->storage)
+        return EB_ErrorInsufficientResources;
+    job->line[strcspn(job->line, "\r\n")] = '\0';
+    job_token_count                       = tokenize_job_line(job->storage, job_tokens, MAX_NUM_TOKENS);
+
+    job->argc                 = 0;
+    job->argv[job->argc++]    = argv[0];
+    const int32_t max_args    = MAX_NUM_TOKENS - 1;
+    Bool          has_progress = FALSE;
+    for (int32_t i = 0; i < job_token_count; i++) has_progress |= !strcmp(job_tokens[i], "--progress");
+    for (int32_t i = 1; i < argc; i++) {
+        Bool skip = !strcmp(argv[i], "--jobs") || !strcmp(argv[i], "--nch");
+        for (int32_t j = 0; j < job_token_count && !skip && is_job_option(argv[i]); j++)
+            skip = !strcmp(argv[i], job_tokens[j]);
+        if (skip) {
+            // options take a single value
+            if (i + 1 < argc && !is_job_option(argv[i + 1]))
+                i++;
+            continue;
+        }
+        has_progress |= !strcmp(argv[i], "--progress");
+        if (job->argc < max_args)
+            job->argv[job->argc++] = argv[i];
+    }
+    if (!has_progress && job->argc + 2 < max_args) {
+        job->argv[job->argc++] = "--progress";
+        job->argv[job->argc++] = "0";
+    }
+    const int32_t first_job_arg = job->argc;
+    for (int32_t i = 0; i < job_token_count; i++)
+        if (job->argc < max_args)
+            job->argv[job->argc++] = job_tokens[i];
+    job->argv[job->argc] = NULL;
+    if (job_token_count < 0 || job->argc == max_args) {
+        fprintf(stderr, "[SVT-Error]: too many options in job: %s\n", job->line);
+        return EB_ErrorBadParameter;
+    }
+    if (!job_has_option(job, first_job_arg, "-i") && !job_has_option(job, first_job_arg, "--input")) {
+        fprintf(stderr, "[SVT-Error]: no input file in job: %s\n", job->line);
+        return EB_ErrorBadParameter;
+    }
+    return EB_ErrorNone;
+}
+
+static void free_jobs(EncJobQueue* queue) {
+    for (uint32_t i = 0; i < queue->job_count; i++) {
+        free(queue->jobs[i].line);
+        free(queue->jobs[i].storage);
+    }
+    free(queue->jobs);
+}
+
+/* Reads the job file, one job per non empty line, lines starting with # are comments */
+static EbErrorType read_job_file(EncJobQueue* queue, const char* path, int32_t argc, char* argv[]) {
+    FILE* file = fopen(path, "r");
+    char  line[COMMAND_LINE_MAX_SIZE];
+    if (!file) {
+        fprintf(stderr, "[SVT-Error]: could not open job file %s\n", path);
+        return EB_ErrorBadParameter;
+    }
+    memset(queue, 0, sizeof(*queue));
+    EbErrorType return_error = EB_ErrorNone;
+    while (return_error == EB_ErrorNone && fgets(line, sizeof(line), file)) {
+        const char* p = line;
+        while (isspace((unsigned char)*p)) p++;
+        if (!*p || *p == '#')
+            continue;
+        EncJob* jobs = (EncJob*)realloc(queue->jobs, sizeof(*jobs) * (queue->job_count + 1));
+        if (!jobs) {
+            return_error = EB_ErrorInsufficientResources;
+            break;
+        }
+        queue->jobs = jobs;
+        memset(&jobs[queue->job_count], 0, sizeof(*jobs));
+        return_error = build_job(&jobs[queue->job_count++], argc, argv, p);
+    }
+    fclose(file);
+    if (return_error == EB_ErrorNone && !queue->job_count) {
+        fprintf(stderr, "[SVT-Error]: no job in %s\n", path);
+        return_error = EB_ErrorBadParameter;
+    }
+    return return_error;
+}
+
+/* Value of the last occurrence of option in the job command line, NULL without it */
+static const char* job_option_value(const EncJob* job, const char* option) {
+    const char* value = NULL;
+    for (int32_t i = 1; i + 1 < job->argc; i++)
+        if (!strcmp(job->argv[i], option))
+            value = job->argv[i + 1];
+    return value;
+}
+
+/* The jobs run in one process: the kernels of the asm level are set for the whole process and the
+ * jobs cannot share stdout */
+static EbErrorType check_jobs(const EncJobQueue* queue) {
+    const char* asm_type = job_option_value(&queue->jobs[0], "--asm");
+    for (uint32_t i = 0; i < queue->job_count; i++) {
+        const EncJob* job     = &queue->jobs[i];
+        const char*   job_asm = job_option_value(job, "--asm");
+        if ((asm_type || job_asm) && (!asm_type || !job_asm || strcmp(asm_type, job_asm))) {
+            fprintf(stderr, "[SVT-Error]: the jobs of a job file have to use the same --asm: %s\n", job->line);
+            return EB_ErrorBadParameter;
+        }
+        const char* outputs[] = {job_option_value(job, "-b"), job_option_value(job, "--output")};
+        for (int j = 0; j < 2; j++) {
+            if (outputs[j] && (!strcmp(outputs[j], "stdout") || !strcmp(outputs[j], "-"))) {
+                fprintf(stderr, "[SVT-Error]: a job cannot write its output to stdout: %s\n", job->line);
+                return EB_ErrorBadParameter;
+            }
+        }
+    }
+    return EB_ErrorNone;
+}
+
+/* Prints what the job wrote to its console stream */
+static void print_job_output(FILE* output) {
+    char   buffer[4096];
+    size_t len;
+    rewind(output);
+    while ((len = fread(buffer, 1, sizeof(buffer), output)) > 0) fwrite(buffer, 1, len, stderr);
+}
+
+/* Each worker runs one encode at a time, with its own input and output loop, and takes the next
+ * job as soon as it is done. The console output of the job goes to its own stream, printed at once
+ * when the job is done. */
+#ifdef _WIN32
+static DWORD WINAPI job_worker(LPVOID arg) {
+#else
+static void* job_worker(void* arg) {
+#endif
+    EncJobQueue* queue = (EncJobQueue*)arg;
+    for (;;) {
+        app_mutex_lock(&queue->mutex);
+        const uint32_t job_idx = keep_running ? queue->next_job : queue->job_count;
+        if (job_idx < queue->job_count)
+            queue->next_job++;
+        app_mutex_unlock(&queue->mutex);
+        if (job_idx >= queue->job_count)
+            break;
+
+        EncJob* job = &queue->jobs[job_idx];
+        app_mutex_lock(&print_mutex);
+        fprintf(stderr, "[SVT-Jobs]: job %u/%u started: %s\n", job_idx + 1, queue->job_count, job->line);
+        app_mutex_unlock(&print_mutex);
+
+        FILE* output = tmpfile();
+        set_app_console(output);
+        job->return_error = run_encode(job->argc, job->argv);
+        set_app_console(NULL);
+
+        app_mutex_lock(&queue->mutex);
+        queue->failed_count += job->return_error != EB_ErrorNone;
+        app_mutex_unlock(&queue->mutex);
+        app_mutex_lock(&print_mutex);
+        if (output) {
+            print_job_output(output);
+            fclose(output);
+        }
+        fprintf(stderr,
+                "[SVT-Jobs]: job %u/%u %s: %s\n",
+                job_idx + 1,
+                queue->job_count,
+                job->return_error == EB_ErrorNone ? "done" : "failed",
+                job->line);
+        app_mutex_unlock(&print_mutex);
+    }
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static EbErrorType run_jobs(int32_t argc, char* argv[], const char* jobs_file) {
+    EncJobQueue queue;
+    uint32_t    num_workers = get_number_of_channels(argc, argv);
+    if (num_workers == 0)
+        return EB_ErrorBadParameter;
+    EbErrorType return_error = read_job_file(&queue, jobs_file, argc, argv);
+    if (return_error == EB_ErrorNone)
+        return_error = check_jobs(&queue);
+    if (return_error != EB_ErrorNone) {
+        free_jobs(&queue);
+        return return_error;
+    }
+    num_workers = num_workers < queue.job_count ? num_workers : queue.job_count;
+
+    app_mutex_init(&queue.mutex);
+    app_mutex_init(&print_mutex);
+#ifdef _WIN32
+    HANDLE workers[MAX_CHANNEL_NUMBER];
+    for (uint32_t i = 0; i < num_workers; i++) workers[i] = CreateThread(NULL, 0, job_worker, &queue, 0, NULL);
+    WaitForMultipleObjects(num_workers, workers, TRUE, INFINITE);
+    for (uint32_t i = 0; i < num_workers; i++) CloseHandle(workers[i]);
+#else
+    pthread_t workers[MAX_CHANNEL_NUMBER];
+    for (uint32_t i = 0; i < num_workers; i++) pthread_create(&workers[i], NULL, job_worker, &queue);
+    for (uint32_t i = 0; i < num_workers; i++) pthread_join(workers[i], NULL);
+#endif
+    app_mutex_destroy(&print_mutex);
+    app_mutex_destroy(&queue.mutex);
+
+    fprintf(stderr,
+            "[SVT-Jobs]: %u of %u jobs done, %u failed\n",
+            queue.next_job - queue.failed_count,
+            queue.job_count,
+            queue.failed_count);
+    return_error = queue.failed_count || queue.next_job < queue.job_count ? EB_ErrorBadParameter : EB_ErrorNone;
+    free_jobs(&queue);
+    return return_error;
+}
+
+/***************************************
+ * Encoder App Main
+ ***************************************/
+int32_t main(int32_t argc, char* argv[]) {
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    // GLOBAL VARIABLES
+    EbErrorType return_error = EB_ErrorNone; // Error Handling
+    char        jobs_file[COMMAND_LINE_MAX_SIZE];
+
+    signal(SIGINT, event_handler);
+    if (get_version(argc, argv))
+        return 0;
+
+    if (get_help(argc, argv))
+        return 0;
+
+    if (get_jobs_file(argc, argv, jobs_file))
+        return_error = run_jobs(argc, argv, jobs_file);
+    else
+        return_error = run_encode(argc, argv);
 
 #if LOG_ENC_DONE
     fprintf(stderr, "all_done_encoding  %i frames \n", tot_frames_done);
@@ -0,0 +1,369 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "app_config.h"
+#include "app_output_mp4.h"
+#include "app_output_obu.h"
+
+#define MP4_TRACK_ID 1
+#define MP4_HEADER_MAX_SIZE 2048
+#define MP4_MOOF_MAX_SIZE 128
+// trun / trex sample flags, ISO/IEC 14496-12 8.8.3.1
+#define MP4_SYNC_SAMPLE_FLAGS 0x02000000 // sample_depends_on = 2
+#define MP4_NON_SYNC_SAMPLE_FLAGS 0x01010000 // sample_depends_on = 1, sample_is_non_sync_sample
+
+typedef struct Mp4Buffer {
+    uint8_t *data;
+    size_t   size;
+    size_t   capacity;
+} Mp4Buffer;
+
+static void put_u8(Mp4Buffer *buf, uint32_t val) {
+    if (buf->size < buf->capacity)
+        buf->data[buf->size] = (uint8_t)val;
+    buf->size++;
+}
+
+static void put_u16(Mp4Buffer *buf, uint32_t val) {
+    put_u8(buf, val >> 8);
+    put_u8(buf, val);
+}
+
+static void put_u32(Mp4Buffer *buf, uint32_t val) {
+    put_u16(buf, val >> 16);
+    put_u16(buf, val);
+}
+
+static void put_u64(Mp4Buffer *buf, uint64_t val) {
+    put_u32(buf, (uint32_t)(val >> 32));
+    put_u32(buf, (uint32_t)val);
+}
+
+static void put_bytes(Mp4Buffer *buf, const void *data, size_t size) {
+    for (size_t i = 0; i < size; i++) put_u8(buf, ((const uint8_t *)data)[i]);
+}
+
+static void put_zeros(Mp4Buffer *buf, size_t size) {
+    for (size_t i = 0; i < size; i++) put_u8(buf, 0);
+}
+
+// Starts a box, the size is patched by end_box()
+static size_t start_box(Mp4Buffer *buf, const char *type) {
+    const size_t offset = buf->size;
+    put_u32(buf, 0);
+    put_bytes(buf, type, 4);
+    return offset;
+}
+
+static size_t start_full_box(Mp4Buffer *buf, const char *type, uint32_t version, uint32_t flags) {
+    const size_t offset = start_box(buf, type);
+    put_u32(buf, (version << 24) | flags);
+    return offset;
+}
+
+static void end_box(Mp4Buffer *buf, size_t offset) {
+    const uint32_t size = (uint32_t)(buf->size - offset);
+    if (offset + 4 <= buf->capacity) {
+        buf->data[offset + 0] = (uint8_t)(size >> 24);
+        buf->data[offset + 1] = (uint8_t)(size >> 16);
+        buf->data[offset + 2] = (uint8_t)(size >> 8);
+        buf->data[offset + 3] = (uint8_t)size;
+    }
+}
+
+static void put_matrix(Mp4Buffer *buf) {
+    static const uint32_t unity[9] = {0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000};
+    for (int i = 0; i < 9; i++) put_u32(buf, unity[i]);
+}
+
+typedef struct BitReader {
+    const uint8_t *data;
+    size_t         size;
+    size_t         pos; // in bits
+} BitReader;
+
+static uint32_t read_bits(BitReader *br, int n) {
+    uint32_t val = 0;
+    for (int i = 0; i < n; i++, br->pos++) {
+        const size_t byte = br->pos >> 3;
+        const int    bit  = byte < br->size ? (br->data[byte] >> (7 - (br->pos & 7))) & 1 : 0;
+        val               = (val << 1) | bit;
+    }
+    return val;
+}
+
+static void skip_uvlc(BitReader *br) {
+    int leading_zeros = 0;
+    while (leading_zeros < 32 && !read_bits(br, 1)) leading_zeros++;
+    br->pos += leading_zeros;
+}
+
+// av1C fields that come before the color config of the sequence header
+typedef struct SeqHeaderInfo {
+    uint32_t seq_profile;
+    uint32_t seq_level_idx_0;
+    uint32_t seq_tier_0;
+} SeqHeaderInfo;
+
+static void parse_sequence_header(const AppObu *obu, SeqHeaderInfo *info) {
+    BitReader br = {obu->payload, obu->payload_size, 0};
+    info->seq_profile = read_bits(&br, 3);
+    read_bits(&br, 1); // still_picture
+    if (read_bits(&br, 1)) { // reduced_still_picture_header
+        info->seq_level_idx_0 = read_bits(&br, 5);
+        info->seq_tier_0      = 0;
+        return;
+    }
+    if (read_bits(&br, 1)) { // timing_info_present_flag
+        read_bits(&br, 32); // num_units_in_display_tick
+        read_bits(&br, 32); // time_scale
+        if (read_bits(&br, 1)) // equal_picture_interval
+            skip_uvlc(&br);
+        if (read_bits(&br, 1)) { // decoder_model_info_present_flag
+            read_bits(&br, 5); // buffer_delay_length_minus_1
+            read_bits(&br, 32); // num_units_in_decoding_tick
+            read_bits(&br, 10); // buffer_removal_time_length_minus_1, frame_presentation_time_length_minus_1
+        }
+    }
+    read_bits(&br, 1); // initial_display_delay_present_flag
+    read_bits(&br, 5); // operating_points_cnt_minus_1
+    read_bits(&br, 12); // operating_point_idc[0]
+    info->seq_level_idx_0 = read_bits(&br, 5);
+    info->seq_tier_0      = info->seq_level_idx_0 > 7 ? read_bits(&br, 1) : 0;
+}
+
+static void put_av1c(Mp4Buffer *buf, const EbSvtAv1EncConfiguration *config, const AppObu *seq_header) {
+    SeqHeaderInfo info;
+    parse_sequence_header(seq_header, &info);
+    const uint32_t high_bitdepth = config->encoder_bit_depth > 8;
+    const uint32_t twelve_bit    = config->encoder_bit_depth == 12;
+    const uint32_t monochrome    = config->encoder_color_format == EB_YUV400;
+    const uint32_t subsampling_x = config->encoder_color_format != EB_YUV444;
+    const uint32_t subsampling_y = config->encoder_color_format == EB_YUV420 ||
+        config->encoder_color_format == EB_YUV400;
+    const uint32_t sample_position = subsampling_x && subsampling_y ? (uint32_t)config->chroma_sample_position & 3 : 0;
+
+    const size_t av1c = start_box(buf, "av1C");
+    put_u8(buf, 0x81); // marker, version 1
+    put_u8(buf, (info.seq_profile << 5) | info.seq_level_idx_0);
+    put_u8(buf,
+           (info.seq_tier_0 << 7) | (high_bitdepth << 6) | (twelve_bit << 5) | (monochrome << 4) |
+               (subsampling_x << 3) | (subsampling_y << 2) | sample_position);
+    put_u8(buf, 0); // no initial_presentation_delay
+    put_bytes(buf, seq_header->data, seq_header->size);
+    end_box(buf, av1c);
+}
+
+static void put_sample_entry(Mp4Buffer *buf, const EbConfig *app_cfg, const AppObu *seq_header) {
+    const size_t av01 = start_box(buf, "av01");
+    put_zeros(buf, 6); // reserved
+    put_u16(buf, 1); // data_reference_index
+    put_zeros(buf, 16); // pre_defined, reserved
+    put_u16(buf, app_cfg->input_padded_width);
+    put_u16(buf, app_cfg->input_padded_height);
+    put_u32(buf, 0x00480000); // horizresolution, 72 dpi
+    put_u32(buf, 0x00480000); // vertresolution
+    put_u32(buf, 0); // reserved
+    put_u16(buf, 1); // frame_count
+    put_zeros(buf, 32); // compressorname
+    put_u16(buf, 0x0018); // depth
+    put_u16(buf, 0xffff); // pre_defined
+    put_av1c(buf, &app_cfg->config, seq_header);
+    end_box(buf, av01);
+}
+
+static size_t build_header(Mp4Buffer *buf, const EbConfig *app_cfg, const AppObu *seq_header) {
+    const uint32_t timescale = app_cfg->config.frame_rate_numerator;
+    const uint32_t duration  = app_cfg->config.frame_rate_denominator;
+
+    const size_t ftyp = start_box(buf, "ftyp");
+    put_bytes(buf, "iso6", 4);
+    put_u32(buf, 0); // minor_version
+    put_bytes(buf, "iso6cmfcav01mp41", 16);
+    end_box(buf, ftyp);
+
+    const size_t moov = start_box(buf, "moov");
+    const size_t mvhd = start_full_box(buf, "mvhd", 0, 0);
+    put_u32(buf, 0); // creation_time
+    put_u32(buf, 0); // modification_time
+    put_u32(buf, timescale);
+    put_u32(buf, 0); // duration, given by the fragments
+    put_u32(buf, 0x00010000); // rate
+    put_u16(buf, 0x0100); // volume
+    put_zeros(buf, 10); // reserved
+    put_matrix(buf);
+    put_zeros(buf, 24); // pre_defined
+    put_u32(buf, MP4_TRACK_ID + 1); // next_track_ID
+    end_box(buf, mvhd);
+
+    const size_t trak = start_box(buf, "trak");
+    const size_t tkhd = start_full_box(buf, "tkhd", 0, 3); // enabled, in movie
+    put_u32(buf, 0); // creation_time
+    put_u32(buf, 0); // modification_time
+    put_u32(buf, MP4_TRACK_ID);
+    put_u32(buf, 0); // reserved
+    put_u32(buf, 0); // duration
+    put_zeros(buf, 8); // reserved
+    put_u16(buf, 0); // layer
+    put_u16(buf, 0); // alternate_group
+    put_u16(buf, 0); // volume
+    put_u16(buf, 0); // reserved
+    put_matrix(buf);
+    put_u32(buf, app_cfg->input_padded_width << 16);
+    put_u32(buf, app_cfg->input_padded_height << 16);
+    end_box(buf, tkhd);
+
+    const size_t mdia = start_box(buf, "mdia");
+    const size_t mdhd = start_full_box(buf, "mdhd", 0, 0);
+    put_u32(buf, 0); // creation_time
+    put_u32(buf, 0); // modification_time
+    put_u32(buf, timescale);
+    put_u32(buf, 0); // duration
+    put_u16(buf, 0x55c4); // language "und"
+    put_u16(buf, 0); // pre_defined
+    end_box(buf, mdhd);
+
+    const size_t hdlr = start_full_box(buf, "hdlr", 0, 0);
+    put_u32(buf, 0); // pre_defined
+    put_bytes(buf, "vide", 4);
+    put_zeros(buf, 12); // reserved
+    put_bytes(buf, "SVT-AV1", 8); // name, null terminated
+    end_box(buf, hdlr);
+
+    const size_t minf = start_box(buf, "minf");
+    const size_t vmhd = start_full_box(buf, "vmhd", 0, 1);
+    put_zeros(buf, 8); // graphicsmode, opcolor
+    end_box(buf, vmhd);
+    const size_t dinf = start_box(buf, "dinf");
+    const size_t dref = start_full_box(buf, "dref", 0, 0);
+    put_u32(buf, 1); // entry_count
+    end_box(buf, start_full_box(buf, "url ", 0, 1)); // media data in the same file
+    end_box(buf, dref);
+    end_box(buf, dinf);
+
+    const size_t stbl = start_box(buf, "stbl");
+    const size_t stsd = start_full_box(buf, "stsd", 0, 0);
+    put_u32(buf, 1); // entry_count
+    put_sample_entry(buf, app_cfg, seq_header);
+    end_box(buf, stsd);
+    // the samples are all described by the fragments
+    const size_t stts = start_full_box(buf, "stts", 0, 0);
+    put_u32(buf, 0);
+    end_box(buf, stts);
+    const size_t stsc = start_full_box(buf, "stsc", 0, 0);
+    put_u32(buf, 0);
+    end_box(buf, stsc);
+    const size_t stsz = start_full_box(buf, "stsz", 0, 0);
+    put_u32(buf, 0); // sample_size
+    put_u32(buf, 0); // sample_count
+    end_box(buf, stsz);
+    const size_t stco = start_full_box(buf, "stco", 0, 0);
+    put_u32(buf, 0);
+    end_box(buf, stco);
+    end_box(buf, stbl);
+    end_box(buf, minf);
+    end_box(buf, mdia);
+    end_box(buf, trak);
+
+    const size_t mvex = start_box(buf, "mvex");
+    const size_t trex = start_full_box(buf, "trex", 0, 0);
+    put_u32(buf, MP4_TRACK_ID);
+    put_u32(buf, 1); // default_sample_description_index
+    put_u32(buf, duration); // default_sample_duration
+    put_u32(buf, 0); // default_sample_size
+    put_u32(buf, MP4_NON_SYNC_SAMPLE_FLAGS); // default_sample_flags
+    end_box(buf, trex);
+    end_box(buf, mvex);
+    end_box(buf, moov);
+    return buf->size;
+}
+
+static size_t build_moof(Mp4Buffer *buf, uint32_t sequence_number, uint64_t decode_time, uint32_t sample_size,
+                         int is_sync) {
+    const size_t moof = start_box(buf, "moof");
+    const size_t mfhd = start_full_box(buf, "mfhd", 0, 0);
+    put_u32(buf, sequence_number);
+    end_box(buf, mfhd);
+
+    const size_t traf = start_box(buf, "traf");
+    const size_t tfhd = start_full_box(buf, "tfhd", 0, 0x020000); // default-base-is-moof
+    put_u32(buf, MP4_TRACK_ID);
+    end_box(buf, tfhd);
+    const size_t tfdt = start_full_box(buf, "tfdt", 1, 0);
+    put_u64(buf, decode_time);
+    end_box(buf, tfdt);
+    // data-offset-present, sample-size-present and first-sample-flags-present for key frames
+    const size_t trun = start_full_box(buf, "trun", 0, 0x000201 | (is_sync ? 0x000004 : 0));
+    put_u32(buf, 1); // sample_count
+    const size_t data_offset = buf->size;
+    put_u32(buf, 0);
+    if (is_sync)
+        put_u32(buf, MP4_SYNC_SAMPLE_FLAGS);
+    put_u32(buf, sample_size);
+    end_box(buf, trun);
+    end_box(buf, traf);
+    end_box(buf, moof);
+
+    // the sample follows the 8 byte mdat header
+    const size_t end = buf->size;
+    buf->size        = data_offset;
+    put_u32(buf, (uint32_t)(end - moof) + 8);
+    buf->size = end;
+    put_u32(buf, 8 + sample_size);
+    put_bytes(buf, "mdat", 4);
+    return buf->size;
+}
+
+void write_mp4_temporal_unit(EbConfig *app_cfg, const uint8_t *data, uint32_t size, EbAv1PictureType pic_type) {
+    AppObu obu;
+    // temporal delimiters are not stored in the samples
+    while (size && app_parse_obu(data, size, &obu) && obu.type == OBU_TYPE_TEMPORAL_DELIMITER) {
+        data += obu.size;
+        size -= (uint32_t)obu.size;
+    }
+    if (!size)
+        return;
+
+    if (!app_cfg->mp4_sequence_number) {
+        const uint8_t *p   = data;
+        const uint8_t *end = data + size;
+        while (p < end && app_parse_obu(p, end - p, &obu) && obu.type != OBU_TYPE_SEQUENCE_HEADER) p += obu.size;
+        if (p >= end || obu.type != OBU_TYPE_SEQUENCE_HEADER) {
+            fprintf(app_console(), "Error: the first temporal unit has no sequence header, mp4 output skipped\n");
+            return;
+        }
+        uint8_t   header[MP4_HEADER_MAX_SIZE];
+        Mp4Buffer buf = {header, 0, sizeof(header)};
+        if (build_header(&buf, app_cfg, &obu) > buf.capacity) {
+            fprintf(app_console(), "Error: sequence header too large for the mp4 header\n");
+            return;
+        }
+        fwrite(header, 1, buf.size, app_cfg->bitstream_file);
+        app_cfg->mp4_sequence_number = 1;
+    }
+
+    uint8_t      moof[MP4_MOOF_MAX_SIZE];
+    Mp4Buffer    buf = {moof, 0, sizeof(moof)};
+    AppIoVecList list;
+    list.file         = app_cfg->bitstream_file;
+    list.count        = 0;
+    list.scratch_used = 0;
+    build_moof(
+        &buf, app_cfg->mp4_sequence_number++, app_cfg->mp4_decode_time, size, pic_type == EB_AV1_KEY_PICTURE);
+    app_io_vec_add(&list, moof, buf.size);
+    app_io_vec_add(&list, data, size);
+    app_io_vec_flush(&list);
+    app_cfg->mp4_decode_time += app_cfg->config.frame_rate_denominator;
+}
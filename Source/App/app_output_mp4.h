@@ -0,0 +1,25 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAppOutputMp4_h
+#define EbAppOutputMp4_h
+
+#include <stdint.h>
+
+#include "app_config.h"
+
+/* Writes one temporal unit to a fragmented mp4 file. The ftyp and moov boxes are
+ * written with the first temporal unit, which carries the sequence header. Every
+ * temporal unit is a moof/mdat chunk, so a CMAF fragment starts at each key frame
+ * and nothing has to be buffered. */
+void write_mp4_temporal_unit(EbConfig *app_cfg, const uint8_t *data, uint32_t size, EbAv1PictureType pic_type);
+
+#endif
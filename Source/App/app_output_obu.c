@@ -0,0 +1,160 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "app_config.h"
+#include "app_output_obu.h"
+
+// A temporal unit holds the shown frame and the frames it reveals, see encode_tu() in the library
+#define ANNEXB_MAX_FRAME_UNITS 128
+
+void app_io_vec_flush(AppIoVecList *list) {
+    for (int i = 0; i < list->count; i++) fwrite(list->vec[i].base, 1, list->vec[i].len, list->file);
+    list->count        = 0;
+    list->scratch_used = 0;
+}
+
+void app_io_vec_add(AppIoVecList *list, const void *base, size_t len) {
+    if (!len)
+        return;
+    if (list->count == APP_IO_VEC_MAX)
+        app_io_vec_flush(list);
+    list->vec[list->count].base = base;
+    list->vec[list->count].len  = len;
+    list->count++;
+}
+
+void app_io_vec_add_copy(AppIoVecList *list, const void *data, size_t len) {
+    if (len > APP_IO_SCRATCH_SIZE) {
+        // too large for the scratch area, write it out now
+        app_io_vec_flush(list);
+        fwrite(data, 1, len, list->file);
+        return;
+    }
+    if (list->scratch_used + len > APP_IO_SCRATCH_SIZE || list->count == APP_IO_VEC_MAX)
+        app_io_vec_flush(list);
+    uint8_t *dst = list->scratch + list->scratch_used;
+    memcpy(dst, data, len);
+    list->scratch_used += len;
+    app_io_vec_add(list, dst, len);
+}
+
+size_t app_leb128_size(uint64_t value) {
+    size_t size = 1;
+    while (value >>= 7) size++;
+    return size;
+}
+
+void app_io_vec_add_leb128(AppIoVecList *list, uint64_t value) {
+    uint8_t bytes[10];
+    size_t  size = 0;
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        bytes[size++] = byte | (value ? 0x80 : 0);
+    } while (value);
+    app_io_vec_add_copy(list, bytes, size);
+}
+
+static int read_leb128(const uint8_t *data, size_t size, uint64_t *value, size_t *length) {
+    *value = 0;
+    for (size_t i = 0; i < 8 && i < size; i++) {
+        *value |= (uint64_t)(data[i] & 0x7f) << (i * 7);
+        if (!(data[i] & 0x80)) {
+            *length = i + 1;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int app_parse_obu(const uint8_t *data, size_t size, AppObu *obu) {
+    if (size < 1 || (data[0] & 0x80))
+        return 0;
+    const int has_extension = (data[0] >> 2) & 1;
+    const int has_size      = (data[0] >> 1) & 1;
+    size_t    header_size   = 1 + has_extension;
+    uint64_t  payload_size;
+    if (header_size > size)
+        return 0;
+    if (has_size) {
+        size_t length;
+        if (!read_leb128(data + header_size, size - header_size, &payload_size, &length))
+            return 0;
+        header_size += length;
+    } else
+        payload_size = size - header_size;
+    if (payload_size > size - header_size)
+        return 0;
+    obu->data         = data;
+    obu->size         = header_size + (size_t)payload_size;
+    obu->payload      = data + header_size;
+    obu->payload_size = (size_t)payload_size;
+    obu->type         = (data[0] >> 3) & 0xf;
+    return 1;
+}
+
+void write_obu_temporal_unit(EbConfig *app_cfg, const uint8_t *data, uint32_t size) {
+    fwrite(data, 1, size, app_cfg->bitstream_file);
+}
+
+/*
+ * temporal_unit(sz) is a list of frame_unit(sz), each a list of obus with their length.
+ * A new frame unit starts at every frame (header) obu after the first one, the temporal
+ * delimiter and sequence header go in the first frame unit.
+ */
+void write_annexb_temporal_unit(EbConfig *app_cfg, const uint8_t *data, uint32_t size) {
+    struct {
+        const uint8_t *start;
+        const uint8_t *end;
+        uint64_t       size;
+    } units[ANNEXB_MAX_FRAME_UNITS];
+    int      unit_count = 0;
+    int      has_frame  = 0;
+    uint64_t tu_size    = 0;
+    AppObu   obu;
+
+    for (const uint8_t *p = data, *end = data + size; p < end; p += obu.size) {
+        if (!app_parse_obu(p, end - p, &obu)) {
+            fprintf(app_console(), "Error: invalid obu in the encoder output, Annex B unit dropped\n");
+            return;
+        }
+        const int is_frame = obu.type == OBU_TYPE_FRAME || obu.type == OBU_TYPE_FRAME_HEADER;
+        if (!unit_count || (is_frame && has_frame && unit_count < ANNEXB_MAX_FRAME_UNITS)) {
+            units[unit_count].start = p;
+            units[unit_count].size  = 0;
+            unit_count++;
+            has_frame = 0;
+        }
+        has_frame |= is_frame;
+        units[unit_count - 1].end = p + obu.size;
+        units[unit_count - 1].size += app_leb128_size(obu.size) + obu.size;
+    }
+    for (int i = 0; i < unit_count; i++) tu_size += app_leb128_size(units[i].size) + units[i].size;
+
+    AppIoVecList list;
+    list.file         = app_cfg->bitstream_file;
+    list.count        = 0;
+    list.scratch_used = 0;
+    app_io_vec_add_leb128(&list, tu_size);
+    for (int i = 0; i < unit_count; i++) {
+        app_io_vec_add_leb128(&list, units[i].size);
+        for (const uint8_t *p = units[i].start; p < units[i].end; p += obu.size) {
+            app_parse_obu(p, units[i].end - p, &obu);
+            app_io_vec_add_leb128(&list, obu.size);
+            app_io_vec_add(&list, p, obu.size);
+        }
+    }
+    app_io_vec_flush(&list);
+}
@@ -0,0 +1,65 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAppOutputObu_h
+#define EbAppOutputObu_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "app_config.h"
+
+#define OBU_TYPE_SEQUENCE_HEADER 1
+#define OBU_TYPE_TEMPORAL_DELIMITER 2
+#define OBU_TYPE_FRAME_HEADER 3
+#define OBU_TYPE_FRAME 6
+
+// One OBU of a temporal unit, pointing into the encoder output buffer
+typedef struct AppObu {
+    const uint8_t *data; // start of the obu header
+    size_t         size; // header + size field + payload
+    const uint8_t *payload;
+    size_t         payload_size;
+    int            type;
+} AppObu;
+
+/* Gather list of buffers written with as few calls as possible. The encoder
+ * output buffers are referenced, never copied, only the small container
+ * fields are stored in the scratch area. */
+#define APP_IO_VEC_MAX 64
+#define APP_IO_SCRATCH_SIZE 512
+typedef struct AppIoVecList {
+    FILE *file;
+    int   count;
+    struct {
+        const void *base;
+        size_t      len;
+    } vec[APP_IO_VEC_MAX];
+    size_t  scratch_used;
+    uint8_t scratch[APP_IO_SCRATCH_SIZE];
+} AppIoVecList;
+
+void   app_io_vec_add(AppIoVecList *list, const void *base, size_t len);
+void   app_io_vec_add_copy(AppIoVecList *list, const void *data, size_t len);
+void   app_io_vec_add_leb128(AppIoVecList *list, uint64_t value);
+void   app_io_vec_flush(AppIoVecList *list);
+size_t app_leb128_size(uint64_t value);
+
+// Parses the obu at the start of data, returns 0 if it is truncated or invalid
+int app_parse_obu(const uint8_t *data, size_t size, AppObu *obu);
+
+// Writes a temporal unit as low overhead (Section 5) obus, the native format of the encoder
+void write_obu_temporal_unit(EbConfig *app_cfg, const uint8_t *data, uint32_t size);
+// Writes a temporal unit with the length fields of Annex B of the AV1 specification
+void write_annexb_temporal_unit(EbConfig *app_cfg, const uint8_t *data, uint32_t size);
+
+#endif
@@ -22,17 +22,23 @@
 #include "app_config.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "app_input_y4m.h"
+#include "app_input_synthetic.h"
 #include "svt_time.h"
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <io.h>
+#include <psapi.h>
 #else
 #include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
 #endif
 
 #include "app_output_ivf.h"
+#include "app_output_mp4.h"
+#include "app_output_obu.h"
 
 /***************************************
  * Macros
@@ -193,7 +199,7 @@ static unsigned char send_qp_on_the_fly(FILE *const qp_file, Bool *use_qp_file)
 
     if (tmp_qp == -1) {
         *use_qp_file = FALSE;
-        fprintf(stderr, "\nWarning: QP File did not contain any valid QPs");
+        fprintf(app_console(), "\nWarning: QP File did not contain any valid QPs");
     }
     return (unsigned)CLIP3(0, 63, tmp_qp);
 }
@@ -707,14 +713,54 @@ static void buffered_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBu
     header_ptr->n_filled_len = (uint32_t)(luma_size + 2 * chroma_size);
 }
 
-void init_reader(EbConfig *app_cfg) {
-    if (app_cfg->buffered_input != -1) {
+static void synthetic_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+    const uint32_t input_padded_width  = app_cfg->input_padded_width;
+    const uint32_t input_padded_height = app_cfg->input_padded_height;
+    EbSvtIOFormat *input_ptr           = (EbSvtIOFormat *)header_ptr->p_buffer;
+
+    const uint8_t color_format  = app_cfg->config.encoder_color_format;
+    const uint8_t subsampling_x = (color_format == EB_YUV444 ? 1 : 2) - 1;
+
+    input_ptr->y_stride  = input_padded_width;
+    input_ptr->cr_stride = input_padded_width >> subsampling_x;
+    input_ptr->cb_stride = input_padded_width >> subsampling_x;
+
+    synthetic_source_fill(app_cfg->synthetic_source,
+                          app_cfg->synthetic_frame++,
+                          input_ptr->luma,
+                          input_ptr->cb,
+                          input_ptr->cr,
+                          input_ptr->y_stride,
+                          input_ptr->cb_stride,
+                          input_ptr->cr_stride);
+    header_ptr->n_filled_len = (uint32_t)SIZE_OF_ONE_FRAME_IN_BYTES(
+        input_padded_width, input_padded_height, color_format, is_16bit);
+}
+
+EbErrorType init_reader(EbConfig *app_cfg) {
+    if (app_cfg->synthetic_input) {
+        // scenes of 3 seconds on average
+        const EbColorFormat color_format = (EbColorFormat)app_cfg->config.encoder_color_format;
+        const uint32_t      fps          = app_cfg->config.frame_rate_denominator
+                      ? app_cfg->config.frame_rate_numerator / app_cfg->config.frame_rate_denominator
+                      : 0;
+        app_cfg->synthetic_source = synthetic_source_create(app_cfg->input_padded_width,
+                                                            app_cfg->input_padded_height,
+                                                            app_cfg->config.encoder_bit_depth,
+                                                            color_format < EB_YUV444,
+                                                            color_format < EB_YUV422,
+                                                            fps ? 3 * fps : 90);
+        if (!app_cfg->synthetic_source)
+            return EB_ErrorInsufficientResources;
+        read_input = synthetic_read_input_frames;
+    } else if (app_cfg->buffered_input != -1) {
         read_input = buffered_read_input_frames;
     } else if (app_cfg->mmap.enable) {
         read_input = mmap_read_input_frames;
     } else {
         read_input = normal_read_input_frames;
     }
+    return EB_ErrorNone;
 }
 
 /***************************************
@@ -786,6 +832,140 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     return;
 }
 
+/* Checkpoint: save the encoder state of the key frame about to be written, with its position in the
+ * output file. The file is replaced at once, so that a crash leaves the previous checkpoint. */
+static void write_checkpoint(EbConfig *app_cfg, EbComponentType *component_handle) {
+    SvtAv1Checkpoint checkpoint;
+    if (svt_av1_enc_get_stream_info(component_handle, SVT_AV1_STREAM_INFO_CHECKPOINT, &checkpoint) != EB_ErrorNone ||
+        checkpoint.picture_number <= app_cfg->checkpoint_picture_number)
+        return;
+    AppCheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, APP_CHECKPOINT_MAGIC, sizeof(header.magic));
+    header.picture_number = checkpoint.picture_number;
+    header.file_offset    = (uint64_t)ftello(app_cfg->bitstream_file);
+    header.ivf_count      = app_cfg->ivf_count;
+    header.state_size     = checkpoint.state.sz;
+
+    const size_t path_len = strlen(app_cfg->checkpoint) + 5;
+    char        *tmp_path = (char *)malloc(path_len);
+    if (!tmp_path)
+        return;
+    snprintf(tmp_path, path_len, "%s.tmp", app_cfg->checkpoint);
+    FILE *file;
+    FOPEN(file, tmp_path, "wb");
+    Bool written = file && fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(checkpoint.state.buf, 1, checkpoint.state.sz, file) == checkpoint.state.sz;
+    // the output before the key frame must be on disk before the checkpoint points past it
+    fflush(app_cfg->bitstream_file);
+    if (file && fclose(file))
+        written = FALSE;
+#ifdef _WIN32
+    if (written)
+        remove(app_cfg->checkpoint);
+#endif
+    if (written && !rename(tmp_path, app_cfg->checkpoint))
+        app_cfg->checkpoint_picture_number = checkpoint.picture_number;
+    else
+        fprintf(app_cfg->error_log_file, "Error: failed to write the checkpoint file %s\n", app_cfg->checkpoint);
+    free(tmp_path);
+}
+
+static void write_output_stream(EbConfig *app_cfg, EbBufferHeaderType *header_ptr) {
+    switch (app_cfg->output_format) {
+    case OUTPUT_FORMAT_OBU: write_obu_temporal_unit(app_cfg, header_ptr->p_buffer, header_ptr->n_filled_len); break;
+    case OUTPUT_FORMAT_ANNEXB:
+        write_annexb_temporal_unit(app_cfg, header_ptr->p_buffer, header_ptr->n_filled_len);
+        break;
+    case OUTPUT_FORMAT_MP4:
+        write_mp4_temporal_unit(app_cfg, header_ptr->p_buffer, header_ptr->n_filled_len, header_ptr->pic_type);
+        break;
+    default:
+        // a resumed stream is appended to the output of the checkpointed encode
+        if (app_cfg->performance_context.frame_count == 1 && !(header_ptr->flags & EB_BUFFERFLAG_IS_ALT_REF) &&
+            !app_cfg->resume) {
+            write_ivf_stream_header(
+                app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
+        }
+        write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
+        fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, app_cfg->bitstream_file);
+        break;
+    }
+}
+
+/* Tile group output: keep the fragment until the frame is complete */
+static void append_fragment(EbConfig *app_cfg, const EbBufferHeaderType *header_ptr) {
+    uint8_t *buffer = (uint8_t *)realloc(app_cfg->fragment_buffer, app_cfg->fragment_size + header_ptr->n_filled_len);
+    if (!buffer) {
+        fprintf(app_cfg->error_log_file, "Error: failed to allocate the frame fragments\n");
+        return;
+    }
+    memcpy(buffer + app_cfg->fragment_size, header_ptr->p_buffer, header_ptr->n_filled_len);
+    app_cfg->fragment_buffer = buffer;
+    app_cfg->fragment_size += header_ptr->n_filled_len;
+}
+
+/* Resident memory of the process in bytes, the peak where the current value is not available */
+static uint64_t get_resident_memory(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.WorkingSetSize;
+    return 0;
+#else
+#if defined(__linux__)
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (file) {
+        unsigned long size = 0, resident = 0;
+        const int     read = fscanf(file, "%lu %lu", &size, &resident);
+        fclose(file);
+        if (read == 2)
+            return (uint64_t)resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return 0;
+#ifdef __APPLE__
+    return (uint64_t)usage.ru_maxrss;
+#else
+    return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+/* Soak test: speed over the last interval and overall, and memory of the process and of the encoder */
+static void report_soak(EbConfig *app_cfg, EbComponentType *component_handle, uint64_t now_s, uint64_t now_u) {
+    EbPerformanceContext *perf = &app_cfg->performance_context;
+    if (!app_cfg->soak_time[0] && !app_cfg->soak_time[1]) {
+        app_cfg->soak_time[0] = perf->encode_start_time[0];
+        app_cfg->soak_time[1] = perf->encode_start_time[1];
+    }
+    const double interval = app_svt_av1_compute_overall_elapsed_time(
+        app_cfg->soak_time[0], app_cfg->soak_time[1], now_s, now_u);
+    if (interval < app_cfg->soak_interval)
+        return;
+
+    SvtAv1MemoryUsage usage;
+    uint32_t          in_use = 0;
+    if (svt_av1_enc_get_stream_info(component_handle, SVT_AV1_STREAM_INFO_MEMORY_USAGE, &usage) != EB_ErrorNone)
+        memset(&usage, 0, sizeof(usage));
+    for (uint32_t i = 0; i < usage.pool_count; i++) in_use += usage.pools[i].in_use_count;
+    fprintf(app_console(),
+            "\nSoak: %.1f s, %llu frames, %.2f fps [%.2f fps overall], process %.1f MB, encoder %.1f MB with %u "
+            "buffers in use\n",
+            perf->total_encode_time,
+            (unsigned long long)perf->frame_count,
+            (double)(perf->frame_count - app_cfg->soak_frame_count) / interval,
+            (double)perf->frame_count / perf->total_encode_time,
+            (double)get_resident_memory() / (1 << 20),
+            (double)usage.total_bytes / (1 << 20),
+            in_use);
+    app_cfg->soak_time[0]     = now_s;
+    app_cfg->soak_time[1]     = now_u;
+    app_cfg->soak_frame_count = perf->frame_count;
+}
+
 void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t *frame_count) {
     EbConfig            *app_cfg    = channel->app_cfg;
     AppPortActiveType   *port_state = &app_cfg->output_stream_port_active;
@@ -814,7 +994,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
         EbErrorType stream_status = svt_av1_enc_get_packet(component_handle, &header_ptr, pic_send_done);
 
         if (stream_status == EB_ErrorMax) {
-            fprintf(stderr, "\n");
+            fprintf(app_console(), "\n");
             log_error_output(app_cfg->error_log_file, header_ptr->flags);
             channel->exit_cond_output = APP_ExitConditionError;
             return;
@@ -843,7 +1023,23 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         }
                     }
                 }
+            } else if (app_cfg->config.tile_group_output && !(flags & EB_BUFFERFLAG_LAST_FRAGMENT)) {
+                append_fragment(app_cfg, header_ptr);
+                svt_av1_enc_release_out_buffer(&header_ptr);
+                // Get the rest of the frame
+                is_alt_ref = 1;
             } else {
+                // The frame is written once its last fragment is received
+                EbBufferHeaderType  frame_buffer;
+                EbBufferHeaderType *packet = header_ptr;
+                if (app_cfg->fragment_size) {
+                    append_fragment(app_cfg, header_ptr);
+                    frame_buffer              = *header_ptr;
+                    frame_buffer.p_buffer     = app_cfg->fragment_buffer;
+                    frame_buffer.n_filled_len = app_cfg->fragment_size;
+                    app_cfg->fragment_size    = 0;
+                    packet                    = &frame_buffer;
+                }
                 is_alt_ref = (flags & EB_BUFFERFLAG_IS_ALT_REF);
                 if (!(flags & EB_BUFFERFLAG_IS_ALT_REF))
                     ++(app_cfg->performance_context.frame_count);
@@ -864,21 +1060,19 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                     app_cfg->performance_context.encode_start_time[1],
                     finish_s_time,
                     finish_u_time);
+                if (app_cfg->soak_interval)
+                    report_soak(app_cfg, component_handle, finish_s_time, finish_u_time);
 
                 // Write Stream Data to file
-                if (stream_file) {
-                    if (app_cfg->performance_context.frame_count == 1 && !(flags & EB_BUFFERFLAG_IS_ALT_REF)) {
-                        write_ivf_stream_header(
-                            app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
-                    }
-                    write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
-                    fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
-                }
+                if (stream_file && app_cfg->checkpoint && packet->pic_type == EB_AV1_KEY_PICTURE)
+                    write_checkpoint(app_cfg, component_handle);
+                if (stream_file)
+                    write_output_stream(app_cfg, packet);
 
-                app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
+                app_cfg->performance_context.byte_count += packet->n_filled_len;
 
                 if (app_cfg->config.stat_report && !(flags & EB_BUFFERFLAG_IS_ALT_REF))
-                    process_output_statistics_buffer(header_ptr, app_cfg);
+                    process_output_statistics_buffer(packet, app_cfg);
 
                 // Update Output Port Activity State
                 return_value = APP_ExitConditionNone;
@@ -905,10 +1099,10 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
             case 0: break;
             case 1:
                 if (!(flags & EB_BUFFERFLAG_IS_ALT_REF))
-                    fprintf(stderr, "\b\b\b\b\b\b\b\b\b%9d", *frame_count);
+                    fprintf(app_console(), "\b\b\b\b\b\b\b\b\b%9d", *frame_count);
                 break;
             case 2:
-                fprintf(stderr,
+                fprintf(app_console(),
                         "\rEncoding: %4d/%4d Frames @ %.2f fp%c | %.2f kbps | Time: %d:%02d:%02d [-%d:%02d:%02d] | Size: %.2f MB [%.2f MB]",
                         *frame_count,
                         app_cfg->frames_to_be_encoded,
@@ -918,7 +1112,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         ete_hh, ete_mm, ete_ss, eta_hh, eta_mm, eta_ss, size, estsz);
             default: break;
             }
-            fflush(stderr);
+            fflush(app_console());
 
             app_cfg->performance_context.average_speed = (double)app_cfg->performance_context.frame_count /
                 app_cfg->performance_context.total_encode_time;
@@ -926,7 +1120,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 app_cfg->performance_context.frame_count;
 
             if (app_cfg->progress == 1 && !(*frame_count % SPEED_MEASUREMENT_INTERVAL))
-                fprintf(stderr,
+                fprintf(app_console(),
                         "\nAverage System Encoding Speed:        %.2f\n",
                         (double)*frame_count / app_cfg->performance_context.total_encode_time);
 #else
@@ -952,14 +1146,8 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 finish_u_time);
 
             // Write Stream Data to file
-            if (stream_file) {
-                if (app_cfg->performance_context.frame_count == 1 && !(flags & EB_BUFFERFLAG_IS_ALT_REF)) {
-                    write_ivf_stream_header(
-                        app_cfg, app_cfg->frames_to_be_encoded == -1 ? 0 : (int32_t)app_cfg->frames_to_be_encoded);
-                }
-                write_ivf_frame_header(app_cfg, header_ptr->n_filled_len);
-                fwrite(header_ptr->p_buffer, 1, header_ptr->n_filled_len, stream_file);
-            }
+            if (stream_file)
+                write_output_stream(app_cfg, header_ptr);
 
             app_cfg->performance_context.byte_count += header_ptr->n_filled_len;
 
@@ -1009,10 +1197,10 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
             case 0: break;
             case 1:
                 if (!(flags & EB_BUFFERFLAG_IS_ALT_REF))
-                    fprintf(stderr, "\b\b\b\b\b\b\b\b\b%9d", *frame_count);
+                    fprintf(app_console(), "\b\b\b\b\b\b\b\b\b%9d", *frame_count);
                 break;
             case 2:
-                fprintf(stderr,
+                fprintf(app_console(),
                         "\rEncoding: %4d/%4d Frames @ %.2f fp%c | %.2f kbps | Time: %d:%02d:%02d [-%d:%02d:%02d] | Size: %.2f MB [%.2f MB]",
                         *frame_count,
                         app_cfg->frames_to_be_encoded,
@@ -1022,7 +1210,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                         ete_hh, ete_mm, ete_ss, eta_hh, eta_mm, eta_ss, size, estsz);
             default: break;
             }
-            fflush(stderr);
+            fflush(app_console());
 
             app_cfg->performance_context.average_speed = (double)app_cfg->performance_context.frame_count /
                 app_cfg->performance_context.total_encode_time;
@@ -1030,7 +1218,7 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 app_cfg->performance_context.frame_count;
 
             if (app_cfg->progress == 1 && !(*frame_count % SPEED_MEASUREMENT_INTERVAL))
-                fprintf(stderr,
+                fprintf(app_console(),
                         "\nAverage System Encoding Speed:        %.2f\n",
                         (double)*frame_count / app_cfg->performance_context.total_encode_time);
 #endif
@@ -1051,7 +1239,7 @@ void process_output_recon_buffer(EncChannel *channel) {
     EbErrorType recon_status = svt_av1_get_recon(component_handle, header_ptr);
 
     if (recon_status == EB_ErrorMax) {
-        fprintf(stderr, "\n");
+        fprintf(app_console(), "\n");
         log_error_output(app_cfg->error_log_file, header_ptr->flags);
         channel->exit_cond_recon = APP_ExitConditionError;
         return;
@@ -1063,7 +1251,7 @@ void process_output_recon_buffer(EncChannel *channel) {
             fseek_return_val = fseeko(app_cfg->recon_file, header_ptr->n_filled_len, SEEK_CUR);
 
             if (fseek_return_val != 0) {
-                fprintf(stderr, "Error in fseeko  returnVal %i\n", fseek_return_val);
+                fprintf(app_console(), "Error in fseeko  returnVal %i\n", fseek_return_val);
                 channel->exit_cond_recon = APP_ExitConditionError;
                 return;
             }
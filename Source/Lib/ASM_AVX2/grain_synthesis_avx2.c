@@ -0,0 +1,238 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include "definitions.h"
+#include "aom_dsp_rtcd.h"
+#include "grainSynthesis.h"
+
+// scaling_lut[] at index, interpolated between the two nearest entries above 8 bits
+static INLINE __m256i scale_lut_avx2(const int32_t *scaling_lut, const __m256i index, const int32_t bit_depth) {
+    if (bit_depth == 8)
+        return _mm256_i32gather_epi32(scaling_lut, index, 4);
+    const int32_t shift = bit_depth - 8;
+    const __m256i x     = _mm256_srli_epi32(index, shift);
+    // the last entry is not interpolated, it has a 0 difference with itself
+    const __m256i x1    = _mm256_min_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)), _mm256_set1_epi32(255));
+    const __m256i s0    = _mm256_i32gather_epi32(scaling_lut, x, 4);
+    const __m256i s1    = _mm256_i32gather_epi32(scaling_lut, x1, 4);
+    const __m256i frac  = _mm256_and_si256(index, _mm256_set1_epi32((1 << shift) - 1));
+    const __m256i delta = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s1, s0), frac),
+                                           _mm256_set1_epi32(1 << (shift - 1)));
+    return _mm256_add_epi32(s0, _mm256_srai_epi32(delta, shift));
+}
+
+// clamp(sample + ((scale * grain + rounding) >> scaling_shift), min, max)
+static INLINE __m256i add_noise_avx2(const __m256i sample, const __m256i scale, const __m256i grain,
+                                     const __m256i rounding, const int32_t scaling_shift, const __m256i min_value,
+                                     const __m256i max_value) {
+    const __m256i noise = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(scale, grain), rounding),
+                                            scaling_shift);
+    return _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(sample, noise), min_value), max_value);
+}
+
+// index of the chroma scaling lut: clamp(((luma * luma_mult + chroma * mult) >> 6) + offset, 0, max)
+static INLINE __m256i chroma_index_avx2(const __m256i luma, const __m256i chroma, const __m256i luma_mult,
+                                        const __m256i mult, const __m256i offset, const __m256i index_max) {
+    const __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(luma, luma_mult), _mm256_mullo_epi32(chroma, mult));
+    const __m256i idx = _mm256_add_epi32(_mm256_srai_epi32(sum, 6), offset);
+    return _mm256_min_epi32(_mm256_max_epi32(idx, _mm256_setzero_si256()), index_max);
+}
+
+// (even + odd + 1) >> 1 of 8 pairs of 16-bit samples
+static INLINE __m256i average_pairs_avx2(const __m256i pairs) {
+    const __m256i even = _mm256_and_si256(pairs, _mm256_set1_epi32(0xffff));
+    const __m256i odd  = _mm256_srli_epi32(pairs, 16);
+    return _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(even, odd), _mm256_set1_epi32(1)), 1);
+}
+
+static INLINE void store_8x8bit(uint8_t *dst, const __m256i v) {
+    const __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(v16, v16));
+}
+
+static INLINE void store_8x16bit(uint16_t *dst, const __m256i v) {
+    _mm_storeu_si128((__m128i *)dst, _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+void svt_av1_fgn_add_luma_noise_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                     int32_t width, int32_t height, const FgnScaling *scaling) {
+    const int32_t w8        = width & ~7;
+    const __m256i rounding  = _mm256_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m256i min_value = _mm256_set1_epi32(scaling->min_value);
+    const __m256i max_value = _mm256_set1_epi32(scaling->max_value);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i y = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(luma + i * luma_stride + j)));
+            const __m256i g = _mm256_loadu_si256((const __m256i *)(grain + i * grain_stride + j));
+            const __m256i s = _mm256_i32gather_epi32(scaling->scaling_lut, y, 4);
+            store_8x8bit(luma + i * luma_stride + j,
+                         add_noise_avx2(y, s, g, rounding, scaling->scaling_shift, min_value, max_value));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_luma_noise_c(luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, scaling);
+}
+
+void svt_av1_fgn_add_luma_noise_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                         int32_t grain_stride, int32_t width, int32_t height,
+                                         const FgnScaling *scaling) {
+    const int32_t w8        = width & ~7;
+    const __m256i rounding  = _mm256_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m256i min_value = _mm256_set1_epi32(scaling->min_value);
+    const __m256i max_value = _mm256_set1_epi32(scaling->max_value);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i y = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(luma + i * luma_stride + j)));
+            const __m256i g = _mm256_loadu_si256((const __m256i *)(grain + i * grain_stride + j));
+            const __m256i s = scale_lut_avx2(scaling->scaling_lut, y, scaling->bit_depth);
+            store_8x16bit(luma + i * luma_stride + j,
+                          add_noise_avx2(y, s, g, rounding, scaling->scaling_shift, min_value, max_value));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_luma_noise_hbd_c(
+            luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, scaling);
+}
+
+void svt_av1_fgn_add_chroma_noise_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                       int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width,
+                                       int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y,
+                                       const FgnScaling *scaling) {
+    const int32_t w8        = width & ~7;
+    const __m256i rounding  = _mm256_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m256i min_value = _mm256_set1_epi32(scaling->min_value);
+    const __m256i max_value = _mm256_set1_epi32(scaling->max_value);
+    const __m256i luma_mult = _mm256_set1_epi32(scaling->luma_mult);
+    const __m256i mult      = _mm256_set1_epi32(scaling->mult);
+    const __m256i offset    = _mm256_set1_epi32(scaling->offset);
+    const __m256i index_max = _mm256_set1_epi32(255);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i y = chroma_subsamp_x
+                ? average_pairs_avx2(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(luma_row + (j << 1)))))
+                : _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(luma_row + j)));
+            const __m256i c = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(chroma + i * chroma_stride + j)));
+            const __m256i g = _mm256_loadu_si256((const __m256i *)(grain + i * grain_stride + j));
+            const __m256i s = _mm256_i32gather_epi32(
+                scaling->scaling_lut, chroma_index_avx2(y, c, luma_mult, mult, offset, index_max), 4);
+            store_8x8bit(chroma + i * chroma_stride + j,
+                         add_noise_avx2(c, s, g, rounding, scaling->scaling_shift, min_value, max_value));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_chroma_noise_c(chroma + w8,
+                                       chroma_stride,
+                                       luma + (w8 << chroma_subsamp_x),
+                                       luma_stride,
+                                       grain + w8,
+                                       grain_stride,
+                                       width - w8,
+                                       height,
+                                       chroma_subsamp_x,
+                                       chroma_subsamp_y,
+                                       scaling);
+}
+
+void svt_av1_fgn_add_chroma_noise_hbd_avx2(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                           int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                           int32_t width, int32_t height, int32_t chroma_subsamp_x,
+                                           int32_t chroma_subsamp_y, const FgnScaling *scaling) {
+    const int32_t w8        = width & ~7;
+    const __m256i rounding  = _mm256_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m256i min_value = _mm256_set1_epi32(scaling->min_value);
+    const __m256i max_value = _mm256_set1_epi32(scaling->max_value);
+    const __m256i luma_mult = _mm256_set1_epi32(scaling->luma_mult);
+    const __m256i mult      = _mm256_set1_epi32(scaling->mult);
+    const __m256i offset    = _mm256_set1_epi32(scaling->offset);
+    const __m256i index_max = _mm256_set1_epi32((256 << (scaling->bit_depth - 8)) - 1);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint16_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            const __m256i y = chroma_subsamp_x
+                ? average_pairs_avx2(_mm256_loadu_si256((const __m256i *)(luma_row + (j << 1))))
+                : _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(luma_row + j)));
+            const __m256i c = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128((const __m128i *)(chroma + i * chroma_stride + j)));
+            const __m256i g = _mm256_loadu_si256((const __m256i *)(grain + i * grain_stride + j));
+            const __m256i s = scale_lut_avx2(scaling->scaling_lut,
+                                             chroma_index_avx2(y, c, luma_mult, mult, offset, index_max),
+                                             scaling->bit_depth);
+            store_8x16bit(chroma + i * chroma_stride + j,
+                          add_noise_avx2(c, s, g, rounding, scaling->scaling_shift, min_value, max_value));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_chroma_noise_hbd_c(chroma + w8,
+                                           chroma_stride,
+                                           luma + (w8 << chroma_subsamp_x),
+                                           luma_stride,
+                                           grain + w8,
+                                           grain_stride,
+                                           width - w8,
+                                           height,
+                                           chroma_subsamp_x,
+                                           chroma_subsamp_y,
+                                           scaling);
+}
+
+// clamp((a * wa + b * wb + 16) >> 5, grain_min, grain_max)
+static INLINE __m256i blend_avx2(const int32_t *a, const __m256i wa, const int32_t *b, const __m256i wb,
+                                 const __m256i grain_min, const __m256i grain_max) {
+    const __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)a), wa),
+                                         _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)b), wb));
+    const __m256i res = _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(16)), 5);
+    return _mm256_min_epi32(_mm256_max_epi32(res, grain_min), grain_max);
+}
+
+void svt_av1_fgn_hor_boundary_overlap_avx2(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block,
+                                           int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride,
+                                           int32_t width, int32_t height, int32_t grain_min, int32_t grain_max) {
+    const int32_t w8   = width & ~7;
+    const __m256i gmin = _mm256_set1_epi32(grain_min);
+    const __m256i gmax = _mm256_set1_epi32(grain_max);
+
+    if (height == 1) {
+        const __m256i w23 = _mm256_set1_epi32(23);
+        const __m256i w22 = _mm256_set1_epi32(22);
+        for (int32_t j = 0; j < w8; j += 8)
+            _mm256_storeu_si256((__m256i *)(dst_block + j),
+                                blend_avx2(top_block + j, w23, bottom_block + j, w22, gmin, gmax));
+    } else if (height == 2) {
+        const __m256i w27 = _mm256_set1_epi32(27);
+        const __m256i w17 = _mm256_set1_epi32(17);
+        for (int32_t j = 0; j < w8; j += 8) {
+            // both rows are read before the store, dst may be the top block
+            const __m256i r0 = blend_avx2(top_block + j, w27, bottom_block + j, w17, gmin, gmax);
+            const __m256i r1 = blend_avx2(
+                top_block + top_stride + j, w17, bottom_block + bottom_stride + j, w27, gmin, gmax);
+            _mm256_storeu_si256((__m256i *)(dst_block + j), r0);
+            _mm256_storeu_si256((__m256i *)(dst_block + dst_stride + j), r1);
+        }
+    } else
+        return;
+    if (w8 < width)
+        svt_av1_fgn_hor_boundary_overlap_c(top_block + w8,
+                                           top_stride,
+                                           bottom_block + w8,
+                                           bottom_stride,
+                                           dst_block + w8,
+                                           dst_stride,
+                                           width - w8,
+                                           height,
+                                           grain_min,
+                                           grain_max);
+}
@@ -2726,3 +2726,63 @@ EbErrorType svt_av1_resize_plane_avx2(const uint8_t *const input, int in_height,
     EB_FREE_ARRAY(intbuf);
     return ret;
 }
+
+// 8-tap sums of 8 rows at 16 samples given as 16-bit, pixels 0-3/8-11 in *lo and 4-7/12-15 in *hi
+static INLINE void resize_filter_rows_16_avx2(const __m256i src[SUBPEL_TAPS], const __m256i filter_2x[4],
+                                              __m256i *lo, __m256i *hi) {
+    const __m256i round = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+    __m256i       sum_lo = round, sum_hi = round;
+    for (int k = 0; k < 4; ++k) {
+        sum_lo = _mm256_add_epi32(sum_lo,
+                                  _mm256_madd_epi16(_mm256_unpacklo_epi16(src[2 * k], src[2 * k + 1]), filter_2x[k]));
+        sum_hi = _mm256_add_epi32(sum_hi,
+                                  _mm256_madd_epi16(_mm256_unpackhi_epi16(src[2 * k], src[2 * k + 1]), filter_2x[k]));
+    }
+    *lo = _mm256_srai_epi32(sum_lo, FILTER_BITS);
+    *hi = _mm256_srai_epi32(sum_hi, FILTER_BITS);
+}
+
+static INLINE void resize_filter_rows_prepare(const int16_t *filter, __m256i filter_2x[4]) {
+    for (int k = 0; k < 4; ++k)
+        filter_2x[k] = _mm256_set1_epi32((int32_t)(uint16_t)filter[2 * k] | ((int32_t)filter[2 * k + 1] << 16));
+}
+
+void svt_av1_resize_filter_rows_avx2(const uint8_t *const *rows, const int16_t *filter, uint8_t *output, int width) {
+    __m256i filter_2x[4], src[SUBPEL_TAPS], lo, hi;
+    int     x = 0;
+    resize_filter_rows_prepare(filter, filter_2x);
+    for (; x + 16 <= width; x += 16) {
+        for (int k = 0; k < SUBPEL_TAPS; ++k)
+            src[k] = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(rows[k] + x)));
+        resize_filter_rows_16_avx2(src, filter_2x, &lo, &hi);
+        // packs keep pixels 0-7 in the low lane and 8-15 in the high lane
+        const __m256i res16 = _mm256_packs_epi32(lo, hi);
+        const __m256i res8  = _mm256_permute4x64_epi64(_mm256_packus_epi16(res16, res16), 0xd8);
+        _mm_storeu_si128((__m128i *)(output + x), _mm256_castsi256_si128(res8));
+    }
+    for (; x < width; ++x) {
+        int sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+    }
+}
+
+void svt_av1_highbd_resize_filter_rows_avx2(const uint16_t *const *rows, const int16_t *filter, uint16_t *output,
+                                            int width, int bd) {
+    const __m256i max = _mm256_set1_epi32((1 << bd) - 1);
+    __m256i       filter_2x[4], src[SUBPEL_TAPS], lo, hi;
+    int           x = 0;
+    resize_filter_rows_prepare(filter, filter_2x);
+    for (; x + 16 <= width; x += 16) {
+        for (int k = 0; k < SUBPEL_TAPS; ++k) src[k] = _mm256_loadu_si256((const __m256i *)(rows[k] + x));
+        resize_filter_rows_16_avx2(src, filter_2x, &lo, &hi);
+        lo = _mm256_min_epi32(_mm256_max_epi32(lo, _mm256_setzero_si256()), max);
+        hi = _mm256_min_epi32(_mm256_max_epi32(hi, _mm256_setzero_si256()), max);
+        _mm256_storeu_si256((__m256i *)(output + x), _mm256_packus_epi32(lo, hi));
+    }
+    for (; x < width; ++x) {
+        int sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
+    }
+}
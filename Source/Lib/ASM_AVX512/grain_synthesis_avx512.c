@@ -0,0 +1,194 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+#include "definitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+#include "aom_dsp_rtcd.h"
+#include "grainSynthesis.h"
+
+// scaling_lut[] at index, interpolated between the two nearest entries above 8 bits
+static INLINE __m512i scale_lut_avx512(const int32_t *scaling_lut, const __m512i index, const int32_t bit_depth) {
+    if (bit_depth == 8)
+        return _mm512_i32gather_epi32(index, scaling_lut, 4);
+    const int32_t shift = bit_depth - 8;
+    const __m512i x     = _mm512_srli_epi32(index, shift);
+    // the last entry is not interpolated, it has a 0 difference with itself
+    const __m512i x1    = _mm512_min_epi32(_mm512_add_epi32(x, _mm512_set1_epi32(1)), _mm512_set1_epi32(255));
+    const __m512i s0    = _mm512_i32gather_epi32(x, scaling_lut, 4);
+    const __m512i s1    = _mm512_i32gather_epi32(x1, scaling_lut, 4);
+    const __m512i frac  = _mm512_and_si512(index, _mm512_set1_epi32((1 << shift) - 1));
+    const __m512i delta = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_sub_epi32(s1, s0), frac),
+                                           _mm512_set1_epi32(1 << (shift - 1)));
+    return _mm512_add_epi32(s0, _mm512_srai_epi32(delta, shift));
+}
+
+// clamp(sample + ((scale * grain + rounding) >> scaling_shift), min, max)
+static INLINE __m512i add_noise_avx512(const __m512i sample, const __m512i scale, const __m512i grain,
+                                       const __m512i rounding, const int32_t scaling_shift, const __m512i min_value,
+                                       const __m512i max_value) {
+    const __m512i noise = _mm512_srai_epi32(_mm512_add_epi32(_mm512_mullo_epi32(scale, grain), rounding),
+                                            scaling_shift);
+    return _mm512_min_epi32(_mm512_max_epi32(_mm512_add_epi32(sample, noise), min_value), max_value);
+}
+
+// index of the chroma scaling lut: clamp(((luma * luma_mult + chroma * mult) >> 6) + offset, 0, max)
+static INLINE __m512i chroma_index_avx512(const __m512i luma, const __m512i chroma, const __m512i luma_mult,
+                                          const __m512i mult, const __m512i offset, const __m512i index_max) {
+    const __m512i sum = _mm512_add_epi32(_mm512_mullo_epi32(luma, luma_mult), _mm512_mullo_epi32(chroma, mult));
+    const __m512i idx = _mm512_add_epi32(_mm512_srai_epi32(sum, 6), offset);
+    return _mm512_min_epi32(_mm512_max_epi32(idx, _mm512_setzero_si512()), index_max);
+}
+
+// (even + odd + 1) >> 1 of 16 pairs of 16-bit samples
+static INLINE __m512i average_pairs_avx512(const __m512i pairs) {
+    const __m512i even = _mm512_and_si512(pairs, _mm512_set1_epi32(0xffff));
+    const __m512i odd  = _mm512_srli_epi32(pairs, 16);
+    return _mm512_srli_epi32(_mm512_add_epi32(_mm512_add_epi32(even, odd), _mm512_set1_epi32(1)), 1);
+}
+
+void svt_av1_fgn_add_luma_noise_avx512(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                       int32_t grain_stride, int32_t width, int32_t height,
+                                       const FgnScaling *scaling) {
+    const int32_t w16       = width & ~15;
+    const __m512i rounding  = _mm512_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m512i min_value = _mm512_set1_epi32(scaling->min_value);
+    const __m512i max_value = _mm512_set1_epi32(scaling->max_value);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w16; j += 16) {
+            const __m512i y = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(luma + i * luma_stride + j)));
+            const __m512i g = _mm512_loadu_si512((const __m512i *)(grain + i * grain_stride + j));
+            const __m512i s = _mm512_i32gather_epi32(y, scaling->scaling_lut, 4);
+            _mm_storeu_si128(
+                (__m128i *)(luma + i * luma_stride + j),
+                _mm512_cvtepi32_epi8(add_noise_avx512(y, s, g, rounding, scaling->scaling_shift, min_value, max_value)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_fgn_add_luma_noise_avx2(
+            luma + w16, luma_stride, grain + w16, grain_stride, width - w16, height, scaling);
+}
+
+void svt_av1_fgn_add_luma_noise_hbd_avx512(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                           int32_t grain_stride, int32_t width, int32_t height,
+                                           const FgnScaling *scaling) {
+    const int32_t w16       = width & ~15;
+    const __m512i rounding  = _mm512_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m512i min_value = _mm512_set1_epi32(scaling->min_value);
+    const __m512i max_value = _mm512_set1_epi32(scaling->max_value);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w16; j += 16) {
+            const __m512i y = _mm512_cvtepu16_epi32(
+                _mm256_loadu_si256((const __m256i *)(luma + i * luma_stride + j)));
+            const __m512i g = _mm512_loadu_si512((const __m512i *)(grain + i * grain_stride + j));
+            const __m512i s = scale_lut_avx512(scaling->scaling_lut, y, scaling->bit_depth);
+            _mm256_storeu_si256((__m256i *)(luma + i * luma_stride + j),
+                                _mm512_cvtepi32_epi16(
+                                    add_noise_avx512(y, s, g, rounding, scaling->scaling_shift, min_value, max_value)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_fgn_add_luma_noise_hbd_avx2(
+            luma + w16, luma_stride, grain + w16, grain_stride, width - w16, height, scaling);
+}
+
+void svt_av1_fgn_add_chroma_noise_avx512(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                         int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                         int32_t width, int32_t height, int32_t chroma_subsamp_x,
+                                         int32_t chroma_subsamp_y, const FgnScaling *scaling) {
+    const int32_t w16       = width & ~15;
+    const __m512i rounding  = _mm512_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m512i min_value = _mm512_set1_epi32(scaling->min_value);
+    const __m512i max_value = _mm512_set1_epi32(scaling->max_value);
+    const __m512i luma_mult = _mm512_set1_epi32(scaling->luma_mult);
+    const __m512i mult      = _mm512_set1_epi32(scaling->mult);
+    const __m512i offset    = _mm512_set1_epi32(scaling->offset);
+    const __m512i index_max = _mm512_set1_epi32(255);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w16; j += 16) {
+            const __m512i y = chroma_subsamp_x
+                ? average_pairs_avx512(
+                      _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)(luma_row + (j << 1)))))
+                : _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(luma_row + j)));
+            const __m512i c = _mm512_cvtepu8_epi32(
+                _mm_loadu_si128((const __m128i *)(chroma + i * chroma_stride + j)));
+            const __m512i g = _mm512_loadu_si512((const __m512i *)(grain + i * grain_stride + j));
+            const __m512i s = _mm512_i32gather_epi32(
+                chroma_index_avx512(y, c, luma_mult, mult, offset, index_max), scaling->scaling_lut, 4);
+            _mm_storeu_si128(
+                (__m128i *)(chroma + i * chroma_stride + j),
+                _mm512_cvtepi32_epi8(add_noise_avx512(c, s, g, rounding, scaling->scaling_shift, min_value, max_value)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_fgn_add_chroma_noise_avx2(chroma + w16,
+                                          chroma_stride,
+                                          luma + (w16 << chroma_subsamp_x),
+                                          luma_stride,
+                                          grain + w16,
+                                          grain_stride,
+                                          width - w16,
+                                          height,
+                                          chroma_subsamp_x,
+                                          chroma_subsamp_y,
+                                          scaling);
+}
+
+void svt_av1_fgn_add_chroma_noise_hbd_avx512(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                             int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                             int32_t width, int32_t height, int32_t chroma_subsamp_x,
+                                             int32_t chroma_subsamp_y, const FgnScaling *scaling) {
+    const int32_t w16       = width & ~15;
+    const __m512i rounding  = _mm512_set1_epi32(1 << (scaling->scaling_shift - 1));
+    const __m512i min_value = _mm512_set1_epi32(scaling->min_value);
+    const __m512i max_value = _mm512_set1_epi32(scaling->max_value);
+    const __m512i luma_mult = _mm512_set1_epi32(scaling->luma_mult);
+    const __m512i mult      = _mm512_set1_epi32(scaling->mult);
+    const __m512i offset    = _mm512_set1_epi32(scaling->offset);
+    const __m512i index_max = _mm512_set1_epi32((256 << (scaling->bit_depth - 8)) - 1);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint16_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w16; j += 16) {
+            const __m512i y = chroma_subsamp_x
+                ? average_pairs_avx512(_mm512_loadu_si512((const __m512i *)(luma_row + (j << 1))))
+                : _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(luma_row + j)));
+            const __m512i c = _mm512_cvtepu16_epi32(
+                _mm256_loadu_si256((const __m256i *)(chroma + i * chroma_stride + j)));
+            const __m512i g = _mm512_loadu_si512((const __m512i *)(grain + i * grain_stride + j));
+            const __m512i s = scale_lut_avx512(scaling->scaling_lut,
+                                               chroma_index_avx512(y, c, luma_mult, mult, offset, index_max),
+                                               scaling->bit_depth);
+            _mm256_storeu_si256((__m256i *)(chroma + i * chroma_stride + j),
+                                _mm512_cvtepi32_epi16(
+                                    add_noise_avx512(c, s, g, rounding, scaling->scaling_shift, min_value, max_value)));
+        }
+    }
+    if (w16 < width)
+        svt_av1_fgn_add_chroma_noise_hbd_avx2(chroma + w16,
+                                              chroma_stride,
+                                              luma + (w16 << chroma_subsamp_x),
+                                              luma_stride,
+                                              grain + w16,
+                                              grain_stride,
+                                              width - w16,
+                                              height,
+                                              chroma_subsamp_x,
+                                              chroma_subsamp_y,
+                                              scaling);
+}
+
+#endif // EN_AVX512_SUPPORT
@@ -0,0 +1,280 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <arm_neon.h>
+
+#include "definitions.h"
+#include "aom_dsp_rtcd.h"
+#include "grainSynthesis.h"
+
+/* scaling_lut[] at the 8 indices, interpolated between the two nearest entries
+ * above 8 bits. There is no gather, the entries are read one by one. */
+static INLINE void scale_lut_neon(const int32_t *scaling_lut, const int32x4_t index[2], const int32_t bit_depth,
+                                  int32x4_t scale[2]) {
+    int32_t idx[8], s0[8], s1[8];
+    vst1q_s32(idx, index[0]);
+    vst1q_s32(idx + 4, index[1]);
+    if (bit_depth == 8) {
+        for (int k = 0; k < 8; k++) s0[k] = scaling_lut[idx[k]];
+        scale[0] = vld1q_s32(s0);
+        scale[1] = vld1q_s32(s0 + 4);
+        return;
+    }
+    const int32_t shift = bit_depth - 8;
+    for (int k = 0; k < 8; k++) {
+        const int32_t x = idx[k] >> shift;
+        s0[k]           = scaling_lut[x];
+        // the last entry is not interpolated, it has a 0 difference with itself
+        s1[k] = scaling_lut[x < 255 ? x + 1 : 255];
+    }
+    const int32x4_t mask     = vdupq_n_s32((1 << shift) - 1);
+    const int32x4_t rounding = vdupq_n_s32(1 << (shift - 1));
+    const int32x4_t rshift   = vdupq_n_s32(-shift);
+    for (int k = 0; k < 2; k++) {
+        const int32x4_t a     = vld1q_s32(s0 + 4 * k);
+        const int32x4_t b     = vld1q_s32(s1 + 4 * k);
+        const int32x4_t delta = vmlaq_s32(rounding, vsubq_s32(b, a), vandq_s32(index[k], mask));
+        scale[k]              = vaddq_s32(a, vshlq_s32(delta, rshift));
+    }
+}
+
+// clamp(sample + ((scale * grain + rounding) >> scaling_shift), min, max)
+static INLINE int32x4_t add_noise_neon(const int32x4_t sample, const int32x4_t scale, const int32x4_t grain,
+                                       const int32x4_t rounding, const int32x4_t rshift, const int32x4_t min_value,
+                                       const int32x4_t max_value) {
+    const int32x4_t noise = vshlq_s32(vmlaq_s32(rounding, scale, grain), rshift);
+    return vminq_s32(vmaxq_s32(vaddq_s32(sample, noise), min_value), max_value);
+}
+
+// index of the chroma scaling lut: clamp(((luma * luma_mult + chroma * mult) >> 6) + offset, 0, max)
+static INLINE int32x4_t chroma_index_neon(const int32x4_t luma, const int32x4_t chroma, const int32_t luma_mult,
+                                          const int32_t mult, const int32x4_t offset, const int32x4_t index_max) {
+    const int32x4_t sum = vmlaq_n_s32(vmulq_n_s32(luma, luma_mult), chroma, mult);
+    const int32x4_t idx = vaddq_s32(vshrq_n_s32(sum, 6), offset);
+    return vminq_s32(vmaxq_s32(idx, vdupq_n_s32(0)), index_max);
+}
+
+static INLINE void widen_u16(const uint16x8_t v, int32x4_t out[2]) {
+    out[0] = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(v)));
+    out[1] = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(v)));
+}
+
+static INLINE uint16x8_t narrow_u16(const int32x4_t v[2]) {
+    return vcombine_u16(vqmovun_s32(v[0]), vqmovun_s32(v[1]));
+}
+
+// 8 luma samples co-located with 8 chroma samples
+static INLINE uint16x8_t load_luma_8bit(const uint8_t *luma, int32_t chroma_subsamp_x) {
+    if (chroma_subsamp_x) {
+        const uint8x8x2_t pairs = vld2_u8(luma);
+        return vmovl_u8(vrhadd_u8(pairs.val[0], pairs.val[1]));
+    }
+    return vmovl_u8(vld1_u8(luma));
+}
+
+static INLINE uint16x8_t load_luma_16bit(const uint16_t *luma, int32_t chroma_subsamp_x) {
+    if (chroma_subsamp_x) {
+        const uint16x8x2_t pairs = vld2q_u16(luma);
+        return vrhaddq_u16(pairs.val[0], pairs.val[1]);
+    }
+    return vld1q_u16(luma);
+}
+
+void svt_av1_fgn_add_luma_noise_neon(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                     int32_t width, int32_t height, const FgnScaling *scaling) {
+    const int32_t   w8        = width & ~7;
+    const int32x4_t rounding  = vdupq_n_s32(1 << (scaling->scaling_shift - 1));
+    const int32x4_t rshift    = vdupq_n_s32(-scaling->scaling_shift);
+    const int32x4_t min_value = vdupq_n_s32(scaling->min_value);
+    const int32x4_t max_value = vdupq_n_s32(scaling->max_value);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w8; j += 8) {
+            int32x4_t y[2], s[2];
+            widen_u16(vmovl_u8(vld1_u8(luma + i * luma_stride + j)), y);
+            scale_lut_neon(scaling->scaling_lut, y, 8, s);
+            for (int k = 0; k < 2; k++)
+                y[k] = add_noise_neon(y[k],
+                                      s[k],
+                                      vld1q_s32(grain + i * grain_stride + j + 4 * k),
+                                      rounding,
+                                      rshift,
+                                      min_value,
+                                      max_value);
+            vst1_u8(luma + i * luma_stride + j, vqmovn_u16(narrow_u16(y)));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_luma_noise_c(luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, scaling);
+}
+
+void svt_av1_fgn_add_luma_noise_hbd_neon(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                         int32_t grain_stride, int32_t width, int32_t height,
+                                         const FgnScaling *scaling) {
+    const int32_t   w8        = width & ~7;
+    const int32x4_t rounding  = vdupq_n_s32(1 << (scaling->scaling_shift - 1));
+    const int32x4_t rshift    = vdupq_n_s32(-scaling->scaling_shift);
+    const int32x4_t min_value = vdupq_n_s32(scaling->min_value);
+    const int32x4_t max_value = vdupq_n_s32(scaling->max_value);
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < w8; j += 8) {
+            int32x4_t y[2], s[2];
+            widen_u16(vld1q_u16(luma + i * luma_stride + j), y);
+            scale_lut_neon(scaling->scaling_lut, y, scaling->bit_depth, s);
+            for (int k = 0; k < 2; k++)
+                y[k] = add_noise_neon(y[k],
+                                      s[k],
+                                      vld1q_s32(grain + i * grain_stride + j + 4 * k),
+                                      rounding,
+                                      rshift,
+                                      min_value,
+                                      max_value);
+            vst1q_u16(luma + i * luma_stride + j, narrow_u16(y));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_luma_noise_hbd_c(
+            luma + w8, luma_stride, grain + w8, grain_stride, width - w8, height, scaling);
+}
+
+void svt_av1_fgn_add_chroma_noise_neon(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                       int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width,
+                                       int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y,
+                                       const FgnScaling *scaling) {
+    const int32_t   w8        = width & ~7;
+    const int32x4_t rounding  = vdupq_n_s32(1 << (scaling->scaling_shift - 1));
+    const int32x4_t rshift    = vdupq_n_s32(-scaling->scaling_shift);
+    const int32x4_t min_value = vdupq_n_s32(scaling->min_value);
+    const int32x4_t max_value = vdupq_n_s32(scaling->max_value);
+    const int32x4_t offset    = vdupq_n_s32(scaling->offset);
+    const int32x4_t index_max = vdupq_n_s32(255);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            int32x4_t y[2], c[2], idx[2], s[2];
+            widen_u16(load_luma_8bit(luma_row + (j << chroma_subsamp_x), chroma_subsamp_x), y);
+            widen_u16(vmovl_u8(vld1_u8(chroma + i * chroma_stride + j)), c);
+            for (int k = 0; k < 2; k++)
+                idx[k] = chroma_index_neon(y[k], c[k], scaling->luma_mult, scaling->mult, offset, index_max);
+            scale_lut_neon(scaling->scaling_lut, idx, 8, s);
+            for (int k = 0; k < 2; k++)
+                c[k] = add_noise_neon(c[k],
+                                      s[k],
+                                      vld1q_s32(grain + i * grain_stride + j + 4 * k),
+                                      rounding,
+                                      rshift,
+                                      min_value,
+                                      max_value);
+            vst1_u8(chroma + i * chroma_stride + j, vqmovn_u16(narrow_u16(c)));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_chroma_noise_c(chroma + w8,
+                                       chroma_stride,
+                                       luma + (w8 << chroma_subsamp_x),
+                                       luma_stride,
+                                       grain + w8,
+                                       grain_stride,
+                                       width - w8,
+                                       height,
+                                       chroma_subsamp_x,
+                                       chroma_subsamp_y,
+                                       scaling);
+}
+
+void svt_av1_fgn_add_chroma_noise_hbd_neon(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                           int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                           int32_t width, int32_t height, int32_t chroma_subsamp_x,
+                                           int32_t chroma_subsamp_y, const FgnScaling *scaling) {
+    const int32_t   w8        = width & ~7;
+    const int32x4_t rounding  = vdupq_n_s32(1 << (scaling->scaling_shift - 1));
+    const int32x4_t rshift    = vdupq_n_s32(-scaling->scaling_shift);
+    const int32x4_t min_value = vdupq_n_s32(scaling->min_value);
+    const int32x4_t max_value = vdupq_n_s32(scaling->max_value);
+    const int32x4_t offset    = vdupq_n_s32(scaling->offset);
+    const int32x4_t index_max = vdupq_n_s32((256 << (scaling->bit_depth - 8)) - 1);
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint16_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < w8; j += 8) {
+            int32x4_t y[2], c[2], idx[2], s[2];
+            widen_u16(load_luma_16bit(luma_row + (j << chroma_subsamp_x), chroma_subsamp_x), y);
+            widen_u16(vld1q_u16(chroma + i * chroma_stride + j), c);
+            for (int k = 0; k < 2; k++)
+                idx[k] = chroma_index_neon(y[k], c[k], scaling->luma_mult, scaling->mult, offset, index_max);
+            scale_lut_neon(scaling->scaling_lut, idx, scaling->bit_depth, s);
+            for (int k = 0; k < 2; k++)
+                c[k] = add_noise_neon(c[k],
+                                      s[k],
+                                      vld1q_s32(grain + i * grain_stride + j + 4 * k),
+                                      rounding,
+                                      rshift,
+                                      min_value,
+                                      max_value);
+            vst1q_u16(chroma + i * chroma_stride + j, narrow_u16(c));
+        }
+    }
+    if (w8 < width)
+        svt_av1_fgn_add_chroma_noise_hbd_c(chroma + w8,
+                                           chroma_stride,
+                                           luma + (w8 << chroma_subsamp_x),
+                                           luma_stride,
+                                           grain + w8,
+                                           grain_stride,
+                                           width - w8,
+                                           height,
+                                           chroma_subsamp_x,
+                                           chroma_subsamp_y,
+                                           scaling);
+}
+
+// clamp((a * wa + b * wb + 16) >> 5, grain_min, grain_max)
+static INLINE int32x4_t blend_neon(const int32_t *a, const int32_t wa, const int32_t *b, const int32_t wb,
+                                   const int32x4_t grain_min, const int32x4_t grain_max) {
+    const int32x4_t sum = vmlaq_n_s32(vmulq_n_s32(vld1q_s32(a), wa), vld1q_s32(b), wb);
+    return vminq_s32(vmaxq_s32(vrshrq_n_s32(sum, 5), grain_min), grain_max);
+}
+
+void svt_av1_fgn_hor_boundary_overlap_neon(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block,
+                                           int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride,
+                                           int32_t width, int32_t height, int32_t grain_min, int32_t grain_max) {
+    const int32_t   w4   = width & ~3;
+    const int32x4_t gmin = vdupq_n_s32(grain_min);
+    const int32x4_t gmax = vdupq_n_s32(grain_max);
+
+    if (height == 1) {
+        for (int32_t j = 0; j < w4; j += 4)
+            vst1q_s32(dst_block + j, blend_neon(top_block + j, 23, bottom_block + j, 22, gmin, gmax));
+    } else if (height == 2) {
+        for (int32_t j = 0; j < w4; j += 4) {
+            // both rows are read before the store, dst may be the top block
+            const int32x4_t r0 = blend_neon(top_block + j, 27, bottom_block + j, 17, gmin, gmax);
+            const int32x4_t r1 = blend_neon(
+                top_block + top_stride + j, 17, bottom_block + bottom_stride + j, 27, gmin, gmax);
+            vst1q_s32(dst_block + j, r0);
+            vst1q_s32(dst_block + dst_stride + j, r1);
+        }
+    } else
+        return;
+    if (w4 < width)
+        svt_av1_fgn_hor_boundary_overlap_c(top_block + w4,
+                                           top_stride,
+                                           bottom_block + w4,
+                                           bottom_stride,
+                                           dst_block + w4,
+                                           dst_stride,
+                                           width - w4,
+                                           height,
+                                           grain_min,
+                                           grain_max);
+}
@@ -542,11 +542,18 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_AVX2(svt_av1_highbd_down2_symeven, svt_av1_highbd_down2_symeven_c, svt_av1_highbd_down2_symeven_avx2);
     SET_AVX2(svt_av1_highbd_resize_plane, svt_av1_highbd_resize_plane_c, svt_av1_highbd_resize_plane_avx2);
     SET_AVX2(svt_av1_resize_plane, svt_av1_resize_plane_c, svt_av1_resize_plane_avx2);
+    SET_AVX2(svt_av1_resize_filter_rows, svt_av1_resize_filter_rows_c, svt_av1_resize_filter_rows_avx2);
+    SET_AVX2(svt_av1_highbd_resize_filter_rows, svt_av1_highbd_resize_filter_rows_c, svt_av1_highbd_resize_filter_rows_avx2);
     SET_AVX2(svt_av1_compute_cul_level, svt_av1_compute_cul_level_c, svt_av1_compute_cul_level_avx2);
     SET_AVX2(svt_ssim_8x8, svt_ssim_8x8_c, svt_ssim_8x8_avx2);
     SET_AVX2(svt_ssim_4x4, svt_ssim_4x4_c, svt_ssim_4x4_avx2);
     SET_AVX2(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c, svt_ssim_8x8_hbd_avx2);
     SET_AVX2(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c, svt_ssim_4x4_hbd_avx2);
+    SET_AVX2_AVX512(svt_av1_fgn_add_luma_noise, svt_av1_fgn_add_luma_noise_c, svt_av1_fgn_add_luma_noise_avx2, svt_av1_fgn_add_luma_noise_avx512);
+    SET_AVX2_AVX512(svt_av1_fgn_add_luma_noise_hbd, svt_av1_fgn_add_luma_noise_hbd_c, svt_av1_fgn_add_luma_noise_hbd_avx2, svt_av1_fgn_add_luma_noise_hbd_avx512);
+    SET_AVX2_AVX512(svt_av1_fgn_add_chroma_noise, svt_av1_fgn_add_chroma_noise_c, svt_av1_fgn_add_chroma_noise_avx2, svt_av1_fgn_add_chroma_noise_avx512);
+    SET_AVX2_AVX512(svt_av1_fgn_add_chroma_noise_hbd, svt_av1_fgn_add_chroma_noise_hbd_c, svt_av1_fgn_add_chroma_noise_hbd_avx2, svt_av1_fgn_add_chroma_noise_hbd_avx512);
+    SET_AVX2(svt_av1_fgn_hor_boundary_overlap, svt_av1_fgn_hor_boundary_overlap_c, svt_av1_fgn_hor_boundary_overlap_avx2);
 #elif defined ARCH_AARCH64
     SET_NEON(hadamard_path, hadamard_path_c, hadamard_path_neon);
     SET_NEON(svt_aom_sse, svt_aom_sse_c, svt_aom_sse_neon);
@@ -893,11 +900,18 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_av1_highbd_down2_symeven, svt_av1_highbd_down2_symeven_c);
     SET_ONLY_C(svt_av1_highbd_resize_plane, svt_av1_highbd_resize_plane_c);
     SET_ONLY_C(svt_av1_resize_plane, svt_av1_resize_plane_c);
+    SET_ONLY_C(svt_av1_resize_filter_rows, svt_av1_resize_filter_rows_c);
+    SET_ONLY_C(svt_av1_highbd_resize_filter_rows, svt_av1_highbd_resize_filter_rows_c);
     SET_NEON(svt_av1_compute_cul_level, svt_av1_compute_cul_level_c, svt_av1_compute_cul_level_neon);
     SET_ONLY_C(svt_ssim_8x8, svt_ssim_8x8_c);
     SET_ONLY_C(svt_ssim_4x4, svt_ssim_4x4_c);
     SET_ONLY_C(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c);
     SET_ONLY_C(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c);
+    SET_NEON(svt_av1_fgn_add_luma_noise, svt_av1_fgn_add_luma_noise_c, svt_av1_fgn_add_luma_noise_neon);
+    SET_NEON(svt_av1_fgn_add_luma_noise_hbd, svt_av1_fgn_add_luma_noise_hbd_c, svt_av1_fgn_add_luma_noise_hbd_neon);
+    SET_NEON(svt_av1_fgn_add_chroma_noise, svt_av1_fgn_add_chroma_noise_c, svt_av1_fgn_add_chroma_noise_neon);
+    SET_NEON(svt_av1_fgn_add_chroma_noise_hbd, svt_av1_fgn_add_chroma_noise_hbd_c, svt_av1_fgn_add_chroma_noise_hbd_neon);
+    SET_NEON(svt_av1_fgn_hor_boundary_overlap, svt_av1_fgn_hor_boundary_overlap_c, svt_av1_fgn_hor_boundary_overlap_neon);
 #else
     SET_ONLY_C(hadamard_path, hadamard_path_c);
     SET_ONLY_C(svt_aom_sse, svt_aom_sse_c);
@@ -1242,11 +1256,18 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_av1_highbd_down2_symeven, svt_av1_highbd_down2_symeven_c);
     SET_ONLY_C(svt_av1_highbd_resize_plane, svt_av1_highbd_resize_plane_c);
     SET_ONLY_C(svt_av1_resize_plane, svt_av1_resize_plane_c);
+    SET_ONLY_C(svt_av1_resize_filter_rows, svt_av1_resize_filter_rows_c);
+    SET_ONLY_C(svt_av1_highbd_resize_filter_rows, svt_av1_highbd_resize_filter_rows_c);
     SET_ONLY_C(svt_av1_compute_cul_level, svt_av1_compute_cul_level_c);
     SET_ONLY_C(svt_ssim_8x8, svt_ssim_8x8_c);
     SET_ONLY_C(svt_ssim_4x4, svt_ssim_4x4_c);
     SET_ONLY_C(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c);
     SET_ONLY_C(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c);
+    SET_ONLY_C(svt_av1_fgn_add_luma_noise, svt_av1_fgn_add_luma_noise_c);
+    SET_ONLY_C(svt_av1_fgn_add_luma_noise_hbd, svt_av1_fgn_add_luma_noise_hbd_c);
+    SET_ONLY_C(svt_av1_fgn_add_chroma_noise, svt_av1_fgn_add_chroma_noise_c);
+    SET_ONLY_C(svt_av1_fgn_add_chroma_noise_hbd, svt_av1_fgn_add_chroma_noise_hbd_c);
+    SET_ONLY_C(svt_av1_fgn_hor_boundary_overlap, svt_av1_fgn_hor_boundary_overlap_c);
 #endif
 
     if(0 == flags)
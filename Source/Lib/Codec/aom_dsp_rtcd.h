@@ -20,6 +20,7 @@
 #include "coding_unit.h"
 
 #include "noise_model.h"
+#include "grainSynthesis.h"
 
 #undef RTCD_EXTERN
 #ifdef AOM_RTCD_C
@@ -899,6 +900,10 @@ extern "C" {
     EbErrorType svt_av1_highbd_resize_plane_c(const uint16_t *const input, int height, int width, int in_stride, uint16_t *output, int height2, int width2, int out_stride, int bd);
     RTCD_EXTERN EbErrorType(*svt_av1_resize_plane)(const uint8_t *const input, int height, int width, int in_stride, uint8_t *output, int height2, int width2, int out_stride);
     EbErrorType svt_av1_resize_plane_c(const uint8_t *const input, int height, int width, int in_stride, uint8_t *output, int height2, int width2, int out_stride);
+    RTCD_EXTERN void(*svt_av1_resize_filter_rows)(const uint8_t *const *rows, const int16_t *filter, uint8_t *output, int width);
+    void svt_av1_resize_filter_rows_c(const uint8_t *const *rows, const int16_t *filter, uint8_t *output, int width);
+    RTCD_EXTERN void(*svt_av1_highbd_resize_filter_rows)(const uint16_t *const *rows, const int16_t *filter, uint16_t *output, int width, int bd);
+    void svt_av1_highbd_resize_filter_rows_c(const uint16_t *const *rows, const int16_t *filter, uint16_t *output, int width, int bd);
     RTCD_EXTERN uint8_t(*svt_av1_compute_cul_level)(const int16_t* const scan, const int32_t* const quant_coeff, uint16_t* eob);
     uint8_t svt_av1_compute_cul_level_c(const int16_t* const scan, const int32_t* const quant_coeff, uint16_t* eob);
     RTCD_EXTERN double (*svt_ssim_8x8)(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp);
@@ -909,6 +914,16 @@ extern "C" {
     double svt_ssim_8x8_hbd_c(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     RTCD_EXTERN double (*svt_ssim_4x4_hbd)(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     double svt_ssim_4x4_hbd_c(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    RTCD_EXTERN void (*svt_av1_fgn_add_luma_noise)(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_luma_noise_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    RTCD_EXTERN void (*svt_av1_fgn_add_luma_noise_hbd)(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_luma_noise_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    RTCD_EXTERN void (*svt_av1_fgn_add_chroma_noise)(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    RTCD_EXTERN void (*svt_av1_fgn_add_chroma_noise_hbd)(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    RTCD_EXTERN void (*svt_av1_fgn_hor_boundary_overlap)(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height, int32_t grain_min, int32_t grain_max);
+    void svt_av1_fgn_hor_boundary_overlap_c(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height, int32_t grain_min, int32_t grain_max);
 
 #ifdef ARCH_AARCH64
     void svt_av1_compute_stats_neon(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
@@ -1234,6 +1249,11 @@ extern "C" {
                                                         uint32_t *p_best_mv64x64, uint32_t mv, uint32_t p_sad32x32[4][8]);
 
     uint8_t svt_av1_compute_cul_level_neon(const int16_t *const scan, const int32_t *const quant_coeff, uint16_t *eob);
+    void svt_av1_fgn_add_luma_noise_neon(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_luma_noise_hbd_neon(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_neon(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_hbd_neon(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    void svt_av1_fgn_hor_boundary_overlap_neon(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height, int32_t grain_min, int32_t grain_max);
 
     void svt_aom_apply_filtering_central_neon(struct MeContext *me_ctx, EbPictureBufferDesc *input_picture_ptr_central,
                                               EbByte *src, uint32_t **accum, uint16_t **count, uint16_t blk_width,
@@ -2097,11 +2117,22 @@ extern "C" {
     void svt_av1_highbd_down2_symeven_avx2(const uint16_t *const input, int length, uint16_t *output, int bd);
     EbErrorType svt_av1_highbd_resize_plane_avx2(const uint16_t *const input, int height, int width, int in_stride, uint16_t *output, int height2, int width2, int out_stride, int bd);
     EbErrorType svt_av1_resize_plane_avx2(const uint8_t *const input, int height, int width, int in_stride, uint8_t *output, int height2, int width2, int out_stride);
+    void svt_av1_resize_filter_rows_avx2(const uint8_t *const *rows, const int16_t *filter, uint8_t *output, int width);
+    void svt_av1_highbd_resize_filter_rows_avx2(const uint16_t *const *rows, const int16_t *filter, uint16_t *output, int width, int bd);
     uint8_t svt_av1_compute_cul_level_avx2(const int16_t* const scan, const int32_t* const quant_coeff, uint16_t* eob);
     double svt_ssim_8x8_avx2(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp);
     double svt_ssim_4x4_avx2(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp);
     double svt_ssim_8x8_hbd_avx2(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     double svt_ssim_4x4_hbd_avx2(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    void svt_av1_fgn_add_luma_noise_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_luma_noise_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_hbd_avx2(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    void svt_av1_fgn_hor_boundary_overlap_avx2(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block, int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height, int32_t grain_min, int32_t grain_max);
+    void svt_av1_fgn_add_luma_noise_avx512(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_luma_noise_hbd_avx512(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_avx512(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
+    void svt_av1_fgn_add_chroma_noise_hbd_avx512(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling);
 #endif
 
     /* Moved to aom_dsp_rtcd.c file:
@@ -1231,7 +1231,7 @@ int svt_av1_full_pixel_search(PictureControlSet *pcs, IntraBcContext *x, BlockSi
                 int       best_hash_cost = INT_MAX;
 
                 // for the hashMap
-                HashTable *ref_frame_hash = &pcs->hash_table;
+                HashTable *ref_frame_hash = &pcs->hash_index.table;
 
                 svt_av1_get_block_hash_value(what, what_stride, block_width, &hash_value1, &hash_value2, 0, pcs, x);
 
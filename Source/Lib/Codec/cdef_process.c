@@ -466,7 +466,7 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
             uint32_t segment_index;
             for (segment_index = 0; segment_index < pcs->rest_segments_total_count; ++segment_index) {
                 // Get Empty Cdef Results to Rest
-                svt_get_empty_object(context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper);
+                EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->cdef_output_fifo_ptr, &cdef_results_wrapper);
                 cdef_results                = (struct CdefResults *)cdef_results_wrapper->object_ptr;
                 cdef_results->pcs_wrapper   = dlf_results->pcs_wrapper;
                 cdef_results->segment_index = segment_index;
@@ -0,0 +1,281 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "checkpoint.h"
+#include "encode_context.h"
+#include "sequence_control_set.h"
+#include "pcs.h"
+#include "svt_threads.h"
+#include "svt_malloc.h"
+#include "svt_log.h"
+
+#define CHECKPOINT_MAGIC 0x54504b43 // "CKPT"
+// Bumped whenever the layout or the meaning of EncCheckpoint changes
+#define CHECKPOINT_VERSION 1
+
+// Serialized as is: the pointers it holds are replaced by the ones of the resumed encoder
+typedef struct EncCheckpoint {
+    uint32_t         magic;
+    uint32_t         version;
+    uint32_t         size;
+    CheckpointConfig cfg;
+    uint64_t         picture_number; // in the stream
+    int64_t          pts; // of the key frame, to match its packet
+    uint64_t         byte_offset;
+    uint16_t         film_grain_random_seed; // of the key frame
+    Bool             has_rc;
+    uint32_t         cr_sb_end;
+    RATE_CONTROL     rc;
+    TWO_PASS         twopass;
+    FIRSTPASS_STATS  total_stats;
+    FIRSTPASS_STATS  total_left_stats;
+    int64_t          last_frame_accumulated; // relative to the key frame
+    RateControlIntervalParamContext rc_param;
+} EncCheckpoint;
+
+void svt_aom_checkpoint_set_config(CheckpointCtrl *ctrl, const EbSvtAv1EncConfiguration *cfg) {
+    CheckpointConfig *out = &ctrl->config;
+    memset(out, 0, sizeof(*out));
+    out->source_width           = cfg->source_width;
+    out->source_height          = cfg->source_height;
+    out->encoder_bit_depth      = cfg->encoder_bit_depth;
+    out->enc_mode               = cfg->enc_mode;
+    out->rate_control_mode      = cfg->rate_control_mode;
+    out->target_bit_rate        = cfg->target_bit_rate;
+    out->qp                     = cfg->qp;
+    out->intra_period_length    = cfg->intra_period_length;
+    out->hierarchical_levels    = cfg->hierarchical_levels;
+    out->pred_structure         = cfg->pred_structure;
+    out->pass                   = cfg->pass;
+    out->frame_rate_numerator   = cfg->frame_rate_numerator;
+    out->frame_rate_denominator = cfg->frame_rate_denominator;
+    out->look_ahead_distance    = cfg->look_ahead_distance;
+}
+
+EbErrorType svt_aom_checkpoint_check(const CheckpointCtrl *ctrl, const SvtAv1FixedBuf *state) {
+    const EncCheckpoint *ckpt = (const EncCheckpoint *)state->buf;
+    if (state->sz != sizeof(EncCheckpoint) || ckpt->magic != CHECKPOINT_MAGIC || ckpt->version != CHECKPOINT_VERSION ||
+        ckpt->size != sizeof(EncCheckpoint))
+        return EB_ErrorBadParameter;
+    if (memcmp(&ctrl->config, &ckpt->cfg, sizeof(ctrl->config)))
+        return EB_ErrorBadParameter;
+    return EB_ErrorNone;
+}
+
+EbErrorType svt_aom_checkpoint_ctrl_init(CheckpointCtrl *ctrl, SequenceControlSet *scs) {
+    const EbSvtAv1EncConfiguration *cfg = &scs->static_config;
+    svt_aom_checkpoint_ctrl_free(ctrl);
+    // the mutex is owned by the encode context, the configuration is set with the parameters
+    EbHandle               mutex  = ctrl->mutex;
+    const CheckpointConfig config = ctrl->config;
+    memset(ctrl, 0, sizeof(*ctrl));
+    ctrl->mutex  = mutex;
+    ctrl->config = config;
+    // open GOP key frames are decoded with the pictures before them
+    if (cfg->intra_refresh_type != SVT_AV1_KF_REFRESH || cfg->pass == ENC_FIRST_PASS || cfg->pipelined_two_pass ||
+        cfg->max_bit_rate)
+        return EB_ErrorNone;
+    ctrl->enabled = TRUE;
+    for (int i = 0; i < CHECKPOINT_PENDING_MAX; i++) EB_CALLOC(ctrl->pending[i], 1, sizeof(EncCheckpoint));
+    EB_CALLOC(ctrl->output, 1, sizeof(EncCheckpoint));
+    if (cfg->resume_checkpoint.buf) {
+        EB_MALLOC(ctrl->resume, sizeof(EncCheckpoint));
+        memcpy(ctrl->resume, cfg->resume_checkpoint.buf, sizeof(EncCheckpoint));
+        ctrl->resume_pending         = TRUE;
+        ctrl->picture_offset         = ctrl->resume->picture_number;
+        ctrl->byte_count             = ctrl->resume->byte_offset;
+        scs->film_grain_random_seed  = ctrl->resume->film_grain_random_seed;
+        // the second pass statistics are rebased to the key frame, they must cover it
+        if (cfg->pass == ENC_SECOND_PASS && !scs->lap_rc &&
+            ctrl->picture_offset + 1 >= cfg->rc_stats_buffer.sz / sizeof(FIRSTPASS_STATS)) {
+            SVT_ERROR("The two pass statistics do not cover the checkpoint key frame\n");
+            return EB_ErrorBadParameter;
+        }
+    }
+    return EB_ErrorNone;
+}
+
+void svt_aom_checkpoint_ctrl_free(CheckpointCtrl *ctrl) {
+    for (int i = 0; i < CHECKPOINT_PENDING_MAX; i++) EB_FREE(ctrl->pending[i]);
+    EB_FREE(ctrl->output);
+    EB_FREE(ctrl->resume);
+    EB_FREE(ctrl->rebased_stats);
+}
+
+uint64_t svt_aom_stream_picture_number(const PictureParentControlSet *ppcs) {
+    return ppcs->picture_number + ppcs->scs->enc_ctx->checkpoint_ctrl.picture_offset;
+}
+
+Bool svt_aom_is_stream_start(const PictureParentControlSet *ppcs) {
+    return ppcs->picture_number == 0 && ppcs->scs->enc_ctx->checkpoint_ctrl.picture_offset == 0;
+}
+
+static void save_state(PictureControlSet *pcs, EncCheckpoint *ckpt) {
+    PictureParentControlSet *ppcs    = pcs->ppcs;
+    SequenceControlSet      *scs     = pcs->scs;
+    EncodeContext           *enc_ctx = scs->enc_ctx;
+    STATS_BUFFER_CTX        *stats   = scs->twopass.stats_buf_ctx;
+
+    memset(ckpt, 0, sizeof(*ckpt));
+    ckpt->magic   = CHECKPOINT_MAGIC;
+    ckpt->version = CHECKPOINT_VERSION;
+    ckpt->size    = sizeof(*ckpt);
+    ckpt->cfg     = enc_ctx->checkpoint_ctrl.config;
+    ckpt->picture_number         = svt_aom_stream_picture_number(ppcs);
+    ckpt->pts                    = ppcs->input_ptr->pts;
+    ckpt->film_grain_random_seed = ppcs->frm_hdr.film_grain_params.random_seed;
+    ckpt->has_rc                 = scs->static_config.rate_control_mode != SVT_AV1_RC_MODE_CQP_OR_CRF;
+    if (!ckpt->has_rc)
+        return;
+    ckpt->cr_sb_end = enc_ctx->cr_sb_end;
+    ckpt->rc        = enc_ctx->rc;
+    ckpt->twopass   = scs->twopass;
+    if (stats) {
+        ckpt->total_stats            = *stats->total_stats;
+        ckpt->total_left_stats       = *stats->total_left_stats;
+        ckpt->last_frame_accumulated = stats->last_frame_accumulated - (int64_t)ppcs->picture_number;
+    }
+    if (ppcs->rate_control_param_ptr)
+        ckpt->rc_param = *ppcs->rate_control_param_ptr;
+}
+
+static void restore_state(PictureControlSet *pcs, const EncCheckpoint *ckpt) {
+    PictureParentControlSet *ppcs    = pcs->ppcs;
+    SequenceControlSet      *scs     = pcs->scs;
+    EncodeContext           *enc_ctx = scs->enc_ctx;
+    if (!ckpt->has_rc)
+        return;
+    enc_ctx->cr_sb_end = ckpt->cr_sb_end;
+
+    // keep the buffers and the handles of this encoder
+    RATE_CONTROL *rc                            = &enc_ctx->rc;
+    coded_frames_stats_entry **stat_queue       = rc->coded_frames_stat_queue;
+    const uint32_t             stat_queue_head  = rc->coded_frames_stat_queue_head_index;
+    const uint32_t             stat_queue_tail  = rc->coded_frames_stat_queue_tail_index;
+    EbHandle                   rc_mutex         = rc->rc_mutex;
+    *rc                                         = ckpt->rc;
+    rc->coded_frames_stat_queue                 = stat_queue;
+    rc->coded_frames_stat_queue_head_index      = stat_queue_head;
+    rc->coded_frames_stat_queue_tail_index      = stat_queue_tail;
+    rc->rc_mutex                                = rc_mutex;
+
+    TWO_PASS              *twopass   = &scs->twopass;
+    const FIRSTPASS_STATS *stats_in  = twopass->stats_in;
+    STATS_BUFFER_CTX      *stats     = twopass->stats_buf_ctx;
+    *twopass                         = ckpt->twopass;
+    twopass->stats_in                = stats_in;
+    twopass->stats_buf_ctx           = stats;
+    if (stats) {
+        *stats->total_stats           = ckpt->total_stats;
+        *stats->total_left_stats      = ckpt->total_left_stats;
+        stats->last_frame_accumulated = ckpt->last_frame_accumulated + (int64_t)ppcs->picture_number;
+    }
+
+    RateControlIntervalParamContext *rc_param = ppcs->rate_control_param_ptr;
+    if (rc_param) {
+        const RateControlIntervalParamContext keep = *rc_param;
+        *rc_param                                  = ckpt->rc_param;
+        rc_param->dctor                            = keep.dctor;
+        rc_param->first_poc                        = keep.first_poc;
+        rc_param->size                             = keep.size;
+        rc_param->processed_frame_number           = keep.processed_frame_number;
+    }
+}
+
+void svt_aom_checkpoint_key_frame(PictureControlSet *pcs) {
+    PictureParentControlSet *ppcs = pcs->ppcs;
+    CheckpointCtrl          *ctrl = &pcs->scs->enc_ctx->checkpoint_ctrl;
+    if (!ctrl->enabled || ppcs->frm_hdr.frame_type != KEY_FRAME)
+        return;
+    svt_block_on_mutex(ctrl->mutex);
+    if (ctrl->resume_pending && ppcs->picture_number == 0) {
+        restore_state(pcs, ctrl->resume);
+        ctrl->resume_pending = FALSE;
+    }
+    // the entry of the key frame, a free one, or the one of the oldest key frame
+    int idx = -1;
+    for (int i = 0; i < CHECKPOINT_PENDING_MAX; i++) {
+        if (ctrl->pending_used[i] && ctrl->pending[i]->pts == ppcs->input_ptr->pts) {
+            idx = i;
+            break;
+        }
+        if (idx < 0 || (ctrl->pending_used[idx] &&
+                        (!ctrl->pending_used[i] ||
+                         ctrl->pending[i]->picture_number < ctrl->pending[idx]->picture_number)))
+            idx = i;
+    }
+    save_state(pcs, ctrl->pending[idx]);
+    ctrl->pending_used[idx] = TRUE;
+    svt_release_mutex(ctrl->mutex);
+}
+
+EbErrorType svt_aom_checkpoint_rebase_stats(SequenceControlSet *scs) {
+    CheckpointCtrl   *ctrl   = &scs->enc_ctx->checkpoint_ctrl;
+    STATS_BUFFER_CTX *stats  = scs->twopass.stats_buf_ctx;
+    const uint64_t    offset = ctrl->picture_offset;
+    const uint64_t    frames = (uint64_t)(stats->stats_in_end - stats->stats_in_start);
+    if (!offset)
+        return EB_ErrorNone;
+    if (offset >= frames)
+        return EB_ErrorBadParameter;
+    // the frames from the key frame on, and the totals after them
+    FIRSTPASS_STATS *rebased;
+    EB_MALLOC_ARRAY(rebased, frames - offset + 1);
+    memcpy(rebased, stats->stats_in_start + offset, sizeof(*rebased) * (frames - offset + 1));
+    for (uint64_t i = 0; i < frames - offset; i++) rebased[i].frame -= (double)offset;
+    EB_FREE(ctrl->rebased_stats);
+    ctrl->rebased_stats        = rebased;
+    stats->stats_in_start      = rebased;
+    stats->stats_in_end_write  = rebased + frames - offset;
+    stats->stats_in_end        = rebased + frames - offset;
+    scs->twopass.stats_in      = rebased;
+    return EB_ErrorNone;
+}
+
+void svt_aom_checkpoint_packet(CheckpointCtrl *ctrl, const EbBufferHeaderType *packet, Bool tile_group_output) {
+    if (!ctrl->enabled)
+        return;
+    svt_block_on_mutex(ctrl->mutex);
+    if (!ctrl->in_frame && packet->pic_type == EB_AV1_KEY_PICTURE) {
+        for (int i = 0; i < CHECKPOINT_PENDING_MAX; i++) {
+            if (!ctrl->pending_used[i] || ctrl->pending[i]->pts != packet->pts)
+                continue;
+            EncCheckpoint *ckpt     = ctrl->pending[i];
+            ctrl->pending[i]        = ctrl->output;
+            ctrl->pending_used[i]   = FALSE;
+            ctrl->output            = ckpt;
+            ctrl->output->byte_offset = ctrl->byte_count;
+            ctrl->output_valid      = TRUE;
+            break;
+        }
+    }
+    ctrl->byte_count += packet->n_filled_len;
+    ctrl->in_frame = tile_group_output && !(packet->flags & (EB_BUFFERFLAG_LAST_FRAGMENT | EB_BUFFERFLAG_EOS));
+    svt_release_mutex(ctrl->mutex);
+}
+
+EbErrorType svt_aom_checkpoint_get(CheckpointCtrl *ctrl, SvtAv1Checkpoint *checkpoint) {
+    memset(checkpoint, 0, sizeof(*checkpoint));
+    if (!ctrl->enabled)
+        return EB_NoErrorEmptyQueue;
+    svt_block_on_mutex(ctrl->mutex);
+    const Bool valid = ctrl->output_valid;
+    if (valid) {
+        checkpoint->picture_number = ctrl->output->picture_number;
+        checkpoint->byte_offset    = ctrl->output->byte_offset;
+        checkpoint->state.buf      = ctrl->output;
+        checkpoint->state.sz       = sizeof(EncCheckpoint);
+    }
+    svt_release_mutex(ctrl->mutex);
+    return valid ? EB_ErrorNone : EB_NoErrorEmptyQueue;
+}
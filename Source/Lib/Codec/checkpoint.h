@@ -0,0 +1,101 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbCheckpoint_h
+#define EbCheckpoint_h
+
+#include "definitions.h"
+#include "EbSvtAv1Enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Key frames whose state is kept until their packet is output
+#define CHECKPOINT_PENDING_MAX 8
+
+// Configuration the state is only valid with
+typedef struct CheckpointConfig {
+    uint32_t source_width;
+    uint32_t source_height;
+    uint32_t encoder_bit_depth;
+    int32_t  enc_mode;
+    uint32_t rate_control_mode;
+    uint32_t target_bit_rate;
+    uint32_t qp;
+    int32_t  intra_period_length;
+    uint32_t hierarchical_levels;
+    uint32_t pred_structure;
+    uint32_t pass;
+    uint32_t frame_rate_numerator;
+    uint32_t frame_rate_denominator;
+    uint32_t look_ahead_distance;
+} CheckpointConfig;
+
+struct EncCheckpoint;
+struct SequenceControlSet;
+struct PictureControlSet;
+struct PictureParentControlSet;
+
+/*
+ * Key frame checkpoints (SVT_AV1_STREAM_INFO_CHECKPOINT / resume_checkpoint)
+ * Rate control saves the state it carries across pictures (RATE_CONTROL, TWO_PASS, the first pass
+ * statistics totals and the rate control interval of the key frame) when it processes a closed GOP
+ * key frame, before the key frame changes it. The state is published when the first packet of the key
+ * frame is output, with the size of the stream before it.
+ * A resumed encoder numbers its pictures from 0 as usual; picture_offset is added where the stream
+ * position shows in the bitstream (order hints) or in the rate control (frames left, stream start),
+ * and the two pass statistics are rebased to the key frame.
+ */
+typedef struct CheckpointCtrl {
+    EbHandle mutex;
+    Bool     enabled;
+    uint64_t picture_offset; // number in the stream of picture 0
+    uint64_t byte_count; // size of the stream output so far
+    Bool     in_frame; // the last packet output does not end its frame (tile group output)
+    // state to restore at picture 0, consumed by rate control
+    struct EncCheckpoint *resume;
+    Bool                  resume_pending;
+    // key frames processed by rate control, not yet output
+    struct EncCheckpoint *pending[CHECKPOINT_PENDING_MAX];
+    Bool                  pending_used[CHECKPOINT_PENDING_MAX];
+    // last key frame output
+    struct EncCheckpoint *output;
+    Bool                  output_valid;
+    // two pass statistics from the key frame on, when resuming the second pass
+    void *rebased_stats;
+    // configuration set by the application
+    CheckpointConfig config;
+} CheckpointCtrl;
+
+// Keep the configuration set by the application, before the encoder adjusts it
+void svt_aom_checkpoint_set_config(CheckpointCtrl *ctrl, const EbSvtAv1EncConfiguration *cfg);
+// Validate resume_checkpoint against the configuration
+EbErrorType svt_aom_checkpoint_check(const CheckpointCtrl *ctrl, const SvtAv1FixedBuf *state);
+// Allocate the checkpoints and load resume_checkpoint, once the configuration is final
+EbErrorType svt_aom_checkpoint_ctrl_init(CheckpointCtrl *ctrl, struct SequenceControlSet *scs);
+void        svt_aom_checkpoint_ctrl_free(CheckpointCtrl *ctrl);
+// Rate control: restore the state at picture 0 when resuming, and save it at key frames
+void svt_aom_checkpoint_key_frame(struct PictureControlSet *pcs);
+// Second pass: start the statistics at the resumed key frame
+EbErrorType svt_aom_checkpoint_rebase_stats(struct SequenceControlSet *scs);
+// Output: account for a packet returned to the application
+void svt_aom_checkpoint_packet(CheckpointCtrl *ctrl, const EbBufferHeaderType *packet, Bool tile_group_output);
+// EB_NoErrorEmptyQueue when no key frame with a checkpoint was output yet
+EbErrorType svt_aom_checkpoint_get(CheckpointCtrl *ctrl, SvtAv1Checkpoint *checkpoint);
+// Number of the picture in the stream, and whether it is the first picture of the stream
+uint64_t svt_aom_stream_picture_number(const struct PictureParentControlSet *ppcs);
+Bool     svt_aom_is_stream_start(const struct PictureParentControlSet *ppcs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbCheckpoint_h
@@ -1912,6 +1912,8 @@ EB_EXTERN EbErrorType svt_aom_encdec_update(SequenceControlSet *scs, PictureCont
             svt_block_on_mutex(pcs->ppcs->pcs_total_rate_mutex);
             pcs->ppcs->pcs_total_rate += blk_ptr->total_rate;
             svt_release_mutex(pcs->ppcs->pcs_total_rate_mutex);
+            if (pcs->sb_rate_ctrl.enabled)
+                pcs->sb_rate_ctrl.coded_rate[sb_addr] += blk_ptr->total_rate;
             // Copy recon to EncDec buffers if EncDec was bypassed;  if used pred depth only and NSQ is OFF data was copied directly to EncDec buffers in MD
             if (md_ctx->bypass_encdec && !(md_ctx->fixed_partition)) {
                 if (md_ctx->encoder_bit_depth > EB_EIGHT_BIT) {
@@ -0,0 +1,169 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "deadline_ctrl.h"
+#include "svt_threads.h"
+#include "svt_log.h"
+#include "utility.h"
+
+// Minimum number of output pictures before the speed can be moved again
+#define DEADLINE_MIN_WINDOW 8
+// The speed is increased below DEADLINE_LOW_PCT % of the target frame rate, and decreased when the
+// estimated capacity is above DEADLINE_HIGH_PCT % of it
+#define DEADLINE_LOW_PCT 97
+#define DEADLINE_HIGH_PCT 115
+
+void svt_aom_deadline_ctrl_init(DeadlineCtrl *ctrl, const EbSvtAv1EncConfiguration *cfg, uint32_t cores) {
+    // the mutex is owned by the encode context
+    EbHandle mutex = ctrl->mutex;
+    memset(ctrl, 0, sizeof(*ctrl));
+    ctrl->mutex = mutex;
+    ctrl->timed = cfg->picture_stats_cb != NULL;
+    if (!cfg->deadline_fps_numerator || !cfg->deadline_fps_denominator)
+        return;
+    ctrl->enabled      = TRUE;
+    ctrl->timed        = TRUE;
+    ctrl->target_fps   = (double)cfg->deadline_fps_numerator / cfg->deadline_fps_denominator;
+    ctrl->cores        = MAX(cores, 1);
+    ctrl->min_enc_mode = (EncMode)cfg->enc_mode;
+    ctrl->max_enc_mode = svt_aom_deadline_fastest_enc_mode(cfg);
+}
+
+EncMode svt_aom_deadline_fastest_enc_mode(const EbSvtAv1EncConfiguration *cfg) {
+    if (!cfg->deadline_fps_numerator)
+        return (EncMode)cfg->enc_mode;
+    return (EncMode)MAX(cfg->enc_mode, (int8_t)MIN(cfg->deadline_max_preset, MAX_ENC_PRESET));
+}
+
+void svt_aom_deadline_update_speed(DeadlineCtrl *ctrl, uint32_t mg_size) {
+    svt_block_on_mutex(ctrl->mutex);
+    if (ctrl->window_open && ctrl->window_frames >= MAX(mg_size, DEADLINE_MIN_WINDOW)) {
+        const uint64_t now_us  = svt_av1_get_time_us();
+        const uint64_t cpu_us  = svt_av1_get_process_cpu_time_us();
+        const double   wall_us = (double)MAX(now_us - ctrl->window_start_us, 1);
+        const double   fps     = ctrl->window_frames * 1000000.0 / wall_us;
+        // When the input or the output is the bottleneck, the frame rate alone does not show the headroom
+        const double util = CLIP3(
+            0.05, 1.0, (double)(cpu_us - ctrl->window_cpu_start_us) / (wall_us * ctrl->cores));
+        const double capacity = fps / util;
+        int32_t      delta    = 0;
+        if (fps * 100 < ctrl->target_fps * DEADLINE_LOW_PCT)
+            delta = (int32_t)CLIP3(DEADLINE_SPEED_ONE / 8,
+                                   DEADLINE_SPEED_ONE * 4,
+                                   2 * DEADLINE_SPEED_ONE * (ctrl->target_fps / fps - 1));
+        else if (capacity * 100 > ctrl->target_fps * DEADLINE_HIGH_PCT)
+            delta = -(int32_t)CLIP3(DEADLINE_SPEED_ONE / 16,
+                                    DEADLINE_SPEED_ONE / 2,
+                                    DEADLINE_SPEED_ONE * (capacity / ctrl->target_fps - 1) / 2);
+        const int32_t max_speed = (ctrl->max_enc_mode - ctrl->min_enc_mode) * DEADLINE_SPEED_ONE;
+        const int32_t speed     = CLIP3(0, max_speed, ctrl->speed + delta);
+        if (speed != ctrl->speed) {
+            // wait for the pictures decided at the new speed before measuring again
+            ctrl->speed = speed;
+            ctrl->epoch++;
+            ctrl->speed_changes++;
+            ctrl->window_open = FALSE;
+        } else {
+            ctrl->window_start_us     = now_us;
+            ctrl->window_cpu_start_us = cpu_us;
+            ctrl->window_frames       = 0;
+        }
+    }
+    svt_release_mutex(ctrl->mutex);
+}
+
+EncMode svt_aom_deadline_pic_enc_mode(const DeadlineCtrl *ctrl, uint8_t temporal_layer_index,
+                                      uint8_t hierarchical_levels) {
+    const int32_t base = ctrl->speed >> DEADLINE_SPEED_SHIFT;
+    const int32_t frac = ctrl->speed & (DEADLINE_SPEED_ONE - 1);
+    // The fractional part goes to the k highest temporal layers, which hold about 1 - 2^-k of the
+    // pictures of a mini-GOP and are the cheapest to code faster
+    int32_t best_k = 0;
+    for (int32_t k = 1; k <= hierarchical_levels + 1; k++) {
+        const int32_t share      = DEADLINE_SPEED_ONE - (DEADLINE_SPEED_ONE >> k);
+        const int32_t best_share = DEADLINE_SPEED_ONE - (DEADLINE_SPEED_ONE >> best_k);
+        if (ABS(share - frac) < ABS(best_share - frac))
+            best_k = k;
+    }
+    const int32_t faster = temporal_layer_index + best_k > hierarchical_levels;
+    return (EncMode)CLIP3(ctrl->min_enc_mode, ctrl->max_enc_mode, ctrl->min_enc_mode + base + faster);
+}
+
+void svt_aom_deadline_picture_done(DeadlineCtrl *ctrl, uint32_t epoch, EncMode enc_mode, Bool is_overlay,
+                                   const uint64_t *stage_time_us) {
+    // overlays are coded in addition to the input pictures
+    if (is_overlay)
+        return;
+    const uint64_t now_us = svt_av1_get_time_us();
+    svt_block_on_mutex(ctrl->mutex);
+    if (!ctrl->frame_count)
+        ctrl->start_us = stage_time_us[0];
+    ctrl->last_output_us = now_us;
+    ctrl->frame_count++;
+    ctrl->preset_sum += enc_mode;
+    ctrl->preset_frame_count[CLIP3(ENC_MR, MAX_ENC_PRESET, enc_mode) + 1]++;
+    for (int s = 0; s < SVT_AV1_DEADLINE_STAGES; s++)
+        if (stage_time_us[s + 1] > stage_time_us[s])
+            ctrl->stage_us[s] += stage_time_us[s + 1] - stage_time_us[s];
+
+    if (ctrl->window_open)
+        ctrl->window_frames++;
+    else if (epoch == ctrl->epoch) {
+        ctrl->window_open         = TRUE;
+        ctrl->window_start_us     = now_us;
+        ctrl->window_cpu_start_us = svt_av1_get_process_cpu_time_us();
+        ctrl->window_frames       = 0;
+    }
+    svt_release_mutex(ctrl->mutex);
+}
+
+void svt_aom_deadline_get_stats(DeadlineCtrl *ctrl, SvtAv1DeadlineStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (!ctrl->enabled)
+        return;
+    svt_block_on_mutex(ctrl->mutex);
+    stats->target_fps    = ctrl->target_fps;
+    stats->frame_count   = ctrl->frame_count;
+    stats->speed_changes = ctrl->speed_changes;
+    if (ctrl->frame_count) {
+        const uint64_t elapsed_us = ctrl->last_output_us - ctrl->start_us;
+        stats->achieved_fps       = elapsed_us ? ctrl->frame_count * 1000000.0 / elapsed_us : 0;
+        stats->average_preset     = (double)ctrl->preset_sum / ctrl->frame_count;
+        for (int s = 0; s < SVT_AV1_DEADLINE_STAGES; s++)
+            stats->stage_ms[s] = ctrl->stage_us[s] / 1000.0 / ctrl->frame_count;
+    }
+    memcpy(stats->preset_frame_count, ctrl->preset_frame_count, sizeof(stats->preset_frame_count));
+    svt_release_mutex(ctrl->mutex);
+}
+
+void svt_aom_deadline_print_stats(DeadlineCtrl *ctrl) {
+    SvtAv1DeadlineStats stats;
+    svt_aom_deadline_get_stats(ctrl, &stats);
+    if (!stats.frame_count)
+        return;
+    SVT_INFO("SVT [deadline]: target / achieved fps \t\t\t\t\t: %.2f / %.2f\n", stats.target_fps, stats.achieved_fps);
+    SVT_INFO("SVT [deadline]: average preset / speed changes \t\t\t\t: %.2f / %u\n",
+             stats.average_preset,
+             stats.speed_changes);
+    for (int p = ENC_MR; p <= MAX_ENC_PRESET; p++)
+        if (stats.preset_frame_count[p + 1])
+            SVT_INFO("SVT [deadline]: preset %2d \t\t\t\t\t\t: %llu frames\n",
+                     p,
+                     (unsigned long long)stats.preset_frame_count[p + 1]);
+    SVT_INFO("SVT [deadline]: lookahead / motion / rc / encode / post \t\t: %.1f / %.1f / %.1f / %.1f / %.1f ms\n",
+             stats.stage_ms[SVT_AV1_DEADLINE_STAGE_LOOKAHEAD],
+             stats.stage_ms[SVT_AV1_DEADLINE_STAGE_MOTION],
+             stats.stage_ms[SVT_AV1_DEADLINE_STAGE_RATE_CONTROL],
+             stats.stage_ms[SVT_AV1_DEADLINE_STAGE_ENCODE],
+             stats.stage_ms[SVT_AV1_DEADLINE_STAGE_POST]);
+}
@@ -0,0 +1,80 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbDeadlineCtrl_h
+#define EbDeadlineCtrl_h
+
+#include "definitions.h"
+#include "EbSvtAv1Enc.h"
+#include "svt_time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The speed of the deadline mode is a fixed point number of presets above the configured preset
+#define DEADLINE_SPEED_SHIFT 8
+#define DEADLINE_SPEED_ONE (1 << DEADLINE_SPEED_SHIFT)
+
+/*
+ * Wall-clock deadline mode
+ * The speed is moved at mini-GOP boundaries in picture decision, from the output frame rate and the
+ * CPU utilization measured over the pictures output since the last move, and mapped onto the preset
+ * (enc_mode) of each picture, which drives the feature levels of all the later stages.
+ */
+typedef struct DeadlineCtrl {
+    EbHandle mutex;
+    Bool     enabled;
+    Bool     timed; // the stage boundaries of the pictures are stamped, for the deadline mode or the picture statistics
+    double   target_fps;
+    uint32_t cores; // processors the encoder runs on, to turn the process CPU time into a utilization
+    EncMode  min_enc_mode; // configured preset, slowest
+    EncMode  max_enc_mode; // deadline_max_preset, fastest
+    int32_t  speed; // in 1/DEADLINE_SPEED_ONE presets above min_enc_mode, only written by picture decision
+    uint32_t epoch; // incremented every time the speed is moved
+    // Measurement window, opened when the first picture decided at the current speed is output
+    Bool     window_open;
+    uint64_t window_start_us;
+    uint64_t window_cpu_start_us;
+    uint32_t window_frames;
+    // Report
+    uint64_t start_us;
+    uint64_t last_output_us;
+    uint64_t frame_count;
+    int64_t  preset_sum;
+    uint32_t speed_changes;
+    uint64_t preset_frame_count[MAX_ENC_PRESET + 2];
+    uint64_t stage_us[SVT_AV1_DEADLINE_STAGES];
+} DeadlineCtrl;
+
+void svt_aom_deadline_ctrl_init(DeadlineCtrl *ctrl, const EbSvtAv1EncConfiguration *cfg, uint32_t cores);
+// Fastest preset a picture can be coded at, for the allocations that grow with the preset. cfg is the
+// static config of the sequence, where the preset and deadline_max_preset are already mapped to the
+// presets the configuration supports
+EncMode svt_aom_deadline_fastest_enc_mode(const EbSvtAv1EncConfiguration *cfg);
+void    svt_aom_deadline_update_speed(DeadlineCtrl *ctrl, uint32_t mg_size);
+EncMode svt_aom_deadline_pic_enc_mode(const DeadlineCtrl *ctrl, uint8_t temporal_layer_index,
+                                      uint8_t hierarchical_levels);
+// stage_time_us holds the SVT_AV1_DEADLINE_STAGES + 1 stage boundaries of the picture
+void svt_aom_deadline_picture_done(DeadlineCtrl *ctrl, uint32_t epoch, EncMode enc_mode, Bool is_overlay,
+                                   const uint64_t *stage_time_us);
+void svt_aom_deadline_get_stats(DeadlineCtrl *ctrl, SvtAv1DeadlineStats *stats);
+void svt_aom_deadline_print_stats(DeadlineCtrl *ctrl);
+
+static INLINE void svt_aom_deadline_stamp(const DeadlineCtrl *ctrl, uint64_t *time_us) {
+    if (ctrl->timed)
+        *time_us = svt_av1_get_time_us();
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDeadlineCtrl_h
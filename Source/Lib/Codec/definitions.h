@@ -302,6 +302,8 @@ enum {
  * FUTURE_WINDOW_WIDTH defined in EbPictureDecisionProcess.c
  */
 #define ALTREF_MAX_NFRAMES 33
+// maximum number of pictures holding a 16-bit view for temporal filtering across windows
+#define TF_HIGHBD_VIEW_MAX (2 * ALTREF_MAX_NFRAMES)
 #define ALTREF_MAX_STRENGTH 6
 #define PAD_VALUE (128 + 32)
 #define PAD_VALUE_SCALED (128 + 128 + 32)
@@ -2324,6 +2326,9 @@ EbPtr handle;
 void(*error_handler)(
     EbPtr handle,
     uint32_t errorCode);
+// Wakes the processes of the handle once the pipeline stopped on an error
+void(*stop_handler)(
+    EbPtr handle);
 } EbCallback;
 
 // Common Macros
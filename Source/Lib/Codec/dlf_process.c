@@ -144,7 +144,7 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
 
         for (segment_index = 0; segment_index < pcs->cdef_segments_total_count; ++segment_index) {
             // Get Empty DLF Results to Cdef
-            svt_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper);
             dlf_results                = (struct DlfResults *)dlf_results_wrapper->object_ptr;
             dlf_results->pcs_wrapper   = enc_dec_results->pcs_wrapper;
             dlf_results->segment_index = segment_index;
@@ -183,6 +183,8 @@ static void reset_entropy_coding_picture(EntropyCodingContext *ctx, PictureContr
 
         entropy_coding_reset_neighbor_arrays(pcs, tile_idx);
     }
+    pcs->tile_group_next  = 0;
+    pcs->tile_group_bytes = 0;
 }
 
 /* Entropy Coding */
@@ -286,6 +288,20 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
                 break;
             }
         }
+        // Tile group output: let packetization send the tile, posted under the mutex to come ahead of the
+        // results of the picture
+        if (!pic_ready && scs->static_config.tile_group_output) {
+            if (svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr,
+                                     &entropy_coding_results_wrapper_ptr) != EB_ErrorNone) {
+                svt_release_mutex(pcs->entropy_coding_pic_mutex);
+                svt_aom_post_error_packet(scs->enc_ctx);
+                return NULL;
+            }
+            entropy_coding_results_ptr = (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
+            entropy_coding_results_ptr->pcs_wrapper = rest_results->pcs_wrapper;
+            entropy_coding_results_ptr->tiles_ready = TRUE;
+            svt_post_full_object(entropy_coding_results_wrapper_ptr);
+        }
         svt_release_mutex(pcs->entropy_coding_pic_mutex);
         if (pic_ready) {
             if (pcs->ppcs->superres_total_recode_loop == 0) {
@@ -311,9 +327,11 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
 
         if (frame_entropy_done) {
             // Get Empty Entropy Coding Results
-            svt_get_empty_object(context_ptr->entropy_coding_output_fifo_ptr, &entropy_coding_results_wrapper_ptr);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->entropy_coding_output_fifo_ptr,
+                                &entropy_coding_results_wrapper_ptr);
             entropy_coding_results_ptr = (EntropyCodingResults *)entropy_coding_results_wrapper_ptr->object_ptr;
             entropy_coding_results_ptr->pcs_wrapper = rest_results->pcs_wrapper;
+            entropy_coding_results_ptr->tiles_ready = FALSE;
 
             // Post EntropyCoding Results
             svt_post_full_object(entropy_coding_results_wrapper_ptr);
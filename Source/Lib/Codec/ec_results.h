@@ -24,6 +24,8 @@ extern "C" {
 typedef struct EntropyCodingResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
+    // Tile group output: tiles of the picture are entropy coded, the picture is not done yet
+    Bool tiles_ready;
 } EntropyCodingResults;
 
 typedef struct EntropyCodingResultsInitData {
@@ -124,6 +124,7 @@ EbErrorType svt_aom_enc_dec_context_ctor(EbThreadContext *thread_ctx, const EbEn
            color_format,
            enc_handle_ptr->scs_instance_array[0]->scs->super_block_size,
            static_config->enc_mode,
+           svt_aom_deadline_fastest_enc_mode(static_config),
            enc_handle_ptr->scs_instance_array[0]->scs->max_block_cnt,
            static_config->encoder_bit_depth,
            0,
@@ -365,7 +366,11 @@ static Bool assign_enc_dec_segments(EncDecSegments *segmentPtr, uint16_t *segmen
 
         if (feedback_row_index > 0) {
             EbObjectWrapper *wrapper_ptr;
-            svt_get_empty_object(srmFifoPtr, &wrapper_ptr);
+            if (svt_get_empty_object(srmFifoPtr, &wrapper_ptr) != EB_ErrorNone) {
+                // The pipeline stopped, the rows are not fed back anymore
+                svt_aom_post_error_packet(((PictureControlSet *)taskPtr->pcs_wrapper->object_ptr)->scs->enc_ctx);
+                return continue_processing_flag;
+            }
             EncDecTasks *feedback_task         = (EncDecTasks *)wrapper_ptr->object_ptr;
             feedback_task->input_type          = ENCDEC_TASKS_ENCDEC_INPUT;
             feedback_task->enc_dec_segment_row = feedback_row_index;
@@ -481,7 +486,11 @@ void svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs) {
         Bool             is_16bit = (scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
         EbObjectWrapper *output_recon_wrapper_ptr;
         // Get Recon Buffer
-        svt_get_empty_object(scs->enc_ctx->recon_output_fifo_ptr, &output_recon_wrapper_ptr);
+        if (svt_get_empty_object(scs->enc_ctx->recon_output_fifo_ptr, &output_recon_wrapper_ptr) != EB_ErrorNone) {
+            svt_release_mutex(enc_ctx->total_number_of_recon_frame_mutex);
+            svt_aom_post_error_packet(enc_ctx);
+            return;
+        }
         EbBufferHeaderType *output_recon_ptr = (EbBufferHeaderType *)output_recon_wrapper_ptr->object_ptr;
         output_recon_ptr->flags              = 0;
 
@@ -2741,6 +2750,8 @@ static void recode_loop_decision_maker(PictureControlSet *pcs, SequenceControlSe
         // 2pass QPM with tpl_la
         if (scs->static_config.enable_adaptive_quantization == 2 && ppcs->tpl_ctrls.enable && ppcs->r0 != 0)
             svt_aom_sb_qp_derivation_tpl_la(pcs);
+        if (pcs->sb_rate_ctrl.enabled)
+            svt_aom_sb_rate_ctrl_rebase(pcs);
     } else {
         ppcs->loop_count = 0;
     }
@@ -3216,7 +3227,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
             pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
             pcs->ppcs->pa_me_data      = NULL;
             // Get Empty EncDec Results
-            svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
             enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
             enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
 
@@ -3235,7 +3246,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                 EbObjectWrapper *enc_dec_re_encode_tasks_wrapper;
                 uint16_t         tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
                 for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-                    svt_get_empty_object(ed_ctx->enc_dec_feedback_fifo_ptr, &enc_dec_re_encode_tasks_wrapper);
+                    EB_GET_EMPTY_OBJECT(scs->enc_ctx, ed_ctx->enc_dec_feedback_fifo_ptr,
+                                        &enc_dec_re_encode_tasks_wrapper);
 
                     EncDecTasks *enc_dec_re_encode_tasks_ptr = (EncDecTasks *)
                                                                    enc_dec_re_encode_tasks_wrapper->object_ptr;
@@ -3370,6 +3382,9 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                             ed_ctx->md_ctx->md_rate_est_ctx = ed_ctx->md_ctx->rate_est_table;
                         }
 
+                        // In-frame rate control of CBR
+                        if (pcs->sb_rate_ctrl.enabled)
+                            sb_ptr->qindex = svt_aom_sb_rate_ctrl_qindex(pcs, ed_ctx->tile_group_index, sb_index);
                         // Configure the SB
                         svt_aom_mode_decision_configure_sb(
                             ed_ctx->md_ctx,
@@ -3514,6 +3529,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                             svt_aom_encode_decode(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
                         }
                         svt_aom_encdec_update(scs, pcs, sb_ptr, sb_index, sb_origin_x, sb_origin_y, ed_ctx);
+                        if (pcs->sb_rate_ctrl.enabled)
+                            svt_aom_sb_rate_ctrl_update(pcs, ed_ctx->tile_group_index, sb_index);
 
                         ed_ctx->coded_sb_count++;
                     }
@@ -3537,8 +3554,13 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                     scs->enc_ctx->recode_loop != DISALLOW_RECODE) {
                     recode_loop_decision_maker(pcs, scs, &do_recode);
                 }
+                // The superblock rate control recodes only when the frame overflows the buffer, and
+                // leaves the frame to the recode loop when it already decided to recode
+                if (pcs->sb_rate_ctrl.enabled && !do_recode)
+                    do_recode = svt_aom_sb_rate_ctrl_recode(pcs);
 
                 if (do_recode) {
+                    pcs->ppcs->recode_count++;
                     // Deallocate the palette data
                     for (sb_index = 0; sb_index < pcs->enc_dec_coded_sb_count; ++sb_index) {
                         sb_ptr = pcs->sb_ptr_array[sb_index];
@@ -3560,7 +3582,8 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                     EbObjectWrapper *enc_dec_re_encode_tasks_wrapper;
                     uint16_t         tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
                     for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
-                        svt_get_empty_object(ed_ctx->enc_dec_feedback_fifo_ptr, &enc_dec_re_encode_tasks_wrapper);
+                        EB_GET_EMPTY_OBJECT(scs->enc_ctx, ed_ctx->enc_dec_feedback_fifo_ptr,
+                                            &enc_dec_re_encode_tasks_wrapper);
 
                         EncDecTasks *enc_dec_re_encode_tasks_ptr = (EncDecTasks *)
                                                                        enc_dec_re_encode_tasks_wrapper->object_ptr;
@@ -3606,8 +3629,10 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                         pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
                         pcs->ppcs->pa_me_data      = NULL;
                     }
+                    svt_aom_deadline_stamp(&scs->enc_ctx->deadline_ctrl,
+                                           &pcs->ppcs->deadline_time_us[SVT_AV1_DEADLINE_STAGE_POST]);
                     // Get Empty EncDec Results
-                    svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
+                    EB_GET_EMPTY_OBJECT(scs->enc_ctx, ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
                     enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
                     enc_dec_results->pcs_wrapper = enc_dec_tasks->pcs_wrapper;
 
@@ -541,6 +541,22 @@ static void svt_aom_set_me_8x8_var_ctrls(MeContext *me_ctx, uint8_t level) {
     default: assert(0);
     }
 }
+static void svt_aom_set_hash_me_ctrls(MeContext *me_ctx, uint8_t level) {
+    HashMeCtrls *hash_me_ctrls = &me_ctx->hash_me_ctrls;
+
+    switch (level) {
+    case 0: hash_me_ctrls->enabled = 0; break;
+    case 1:
+        hash_me_ctrls->enabled        = 1;
+        hash_me_ctrls->min_block_size = 8;
+        break;
+    case 2:
+        hash_me_ctrls->enabled        = 1;
+        hash_me_ctrls->min_block_size = 16;
+        break;
+    default: assert(0);
+    }
+}
 /*configure PreHme control*/
 static void svt_aom_set_prehme_ctrls(MeContext *me_ctx, uint8_t level) {
     PreHmeCtrls *ctrl = &me_ctx->prehme_ctrl;
@@ -791,6 +807,15 @@ void svt_aom_sig_deriv_me(SequenceControlSet *scs, PictureParentControlSet *pcs,
 
     uint8_t me_8x8_var_lvl = 2;
     svt_aom_set_me_8x8_var_ctrls(me_ctx, me_8x8_var_lvl);
+    // Set hash-based ME level (0-2)
+    uint8_t hash_me_level = 0;
+    if (sc_class1) {
+        if (enc_mode <= ENC_M5)
+            hash_me_level = 1;
+        else if (enc_mode <= ENC_M8)
+            hash_me_level = 2;
+    }
+    svt_aom_set_hash_me_ctrls(me_ctx, hash_me_level);
     if (enc_mode <= ENC_M5)
         me_ctx->prune_me_candidates_th = 0;
     else
@@ -862,6 +887,7 @@ void svt_aom_sig_deriv_me_tf(PictureParentControlSet *pcs, MeContext *me_ctx) {
     svt_aom_set_mv_based_sa_ctrls(me_ctx, 0);
 
     svt_aom_set_me_8x8_var_ctrls(me_ctx, 0);
+    svt_aom_set_hash_me_ctrls(me_ctx, 0);
     me_ctx->me_early_exit_th            = enc_mode <= ENC_M6 || resolution <= INPUT_SIZE_720p_RANGE
                    ? 0
                    : BLOCK_SIZE_64 * BLOCK_SIZE_64 * 4;
@@ -1958,7 +1984,9 @@ void svt_aom_sig_deriv_multi_processes(SequenceControlSet *scs, PictureParentCon
     else
         pcs->hbd_md = scs->enable_hbd_mode_decision;
 
-    pcs->max_can_count = svt_aom_get_max_can_count(enc_mode);
+    // The candidate buffers are allocated for the configured preset, and the sequence level
+    // decisions (e.g. the reference count) of that preset also hold in the deadline mode
+    pcs->max_can_count = svt_aom_get_max_can_count(MIN(enc_mode, (EncMode)scs->static_config.enc_mode));
     if (enc_mode <= ENC_M4)
         pcs->use_best_me_unipred_cand_only = 0;
     else
@@ -4306,6 +4334,22 @@ void svt_aom_set_wm_controls(ModeDecisionContext *ctx, uint8_t wm_level) {
     default: assert(0); break;
     }
 }
+// Get the tx_cache_level used for each preset; the cache only pays off when many tx types and NSQ shapes are
+// searched, so it is limited to the slowest presets
+uint8_t svt_aom_get_tx_cache_level(EncMode enc_mode) {
+    if (enc_mode <= ENC_M2)
+        return 1;
+    return 0;
+}
+static void set_tx_cache_controls(ModeDecisionContext *ctx, uint8_t tx_cache_level) {
+    TxCacheCtrls *tx_cache_ctrls = &ctx->tx_cache_ctrls;
+
+    switch (tx_cache_level) {
+    case 0: tx_cache_ctrls->enabled = 0; break;
+    case 1: tx_cache_ctrls->enabled = 1; break;
+    default: assert(0); break;
+    }
+}
 // Get the nic_level used for each preset (to be passed to setting function: svt_aom_set_nic_controls())
 uint8_t svt_aom_get_nic_level(EncMode enc_mode, uint8_t is_base, uint32_t qp, uint8_t seq_qp_mod) {
     uint8_t nic_level;
@@ -7703,6 +7747,8 @@ void svt_aom_sig_deriv_enc_dec(SequenceControlSet *scs, PictureControlSet *pcs,
     if (scs->low_latency_kf && is_islice)
         ctx->rdoq_level = 0;
     set_rdoq_controls(ctx, ctx->rdoq_level, rtc_tune);
+    // The cache is allocated at init time for the presets that use it
+    set_tx_cache_controls(ctx, ctx->tx_cache ? svt_aom_get_tx_cache_level(enc_mode) : 0);
 
     // There are only redundant blocks when HVA_HVB shapes are used
     if (pd_pass == PD_PASS_0 || !ctx->nsq_geom_ctrls.allow_HVA_HVB)
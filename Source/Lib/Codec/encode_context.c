@@ -14,6 +14,7 @@
 #include "encode_context.h"
 #include "EbSvtAv1ErrorCodes.h"
 #include "svt_threads.h"
+#include "svt_log.h"
 
 static EbErrorType create_stats_buffer(FIRSTPASS_STATS **frame_stats_buffer, STATS_BUFFER_CTX *stats_buf_context,
                                        int num_lap_buffers) {
@@ -58,8 +59,13 @@ static void encode_context_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->total_number_of_shown_frames_mutex);
 #endif
     EB_DESTROY_MUTEX(obj->sc_buffer_mutex);
+    EB_DESTROY_MUTEX(obj->deadline_ctrl.mutex);
+    svt_aom_checkpoint_ctrl_free(&obj->checkpoint_ctrl);
+    EB_DESTROY_MUTEX(obj->checkpoint_ctrl.mutex);
     EB_DESTROY_MUTEX(obj->stat_file_mutex);
+    EB_DESTROY_SEMAPHORE(obj->first_pass_semaphore);
     EB_DESTROY_MUTEX(obj->frame_updated_mutex);
+    EB_DESTROY_MUTEX(obj->pipeline_stopped.mutex);
     EB_DELETE(obj->prediction_structure_group_ptr);
     EB_DELETE_PTR_ARRAY(obj->picture_decision_reorder_queue, PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE(obj->pre_assignment_buffer);
@@ -94,6 +100,7 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
 
     EB_CREATE_MUTEX(enc_ctx->total_number_of_recon_frame_mutex);
     EB_CREATE_MUTEX(enc_ctx->frame_updated_mutex);
+    EB_CREATE_MUTEX(enc_ctx->pipeline_stopped.mutex);
     EB_ALLOC_PTR_ARRAY(enc_ctx->picture_decision_reorder_queue, PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
 
     for (picture_index = 0; picture_index < PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH; ++picture_index) {
@@ -142,6 +149,8 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     enc_ctx->terminating_picture_number = ~0u;
 
     EB_CREATE_MUTEX(enc_ctx->sc_buffer_mutex);
+    EB_CREATE_MUTEX(enc_ctx->deadline_ctrl.mutex);
+    EB_CREATE_MUTEX(enc_ctx->checkpoint_ctrl.mutex);
     enc_ctx->enc_mode         = SPEED_CONTROL_INIT_MOD;
     enc_ctx->recode_tolerance = 25;
     enc_ctx->rc_cfg.min_cr    = 0;
@@ -185,3 +194,54 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     enc_ctx->roi_map_evt = NULL;
     return EB_ErrorNone;
 }
+
+uint8_t *svt_aom_out_buffer_alloc(const SvtAv1OutputBufferAllocator *allocator, uint32_t size) {
+    uint8_t *buffer;
+    if (allocator->alloc) {
+        buffer = allocator->alloc(allocator->context, size);
+        if (!buffer)
+            SVT_ERROR("output buffer allocator failed to provide %u bytes\n", size);
+    } else
+        EB_NO_THROW_MALLOC(buffer, size);
+    return buffer;
+}
+
+void svt_aom_out_buffer_free(const SvtAv1OutputBufferAllocator *allocator, uint8_t **buffer) {
+    if (!*buffer)
+        return;
+    if (allocator->release) {
+        allocator->release(allocator->context, *buffer);
+        *buffer = NULL;
+    } else
+        EB_FREE(*buffer);
+}
+
+Bool svt_aom_pipeline_stopped(EncodeContext *enc_ctx) {
+    svt_block_on_mutex(enc_ctx->pipeline_stopped.mutex);
+    const Bool stopped = (Bool)enc_ctx->pipeline_stopped.obj;
+    svt_release_mutex(enc_ctx->pipeline_stopped.mutex);
+    return stopped;
+}
+
+void svt_aom_post_error_packet(EncodeContext *enc_ctx) {
+    // Processes failing together, or stopping on the shut down Fifos, post no other packet
+    svt_block_on_mutex(enc_ctx->pipeline_stopped.mutex);
+    const Bool stopped             = (Bool)enc_ctx->pipeline_stopped.obj;
+    enc_ctx->pipeline_stopped.obj = TRUE;
+    svt_release_mutex(enc_ctx->pipeline_stopped.mutex);
+    if (stopped)
+        return;
+
+    EbObjectWrapper *out_str_wrp;
+    if (svt_get_empty_object(enc_ctx->stream_output_fifo_ptr, &out_str_wrp) == EB_ErrorNone) {
+        EbBufferHeaderType *out_str = (EbBufferHeaderType *)out_str_wrp->object_ptr;
+
+        // The EOS flag lets svt_av1_enc_deinit() stop draining the packets
+        out_str->flags        = EB_BUFFERFLAG_EOS | EB_BUFFERFLAG_ERROR_MASK;
+        out_str->n_filled_len = 0;
+
+        svt_post_full_object(out_str_wrp);
+    }
+    // The processes, and the application waiting for an input buffer, are woken to stop
+    enc_ctx->app_callback_ptr->stop_handler(enc_ctx->app_callback_ptr->handle);
+}
@@ -28,6 +28,8 @@
 #include "encoder.h"
 #include "firstpass.h"
 #include "rc_process.h"
+#include "deadline_ctrl.h"
+#include "checkpoint.h"
 
 // *Note - the queues are small for testing purposes.  They should be increased when they are done.
 #define PRE_ASSIGNMENT_MAX_DEPTH 128 // should be large enough to hold an entire prediction period
@@ -50,6 +52,7 @@ typedef struct FirstPassStatsOut {
     FIRSTPASS_STATS *stat;
     size_t           size;
     size_t           capability;
+    size_t           ready; // number of frames written, from the first one without a gap
 } FirstPassStatsOut;
 
 typedef struct RateControlIntervalParamContext {
@@ -80,6 +83,9 @@ typedef struct EncodeContext {
     // Callback Functions
     EbCallback *app_callback_ptr;
 
+    // Caller allocator of the output packet buffers, unset for the internal one
+    SvtAv1OutputBufferAllocator out_buffer_allocator;
+
     EbHandle total_number_of_recon_frame_mutex;
     uint64_t total_number_of_recon_frames;
 #if OPT_LD_LATENCY2
@@ -89,6 +95,8 @@ typedef struct EncodeContext {
 
     // Overlay input picture fifo
     EbFifo *overlay_input_picture_pool_fifo_ptr;
+    // Set when a process stopped on an error, the others are woken to stop as well
+    AtomicVarU32 pipeline_stopped;
     // Output Buffer Fifos
     EbFifo *stream_output_fifo_ptr;
     EbFifo *recon_output_fifo_ptr;
@@ -163,6 +171,16 @@ typedef struct EncodeContext {
     EbHandle sc_buffer_mutex;
     EncMode  enc_mode;
 
+    // Wall-clock deadline mode
+    DeadlineCtrl deadline_ctrl;
+    // Key frame checkpoints and resume
+    CheckpointCtrl checkpoint_ctrl;
+
+    // 10-bit pictures whose 16-bit view (altref_buffer_highbd) is kept across the temporal filtering
+    // windows of picture decision, released at the end of the mini-GOP they belong to
+    struct PictureParentControlSet *tf_highbd_view_pcs[TF_HIGHBD_VIEW_MAX];
+    uint32_t                        tf_highbd_view_count;
+
     // Dynamic GOP
     uint32_t         previous_mini_gop_hierarchical_levels;
     uint64_t         mini_gop_cnt_per_gop;
@@ -186,6 +204,14 @@ typedef struct EncodeContext {
     STATS_BUFFER_CTX  stats_buf_context;
     SvtAv1FixedBuf    rc_stats_buffer; // replaced oxcf->two_pass_cfg.stats_in in aom
     FirstPassStatsOut stats_out;
+
+    // Pipelined two pass: the first pass encoder that runs ahead on the same input
+    struct EncodeContext *first_pass_enc_ctx;
+    EbHandle              first_pass_semaphore; // posted for each packet of the first pass
+    volatile Bool         first_pass_ended;
+    uint64_t              first_pass_stats_copied; // frames whose first pass size is in the stats buffer
+    uint64_t              first_pass_layer_bits[MAX_TEMPORAL_LAYERS];
+
     RecodeLoopType    recode_loop;
     // This feature controls the tolerence vs target used in deciding whether to
     // recode a frame. It has no meaning if recode is disabled.
@@ -214,4 +240,21 @@ typedef struct EncodeContextInitData {
  * Extern Function Declarations
  **************************************/
 extern EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_init_data_ptr);
+// Output packet buffers, taken from the caller allocator when one is set
+uint8_t *svt_aom_out_buffer_alloc(const SvtAv1OutputBufferAllocator *allocator, uint32_t size);
+void     svt_aom_out_buffer_free(const SvtAv1OutputBufferAllocator *allocator, uint8_t **buffer);
+// Ends the stream with an error packet, for a process that cannot continue, and wakes the other
+// processes so that they stop; only the first call has an effect
+void svt_aom_post_error_packet(EncodeContext *enc_ctx);
+Bool svt_aom_pipeline_stopped(EncodeContext *enc_ctx);
+
+// Gets an empty object, the kernel stops when none can be given: the pool failed to grow, or the
+// pipeline stopped on an error
+#define EB_GET_EMPTY_OBJECT(enc_ctx, empty_fifo_ptr, wrapper_dbl_ptr)                 \
+    do {                                                                              \
+        if (svt_get_empty_object(empty_fifo_ptr, wrapper_dbl_ptr) != EB_ErrorNone) { \
+            svt_aom_post_error_packet(enc_ctx);                                       \
+            return NULL;                                                              \
+        }                                                                             \
+    } while (0)
 #endif // EbEncodeContext_h
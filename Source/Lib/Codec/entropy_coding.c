@@ -2571,12 +2571,12 @@ static void write_tile_info(const PictureParentControlSet *const pcs,
                                  pcs->av1_cm->tiles_info.tile_rows * pcs->av1_cm->tiles_info.tile_cols - 1,
                                  pcs->av1_cm->log2_tile_cols + pcs->av1_cm->log2_tile_rows);
 
-        // Number of bytes in tile size - 1
+        // Number of bytes in tile size - 1, the largest when the header is sent ahead of the tiles
         uint32_t max_tile_size = 0;
         for (int tile_idx = 0; tile_idx < tile_cnt - 1; tile_idx++) {
             max_tile_size = AOMMAX(max_tile_size, pcs->child_pcs->ec_info[tile_idx]->ec->ec_writer.pos);
         }
-        if (max_tile_size >> 24 != 0)
+        if (pcs->scs->static_config.tile_group_output || max_tile_size >> 24 != 0)
             pcs->child_pcs->tile_size_bytes_minus_1 = 3;
         else if (max_tile_size >> 16 != 0)
             pcs->child_pcs->tile_size_bytes_minus_1 = 2;
@@ -3762,6 +3762,38 @@ EbErrorType svt_aom_write_metadata_av1(Bitstream *bitstream_ptr, SvtMetadataArra
     return return_error;
 }
 
+/* Copy the entropy coded tiles start_tile to end_tile after the headers, each but the last one
+ * preceded by its size */
+static int32_t write_tiles(OutputBitstreamUnit *output_bitstream_ptr, uint8_t **data_ptr, int32_t curr_data_size,
+                           PictureControlSet *pcs, int start_tile, int end_tile) {
+    uint8_t *data = *data_ptr;
+    for (int tile_idx = start_tile; tile_idx <= end_tile; tile_idx++) {
+        const int32_t tile_size       = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
+        uint8_t       tile_size_bytes = 0;
+        // tile_size += (tile_idx != tile_cnt - 1) ? 4 : 0;
+        if (tile_idx != end_tile) {
+            tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
+            mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
+        }
+        OutputBitstreamUnit *ec_output_bitstream_ptr =
+            (OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
+        assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
+        // Size of the buffer needed to store all data; if buffer is too small, increase buffer
+        // size
+        uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes + 10 /*MAX length_field_size*/ +
+            (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
+        if (output_bitstream_ptr->size < data_size) {
+            svt_realloc_output_bitstream_unit(output_bitstream_ptr,
+                                              data_size + 1); // plus one for good measure
+            data = output_bitstream_ptr->buffer_av1;
+        }
+        svt_memcpy(data + curr_data_size + tile_size_bytes, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
+        curr_data_size += (tile_size + tile_size_bytes);
+    }
+    *data_ptr = data;
+    return curr_data_size;
+}
+
 /**************************************************
 * EncodeFrameHeaderHeader
 **************************************************/
@@ -3778,47 +3810,27 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     int32_t curr_data_size = 0;
 
     const uint8_t obu_extension_header = 0;
+    // With tile group output, the tiles follow in separate tile group OBUs
+    const Bool header_only = show_existing || scs->static_config.tile_group_output;
 
     // A new tile group begins at this tile.  Write the obu header and
     // tile group header
-    const ObuType obu_type = show_existing ? OBU_FRAME_HEADER : OBU_FRAME;
+    const ObuType obu_type = header_only ? OBU_FRAME_HEADER : OBU_FRAME;
     curr_data_size         = write_obu_header(obu_type, obu_extension_header, data);
     obu_header_size        = curr_data_size;
 
     curr_data_size += write_frame_header_obu(
-        scs, ppcs, /*saved_wb,*/ data + curr_data_size, show_existing, show_existing);
+        scs, ppcs, /*saved_wb,*/ data + curr_data_size, show_existing, header_only);
 
-    const int n_log2_tiles                    = ppcs->av1_cm->log2_tile_rows + ppcs->av1_cm->log2_tile_cols;
-    const int tile_start_and_end_present_flag = 0;
+    if (!header_only) {
+        const int n_log2_tiles                    = ppcs->av1_cm->log2_tile_rows + ppcs->av1_cm->log2_tile_cols;
+        const int tile_start_and_end_present_flag = 0;
 
-    curr_data_size += write_tile_group_header(
-        data + curr_data_size, 0, 0, n_log2_tiles, tile_start_and_end_present_flag);
+        curr_data_size += write_tile_group_header(
+            data + curr_data_size, 0, 0, n_log2_tiles, tile_start_and_end_present_flag);
 
-    if (!show_existing) {
         // Add data from EC stream to Picture Stream.
-        for (int tile_idx = 0; tile_idx < tile_cnt; tile_idx++) {
-            const int32_t tile_size       = pcs->ec_info[tile_idx]->ec->ec_writer.pos;
-            uint8_t       tile_size_bytes = 0;
-            // tile_size += (tile_idx != tile_cnt - 1) ? 4 : 0;
-            if (tile_idx != tile_cnt - 1 && tile_cnt > 1) {
-                tile_size_bytes = pcs->tile_size_bytes_minus_1 + 1;
-                mem_put_varsize(data + curr_data_size, tile_size_bytes, tile_size - 1);
-            }
-            OutputBitstreamUnit *ec_output_bitstream_ptr =
-                (OutputBitstreamUnit *)pcs->ec_info[tile_idx]->ec->ec_output_bitstream_ptr;
-            assert(output_bitstream_ptr->buffer_av1 >= output_bitstream_ptr->buffer_begin_av1);
-            // Size of the buffer needed to store all data; if buffer is too small, increase buffer
-            // size
-            uint32_t data_size = (uint32_t)tile_size + curr_data_size + tile_size_bytes + 10 /*MAX length_field_size*/ +
-                (uint32_t)(output_bitstream_ptr->buffer_av1 - output_bitstream_ptr->buffer_begin_av1);
-            if (output_bitstream_ptr->size < data_size) {
-                svt_realloc_output_bitstream_unit(output_bitstream_ptr,
-                                                  data_size + 1); // plus one for good measure
-                data = output_bitstream_ptr->buffer_av1;
-            }
-            svt_memcpy(data + curr_data_size + tile_size_bytes, ec_output_bitstream_ptr->buffer_begin_av1, tile_size);
-            curr_data_size += (tile_size + tile_size_bytes);
-        }
+        curr_data_size = write_tiles(output_bitstream_ptr, &data, curr_data_size, pcs, 0, tile_cnt - 1);
     }
     const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
     const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
@@ -3832,6 +3844,32 @@ EbErrorType svt_aom_write_frame_header_av1(Bitstream *bitstream_ptr, SequenceCon
     return return_error;
 }
 
+/**************************************************
+* svt_aom_write_tile_group_av1
+**************************************************/
+EbErrorType svt_aom_write_tile_group_av1(Bitstream *bitstream_ptr, PictureControlSet *pcs, uint16_t start_tile,
+                                         uint16_t end_tile) {
+    OutputBitstreamUnit *output_bitstream_ptr = (OutputBitstreamUnit *)bitstream_ptr->output_bitstream_ptr;
+    Av1Common *const     cm                   = pcs->ppcs->av1_cm;
+    const int            n_log2_tiles         = cm->log2_tile_rows + cm->log2_tile_cols;
+    uint8_t             *data                 = output_bitstream_ptr->buffer_av1;
+
+    // The tile group header holds the range of its tiles
+    int32_t        curr_data_size  = write_obu_header(OBU_TILE_GROUP, 0, data);
+    const uint32_t obu_header_size = curr_data_size;
+    curr_data_size += write_tile_group_header(data + curr_data_size, start_tile, end_tile, n_log2_tiles, 1);
+    curr_data_size = write_tiles(output_bitstream_ptr, &data, curr_data_size, pcs, start_tile, end_tile);
+
+    const uint32_t obu_payload_size  = curr_data_size - obu_header_size;
+    const size_t   length_field_size = obu_mem_move(obu_header_size, obu_payload_size, data);
+    if (write_uleb_obu_size(obu_header_size, obu_payload_size, data) != AOM_CODEC_OK) {
+        assert(0);
+    }
+    curr_data_size += (int32_t)length_field_size;
+    output_bitstream_ptr->buffer_av1 = data + curr_data_size;
+    return EB_ErrorNone;
+}
+
 /**************************************************
 * svt_aom_encode_sps_av1
 **************************************************/
@@ -76,6 +76,8 @@ static EbErrorType realloc_stats_out(SequenceControlSet *scs, FirstPassStatsOut
         } else {
             EB_REALLOC_ARRAY(out->stat, capability);
         }
+        // frames not written yet keep a zero count
+        memset(out->stat + out->capability, 0, (capability - out->capability) * sizeof(*out->stat));
         out->capability = capability;
     }
     out->size = frame_number + 1;
@@ -90,6 +92,7 @@ static AOM_INLINE void output_stats(SequenceControlSet *scs, const FIRSTPASS_STA
         SVT_ERROR("realloc_stats_out request %d entries failed failed\n", frame_number);
     } else {
         stats_out->stat[frame_number] = *stats;
+        while (stats_out->ready < stats_out->size && stats_out->stat[stats_out->ready].count) stats_out->ready++;
     }
 
     // TEMP debug code
@@ -18,6 +18,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "grainSynthesis.h"
+#include "aom_dsp_rtcd.h"
 #include "svt_log.h"
 
 // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
@@ -526,7 +527,7 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
 
 // function that extracts samples from a lut (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
+static INLINE int32_t scale_lut(const int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
     int32_t x = index >> (bit_depth - 8);
 
     if (!(bit_depth - 8) || x == 255)
@@ -538,104 +539,186 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
              (bit_depth - 8));
 }
 
+void svt_av1_fgn_add_luma_noise_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                  int32_t width, int32_t height, const FgnScaling *scaling) {
+    const int32_t rounding_offset = (1 << (scaling->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] = clamp(
+                luma[i * luma_stride + j] +
+                    ((scale_lut(scaling->scaling_lut, luma[i * luma_stride + j], 8) * grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling->scaling_shift),
+                scaling->min_value,
+                scaling->max_value);
+        }
+    }
+}
+
+void svt_av1_fgn_add_luma_noise_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                      int32_t width, int32_t height, const FgnScaling *scaling) {
+    const int32_t rounding_offset = (1 << (scaling->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] = clamp(
+                luma[i * luma_stride + j] +
+                    ((scale_lut(scaling->scaling_lut, luma[i * luma_stride + j], scaling->bit_depth) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling->scaling_shift),
+                scaling->min_value,
+                scaling->max_value);
+        }
+    }
+}
+
+void svt_av1_fgn_add_chroma_noise_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma, int32_t luma_stride,
+                                    const int32_t *grain, int32_t grain_stride, int32_t width, int32_t height,
+                                    int32_t chroma_subsamp_x, int32_t chroma_subsamp_y, const FgnScaling *scaling) {
+    const int32_t rounding_offset = (1 << (scaling->scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(scaling->scaling_lut,
+                                clamp(((average_luma * scaling->luma_mult + scaling->mult * chroma[i * chroma_stride + j]) >>
+                                       6) +
+                                          scaling->offset,
+                                      0,
+                                      255),
+                                8) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling->scaling_shift),
+                scaling->min_value,
+                scaling->max_value);
+        }
+    }
+}
+
+void svt_av1_fgn_add_chroma_noise_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                        int32_t luma_stride, const int32_t *grain, int32_t grain_stride, int32_t width,
+                                        int32_t height, int32_t chroma_subsamp_x, int32_t chroma_subsamp_y,
+                                        const FgnScaling *scaling) {
+    const int32_t rounding_offset = (1 << (scaling->scaling_shift - 1));
+    const int32_t bit_depth       = scaling->bit_depth;
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(scaling->scaling_lut,
+                                clamp(((average_luma * scaling->luma_mult + scaling->mult * chroma[i * chroma_stride + j]) >>
+                                       6) +
+                                          scaling->offset,
+                                      0,
+                                      (256 << (bit_depth - 8)) - 1),
+                                bit_depth) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling->scaling_shift),
+                scaling->min_value,
+                scaling->max_value);
+        }
+    }
+}
+
 static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t luma_stride,
                                int32_t chroma_stride, int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
                                int32_t luma_grain_stride, int32_t chroma_grain_stride, int32_t half_luma_height,
                                int32_t half_luma_width, int32_t bit_depth, int32_t chroma_subsamp_y,
                                int32_t chroma_subsamp_x) {
-    int32_t cb_mult      = params->cb_mult - 128; // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
-    int32_t cb_offset    = params->cb_offset - 256;
-
-    int32_t cr_mult      = params->cr_mult - 128; // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
-    int32_t cr_offset    = params->cr_offset - 256;
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
+    FgnScaling cb_scaling = {scaling_lut_cb,
+                             params->scaling_shift,
+                             8,
+                             0,
+                             0,
+                             params->cb_luma_mult - 128, // fixed scale
+                             params->cb_mult - 128, // fixed scale
+                             params->cb_offset - 256};
+    FgnScaling cr_scaling = {scaling_lut_cr,
+                             params->scaling_shift,
+                             8,
+                             0,
+                             0,
+                             params->cr_luma_mult - 128, // fixed scale
+                             params->cr_mult - 128, // fixed scale
+                             params->cr_offset - 256};
+    FgnScaling y_scaling  = {scaling_lut_y, params->scaling_shift, 8, 0, 0, 0, 0, 0};
+    (void)bit_depth;
 
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = (params->num_cb_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
     int32_t apply_cr = (params->num_cr_points > 0 || params->chroma_scaling_from_luma) ? 1 : 0;
 
     if (params->chroma_scaling_from_luma) {
-        cb_mult      = 0; // fixed scale
-        cb_luma_mult = 64; // fixed scale
-        cb_offset    = 0;
+        cb_scaling.mult      = 0; // fixed scale
+        cb_scaling.luma_mult = 64; // fixed scale
+        cb_scaling.offset    = 0;
 
-        cr_mult      = 0; // fixed scale
-        cr_luma_mult = 64; // fixed scale
-        cr_offset    = 0;
+        cr_scaling.mult      = 0; // fixed scale
+        cr_scaling.luma_mult = 64; // fixed scale
+        cr_scaling.offset    = 0;
     }
 
-    int32_t min_luma, max_luma, min_chroma, max_chroma;
-
     if (params->clip_to_restricted_range) {
-        min_luma = min_luma_legal_range;
-        max_luma = max_luma_legal_range;
+        y_scaling.min_value = min_luma_legal_range;
+        y_scaling.max_value = max_luma_legal_range;
 
-        min_chroma = min_chroma_legal_range;
-        max_chroma = max_chroma_legal_range;
+        cb_scaling.min_value = cr_scaling.min_value = min_chroma_legal_range;
+        cb_scaling.max_value = cr_scaling.max_value = max_chroma_legal_range;
     } else {
-        min_luma = min_chroma = 0;
-        max_luma = max_chroma = 255;
-    }
-
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult + cb_mult * cb[i * chroma_stride + j]) >> 6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult + cr_mult * cr[i * chroma_stride + j]) >> 6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    8) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-        }
+        y_scaling.min_value = cb_scaling.min_value = cr_scaling.min_value = 0;
+        y_scaling.max_value = cb_scaling.max_value = cr_scaling.max_value = 255;
     }
 
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
-                                                      ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                                                            luma_grain[i * luma_grain_stride + j] +
-                                                        rounding_offset) >>
-                                                       params->scaling_shift),
-                                                  min_luma,
-                                                  max_luma);
-            }
-        }
-    }
+    // chroma first, its scaling uses the luma samples without grain
+    const int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    const int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+    if (apply_cb)
+        svt_av1_fgn_add_chroma_noise(cb,
+                                     chroma_stride,
+                                     luma,
+                                     luma_stride,
+                                     cb_grain,
+                                     chroma_grain_stride,
+                                     chroma_width,
+                                     chroma_height,
+                                     chroma_subsamp_x,
+                                     chroma_subsamp_y,
+                                     &cb_scaling);
+    if (apply_cr)
+        svt_av1_fgn_add_chroma_noise(cr,
+                                     chroma_stride,
+                                     luma,
+                                     luma_stride,
+                                     cr_grain,
+                                     chroma_grain_stride,
+                                     chroma_width,
+                                     chroma_height,
+                                     chroma_subsamp_x,
+                                     chroma_subsamp_y,
+                                     &cr_scaling);
+    if (apply_y)
+        svt_av1_fgn_add_luma_noise(
+            luma, luma_stride, luma_grain, luma_grain_stride, half_luma_width << 1, half_luma_height << 1, &y_scaling);
 }
 
 static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
@@ -643,100 +726,81 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
                                    int32_t *cr_grain, int32_t luma_grain_stride, int32_t chroma_grain_stride,
                                    int32_t half_luma_height, int32_t half_luma_width, int32_t bit_depth,
                                    int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
-    int32_t cb_mult      = params->cb_mult - 128; // fixed scale
-    int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
-    // offset value depends on the bit depth
-    int32_t cb_offset = (params->cb_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t cr_mult      = params->cr_mult - 128; // fixed scale
-    int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
-    // offset value depends on the bit depth
-    int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
-
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
+    FgnScaling cb_scaling = {scaling_lut_cb,
+                             params->scaling_shift,
+                             bit_depth,
+                             0,
+                             0,
+                             params->cb_luma_mult - 128, // fixed scale
+                             params->cb_mult - 128, // fixed scale
+                             // offset value depends on the bit depth
+                             (params->cb_offset << (bit_depth - 8)) - (1 << bit_depth)};
+    FgnScaling cr_scaling = {scaling_lut_cr,
+                             params->scaling_shift,
+                             bit_depth,
+                             0,
+                             0,
+                             params->cr_luma_mult - 128, // fixed scale
+                             params->cr_mult - 128, // fixed scale
+                             // offset value depends on the bit depth
+                             (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth)};
+    FgnScaling y_scaling  = {scaling_lut_y, params->scaling_shift, bit_depth, 0, 0, 0, 0, 0};
 
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
 
     if (params->chroma_scaling_from_luma) {
-        cb_mult      = 0; // fixed scale
-        cb_luma_mult = 64; // fixed scale
-        cb_offset    = 0;
+        cb_scaling.mult      = 0; // fixed scale
+        cb_scaling.luma_mult = 64; // fixed scale
+        cb_scaling.offset    = 0;
 
-        cr_mult      = 0; // fixed scale
-        cr_luma_mult = 64; // fixed scale
-        cr_offset    = 0;
+        cr_scaling.mult      = 0; // fixed scale
+        cr_scaling.luma_mult = 64; // fixed scale
+        cr_scaling.offset    = 0;
     }
 
-    int32_t min_luma, max_luma, min_chroma, max_chroma;
-
     if (params->clip_to_restricted_range) {
-        min_luma = min_luma_legal_range << (bit_depth - 8);
-        max_luma = max_luma_legal_range << (bit_depth - 8);
+        y_scaling.min_value = min_luma_legal_range << (bit_depth - 8);
+        y_scaling.max_value = max_luma_legal_range << (bit_depth - 8);
 
-        min_chroma = min_chroma_legal_range << (bit_depth - 8);
-        max_chroma = max_chroma_legal_range << (bit_depth - 8);
+        cb_scaling.min_value = cr_scaling.min_value = min_chroma_legal_range << (bit_depth - 8);
+        cb_scaling.max_value = cr_scaling.max_value = max_chroma_legal_range << (bit_depth - 8);
     } else {
-        min_luma = min_chroma = 0;
-        max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
+        y_scaling.min_value = cb_scaling.min_value = cr_scaling.min_value = 0;
+        y_scaling.max_value = cb_scaling.max_value = cr_scaling.max_value = (256 << (bit_depth - 8)) - 1;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                                luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] + 1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cb,
-                                    clamp(((average_luma * cb_luma_mult + cb_mult * cb[i * chroma_stride + j]) >> 6) +
-                                              cb_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cb_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                        ((scale_lut(scaling_lut_cr,
-                                    clamp(((average_luma * cr_luma_mult + cr_mult * cr[i * chroma_stride + j]) >> 6) +
-                                              cr_offset,
-                                          0,
-                                          (256 << (bit_depth - 8)) - 1),
-                                    bit_depth) *
-                              cr_grain[i * chroma_grain_stride + j] +
-                          rounding_offset) >>
-                         params->scaling_shift),
-                    min_chroma,
-                    max_chroma);
-            }
-        }
-    }
-
-    if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] = clamp(luma[i * luma_stride + j] +
-                                                      ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], bit_depth) *
-                                                            luma_grain[i * luma_grain_stride + j] +
-                                                        rounding_offset) >>
-                                                       params->scaling_shift),
-                                                  min_luma,
-                                                  max_luma);
-            }
-        }
-    }
+    // chroma first, its scaling uses the luma samples without grain
+    const int32_t chroma_height = half_luma_height << (1 - chroma_subsamp_y);
+    const int32_t chroma_width  = half_luma_width << (1 - chroma_subsamp_x);
+    if (apply_cb)
+        svt_av1_fgn_add_chroma_noise_hbd(cb,
+                                         chroma_stride,
+                                         luma,
+                                         luma_stride,
+                                         cb_grain,
+                                         chroma_grain_stride,
+                                         chroma_width,
+                                         chroma_height,
+                                         chroma_subsamp_x,
+                                         chroma_subsamp_y,
+                                         &cb_scaling);
+    if (apply_cr)
+        svt_av1_fgn_add_chroma_noise_hbd(cr,
+                                         chroma_stride,
+                                         luma,
+                                         luma_stride,
+                                         cr_grain,
+                                         chroma_grain_stride,
+                                         chroma_width,
+                                         chroma_height,
+                                         chroma_subsamp_x,
+                                         chroma_subsamp_y,
+                                         &cr_scaling);
+    if (apply_y)
+        svt_av1_fgn_add_luma_noise_hbd(
+            luma, luma_stride, luma_grain, luma_grain_stride, half_luma_width << 1, half_luma_height << 1, &y_scaling);
 }
 
 int32_t svt_aom_film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b) {
@@ -850,8 +914,9 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
     }
 }
 
-static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block, int32_t bottom_stride,
-                                 int32_t *dst_block, int32_t dst_stride, int32_t width, int32_t height) {
+void svt_av1_fgn_hor_boundary_overlap_c(const int32_t *top_block, int32_t top_stride, const int32_t *bottom_block,
+                                        int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width,
+                                        int32_t height, int32_t grain_min, int32_t grain_max) {
     if (height == 1) {
         while (width) {
             *dst_block = clamp((*top_block * 23 + *bottom_block * 22 + 16) >> 5, grain_min, grain_max);
@@ -875,6 +940,13 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t
     }
 }
 
+static INLINE void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block,
+                                        int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride, int32_t width,
+                                        int32_t height) {
+    svt_av1_fgn_hor_boundary_overlap(
+        top_block, top_stride, bottom_block, bottom_stride, dst_block, dst_stride, width, height, grain_min, grain_max);
+}
+
 void svt_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
                                 int32_t width, int32_t luma_stride, int32_t chroma_stride, int32_t use_high_bit_depth,
                                 int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
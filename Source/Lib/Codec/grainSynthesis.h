@@ -26,6 +26,21 @@ extern "C" {
 
 int32_t svt_aom_film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b);
 
+/* Constants used to add the grain to one plane. The grain of a sample is scaled by
+ * scaling_lut[] at the sample value, or for chroma at the value
+ * ((luma * luma_mult + chroma * mult) >> 6) + offset. The lut has 256 entries and
+ * is interpolated for bit depths above 8. */
+typedef struct FgnScaling {
+    const int32_t *scaling_lut;
+    int32_t        scaling_shift;
+    int32_t        bit_depth;
+    int32_t        min_value; // clipping range of the output
+    int32_t        max_value;
+    int32_t        luma_mult; // chroma only
+    int32_t        mult; // chroma only
+    int32_t        offset; // chroma only
+} FgnScaling;
+
 /*!\brief Add film grain
      *
      * Add film grain to an image
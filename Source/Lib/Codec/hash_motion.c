@@ -130,8 +130,9 @@ Iterator svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_
     return svt_aom_vector_begin(p_hash_table->p_lookup_table[hash_value]);
 }
 
-void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
-                                           int8_t *pic_block_same_info[3], PictureControlSet *pcs) {
+static void generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
+                                          int8_t *pic_block_same_info[3], CRC_CALCULATOR *crc_calculator1,
+                                          CRC_CALCULATOR *crc_calculator2) {
     const int width  = 2;
     const int height = 2;
     const int x_end  = picture->y_crop_width - width + 1;
@@ -149,9 +150,9 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
                 pic_block_same_info[1][pos] = is_block16_2x2_col_same_value(p);
 
                 pic_block_hash[0][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator1, (uint8_t *)p, length * sizeof(p[0]));
+                    crc_calculator1, (uint8_t *)p, length * sizeof(p[0]));
                 pic_block_hash[1][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
+                    crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
                 pos++;
             }
             pos += width - 1;
@@ -166,8 +167,8 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
                 pic_block_same_info[0][pos] = is_block_2x2_row_same_value(p);
                 pic_block_same_info[1][pos] = is_block_2x2_col_same_value(p);
 
-                pic_block_hash[0][pos] = svt_av1_get_crc_value(&pcs->crc_calculator1, p, length * sizeof(p[0]));
-                pic_block_hash[1][pos] = svt_av1_get_crc_value(&pcs->crc_calculator2, p, length * sizeof(p[0]));
+                pic_block_hash[0][pos] = svt_av1_get_crc_value(crc_calculator1, p, length * sizeof(p[0]));
+                pic_block_hash[1][pos] = svt_av1_get_crc_value(crc_calculator2, p, length * sizeof(p[0]));
                 pos++;
             }
             pos += width - 1;
@@ -175,9 +176,10 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
     }
 }
 
-void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size, uint32_t *src_pic_block_hash[2],
-                                       uint32_t *dst_pic_block_hash[2], int8_t *src_pic_block_same_info[3],
-                                       int8_t *dst_pic_block_same_info[3], PictureControlSet *pcs) {
+static void generate_block_hash_value(const Yv12BufferConfig *picture, int block_size, uint32_t *src_pic_block_hash[2],
+                                     uint32_t *dst_pic_block_hash[2], int8_t *src_pic_block_same_info[3],
+                                     int8_t *dst_pic_block_same_info[3], CRC_CALCULATOR *crc_calculator1,
+                                     CRC_CALCULATOR *crc_calculator2) {
     const int pic_width = picture->y_crop_width;
     const int x_end     = picture->y_crop_width - block_size + 1;
     const int y_end     = picture->y_crop_height - block_size + 1;
@@ -195,13 +197,13 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
             p[1]                       = src_pic_block_hash[0][pos + src_size];
             p[2]                       = src_pic_block_hash[0][pos + src_size * pic_width];
             p[3]                       = src_pic_block_hash[0][pos + src_size * pic_width + src_size];
-            dst_pic_block_hash[0][pos] = svt_av1_get_crc_value(&pcs->crc_calculator1, (uint8_t *)p, length);
+            dst_pic_block_hash[0][pos] = svt_av1_get_crc_value(crc_calculator1, (uint8_t *)p, length);
 
             p[0]                       = src_pic_block_hash[1][pos];
             p[1]                       = src_pic_block_hash[1][pos + src_size];
             p[2]                       = src_pic_block_hash[1][pos + src_size * pic_width];
             p[3]                       = src_pic_block_hash[1][pos + src_size * pic_width + src_size];
-            dst_pic_block_hash[1][pos] = svt_av1_get_crc_value(&pcs->crc_calculator2, (uint8_t *)p, length);
+            dst_pic_block_hash[1][pos] = svt_av1_get_crc_value(crc_calculator2, (uint8_t *)p, length);
 
             dst_pic_block_same_info[0][pos] = src_pic_block_same_info[0][pos] &&
                 src_pic_block_same_info[0][pos + quad_size] && src_pic_block_same_info[0][pos + src_size] &&
@@ -234,6 +236,25 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
     }
 }
 
+void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
+                                           int8_t *pic_block_same_info[3], PictureControlSet *pcs) {
+    generate_block_2x2_hash_value(
+        picture, pic_block_hash, pic_block_same_info, &pcs->crc_calculator1, &pcs->crc_calculator2);
+}
+
+void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size, uint32_t *src_pic_block_hash[2],
+                                       uint32_t *dst_pic_block_hash[2], int8_t *src_pic_block_same_info[3],
+                                       int8_t *dst_pic_block_same_info[3], PictureControlSet *pcs) {
+    generate_block_hash_value(picture,
+                              block_size,
+                              src_pic_block_hash,
+                              dst_pic_block_hash,
+                              src_pic_block_same_info,
+                              dst_pic_block_same_info,
+                              &pcs->crc_calculator1,
+                              &pcs->crc_calculator2);
+}
+
 void svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, uint32_t *pic_hash[2],
                                                                          int8_t *pic_is_same, int pic_width,
                                                                          int pic_height, int block_size) {
@@ -349,3 +370,393 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
     *hash_value1 = (x->hash_value_buffer[0][dst_idx][0] & crc_mask) + add_value;
     *hash_value2 = x->hash_value_buffer[1][dst_idx][0];
 }
+
+/*
+ * Incremental hash index
+ *
+ * Positions are rehashed per tile of at least the largest hashed block size, so that a tile origin is
+ * aligned for every block size and the blocks starting in a tile only cover that tile and its right and
+ * bottom neighbours.
+ */
+#define HASH_INDEX_MIN_TILE_SIZE 64
+// Rebuild the whole table when more tiles than this percentage need to be rehashed
+#define HASH_INDEX_MAX_REFRESH_PERCENT 50
+#define HASH_INDEX_CRC1_POLY 0x5D6DCB
+#define HASH_INDEX_CRC2_POLY 0x864CFB
+
+typedef struct HashIndexEntry {
+    uint32_t  hash_value1; // table address
+    BlockHash block;
+} HashIndexEntry;
+
+typedef struct HashIndexEntryList {
+    HashIndexEntry *entries;
+    uint32_t        count;
+    uint32_t        capacity;
+} HashIndexEntryList;
+
+typedef struct HashIndexScratch {
+    uint32_t *block_hash_values[2][2];
+    int8_t   *is_block_same[2][3];
+} HashIndexScratch;
+
+static void hash_index_scratch_free(HashIndexScratch *scratch) {
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 2; j++) free(scratch->block_hash_values[k][j]);
+        for (int j = 0; j < 3; j++) free(scratch->is_block_same[k][j]);
+    }
+}
+
+static EbErrorType hash_index_scratch_alloc(HashIndexScratch *scratch, size_t size) {
+    memset(scratch, 0, sizeof(*scratch));
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 2; j++) {
+            scratch->block_hash_values[k][j] = (uint32_t *)malloc(sizeof(uint32_t) * size);
+            if (!scratch->block_hash_values[k][j])
+                return EB_ErrorInsufficientResources;
+        }
+        for (int j = 0; j < 3; j++) {
+            scratch->is_block_same[k][j] = (int8_t *)malloc(sizeof(int8_t) * size);
+            if (!scratch->is_block_same[k][j])
+                return EB_ErrorInsufficientResources;
+        }
+    }
+    return EB_ErrorNone;
+}
+
+static EbErrorType hash_index_entry_push(HashIndexEntryList *list, uint32_t hash_value1, int x, int y,
+                                         uint32_t hash_value2) {
+    if (list->count == list->capacity) {
+        const uint32_t  capacity = list->capacity ? list->capacity * 2 : 1024;
+        HashIndexEntry *entries  = (HashIndexEntry *)realloc(list->entries, sizeof(*entries) * capacity);
+        if (!entries)
+            return EB_ErrorInsufficientResources;
+        list->entries  = entries;
+        list->capacity = capacity;
+    }
+    HashIndexEntry *entry    = &list->entries[list->count++];
+    entry->hash_value1       = hash_value1;
+    entry->block.x           = (int16_t)x;
+    entry->block.y           = (int16_t)y;
+    entry->block.hash_value2 = hash_value2;
+    return EB_ErrorNone;
+}
+
+// Blocks are added column by column, so that is the order of the blocks in a table entry
+static INLINE int block_hash_is_before(const BlockHash *a, const BlockHash *b) {
+    return a->x < b->x || (a->x == b->x && a->y < b->y);
+}
+
+static int hash_index_entry_cmp(const void *a, const void *b) {
+    const HashIndexEntry *entry_a = (const HashIndexEntry *)a;
+    const HashIndexEntry *entry_b = (const HashIndexEntry *)b;
+    if (entry_a->hash_value1 != entry_b->hash_value1)
+        return entry_a->hash_value1 < entry_b->hash_value1 ? -1 : 1;
+    if (block_hash_is_before(&entry_a->block, &entry_b->block))
+        return -1;
+    return block_hash_is_before(&entry_b->block, &entry_a->block);
+}
+
+/*
+ * Hash the blocks starting in the area [x0, x1) x [y0, y1) of a luma plane and list the ones that would
+ * be added to the table. The hashes are generated over the area extended by the largest block size, with
+ * the area origin aligned for every block size, so they match the ones of the whole plane.
+ */
+static EbErrorType hash_index_list_area(HashIndex *index, const uint8_t *luma, int stride, int x0, int y0, int x1,
+                                        int y1, HashIndexScratch *scratch, HashIndexEntryList *list) {
+    const int        area_width  = AOMMIN(x1 + index->max_block_size - 1, index->width) - x0;
+    const int        area_height = AOMMIN(y1 + index->max_block_size - 1, index->height) - y0;
+    Yv12BufferConfig area;
+    memset(&area, 0, sizeof(area));
+    area.y_buffer      = (uint8_t *)luma + y0 * stride + x0;
+    area.y_stride      = stride;
+    area.y_crop_width  = area_width;
+    area.y_crop_height = area_height;
+
+    const int crc_mask = (1 << crc_bits) - 1;
+    generate_block_2x2_hash_value(&area,
+                                  scratch->block_hash_values[0],
+                                  scratch->is_block_same[0],
+                                  &index->crc_calculator1,
+                                  &index->crc_calculator2);
+    uint8_t src_idx = 0;
+    for (int size = 4; size <= index->max_block_size; size <<= 1, src_idx = !src_idx) {
+        const uint8_t dst_idx = !src_idx;
+        generate_block_hash_value(&area,
+                                  size,
+                                  scratch->block_hash_values[src_idx],
+                                  scratch->block_hash_values[dst_idx],
+                                  scratch->is_block_same[src_idx],
+                                  scratch->is_block_same[dst_idx],
+                                  &index->crc_calculator1,
+                                  &index->crc_calculator2);
+        if (size == 4 && !index->hash_4x4)
+            continue;
+        const uint32_t  add_value = (uint32_t)hash_block_size_to_index(size) << crc_bits;
+        const uint32_t *hash[2]   = {scratch->block_hash_values[dst_idx][0], scratch->block_hash_values[dst_idx][1]};
+        const int8_t   *is_added  = scratch->is_block_same[dst_idx][2];
+        const int       x_end     = AOMMIN(x1, index->width - size + 1);
+        const int       y_end     = AOMMIN(y1, index->height - size + 1);
+        for (int x_pos = x0; x_pos < x_end; x_pos++) {
+            for (int y_pos = y0; y_pos < y_end; y_pos++) {
+                const int pos = (y_pos - y0) * area_width + x_pos - x0;
+                if (!is_added[pos])
+                    continue;
+                EbErrorType err = hash_index_entry_push(
+                    list, (hash[0][pos] & crc_mask) + add_value, x_pos, y_pos, hash[1][pos]);
+                if (err != EB_ErrorNone)
+                    return err;
+            }
+        }
+    }
+    return EB_ErrorNone;
+}
+
+// Remove the blocks of a table entry listed in remove[] and merge in the ones of add[], keeping the order
+static void hash_index_update_table_entry(HashTable *p_hash_table, uint32_t hash_value1, const HashIndexEntry *remove,
+                                          uint32_t num_remove, const HashIndexEntry *add, uint32_t num_add) {
+    Vector  *entry = p_hash_table->p_lookup_table[hash_value1];
+    uint32_t kept  = 0;
+    if (entry) {
+        BlockHash *blocks = (BlockHash *)entry->data;
+        uint32_t   r      = 0;
+        for (uint32_t i = 0; i < entry->size; i++) {
+            while (r < num_remove && block_hash_is_before(&remove[r].block, &blocks[i])) r++;
+            if (r < num_remove && remove[r].block.x == blocks[i].x && remove[r].block.y == blocks[i].y) {
+                r++;
+                continue;
+            }
+            blocks[kept++] = blocks[i];
+        }
+        entry->size = kept;
+    }
+    if (!num_add)
+        return;
+    // grow the entry, then merge from the back
+    for (uint32_t j = 0; j < num_add; j++) hash_table_add_to_table(p_hash_table, hash_value1, (BlockHash *)&add[j].block);
+    BlockHash *blocks = (BlockHash *)p_hash_table->p_lookup_table[hash_value1]->data;
+    int32_t    i      = (int32_t)kept - 1;
+    int32_t    j      = (int32_t)num_add - 1;
+    int32_t    k      = (int32_t)(kept + num_add) - 1;
+    while (j >= 0) {
+        if (i >= 0 && block_hash_is_before(&add[j].block, &blocks[i]))
+            blocks[k--] = blocks[i--];
+        else
+            blocks[k--] = add[j--].block;
+    }
+}
+
+static EbErrorType hash_index_rebuild(HashIndex *index, const Yv12BufferConfig *picture) {
+    EbErrorType err = svt_aom_rtime_alloc_svt_av1_hash_table_create(&index->table);
+    if (err != EB_ErrorNone)
+        return err;
+    HashIndexScratch scratch;
+    err = hash_index_scratch_alloc(&scratch, (size_t)index->width * index->height);
+    if (err == EB_ErrorNone) {
+        generate_block_2x2_hash_value(picture,
+                                      scratch.block_hash_values[0],
+                                      scratch.is_block_same[0],
+                                      &index->crc_calculator1,
+                                      &index->crc_calculator2);
+        uint8_t src_idx = 0;
+        for (int size = 4; size <= index->max_block_size; size <<= 1, src_idx = !src_idx) {
+            const uint8_t dst_idx = !src_idx;
+            generate_block_hash_value(picture,
+                                      size,
+                                      scratch.block_hash_values[src_idx],
+                                      scratch.block_hash_values[dst_idx],
+                                      scratch.is_block_same[src_idx],
+                                      scratch.is_block_same[dst_idx],
+                                      &index->crc_calculator1,
+                                      &index->crc_calculator2);
+            if (size != 4 || index->hash_4x4)
+                svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(&index->table,
+                                                                                    scratch.block_hash_values[dst_idx],
+                                                                                    scratch.is_block_same[dst_idx][2],
+                                                                                    index->width,
+                                                                                    index->height,
+                                                                                    size);
+        }
+    }
+    hash_index_scratch_free(&scratch);
+    return err;
+}
+
+static EbErrorType hash_index_refresh_tiles(HashIndex *index, const Yv12BufferConfig *picture, const uint8_t *refresh,
+                                            int tile_size, int tile_cols, int tile_rows) {
+    HashIndexEntryList old_list, new_list;
+    HashIndexScratch   scratch;
+    memset(&old_list, 0, sizeof(old_list));
+    memset(&new_list, 0, sizeof(new_list));
+    EbErrorType err = hash_index_scratch_alloc(
+        &scratch, (size_t)index->width * AOMMIN(index->height, tile_size + index->max_block_size - 1));
+
+    // list the blocks of the previous and of the new picture starting in runs of tiles to refresh
+    for (int tile_row = 0; tile_row < tile_rows && err == EB_ErrorNone; tile_row++) {
+        for (int tile_col = 0; tile_col < tile_cols && err == EB_ErrorNone;) {
+            if (!refresh[tile_row * tile_cols + tile_col]) {
+                tile_col++;
+                continue;
+            }
+            const int run_start = tile_col;
+            while (tile_col < tile_cols && refresh[tile_row * tile_cols + tile_col]) tile_col++;
+            const int x0 = run_start * tile_size;
+            const int x1 = AOMMIN(tile_col * tile_size, index->width);
+            const int y0 = tile_row * tile_size;
+            const int y1 = AOMMIN(y0 + tile_size, index->height);
+            err          = hash_index_list_area(index, index->luma, index->width, x0, y0, x1, y1, &scratch, &old_list);
+            if (err == EB_ErrorNone)
+                err = hash_index_list_area(
+                    index, picture->y_buffer, picture->y_stride, x0, y0, x1, y1, &scratch, &new_list);
+        }
+    }
+    hash_index_scratch_free(&scratch);
+
+    if (err == EB_ErrorNone) {
+        qsort(old_list.entries, old_list.count, sizeof(HashIndexEntry), hash_index_entry_cmp);
+        qsort(new_list.entries, new_list.count, sizeof(HashIndexEntry), hash_index_entry_cmp);
+        uint32_t i = 0, j = 0;
+        while (i < old_list.count || j < new_list.count) {
+            const uint32_t hash_value1 = (j == new_list.count ||
+                                          (i < old_list.count &&
+                                           old_list.entries[i].hash_value1 < new_list.entries[j].hash_value1))
+                ? old_list.entries[i].hash_value1
+                : new_list.entries[j].hash_value1;
+            const uint32_t old_start = i, new_start = j;
+            while (i < old_list.count && old_list.entries[i].hash_value1 == hash_value1) i++;
+            while (j < new_list.count && new_list.entries[j].hash_value1 == hash_value1) j++;
+            // unchanged blocks of a refreshed tile
+            if (i - old_start == j - new_start &&
+                !memcmp(&old_list.entries[old_start], &new_list.entries[new_start], sizeof(HashIndexEntry) * (i - old_start)))
+                continue;
+            hash_index_update_table_entry(&index->table,
+                                          hash_value1,
+                                          &old_list.entries[old_start],
+                                          i - old_start,
+                                          &new_list.entries[new_start],
+                                          j - new_start);
+        }
+    }
+    free(old_list.entries);
+    free(new_list.entries);
+    return err;
+}
+
+void svt_av1_hash_index_destroy(HashIndex *index) {
+    svt_av1_hash_table_destroy(&index->table);
+    EB_FREE_ARRAY(index->luma);
+    index->width  = 0;
+    index->height = 0;
+}
+
+EbErrorType svt_av1_hash_index_update(HashIndex *index, const Yv12BufferConfig *picture, int max_block_size,
+                                      uint8_t hash_4x4) {
+    assert(!(picture->flags & YV12_FLAG_HIGHBITDEPTH));
+    EbErrorType err         = EB_ErrorNone;
+    const int   width       = picture->y_crop_width;
+    const int   height      = picture->y_crop_height;
+    Bool        full_update = index->luma == NULL || index->table.p_lookup_table == NULL || index->width != width ||
+        index->height != height || index->max_block_size != max_block_size || index->hash_4x4 != hash_4x4;
+
+    if (full_update) {
+        svt_av1_hash_index_destroy(index);
+        EB_MALLOC_ARRAY(index->luma, (size_t)width * height);
+        index->width          = width;
+        index->height         = height;
+        index->max_block_size = max_block_size;
+        index->hash_4x4       = hash_4x4;
+        svt_av1_crc_calculator_init(&index->crc_calculator1, 24, HASH_INDEX_CRC1_POLY);
+        svt_av1_crc_calculator_init(&index->crc_calculator2, 24, HASH_INDEX_CRC2_POLY);
+    } else {
+        // find the tiles whose samples changed since the last update, and the ones holding blocks
+        // that overlap them
+        const int tile_size = AOMMAX(HASH_INDEX_MIN_TILE_SIZE, max_block_size);
+        const int tile_cols = (width + tile_size - 1) / tile_size;
+        const int tile_rows = (height + tile_size - 1) / tile_size;
+        uint8_t  *changed, *refresh;
+        EB_MALLOC_ARRAY(changed, tile_cols * tile_rows);
+        EB_MALLOC_ARRAY(refresh, tile_cols * tile_rows);
+        for (int tile_row = 0; tile_row < tile_rows; tile_row++) {
+            const int y0 = tile_row * tile_size;
+            const int h  = AOMMIN(tile_size, height - y0);
+            for (int tile_col = 0; tile_col < tile_cols; tile_col++) {
+                const int x0   = tile_col * tile_size;
+                const int w    = AOMMIN(tile_size, width - x0);
+                uint8_t   diff = 0;
+                for (int y = y0; y < y0 + h && !diff; y++)
+                    diff = memcmp(index->luma + y * width + x0, picture->y_buffer + y * picture->y_stride + x0, w) !=
+                        0;
+                changed[tile_row * tile_cols + tile_col] = diff;
+            }
+        }
+        int num_refresh = 0;
+        for (int tile_row = 0; tile_row < tile_rows; tile_row++) {
+            for (int tile_col = 0; tile_col < tile_cols; tile_col++) {
+                uint8_t refresh_tile = 0;
+                for (int r = tile_row; r <= AOMMIN(tile_row + 1, tile_rows - 1); r++)
+                    for (int c = tile_col; c <= AOMMIN(tile_col + 1, tile_cols - 1); c++)
+                        refresh_tile |= changed[r * tile_cols + c];
+                refresh[tile_row * tile_cols + tile_col] = refresh_tile;
+                num_refresh += refresh_tile;
+            }
+        }
+        if (num_refresh * 100 > tile_cols * tile_rows * HASH_INDEX_MAX_REFRESH_PERCENT)
+            full_update = TRUE;
+        else if (num_refresh)
+            err = hash_index_refresh_tiles(index, picture, refresh, tile_size, tile_cols, tile_rows);
+        EB_FREE_ARRAY(changed);
+        EB_FREE_ARRAY(refresh);
+    }
+    if (full_update && err == EB_ErrorNone)
+        err = hash_index_rebuild(index, picture);
+    if (err != EB_ErrorNone) {
+        svt_av1_hash_index_destroy(index);
+        return err;
+    }
+    for (int y = 0; y < height; y++)
+        svt_memcpy(index->luma + y * width, picture->y_buffer + y * picture->y_stride, width);
+    return EB_ErrorNone;
+}
+
+void svt_av1_get_b64_block_hashes(const uint8_t *src, int stride, CRC_CALCULATOR *crc_calculator1,
+                                  CRC_CALCULATOR *crc_calculator2, B64BlockHashes *hashes) {
+    // raw crcs of the current and of the previous level, in raster order
+    uint32_t  crc[2][2][(BLOCK_SIZE_64 / 2) * (BLOCK_SIZE_64 / 2)];
+    const int crc_mask = (1 << crc_bits) - 1;
+    const int b64_size = BLOCK_SIZE_64;
+    uint8_t   src_idx  = 0;
+
+    for (int y_pos = 0; y_pos < b64_size; y_pos += 2) {
+        for (int x_pos = 0; x_pos < b64_size; x_pos += 2) {
+            const int pos = (y_pos >> 1) * (b64_size >> 1) + (x_pos >> 1);
+            uint8_t   p[4];
+            get_pixels_in_1d_char_array_by_block_2x2((uint8_t *)src + y_pos * stride + x_pos, stride, p);
+            crc[src_idx][0][pos] = svt_av1_get_crc_value(crc_calculator1, p, sizeof(p));
+            crc[src_idx][1][pos] = svt_av1_get_crc_value(crc_calculator2, p, sizeof(p));
+        }
+    }
+    int src_width = b64_size >> 1;
+    for (int size = 4, level = 0; size <= b64_size; size <<= 1, level++, src_idx = !src_idx) {
+        const uint8_t  dst_idx   = !src_idx;
+        const int      dst_width = src_width >> 1;
+        const uint32_t add_value = (uint32_t)hash_block_size_to_index(size) << crc_bits;
+        for (int y_pos = 0; y_pos < dst_width; y_pos++) {
+            for (int x_pos = 0; x_pos < dst_width; x_pos++) {
+                const int src_pos = (y_pos << 1) * src_width + (x_pos << 1);
+                const int dst_pos = y_pos * dst_width + x_pos;
+                for (int k = 0; k < 2; k++) {
+                    uint32_t to_hash[4];
+                    to_hash[0]              = crc[src_idx][k][src_pos];
+                    to_hash[1]              = crc[src_idx][k][src_pos + 1];
+                    to_hash[2]              = crc[src_idx][k][src_pos + src_width];
+                    to_hash[3]              = crc[src_idx][k][src_pos + src_width + 1];
+                    crc[dst_idx][k][dst_pos] = svt_av1_get_crc_value(
+                        k ? crc_calculator2 : crc_calculator1, (uint8_t *)to_hash, sizeof(to_hash));
+                }
+                hashes->hash_value1[level][dst_pos] = (crc[dst_idx][0][dst_pos] & crc_mask) + add_value;
+                hashes->hash_value2[level][dst_pos] = crc[dst_idx][1][dst_pos];
+            }
+        }
+        src_width = dst_width;
+    }
+}
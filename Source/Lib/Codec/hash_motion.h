@@ -13,6 +13,7 @@
 #define AOM_AV1_ENCODER_HASH_MOTION_H_
 
 #include "definitions.h"
+#include "hash.h"
 #include "coding_unit.h"
 #include "vector.h"
 #include "pic_buffer_desc.h"
@@ -47,6 +48,35 @@ void svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTab
                                                                          int8_t *pic_is_same, int pic_width,
                                                                          int pic_height, int block_size);
 
+/*
+ * Block hash index of a luma plane, kept from one picture to the next: an update only rehashes the tiles
+ * that changed since the previous one, and leaves the table as a full rebuild would.
+ */
+typedef struct HashIndex {
+    HashTable      table;
+    CRC_CALCULATOR crc_calculator1;
+    CRC_CALCULATOR crc_calculator2;
+    // copy of the luma samples the table was built from
+    uint8_t *luma;
+    int32_t  width;
+    int32_t  height;
+    // blocks from 8x8 (4x4 when hash_4x4 is set) to max_block_size x max_block_size are indexed
+    int32_t max_block_size;
+    uint8_t hash_4x4;
+} HashIndex;
+void        svt_av1_hash_index_destroy(HashIndex *index);
+EbErrorType svt_av1_hash_index_update(HashIndex *index, const Yv12BufferConfig *picture, int max_block_size,
+                                      uint8_t hash_4x4);
+
+// table addresses and second hash values of the aligned 4x4 to 64x64 blocks of a 64x64 block, in raster order
+#define HASH_B64_LEVELS 5
+typedef struct B64BlockHashes {
+    uint32_t hash_value1[HASH_B64_LEVELS][(BLOCK_SIZE_64 / 4) * (BLOCK_SIZE_64 / 4)];
+    uint32_t hash_value2[HASH_B64_LEVELS][(BLOCK_SIZE_64 / 4) * (BLOCK_SIZE_64 / 4)];
+} B64BlockHashes;
+void svt_av1_get_b64_block_hashes(const uint8_t *src, int stride, CRC_CALCULATOR *crc_calculator1,
+                                  CRC_CALCULATOR *crc_calculator2, B64BlockHashes *hashes);
+
 // check whether the block starts from (x_start, y_start) with the size of
 // BlockSize x BlockSize has the same color in all rows
 
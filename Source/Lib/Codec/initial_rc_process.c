@@ -142,15 +142,20 @@ static void push_to_lad_queue(PictureParentControlSet *pcs, InitialRateControlCo
 }
 
 /* send picture out from irc process */
-static void irc_send_picture_out(InitialRateControlContext *ctx, PictureParentControlSet *pcs, Bool superres_recode) {
+static EbErrorType irc_send_picture_out(InitialRateControlContext *ctx, PictureParentControlSet *pcs,
+                                        Bool superres_recode) {
     EbObjectWrapper *out_results_wrapper;
     // Get Empty Results Object
-    svt_get_empty_object(ctx->initialrate_control_results_output_fifo_ptr, &out_results_wrapper);
+    EbErrorType return_error = svt_get_empty_object(ctx->initialrate_control_results_output_fifo_ptr,
+                                                    &out_results_wrapper);
+    if (return_error != EB_ErrorNone)
+        return return_error;
     InitialRateControlResults *out_results = (InitialRateControlResults *)out_results_wrapper->object_ptr;
     // SVT_LOG("iRC Out:%lld\n",pcs->picture_number);
     out_results->pcs_wrapper     = pcs->p_pcs_wrapper_ptr;
     out_results->superres_recode = superres_recode;
     svt_post_full_object(out_results_wrapper);
+    return EB_ErrorNone;
 }
 static uint8_t is_frame_already_exists(PictureParentControlSet *pcs, uint32_t end_index, uint64_t pic_num) {
     for (uint32_t i = 0; i < end_index; i++)
@@ -495,12 +500,50 @@ void store_extended_group(PictureParentControlSet *pcs, InitialRateControlContex
 #endif
 }
 
+/*
+ Pipelined two pass: wait for the first pass encoder to code the pictures before end, then take its frame
+ sizes in place of the motion estimation estimates of the look-ahead rate control. The input pools keep room
+ for the future pictures the first pass needs past the look-ahead window.
+*/
+static void get_first_pass_stats(SequenceControlSet *scs, uint64_t end) {
+    EncodeContext *enc_ctx    = scs->enc_ctx;
+    EncodeContext *fp_enc_ctx = enc_ctx->first_pass_enc_ctx;
+    if (enc_ctx->first_pass_stats_copied >= end)
+        return;
+    while (TRUE) {
+        svt_block_on_mutex(fp_enc_ctx->stat_file_mutex);
+        const Bool ready = fp_enc_ctx->stats_out.ready >= end;
+        svt_release_mutex(fp_enc_ctx->stat_file_mutex);
+        if (ready || enc_ctx->first_pass_ended || svt_aom_pipeline_stopped(enc_ctx))
+            break;
+        svt_block_on_semaphore(enc_ctx->first_pass_semaphore);
+    }
+    svt_block_on_mutex(fp_enc_ctx->stat_file_mutex);
+    svt_block_on_mutex(scs->twopass.stats_buf_ctx->stats_in_write_mutex);
+    const uint64_t ready = MIN(end, (uint64_t)fp_enc_ctx->stats_out.ready);
+    for (uint64_t i = enc_ctx->first_pass_stats_copied; i < ready; i++) {
+        const StatStruct *src   = &fp_enc_ctx->stats_out.stat[i].stat_struct;
+        StatStruct       *dst   = &(scs->twopass.stats_buf_ctx->stats_in_start + i)->stat_struct;
+        const uint8_t     layer = MIN(src->temporal_layer_index, MAX_TEMPORAL_LAYERS - 1);
+        // The pictures the first pass did not code take the size of the previous picture of their layer
+        if (src->total_num_bits)
+            enc_ctx->first_pass_layer_bits[layer] = src->total_num_bits;
+        dst->total_num_bits       = MAX(enc_ctx->first_pass_layer_bits[layer], 1);
+        dst->qindex               = src->qindex;
+        dst->worst_qindex         = src->worst_qindex;
+        dst->temporal_layer_index = src->temporal_layer_index;
+    }
+    enc_ctx->first_pass_stats_copied = MAX(enc_ctx->first_pass_stats_copied, ready);
+    svt_release_mutex(scs->twopass.stats_buf_ctx->stats_in_write_mutex);
+    svt_release_mutex(fp_enc_ctx->stat_file_mutex);
+}
+
 /*
  scan the queue and determine if pictures can go outside
  pictures are stored in dec order.
  only base pictures are hold. the rest including LDP ones are pass-thru
 */
-static void process_lad_queue(InitialRateControlContext *ctx, uint8_t pass_thru) {
+static EbErrorType process_lad_queue(InitialRateControlContext *ctx, uint8_t pass_thru) {
     LadQueue      *queue      = ctx->lad_queue;
     LadQueueEntry *head_entry = queue->cir_buf[queue->head];
 
@@ -577,6 +620,10 @@ static void process_lad_queue(InitialRateControlContext *ctx, uint8_t pass_thru)
                     : (uint64_t)(head_pcs->scs->twopass.stats_buf_ctx->stats_in_end_write -
                                  head_pcs->scs->twopass.stats_buf_ctx->stats_in_start);
                 svt_release_mutex(head_pcs->scs->twopass.stats_buf_ctx->stats_in_write_mutex);
+                if (head_pcs->scs->static_config.pipelined_two_pass)
+                    get_first_pass_stats(head_pcs->scs,
+                                         head_pcs->ext_group_size ? head_pcs->stats_in_end_offset
+                                                                  : head_pcs->stats_in_offset + 1);
                 head_pcs->frames_in_sw = (int)(head_pcs->stats_in_end_offset - head_pcs->stats_in_offset);
                 if (head_pcs->scs->enable_dec_order == 0 && head_pcs->scs->lap_rc &&
                     head_pcs->temporal_layer_index == 0) {
@@ -591,7 +638,9 @@ static void process_lad_queue(InitialRateControlContext *ctx, uint8_t pass_thru)
                 }
             }
             //take the picture out from iRc process
-            irc_send_picture_out(ctx, head_pcs, FALSE);
+            EbErrorType return_error = irc_send_picture_out(ctx, head_pcs, FALSE);
+            if (return_error != EB_ErrorNone)
+                return return_error;
             //advance the head
             head_entry->pcs = NULL;
             queue->head     = OUT_Q_ADVANCE(queue->head);
@@ -600,6 +649,7 @@ static void process_lad_queue(InitialRateControlContext *ctx, uint8_t pass_thru)
             break;
         }
     }
+    return EB_ErrorNone;
 }
 #define HIGH_8x8_DIST_VAR_TH 50000
 #define MIN_AVG_ME_DIST 1000
@@ -683,6 +733,8 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
         // If the picture is complete, proceed
         if (pcs->me_segments_completion_count == pcs->me_segments_total_count) {
             SequenceControlSet *scs = pcs->scs;
+            svt_aom_deadline_stamp(&scs->enc_ctx->deadline_ctrl,
+                                   &pcs->deadline_time_us[SVT_AV1_DEADLINE_STAGE_RATE_CONTROL]);
 
             pcs->norm_me_dist = 0;
             if (pcs->slice_type != I_SLICE) {
@@ -744,7 +796,10 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
                 }
 
                 // post to downstream process
-                irc_send_picture_out(context_ptr, pcs, TRUE);
+                if (irc_send_picture_out(context_ptr, pcs, TRUE) != EB_ErrorNone) {
+                    svt_aom_post_error_packet(scs->enc_ctx);
+                    return NULL;
+                }
 
                 // Release the Input Results
                 svt_release_object(in_results_wrapper_ptr);
@@ -791,7 +846,10 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
 #endif
             // tpl_la can be performed on unscaled frame when in super-res q-threshold and auto mode
             uint8_t lad_queue_pass_thru = !(pcs->tpl_ctrls.enable && !pcs->frame_superres_enabled);
-            process_lad_queue(context_ptr, lad_queue_pass_thru);
+            if (process_lad_queue(context_ptr, lad_queue_pass_thru) != EB_ErrorNone) {
+                svt_aom_post_error_packet(scs->enc_ctx);
+                return NULL;
+            }
         }
         // Release the Input Results
         svt_release_object(in_results_wrapper_ptr);
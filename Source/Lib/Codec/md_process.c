@@ -59,6 +59,8 @@ static void mode_decision_context_dctor(EbPtr p) {
     EB_FREE_ALIGNED_ARRAY(obj->pred_buf_q3);
     EB_FREE_ARRAY(obj->fast_cand_array);
     EB_FREE_ARRAY(obj->fast_cand_ptr_array);
+    EB_FREE_ARRAY(obj->tx_cache);
+    EB_FREE_ARRAY(obj->tx_cache_pool);
     EB_FREE_2D(obj->injected_mvs);
     EB_FREE_ARRAY(obj->injected_ref_types);
     EB_FREE_ARRAY(obj->fast_cost_array);
@@ -125,7 +127,8 @@ void svt_aom_set_nics(NicScalingCtrls *scaling_ctrls, uint32_t mds1_count[CAND_C
  * Mode Decision Context Constructor
  ******************************************************/
 EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColorFormat color_format, uint8_t sb_size,
-                                               EncMode enc_mode, uint16_t max_block_cnt, uint32_t encoder_bit_depth,
+                                               EncMode enc_mode, EncMode max_enc_mode, uint16_t max_block_cnt,
+                                               uint32_t encoder_bit_depth,
                                                EbFifo *mode_decision_configuration_input_fifo_ptr,
                                                EbFifo *mode_decision_output_fifo_ptr, uint8_t enable_hbd_mode_decision,
                                                uint8_t cfg_palette, uint8_t seq_qp_mod) {
@@ -252,6 +255,15 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
     EB_MALLOC_ARRAY(ctx->fast_cand_array, max_can_count);
 
     EB_MALLOC_ARRAY(ctx->fast_cand_ptr_array, max_can_count);
+    if (svt_aom_get_tx_cache_level(enc_mode)) {
+        EB_CALLOC_ARRAY(ctx->tx_cache, TX_CACHE_ENTRIES);
+        EB_MALLOC_ARRAY(ctx->tx_cache_pool, TX_CACHE_POOL_SIZE);
+    } else {
+        ctx->tx_cache      = NULL;
+        ctx->tx_cache_pool = NULL;
+    }
+    ctx->tx_cache_pool_pos = 0;
+    ctx->tx_cache_epoch    = 0;
     svt_aom_assert_err(max_can_count > ind_uv_cands, "Max. candidates is too low");
     EB_MALLOC_2D(ctx->injected_mvs, (uint16_t)(max_can_count - ind_uv_cands), 2);
     EB_MALLOC_ARRAY(ctx->injected_ref_types, (max_can_count - ind_uv_cands));
@@ -354,7 +366,8 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
         ctx->md_blk_arr_nsq[coded_leaf_index].segment_id = 0;
         const BlockGeom *blk_geom                        = get_blk_geom_mds(coded_leaf_index);
 
-        if (svt_aom_get_bypass_encdec(enc_mode, encoder_bit_depth)) {
+        // bypass_encdec is on in the fast presets, check the fastest preset a picture can use
+        if (svt_aom_get_bypass_encdec(max_enc_mode, encoder_bit_depth)) {
             EbPictureBufferDescInitData init_data;
 
             init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
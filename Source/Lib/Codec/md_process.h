@@ -174,6 +174,32 @@ typedef struct TxtControls {
     // a multiplier to control the q-based modulation of satd_early_exit_th; ~0 is off, lower values are more aggressive.
     uint16_t satd_th_q_weight;
 } TxtControls;
+#define TX_CACHE_ENTRIES 4096 // must be a power of 2
+#define TX_CACHE_POOL_SIZE (1 << 18) // int32 slots
+// One cached luma T/Q result of tx_type_search
+typedef struct TxCacheEntry {
+    // Hash of the residual block
+    uint64_t hash;
+    // Packed tx_size, tx_type, pf_shape, qindex and the RDOQ context the result was computed with
+    uint64_t key;
+    uint32_t lambda;
+    // The entry is valid only if it matches ModeDecisionContext::tx_cache_epoch
+    uint32_t epoch;
+    // Absolute write position of the quantized coeffs, reconstructed coeffs and residual in the coeff
+    // pool; they are overwritten once the pool write position is more than TX_CACHE_POOL_SIZE ahead
+    uint64_t coeff_pos;
+    uint64_t three_quad_energy;
+    // Frequency-domain distortion before the tx-scale shift; valid if dist_valid is set
+    uint64_t dist[DIST_CALC_TOTAL];
+    int32_t  satd;
+    uint16_t eob;
+    uint8_t  quantized_dc;
+    uint8_t  dist_valid;
+} TxCacheEntry;
+typedef struct TxCacheCtrls {
+    // Cache the T/Q output of tx_type_search for identical residuals within a SB; 0: OFF, 1: ON
+    uint8_t enabled;
+} TxCacheCtrls;
 typedef struct TxsCycleRControls {
     // On/Off feature control
     uint8_t enabled;
@@ -898,6 +924,12 @@ typedef struct ModeDecisionContext {
     EbFifo                       *mode_decision_output_fifo_ptr;
     ModeDecisionCandidate       **fast_cand_ptr_array;
     ModeDecisionCandidate        *fast_cand_array;
+    // SB-scoped cache of tx_type_search T/Q results; the coeffs of the entries are written in a ring
+    // of TX_CACHE_POOL_SIZE coeffs, at the absolute position tx_cache_pool_pos
+    TxCacheEntry *tx_cache;
+    int32_t      *tx_cache_pool;
+    uint64_t      tx_cache_pool_pos;
+    uint32_t      tx_cache_epoch;
     ModeDecisionCandidateBuffer **cand_bf_ptr_array;
     ModeDecisionCandidateBuffer  *cand_bf_tx_depth_1;
     ModeDecisionCandidateBuffer  *cand_bf_tx_depth_2;
@@ -1119,6 +1151,7 @@ typedef struct ModeDecisionContext {
     CflCtrls            cfl_ctrls;
     TxsControls         txs_ctrls;
     TxtControls         txt_ctrls;
+    TxCacheCtrls        tx_cache_ctrls;
     CandReductionCtrls  cand_reduction_ctrls;
     NsqGeomCtrls        nsq_geom_ctrls;
     NsqSearchCtrls      nsq_search_ctrls;
@@ -1259,8 +1292,8 @@ typedef void (*EbAv1LambdaAssignFunc)(PictureControlSet *pcs, uint32_t *fast_lam
  * Extern Function Declarations
  **************************************/
 extern EbErrorType svt_aom_mode_decision_context_ctor(
-    ModeDecisionContext *ctx, EbColorFormat color_format, uint8_t sb_size, EncMode enc_mode, uint16_t max_block_cnt,
-    uint32_t encoder_bit_depth, EbFifo *mode_decision_configuration_input_fifo_ptr,
+    ModeDecisionContext *ctx, EbColorFormat color_format, uint8_t sb_size, EncMode enc_mode, EncMode max_enc_mode,
+    uint16_t max_block_cnt, uint32_t encoder_bit_depth, EbFifo *mode_decision_configuration_input_fifo_ptr,
     EbFifo *mode_decision_output_fifo_ptr, uint8_t enable_hbd_mode_decision, uint8_t cfg_palette, uint8_t seq_qp_mod);
 
 extern const EbAv1LambdaAssignFunc svt_aom_av1_lambda_assignment_function_table[4];
@@ -33,5 +33,8 @@ EbErrorType svt_aom_me_context_ctor(MeContext *object_ptr) {
     object_ptr->num_of_ref_pic_to_search[0] = 0;
     object_ptr->num_of_ref_pic_to_search[1] = 0;
 
+    svt_av1_crc_calculator_init(&object_ptr->crc_calculator1, 24, 0x5D6DCB);
+    svt_av1_crc_calculator_init(&object_ptr->crc_calculator2, 24, 0x864CFB);
+
     return EB_ErrorNone;
 }
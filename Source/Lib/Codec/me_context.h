@@ -16,6 +16,7 @@
 #include "md_rate_estimation.h"
 #include "coding_unit.h"
 #include "object.h"
+#include "hash_motion.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -317,6 +318,15 @@ typedef struct Me8x8VarCtrls {
     // If ME 8x8 SAD variance is above me_sr_mult2_th, multiply the search area width/height by 2
     uint32_t me_sr_mult2_th;
 } Me8x8VarCtrls;
+/* HashMeCtrls look up the ME blocks in the block hash index of the nearest reference of each list, and
+* take an exact match when the search did not find one (screen content, where moved windows and scrolled
+* text land far outside the search area).
+*/
+typedef struct HashMeCtrls {
+    uint8_t enabled;
+    // Smallest ME block size looked up in the hash index (8, 16, 32 or 64)
+    uint8_t min_block_size;
+} HashMeCtrls;
 #define SEARCH_REGION_COUNT 2
 typedef struct SearchArea {
     uint16_t width; // search area width
@@ -413,6 +423,7 @@ typedef struct MeContext {
     MeHmeRefPruneCtrls me_hme_prune_ctrls;
     MeSrCtrls          me_sr_adjustment_ctrls;
     Me8x8VarCtrls      me_8x8_var_ctrls;
+    HashMeCtrls        hash_me_ctrls;
     uint8_t            max_hme_sr_area_multipler;
     MvBasedSearchAdj   mv_based_sa_adj;
     // ME
@@ -506,6 +517,11 @@ typedef struct MeContext {
     uint32_t     b64_height;
     uint8_t      performed_phme[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH][2];
     uint32_t     prev_me_stage_based_exit_th;
+    // hash-based ME
+    HashIndex     *ref_hash_index[MAX_NUM_OF_REF_PIC_LIST];
+    CRC_CALCULATOR crc_calculator1;
+    CRC_CALCULATOR crc_calculator2;
+    B64BlockHashes b64_hashes;
 } MeContext;
 
 typedef uint64_t (*EB_ME_DISTORTION_FUNC)(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride,
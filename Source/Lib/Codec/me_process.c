@@ -86,6 +86,40 @@ EbErrorType svt_aom_motion_estimation_context_ctor(EbThreadContext *  thread_ctx
     EB_NEW(me_context_ptr->me_ctx, svt_aom_me_context_ctor);
     return EB_ErrorNone;
 }
+/*
+* Point the hash-based ME at the block hash index of the nearest reference of each list. The
+* index lives in the PA reference object and is brought up to date by the first ME segment that
+* needs it; only the blocks that changed since the picture the index last held are rehashed.
+*/
+static void set_hash_me_refs(PictureParentControlSet *pcs, MeContext *me_ctx) {
+    SequenceControlSet *scs = pcs->scs;
+
+    for (int list_index = REF_LIST_0; list_index < MAX_NUM_OF_REF_PIC_LIST; list_index++)
+        me_ctx->ref_hash_index[list_index] = NULL;
+    if (!me_ctx->hash_me_ctrls.enabled || scs->static_config.restricted_motion_vector ||
+        pcs->frame_superres_enabled || pcs->frame_resize_enabled ||
+        scs->static_config.resize_mode != RESIZE_NONE)
+        return;
+    const int num_of_list_to_search = (pcs->slice_type == P_SLICE) ? 1 : 2;
+    for (int list_index = REF_LIST_0; list_index < num_of_list_to_search; list_index++) {
+        const uint8_t ref_count = list_index == REF_LIST_0 ? pcs->ref_list0_count_try : pcs->ref_list1_count_try;
+        if (!ref_count)
+            continue;
+        EbPaReferenceObject *ref_object = (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][0]->object_ptr;
+        EbErrorType          err        = EB_ErrorNone;
+        svt_block_on_mutex(ref_object->hash_index_mutex);
+        if (ref_object->hash_index_picture_number != ref_object->picture_number) {
+            Yv12BufferConfig ref_source;
+            svt_aom_link_eb_to_aom_buffer_desc_8bit(ref_object->input_padded_pic, &ref_source);
+            err = svt_av1_hash_index_update(&ref_object->hash_index, &ref_source, BLOCK_SIZE_64, 0);
+            ref_object->hash_index_picture_number = err == EB_ErrorNone ? ref_object->picture_number : (uint64_t)~0;
+        }
+        svt_release_mutex(ref_object->hash_index_mutex);
+        if (err == EB_ErrorNone)
+            me_ctx->ref_hash_index[list_index] = &ref_object->hash_index;
+    }
+}
+
 /************************************************
  * Motion Analysis Kernel
  * The Motion Analysis performs  Motion Estimation
@@ -169,6 +203,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                                                      &input_padded_pic,
                                                      &quarter_picture_ptr,
                                                      &sixteenth_picture_ptr);
+                    set_hash_me_refs(pcs, me_context_ptr->me_ctx);
 
                     // 64x64 Block Loop
                     for (uint32_t y_b64_index = y_b64_start_index; y_b64_index < y_b64_end_index; ++y_b64_index) {
@@ -298,8 +333,8 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                         }
             }
             // Get Empty Results Object
-            svt_get_empty_object(me_context_ptr->motion_estimation_results_output_fifo_ptr,
-                                 &out_results_wrapper);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, me_context_ptr->motion_estimation_results_output_fifo_ptr,
+                                &out_results_wrapper);
 
             MotionEstimationResults *out_results = (MotionEstimationResults *)
                                                            out_results_wrapper->object_ptr;
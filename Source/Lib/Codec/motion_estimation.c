@@ -1246,6 +1246,99 @@ uint16_t svt_aom_get_scaled_picture_distance(uint16_t dist) {
  *   performs integer search motion estimation for
  all avaiable references frames
  *******************************************/
+// largest hash ME displacement, in full pel, that leaves room for the sub-pel refinement
+#define HASH_ME_MAX_MV ((MV_UPP >> 3) - 16)
+// index of the block at (block_x, block_y), in units of the block size, within the ME results of a 64x64
+static INLINE uint32_t hash_me_block_index(int size, int block_x, int block_y) {
+    if (size == 64)
+        return ME_TIER_ZERO_PU_64x64;
+    if (size == 32)
+        return ME_TIER_ZERO_PU_32x32_0 + (block_x | (block_y << 1));
+    if (size == 16)
+        return ME_TIER_ZERO_PU_16x16_0 + ((block_x & 1) | ((block_y & 1) << 1) | ((block_x >> 1) << 2) |
+                                          ((block_y >> 1) << 3));
+    const int x16 = block_x >> 1, y16 = block_y >> 1;
+    return ME_TIER_ZERO_PU_8x8_0 +
+        4 * ((x16 & 1) | ((y16 & 1) << 1) | ((x16 >> 1) << 2) | ((y16 >> 1) << 3)) +
+        ((block_x & 1) | ((block_y & 1) << 1));
+}
+/*
+* Look up the blocks of the 64x64 that the search left with a non-zero SAD in the block hash index of the
+* reference, and take the closest exact match. Screen content moves by large displacements (scrolling,
+* dragged windows) that no search area covers, but that an index of all the reference blocks finds at once.
+*/
+static void hash_me_b64(MeContext *me_ctx, uint32_t list_index, uint32_t b64_origin_x, uint32_t b64_origin_y,
+                        Bool *hashed) {
+    HashIndex           *index    = me_ctx->ref_hash_index[list_index];
+    EbPictureBufferDesc *ref_pic  = me_ctx->me_ds_ref_array[list_index][0].picture_ptr;
+    uint32_t            *best_sad = me_ctx->p_sb_best_sad[list_index][0];
+    uint32_t            *best_mv  = me_ctx->p_sb_best_mv[list_index][0];
+    const int            b64_size = BLOCK_SIZE_64;
+
+    for (int size = me_ctx->hash_me_ctrls.min_block_size, level = get_msb(size) - 2; size <= b64_size;
+         size <<= 1, level++) {
+        const int blocks_per_row = b64_size / size;
+        for (int block_y = 0; block_y < blocks_per_row; block_y++) {
+            if ((uint32_t)((block_y + 1) * size) > me_ctx->b64_height)
+                break;
+            for (int block_x = 0; block_x < blocks_per_row; block_x++) {
+                if ((uint32_t)((block_x + 1) * size) > me_ctx->b64_width)
+                    break;
+                const uint32_t me_idx = hash_me_block_index(size, block_x, block_y);
+                if (best_sad[me_idx] == 0)
+                    continue;
+                if (!*hashed) {
+                    svt_av1_get_b64_block_hashes(me_ctx->b64_src_ptr,
+                                                 me_ctx->b64_src_stride,
+                                                 &me_ctx->crc_calculator1,
+                                                 &me_ctx->crc_calculator2,
+                                                 &me_ctx->b64_hashes);
+                    *hashed = TRUE;
+                }
+                const int      pos           = block_y * blocks_per_row + block_x;
+                const uint32_t hash_value1   = me_ctx->b64_hashes.hash_value1[level][pos];
+                const uint32_t hash_value2   = me_ctx->b64_hashes.hash_value2[level][pos];
+                const int      count         = svt_av1_hash_table_count(&index->table, hash_value1);
+                const int      x_pos         = (int)b64_origin_x + block_x * size;
+                const int      y_pos         = (int)b64_origin_y + block_y * size;
+                const uint8_t *src           = me_ctx->b64_src_ptr + block_y * size * me_ctx->b64_src_stride +
+                    block_x * size;
+                int            best_mv_cost  = INT_MAX;
+                int16_t        best_x_mv     = 0;
+                int16_t        best_y_mv     = 0;
+                if (count == 0)
+                    continue;
+                Iterator iterator = svt_av1_hash_get_first_iterator(&index->table, hash_value1);
+                for (int i = 0; i < count; i++, svt_aom_iterator_increment(&iterator)) {
+                    const BlockHash *ref_block_hash = (BlockHash *)svt_aom_iterator_get(&iterator);
+                    if (ref_block_hash->hash_value2 != hash_value2)
+                        continue;
+                    const int x_mv    = ref_block_hash->x - x_pos;
+                    const int y_mv    = ref_block_hash->y - y_pos;
+                    const int mv_cost = ABS(x_mv) + ABS(y_mv);
+                    if (mv_cost >= best_mv_cost || ABS(x_mv) > HASH_ME_MAX_MV || ABS(y_mv) > HASH_ME_MAX_MV)
+                        continue;
+                    // the hashes can collide; only an exact match is taken
+                    const uint8_t *ref = ref_pic->buffer_y + (ref_pic->org_y + ref_block_hash->y) * ref_pic->stride_y +
+                        ref_pic->org_x + ref_block_hash->x;
+                    int match = 1;
+                    for (int row = 0; row < size && match; row++)
+                        match = !memcmp(src + row * me_ctx->b64_src_stride, ref + row * ref_pic->stride_y, size);
+                    if (match) {
+                        best_mv_cost = mv_cost;
+                        best_x_mv    = (int16_t)x_mv;
+                        best_y_mv    = (int16_t)y_mv;
+                    }
+                }
+                if (best_mv_cost != INT_MAX) {
+                    best_sad[me_idx] = 0;
+                    best_mv[me_idx]  = ((uint16_t)best_y_mv << 16) | ((uint16_t)best_x_mv);
+                }
+            }
+        }
+    }
+}
+
 static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index, uint32_t b64_origin_x,
     uint32_t b64_origin_y, MeContext *me_ctx,
     EbPictureBufferDesc *input_ptr) {
@@ -1272,6 +1365,7 @@ static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index,
     int16_t              x_search_center = 0;
     int16_t              y_search_center = 0;
     EbPictureBufferDesc *ref_pic_ptr;
+    Bool                 b64_hashed = FALSE;
     num_of_list_to_search = me_ctx->num_of_list_to_search;
 
     // Uni-Prediction motion estimation loop
@@ -1581,6 +1675,9 @@ static void integer_search_b64(PictureParentControlSet *pcs, uint32_t b64_index,
                                                y_search_area_origin,
                                                search_area_width,
                                                search_area_height);
+            if (ref_pic_index == 0 && me_ctx->me_type == ME_OPEN_LOOP && me_ctx->hash_me_ctrls.enabled &&
+                me_ctx->ref_hash_index[list_index])
+                hash_me_b64(me_ctx, list_index, b64_origin_x, b64_origin_y, &b64_hashed);
         }
     }
 }
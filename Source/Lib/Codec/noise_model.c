@@ -17,9 +17,15 @@
 #include "mathutils.h"
 #include "svt_log.h"
 #include "aom_dsp_rtcd.h"
+#include "svt_threads.h"
 
 static const int32_t k_max_lag = 4;
 
+// Number of block rows gathered into one partial AR equation system. The
+// partial systems are summed in band order, so the band layout (and not the
+// thread count) decides the rounding of the result.
+#define NOISE_OBS_BAND_BLOCK_ROWS 4
+
 void *svt_aom_memalign(size_t align, size_t size);
 void  svt_aom_free(void *memblk);
 
@@ -502,107 +508,152 @@ static int compare_scores(const void *a, const void *b) {
     return diff < 0 ? -1 : diff > 0;
 }
 
-int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w,
-                                      int32_t h, int32_t stride, uint8_t *flat_blocks) {
+typedef struct FlatBlockFinderJobs {
+    const AomFlatBlockFinder *block_finder;
+    const uint8_t            *data;
+    int32_t                   w;
+    int32_t                   h;
+    int32_t                   stride;
+    int32_t                   num_blocks_w;
+    uint8_t                  *flat_blocks;
+    IndexAndscore            *scores;
+    int32_t                  *row_num_flat;
+    double                   *plane[SVT_JOBS_MAX_THREADS];
+    double                   *block[SVT_JOBS_MAX_THREADS];
+} FlatBlockFinderJobs;
+
+// Scores the blocks of block row by
+static void flat_block_finder_row(void *ctx, int32_t thread_idx, int32_t by) {
     // The gradient-based features used in this code are based on:
     //  A. Kokaram, D. Kelly, H. Denman and A. Crawford, "Measuring noise
     //  correlation for improved video denoising," 2012 19th, ICIP.
     // The thresholds are more lenient to allow for correct grain modeling
     // if extreme cases.
-    const int32_t  block_size        = block_finder->block_size;
-    const int32_t  n                 = block_size * block_size;
-    const double   k_trace_threshold = 0.15 / (32 * 32);
-    const double   k_ratio_threshold = 1.25;
-    const double   k_norm_threshold  = 0.08 / (32 * 32);
-    const double   k_var_threshold   = 0.005 / (double)n;
-    const int32_t  num_blocks_w      = (w + block_size - 1) / block_size;
-    const int32_t  num_blocks_h      = (h + block_size - 1) / block_size;
-    int32_t        num_flat          = 0;
-    double        *plane             = (double *)malloc(n * sizeof(*plane));
-    double        *block             = (double *)malloc(n * sizeof(*block));
-    IndexAndscore *scores            = (IndexAndscore *)malloc(num_blocks_w * num_blocks_h * sizeof(*scores));
-    if (plane == NULL || block == NULL || scores == NULL) {
-        SVT_ERROR("Failed to allocate memory for block of size %d\n", n);
-        free(plane);
-        free(block);
-        free(scores);
-        return -1;
-    }
-
-#ifdef NOISE_MODEL_LOG_SCORE
-    SVT_ERROR("score = [");
-#endif
-    for (int32_t by = 0; by < num_blocks_h; ++by) {
-        for (int32_t bx = 0; bx < num_blocks_w; ++bx) {
-            // Compute gradient covariance matrix.
-            double g_xx = 0, g_xy = 0, g_yy = 0;
-            double var  = 0;
-            double mean = 0;
-            svt_aom_flat_block_finder_extract_block(
-                block_finder, data, w, h, stride, bx * block_size, by * block_size, plane, block);
-
-            for (int32_t yi = 1; yi < block_size - 1; ++yi) {
-                for (int32_t xi = 1; xi < block_size - 1; ++xi) {
-                    const double gx = (block[yi * block_size + xi + 1] - block[yi * block_size + xi - 1]) / 2;
-                    const double gy = (block[yi * block_size + xi + block_size] -
-                                       block[yi * block_size + xi - block_size]) /
-                        2;
-                    g_xx += gx * gx;
-                    g_xy += gx * gy;
-                    g_yy += gy * gy;
-
-                    mean += block[yi * block_size + xi];
-                    var += block[yi * block_size + xi] * block[yi * block_size + xi];
-                }
+    FlatBlockFinderJobs      *jobs              = (FlatBlockFinderJobs *)ctx;
+    const AomFlatBlockFinder *block_finder      = jobs->block_finder;
+    const int32_t             block_size        = block_finder->block_size;
+    const int32_t             n                 = block_size * block_size;
+    const double              k_trace_threshold = 0.15 / (32 * 32);
+    const double              k_ratio_threshold = 1.25;
+    const double              k_norm_threshold  = 0.08 / (32 * 32);
+    const double              k_var_threshold   = 0.005 / (double)n;
+    const int32_t             num_blocks_w      = jobs->num_blocks_w;
+    double                   *plane             = jobs->plane[thread_idx];
+    double                   *block             = jobs->block[thread_idx];
+    uint8_t                  *flat_blocks       = jobs->flat_blocks;
+    IndexAndscore            *scores            = jobs->scores;
+    int32_t                   num_flat          = 0;
+
+    for (int32_t bx = 0; bx < num_blocks_w; ++bx) {
+        // Compute gradient covariance matrix.
+        double g_xx = 0, g_xy = 0, g_yy = 0;
+        double var  = 0;
+        double mean = 0;
+        svt_aom_flat_block_finder_extract_block(
+            block_finder, jobs->data, jobs->w, jobs->h, jobs->stride, bx * block_size, by * block_size, plane, block);
+
+        for (int32_t yi = 1; yi < block_size - 1; ++yi) {
+            for (int32_t xi = 1; xi < block_size - 1; ++xi) {
+                const double gx = (block[yi * block_size + xi + 1] - block[yi * block_size + xi - 1]) / 2;
+                const double gy = (block[yi * block_size + xi + block_size] -
+                                   block[yi * block_size + xi - block_size]) /
+                    2;
+                g_xx += gx * gx;
+                g_xy += gx * gy;
+                g_yy += gy * gy;
+
+                mean += block[yi * block_size + xi];
+                var += block[yi * block_size + xi] * block[yi * block_size + xi];
             }
-            mean /= (block_size - 2) * (block_size - 2);
-
-            // Normalize gradients by BlockSize.
-            g_xx /= ((block_size - 2) * (block_size - 2));
-            g_xy /= ((block_size - 2) * (block_size - 2));
-            g_yy /= ((block_size - 2) * (block_size - 2));
-            var = var / ((block_size - 2) * (block_size - 2)) - mean * mean;
-
-            {
-                const double  trace   = g_xx + g_yy;
-                const double  det     = g_xx * g_yy - g_xy * g_xy;
-                const double  e1      = (trace + sqrt(trace * trace - 4 * det)) / 2.;
-                const double  e2      = (trace - sqrt(trace * trace - 4 * det)) / 2.;
-                const double  norm    = e1; // Spectral norm
-                const double  ratio   = (e1 / AOMMAX(e2, 1e-6));
-                const int32_t is_flat = (trace < k_trace_threshold) && (ratio < k_ratio_threshold) &&
-                    (norm < k_norm_threshold) && (var > k_var_threshold);
-                // The following weights are used to combine the above features to give
-                // a sigmoid score for flatness. If the input was normalized to [0,100]
-                // the magnitude of these values would be close to 1 (e.g., weights
-                // corresponding to variance would be a factor of 10000x smaller).
-                // The weights are given in the following order:
-                //    [{var}, {ratio}, {trace}, {norm}, offset]
-                // with one of the most discriminative being simply the variance.
-                const double weights[5]              = {-6682, -0.2056, 13087, -12434, 2.5694};
-                const float  score                   = (float)(1.0 /
-                                            (1 +
-                                             exp(-(weights[0] * var + weights[1] * ratio + weights[2] * trace +
-                                                   weights[3] * norm + weights[4]))));
-                flat_blocks[by * num_blocks_w + bx]  = is_flat ? 255 : 0;
-                scores[by * num_blocks_w + bx].score = var > k_var_threshold ? score : 0;
-                scores[by * num_blocks_w + bx].index = by * num_blocks_w + bx;
+        }
+        mean /= (block_size - 2) * (block_size - 2);
+
+        // Normalize gradients by BlockSize.
+        g_xx /= ((block_size - 2) * (block_size - 2));
+        g_xy /= ((block_size - 2) * (block_size - 2));
+        g_yy /= ((block_size - 2) * (block_size - 2));
+        var = var / ((block_size - 2) * (block_size - 2)) - mean * mean;
+
+        {
+            const double  trace   = g_xx + g_yy;
+            const double  det     = g_xx * g_yy - g_xy * g_xy;
+            const double  e1      = (trace + sqrt(trace * trace - 4 * det)) / 2.;
+            const double  e2      = (trace - sqrt(trace * trace - 4 * det)) / 2.;
+            const double  norm    = e1; // Spectral norm
+            const double  ratio   = (e1 / AOMMAX(e2, 1e-6));
+            const int32_t is_flat = (trace < k_trace_threshold) && (ratio < k_ratio_threshold) &&
+                (norm < k_norm_threshold) && (var > k_var_threshold);
+            // The following weights are used to combine the above features to give
+            // a sigmoid score for flatness. If the input was normalized to [0,100]
+            // the magnitude of these values would be close to 1 (e.g., weights
+            // corresponding to variance would be a factor of 10000x smaller).
+            // The weights are given in the following order:
+            //    [{var}, {ratio}, {trace}, {norm}, offset]
+            // with one of the most discriminative being simply the variance.
+            const double weights[5]              = {-6682, -0.2056, 13087, -12434, 2.5694};
+            const float  score                   = (float)(1.0 /
+                                        (1 +
+                                         exp(-(weights[0] * var + weights[1] * ratio + weights[2] * trace +
+                                               weights[3] * norm + weights[4]))));
+            flat_blocks[by * num_blocks_w + bx]  = is_flat ? 255 : 0;
+            scores[by * num_blocks_w + bx].score = var > k_var_threshold ? score : 0;
+            scores[by * num_blocks_w + bx].index = by * num_blocks_w + bx;
 #ifdef NOISE_MODEL_LOG_SCORE
-                SVT_ERROR("%g %g %g %g %g %d ", score, var, ratio, trace, norm, is_flat);
+            SVT_ERROR("%g %g %g %g %g %d ", score, var, ratio, trace, norm, is_flat);
 #endif
-                num_flat += is_flat;
-            }
+            num_flat += is_flat;
         }
+    }
 #ifdef NOISE_MODEL_LOG_SCORE
-        SVT_ERROR("\n");
+    SVT_ERROR("\n");
 #endif
+    jobs->row_num_flat[by] = num_flat;
+}
+
+int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w,
+                                      int32_t h, int32_t stride, uint8_t *flat_blocks, SvtJobPool *job_pool) {
+    const int32_t       block_size   = block_finder->block_size;
+    const int32_t       n            = block_size * block_size;
+    const int32_t       num_blocks_w = (w + block_size - 1) / block_size;
+    const int32_t       num_blocks_h = (h + block_size - 1) / block_size;
+    int32_t             num_flat     = 0;
+    int32_t             init_success = 1;
+    const int32_t       thread_count = svt_job_pool_thread_count(job_pool, num_blocks_h);
+    FlatBlockFinderJobs jobs;
+
+    jobs.block_finder = block_finder;
+    jobs.data         = data;
+    jobs.w            = w;
+    jobs.h            = h;
+    jobs.stride       = stride;
+    jobs.num_blocks_w = num_blocks_w;
+    jobs.flat_blocks  = flat_blocks;
+    jobs.scores       = (IndexAndscore *)malloc(num_blocks_w * num_blocks_h * sizeof(*jobs.scores));
+    jobs.row_num_flat = (int32_t *)malloc(num_blocks_h * sizeof(*jobs.row_num_flat));
+    init_success &= (jobs.scores != NULL) && (jobs.row_num_flat != NULL);
+    for (int32_t t = 0; t < thread_count; ++t) {
+        jobs.plane[t] = (double *)malloc(n * sizeof(*jobs.plane[t]));
+        jobs.block[t] = (double *)malloc(n * sizeof(*jobs.block[t]));
+        init_success &= (jobs.plane[t] != NULL) && (jobs.block[t] != NULL);
+    }
+    if (!init_success) {
+        SVT_ERROR("Failed to allocate memory for block of size %d\n", n);
+        num_flat = -1;
+        goto free_scratch;
     }
+
+#ifdef NOISE_MODEL_LOG_SCORE
+    SVT_ERROR("score = [");
+#endif
+    svt_job_pool_run(job_pool, flat_block_finder_row, &jobs, num_blocks_h);
 #ifdef NOISE_MODEL_LOG_SCORE
     SVT_ERROR("];\n");
 #endif
+    for (int32_t by = 0; by < num_blocks_h; ++by) num_flat += jobs.row_num_flat[by];
     // Find the top-scored blocks (most likely to be flat) and set the flat blocks
     // be the union of the thresholded results and the top 10th percentile of the
     // scored results.
+    IndexAndscore *scores = jobs.scores;
     qsort(scores, num_blocks_w * num_blocks_h, sizeof(*scores), &compare_scores);
     const int32_t top_nth_percentile = num_blocks_w * num_blocks_h * 90 / 100;
     const float   score_threshold    = scores[top_nth_percentile].score;
@@ -612,9 +663,13 @@ int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder, co
             flat_blocks[scores[i].index] |= 1;
         }
     }
-    free(block);
-    free(plane);
-    free(scores);
+free_scratch:
+    for (int32_t t = 0; t < thread_count; ++t) {
+        free(jobs.block[t]);
+        free(jobs.plane[t]);
+    }
+    free(jobs.scores);
+    free(jobs.row_num_flat);
     return num_flat;
 }
 
@@ -787,38 +842,51 @@ void svt_av1_add_block_observations_internal_c(uint32_t n, const double val, con
     }
 }
 
-static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c, const uint8_t *const data,
-                                      const uint8_t *const denoised, int32_t w, int32_t h, int32_t stride,
-                                      int32_t sub_log2[2], const uint8_t *const alt_data,
-                                      const uint8_t *const alt_denoised, int32_t alt_stride,
-                                      const uint8_t *const flat_blocks, int32_t block_size, int32_t num_blocks_w,
-                                      int32_t num_blocks_h) {
-    const int32_t lag           = noise_model->params.lag;
-    const int32_t num_coords    = noise_model->n;
-    const double  normalization = (1 << noise_model->params.bit_depth) - 1;
-    const double  recp_sqr_norm = 1 / (normalization * normalization);
-    double       *A             = noise_model->latest_state[c].eqns.A;
-    double       *b             = noise_model->latest_state[c].eqns.b;
-    const int32_t n             = noise_model->latest_state[c].eqns.n;
-    double       *buffer;
-    double       *buffer_norm;
-
-    EB_MALLOC_ALIGNED(buffer, sizeof(*buffer) * (num_coords + 1));
-
-    if (!buffer) {
-        SVT_ERROR("Unable to allocate buffer of size %d\n", sizeof(*buffer) * (num_coords + 1));
-        return 0;
-    }
-
-    EB_MALLOC_ALIGNED(buffer_norm, sizeof(*buffer_norm) * (n));
-
-    if (!buffer_norm) {
-        EB_FREE_ALIGNED(buffer);
-        SVT_ERROR("Unable to allocate buffer of size %d\n", sizeof(*buffer_norm) * (n));
-        return 0;
-    }
-
-    for (int32_t by = 0; by < num_blocks_h; ++by) {
+typedef struct BlockObservationJobs {
+    const AomNoiseModel *noise_model;
+    const uint8_t       *data;
+    const uint8_t       *denoised;
+    int32_t              w;
+    int32_t              h;
+    int32_t              stride;
+    int32_t             *sub_log2;
+    const uint8_t       *alt_data;
+    const uint8_t       *alt_denoised;
+    int32_t              alt_stride;
+    const uint8_t       *flat_blocks;
+    int32_t              block_size;
+    int32_t              num_blocks_w;
+    int32_t              num_blocks_h;
+    int32_t              n;
+    double               recp_sqr_norm;
+    // Partial equation system of each band: A (n * n), b (n) and the ar row
+    // scratch buffers, band_doubles apart
+    double  *band_eqns;
+    int32_t  band_doubles;
+    int32_t *band_num_observations;
+} BlockObservationJobs;
+
+// Accumulates the observations of the flat blocks of one band of block rows
+// into the band's partial equation system
+static void add_band_observations(void *ctx, int32_t thread_idx, int32_t band) {
+    BlockObservationJobs *jobs          = (BlockObservationJobs *)ctx;
+    const AomNoiseModel  *noise_model   = jobs->noise_model;
+    const int32_t         lag           = noise_model->params.lag;
+    const int32_t         num_coords    = noise_model->n;
+    const int32_t         n             = jobs->n;
+    const int32_t         block_size    = jobs->block_size;
+    const int32_t         num_blocks_w  = jobs->num_blocks_w;
+    const int32_t        *sub_log2      = jobs->sub_log2;
+    const uint8_t *const  flat_blocks   = jobs->flat_blocks;
+    double               *A             = jobs->band_eqns + band * jobs->band_doubles;
+    double               *b             = A + n * n;
+    double               *buffer        = b + n;
+    double               *buffer_norm   = buffer + num_coords + 1;
+    const int32_t         by_end        = AOMMIN((band + 1) * NOISE_OBS_BAND_BLOCK_ROWS, jobs->num_blocks_h);
+    int32_t               num_observations = 0;
+    (void)thread_idx;
+
+    for (int32_t by = band * NOISE_OBS_BAND_BLOCK_ROWS; by < by_end; ++by) {
         const int32_t y_o = by * (block_size >> sub_log2[1]);
         for (int32_t bx = 0; bx < num_blocks_w; ++bx) {
             const int32_t x_o = bx * (block_size >> sub_log2[0]);
@@ -826,8 +894,9 @@ static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c, con
                 continue;
             int32_t y_start = (by > 0 && flat_blocks[(by - 1) * num_blocks_w + bx]) ? 0 : lag;
             int32_t x_start = (bx > 0 && flat_blocks[by * num_blocks_w + bx - 1]) ? 0 : lag;
-            int32_t y_end   = AOMMIN((h >> sub_log2[1]) - by * (block_size >> sub_log2[1]), block_size >> sub_log2[1]);
-            int32_t x_end   = AOMMIN((w >> sub_log2[0]) - bx * (block_size >> sub_log2[0]) - lag,
+            int32_t y_end   = AOMMIN((jobs->h >> sub_log2[1]) - by * (block_size >> sub_log2[1]),
+                                   block_size >> sub_log2[1]);
+            int32_t x_end   = AOMMIN((jobs->w >> sub_log2[0]) - bx * (block_size >> sub_log2[0]) - lag,
                                    (bx + 1 < num_blocks_w && flat_blocks[by * num_blocks_w + bx + 1])
                                          ? (block_size >> sub_log2[0])
                                          : ((block_size >> sub_log2[0]) - lag));
@@ -836,40 +905,100 @@ static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c, con
                     const double val = noise_model->params.use_highbd
                         ? extract_ar_row_highbd(noise_model->coords,
                                                 num_coords,
-                                                (const uint16_t *const)data,
-                                                (const uint16_t *const)denoised,
-                                                stride,
-                                                sub_log2,
-                                                (const uint16_t *const)alt_data,
-                                                (const uint16_t *const)alt_denoised,
-                                                alt_stride,
+                                                (const uint16_t *const)jobs->data,
+                                                (const uint16_t *const)jobs->denoised,
+                                                jobs->stride,
+                                                jobs->sub_log2,
+                                                (const uint16_t *const)jobs->alt_data,
+                                                (const uint16_t *const)jobs->alt_denoised,
+                                                jobs->alt_stride,
                                                 x + x_o,
                                                 y + y_o,
                                                 buffer)
                         : extract_ar_row_lowbd(noise_model->coords,
                                                num_coords,
-                                               data,
-                                               denoised,
-                                               stride,
-                                               sub_log2,
-                                               alt_data,
-                                               alt_denoised,
-                                               alt_stride,
+                                               jobs->data,
+                                               jobs->denoised,
+                                               jobs->stride,
+                                               jobs->sub_log2,
+                                               jobs->alt_data,
+                                               jobs->alt_denoised,
+                                               jobs->alt_stride,
                                                x + x_o,
                                                y + y_o,
                                                buffer);
 
-                    svt_av1_add_block_observations_internal(n, val, recp_sqr_norm, buffer, buffer_norm, b, A);
+                    svt_av1_add_block_observations_internal(n, val, jobs->recp_sqr_norm, buffer, buffer_norm, b, A);
                 }
             }
             //There is situation when x_start is greater than x_end,
             //use max() to cap negative result and do not increment num_observations
-            noise_model->latest_state[c].num_observations += AOMMAX((y_end - y_start), 0) *
-                AOMMAX((x_end - x_start), 0);
+            num_observations += AOMMAX((y_end - y_start), 0) * AOMMAX((x_end - x_start), 0);
         }
     }
-    EB_FREE_ALIGNED(buffer);
-    EB_FREE_ALIGNED(buffer_norm);
+    jobs->band_num_observations[band] = num_observations;
+}
+
+static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c, const uint8_t *const data,
+                                      const uint8_t *const denoised, int32_t w, int32_t h, int32_t stride,
+                                      int32_t sub_log2[2], const uint8_t *const alt_data,
+                                      const uint8_t *const alt_denoised, int32_t alt_stride,
+                                      const uint8_t *const flat_blocks, int32_t block_size, int32_t num_blocks_w,
+                                      int32_t num_blocks_h, SvtJobPool *job_pool) {
+    const double         normalization = (1 << noise_model->params.bit_depth) - 1;
+    double              *A             = noise_model->latest_state[c].eqns.A;
+    double              *b             = noise_model->latest_state[c].eqns.b;
+    const int32_t        n             = noise_model->latest_state[c].eqns.n;
+    const int32_t        num_bands     = (num_blocks_h + NOISE_OBS_BAND_BLOCK_ROWS - 1) / NOISE_OBS_BAND_BLOCK_ROWS;
+    BlockObservationJobs jobs;
+
+    jobs.noise_model   = noise_model;
+    jobs.data          = data;
+    jobs.denoised      = denoised;
+    jobs.w             = w;
+    jobs.h             = h;
+    jobs.stride        = stride;
+    jobs.sub_log2      = sub_log2;
+    jobs.alt_data      = alt_data;
+    jobs.alt_denoised  = alt_denoised;
+    jobs.alt_stride    = alt_stride;
+    jobs.flat_blocks   = flat_blocks;
+    jobs.block_size    = block_size;
+    jobs.num_blocks_w  = num_blocks_w;
+    jobs.num_blocks_h  = num_blocks_h;
+    jobs.n             = n;
+    jobs.recp_sqr_norm = 1 / (normalization * normalization);
+    jobs.band_doubles  = n * n + n + (noise_model->n + 1) + n;
+
+    EB_MALLOC_ALIGNED(jobs.band_eqns, sizeof(*jobs.band_eqns) * jobs.band_doubles * num_bands);
+
+    if (!jobs.band_eqns) {
+        SVT_ERROR("Unable to allocate buffer of size %d\n", sizeof(*jobs.band_eqns) * jobs.band_doubles * num_bands);
+        return 0;
+    }
+
+    jobs.band_num_observations = (int32_t *)malloc(sizeof(*jobs.band_num_observations) * num_bands);
+
+    if (!jobs.band_num_observations) {
+        EB_FREE_ALIGNED(jobs.band_eqns);
+        SVT_ERROR("Unable to allocate buffer of size %d\n", sizeof(*jobs.band_num_observations) * num_bands);
+        return 0;
+    }
+    memset(jobs.band_eqns, 0, sizeof(*jobs.band_eqns) * jobs.band_doubles * num_bands);
+
+    svt_job_pool_run(job_pool, add_band_observations, &jobs, num_bands);
+
+    // Sum the partial systems in band order so the result does not depend on
+    // how the bands were spread over the threads
+    for (int32_t band = 0; band < num_bands; ++band) {
+        const double *band_A = jobs.band_eqns + band * jobs.band_doubles;
+        const double *band_b = band_A + n * n;
+        for (int32_t i = 0; i < n * n; ++i) A[i] += band_A[i];
+        for (int32_t i = 0; i < n; ++i) b[i] += band_b[i];
+        noise_model->latest_state[c].num_observations += jobs.band_num_observations[band];
+    }
+    EB_FREE_ALIGNED(jobs.band_eqns);
+    free(jobs.band_num_observations);
     return 1;
 }
 
@@ -977,7 +1106,7 @@ static int32_t ar_equation_system_solve(AomNoiseState *state, int32_t is_chroma)
 AomNoiseStatus svt_aom_noise_model_update(AomNoiseModel *const noise_model, const uint8_t *const data[3],
                                           const uint8_t *const denoised[3], int32_t w, int32_t h, int32_t stride[3],
                                           int32_t chroma_sub_log2[2], const uint8_t *const flat_blocks,
-                                          int32_t block_size) {
+                                          int32_t block_size, SvtJobPool *job_pool) {
     const int32_t num_blocks_w = (w + block_size - 1) / block_size;
     const int32_t num_blocks_h = (h + block_size - 1) / block_size;
     //  int32_t y_model_different = 0;
@@ -1034,7 +1163,8 @@ AomNoiseStatus svt_aom_noise_model_update(AomNoiseModel *const noise_model, cons
                                     flat_blocks,
                                     block_size,
                                     num_blocks_w,
-                                    num_blocks_h)) {
+                                    num_blocks_h,
+                                    job_pool)) {
             SVT_ERROR("Adding block observation failed\n");
             return AOM_NOISE_STATUS_INTERNAL_ERROR;
         }
@@ -1964,97 +2094,146 @@ void svt_av1_apply_window_function_to_plane_c(int32_t y_size, int32_t x_size, fl
     }
 }
 
+typedef struct WienerDenoiseJobs {
+    const AomFlatBlockFinder *block_finder;
+    const uint8_t            *data;
+    int32_t                   w;
+    int32_t                   h;
+    int32_t                   stride;
+    const float              *window_function;
+    float                     noise_psd;
+    int32_t                   x_size;
+    int32_t                   y_size;
+    int32_t                   offsx;
+    int32_t                   offsy;
+    int32_t                   num_blocks_w;
+    float                    *result;
+    int32_t                   result_stride;
+    int32_t                   use_tx_chroma;
+    // Per thread scratch buffers
+    float                 *plane[SVT_JOBS_MAX_THREADS];
+    float                 *block[SVT_JOBS_MAX_THREADS];
+    double                *block_d[SVT_JOBS_MAX_THREADS];
+    double                *plane_d[SVT_JOBS_MAX_THREADS];
+    struct aom_noise_tx_t *tx_full[SVT_JOBS_MAX_THREADS];
+    struct aom_noise_tx_t *tx_chroma[SVT_JOBS_MAX_THREADS];
+} WienerDenoiseJobs;
+
+// Filters one row of blocks of the current block-set. The blocks of a block-set
+// do not overlap, so the rows write disjoint parts of the result.
+static void wiener_denoise_row(void *ctx, int32_t thread_idx, int32_t job) {
+    WienerDenoiseJobs     *jobs             = (WienerDenoiseJobs *)ctx;
+    const int32_t          by               = job - 1; // Pad the top boundary
+    const int32_t          x_size           = jobs->x_size;
+    const int32_t          y_size           = jobs->y_size;
+    const int32_t          pixels_per_block = x_size * y_size;
+    float                 *plane            = jobs->plane[thread_idx];
+    float                 *block            = jobs->block[thread_idx];
+    double                *block_d          = jobs->block_d[thread_idx];
+    double                *plane_d          = jobs->plane_d[thread_idx];
+    struct aom_noise_tx_t *tx = jobs->use_tx_chroma ? jobs->tx_chroma[thread_idx] : jobs->tx_full[thread_idx];
+
+    for (int32_t bx = -1; bx < jobs->num_blocks_w; ++bx) {
+        svt_aom_flat_block_finder_extract_block(jobs->block_finder,
+                                                jobs->data,
+                                                jobs->w,
+                                                jobs->h,
+                                                jobs->stride,
+                                                bx * x_size + jobs->offsx,
+                                                by * y_size + jobs->offsy,
+                                                plane_d,
+                                                block_d);
+        svt_av1_pointwise_multiply(jobs->window_function, plane, block, plane_d, block_d, pixels_per_block);
+        svt_aom_noise_tx_forward(tx, block);
+        svt_aom_noise_tx_filter(tx->block_size, tx->tx_block, jobs->noise_psd);
+        svt_aom_noise_tx_inverse(tx, block);
+
+        // Apply window function to the plane approximation (we will apply
+        // it to the sum of plane + block when composing the results).
+        float *result_ptr = jobs->result + ((by + 1) * y_size + jobs->offsy) * jobs->result_stride +
+            (bx + 1) * x_size + jobs->offsx;
+        svt_av1_apply_window_function_to_plane(
+            y_size, x_size, result_ptr, jobs->result_stride, block, plane, jobs->window_function);
+    }
+}
+
 int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w, int32_t h,
                                   int32_t stride[3], int32_t chroma_sub[2], float noise_psd[3], int32_t block_size,
-                                  int32_t bit_depth, int32_t use_highbd) {
-    const float *window_full = NULL, *window_chroma = NULL;
-    float       *plane = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block                          = NULL;
-    double                *block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full       = NULL;
-    struct aom_noise_tx_t *tx_chroma     = NULL;
-    const int32_t          num_blocks_w  = (w + block_size - 1) / block_size;
-    const int32_t          num_blocks_h  = (h + block_size - 1) / block_size;
-    const int32_t          result_stride = (num_blocks_w + 2) * block_size;
-    const int32_t          result_height = (num_blocks_h + 2) * block_size;
-    float                 *result        = NULL;
-    int32_t                init_success  = 1;
-    AomFlatBlockFinder     block_finder_full;
-    AomFlatBlockFinder     block_finder_chroma;
-    const float            k_block_normalization = (float)((1 << bit_depth) - 1);
+                                  int32_t bit_depth, int32_t use_highbd, SvtJobPool *job_pool) {
+    const float       *window_full = NULL, *window_chroma = NULL;
+    const int32_t      num_blocks_w  = (w + block_size - 1) / block_size;
+    const int32_t      num_blocks_h  = (h + block_size - 1) / block_size;
+    const int32_t      result_stride = (num_blocks_w + 2) * block_size;
+    const int32_t      result_height = (num_blocks_h + 2) * block_size;
+    float             *result        = NULL;
+    int32_t            init_success  = 1;
+    AomFlatBlockFinder block_finder_full;
+    AomFlatBlockFinder block_finder_chroma;
+    WienerDenoiseJobs  jobs;
+    const float        k_block_normalization = (float)((1 << bit_depth) - 1);
     if (chroma_sub[0] != chroma_sub[1]) {
         SVT_ERROR(
             "svt_aom_wiener_denoise_2d doesn't handle different chroma "
             "subsampling");
         return 0;
     }
+    // The block-set rows (plus the padding row above the frame) are the jobs
+    const int32_t thread_count = svt_job_pool_thread_count(job_pool, num_blocks_h + 1);
     init_success &= svt_aom_flat_block_finder_init(&block_finder_full, block_size, bit_depth, use_highbd);
     result      = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
-    plane       = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block       = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d     = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d     = (double *)malloc(block_size * block_size * sizeof(*plane_d));
     window_full = get_half_cos_window(block_size);
-    tx_full     = svt_aom_noise_tx_malloc(block_size);
+    for (int32_t t = 0; t < thread_count; ++t) {
+        jobs.plane[t]   = (float *)malloc(block_size * block_size * sizeof(*jobs.plane[t]));
+        jobs.block[t]   = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*jobs.block[t]));
+        jobs.block_d[t] = (double *)malloc(block_size * block_size * sizeof(*jobs.block_d[t]));
+        jobs.plane_d[t] = (double *)malloc(block_size * block_size * sizeof(*jobs.plane_d[t]));
+        jobs.tx_full[t] = svt_aom_noise_tx_malloc(block_size);
+        init_success &= (int32_t)((jobs.tx_full[t] != NULL) && (jobs.plane[t] != NULL) &&
+                                  (jobs.plane_d[t] != NULL) && (jobs.block[t] != NULL) &&
+                                  (jobs.block_d[t] != NULL));
+    }
 
     if (chroma_sub[0] != 0) {
         init_success &= svt_aom_flat_block_finder_init(
             &block_finder_chroma, block_size >> chroma_sub[0], bit_depth, use_highbd);
         window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma     = svt_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
+        for (int32_t t = 0; t < thread_count; ++t) {
+            jobs.tx_chroma[t] = svt_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
+            init_success &= (int32_t)(jobs.tx_chroma[t] != NULL);
+        }
     } else {
         window_chroma = window_full;
-        tx_chroma     = tx_full;
+        for (int32_t t = 0; t < thread_count; ++t) jobs.tx_chroma[t] = jobs.tx_full[t];
     }
 
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) && (plane_d != NULL) &&
-                              (block != NULL) && (block_d != NULL) && (window_full != NULL) &&
-                              (window_chroma != NULL) && (result != NULL));
+    init_success &= (int32_t)((window_full != NULL) && (window_chroma != NULL) && (result != NULL));
     for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
-        const float           *window_function = c == 0 ? window_full : window_chroma;
-        AomFlatBlockFinder    *block_finder    = &block_finder_full;
-        const int32_t          chroma_sub_h    = c > 0 ? chroma_sub[1] : 0;
-        const int32_t          chroma_sub_w    = c > 0 ? chroma_sub[0] : 0;
-        struct aom_noise_tx_t *tx              = (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
+        const int32_t chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
+        const int32_t chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
         if (!data[c] || !denoised[c])
             continue;
-        if (c > 0 && chroma_sub[0] != 0)
-            block_finder = &block_finder_chroma;
+        jobs.block_finder    = (c > 0 && chroma_sub[0] != 0) ? &block_finder_chroma : &block_finder_full;
+        jobs.data            = data[c];
+        jobs.w               = w >> chroma_sub_w;
+        jobs.h               = h >> chroma_sub_h;
+        jobs.stride          = stride[c];
+        jobs.window_function = c == 0 ? window_full : window_chroma;
+        jobs.noise_psd       = noise_psd[c];
+        jobs.x_size          = block_size >> chroma_sub_w;
+        jobs.y_size          = block_size >> chroma_sub_h;
+        jobs.num_blocks_w    = num_blocks_w;
+        jobs.result          = result;
+        jobs.result_stride   = result_stride;
+        jobs.use_tx_chroma   = c > 0 && chroma_sub[0] > 0;
         memset(result, 0, sizeof(*result) * result_stride * result_height);
-        // Do overlapped block processing (half overlapped). The block rows can
-        // easily be done in parallel
-        for (int32_t offsy = 0; offsy < (block_size >> chroma_sub_h); offsy += (block_size >> chroma_sub_h) / 2) {
-            for (int32_t offsx = 0; offsx < (block_size >> chroma_sub_w); offsx += (block_size >> chroma_sub_w) / 2) {
-                // Pad the boundary when processing each block-set.
-                for (int32_t by = -1; by < num_blocks_h; ++by) {
-                    for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
-                        const int32_t pixels_per_block = (block_size >> chroma_sub_w) * (block_size >> chroma_sub_h);
-                        svt_aom_flat_block_finder_extract_block(block_finder,
-                                                                data[c],
-                                                                w >> chroma_sub_w,
-                                                                h >> chroma_sub_h,
-                                                                stride[c],
-                                                                bx * (block_size >> chroma_sub_w) + offsx,
-                                                                by * (block_size >> chroma_sub_h) + offsy,
-                                                                plane_d,
-                                                                block_d);
-                        svt_av1_pointwise_multiply(window_function, plane, block, plane_d, block_d, pixels_per_block);
-                        svt_aom_noise_tx_forward(tx, block);
-                        svt_aom_noise_tx_filter(tx->block_size, tx->tx_block, noise_psd[c]);
-                        svt_aom_noise_tx_inverse(tx, block);
-
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-
-                        const int y_size  = (block_size >> chroma_sub_h);
-                        const int x_size  = (block_size >> chroma_sub_w);
-                        float *result_ptr = result + ((by + 1) * y_size + offsy) * result_stride + (bx + 1) * x_size +
-                            offsx;
-                        svt_av1_apply_window_function_to_plane(
-                            y_size, x_size, result_ptr, result_stride, block, plane, window_function);
-                    }
-                }
+        // Do overlapped block processing (half overlapped). The block rows of
+        // each block-set are done in parallel, the block-sets are accumulated
+        // one after the other so the result does not depend on the thread count.
+        for (int32_t offsy = 0; offsy < jobs.y_size; offsy += jobs.y_size / 2) {
+            for (int32_t offsx = 0; offsx < jobs.x_size; offsx += jobs.x_size / 2) {
+                jobs.offsx = offsx;
+                jobs.offsy = offsy;
+                svt_job_pool_run(job_pool, wiener_denoise_row, &jobs, num_blocks_h + 1);
             }
         }
         if (use_highbd) {
@@ -2082,18 +2261,19 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
         }
     }
     free(result);
-    free(plane);
-    svt_aom_free(block);
-    free(plane_d);
-    free(block_d);
-
-    svt_aom_noise_tx_free(tx_full);
+    for (int32_t t = 0; t < thread_count; ++t) {
+        free(jobs.plane[t]);
+        svt_aom_free(jobs.block[t]);
+        free(jobs.plane_d[t]);
+        free(jobs.block_d[t]);
+        svt_aom_noise_tx_free(jobs.tx_full[t]);
+        if (chroma_sub[0] != 0)
+            svt_aom_noise_tx_free(jobs.tx_chroma[t]);
+    }
 
     svt_aom_flat_block_finder_free(&block_finder_full);
-    if (chroma_sub[0] != 0) {
+    if (chroma_sub[0] != 0)
         svt_aom_flat_block_finder_free(&block_finder_chroma);
-        svt_aom_noise_tx_free(tx_chroma);
-    }
     return init_success;
 }
 
@@ -2155,6 +2335,7 @@ EbErrorType svt_aom_denoise_and_model_ctor(AomDenoiseAndModel *object_ptr, EbPtr
     }
 
     object_ptr->denoise_apply = init_data_ptr->denoise_apply;
+    object_ptr->job_pool      = init_data_ptr->job_pool;
 
     return return_error;
 }
@@ -2304,7 +2485,7 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
     const uint8_t *const data[3] = {raw_data[0], raw_data[1], raw_data[2]};
 
     svt_aom_flat_block_finder_run(
-        &ctx->flat_block_finder, data[0], sd->width, sd->height, strides[0], ctx->flat_blocks);
+        &ctx->flat_block_finder, data[0], sd->width, sd->height, strides[0], ctx->flat_blocks, ctx->job_pool);
 
     if (!svt_aom_wiener_denoise_2d(data,
                                    ctx->denoised,
@@ -2315,7 +2496,8 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
                                    ctx->noise_psd,
                                    block_size,
                                    ctx->bit_depth,
-                                   use_highbd)) {
+                                   use_highbd,
+                                   ctx->job_pool)) {
         SVT_ERROR("Unable to denoise image\n");
         return 0;
     }
@@ -2328,7 +2510,8 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
                                                              strides,
                                                              chroma_sub_log2,
                                                              ctx->flat_blocks,
-                                                             block_size);
+                                                             block_size,
+                                                             ctx->job_pool);
 
     int32_t have_noise_estimate = 0;
     if (status == AOM_NOISE_STATUS_OK || status == AOM_NOISE_STATUS_DIFFERENT_NOISE_TYPE) {
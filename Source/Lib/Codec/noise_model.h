@@ -20,6 +20,7 @@ extern "C" {
 #include "grainSynthesis.h"
 #include "pic_buffer_desc.h"
 #include "object.h"
+#include "svt_threads.h"
 
 #define DENOISING_BlockSize 32
 
@@ -139,10 +140,11 @@ void svt_aom_flat_block_finder_extract_block_c(const AomFlatBlockFinder *block_f
      * Find flat blocks in the input image data. Returns a map of
      * flat_blocks, where the value of flat_blocks map will be non-zero
      * when a block is determined to be flat. A higher value indicates a bigger
-     * confidence in the decision.
+     * confidence in the decision. The block rows are scored on the workers
+     * of job_pool, or on the calling thread when it is NULL.
      */
 int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w,
-                                      int32_t h, int32_t stride, uint8_t *flat_blocks);
+                                      int32_t h, int32_t stride, uint8_t *flat_blocks, SvtJobPool *job_pool);
 
 // The noise shape indicates the allowed coefficients in the AR model.
 typedef enum { AOM_NOISE_SHAPE_DIAMOND = 0, AOM_NOISE_SHAPE_SQUARE = 1 } AomNoiseShape;
@@ -203,12 +205,13 @@ typedef struct DenoiseAndModelInitData {
     uint32_t encoder_bit_depth;
     uint32_t encoder_color_format;
 
-    uint16_t width;
-    uint16_t height;
-    uint16_t stride_y;
-    uint16_t stride_cb;
-    uint16_t stride_cr;
-    uint8_t  denoise_apply;
+    uint16_t    width;
+    uint16_t    height;
+    uint16_t    stride_y;
+    uint16_t    stride_cb;
+    uint16_t    stride_cr;
+    uint8_t     denoise_apply;
+    SvtJobPool *job_pool; // Workers denoising and modelling a picture, may be NULL
 } DenoiseAndModelInitData;
 
 typedef struct AomDenoiseAndModel {
@@ -236,6 +239,7 @@ typedef struct AomDenoiseAndModel {
     AomFlatBlockFinder flat_block_finder;
     AomNoiseModel      noise_model;
     uint8_t            denoise_apply;
+    SvtJobPool        *job_pool;
 } AomDenoiseAndModel;
 
 /************************************
@@ -270,11 +274,14 @@ void    svt_aom_noise_model_free(AomNoiseModel *model);
      * \param[in]     chroma_sub_log2 Chroma subsampling for planes != 0.
      * \param[in]     flat_blocks     A map to blocks that have been determined flat
      * \param[in]     block_size      The size of blocks.
+     * \param[in]     job_pool        Workers gathering the observations, may
+     *                                be NULL. The estimate does not depend
+     *                                on the number of workers.
      */
 AomNoiseStatus svt_aom_noise_model_update(AomNoiseModel *const noise_model, const uint8_t *const data[3],
                                           const uint8_t *const denoised[3], int32_t w, int32_t h, int32_t strides[3],
                                           int32_t chroma_sub_log2[2], const uint8_t *const flat_blocks,
-                                          int32_t block_size);
+                                          int32_t block_size, SvtJobPool *job_pool);
 
 /*\brief Save the "latest" estimate into the "combined" estimate.
      *
@@ -307,10 +314,13 @@ int32_t svt_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_mode
      * \param[in]     use_highbd      If true, uint8 pointers are interpreted as
      *                                uint16 and stride is measured in uint16.
      *                                This must be true when bit_depth >= 10.
+     * \param[in]     job_pool        Workers filtering the block rows, may be
+     *                                NULL. The output does not depend on the
+     *                                number of workers.
      */
 int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w, int32_t h,
                                   int32_t stride[3], int32_t chroma_sub_log2[2], float noise_psd[3], int32_t block_size,
-                                  int32_t bit_depth, int32_t use_highbd);
+                                  int32_t bit_depth, int32_t use_highbd, SvtJobPool *job_pool);
 
 struct AomDenoiseAndModel;
 
@@ -26,6 +26,7 @@
 #include "restoration.h" // RDCOST_DBL
 #include "rc_process.h"
 #include "enc_mode_config.h"
+#include "resize.h"
 
 #define RDCOST_DBL_WITH_NATIVE_BD_DIST(RM, R, D, BD) RDCOST_DBL((RM), (R), (double)((D) >> (2 * (BD - 8))))
 
@@ -50,12 +51,12 @@ typedef struct PacketizationContext {
     uint64_t     dpb_disp_order[8], dpb_dec_order[8];
     uint64_t     tot_shown_frames;
     uint64_t     disp_order_continuity_count;
+    SvtJobPool  *resize_job_pool; // Workers scaling the pictures of the superres recode loops
 } PacketizationContext;
 
 static Bool is_passthrough_data(EbLinkedListNode *data_node) { return data_node->passthrough; }
 void        free_temporal_filtering_buffer(PictureControlSet *pcs, SequenceControlSet *scs);
 void        svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs);
-void        svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSet *pcs);
 void        pad_ref_and_set_flags(PictureControlSet *pcs, SequenceControlSet *scs);
 void        svt_aom_update_rc_counts(PictureParentControlSet *ppcs);
 EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory);
@@ -73,6 +74,7 @@ static void packetization_context_dctor(EbPtr p) {
     EbThreadContext      *thread_ctx = (EbThreadContext *)p;
     PacketizationContext *obj        = (PacketizationContext *)thread_ctx->priv;
     EB_FREE_ARRAY(obj->pps_config);
+    EB_DELETE(obj->resize_job_pool);
     EB_FREE_ARRAY(obj);
 }
 
@@ -94,7 +96,7 @@ EbErrorType svt_aom_packetization_context_ctor(EbThreadContext *thread_ctx, cons
         enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
     EB_MALLOC_ARRAY(context_ptr->pps_config, 1);
 
-    return EB_ErrorNone;
+    return svt_aom_create_resize_job_pool(&context_ptr->resize_job_pool, enc_handle_ptr->scs_instance_array[0]->scs);
 }
 static inline int get_reorder_queue_pos(const EncodeContext *enc_ctx, int delta) {
     return (enc_ctx->packetization_reorder_queue_head_index + delta) % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH;
@@ -309,46 +311,64 @@ static void collect_frames_info(PacketizationContext *context_ptr, const EncodeC
 // a tu start with a td, + 0 more not displable frame, + 1 display frame
 static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_bytes,
                              EbBufferHeaderType *output_stream_ptr) {
-    total_bytes += TD_SIZE;
+    // With tile group output, the td went out with the first tile group of the frame
+    const uint32_t td_size = get_reorder_queue_entry(enc_ctx, 0)->tile_group_sent ? 0 : TD_SIZE;
+    EbErrorType    return_error = EB_ErrorNone;
+    total_bytes += td_size;
     if (total_bytes > output_stream_ptr->n_alloc_len) {
-        uint8_t *pbuff;
-        EB_MALLOC(pbuff, total_bytes);
+        uint8_t *pbuff = svt_aom_out_buffer_alloc(&enc_ctx->out_buffer_allocator, total_bytes);
         if (!pbuff) {
-            SVT_ERROR("failed to allocate more memory in encode_tu");
-            return EB_ErrorInsufficientResources;
+            // keep walking the frames below so the undisplayed queue stays consistent
+            SVT_ERROR("failed to allocate more memory in encode_tu\n");
+            output_stream_ptr->flags |= EB_BUFFERFLAG_ERROR_MASK;
+            return_error = EB_ErrorInsufficientResources;
+        } else {
+            if (output_stream_ptr->p_buffer)
+                EB_MEMCPY(pbuff,
+                          output_stream_ptr->p_buffer,
+                          output_stream_ptr->n_alloc_len > total_bytes ? total_bytes
+                                                                       : output_stream_ptr->n_alloc_len);
+            svt_aom_out_buffer_free(&enc_ctx->out_buffer_allocator, &output_stream_ptr->p_buffer);
+            output_stream_ptr->p_buffer    = pbuff;
+            output_stream_ptr->n_alloc_len = total_bytes;
         }
-        EB_MEMCPY(pbuff,
-                  output_stream_ptr->p_buffer,
-                  output_stream_ptr->n_alloc_len > total_bytes ? total_bytes : output_stream_ptr->n_alloc_len);
-        EB_FREE(output_stream_ptr->p_buffer);
-        output_stream_ptr->p_buffer    = pbuff;
-        output_stream_ptr->n_alloc_len = total_bytes;
     }
-    uint8_t *dst = output_stream_ptr->p_buffer + total_bytes;
+    uint8_t *dst = return_error == EB_ErrorNone ? output_stream_ptr->p_buffer + total_bytes : NULL;
     // we use last frame's output_stream_ptr to hold entire tu, so we need copy backward.
     for (int i = frames - 1; i >= 0; i--) {
         PacketizationReorderEntry *queue_entry_ptr = get_reorder_queue_entry(enc_ctx, i);
         EbObjectWrapper           *wrapper         = queue_entry_ptr->output_stream_wrapper_ptr;
         EbBufferHeaderType        *src_stream_ptr  = (EbBufferHeaderType *)wrapper->object_ptr;
         uint32_t                   size            = src_stream_ptr->n_filled_len;
-        dst -= size;
-        memmove(dst, src_stream_ptr->p_buffer, size);
+        if (dst) {
+            dst -= size;
+            if (size)
+                memmove(dst, src_stream_ptr->p_buffer, size);
+        }
+        // a frame whose packet could not be allocated fails the whole tu
+        output_stream_ptr->flags |= src_stream_ptr->flags & EB_BUFFERFLAG_ERROR_MASK;
         // 1. The last frame is a displayable frame, others are undisplayed.
         // 2. We do not push alt ref frame since the overlay frame will carry the pts.
         // 3. Release alt ref stream buffer here for it will not be sent out
         if (i != frames - 1 && !queue_entry_ptr->is_alt_ref)
             push_undisplayed_frame(enc_ctx, wrapper);
         else if (queue_entry_ptr->is_alt_ref) {
-            EB_FREE(src_stream_ptr->p_buffer);
+            svt_aom_out_buffer_free(&enc_ctx->out_buffer_allocator, &src_stream_ptr->p_buffer);
             svt_release_object(wrapper);
         }
     }
     if (frames > 1)
         sort_undisplayed_frame(enc_ctx);
-    dst -= TD_SIZE;
-    svt_aom_encode_td_av1(dst);
+    if (return_error != EB_ErrorNone) {
+        output_stream_ptr->n_filled_len = 0;
+        return return_error;
+    }
     output_stream_ptr->n_filled_len = total_bytes;
-    output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    if (td_size) {
+        dst -= TD_SIZE;
+        svt_aom_encode_td_av1(dst);
+        output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+    }
     return EB_ErrorNone;
 }
 
@@ -370,6 +390,9 @@ static EbErrorType copy_data_from_bitstream(EncodeContext *enc_ctx, Bitstream *b
 
 static void encode_show_existing(EncodeContext *enc_ctx, PacketizationReorderEntry *queue_entry_ptr,
                                  EbBufferHeaderType *output_stream_ptr) {
+    // the frame packet could not be allocated, it already carries the error
+    if (!output_stream_ptr->p_buffer)
+        return;
     uint8_t *dst = output_stream_ptr->p_buffer;
 
     svt_aom_encode_td_av1(dst);
@@ -446,10 +469,18 @@ inline static void set_eos_flag(EbBufferHeaderType *output_stream_ptr) {
     output_stream_ptr->flags |= EB_BUFFERFLAG_EOS;
 }
 
-/* Wrapper function to capture the return of EB_MALLOC */
-static inline EbErrorType malloc_p_buffer(EbBufferHeaderType *output_stream_ptr) {
-    EB_MALLOC(output_stream_ptr->p_buffer, output_stream_ptr->n_alloc_len);
-    return EB_ErrorNone;
+/* Packet buffer of a frame, from the caller allocator when one is set. On failure the packet is
+ * flagged with EB_BUFFERFLAG_ERROR_MASK and left empty */
+static inline EbErrorType malloc_p_buffer(EncodeContext *enc_ctx, EbBufferHeaderType *output_stream_ptr) {
+    output_stream_ptr->p_buffer = svt_aom_out_buffer_alloc(&enc_ctx->out_buffer_allocator,
+                                                           output_stream_ptr->n_alloc_len);
+    if (output_stream_ptr->p_buffer)
+        return EB_ErrorNone;
+    SVT_ERROR("failed to allocate a packet of %u bytes\n", output_stream_ptr->n_alloc_len);
+    output_stream_ptr->n_alloc_len  = 0;
+    output_stream_ptr->n_filled_len = 0;
+    output_stream_ptr->flags |= EB_BUFFERFLAG_ERROR_MASK;
+    return EB_ErrorInsufficientResources;
 }
 void update_firstpass_stats(PictureParentControlSet *pcs, const int frame_number, const double ts_duration,
                             StatStruct *stat_struct);
@@ -466,6 +497,159 @@ static EbErrorType realloc_output_bitstream(Bitstream *bitstream_ptr, uint32_t s
     }
     return EB_ErrorNone;
 }
+/* Sequence header and metadata OBUs that precede the frame header, returns the size of the metadata
+ * kept for the next shown frame */
+static size_t write_frame_prefix(EncodeContext *enc_ctx, SequenceControlSet *scs, PictureControlSet *pcs) {
+    FrameHeader *frm_hdr     = &pcs->ppcs->frm_hdr;
+    size_t       metadata_sz = 0;
+
+    if (frm_hdr->frame_type == KEY_FRAME) {
+        if (scs->static_config.mastering_display.max_luma)
+            svt_add_metadata(pcs->ppcs->input_ptr,
+                             EB_AV1_METADATA_TYPE_HDR_MDCV,
+                             (const uint8_t *)&scs->static_config.mastering_display,
+                             sizeof(scs->static_config.mastering_display));
+        if (scs->static_config.content_light_level.max_cll)
+            svt_add_metadata(pcs->ppcs->input_ptr,
+                             EB_AV1_METADATA_TYPE_HDR_CLL,
+                             (const uint8_t *)&scs->static_config.content_light_level,
+                             sizeof(scs->static_config.content_light_level));
+    }
+
+    // Code the SPS
+    if (frm_hdr->frame_type == KEY_FRAME) {
+        svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
+        // Add CLL and MDCV meta when frame is keyframe and SPS is written
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
+    }
+
+    if (frm_hdr->show_frame) {
+        // Add HDR10+ dynamic metadata when show frame flag is enabled
+        svt_aom_write_metadata_av1(pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+        svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
+    } else {
+        // Copy metadata pointer to the queue entry related to current frame number
+        uint64_t                   current_picture_number = pcs->picture_number;
+        PacketizationReorderEntry *temp_entry =
+            enc_ctx->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
+        temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
+        pcs->ppcs->input_ptr->metadata = NULL;
+        metadata_sz                    = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+    }
+    return metadata_sz;
+}
+
+/* Tile group output: write the headers ahead of the first tile group of the frame, then the tile group
+ * from the next tile to send to end_tile */
+static size_t write_tile_groups(EncodeContext *enc_ctx, SequenceControlSet *scs, PictureControlSet *pcs,
+                                uint16_t end_tile) {
+    size_t metadata_sz = 0;
+    if (!pcs->tile_group_next) {
+        metadata_sz = write_frame_prefix(enc_ctx, scs, pcs);
+        svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
+    }
+    svt_aom_write_tile_group_av1(pcs->bitstream_ptr, pcs, pcs->tile_group_next, end_tile);
+    pcs->tile_group_next = end_tile + 1;
+    return metadata_sz;
+}
+
+/* Tile group output: send the entropy coded tiles that follow the tiles already sent in a packet. The
+ * last tile is left to the packet of the frame, which carries EB_BUFFERFLAG_LAST_FRAGMENT */
+static void output_tile_groups(EncodeContext *enc_ctx, SequenceControlSet *scs, PictureControlSet *pcs) {
+    Av1Common *const cm       = pcs->ppcs->av1_cm;
+    const uint16_t   tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
+    uint16_t         end_tile = pcs->tile_group_next;
+    svt_block_on_mutex(pcs->entropy_coding_pic_mutex);
+    while (end_tile < tile_cnt - 1 && pcs->ec_info[end_tile]->entropy_coding_tile_done) end_tile++;
+    svt_release_mutex(pcs->entropy_coding_pic_mutex);
+    if (end_tile == pcs->tile_group_next)
+        return;
+
+    const Bool first = !pcs->tile_group_next;
+    svt_aom_bitstream_reset(pcs->bitstream_ptr);
+    write_tile_groups(enc_ctx, scs, pcs, end_tile - 1);
+
+    const uint32_t   size = (uint32_t)svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr);
+    EbObjectWrapper *output_stream_wrapper_ptr;
+    if (svt_get_empty_object(enc_ctx->stream_output_fifo_ptr, &output_stream_wrapper_ptr) != EB_ErrorNone) {
+        svt_aom_post_error_packet(enc_ctx);
+        return;
+    }
+    EbBufferHeaderType *output_stream_ptr = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
+    output_stream_ptr->n_alloc_len        = size + TD_SIZE;
+    output_stream_ptr->flags              = 0;
+    output_stream_ptr->n_filled_len       = 0;
+    if (malloc_p_buffer(enc_ctx, output_stream_ptr) == EB_ErrorNone) {
+        if (first) {
+            svt_aom_encode_td_av1(output_stream_ptr->p_buffer);
+            output_stream_ptr->n_filled_len = TD_SIZE;
+            output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
+        }
+        svt_aom_bitstream_copy(
+            pcs->bitstream_ptr, output_stream_ptr->p_buffer + output_stream_ptr->n_filled_len, size);
+        output_stream_ptr->n_filled_len += size;
+        pcs->tile_group_bytes += size;
+    }
+
+    output_stream_ptr->pts           = pcs->ppcs->input_ptr->pts;
+    output_stream_ptr->dts           = output_stream_ptr->pts;
+    output_stream_ptr->pic_type      = pcs->ppcs->is_ref
+             ? pcs->ppcs->idr_flag ? EB_AV1_KEY_PICTURE : (EbAv1PictureType)pcs->slice_type
+             : EB_AV1_NON_REF_PICTURE;
+    output_stream_ptr->p_app_private = NULL;
+    output_stream_ptr->n_tick_count  = 0;
+    output_stream_ptr->qp            = pcs->ppcs->picture_qp;
+    output_stream_ptr->luma_sse      = 0;
+    output_stream_ptr->cr_sse        = 0;
+    output_stream_ptr->cb_sse        = 0;
+    output_stream_ptr->luma_ssim     = 0;
+    output_stream_ptr->cr_ssim       = 0;
+    output_stream_ptr->cb_ssim       = 0;
+    svt_post_full_object(output_stream_wrapper_ptr);
+}
+
+/* Report the statistics of the picture to picture_stats_cb, stage_time_us holds the stage boundaries
+ * of the picture, the last one being the end of its entropy coding */
+static void report_picture_stats(const SequenceControlSet *scs, const PictureControlSet *pcs,
+                                 const uint64_t *stage_time_us) {
+    const PictureParentControlSet *ppcs = pcs->ppcs;
+    const uint64_t                 offset = scs->enc_ctx->checkpoint_ctrl.picture_offset;
+    SvtAv1PictureStats             stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.picture_number = svt_aom_stream_picture_number(ppcs);
+    stats.decode_order   = ppcs->decode_order;
+    stats.pts            = ppcs->input_ptr->pts;
+    stats.pic_type       = ppcs->is_ref ? ppcs->idr_flag ? EB_AV1_KEY_PICTURE : (EbAv1PictureType)pcs->slice_type
+                                        : EB_AV1_NON_REF_PICTURE;
+    stats.temporal_layer = ppcs->temporal_layer_index;
+    stats.show_frame     = ppcs->frm_hdr.show_frame;
+    stats.is_overlay     = ppcs->is_overlay;
+    stats.enc_mode       = ppcs->enc_mode;
+    stats.qindex         = ppcs->frm_hdr.quantization_params.base_q_idx;
+    stats.qp             = ppcs->picture_qp;
+    stats.recode_count   = ppcs->recode_count;
+    stats.tpl_valid      = ppcs->tpl_is_valid;
+    stats.bits           = ppcs->total_num_bits;
+    stats.target_bits    = scs->static_config.rate_control_mode != SVT_AV1_RC_MODE_CQP_OR_CRF ? ppcs->this_frame_target
+                                                                                               : 0;
+    stats.tpl_r0         = ppcs->tpl_is_valid ? ppcs->r0 : 0;
+    stats.me_distortion  = ppcs->norm_me_dist;
+    if (pcs->slice_type != I_SLICE) {
+        stats.ref_count[REF_LIST_0] = MIN(ppcs->ref_list0_count, REF_LIST_MAX_DEPTH);
+        stats.ref_count[REF_LIST_1] = MIN(ppcs->ref_list1_count, REF_LIST_MAX_DEPTH);
+        for (int list = REF_LIST_0; list <= REF_LIST_1; list++)
+            for (int i = 0; i < stats.ref_count[list]; i++)
+                stats.ref_picture_number[list][i] = ppcs->ref_pic_poc_array[list][i] + offset;
+    }
+    const uint64_t end_us = stage_time_us[SVT_AV1_DEADLINE_STAGES];
+    stats.latency_us      = end_us > stage_time_us[0] ? end_us - stage_time_us[0] : 0;
+    for (int s = 0; s < SVT_AV1_DEADLINE_STAGES; s++)
+        if (stage_time_us[s + 1] > stage_time_us[s])
+            stats.stage_us[s] = stage_time_us[s + 1] - stage_time_us[s];
+    scs->static_config.picture_stats_cb(&stats, scs->static_config.picture_stats_user_data);
+}
+
 void *svt_aom_packetization_kernel(void *input_ptr) {
     // Context
     EbThreadContext      *thread_ctx  = (EbThreadContext *)input_ptr;
@@ -495,6 +679,14 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         uint16_t                 tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
         PictureParentControlSet *ppcs     = (PictureParentControlSet *)pcs->ppcs;
 
+        if (entropy_coding_results_ptr->tiles_ready) {
+            // Tile group output: the tiles of the frame go out once the previous frames are out
+            if (get_reorder_queue_entry(enc_ctx, 0)->picture_number == ppcs->decode_order)
+                output_tile_groups(enc_ctx, scs, pcs);
+            svt_release_object(entropy_coding_results_wrapper_ptr);
+            continue;
+        }
+
         if (ppcs->superres_total_recode_loop > 0 && ppcs->superres_recode_loop < ppcs->superres_total_recode_loop) {
             // Reset the Bitstream before writing to it
             svt_aom_bitstream_reset(pcs->bitstream_ptr);
@@ -558,7 +750,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                 }
 
                 if (do_recode) {
-                    svt_aom_init_resize_picture(scs, ppcs);
+                    ppcs->recode_count++;
+                    svt_aom_init_resize_picture(scs, ppcs, context_ptr->resize_job_pool);
 
                     // reset gm based on super-res on/off
                     bool super_res_off = ppcs->frame_superres_enabled == FALSE &&
@@ -584,8 +777,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                     for (uint32_t segment_index = 0; segment_index < ppcs->me_segments_total_count; ++segment_index) {
                         // Get Empty Results Object
                         EbObjectWrapper *out_results_wrapper;
-                        svt_get_empty_object(context_ptr->picture_decision_results_output_fifo_ptr,
-                                             &out_results_wrapper);
+                        EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->picture_decision_results_output_fifo_ptr,
+                                            &out_results_wrapper);
 
                         PictureDecisionResults *out_results = (PictureDecisionResults *)out_results_wrapper->object_ptr;
                         out_results->pcs_wrapper            = ppcs->p_pcs_wrapper_ptr;
@@ -653,7 +846,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                     PictureDemuxResults *picture_demux_results_rtr;
 
                     // Get Empty PicMgr Results
-                    svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
+                    EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->picture_demux_fifo_ptr,
+                                        &picture_demux_results_wrapper_ptr);
 
                     picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
                     picture_demux_results_rtr->ref_pic_wrapper = ppcs->ref_pic_wrapper;
@@ -697,24 +891,13 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         queue_entry_ptr->start_time_seconds          = pcs->ppcs->start_time_seconds;
         queue_entry_ptr->start_time_u_seconds        = pcs->ppcs->start_time_u_seconds;
         queue_entry_ptr->is_alt_ref                  = pcs->ppcs->is_alt_ref;
-        svt_get_empty_object(scs->enc_ctx->stream_output_fifo_ptr, &pcs->ppcs->output_stream_wrapper_ptr);
+        EB_GET_EMPTY_OBJECT(scs->enc_ctx, scs->enc_ctx->stream_output_fifo_ptr, &pcs->ppcs->output_stream_wrapper_ptr);
         EbObjectWrapper    *output_stream_wrapper_ptr = pcs->ppcs->output_stream_wrapper_ptr;
         EbBufferHeaderType *output_stream_ptr         = (EbBufferHeaderType *)output_stream_wrapper_ptr->object_ptr;
 
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            if (scs->static_config.mastering_display.max_luma)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_MDCV,
-                                 (const uint8_t *)&scs->static_config.mastering_display,
-                                 sizeof(scs->static_config.mastering_display));
-            if (scs->static_config.content_light_level.max_cll)
-                svt_add_metadata(pcs->ppcs->input_ptr,
-                                 EB_AV1_METADATA_TYPE_HDR_CLL,
-                                 (const uint8_t *)&scs->static_config.content_light_level,
-                                 sizeof(scs->static_config.content_light_level));
-        }
-
         output_stream_ptr->flags = 0;
+        if (scs->static_config.tile_group_output)
+            output_stream_ptr->flags |= EB_BUFFERFLAG_LAST_FRAGMENT;
 #if !OPT_LD_LATENCY2
         if (pcs->ppcs->end_of_sequence_flag) {
             output_stream_ptr->flags |= EB_BUFFERFLAG_EOS;
@@ -747,7 +930,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         }
 
         // Get Empty Rate Control Input Tasks
-        svt_get_empty_object(context_ptr->rate_control_tasks_output_fifo_ptr, &rate_control_tasks_wrapper_ptr);
+        EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->rate_control_tasks_output_fifo_ptr,
+                            &rate_control_tasks_wrapper_ptr);
         RateControlTasks *rc_tasks = (RateControlTasks *)rate_control_tasks_wrapper_ptr->object_ptr;
         rc_tasks->pcs_wrapper      = pcs->ppcs_wrapper;
         rc_tasks->task_type        = RC_PACKETIZATION_FEEDBACK_RESULT;
@@ -765,7 +949,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                 }
             }
             // Get Empty Results Object
-            svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_manager_results_wrapper_ptr);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->picture_demux_fifo_ptr,
+                                &picture_manager_results_wrapper_ptr);
 
             PictureDemuxResults *picture_manager_results_ptr = (PictureDemuxResults *)
                                                                    picture_manager_results_wrapper_ptr->object_ptr;
@@ -777,42 +962,20 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         // Reset the Bitstream before writing to it
         svt_aom_bitstream_reset(pcs->bitstream_ptr);
 
-        size_t metadata_sz = 0;
-
-        // Code the SPS
-        if (frm_hdr->frame_type == KEY_FRAME) {
-            svt_aom_encode_sps_av1(pcs->bitstream_ptr, scs);
-            // Add CLL and MDCV meta when frame is keyframe and SPS is written
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_CLL);
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_HDR_MDCV);
-        }
-
-        if (frm_hdr->show_frame) {
-            // Add HDR10+ dynamic metadata when show frame flag is enabled
-            svt_aom_write_metadata_av1(
-                pcs->bitstream_ptr, pcs->ppcs->input_ptr->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
-            svt_metadata_array_free(&pcs->ppcs->input_ptr->metadata);
-        } else {
-            // Copy metadata pointer to the queue entry related to current frame number
-            uint64_t                   current_picture_number = pcs->picture_number;
-            PacketizationReorderEntry *temp_entry =
-                enc_ctx->packetization_reorder_queue[current_picture_number % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH];
-            temp_entry->metadata           = pcs->ppcs->input_ptr->metadata;
-            pcs->ppcs->input_ptr->metadata = NULL;
-            metadata_sz                    = svt_metadata_size(temp_entry->metadata, EB_AV1_METADATA_TYPE_ITUT_T35);
+        size_t metadata_sz;
+        queue_entry_ptr->tile_group_sent = pcs->tile_group_next > 0;
+        if (scs->static_config.tile_group_output)
+            // The tiles not sent yet
+            metadata_sz = write_tile_groups(enc_ctx, scs, pcs, tile_cnt - 1);
+        else {
+            metadata_sz = write_frame_prefix(enc_ctx, scs, pcs);
+            svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
         }
 
-        svt_aom_write_frame_header_av1(pcs->bitstream_ptr, scs, pcs, 0);
-
         output_stream_ptr->n_alloc_len = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE +
                                                     metadata_sz);
-        malloc_p_buffer(output_stream_ptr);
-
-        assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
-
-        copy_data_from_bitstream(enc_ctx, pcs->bitstream_ptr, output_stream_ptr);
+        if (malloc_p_buffer(enc_ctx, output_stream_ptr) == EB_ErrorNone)
+            copy_data_from_bitstream(enc_ctx, pcs->bitstream_ptr, output_stream_ptr);
 
         if (pcs->ppcs->has_show_existing) {
             uint64_t                   next_picture_number = pcs->picture_number + 1;
@@ -835,7 +998,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         }
 
         // Send the number of bytes per frame to RC
-        pcs->ppcs->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        pcs->ppcs->total_num_bits = (uint64_t)(output_stream_ptr->n_filled_len + pcs->tile_group_bytes) << 3;
         if (scs->passes == 2 && scs->static_config.pass == ENC_FIRST_PASS) {
             StatStruct stat_struct;
             stat_struct.poc = pcs->picture_number;
@@ -893,13 +1056,23 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             enc_ctx->sc_frame_out++;
             svt_release_mutex(enc_ctx->sc_buffer_mutex);
         }
+        if (enc_ctx->deadline_ctrl.timed) {
+            PictureParentControlSet *ppcs = pcs->ppcs;
+            ppcs->deadline_time_us[SVT_AV1_DEADLINE_STAGES] = svt_av1_get_time_us();
+            if (enc_ctx->deadline_ctrl.enabled)
+                svt_aom_deadline_picture_done(&enc_ctx->deadline_ctrl,
+                                              ppcs->deadline_epoch,
+                                              ppcs->enc_mode,
+                                              ppcs->is_overlay,
+                                              ppcs->deadline_time_us);
+            if (scs->static_config.picture_stats_cb)
+                report_picture_stats(scs, pcs, ppcs->deadline_time_us);
+        }
         if (scs->enable_dec_order || (pcs->ppcs->is_ref == TRUE && pcs->ppcs->ref_pic_wrapper))
             // Post the Full Results Object
             svt_post_full_object(picture_manager_results_wrapper_ptr);
         // Post Rate Control Task. Be done after postig to PM as RC might release ppcs
         svt_post_full_object(rate_control_tasks_wrapper_ptr);
-        if (pcs->ppcs->frm_hdr.allow_intrabc)
-            svt_av1_hash_table_destroy(&pcs->hash_table);
         svt_release_object(pcs->ppcs->enc_dec_ptr->enc_dec_wrapper); // Child
         // Release the Parent PCS then the Child PCS
         assert(entropy_coding_results_ptr->pcs_wrapper->live_count == 1);
@@ -976,7 +1149,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
 #if OPT_LD_LATENCY2
         if (eos) {
             EbObjectWrapper *tmp_out_str_wrp;
-            svt_get_empty_object(scs->enc_ctx->stream_output_fifo_ptr, &tmp_out_str_wrp);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, scs->enc_ctx->stream_output_fifo_ptr, &tmp_out_str_wrp);
             EbBufferHeaderType *tmp_out_str = (EbBufferHeaderType *)tmp_out_str_wrp->object_ptr;
 
             tmp_out_str->flags        = EB_BUFFERFLAG_EOS;
@@ -50,6 +50,8 @@ typedef struct PacketizationReorderEntry {
     int64_t                  next_pts;
     uint8_t                  is_alt_ref;
     struct SvtMetadataArray *metadata;
+    // Tile group output: the TD, the headers and the first tiles went out ahead of the frame
+    Bool tile_group_sent;
 } PacketizationReorderEntry;
 
 extern EbErrorType svt_aom_packetization_reorder_entry_ctor(PacketizationReorderEntry *entry_ptr,
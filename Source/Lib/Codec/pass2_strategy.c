@@ -417,7 +417,7 @@ static int av1_calc_iframe_target_size_one_pass_cbr(PictureParentControlSet *pcs
     RATE_CONTROL *const rc      = &enc_ctx->rc;
     int                 target;
     const int           w = 3;
-    if (pcs->picture_number == 0) {
+    if (svt_aom_is_stream_start(pcs)) {
         target = ((rc->starting_buffer_level / 2) > INT_MAX) ? INT_MAX : (int)(rc->starting_buffer_level * w / 4);
     } else {
         int    kf_boost  = 32;
@@ -836,7 +836,8 @@ static int get_section_target_bandwidth(PictureParentControlSet *pcs) {
     TWO_PASS *const     twopass = &scs->twopass;
     RATE_CONTROL *const rc      = &enc_ctx->rc;
     int                 section_target_bandwidth;
-    const int           frames_left = (int)(twopass->stats_buf_ctx->total_stats->count - pcs->picture_number);
+    const int           frames_left = (int)(twopass->stats_buf_ctx->total_stats->count -
+                                        svt_aom_stream_picture_number(pcs));
     if (scs->lap_rc)
         section_target_bandwidth = (int)rc->avg_frame_bandwidth;
     else
@@ -850,7 +851,8 @@ static void process_first_pass_stats(PictureParentControlSet *pcs, FIRSTPASS_STA
     TWO_PASS *const             twopass = &scs->twopass;
     RATE_CONTROL *const         rc      = &enc_ctx->rc;
     const RateControlCfg *const rc_cfg  = &enc_ctx->rc_cfg;
-    if (pcs->picture_number == 0 && twopass->stats_buf_ctx->total_stats && twopass->stats_buf_ctx->total_left_stats) {
+    if (svt_aom_is_stream_start(pcs) && twopass->stats_buf_ctx->total_stats &&
+        twopass->stats_buf_ctx->total_left_stats) {
         if (scs->lap_rc) {
             /*
        * Accumulate total_stats using available limited number of stats,
@@ -1055,7 +1057,7 @@ void svt_aom_one_pass_rt_rate_alloc(PictureParentControlSet *pcs) {
         rc->kf_boost = DEFAULT_KF_BOOST_RT;
 
     if (frame_is_intra_only(pcs)) {
-        rc->this_key_frame_forced = pcs->picture_number != 0 && rc->frames_to_key == 0;
+        rc->this_key_frame_forced = !svt_aom_is_stream_start(pcs) && rc->frames_to_key == 0;
         rc->frames_to_key         = scs->static_config.intra_period_length + 1;
     }
 
@@ -131,7 +131,7 @@ static void picture_control_set_dctor(EbPtr p) {
     PictureControlSet *obj      = (PictureControlSet *)p;
     uint16_t           tile_cnt = obj->tile_row_count * obj->tile_column_count;
     uint8_t            depth;
-    svt_av1_hash_table_destroy(&obj->hash_table);
+    svt_av1_hash_index_destroy(&obj->hash_index);
     EB_FREE_ALIGNED_ARRAY(obj->tpl_mvs);
     EB_DELETE_PTR_ARRAY(obj->enc_dec_segment_ctrl, tile_cnt);
     EB_DELETE_PTR_ARRAY(obj->ep_luma_recon_na, tile_cnt);
@@ -183,6 +183,10 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->sb_skip);
     EB_FREE_ARRAY(obj->sb_64x64_mvp);
     EB_FREE_ARRAY(obj->sb_count_nz_coeffs);
+    EB_FREE_ARRAY(obj->sb_rate_ctrl.pred_rate);
+    EB_FREE_ARRAY(obj->sb_rate_ctrl.coded_rate);
+    EB_FREE_ARRAY(obj->sb_rate_ctrl.coded_base_rate);
+    EB_FREE_ARRAY(obj->sb_rate_ctrl.base_qindex);
     EB_FREE_ARRAY(obj->b64_me_qindex);
     EB_DELETE(obj->bitstream_ptr);
     EB_DELETE_PTR_ARRAY(obj->ec_info, tile_cnt);
@@ -475,7 +479,8 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     object_ptr->dctor = picture_control_set_dctor;
 
-    object_ptr->hash_table.p_lookup_table = NULL;
+    object_ptr->hash_index.table.p_lookup_table = NULL;
+    object_ptr->hash_index.luma                 = NULL;
 
     // Init Picture Init data
     uint16_t padding = init_data_ptr->sb_size + 32;
@@ -552,6 +557,12 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
     EB_ALLOC_PTR_ARRAY(object_ptr->sb_ptr_array, object_ptr->sb_total_count_unscaled);
 
     EB_MALLOC_ARRAY(object_ptr->sb_count_nz_coeffs, object_ptr->sb_total_count);
+    if (init_data_ptr->static_config.sb_rate_control) {
+        EB_MALLOC_ARRAY(object_ptr->sb_rate_ctrl.pred_rate, object_ptr->sb_total_count);
+        EB_MALLOC_ARRAY(object_ptr->sb_rate_ctrl.coded_rate, object_ptr->sb_total_count);
+        EB_MALLOC_ARRAY(object_ptr->sb_rate_ctrl.coded_base_rate, object_ptr->sb_total_count);
+        EB_MALLOC_ARRAY(object_ptr->sb_rate_ctrl.base_qindex, object_ptr->sb_total_count);
+    }
 
     for (sb_index = 0; sb_index < all_sb; ++sb_index) {
         EB_NEW(object_ptr->sb_ptr_array[sb_index],
@@ -1128,6 +1139,10 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
 
     if (obj->variance)
         EB_FREE_2D(obj->variance);
+    // a 16-bit view kept for temporal filtering when the encoder is torn down mid-stream
+    for (int c = 0; c < 3; c++)
+        if (obj->altref_buffer_highbd[c])
+            EB_FREE_ARRAY(obj->altref_buffer_highbd[c]);
 
     if (obj->picture_histogram) {
         for (int region_in_picture_width_index = 0; region_in_picture_width_index < MAX_NUMBER_OF_REGIONS_IN_WIDTH;
@@ -1173,6 +1188,7 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
     if (obj->frame_superres_enabled || obj->frame_resize_enabled) {
         EB_DELETE(obj->enhanced_downscaled_pic);
     }
+    for (int i = 0; i <= NUM_SR_SCALES; i++) EB_DELETE(obj->superres_recode_pics[i]);
     EB_DESTROY_SEMAPHORE(obj->tpl_disp_done_semaphore);
     EB_DESTROY_MUTEX(obj->tpl_disp_mutex);
     uint16_t tile_cnt = 1; /*obj->tile_row_count * obj->tile_column_count;*/
@@ -1271,6 +1287,8 @@ static EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *obje
     object_ptr->enhanced_pic            = (EbPictureBufferDesc *)NULL;
     object_ptr->enhanced_downscaled_pic = (EbPictureBufferDesc *)NULL;
     object_ptr->enhanced_unscaled_pic   = (EbPictureBufferDesc *)NULL;
+    for (int i = 0; i <= NUM_SR_SCALES; i++) object_ptr->superres_recode_pics[i] = (EbPictureBufferDesc *)NULL;
+    object_ptr->sb_rate_ctrl_base_ratio = 1.0;
 
     if (init_data_ptr->color_format >= EB_YUV422) {
         EbPictureBufferDescInitData input_pic_buf_desc_init_data;
@@ -1347,6 +1365,7 @@ static EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *obje
     EB_MALLOC_ARRAY(object_ptr->av1_cm, 1);
 
     EB_CREATE_MUTEX(object_ptr->pa_me_done.mutex);
+    svt_create_cond_var(&object_ptr->me_ready);
 
     EB_CREATE_SEMAPHORE(object_ptr->tpl_disp_done_semaphore, 0, 1);
     EB_CREATE_MUTEX(object_ptr->tpl_disp_mutex);
@@ -34,6 +34,7 @@
 #include "av1me.h"
 #include "hash_motion.h"
 #include "firstpass.h"
+#include "sb_rate_ctrl.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -253,6 +254,9 @@ typedef struct PictureControlSet {
     EbHandle          entropy_coding_pic_mutex;
     Bool              entropy_coding_pic_reset_flag;
     uint8_t           tile_size_bytes_minus_1;
+    // Tile group output: next tile to send, and bytes of the frame already sent
+    uint16_t          tile_group_next;
+    uint32_t          tile_group_bytes;
     EbHandle          intra_mutex;
     uint32_t          intra_coded_area;
     uint64_t          skip_coded_area;
@@ -293,6 +297,7 @@ typedef struct PictureControlSet {
     uint8_t     *sb_skip;
     uint8_t     *sb_64x64_mvp;
     uint32_t    *sb_count_nz_coeffs;
+    SbRateCtrl   sb_rate_ctrl;
     // qindex per 64x64 using ME distortions (to be used for lambda modulation only; not at Q/Q-1)
     // Mode Decision Neighbor Arrays
     uint8_t            *b64_me_qindex;
@@ -395,7 +400,7 @@ typedef struct PictureControlSet {
     SgrprojInfo      sgrproj_info[MAX_TILE_CNTS][MAX_MB_PLANE];
     SpeedFeatures    sf;
     SearchSiteConfig ss_cfg; // CHKN this might be a seq based
-    HashTable        hash_table;
+    HashIndex        hash_index;
     CRC_CALCULATOR   crc_calculator1;
     CRC_CALCULATOR   crc_calculator2;
 
@@ -800,6 +805,9 @@ typedef struct PictureParentControlSet {
     uint64_t                                last_idr_picture;
     uint64_t                                start_time_seconds;
     uint64_t                                start_time_u_seconds;
+    // deadline mode: stage boundaries of the picture (see SvtAv1DeadlineStage) and speed epoch it was decided in
+    uint64_t                                deadline_time_us[SVT_AV1_DEADLINE_STAGES + 1];
+    uint32_t                                deadline_epoch;
     uint64_t                                luma_sse;
     uint64_t                                cr_sse;
     uint64_t                                cb_sse;
@@ -1002,6 +1010,7 @@ typedef struct PictureParentControlSet {
     uint64_t    filtered_sse_uv;
     FrameHeader frm_hdr;
     uint16_t   *altref_buffer_highbd[3];
+    Bool        altref_highbd_cached; // altref_buffer_highbd is listed in tf_highbd_view_pcs of the encode context
     uint8_t     pic_obmc_level;
 
     Bool is_pcs_sb_params;
@@ -1042,6 +1051,8 @@ typedef struct PictureParentControlSet {
     int32_t superres_total_recode_loop; // how many loops to run, set to 2 in dual search mode
     uint8_t superres_denom_array[NUM_SR_SCALES + 1]; // denom candidate array used in auto supreres
     double  superres_rdcost[NUM_SR_SCALES + 1]; // 9 slots, for denom 8 ~ 16
+    // source scaled to superres_denom_array[i] by the first loop, taken by loop i
+    EbPictureBufferDesc *superres_recode_pics[NUM_SR_SCALES + 1];
 
     EbObjectWrapper      *me_data_wrapper;
     MotionEstimationData *pa_me_data;
@@ -1075,6 +1086,7 @@ typedef struct PictureParentControlSet {
     int         q_low;
     int         q_high;
     int         loop_count;
+    uint8_t     recode_count; // times the picture was coded again, by the rate control or the super-res search
     int         overshoot_seen;
     int         undershoot_seen;
     int         low_cr_seen;
@@ -1102,7 +1114,13 @@ typedef struct PictureParentControlSet {
     int base_frame_target; // A baseline frame target before adjustment.
     int this_frame_target; // Actual frame target after rc adjustment.
     int projected_frame_size;
-    int max_frame_size;
+    // Rate of the frame at the base qindex over its coded rate, when the superblock rate control moved the qindex
+    double sb_rate_ctrl_base_ratio;
+    // Frame size expected by the rate model and rate mode decision spent, in bits, when the superblock
+    // rate control is on
+    int     sb_rate_ctrl_expected_bits;
+    int64_t sb_rate_ctrl_md_bits;
+    int     max_frame_size;
     int frames_to_key;
     int frames_since_key;
     int top_index;
@@ -51,7 +51,7 @@ extern PredictionStructureConfigEntry four_level_hierarchical_pred_struct[];
 extern PredictionStructureConfigEntry five_level_hierarchical_pred_struct[];
 extern PredictionStructureConfigEntry six_level_hierarchical_pred_struct[];
 void  svt_aom_get_max_allocated_me_refs(uint8_t ref_count_used_list0, uint8_t ref_count_used_list1, uint8_t* max_ref_to_alloc, uint8_t* max_cand_to_alloc);
-void svt_aom_init_resize_picture(SequenceControlSet* scs, PictureParentControlSet* pcs);
+void svt_aom_init_resize_picture(SequenceControlSet* scs, PictureParentControlSet* pcs, SvtJobPool *job_pool);
 MvReferenceFrame svt_get_ref_frame_type(uint8_t list, uint8_t ref_idx);
 
 static uint32_t calc_ahd(
@@ -211,6 +211,7 @@ static void picture_decision_context_dctor(EbPtr p)
     EB_FREE_2D(obj->ahd_running_avg);
     EB_FREE_2D(obj->ahd_running_avg_cr);
     EB_FREE_2D(obj->ahd_running_avg_cb);
+    EB_DELETE(obj->resize_job_pool);
     EB_FREE_ARRAY(obj);
 }
 
@@ -256,7 +257,7 @@ EbErrorType svt_aom_picture_decision_context_ctor(
     pd_ctx->sframe_due = 0;
     pd_ctx->last_long_base_pic = 0;
     pd_ctx->enable_startup_mg = false;
-    return EB_ErrorNone;
+    return svt_aom_create_resize_job_pool(&pd_ctx->resize_job_pool, enc_handle_ptr->scs_instance_array[0]->scs);
 }
 static Bool scene_transition_detector(
     PictureDecisionContext* pd_ctx,
@@ -609,9 +610,12 @@ static void early_hme(
 
         EbObjectWrapper               *out_results_wrp;
         PictureDecisionResults        *out_results;
-        svt_get_empty_object(
+        if (svt_get_empty_object(
             ctx->picture_decision_results_output_fifo_ptr,
-            &out_results_wrp);
+            &out_results_wrp) != EB_ErrorNone) {
+            svt_aom_post_error_packet(src_pcs->scs->enc_ctx);
+            break;
+        }
         out_results = (PictureDecisionResults*)out_results_wrp->object_ptr;
         out_results->pcs_wrapper = src_pcs->p_pcs_wrapper_ptr;
         out_results->segment_index = seg_idx;
@@ -620,7 +624,9 @@ static void early_hme(
     }
 
     // wait for all segments to complete before the frame based calculations can be performed using the dg metrics
-    svt_block_on_semaphore(src_pcs->dg_detector->frame_done_sem);
+    // a stopped pipeline does not complete them, the metrics are then unused as the next output is refused
+    if (!svt_aom_pipeline_stopped(src_pcs->scs->enc_ctx))
+        svt_block_on_semaphore(src_pcs->dg_detector->frame_done_sem);
 
     // 64x64 Block Loop
     uint32_t pic_width_in_b64 = (src_pcs->aligned_width + 63) / 64;
@@ -1108,6 +1114,11 @@ static void set_key_frame_rps(PictureParentControlSet *pcs, PictureDecisionConte
     FrameHeader *frm_hdr = &pcs->frm_hdr;
     pd_ctx->lay0_toggle = 0;
     pd_ctx->lay1_toggle = 0;
+    // with checkpoints, the key frame refreshes all the references; count the long base interval from
+    // it, so that the references after it do not depend on the pictures before it
+    const CheckpointCtrl *ckpt_ctrl = &pcs->scs->enc_ctx->checkpoint_ctrl;
+    if (ckpt_ctrl->enabled || ckpt_ctrl->resume)
+        pd_ctx->last_long_base_pic = pcs->picture_number;
 
     frm_hdr->show_frame = TRUE;
     pcs->has_show_existing = FALSE;
@@ -2698,7 +2709,8 @@ static void  av1_generate_rps_info(
         // Pre processing operations performed on the input picture
         svt_aom_picture_pre_processing_operations(
             pcs,
-            scs);
+            scs,
+            NULL);
 
         if (input_pic->color_format >= EB_YUV422) {
             // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
@@ -2948,21 +2960,10 @@ static EbErrorType derive_tf_window_params(
         do_noise_est = 1;
     // allocate 16 bit buffer
     if (is_highbd) {
-        EB_MALLOC_ARRAY(centre_pcs->altref_buffer_highbd[C_Y],
-            central_picture_ptr->luma_size);
-        if (pcs->tf_ctrls.chroma_lvl) {
-            EB_MALLOC_ARRAY(centre_pcs->altref_buffer_highbd[C_U],
-                central_picture_ptr->chroma_size);
-            EB_MALLOC_ARRAY(centre_pcs->altref_buffer_highbd[C_V],
-                central_picture_ptr->chroma_size);
-        }
-
-        // pack byte buffers to 16 bit buffer
-        svt_aom_pack_highbd_pic(central_picture_ptr,
-            centre_pcs->altref_buffer_highbd,
-            ss_x,
-            ss_y,
-            TRUE);
+        // pack byte buffers to 16 bit buffer, or take the view packed for an earlier window
+        EbErrorType err = svt_aom_tf_get_highbd_view(enc_ctx, centre_pcs, pcs->tf_ctrls.chroma_lvl != 0, FALSE);
+        if (err != EB_ErrorNone)
+            return err;
         // Estimate source noise level
         uint16_t *altref_buffer_highbd_start[COLOR_CHANNELS];
         altref_buffer_highbd_start[C_Y] =
@@ -3407,9 +3408,12 @@ static void mctf_frame(
                 EbObjectWrapper               *out_results_wrapper;
                 PictureDecisionResults        *out_results;
 
-                svt_get_empty_object(
+                if (svt_get_empty_object(
                     pd_ctx->picture_decision_results_output_fifo_ptr,
-                    &out_results_wrapper);
+                    &out_results_wrapper) != EB_ErrorNone) {
+                    svt_aom_post_error_packet(scs->enc_ctx);
+                    break;
+                }
                 out_results = (PictureDecisionResults*)out_results_wrapper->object_ptr;
                 out_results->pcs_wrapper = pcs->p_pcs_wrapper_ptr;
                 out_results->segment_index = seg_idx;
@@ -3417,7 +3421,9 @@ static void mctf_frame(
                 svt_post_full_object(out_results_wrapper);
             }
 
-            svt_block_on_semaphore(pcs->temp_filt_done_semaphore);
+            // a stopped pipeline does not complete the segments, the picture is then not sent out
+            if (!svt_aom_pipeline_stopped(scs->enc_ctx))
+                svt_block_on_semaphore(pcs->temp_filt_done_semaphore);
         }
 
         if (pcs->tf_tot_horz_blks > pcs->tf_tot_vert_blks * 6 / 4){
@@ -3460,7 +3466,7 @@ bool get_similar_ref_brightness(PictureParentControlSet *pcs)
     return similar_brightness_refs;
 }
 
-static void send_picture_out(
+static EbErrorType send_picture_out(
     SequenceControlSet      *scs,
     PictureParentControlSet *pcs,
     PictureDecisionContext  *ctx)
@@ -3484,7 +3490,9 @@ static void send_picture_out(
     }
         //get a new ME data buffer
         if (pcs->me_data_wrapper == NULL) {
-            svt_get_empty_object(ctx->me_fifo_ptr, &me_wrapper);
+            EbErrorType return_error = svt_get_empty_object(ctx->me_fifo_ptr, &me_wrapper);
+            if (return_error != EB_ErrorNone)
+                return return_error;
             pcs->me_data_wrapper = me_wrapper;
             pcs->pa_me_data = (MotionEstimationData *)me_wrapper->object_ptr;
             me_update_param(pcs->pa_me_data, scs);
@@ -3521,7 +3529,7 @@ static void send_picture_out(
         if (scs->static_config.resize_mode > RESIZE_NONE ||
             scs->static_config.superres_mode == SUPERRES_FIXED ||
             scs->static_config.superres_mode == SUPERRES_RANDOM) {
-            svt_aom_init_resize_picture(scs, pcs);
+            svt_aom_init_resize_picture(scs, pcs, ctx->resize_job_pool);
         }
     }
     bool super_res_off = pcs->frame_superres_enabled == FALSE &&
@@ -3531,14 +3539,20 @@ static void send_picture_out(
 
     // NB: overlay frames should be non-ref
     // Before sending pics out to pic mgr, ensure that pic mgr can handle them
-    if (pcs->is_ref)
+    if (pcs->is_ref) {
+        // a stopped pipeline posts the semaphore once, it is not waited on anymore
+        if (svt_aom_pipeline_stopped(scs->enc_ctx))
+            return EB_ErrorUndefined;
         svt_block_on_semaphore(scs->ref_buffer_available_semaphore);
+    }
 
     for (uint32_t segment_index = 0; segment_index < pcs->me_segments_total_count; ++segment_index) {
         // Get Empty Results Object
-        svt_get_empty_object(
+        EbErrorType return_error = svt_get_empty_object(
             ctx->picture_decision_results_output_fifo_ptr,
             &out_results_wrapper);
+        if (return_error != EB_ErrorNone)
+            return return_error;
 
         PictureDecisionResults* out_results = (PictureDecisionResults*)out_results_wrapper->object_ptr;
         out_results->pcs_wrapper = pcs->p_pcs_wrapper_ptr;
@@ -3547,7 +3561,7 @@ static void send_picture_out(
         //Post the Full Results Object
         svt_post_full_object(out_results_wrapper);
     }
-
+    return EB_ErrorNone;
 }
 /***************************************************************************************************
 * Store the pcs pointers in the gf group, set the gf_interval and gf_update_due
@@ -3633,12 +3647,16 @@ static PaReferenceEntry * search_ref_in_ref_queue_pa(
  * Copy TF params: sps -> pcs
  */
 static void copy_tf_params(SequenceControlSet *scs, PictureParentControlSet *pcs) {
+    // In deadline mode, the TF params follow the preset of the picture
+    const TfControls *tf_params_per_type = scs->static_config.deadline_fps_numerator
+        ? scs->deadline_tf_params[pcs->enc_mode - scs->static_config.enc_mode]
+        : scs->tf_params_per_type;
 
     // Map TF settings sps -> pcs
    if (scs->static_config.pred_structure != SVT_AV1_PRED_RANDOM_ACCESS)
    {
         if (pcs->slice_type != I_SLICE && pcs->temporal_layer_index == 0)
-            pcs->tf_ctrls = scs->tf_params_per_type[1];
+            pcs->tf_ctrls = tf_params_per_type[1];
         else
             pcs->tf_ctrls.enabled = 0;
         return;
@@ -3647,11 +3665,11 @@ static void copy_tf_params(SequenceControlSet *scs, PictureParentControlSet *pcs
    if (pcs->is_overlay || pcs->temporal_layer_index == pcs->hierarchical_levels)
        pcs->tf_ctrls.enabled = 0;
    else if (svt_aom_is_delayed_intra(pcs))
-        pcs->tf_ctrls = scs->tf_params_per_type[0];
+        pcs->tf_ctrls = tf_params_per_type[0];
     else if (pcs->temporal_layer_index == 0)  // BASE
-        pcs->tf_ctrls = scs->tf_params_per_type[1];
+        pcs->tf_ctrls = tf_params_per_type[1];
     else if (pcs->temporal_layer_index == 1)  // L1
-        pcs->tf_ctrls = scs->tf_params_per_type[2];
+        pcs->tf_ctrls = tf_params_per_type[2];
     else
         pcs->tf_ctrls.enabled = 0;
 }
@@ -3694,7 +3712,7 @@ static void update_sframe_ref_order_hint(PictureParentControlSet *ppcs, PictureD
     assert(sizeof(ppcs->dpb_order_hint) == sizeof(pd_ctx->ref_order_hint));
     memcpy(ppcs->dpb_order_hint, pd_ctx->ref_order_hint, sizeof(ppcs->dpb_order_hint));
     if (ppcs->av1_ref_signal.refresh_frame_mask != 0) {
-        const uint32_t cur_order_hint = ppcs->picture_number % ((uint64_t)1 << (ppcs->scs->seq_header.order_hint_info.order_hint_bits));
+        const uint32_t cur_order_hint = svt_aom_stream_picture_number(ppcs) % ((uint64_t)1 << (ppcs->scs->seq_header.order_hint_info.order_hint_bits));
         for (int32_t i = 0; i < REF_FRAMES; i++) {
             if ((ppcs->av1_ref_signal.refresh_frame_mask >> i) & 1) {
                 pd_ctx->ref_order_hint[i] = cur_order_hint;
@@ -4070,13 +4088,14 @@ static void init_pic_settings(SequenceControlSet* scs, PictureParentControlSet*
     pcs->av1_cm->mi_cols = pcs->aligned_width >> MI_SIZE_LOG2;
     pcs->av1_cm->mi_rows = pcs->aligned_height >> MI_SIZE_LOG2;
 
-    // Initialize the order hints
+    // Initialize the order hints, from the position of the pictures in the stream when resuming it
     const OrderHintInfo *const order_hint_info = &pcs->scs->seq_header.order_hint_info;
+    const uint64_t picture_offset = pcs->scs->enc_ctx->checkpoint_ctrl.picture_offset;
     uint32_t* ref_order_hint = pcs->ref_order_hint;
     for (uint8_t i = 0; i < INTER_REFS_PER_FRAME; ++i) {
-        ref_order_hint[i] = pcs->av1_ref_signal.ref_poc_array[i] % (uint64_t)(1 << (order_hint_info->order_hint_bits));
+        ref_order_hint[i] = (pcs->av1_ref_signal.ref_poc_array[i] + picture_offset) % (uint64_t)(1 << (order_hint_info->order_hint_bits));
     }
-    pcs->cur_order_hint = pcs->picture_number % (uint64_t)(1 << (order_hint_info->order_hint_bits));
+    pcs->cur_order_hint = (pcs->picture_number + picture_offset) % (uint64_t)(1 << (order_hint_info->order_hint_bits));
 
     set_ref_frame_sign_bias(scs, pcs);
 
@@ -4301,7 +4320,7 @@ static void assign_and_release_pa_refs(EncodeContext* enc_ctx, PictureParentCont
 }
 
 // Send pictures to TF and ME
-static void process_pics(SequenceControlSet* scs, PictureDecisionContext* ctx) {
+static EbErrorType process_pics(SequenceControlSet* scs, PictureDecisionContext* ctx) {
     PictureParentControlSet* pcs = NULL; // init'd to quiet build warnings
     const unsigned int mg_size = ctx->mg_size;
     // Process previous delayed Intra if we have one
@@ -4328,8 +4347,10 @@ static void process_pics(SequenceControlSet* scs, PictureDecisionContext* ctx) {
     }
 
     //Do TF loop in display order
+    uint64_t last_picture_number = ctx->prev_delayed_intra ? ctx->prev_delayed_intra->picture_number : 0;
     for (uint32_t pic_i = 0; pic_i < mg_size; ++pic_i) {
         pcs = ctx->mg_pictures_array_disp_order[pic_i];
+        last_picture_number = MAX(last_picture_number, pcs->picture_number);
 
         if (svt_aom_is_delayed_intra(pcs) == FALSE) {
             if (pcs->slice_type == B_SLICE && pcs->temporal_layer_index == 0) {
@@ -4343,11 +4364,16 @@ static void process_pics(SequenceControlSet* scs, PictureDecisionContext* ctx) {
             ctx->gm_pp_last_detected = pcs->gm_pp_enabled ? pcs->gm_pp_detected : ctx->gm_pp_last_detected;
         }
     }
+    // The pictures of the mini-GOP are sent out below, the 16-bit views of the later pictures stay
+    // for the next windows
+    svt_aom_tf_flush_highbd_views(scs->enc_ctx, last_picture_number);
 
     if (ctx->prev_delayed_intra) {
         pcs = ctx->prev_delayed_intra;
         ctx->prev_delayed_intra = NULL;
-        send_picture_out(scs, pcs, ctx);
+        EbErrorType return_error = send_picture_out(scs, pcs, ctx);
+        if (return_error != EB_ErrorNone)
+            return return_error;
     }
 
     //split MG into two for these two special cases
@@ -4390,12 +4416,14 @@ static void process_pics(SequenceControlSet* scs, PictureDecisionContext* ctx) {
                 }
             }
            pcs->gm_pp_detected = ctx->gm_pp_last_detected;
-            send_picture_out(scs, pcs, ctx);
+            EbErrorType return_error = send_picture_out(scs, pcs, ctx);
+            if (return_error != EB_ErrorNone)
+                return return_error;
         }
     }
 
     ctx->mg_progress_id++;
-
+    return EB_ErrorNone;
 }
 
 // update the DPB stored in the PD context
@@ -4780,6 +4808,10 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
                         pre_assignment_buffer_first_pass_flag = false;
                     }
 
+                    // Move the speed of the deadline mode, once per mini-GOP
+                    if (enc_ctx->deadline_ctrl.enabled)
+                        svt_aom_deadline_update_speed(&enc_ctx->deadline_ctrl, ctx->mini_gop_length[mini_gop_index]);
+
                     // 2nd Loop over Pictures in the Pre-Assignment Buffer
                     // Init picture settings
                     // Add 1 to the loop for the overlay picture. If the last picture is alt ref, increase the loop by 1 to add the overlay picture
@@ -4858,6 +4890,13 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
 
                         update_dpb(pcs, ctx);
 
+                        if (enc_ctx->deadline_ctrl.enabled) {
+                            pcs->enc_mode = svt_aom_deadline_pic_enc_mode(
+                                &enc_ctx->deadline_ctrl, pcs->temporal_layer_index, pcs->hierarchical_levels);
+                            pcs->deadline_epoch = enc_ctx->deadline_ctrl.epoch;
+                        }
+                        svt_aom_deadline_stamp(&enc_ctx->deadline_ctrl,
+                                               &pcs->deadline_time_us[SVT_AV1_DEADLINE_STAGE_MOTION]);
                         // Set picture settings, incl. normative frame header fields and feature levels in signal_derivation function
                         init_pic_settings(scs, pcs, ctx);
                     }
@@ -4875,7 +4914,10 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
                     assign_and_release_pa_refs(enc_ctx, pcs, ctx);
 
                     // Send the pictures in the MG to TF and ME
-                    process_pics(scs, ctx);
+                    if (process_pics(scs, ctx) != EB_ErrorNone) {
+                        svt_aom_post_error_packet(enc_ctx);
+                        return NULL;
+                    }
                 } // End MINI GOPs loop
                 // Reset the Pre-Assignment Buffer
                 enc_ctx->pre_assignment_buffer_count = 0;
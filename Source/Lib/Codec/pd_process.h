@@ -28,7 +28,9 @@ void svt_aom_pad_picture_to_multiple_of_min_blk_size_dimensions(SequenceControlS
                                                                 EbPictureBufferDesc *input_pic);
 void svt_aom_pad_picture_to_multiple_of_min_blk_size_dimensions_16bit(SequenceControlSet  *scs,
                                                                       EbPictureBufferDesc *input_pic);
-void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs);
+// job_pool runs the film grain denoising and modelling, NULL runs it on the calling thread
+void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs,
+                                               SvtJobPool *job_pool);
 void svt_aom_pad_picture_to_multiple_of_sb_dimensions(EbPictureBufferDesc *input_padded_pic);
 void svt_aom_gathering_picture_statistics(SequenceControlSet *scs, PictureParentControlSet *pcs,
                                           EbPictureBufferDesc *input_padded_pic,
@@ -126,6 +128,8 @@ typedef struct PictureDecisionContext {
     bool     enable_startup_mg;
     uint32_t filt_to_unfilt_diff;
     bool     list0_only;
+    // Workers scaling the pictures of the resize and superres fixed/random modes
+    SvtJobPool *resize_job_pool;
 } PictureDecisionContext;
 
 #endif // EbPictureDecision_h
@@ -39,11 +39,14 @@ typedef struct PictureAnalysisContext {
     EB_ALIGN(64) uint8_t local_cache[64];
     EbFifo *resource_coordination_results_input_fifo_ptr;
     EbFifo *picture_analysis_results_output_fifo_ptr;
+    // Workers denoising and modelling the film grain of this process' pictures
+    SvtJobPool *film_grain_job_pool;
 } PictureAnalysisContext;
 
 static void picture_analysis_context_dctor(EbPtr p) {
     EbThreadContext        *thread_ctx = (EbThreadContext *)p;
     PictureAnalysisContext *obj        = (PictureAnalysisContext *)thread_ctx->priv;
+    EB_DELETE(obj->film_grain_job_pool);
     EB_FREE_ARRAY(obj);
 }
 /************************************************
@@ -60,6 +63,12 @@ EbErrorType svt_aom_picture_analysis_context_ctor(EbThreadContext *thread_ctx, c
         enc_handle_ptr->resource_coordination_results_resource_ptr, index);
     pa_ctx->picture_analysis_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_analysis_results_resource_ptr, index);
+
+    const SequenceControlSet *scs = enc_handle_ptr->scs_instance_array[0]->scs;
+    // Picture analysis runs several pictures at once, split the cores between them
+    const int32_t fg_thread_count = MAX(1, scs->core_count / scs->picture_analysis_process_init_count);
+    if (scs->static_config.film_grain_denoise_strength && !scs->static_config.fgs_table && fg_thread_count > 1)
+        EB_NEW(pa_ctx->film_grain_job_pool, svt_job_pool_ctor, fg_thread_count);
     return EB_ErrorNone;
 }
 void svt_aom_down_sample_chroma(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *outputPicturePtr) {
@@ -1381,7 +1390,7 @@ static EbErrorType compute_block_mean_compute_variance(
 }
 
 static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet *pcs,
-                                EbPictureBufferDesc *inputPicturePointer) {
+                                EbPictureBufferDesc *inputPicturePointer, SvtJobPool *job_pool) {
     AomDenoiseAndModel     *denoise_and_model;
     DenoiseAndModelInitData fg_init_data;
     fg_init_data.encoder_bit_depth    = pcs->enhanced_pic->bit_depth;
@@ -1393,6 +1402,7 @@ static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet
     fg_init_data.stride_cb            = pcs->enhanced_pic->stride_cb;
     fg_init_data.stride_cr            = pcs->enhanced_pic->stride_cr;
     fg_init_data.denoise_apply        = scs->static_config.film_grain_denoise_apply;
+    fg_init_data.job_pool             = job_pool;
     EB_NEW(denoise_and_model, svt_aom_denoise_and_model_ctor, (EbPtr)&fg_init_data);
 
     if (svt_aom_denoise_and_model_run(denoise_and_model,
@@ -1405,7 +1415,8 @@ static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet
     return 0;
 }
 
-static EbErrorType denoise_estimate_film_grain(SequenceControlSet *scs, PictureParentControlSet *pcs) {
+static EbErrorType denoise_estimate_film_grain(SequenceControlSet *scs, PictureParentControlSet *pcs,
+                                               SvtJobPool *job_pool) {
     EbErrorType return_error = EB_ErrorNone;
 
     FrameHeader *frm_hdr = &pcs->frm_hdr;
@@ -1414,7 +1425,7 @@ static EbErrorType denoise_estimate_film_grain(SequenceControlSet *scs, PictureP
     frm_hdr->film_grain_params.apply_grain = 0;
 
     if (scs->static_config.film_grain_denoise_strength) {
-        if (apply_denoise_2d(scs, pcs, input_pic) < 0)
+        if (apply_denoise_2d(scs, pcs, input_pic, job_pool) < 0)
             return 1;
     }
 
@@ -1449,11 +1460,12 @@ static EbErrorType apply_film_grain_table(SequenceControlSet *scs_ptr, PicturePa
  ***** Borders preprocessing
  ***** Denoising
  ************************************************/
-void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs) {
+void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs,
+                                               SvtJobPool *job_pool) {
     if (scs->static_config.fgs_table) {
         apply_film_grain_table(scs, pcs);
     } else if (scs->static_config.film_grain_denoise_strength) {
-        denoise_estimate_film_grain(scs, pcs);
+        denoise_estimate_film_grain(scs, pcs, job_pool);
     }
 
     return;
@@ -2099,7 +2111,7 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
                 svt_aom_pad_input_pictures(scs, input_pic);
 
                 // Pre processing operations performed on the input picture
-                svt_aom_picture_pre_processing_operations(pcs, scs);
+                svt_aom_picture_pre_processing_operations(pcs, scs, pa_ctx->film_grain_job_pool);
 
                 if (input_pic->color_format >= EB_YUV422) {
                     // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
@@ -2154,7 +2166,7 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
             }
         }
         // Get Empty Results Object
-        svt_get_empty_object(pa_ctx->picture_analysis_results_output_fifo_ptr, &out_results_wrapper);
+        EB_GET_EMPTY_OBJECT(scs->enc_ctx, pa_ctx->picture_analysis_results_output_fifo_ptr, &out_results_wrapper);
 
         PictureAnalysisResults *out_results = (PictureAnalysisResults *)out_results_wrapper->object_ptr;
         out_results->pcs_wrapper            = in_results_ptr->pcs_wrapper;
@@ -353,7 +353,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
 
             EbObjectWrapper *out_results_wrapper;
             // Get Empty Results Object
-            svt_get_empty_object(context_ptr->picture_manager_output_fifo_ptr, &out_results_wrapper);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->picture_manager_output_fifo_ptr, &out_results_wrapper);
             RateControlTasks *rc_tasks = (RateControlTasks *)out_results_wrapper->object_ptr;
             rc_tasks->pcs_wrapper      = pcs->child_pcs->c_pcs_wrapper_ptr;
             rc_tasks->task_type        = RC_INPUT_SUPERRES_RECODE;
@@ -567,7 +567,11 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
                         if (entry_ppcs->is_ref) {
                             EbObjectWrapper *ref_pic_wrapper;
                             // Get Empty Reference Picture Object
-                            svt_get_empty_object(scs->enc_ctx->reference_picture_pool_fifo_ptr, &ref_pic_wrapper);
+                            if (svt_get_empty_object(scs->enc_ctx->reference_picture_pool_fifo_ptr, &ref_pic_wrapper) !=
+                                EB_ErrorNone) {
+                                svt_aom_post_error_packet(enc_ctx);
+                                return NULL;
+                            }
                             entry_ppcs->ref_pic_wrapper = ref_pic_wrapper;
                             // reset reference object in case of its members are altered by superres
                             // tool
@@ -577,6 +581,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
                                 ref->reference_picture->max_height != entry_scs_ptr->max_input_luma_height)
                                 svt_reference_param_update(ref, entry_scs_ptr);
                             svt_reference_object_reset(ref, entry_scs_ptr);
+                            svt_reference_object_release_downscaled(ref);
                             // Give the new Reference a nominal live_count of 1
                             svt_object_inc_live_count(entry_ppcs->ref_pic_wrapper, 1);
 #if SRM_REPORT
@@ -586,7 +591,10 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
                             entry_ppcs->ref_pic_wrapper = NULL;
                         }
                         // Get New  Empty recon-coef from recon-coef  Pool
-                        svt_get_empty_object(context_ptr->recon_coef_fifo_ptr, &enc_dec_wrapper);
+                        if (svt_get_empty_object(context_ptr->recon_coef_fifo_ptr, &enc_dec_wrapper) != EB_ErrorNone) {
+                            svt_aom_post_error_packet(enc_ctx);
+                            return NULL;
+                        }
                         // Child PCS is released by Packetization
                         svt_object_inc_live_count(enc_dec_wrapper, 1);
                         enc_dec_ptr = (EncDecSet *)enc_dec_wrapper->object_ptr;
@@ -602,7 +610,11 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
 
                         enc_dec_ptr->ppcs->enc_dec_ptr = enc_dec_ptr;
                         // Get New  Empty Child PCS from PCS Pool
-                        svt_get_empty_object(context_ptr->picture_control_set_fifo_ptr, &child_pcs_wrapper);
+                        if (svt_get_empty_object(context_ptr->picture_control_set_fifo_ptr, &child_pcs_wrapper) !=
+                            EB_ErrorNone) {
+                            svt_aom_post_error_packet(enc_ctx);
+                            return NULL;
+                        }
 
                         // Child PCS is released by Packetization
                         svt_object_inc_live_count(child_pcs_wrapper, 1);
@@ -901,7 +913,8 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
                         }
                         EbObjectWrapper *out_results_wrapper;
                         // Get Empty Results Object
-                        svt_get_empty_object(context_ptr->picture_manager_output_fifo_ptr, &out_results_wrapper);
+                        EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->picture_manager_output_fifo_ptr,
+                                            &out_results_wrapper);
                         RateControlTasks *rc_tasks = (RateControlTasks *)out_results_wrapper->object_ptr;
                         rc_tasks->pcs_wrapper      = child_pcs->c_pcs_wrapper_ptr;
                         rc_tasks->task_type        = RC_INPUT;
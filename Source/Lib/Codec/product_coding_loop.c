@@ -4452,6 +4452,40 @@ static int32_t av1_txt_rate_est(struct ModeDecisionContext *ctx, struct ModeDeci
     }
     return 0;
 }
+// Hash of the residual block fed to the transform; rows are at least 4 samples wide
+static uint64_t tx_cache_hash_residual(const int16_t *src, uint32_t stride, uint32_t width, uint32_t height) {
+    uint64_t hash = ((uint64_t)width << 32) | height;
+    for (uint32_t y = 0; y < height; y++, src += stride) {
+        for (uint32_t x = 0; x < width; x += 4) {
+            uint64_t v;
+            memcpy(&v, src + x, sizeof(v));
+            hash = (hash ^ v) * 0x9E3779B97F4A7C15ULL;
+            hash ^= hash >> 29;
+        }
+    }
+    return hash;
+}
+// The residual is kept next to the coeffs of the entry, a hit must match it and not only its hash
+static Bool tx_cache_residual_match(const int16_t *src, uint32_t stride, uint32_t width, uint32_t height,
+                                    const int16_t *cached) {
+    for (uint32_t y = 0; y < height; y++, src += stride, cached += width)
+        if (memcmp(src, cached, width * sizeof(*src)))
+            return FALSE;
+    return TRUE;
+}
+static void tx_cache_store_residual(const int16_t *src, uint32_t stride, uint32_t width, uint32_t height,
+                                    int16_t *cached) {
+    for (uint32_t y = 0; y < height; y++, src += stride, cached += width) memcpy(cached, src, width * sizeof(*src));
+}
+// Pack everything (other than the residual and lambda) the luma T/Q output of tx_type_search depends on
+static INLINE uint64_t tx_cache_key(TxSize tx_size, TxType tx_type, EB_TRANS_COEFF_SHAPE pf_shape, uint32_t qindex,
+                                    int32_t seg_qp, Bool is_inter, int16_t txb_skip_ctx, int16_t dc_sign_ctx,
+                                    uint8_t sq_size, uint8_t skip_rdoq) {
+    return (uint64_t)tx_size | ((uint64_t)tx_type << 5) | ((uint64_t)pf_shape << 9) | ((uint64_t)(qindex & 0xff) << 11) |
+        ((uint64_t)((seg_qp + 256) & 0x1ff) << 19) | ((uint64_t)is_inter << 28) |
+        ((uint64_t)(txb_skip_ctx & 0xff) << 29) | ((uint64_t)(dc_sign_ctx & 0xff) << 37) |
+        ((uint64_t)sq_size << 45) | ((uint64_t)skip_rdoq << 53);
+}
 static INLINE double derive_ssim_threshold_factor_for_tx_type_search(SequenceControlSet *scs) {
     return scs->input_resolution >= INPUT_SIZE_1080p_RANGE ? 1.06 : 1.05;
 }
@@ -4578,6 +4612,17 @@ static void tx_type_search(PictureControlSet *pcs, ModeDecisionContext *ctx, Mod
     }
     const double cost_threshold_factor = derive_ssim_threshold_factor_for_tx_type_search(pcs->scs);
     int          tx_type_tot_group     = get_tx_type_group(ctx, cand_bf, only_dct_dct);
+    // The T/Q output only depends on the residual and the key fields, so identical residuals evaluated
+    // again within the SB (MDS1 then MDS3, redundant blocks, overlapping NSQ shapes) reuse it
+    const uint8_t  use_tx_cache  = ctx->tx_cache_ctrls.enabled && !tx_search_skip_flag;
+    const int16_t *residual      = &(((int16_t *)cand_bf->residual->buffer_y)[txb_origin_index]);
+    const uint64_t residual_hash = use_tx_cache
+         ? tx_cache_hash_residual(
+              residual, cand_bf->residual->stride_y, tx_size_wide[tx_size], tx_size_high[tx_size])
+         : 0;
+    const int32_t  max_eob       = av1_get_max_eob(tx_size);
+    // An entry holds the quantized coeffs, the reconstructed coeffs, then the residual packed as int16
+    const uint32_t entry_size = 2 * max_eob + (tx_size_wide[tx_size] * tx_size_high[tx_size] + 1) / 2;
     for (int tx_type_group_idx = 0; tx_type_group_idx < tx_type_tot_group; ++tx_type_group_idx) {
         uint32_t best_tx_non_coeff = 64 * 64;
         for (int tx_type_idx = 0; tx_type_idx < TX_TYPES; ++tx_type_idx) {
@@ -4612,51 +4657,125 @@ static void tx_type_search(PictureControlSet *pcs, ModeDecisionContext *ctx, Mod
             EbPictureBufferDesc *quant_coeff_ptr = (tx_type == DCT_DCT) ? cand_bf->quant
                                                                         : ctx->quant_coeff_ptr[tx_type];
             ctx->three_quad_energy               = 0;
+            TxCacheEntry *tx_cache_entry         = NULL;
+            uint8_t       tx_cache_hit           = 0;
             if (!tx_search_skip_flag) {
-                // Y: T Q i_q
-                svt_aom_estimate_transform(&(((int16_t *)cand_bf->residual->buffer_y)[txb_origin_index]),
-                                           cand_bf->residual->stride_y,
-                                           &(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
-                                           NOT_USED_VALUE,
-                                           tx_size,
-                                           &ctx->three_quad_energy,
-                                           ctx->hbd_md ? EB_TEN_BIT : EB_EIGHT_BIT,
-                                           tx_type,
-                                           PLANE_TYPE_Y,
-                                           pf_shape);
+                if (use_tx_cache) {
+                    const uint64_t key = tx_cache_key(tx_size,
+                                                      tx_type,
+                                                      pf_shape,
+                                                      qindex,
+                                                      seg_qp,
+                                                      cand_bf->cand->pred_mode >= NEARESTMV,
+                                                      ctx->luma_txb_skip_context,
+                                                      ctx->luma_dc_sign_context,
+                                                      ctx->blk_geom->sq_size,
+                                                      ctx->mds_skip_rdoq);
+                    const uint32_t idx = (uint32_t)((residual_hash ^ (key * 0xFF51AFD7ED558CCDULL)) >> 32);
+                    tx_cache_entry     = &ctx->tx_cache[idx & (TX_CACHE_ENTRIES - 1)];
+                    tx_cache_hit = tx_cache_entry->epoch == ctx->tx_cache_epoch &&
+                        tx_cache_entry->hash == residual_hash && tx_cache_entry->key == key &&
+                        tx_cache_entry->lambda == full_lambda &&
+                        ctx->tx_cache_pool_pos - tx_cache_entry->coeff_pos <= TX_CACHE_POOL_SIZE &&
+                        tx_cache_residual_match(residual,
+                                                cand_bf->residual->stride_y,
+                                                tx_size_wide[tx_size],
+                                                tx_size_high[tx_size],
+                                                (const int16_t *)(ctx->tx_cache_pool +
+                                                                  (tx_cache_entry->coeff_pos & (TX_CACHE_POOL_SIZE - 1)) +
+                                                                  2 * max_eob));
+                    if (!tx_cache_hit) {
+                        // Invalid until the T/Q output is stored below
+                        tx_cache_entry->epoch  = ctx->tx_cache_epoch - 1;
+                        tx_cache_entry->hash   = residual_hash;
+                        tx_cache_entry->key    = key;
+                        tx_cache_entry->lambda = full_lambda;
+                    }
+                }
+                int satd = 0;
+                if (tx_cache_hit) {
+                    ctx->three_quad_energy = tx_cache_entry->three_quad_energy;
+                    satd                   = tx_cache_entry->satd;
+                } else {
+                    // Y: T Q i_q
+                    svt_aom_estimate_transform(&(((int16_t *)cand_bf->residual->buffer_y)[txb_origin_index]),
+                                               cand_bf->residual->stride_y,
+                                               &(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
+                                               NOT_USED_VALUE,
+                                               tx_size,
+                                               &ctx->three_quad_energy,
+                                               ctx->hbd_md ? EB_TEN_BIT : EB_EIGHT_BIT,
+                                               tx_type,
+                                               PLANE_TYPE_Y,
+                                               pf_shape);
+                    if (satd_early_exit_th || tx_cache_entry)
+                        satd = svt_aom_satd(&(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
+                                            (txbwidth * txbheight));
+                }
                 if (satd_early_exit_th) {
-                    int satd = svt_aom_satd(&(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
-                                            (txbwidth * txbheight))
-                        << ctx->mds_subres_step;
+                    const int scaled_satd = satd << ctx->mds_subres_step;
 
                     // If SATD of current type is better than the prevous best, update best, and continue evaluating tx_type
-                    if (satd < best_satd_tx_search) {
-                        best_satd_tx_search = satd;
+                    if (scaled_satd < best_satd_tx_search) {
+                        best_satd_tx_search = scaled_satd;
                     } else {
                         // If SATD of current type is much worse than the best then stop evaluating current tx_type
-                        if ((satd - best_satd_tx_search) * 100 > best_satd_tx_search * satd_early_exit_th)
+                        if ((scaled_satd - best_satd_tx_search) * 100 > best_satd_tx_search * satd_early_exit_th)
                             continue;
                     }
                 }
 
-                quantized_dc_txt[tx_type] = svt_aom_quantize_inv_quantize(
-                    pcs,
-                    ctx,
-                    &(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
-                    &(((int32_t *)quant_coeff_ptr->buffer_y)[ctx->txb_1d_offset]),
-                    &(((int32_t *)recon_coeff_ptr->buffer_y)[ctx->txb_1d_offset]),
-                    qindex,
-                    seg_qp,
-                    tx_size,
-                    &eob_txt[tx_type],
-                    COMPONENT_LUMA,
-                    ctx->hbd_md ? EB_TEN_BIT : EB_EIGHT_BIT,
-                    tx_type,
-                    ctx->luma_txb_skip_context,
-                    ctx->luma_dc_sign_context,
-                    cand_bf->cand->pred_mode,
-                    full_lambda,
-                    FALSE);
+                int32_t *quant_coeff = &(((int32_t *)quant_coeff_ptr->buffer_y)[ctx->txb_1d_offset]);
+                int32_t *recon_coeff = &(((int32_t *)recon_coeff_ptr->buffer_y)[ctx->txb_1d_offset]);
+                if (tx_cache_hit) {
+                    const int32_t *cached_coeffs = ctx->tx_cache_pool +
+                        (tx_cache_entry->coeff_pos & (TX_CACHE_POOL_SIZE - 1));
+                    memcpy(quant_coeff, cached_coeffs, max_eob * sizeof(int32_t));
+                    memcpy(recon_coeff, cached_coeffs + max_eob, max_eob * sizeof(int32_t));
+                    eob_txt[tx_type]          = tx_cache_entry->eob;
+                    quantized_dc_txt[tx_type] = tx_cache_entry->quantized_dc;
+                } else {
+                    quantized_dc_txt[tx_type] = svt_aom_quantize_inv_quantize(pcs,
+                                                                              ctx,
+                                                                              &(((int32_t *)ctx->tx_coeffs
+                                                                                     ->buffer_y)[ctx->txb_1d_offset]),
+                                                                              quant_coeff,
+                                                                              recon_coeff,
+                                                                              qindex,
+                                                                              seg_qp,
+                                                                              tx_size,
+                                                                              &eob_txt[tx_type],
+                                                                              COMPONENT_LUMA,
+                                                                              ctx->hbd_md ? EB_TEN_BIT : EB_EIGHT_BIT,
+                                                                              tx_type,
+                                                                              ctx->luma_txb_skip_context,
+                                                                              ctx->luma_dc_sign_context,
+                                                                              cand_bf->cand->pred_mode,
+                                                                              full_lambda,
+                                                                              FALSE);
+                    if (tx_cache_entry) {
+                        // Restart at the beginning of the ring rather than splitting the coeffs
+                        uint64_t pos = ctx->tx_cache_pool_pos;
+                        if ((pos & (TX_CACHE_POOL_SIZE - 1)) + entry_size > TX_CACHE_POOL_SIZE)
+                            pos = (pos + TX_CACHE_POOL_SIZE) & ~(uint64_t)(TX_CACHE_POOL_SIZE - 1);
+                        int32_t *cached_coeffs = ctx->tx_cache_pool + (pos & (TX_CACHE_POOL_SIZE - 1));
+                        memcpy(cached_coeffs, quant_coeff, max_eob * sizeof(int32_t));
+                        memcpy(cached_coeffs + max_eob, recon_coeff, max_eob * sizeof(int32_t));
+                        tx_cache_store_residual(residual,
+                                                cand_bf->residual->stride_y,
+                                                tx_size_wide[tx_size],
+                                                tx_size_high[tx_size],
+                                                (int16_t *)(cached_coeffs + 2 * max_eob));
+                        tx_cache_entry->coeff_pos         = pos;
+                        ctx->tx_cache_pool_pos            = pos + entry_size;
+                        tx_cache_entry->eob               = eob_txt[tx_type];
+                        tx_cache_entry->quantized_dc      = quantized_dc_txt[tx_type];
+                        tx_cache_entry->three_quad_energy = ctx->three_quad_energy;
+                        tx_cache_entry->satd              = satd;
+                        tx_cache_entry->dist_valid        = 0;
+                        tx_cache_entry->epoch             = ctx->tx_cache_epoch;
+                    }
+                }
             }
             uint32_t y_has_coeff = eob_txt[tx_type] > 0;
 
@@ -4726,14 +4845,41 @@ static void tx_type_search(PictureControlSet *pcs, ModeDecisionContext *ctx, Mod
                     bwidth  = txbwidth < 64 ? txbwidth : 32;
                     bheight = txbheight < 64 ? txbheight : 32;
                 }
-                svt_aom_picture_full_distortion32_bits_single(
-                    &(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
-                    &(((int32_t *)recon_coeff_ptr->buffer_y)[ctx->txb_1d_offset]),
-                    txbwidth < 64 ? txbwidth : 32,
-                    bwidth,
-                    bheight,
-                    txb_full_distortion_txt[DIST_SSD][tx_type],
-                    eob_txt[tx_type]);
+                if (tx_cache_hit && tx_cache_entry->dist_valid) {
+                    txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_RESIDUAL] =
+                        tx_cache_entry->dist[DIST_CALC_RESIDUAL];
+                    txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_PREDICTION] =
+                        tx_cache_entry->dist[DIST_CALC_PREDICTION];
+                } else {
+                    // The transform is skipped on a hit, so the coeffs are only regenerated when the cached
+                    // entry was stored by a spatial-distortion search
+                    if (tx_cache_hit)
+                        svt_aom_estimate_transform(&(((int16_t *)cand_bf->residual->buffer_y)[txb_origin_index]),
+                                                   cand_bf->residual->stride_y,
+                                                   &(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
+                                                   NOT_USED_VALUE,
+                                                   tx_size,
+                                                   &ctx->three_quad_energy,
+                                                   ctx->hbd_md ? EB_TEN_BIT : EB_EIGHT_BIT,
+                                                   tx_type,
+                                                   PLANE_TYPE_Y,
+                                                   pf_shape);
+                    svt_aom_picture_full_distortion32_bits_single(
+                        &(((int32_t *)ctx->tx_coeffs->buffer_y)[ctx->txb_1d_offset]),
+                        &(((int32_t *)recon_coeff_ptr->buffer_y)[ctx->txb_1d_offset]),
+                        txbwidth < 64 ? txbwidth : 32,
+                        bwidth,
+                        bheight,
+                        txb_full_distortion_txt[DIST_SSD][tx_type],
+                        eob_txt[tx_type]);
+                    if (tx_cache_entry) {
+                        tx_cache_entry->dist[DIST_CALC_RESIDUAL] =
+                            txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_RESIDUAL];
+                        tx_cache_entry->dist[DIST_CALC_PREDICTION] =
+                            txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_PREDICTION];
+                        tx_cache_entry->dist_valid = 1;
+                    }
+                }
                 txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_RESIDUAL] += ctx->three_quad_energy;
                 txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_PREDICTION] += ctx->three_quad_energy;
                 //assert(ctx->three_quad_energy == 0 && ctx->cu_stats->size < 64);
@@ -10531,6 +10677,8 @@ static void update_part_neighs(ModeDecisionContext *ctx) {
  */
 void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, ModeDecisionContext *ctx,
                               const MdcSbData *const mdc_sb_data) {
+    // Invalidate the tx_type_search cache entries of the previous SB / PD pass
+    ctx->tx_cache_epoch++;
     // Update neighbour arrays for the SB
     update_neighbour_arrays(pcs, ctx);
 
@@ -140,6 +140,8 @@ typedef struct RateControlContext {
     EbFifo *rate_control_input_tasks_fifo_ptr;
     EbFifo *rate_control_output_results_fifo_ptr;
     EbFifo *picture_decision_results_output_fifo_ptr;
+    // Workers scaling the pictures of the superres qthresh and auto modes
+    SvtJobPool *resize_job_pool;
 } RateControlContext;
 EbErrorType svt_aom_rate_control_coded_frames_stats_context_ctor(coded_frames_stats_entry *entry_ptr,
                                                                  uint64_t                  picture_number) {
@@ -151,6 +153,7 @@ EbErrorType svt_aom_rate_control_coded_frames_stats_context_ctor(coded_frames_st
 static void rate_control_context_dctor(EbPtr p) {
     EbThreadContext    *thread_ctx = (EbThreadContext *)p;
     RateControlContext *obj        = (RateControlContext *)thread_ctx->priv;
+    EB_DELETE(obj->resize_job_pool);
     EB_FREE_ARRAY(obj);
 }
 
@@ -168,7 +171,7 @@ EbErrorType svt_aom_rate_control_context_ctor(EbThreadContext *thread_ctx, const
     context_ptr->picture_decision_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
 
-    return EB_ErrorNone;
+    return svt_aom_create_resize_job_pool(&context_ptr->resize_job_pool, enc_handle_ptr->scs_instance_array[0]->scs);
 }
 
 #define MAX_Q_INDEX 255
@@ -1276,7 +1279,7 @@ void svt_aom_cyclic_refresh_init(PictureParentControlSet *ppcs) {
 
     uint16_t sb_cnt     = scs->sb_total_count;
     cr->percent_refresh = 20;
-    if (ppcs->picture_number > (uint64_t)(4 * (1 << scs->max_heirachical_level) * 100 / 20))
+    if (svt_aom_stream_picture_number(ppcs) > (uint64_t)(4 * (1 << scs->max_heirachical_level) * 100 / 20))
         cr->percent_refresh = 15;
     if (ppcs->sc_class1)
         cr->percent_refresh += 5;
@@ -1292,7 +1295,8 @@ void svt_aom_cyclic_refresh_init(PictureParentControlSet *ppcs) {
     // Use larger delta - qp(increase rate_ratio_qdelta) for first few(~4)
     // periods of the refresh cycle, after a key frame.
     cr->max_qdelta_perc = 60;
-    if (ppcs->picture_number > (uint64_t)(4 * (1 << scs->max_heirachical_level) * 100 / cr->percent_refresh))
+    if (svt_aom_stream_picture_number(ppcs) >
+        (uint64_t)(4 * (1 << scs->max_heirachical_level) * 100 / cr->percent_refresh))
         cr->rate_ratio_qdelta = 2;
     else
         cr->rate_ratio_qdelta = 3;
@@ -1650,6 +1654,8 @@ static void av1_rc_init(SequenceControlSet *scs) {
     } else {
         rc->onepass_cbr_mode = 0;
     }
+    rc->sb_rate_bits_ratio = 1.0;
+    for (i = 0; i < MAX_TEMPORAL_LAYERS + 1; ++i) rc->sb_rate_model_ratio[i] = 0;
     if (scs->static_config.rate_control_mode) {
         double frame_rate = (double)scs->static_config.frame_rate_numerator /
             (double)scs->static_config.frame_rate_denominator;
@@ -2140,7 +2146,7 @@ static int rc_pick_q_and_bounds_no_stats_cbr(PictureControlSet *pcs) {
     // if short intra refresh
     if (ip > -1 && ip < 256) {
         if (pcs->slice_type == I_SLICE) {
-            int q1 = pcs->picture_number == 0 ? q + 20 : rc->q_1_frame;
+            int q1 = svt_aom_is_stream_start(pcs->ppcs) ? q + 20 : rc->q_1_frame;
             q      = (q + q1) / 2;
         } else if (pcs->slice_type != I_SLICE && pcs->ppcs->temporal_layer_index == 0) {
             int qdelta = 0;
@@ -2233,6 +2239,21 @@ static int av1_estimate_bits_at_q(FrameType frame_type, int q, int mbs, double c
     return AOMMAX(FRAME_OVERHEAD_BITS, (int)((uint64_t)bpm * mbs) >> BPER_MB_NORMBITS);
 }
 
+// Frame size the rate model expects at base_q_idx, the target of the superblock rate control
+static int sb_rate_ctrl_expected_bits(PictureParentControlSet *ppcs) {
+    SequenceControlSet *scs    = ppcs->scs;
+    const int           width  = ppcs->av1_cm->frm_size.frame_width;
+    const int           height = ppcs->av1_cm->frm_size.frame_height;
+    const int           MBs    = ((width + 15) / 16) * ((height + 15) / 16);
+    return av1_estimate_bits_at_q(ppcs->frm_hdr.frame_type,
+                                  ppcs->frm_hdr.quantization_params.base_q_idx,
+                                  MBs,
+                                  get_rate_correction_factor(ppcs, width, height),
+                                  scs->static_config.encoder_bit_depth,
+                                  ppcs->sc_class1,
+                                  scs->enc_ctx->rc.onepass_cbr_mode);
+}
+
 static void av1_rc_update_rate_correction_factors(PictureParentControlSet *ppcs, int width, int height) {
     SequenceControlSet *scs                    = ppcs->scs;
     EncodeContext      *enc_ctx                = scs->enc_ctx;
@@ -2264,8 +2285,14 @@ static void av1_rc_update_rate_correction_factors(PictureParentControlSet *ppcs,
         ppcs->sc_class1,
         rc->onepass_cbr_mode);
     // Work out a size correction factor.
+    // The superblock rate control moves the qindex away from base_q_idx, the frame size is brought back to it
+    int64_t projected_frame_size = ppcs->projected_frame_size;
+    if (ppcs->sb_rate_ctrl_base_ratio != 1.0)
+        projected_frame_size = (int64_t)(projected_frame_size * ppcs->sb_rate_ctrl_base_ratio);
     if (projected_size_based_on_q > FRAME_OVERHEAD_BITS)
-        correction_factor = (int)((100 * (int64_t)ppcs->projected_frame_size) / projected_size_based_on_q);
+        correction_factor = (int)((100 * projected_frame_size) / projected_size_based_on_q);
+    if (ppcs->sb_rate_ctrl_md_bits > 0)
+        svt_aom_sb_rate_ctrl_feedback(ppcs);
 
     // More heavily damped adjustment used if we have been oscillating either side
     // of target.
@@ -2490,7 +2517,8 @@ static void vbr_rate_correction(PictureControlSet *pcs, int *this_frame_target)
     const int           stats_count         = twopass->stats_buf_ctx->total_stats != NULL
                           ? (int)twopass->stats_buf_ctx->total_stats->count
                           : 0;
-    const int           frame_window        = AOMMIN(16, (int)(stats_count - (int)pcs->picture_number));
+    const int           frame_window        = AOMMIN(
+        16, (int)(stats_count - (int)svt_aom_stream_picture_number(pcs->ppcs)));
     assert(VBR_PCT_ADJUSTMENT_LIMIT <= 100);
     if (frame_window > 0) {
         const int max_delta = (int)AOMMIN(abs((int)(vbr_bits_off_target / frame_window)),
@@ -3193,6 +3221,8 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
                             set_rc_buffer_sizes(scs);
                             av1_rc_init(scs);
                         }
+                        // once initialized, the rate control starts from the state of a resumed stream
+                        svt_aom_checkpoint_key_frame(pcs);
                         int32_t update_type = pcs->ppcs->update_type;
                         if (pcs->ppcs->tpl_ctrls.enable && pcs->ppcs->r0 != 0 &&
                             (update_type == SVT_AV1_KF_UPDATE || update_type == SVT_AV1_GF_UPDATE ||
@@ -3214,6 +3244,8 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
                 }
 
                 if (scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CQP_OR_CRF) {
+                    if (!is_superres_recode_task)
+                        svt_aom_checkpoint_key_frame(pcs);
                     // if RC mode is 0,  fixed QP is used
                     // QP scaling based on POC number for Flat IPPP structure
                     // make sure no run to run is cause
@@ -3395,7 +3427,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
                 if (scs->static_config.pass == ENC_SINGLE_PASS) {
                     if (scs->static_config.superres_mode > SUPERRES_RANDOM) {
                         // determine denom and scale down picture by selected denom
-                        svt_aom_init_resize_picture(scs, pcs->ppcs);
+                        svt_aom_init_resize_picture(scs, pcs->ppcs, context_ptr->resize_job_pool);
                         if (pcs->ppcs->frame_superres_enabled || pcs->ppcs->frame_resize_enabled) {
                             // reset gm based on super-res on/off
                             bool super_res_off = pcs->ppcs->frame_superres_enabled == FALSE &&
@@ -3409,8 +3441,8 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
                                  ++segment_index) {
                                 // Get Empty Results Object
                                 EbObjectWrapper *out_results_wrapper;
-                                svt_get_empty_object(context_ptr->picture_decision_results_output_fifo_ptr,
-                                                     &out_results_wrapper);
+                                EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->picture_decision_results_output_fifo_ptr,
+                                                    &out_results_wrapper);
 
                                 PictureDecisionResults *out_results = (PictureDecisionResults *)
                                                                           out_results_wrapper->object_ptr;
@@ -3471,11 +3503,13 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
                        scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CBR) {
                 cyclic_sb_qp_derivation(pcs);
             }
-
             if (pcs->scs->static_config.tune == 2 && !pcs->ppcs->frm_hdr.delta_q_params.delta_q_present) {
                 // enable sb level qindex when tune 2
                 pcs->ppcs->frm_hdr.delta_q_params.delta_q_present = 1;
             }
+            // In-frame rate control of CBR, moves the SB qindex during enc-dec
+            if (scs->static_config.sb_rate_control)
+                svt_aom_sb_rate_ctrl_init(pcs, sb_rate_ctrl_expected_bits(pcs->ppcs));
             if (scs->static_config.rate_control_mode && !is_superres_recode_task) {
                 svt_aom_update_rc_counts(pcs->ppcs);
             }
@@ -3484,7 +3518,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
             if (scs->stats_based_sb_lambda_modulation)
                 generate_b64_me_qindex_map(pcs);
             // Get Empty Rate Control Results Buffer
-            svt_get_empty_object(context_ptr->rate_control_output_results_fifo_ptr, &rc_results_wrapper);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->rate_control_output_results_fifo_ptr, &rc_results_wrapper);
             rc_results                  = (RateControlResults *)rc_results_wrapper->object_ptr;
             rc_results->pcs_wrapper     = rc_tasks->pcs_wrapper;
             rc_results->superres_recode = is_superres_recode_task;
@@ -104,6 +104,10 @@ typedef struct {
     int     kf_boost;
     double  rate_correction_factors[MAX_TEMPORAL_LAYERS + 1];
     int     onepass_cbr_mode; // 0: not 1pass cbr, 1: 1pass cbr for low delay
+    // sb_rate_control: bitstream bits per bit of mode decision rate, and mode decision rate at the base
+    // qindex over the frame size expected by the rate model, per rate_correction_factors level (0: unknown)
+    double  sb_rate_bits_ratio;
+    double  sb_rate_model_ratio[MAX_TEMPORAL_LAYERS + 1];
     int     baseline_gf_interval;
     int     constrained_gf_group;
     int     frames_to_key;
@@ -221,6 +225,10 @@ typedef struct PicMgrPorts {
 int32_t svt_av1_convert_qindex_to_q_fp8(int32_t qindex, EbBitDepth bit_depth);
 double  svt_av1_convert_qindex_to_q(int32_t qindex, EbBitDepth bit_depth);
 double  svt_av1_get_gfu_boost_projection_factor(double min_factor, double max_factor, int frame_count);
+int     svt_av1_rc_bits_per_mb(FrameType frame_type, int qindex, double correction_factor, const int bit_depth,
+                               const int is_screen_content_type, int onepass_cbr_mode);
+int     svt_av1_compute_qdelta_by_rate(const RATE_CONTROL *rc, FrameType frame_type, int qindex, double rate_target_ratio,
+                                       const int bit_depth, const int is_screen_content_type);
 
 EbErrorType svt_aom_rate_control_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr,
                                               int me_port_index);
@@ -290,6 +290,65 @@ EbErrorType svt_reference_object_reset(EbReferenceObject *ref_object, SequenceCo
     return EB_ErrorNone;
 }
 
+/*
+ * The downscaled copies are produced on demand for the scales the picture is referenced at. When the
+ * object is taken from the pool for a new picture nothing else accesses it: the copy produced last is
+ * kept, since the next pictures are usually scaled the same way and only need it refreshed, and the
+ * others are freed.
+ */
+void svt_reference_object_release_downscaled(EbReferenceObject *ref_object) {
+    uint64_t last_picture_number = 0;
+    int32_t  last_idx            = -1;
+    for (uint8_t sr_denom_idx = 0; sr_denom_idx < NUM_SR_SCALES + 1; sr_denom_idx++) {
+        for (uint8_t resize_denom_idx = 0; resize_denom_idx < NUM_RESIZE_SCALES + 1; resize_denom_idx++) {
+            if (ref_object->downscaled_reference_picture[sr_denom_idx][resize_denom_idx] != NULL &&
+                (last_idx < 0 ||
+                 ref_object->downscaled_picture_number[sr_denom_idx][resize_denom_idx] > last_picture_number)) {
+                last_picture_number = ref_object->downscaled_picture_number[sr_denom_idx][resize_denom_idx];
+                last_idx            = sr_denom_idx * (NUM_RESIZE_SCALES + 1) + resize_denom_idx;
+            }
+        }
+    }
+    for (uint8_t sr_denom_idx = 0; sr_denom_idx < NUM_SR_SCALES + 1; sr_denom_idx++) {
+        for (uint8_t resize_denom_idx = 0; resize_denom_idx < NUM_RESIZE_SCALES + 1; resize_denom_idx++) {
+            if (sr_denom_idx * (NUM_RESIZE_SCALES + 1) + resize_denom_idx == last_idx ||
+                ref_object->downscaled_reference_picture[sr_denom_idx][resize_denom_idx] == NULL)
+                continue;
+            EB_DELETE(ref_object->downscaled_reference_picture[sr_denom_idx][resize_denom_idx]);
+            ref_object->downscaled_picture_number[sr_denom_idx][resize_denom_idx] = (uint64_t)~0;
+        }
+    }
+}
+
+/*
+ * Same as svt_reference_object_release_downscaled() for the downscaled source pictures
+ */
+void svt_pa_reference_object_release_downscaled(EbPaReferenceObject *pa_ref_obj) {
+    uint64_t last_picture_number = 0;
+    int32_t  last_idx            = -1;
+    for (uint8_t sr_denom_idx = 0; sr_denom_idx < NUM_SR_SCALES + 1; sr_denom_idx++) {
+        for (uint8_t resize_denom_idx = 0; resize_denom_idx < NUM_RESIZE_SCALES + 1; resize_denom_idx++) {
+            if (pa_ref_obj->downscaled_input_padded_picture_ptr[sr_denom_idx][resize_denom_idx] != NULL &&
+                (last_idx < 0 ||
+                 pa_ref_obj->downscaled_picture_number[sr_denom_idx][resize_denom_idx] > last_picture_number)) {
+                last_picture_number = pa_ref_obj->downscaled_picture_number[sr_denom_idx][resize_denom_idx];
+                last_idx            = sr_denom_idx * (NUM_RESIZE_SCALES + 1) + resize_denom_idx;
+            }
+        }
+    }
+    for (uint8_t sr_denom_idx = 0; sr_denom_idx < NUM_SR_SCALES + 1; sr_denom_idx++) {
+        for (uint8_t resize_denom_idx = 0; resize_denom_idx < NUM_RESIZE_SCALES + 1; resize_denom_idx++) {
+            if (sr_denom_idx * (NUM_RESIZE_SCALES + 1) + resize_denom_idx == last_idx ||
+                pa_ref_obj->downscaled_input_padded_picture_ptr[sr_denom_idx][resize_denom_idx] == NULL)
+                continue;
+            EB_DELETE(pa_ref_obj->downscaled_input_padded_picture_ptr[sr_denom_idx][resize_denom_idx]);
+            EB_DELETE(pa_ref_obj->downscaled_quarter_downsampled_picture_ptr[sr_denom_idx][resize_denom_idx]);
+            EB_DELETE(pa_ref_obj->downscaled_sixteenth_downsampled_picture_ptr[sr_denom_idx][resize_denom_idx]);
+            pa_ref_obj->downscaled_picture_number[sr_denom_idx][resize_denom_idx] = (uint64_t)~0;
+        }
+    }
+}
+
 static void svt_pa_reference_object_dctor(EbPtr p) {
     EbPaReferenceObject *obj = (EbPaReferenceObject *)p;
     if (obj->dummy_obj)
@@ -307,6 +366,8 @@ static void svt_pa_reference_object_dctor(EbPtr p) {
             EB_DESTROY_MUTEX(obj->resize_mutex[sr_denom_idx][resize_denom_idx]);
         }
     }
+    svt_av1_hash_index_destroy(&obj->hash_index);
+    EB_DESTROY_MUTEX(obj->hash_index_mutex);
 }
 
 static void svt_tpl_reference_object_dctor(EbPtr p) {
@@ -409,6 +470,8 @@ EbErrorType svt_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_, EbPtr
             EB_CREATE_MUTEX(pa_ref_obj_->resize_mutex[sr_down_idx][resize_down_idx]);
         }
     }
+    pa_ref_obj_->hash_index_picture_number = (uint64_t)~0;
+    EB_CREATE_MUTEX(pa_ref_obj_->hash_index_mutex);
 
     return EB_ErrorNone;
 }
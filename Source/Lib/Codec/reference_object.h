@@ -16,6 +16,7 @@
 #include "object.h"
 #include "cabac_context_model.h"
 #include "coding_unit.h"
+#include "hash_motion.h"
 #include "sequence_control_set.h"
 
 typedef struct EbReferenceObject {
@@ -83,6 +84,11 @@ typedef struct EbPaReferenceObject {
     uint64_t             downscaled_picture_number[NUM_SR_SCALES + 1]
                                       [NUM_RESIZE_SCALES + 1]; // save the picture_number for each denom
     EbHandle resize_mutex[NUM_SR_SCALES + 1][NUM_RESIZE_SCALES + 1];
+    // block hash index of input_padded_pic for hash-based ME, built on first use and kept when the
+    // object is recycled so the next picture only rehashes what changed
+    HashIndex hash_index;
+    uint64_t  hash_index_picture_number;
+    EbHandle  hash_index_mutex;
     uint64_t picture_number;
     uint64_t avg_luma;
     uint8_t  dummy_obj;
@@ -108,6 +114,9 @@ typedef struct EbTplReferenceObjectDescInitData {
  **************************************/
 extern EbErrorType svt_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 extern EbErrorType svt_reference_object_reset(EbReferenceObject *obj, SequenceControlSet *scs);
+// Free the downscaled copies of a recycled object, except the one produced last
+void svt_reference_object_release_downscaled(EbReferenceObject *ref_object);
+void svt_pa_reference_object_release_downscaled(EbPaReferenceObject *pa_ref_obj);
 
 extern EbErrorType svt_pa_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 extern EbErrorType svt_tpl_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
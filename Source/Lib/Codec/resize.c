@@ -22,6 +22,7 @@
 #include "md_process.h"
 #include "enc_inter_prediction.h"
 #include "svt_log.h"
+#include "svt_threads.h"
 
 #define DIVIDE_AND_ROUND(x, y) (((x) + ((y) >> 1)) / (y))
 
@@ -732,6 +733,263 @@ EbErrorType svt_av1_highbd_resize_plane_horizontal(const uint16_t *const input,
     return EB_ErrorNone;
 }
 
+void svt_av1_resize_filter_rows_c(const uint8_t *const *rows, const int16_t *filter, uint8_t *output, int width) {
+    for (int x = 0; x < width; ++x) {
+        int sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+    }
+}
+
+void svt_av1_highbd_resize_filter_rows_c(const uint16_t *const *rows, const int16_t *filter, uint16_t *output,
+                                         int width, int bd) {
+    for (int x = 0; x < width; ++x) {
+        int sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
+    }
+}
+
+// Source rows per band of svt_aom_resize_plane_multi(). A band is resized to
+// every target before the next band is read, and bands are the threading unit.
+#define RESIZE_BAND_ROWS 64
+// 2:1 steps of a 16-bit dimension plus the final interpolation
+#define RESIZE_MAX_VERT_STEPS 17
+
+// One vertical step of resize_multistep(), applied to whole rows: a 2:1
+// decimation or an interpolation from in_len to out_len rows. Both are run
+// as 8-tap filters over clamped row indices.
+typedef struct ResizeVertStep {
+    int32_t        in_len;
+    int32_t        out_len;
+    Bool           down2;
+    int16_t        down2_filter[SUBPEL_TAPS];
+    const int16_t *interp_filters;
+    int32_t        delta;
+    int32_t        offset;
+} ResizeVertStep;
+
+typedef struct ResizeTargetPlan {
+    ResizePlaneTarget target;
+    int32_t           num_steps;
+    ResizeVertStep    steps[RESIZE_MAX_VERT_STEPS];
+    // rows of the input of each step held per band
+    int32_t max_rows[RESIZE_MAX_VERT_STEPS];
+} ResizeTargetPlan;
+
+typedef struct ResizeMultiJobs {
+    const uint8_t    *input;
+    int32_t           width;
+    int32_t           height;
+    int32_t           in_stride;
+    int32_t           bd;
+    ResizeTargetPlan *plans;
+    int32_t           num_targets;
+    int32_t           num_bands;
+    uint8_t          *scratch[SVT_JOBS_MAX_THREADS];
+} ResizeMultiJobs;
+
+static int32_t resize_vert_steps(int32_t length, int32_t olength, ResizeVertStep *steps) {
+    int32_t num_steps = 0;
+    if (length == olength)
+        return 0;
+    const int down2_steps = get_down2_steps(length, olength);
+    for (int s = 0; s < down2_steps; ++s) {
+        ResizeVertStep *step = &steps[num_steps++];
+        step->in_len         = length;
+        step->out_len        = get_down2_length(length, 1);
+        step->down2          = TRUE;
+        if (length & 1) {
+            // symodd taps i - 3 .. i + 3, the eighth tap is unused
+            for (int j = 0; j < 4; ++j) {
+                step->down2_filter[3 - j] = av1_down2_symodd_half_filter[j];
+                step->down2_filter[3 + j] = av1_down2_symodd_half_filter[j];
+            }
+            step->down2_filter[7] = 0;
+        } else {
+            // symeven taps i - 3 .. i + 4
+            for (int j = 0; j < 4; ++j) {
+                step->down2_filter[3 - j] = svt_aom_av1_down2_symeven_half_filter[j];
+                step->down2_filter[4 + j] = svt_aom_av1_down2_symeven_half_filter[j];
+            }
+        }
+        length = step->out_len;
+    }
+    if (length != olength) {
+        ResizeVertStep *step = &steps[num_steps++];
+        step->in_len         = length;
+        step->out_len        = olength;
+        step->down2          = FALSE;
+        step->interp_filters = &choose_interp_filter(length, olength)[0][0];
+        step->delta          = (((uint32_t)length << RS_SCALE_SUBPEL_BITS) + olength / 2) / olength;
+        step->offset         = length > olength
+                    ? (((int32_t)(length - olength) << (RS_SCALE_SUBPEL_BITS - 1)) + olength / 2) / olength
+                    : -(((int32_t)(olength - length) << (RS_SCALE_SUBPEL_BITS - 1)) + olength / 2) / olength;
+    }
+    return num_steps;
+}
+
+// First input row of the taps of output row x, and the filter applied to them
+static int32_t resize_step_taps(const ResizeVertStep *step, int32_t x, const int16_t **filter) {
+    if (step->down2) {
+        *filter = step->down2_filter;
+        return 2 * x - (SUBPEL_TAPS / 2 - 1);
+    }
+    const int32_t y = step->offset + RS_SCALE_EXTRA_OFF + step->delta * x;
+    *filter         = &step->interp_filters[((y >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK) * SUBPEL_TAPS];
+    return (y >> RS_SCALE_SUBPEL_BITS) - (SUBPEL_TAPS / 2 - 1);
+}
+
+// Input rows [*lo, *hi) read by output rows [a, b) of a step
+static void resize_step_input_rows(const ResizeVertStep *step, int32_t a, int32_t b, int32_t *lo, int32_t *hi) {
+    const int16_t *filter;
+    *lo = AOMMAX(resize_step_taps(step, a, &filter), 0);
+    *hi = AOMMIN(resize_step_taps(step, b - 1, &filter) + SUBPEL_TAPS - 1, step->in_len - 1) + 1;
+}
+
+// Rows [lo[k], hi[k]) of the input of each step needed by band, and in
+// lo[num_steps], hi[num_steps] the output rows of the target the band writes
+static void resize_band_rows(const ResizeTargetPlan *plan, int32_t band, int32_t num_bands, int32_t height,
+                             int32_t lo[RESIZE_MAX_VERT_STEPS + 1], int32_t hi[RESIZE_MAX_VERT_STEPS + 1]) {
+    const int32_t height2 = plan->target.height;
+    lo[plan->num_steps]   = (int32_t)((int64_t)band * RESIZE_BAND_ROWS * height2 / height);
+    hi[plan->num_steps]   = band + 1 == num_bands ? height2
+                                                  : (int32_t)((int64_t)(band + 1) * RESIZE_BAND_ROWS * height2 / height);
+    if (lo[plan->num_steps] >= hi[plan->num_steps])
+        return;
+    for (int32_t k = plan->num_steps - 1; k >= 0; --k)
+        resize_step_input_rows(&plan->steps[k], lo[k + 1], hi[k + 1], &lo[k], &hi[k]);
+}
+
+static size_t resize_plan_scratch_samples(const ResizeTargetPlan *plan) {
+    size_t samples = 0;
+    for (int32_t k = 0; k < plan->num_steps; ++k) samples += (size_t)plan->max_rows[k] * plan->target.width;
+    return samples;
+}
+
+static void resize_multi_band(void *ctx, int32_t thread_idx, int32_t band) {
+    const ResizeMultiJobs *jobs       = (const ResizeMultiJobs *)ctx;
+    const size_t           sample_sz  = jobs->bd > 8 ? sizeof(uint16_t) : sizeof(uint8_t);
+    uint8_t               *tmpbuf     = jobs->scratch[thread_idx];
+    uint8_t               *buf_start  = tmpbuf + jobs->width * sample_sz;
+    int32_t                lo[RESIZE_MAX_VERT_STEPS + 1], hi[RESIZE_MAX_VERT_STEPS + 1];
+    uint8_t               *bufs[RESIZE_MAX_VERT_STEPS];
+
+    for (int32_t t = 0; t < jobs->num_targets; ++t) {
+        const ResizeTargetPlan  *plan   = &jobs->plans[t];
+        const ResizePlaneTarget *target = &plan->target;
+        const int32_t            last   = plan->num_steps;
+        resize_band_rows(plan, band, jobs->num_bands, jobs->height, lo, hi);
+        if (lo[last] >= hi[last])
+            continue;
+        uint8_t *buf = buf_start;
+        for (int32_t k = 0; k < last; ++k) {
+            bufs[k] = buf;
+            buf += (size_t)plan->max_rows[k] * target->width * sample_sz;
+        }
+
+        // horizontal pass of the source rows the band reads
+        for (int32_t r = lo[0]; r < hi[0]; ++r) {
+            uint8_t *dst = last ? bufs[0] + (size_t)(r - lo[0]) * target->width * sample_sz
+                                : target->output + (size_t)r * target->stride * sample_sz;
+            if (jobs->bd > 8)
+                highbd_resize_multistep((const uint16_t *)jobs->input + (size_t)r * jobs->in_stride,
+                                        jobs->width,
+                                        (uint16_t *)dst,
+                                        target->width,
+                                        (uint16_t *)tmpbuf,
+                                        jobs->bd);
+            else
+                resize_multistep(
+                    jobs->input + (size_t)r * jobs->in_stride, jobs->width, dst, target->width, tmpbuf);
+        }
+
+        // vertical steps, one output row at a time across the full width
+        for (int32_t k = 0; k < last; ++k) {
+            const ResizeVertStep *step = &plan->steps[k];
+            for (int32_t x = lo[k + 1]; x < hi[k + 1]; ++x) {
+                const int16_t *filter;
+                const int32_t  first = resize_step_taps(step, x, &filter);
+                const uint8_t *rows[SUBPEL_TAPS];
+                for (int32_t i = 0; i < SUBPEL_TAPS; ++i) {
+                    const int32_t row = clamp(first + i, lo[k], hi[k] - 1);
+                    rows[i]           = bufs[k] + (size_t)(row - lo[k]) * target->width * sample_sz;
+                }
+                uint8_t *dst = k + 1 < last ? bufs[k + 1] + (size_t)(x - lo[k + 1]) * target->width * sample_sz
+                                            : target->output + (size_t)x * target->stride * sample_sz;
+                if (jobs->bd > 8) {
+                    const uint16_t *rows16[SUBPEL_TAPS];
+                    for (int32_t i = 0; i < SUBPEL_TAPS; ++i) rows16[i] = (const uint16_t *)rows[i];
+                    svt_av1_highbd_resize_filter_rows(rows16, filter, (uint16_t *)dst, target->width, jobs->bd);
+                } else
+                    svt_av1_resize_filter_rows(rows, filter, dst, target->width);
+            }
+        }
+    }
+}
+
+/*
+ * Resize one plane to several output sizes. Each band of RESIZE_BAND_ROWS
+ * source rows is scaled to all targets while it is in cache: a horizontal
+ * pass of the source rows the band reads, then the vertical steps row by row
+ * on band-sized intermediate buffers, so no column is ever gathered. Bands
+ * are independent and spread over the workers of job_pool. The output matches
+ * svt_av1_resize_plane() / svt_av1_highbd_resize_plane() for each target.
+ */
+EbErrorType svt_aom_resize_plane_multi(const uint8_t *input, int32_t height, int32_t width, int32_t in_stride,
+                                       const ResizePlaneTarget *targets, int32_t num_targets, int32_t bd,
+                                       SvtJobPool *job_pool) {
+    ResizeMultiJobs jobs;
+    const size_t    sample_sz = bd > 8 ? sizeof(uint16_t) : sizeof(uint8_t);
+    int32_t         lo[RESIZE_MAX_VERT_STEPS + 1], hi[RESIZE_MAX_VERT_STEPS + 1];
+    size_t          scratch_samples = 0;
+    EbErrorType     return_error    = EB_ErrorNone;
+
+    assert(width > 0);
+    assert(height > 0);
+    if (num_targets <= 0)
+        return EB_ErrorNone;
+    jobs.input       = input;
+    jobs.width       = width;
+    jobs.height      = height;
+    jobs.in_stride   = in_stride;
+    jobs.bd          = bd;
+    jobs.num_targets = num_targets;
+    jobs.num_bands   = (height + RESIZE_BAND_ROWS - 1) / RESIZE_BAND_ROWS;
+    EB_MALLOC_ARRAY(jobs.plans, num_targets);
+    if (jobs.plans == NULL)
+        return EB_ErrorInsufficientResources;
+    for (int32_t t = 0; t < num_targets; ++t) {
+        ResizeTargetPlan *plan = &jobs.plans[t];
+        assert(targets[t].width > 0);
+        assert(targets[t].height > 0);
+        plan->target    = targets[t];
+        plan->num_steps = resize_vert_steps(height, targets[t].height, plan->steps);
+        for (int32_t k = 0; k < plan->num_steps; ++k) plan->max_rows[k] = 0;
+        for (int32_t band = 0; band < jobs.num_bands; ++band) {
+            resize_band_rows(plan, band, jobs.num_bands, height, lo, hi);
+            if (lo[plan->num_steps] >= hi[plan->num_steps])
+                continue;
+            for (int32_t k = 0; k < plan->num_steps; ++k) plan->max_rows[k] = AOMMAX(plan->max_rows[k], hi[k] - lo[k]);
+        }
+        // targets are resized one after the other and share the band buffers
+        scratch_samples = AOMMAX(scratch_samples, resize_plan_scratch_samples(plan));
+    }
+
+    const int32_t thread_count = svt_job_pool_thread_count(job_pool, jobs.num_bands);
+    for (int32_t i = 0; i < thread_count; ++i) {
+        // the first width samples hold the horizontal multistep temporaries
+        EB_MALLOC_ARRAY(jobs.scratch[i], (width + scratch_samples) * sample_sz);
+        if (jobs.scratch[i] == NULL)
+            return_error = EB_ErrorInsufficientResources;
+    }
+    if (return_error == EB_ErrorNone)
+        svt_job_pool_run(job_pool, resize_multi_band, &jobs, jobs.num_bands);
+    for (int32_t i = 0; i < thread_count; ++i) EB_FREE_ARRAY(jobs.scratch[i]);
+    EB_FREE_ARRAY(jobs.plans);
+    return return_error;
+}
+
 void svt_aom_pack_highbd_pic(const EbPictureBufferDesc *pic_ptr, uint16_t *buffer_16bit[3], uint32_t ss_x,
                              uint32_t ss_y, Bool include_padding);
 
@@ -746,11 +1004,6 @@ void save_YUV_to_file_highbd(char *filename, uint16_t *buffer_y, uint16_t *buffe
                              uint16_t height, uint16_t stride_y, uint16_t stride_u, uint16_t stride_v, uint16_t org_y,
                              uint16_t org_x, uint32_t ss_x, uint32_t ss_y);
 #endif
-typedef EbErrorType (*Av1HighbdResizePlane)(const uint16_t *const input, int height, int width, int in_stride,
-                                            uint16_t *output, int height2, int width2, int out_stride, int bd);
-typedef EbErrorType (*Av1ResizePlane)(const uint8_t *const input, int height, int width, int in_stride, uint8_t *output,
-                                      int height2, int width2, int out_stride);
-
 static void pack_highbd_pic_2d(const EbPictureBufferDesc *pic_ptr, uint16_t *buffer_16bit[3], uint32_t ss_x,
                                uint32_t ss_y) {
     uint16_t width  = pic_ptr->stride_y;
@@ -820,23 +1073,43 @@ static void svt_aom_unpack_highbd_pic_2d(uint16_t *buffer_highbd[3], EbPictureBu
                           (height + ss_y) >> ss_y);
 }
 
+// Origin and stride of one plane of pic, in samples of highbd[] when it is set
+static uint8_t *resize_plane_origin(const EbPictureBufferDesc *pic, uint16_t *const highbd[MAX_MB_PLANE], int plane,
+                                    uint32_t ss_x, uint32_t ss_y, int32_t *stride) {
+    const uint32_t org_x  = plane ? pic->org_x >> ss_x : pic->org_x;
+    const uint32_t org_y  = plane ? pic->org_y >> ss_y : pic->org_y;
+    *stride               = plane == 0 ? pic->stride_y : plane == 1 ? pic->stride_cb : pic->stride_cr;
+    const size_t   offset = (size_t)org_y * *stride + org_x;
+    if (highbd)
+        return highbd[plane] ? (uint8_t *)(highbd[plane] + offset) : NULL;
+    uint8_t *buffer = plane == 0 ? pic->buffer_y : plane == 1 ? pic->buffer_cb : pic->buffer_cr;
+    return buffer ? buffer + offset : NULL;
+}
+
 /*
- * Resize frame according to dst resolution.
+ * Resize frame to the resolution of each of the num_dst dst frames, reading
+ * (and for unpacked 10-bit, packing) the source once for all of them.
  * Supports 8-bit / 10-bit and either packed or unpacked buffers
  */
-EbErrorType svt_aom_resize_frame(const EbPictureBufferDesc *src, EbPictureBufferDesc *dst, int bd, const int num_planes,
-                                 const uint32_t ss_x, const uint32_t ss_y, uint8_t is_packed,
-                                 uint32_t buffer_enable_mask, uint8_t is_2bcompress) {
-    uint16_t *src_buffer_highbd[MAX_MB_PLANE];
-    uint16_t *dst_buffer_highbd[MAX_MB_PLANE];
-
+EbErrorType svt_aom_resize_frame_multi(const EbPictureBufferDesc *src, EbPictureBufferDesc *const *dst,
+                                       int32_t num_dst, int bd, const int num_planes, const uint32_t ss_x,
+                                       const uint32_t ss_y, uint8_t is_packed, uint32_t buffer_enable_mask,
+                                       uint8_t is_2bcompress, SvtJobPool *job_pool) {
+    uint16_t         *src_buffer_highbd[MAX_MB_PLANE];
+    uint16_t         *dst_buffer_highbd[RESIZE_MAX_FRAMES][MAX_MB_PLANE];
+    ResizePlaneTarget targets[RESIZE_MAX_FRAMES];
+    EbErrorType       return_error = EB_ErrorNone;
+
+    assert(num_dst <= RESIZE_MAX_FRAMES);
     if (bd > 8 && !is_packed) {
         EB_MALLOC_ARRAY(src_buffer_highbd[0], src->luma_size);
         EB_MALLOC_ARRAY(src_buffer_highbd[1], src->chroma_size);
         EB_MALLOC_ARRAY(src_buffer_highbd[2], src->chroma_size);
-        EB_MALLOC_ARRAY(dst_buffer_highbd[0], dst->luma_size);
-        EB_MALLOC_ARRAY(dst_buffer_highbd[1], dst->chroma_size);
-        EB_MALLOC_ARRAY(dst_buffer_highbd[2], dst->chroma_size);
+        for (int32_t d = 0; d < num_dst; ++d) {
+            EB_MALLOC_ARRAY(dst_buffer_highbd[d][0], dst[d]->luma_size);
+            EB_MALLOC_ARRAY(dst_buffer_highbd[d][1], dst[d]->chroma_size);
+            EB_MALLOC_ARRAY(dst_buffer_highbd[d][2], dst[d]->chroma_size);
+        }
         if (is_2bcompress)
             svt_aom_pack_highbd_pic(src, src_buffer_highbd, ss_x, ss_y, TRUE);
         else
@@ -845,9 +1118,11 @@ EbErrorType svt_aom_resize_frame(const EbPictureBufferDesc *src, EbPictureBuffer
         src_buffer_highbd[0] = (uint16_t *)src->buffer_y;
         src_buffer_highbd[1] = (uint16_t *)src->buffer_cb;
         src_buffer_highbd[2] = (uint16_t *)src->buffer_cr;
-        dst_buffer_highbd[0] = (uint16_t *)dst->buffer_y;
-        dst_buffer_highbd[1] = (uint16_t *)dst->buffer_cb;
-        dst_buffer_highbd[2] = (uint16_t *)dst->buffer_cr;
+        for (int32_t d = 0; d < num_dst; ++d) {
+            dst_buffer_highbd[d][0] = (uint16_t *)dst[d]->buffer_y;
+            dst_buffer_highbd[d][1] = (uint16_t *)dst[d]->buffer_cb;
+            dst_buffer_highbd[d][2] = (uint16_t *)dst[d]->buffer_cr;
+        }
     }
 #if DEBUG_SCALING
     if (bd > 8)
@@ -881,175 +1156,145 @@ EbErrorType svt_aom_resize_frame(const EbPictureBufferDesc *src, EbPictureBuffer
 #endif
 
     for (int plane = 0; plane <= AOMMIN(num_planes, MAX_MB_PLANE - 1); ++plane) {
-        if (bd > 8) {
-            Av1HighbdResizePlane resize_plane_func = (src->height == dst->height)
-                ? svt_av1_highbd_resize_plane_horizontal
-                : svt_av1_highbd_resize_plane;
-            switch (plane) {
-            case 0:
-                if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) && src_buffer_highbd[0] && dst_buffer_highbd[0])
-                    resize_plane_func(src_buffer_highbd[0] + src->org_y * src->stride_y + src->org_x,
-                                      src->height,
-                                      src->width,
-                                      src->stride_y,
-                                      dst_buffer_highbd[0] + dst->org_y * dst->stride_y + dst->org_x,
-                                      dst->height,
-                                      dst->width,
-                                      dst->stride_y,
-                                      bd);
-                break;
-            case 1:
-                if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) && src_buffer_highbd[1] && dst_buffer_highbd[1])
-                    resize_plane_func(
-                        src_buffer_highbd[1] + (src->org_y >> ss_y) * src->stride_cb + (src->org_x >> ss_x),
-                        (src->height + ss_y) >> ss_y,
-                        (src->width + ss_x) >> ss_x,
-                        src->stride_cb,
-                        dst_buffer_highbd[1] + (dst->org_y >> ss_y) * dst->stride_cb + (dst->org_x >> ss_x),
-                        (dst->height + ss_y) >> ss_y,
-                        (dst->width + ss_x) >> ss_x,
-                        dst->stride_cb,
-                        bd);
-                break;
-            case 2:
-                if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) && src_buffer_highbd[2] && dst_buffer_highbd[2])
-                    resize_plane_func(
-                        src_buffer_highbd[2] + (src->org_y >> ss_y) * src->stride_cr + (src->org_x >> ss_x),
-                        (src->height + ss_y) >> ss_y,
-                        (src->width + ss_x) >> ss_x,
-                        src->stride_cr,
-                        dst_buffer_highbd[2] + (dst->org_y >> ss_y) * dst->stride_cr + (dst->org_x >> ss_x),
-                        (dst->height + ss_y) >> ss_y,
-                        (dst->width + ss_x) >> ss_x,
-                        dst->stride_cr,
-                        bd);
-                break;
-            default: break;
-            }
-        } else {
-            Av1ResizePlane resize_plane_func = (src->height == dst->height) ? svt_av1_resize_plane_horizontal
-                                                                            : svt_av1_resize_plane;
-            switch (plane) {
-            case 0:
-                if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) && src->buffer_y && dst->buffer_y)
-                    resize_plane_func(src->buffer_y + src->org_y * src->stride_y + src->org_x,
-                                      src->height,
-                                      src->width,
-                                      src->stride_y,
-                                      dst->buffer_y + dst->org_y * dst->stride_y + dst->org_x,
-                                      dst->height,
-                                      dst->width,
-                                      dst->stride_y);
-                break;
-            case 1:
-                if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) && src->buffer_cb && dst->buffer_cb)
-                    resize_plane_func(src->buffer_cb + (src->org_y >> ss_y) * src->stride_cb + (src->org_x >> ss_x),
-                                      (src->height + ss_y) >> ss_y,
-                                      (src->width + ss_x) >> ss_x,
-                                      src->stride_cb,
-                                      dst->buffer_cb + (dst->org_y >> ss_y) * dst->stride_cb + (dst->org_x >> ss_x),
-                                      (dst->height + ss_y) >> ss_y,
-                                      (dst->width + ss_x) >> ss_x,
-                                      dst->stride_cb);
-                break;
-            case 2:
-                if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) && src->buffer_cr && dst->buffer_cr)
-                    resize_plane_func(src->buffer_cr + (src->org_y >> ss_y) * src->stride_cr + (src->org_x >> ss_x),
-                                      (src->height + ss_y) >> ss_y,
-                                      (src->width + ss_x) >> ss_x,
-                                      src->stride_cr,
-                                      dst->buffer_cr + (dst->org_y >> ss_y) * dst->stride_cr + (dst->org_x >> ss_x),
-                                      (dst->height + ss_y) >> ss_y,
-                                      (dst->width + ss_x) >> ss_x,
-                                      dst->stride_cr);
-                break;
-            default: break;
-            }
+        const uint32_t plane_flag = plane == 0 ? PICTURE_BUFFER_DESC_Y_FLAG
+            : plane == 1                       ? PICTURE_BUFFER_DESC_Cb_FLAG
+                                               : PICTURE_BUFFER_DESC_Cr_FLAG;
+        const uint32_t sx         = plane ? ss_x : 0;
+        const uint32_t sy         = plane ? ss_y : 0;
+        int32_t        src_stride;
+        int32_t        num_targets = 0;
+        const uint8_t *input       = resize_plane_origin(
+            src, bd > 8 ? src_buffer_highbd : NULL, plane, ss_x, ss_y, &src_stride);
+        if (!(buffer_enable_mask & plane_flag) || input == NULL)
+            continue;
+        for (int32_t d = 0; d < num_dst; ++d) {
+            ResizePlaneTarget *target = &targets[num_targets];
+            target->output            = resize_plane_origin(
+                dst[d], bd > 8 ? dst_buffer_highbd[d] : NULL, plane, ss_x, ss_y, &target->stride);
+            target->width  = (dst[d]->width + sx) >> sx;
+            target->height = (dst[d]->height + sy) >> sy;
+            if (target->output)
+                ++num_targets;
         }
+        return_error = svt_aom_resize_plane_multi(input,
+                                                  (src->height + sy) >> sy,
+                                                  (src->width + sx) >> sx,
+                                                  src_stride,
+                                                  targets,
+                                                  num_targets,
+                                                  bd,
+                                                  job_pool);
+        if (return_error != EB_ErrorNone)
+            break;
     }
 
-    // padding before unpack to support 10-bit with 2b compressed format
-    if (bd > 8) {
-        if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) && dst_buffer_highbd[0])
-            svt_aom_generate_padding16_bit(
-                dst_buffer_highbd[0], dst->stride_y, dst->width, dst->height, dst->org_x, dst->org_y);
-        if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) && dst_buffer_highbd[1])
-            svt_aom_generate_padding16_bit(dst_buffer_highbd[1],
-                                           dst->stride_cb,
-                                           (dst->width + ss_x) >> ss_x,
-                                           (dst->height + ss_y) >> ss_y,
-                                           (dst->org_x + ss_x) >> ss_x,
-                                           (dst->org_y + ss_y) >> ss_y);
-        if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) && dst_buffer_highbd[2])
-            svt_aom_generate_padding16_bit(dst_buffer_highbd[2],
-                                           dst->stride_cb,
-                                           (dst->width + ss_x) >> ss_x,
-                                           (dst->height + ss_y) >> ss_y,
-                                           (dst->org_x + ss_x) >> ss_x,
-                                           (dst->org_y + ss_y) >> ss_y);
-    } else {
-        if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) && dst->buffer_y)
-            svt_aom_generate_padding(dst->buffer_y, dst->stride_y, dst->width, dst->height, dst->org_x, dst->org_y);
-        if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) && dst->buffer_cb)
-            svt_aom_generate_padding(dst->buffer_cb,
-                                     dst->stride_cb,
-                                     (dst->width + ss_x) >> ss_x,
-                                     (dst->height + ss_y) >> ss_y,
-                                     (dst->org_x + ss_x) >> ss_x,
-                                     (dst->org_y + ss_y) >> ss_y);
-        if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) && dst->buffer_cr)
-            svt_aom_generate_padding(dst->buffer_cr,
-                                     dst->stride_cr,
-                                     (dst->width + ss_x) >> ss_x,
-                                     (dst->height + ss_y) >> ss_y,
-                                     (dst->org_x + ss_x) >> ss_x,
-                                     (dst->org_y + ss_y) >> ss_y);
-    }
+    for (int32_t d = 0; d < num_dst; ++d) {
+        EbPictureBufferDesc *dst_pic = dst[d];
+        // padding before unpack to support 10-bit with 2b compressed format
+        if (bd > 8) {
+            if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) && dst_buffer_highbd[d][0])
+                svt_aom_generate_padding16_bit(dst_buffer_highbd[d][0],
+                                               dst_pic->stride_y,
+                                               dst_pic->width,
+                                               dst_pic->height,
+                                               dst_pic->org_x,
+                                               dst_pic->org_y);
+            if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) && dst_buffer_highbd[d][1])
+                svt_aom_generate_padding16_bit(dst_buffer_highbd[d][1],
+                                               dst_pic->stride_cb,
+                                               (dst_pic->width + ss_x) >> ss_x,
+                                               (dst_pic->height + ss_y) >> ss_y,
+                                               (dst_pic->org_x + ss_x) >> ss_x,
+                                               (dst_pic->org_y + ss_y) >> ss_y);
+            if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) && dst_buffer_highbd[d][2])
+                svt_aom_generate_padding16_bit(dst_buffer_highbd[d][2],
+                                               dst_pic->stride_cb,
+                                               (dst_pic->width + ss_x) >> ss_x,
+                                               (dst_pic->height + ss_y) >> ss_y,
+                                               (dst_pic->org_x + ss_x) >> ss_x,
+                                               (dst_pic->org_y + ss_y) >> ss_y);
+        } else {
+            if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG) && dst_pic->buffer_y)
+                svt_aom_generate_padding(dst_pic->buffer_y,
+                                         dst_pic->stride_y,
+                                         dst_pic->width,
+                                         dst_pic->height,
+                                         dst_pic->org_x,
+                                         dst_pic->org_y);
+            if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG) && dst_pic->buffer_cb)
+                svt_aom_generate_padding(dst_pic->buffer_cb,
+                                         dst_pic->stride_cb,
+                                         (dst_pic->width + ss_x) >> ss_x,
+                                         (dst_pic->height + ss_y) >> ss_y,
+                                         (dst_pic->org_x + ss_x) >> ss_x,
+                                         (dst_pic->org_y + ss_y) >> ss_y);
+            if ((buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG) && dst_pic->buffer_cr)
+                svt_aom_generate_padding(dst_pic->buffer_cr,
+                                         dst_pic->stride_cr,
+                                         (dst_pic->width + ss_x) >> ss_x,
+                                         (dst_pic->height + ss_y) >> ss_y,
+                                         (dst_pic->org_x + ss_x) >> ss_x,
+                                         (dst_pic->org_y + ss_y) >> ss_y);
+        }
 
 #if DEBUG_SCALING
-    if (bd > 8)
-        save_YUV_to_file_highbd("scaled_pic_highbd.yuv",
-                                dst_buffer_highbd[0],
-                                dst_buffer_highbd[1],
-                                dst_buffer_highbd[2],
-                                dst->width + dst->org_x * 2,
-                                dst->height + dst->org_y * 2,
-                                dst->stride_y,
-                                dst->stride_cb,
-                                dst->stride_cr,
-                                0,
-                                0,
-                                1,
-                                1);
-    else
-        save_YUV_to_file("scaled_pic.yuv",
-                         dst->buffer_y,
-                         dst->buffer_cb,
-                         dst->buffer_cr,
-                         dst->width + dst->org_x * 2,
-                         dst->height + dst->org_y * 2,
-                         dst->stride_y,
-                         dst->stride_cb,
-                         dst->stride_cr,
-                         0,
-                         0,
-                         1,
-                         1);
+        if (bd > 8)
+            save_YUV_to_file_highbd("scaled_pic_highbd.yuv",
+                                    dst_buffer_highbd[d][0],
+                                    dst_buffer_highbd[d][1],
+                                    dst_buffer_highbd[d][2],
+                                    dst_pic->width + dst_pic->org_x * 2,
+                                    dst_pic->height + dst_pic->org_y * 2,
+                                    dst_pic->stride_y,
+                                    dst_pic->stride_cb,
+                                    dst_pic->stride_cr,
+                                    0,
+                                    0,
+                                    1,
+                                    1);
+        else
+            save_YUV_to_file("scaled_pic.yuv",
+                             dst_pic->buffer_y,
+                             dst_pic->buffer_cb,
+                             dst_pic->buffer_cr,
+                             dst_pic->width + dst_pic->org_x * 2,
+                             dst_pic->height + dst_pic->org_y * 2,
+                             dst_pic->stride_y,
+                             dst_pic->stride_cb,
+                             dst_pic->stride_cr,
+                             0,
+                             0,
+                             1,
+                             1);
 #endif
+        if (bd > 8 && !is_packed) {
+            if (is_2bcompress)
+                svt_aom_unpack_highbd_pic(dst_buffer_highbd[d], dst_pic, ss_x, ss_y, TRUE);
+            else
+                svt_aom_unpack_highbd_pic_2d(dst_buffer_highbd[d], dst_pic, ss_x, ss_y);
+            EB_FREE(dst_buffer_highbd[d][0]);
+            EB_FREE(dst_buffer_highbd[d][1]);
+            EB_FREE(dst_buffer_highbd[d][2]);
+        }
+    }
     if (bd > 8 && !is_packed) {
-        if (is_2bcompress)
-            svt_aom_unpack_highbd_pic(dst_buffer_highbd, dst, ss_x, ss_y, TRUE);
-        else
-            svt_aom_unpack_highbd_pic_2d(dst_buffer_highbd, dst, ss_x, ss_y);
         EB_FREE(src_buffer_highbd[0]);
         EB_FREE(src_buffer_highbd[1]);
         EB_FREE(src_buffer_highbd[2]);
-        EB_FREE(dst_buffer_highbd[0]);
-        EB_FREE(dst_buffer_highbd[1]);
-        EB_FREE(dst_buffer_highbd[2]);
     }
 
-    return EB_ErrorNone;
+    return return_error;
+}
+
+/*
+ * Resize frame according to dst resolution.
+ * Supports 8-bit / 10-bit and either packed or unpacked buffers
+ */
+EbErrorType svt_aom_resize_frame(const EbPictureBufferDesc *src, EbPictureBufferDesc *dst, int bd, const int num_planes,
+                                 const uint32_t ss_x, const uint32_t ss_y, uint8_t is_packed,
+                                 uint32_t buffer_enable_mask, uint8_t is_2bcompress) {
+    return svt_aom_resize_frame_multi(
+        src, &dst, 1, bd, num_planes, ss_x, ss_y, is_packed, buffer_enable_mask, is_2bcompress, NULL);
 }
 
 // Generate a random number in the range [0, 32768).
@@ -1200,6 +1445,114 @@ static uint8_t get_superres_denom_for_qindex(SequenceControlSet *scs, PicturePar
     return denom;
 }
 
+// Relative gap to the best predicted cost below which a candidate can not be
+// ruled out by the model and is kept for the recode loop
+#define SUPERRES_MODEL_CONFIDENCE 0.1
+// Lower bound of the TPL propagation factor applied to the model lambda
+#define SUPERRES_MODEL_MIN_R0 0.25
+// Cost of a superres frame not explained by its spectrum (resampling, tools
+// disabled with superres), relative to the full resolution cost. Lower end of
+// what was measured against the recode loop at denom 9.
+#define SUPERRES_MODEL_FIXED_COST 0.2
+
+// Predicts the rate-distortion cost of coding a frame with the given denom
+// from the per coefficient energy of its horizontal frequency bins. Each bin
+// is modelled as a Gaussian source quantized with noise level theta: it costs
+// min(e, theta) distortion and max(0, log2(e / theta) / 2) bits. The bins
+// past the downscaled cut-off are lost (distortion e, no rate) and the kept
+// bins are coded on a SCALE_NUMERATOR / denom narrower picture.
+static double superres_model_cost(const double *energy, uint8_t denom, double theta, double lambda) {
+    // Same cut-off as get_superres_denom_from_qindex_energy()
+    const int first_lost = 3 * SCALE_NUMERATOR - denom;
+    double    dist       = 0;
+    double    rate       = 0;
+    for (int k = 1; k < 16; ++k) {
+        const double e = energy[k] - (k < 15 ? energy[k + 1] : 0);
+        if (k >= first_lost) {
+            dist += e;
+        } else {
+            dist += AOMMIN(e, theta);
+            rate += e > theta ? 0.5 * log2(e / theta) : 0;
+        }
+    }
+    return dist + lambda * rate * SCALE_NUMERATOR / denom;
+}
+
+/*
+ * Auto-dual and auto-all modes: rank the candidate denoms of a key or alt-ref frame with
+ * superres_model_cost() and only keep for the recode loop the ones too close to the best to
+ * be told apart by the model. The recode loop is skipped when a single candidate is left.
+ */
+static void superres_auto_model_search(superres_params_type *spr_params, SequenceControlSet *scs,
+                                       PictureParentControlSet *pcs, int qindex) {
+    const int32_t update_type = svt_aom_get_frame_update_type(scs, pcs);
+    if (update_type != SVT_AV1_KF_UPDATE && update_type != SVT_AV1_ARF_UPDATE)
+        return;
+
+    double energy[16];
+    analyze_hor_freq(pcs, energy);
+
+    // Quantization noise level in the energy domain, calibrated on the threshold of the q-based rule
+    const double energy_by_q2_thresh = get_energy_by_q2_thresh(&scs->enc_ctx->rc, update_type);
+    const double q                   = svt_av1_convert_qindex_to_q(qindex, EB_EIGHT_BIT);
+    const double theta               = AOMMAX(energy_by_q2_thresh * q * q, 1e-6);
+    // dD/dR of the model at high rate, lowered for frames whose detail is propagated by TPL
+    double lambda = 2 * log(2.0) * theta;
+    if (pcs->tpl_is_valid)
+        lambda *= AOMMAX(AOMMIN(pcs->r0, 1.0), SUPERRES_MODEL_MIN_R0);
+
+    uint8_t denoms[NUM_SR_SCALES + 1];
+    double  costs[NUM_SR_SCALES + 1];
+    int     num_denoms = 0;
+    if (scs->static_config.superres_auto_search_type == SUPERRES_AUTO_DUAL) {
+        // q-based denom against no superres
+        const uint8_t q_denom = get_superres_denom_from_qindex_energy(
+            qindex, energy, energy_by_q2_thresh, SUPERRES_ENERGY_BY_AC_THRESH);
+        denoms[num_denoms++] = AOMMAX(q_denom, SCALE_NUMERATOR + 1);
+        denoms[num_denoms++] = SCALE_NUMERATOR;
+    } else {
+        assert(scs->static_config.superres_auto_search_type == SUPERRES_AUTO_ALL);
+        for (int i = 0; i < NUM_SR_SCALES + 1; i++) denoms[num_denoms++] = SCALE_NUMERATOR + i;
+    }
+
+    const double full_res_cost = superres_model_cost(energy, SCALE_NUMERATOR, theta, lambda);
+    double       best_cost     = full_res_cost;
+    for (int i = 0; i < num_denoms; i++) {
+        costs[i] = denoms[i] == SCALE_NUMERATOR
+            ? full_res_cost
+            : superres_model_cost(energy, denoms[i], theta, lambda) + SUPERRES_MODEL_FIXED_COST * full_res_cost;
+        best_cost = AOMMIN(best_cost, costs[i]);
+    }
+
+    // Keep the uncertain candidates ordered by decreasing cost, so that the predicted best is
+    // coded last and does not need an extra loop when the recode confirms it
+    double kept_costs[NUM_SR_SCALES + 1];
+    int    num_kept = 0;
+    for (int i = 0; i < num_denoms; i++) {
+        if (costs[i] > best_cost * (1 + SUPERRES_MODEL_CONFIDENCE))
+            continue;
+        int j = num_kept++;
+        for (; j > 0 && kept_costs[j - 1] < costs[i]; --j) {
+            kept_costs[j]                = kept_costs[j - 1];
+            pcs->superres_denom_array[j] = pcs->superres_denom_array[j - 1];
+        }
+        kept_costs[j]                = costs[i];
+        pcs->superres_denom_array[j] = denoms[i];
+    }
+
+#if DEBUG_SUPERRES_ENERGY
+    printf("\nFrame %d. superres model theta %.2f lambda %.2f, kept %d candidates, best denom %d\n",
+           (int)pcs->picture_number,
+           theta,
+           lambda,
+           num_kept,
+           pcs->superres_denom_array[num_kept - 1]);
+#endif
+    spr_params->superres_denom = pcs->superres_denom_array[0];
+    if (num_kept > 1)
+        pcs->superres_total_recode_loop = num_kept;
+}
+
 /*
  * Given the superres configurations and the frame type, determine the denominator and
  * encoding resolution
@@ -1255,27 +1608,8 @@ static void calc_superres_params(superres_params_type *spr_params, SequenceContr
         } else {
             if (sr_search_type == SUPERRES_AUTO_SOLO) {
                 spr_params->superres_denom = get_superres_denom_for_qindex(scs, pcs, q, 1, 1);
-            } else if (sr_search_type == SUPERRES_AUTO_DUAL) {
-                pcs->superres_denom_array[0] = get_superres_denom_for_qindex(scs, pcs, q, 1, 1);
-                if (pcs->superres_denom_array[0] != SCALE_NUMERATOR) {
-                    pcs->superres_denom_array[1]    = SCALE_NUMERATOR;
-                    spr_params->superres_denom      = pcs->superres_denom_array[0];
-                    pcs->superres_total_recode_loop = 2;
-                }
-            } else { // SUPERRES_AUTO_ALL
-                assert(sr_search_type == SUPERRES_AUTO_ALL);
-                int32_t update_type = svt_aom_get_frame_update_type(scs, pcs);
-                if (update_type == SVT_AV1_KF_UPDATE || update_type == SVT_AV1_ARF_UPDATE) {
-                    for (int i = 0; i < NUM_SR_SCALES + 1; i++) {
-                        if (i < SCALE_NUMERATOR) {
-                            pcs->superres_denom_array[i] = SCALE_NUMERATOR + 1 + i;
-                        } else {
-                            pcs->superres_denom_array[i] = SCALE_NUMERATOR;
-                        }
-                    }
-                    spr_params->superres_denom      = pcs->superres_denom_array[0];
-                    pcs->superres_total_recode_loop = SCALE_NUMERATOR + 1;
-                }
+            } else {
+                superres_auto_model_search(spr_params, scs, pcs, q);
             }
         }
         break;
@@ -1483,12 +1817,30 @@ static EbErrorType allocate_downscaled_source_reference_pics(EbPictureBufferDesc
     return EB_ErrorNone;
 }
 
+// The picture decision, rate control and packetization processes can each scale
+// a picture in svt_aom_init_resize_picture() at the same time
+#define RESIZE_SCALING_PROCESSES 3
+
+EbErrorType svt_aom_create_resize_job_pool(SvtJobPool **job_pool, const SequenceControlSet *scs) {
+    const int32_t thread_count = AOMMAX(1, (int32_t)scs->core_count / RESIZE_SCALING_PROCESSES);
+    *job_pool                  = NULL;
+    if ((scs->static_config.resize_mode > RESIZE_NONE || scs->static_config.superres_mode > SUPERRES_NONE) &&
+        thread_count > 1)
+        EB_NEW(*job_pool, svt_job_pool_ctor, thread_count);
+    return EB_ErrorNone;
+}
+
+static void release_superres_recode_pics(PictureParentControlSet *pcs) {
+    for (int32_t i = 0; i <= NUM_SR_SCALES; ++i) EB_DELETE(pcs->superres_recode_pics[i]);
+}
+
 /*
  * Allocate memory and perform scaling of the source reference picture (references to the current picture)
  * and its decimated/filtered versions to match with the input picture resolution
  * This is used in the open-loop stage.
  */
-void scale_source_references(SequenceControlSet *scs, PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic) {
+void scale_source_references(SequenceControlSet *scs, PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic,
+                             SvtJobPool *job_pool) {
     EbPaReferenceObject *ref_object;
 
     uint8_t        sr_denom_idx          = svt_aom_get_denom_idx(pcs->superres_denom);
@@ -1541,15 +1893,17 @@ void scale_source_references(SequenceControlSet *scs, PictureParentControlSet *p
                         ref_object->downscaled_input_padded_picture_ptr[sr_denom_idx][resize_denom_idx];
 
                     // downsample input padded picture buffer
-                    svt_aom_resize_frame(ref_pic_ptr,
-                                         down_ref_pic_ptr,
-                                         8, // only 8-bit buffer needed for open-loop processing
-                                         num_planes,
-                                         ss_x,
-                                         ss_y,
-                                         0, // is_packed
-                                         PICTURE_BUFFER_DESC_LUMA_MASK, // buffer_enable_mask
-                                         0); // is_2bcompress
+                    svt_aom_resize_frame_multi(ref_pic_ptr,
+                                               &down_ref_pic_ptr,
+                                               1,
+                                               8, // only 8-bit buffer needed for open-loop processing
+                                               num_planes,
+                                               ss_x,
+                                               ss_y,
+                                               0, // is_packed
+                                               PICTURE_BUFFER_DESC_LUMA_MASK, // buffer_enable_mask
+                                               0, // is_2bcompress
+                                               job_pool);
 
                     // 1/4 & 1/16 input picture downsampling
                     svt_aom_downsample_filtering_input_picture(
@@ -1866,13 +2220,14 @@ static int validate_size_scales(RESIZE_MODE resize_mode, SUPERRES_MODE superres_
  * perform resizing of source picture and
  * adjust resolution related parameters
  */
-void svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSet *pcs) {
+void svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSet *pcs, SvtJobPool *job_pool) {
     EbPictureBufferDesc *input_pic = pcs->enhanced_unscaled_pic;
 
     superres_params_type spr_params = {input_pic->width, // encoding_width
                                        input_pic->height, // encoding_height
                                        scs->static_config.superres_denom};
-    Bool                 do_resize  = FALSE;
+    Bool                 do_resize         = FALSE;
+    Bool                 scale_recode_pics = FALSE;
 
     // step 1: calculate resized resolution
     pcs->resize_denom = SCALE_NUMERATOR;
@@ -1892,6 +2247,10 @@ void svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSe
         if (first_loop) { // first loop of multiple coding loop (auto-dual or auto-all mode) or the only loop (all the other modes)
             // determine super-res denom
             calc_superres_params(&spr_params, scs, pcs);
+            release_superres_recode_pics(pcs);
+            // without resize every loop scales the same source by its denom only
+            scale_recode_pics = scs->static_config.superres_mode == SUPERRES_AUTO &&
+                scs->static_config.resize_mode == RESIZE_NONE && pcs->superres_total_recode_loop > 1;
         } else {
             if (pcs->superres_recode_loop < pcs->superres_total_recode_loop) {
                 spr_params.superres_denom = pcs->superres_denom_array[pcs->superres_recode_loop];
@@ -1944,26 +2303,52 @@ void svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSe
         pcs->frame_superres_enabled = TRUE;
     }
 
-    if (do_resize) {
-        // Allocate downsampled picture buffer descriptor
-        svt_aom_downscaled_source_buffer_desc_ctor(&pcs->enhanced_downscaled_pic, input_pic, spr_params);
+    const int32_t recode_loop = pcs->superres_recode_loop;
+    if (do_resize && recode_loop > 0 && recode_loop < pcs->superres_total_recode_loop &&
+        pcs->superres_recode_pics[recode_loop]) {
+        // already scaled by the first loop
+        pcs->enhanced_downscaled_pic           = pcs->superres_recode_pics[recode_loop];
+        pcs->superres_recode_pics[recode_loop] = NULL;
+    } else if (do_resize || scale_recode_pics) {
+        EbPictureBufferDesc *downscaled_pics[RESIZE_MAX_FRAMES];
+        int32_t              num_downscaled = 0;
 
-        const int32_t  num_planes = av1_num_planes(&scs->seq_header.color_config);
-        const uint32_t ss_x       = scs->subsampling_x;
-        const uint32_t ss_y       = scs->subsampling_y;
+        // Allocate downsampled picture buffer descriptor
+        if (do_resize) {
+            svt_aom_downscaled_source_buffer_desc_ctor(&pcs->enhanced_downscaled_pic, input_pic, spr_params);
+            assert(pcs->enhanced_downscaled_pic);
+            downscaled_pics[num_downscaled++] = pcs->enhanced_downscaled_pic;
+        }
+        // scale the source to the denoms of the later loops in the same pass
+        if (scale_recode_pics) {
+            for (int32_t loop = 1; loop < pcs->superres_total_recode_loop; ++loop) {
+                superres_params_type recode_params = {
+                    input_pic->width, input_pic->height, pcs->superres_denom_array[loop]};
+                if (recode_params.superres_denom == SCALE_NUMERATOR)
+                    continue;
+                calculate_scaled_size_helper(&recode_params.encoding_width, recode_params.superres_denom);
+                svt_aom_downscaled_source_buffer_desc_ctor(&pcs->superres_recode_pics[loop], input_pic, recode_params);
+                assert(pcs->superres_recode_pics[loop]);
+                downscaled_pics[num_downscaled++] = pcs->superres_recode_pics[loop];
+            }
+        }
 
         // downsample picture buffer
-        assert(pcs->enhanced_downscaled_pic);
-        svt_aom_resize_frame(input_pic,
-                             pcs->enhanced_downscaled_pic,
-                             pcs->enhanced_downscaled_pic->bit_depth,
-                             num_planes,
-                             ss_x,
-                             ss_y,
-                             pcs->enhanced_downscaled_pic->packed_flag,
-                             PICTURE_BUFFER_DESC_FULL_MASK, // buffer_enable_mask
-                             1); // is_2bcompress
+        if (num_downscaled)
+            svt_aom_resize_frame_multi(input_pic,
+                                       downscaled_pics,
+                                       num_downscaled,
+                                       downscaled_pics[0]->bit_depth,
+                                       av1_num_planes(&scs->seq_header.color_config),
+                                       scs->subsampling_x,
+                                       scs->subsampling_y,
+                                       downscaled_pics[0]->packed_flag,
+                                       PICTURE_BUFFER_DESC_FULL_MASK, // buffer_enable_mask
+                                       1, // is_2bcompress
+                                       job_pool);
+    }
 
+    if (do_resize) {
         // use downscaled picture instead of original res for mode decision, encoding loop etc
         // after temporal filtering and motion estimation
         pcs->enhanced_pic = pcs->enhanced_downscaled_pic;
@@ -1973,7 +2358,7 @@ void svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSe
         scale_input_references(pcs, spr_params);
 
         if (pcs->slice_type != I_SLICE) {
-            scale_source_references(scs, pcs, pcs->enhanced_pic);
+            scale_source_references(scs, pcs, pcs->enhanced_pic, job_pool);
         }
     } else {
         // pcs previously might be used and dirty in params
@@ -37,7 +37,8 @@ typedef struct {
     uint8_t  superres_denom;
 } superres_params_type;
 
-void scale_source_references(SequenceControlSet *scs, PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic);
+void scale_source_references(SequenceControlSet *scs, PictureParentControlSet *pcs, EbPictureBufferDesc *input_pic,
+                             SvtJobPool *job_pool);
 
 void svt_aom_scale_rec_references(PictureControlSet *pcs, EbPictureBufferDesc *input_pic, uint8_t hbd_md);
 
@@ -52,8 +53,12 @@ void svt_aom_use_scaled_source_refs_if_needed(PictureParentControlSet *pcs, EbPi
 void scale_pcs_params(SequenceControlSet *scs, PictureParentControlSet *pcs, superres_params_type spr_params,
                       uint16_t source_width, uint16_t source_height);
 
-// resize picture for both super-res and scaling-ref
-void svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSet *pcs);
+// resize picture for both super-res and scaling-ref, on the workers of job_pool (may be NULL)
+void svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSet *pcs, SvtJobPool *job_pool);
+
+// Creates the workers svt_aom_init_resize_picture() uses for one calling process,
+// *job_pool stays NULL when pictures are never scaled or there is no core to share
+EbErrorType svt_aom_create_resize_job_pool(SvtJobPool **job_pool, const SequenceControlSet *scs);
 
 void svt_aom_reset_resized_picture(SequenceControlSet *scs, PictureParentControlSet *pcs,
                                    EbPictureBufferDesc *input_pic);
@@ -68,6 +73,26 @@ EbErrorType svt_aom_resize_frame(const EbPictureBufferDesc *src, EbPictureBuffer
                                  const uint32_t ss_x, const uint32_t ss_y, uint8_t is_packed,
                                  uint32_t buffer_enable_mask, uint8_t is_2bcompress);
 
+// Most frames svt_aom_resize_frame_multi() produces in one call
+#define RESIZE_MAX_FRAMES (NUM_SR_SCALES + 1)
+
+EbErrorType svt_aom_resize_frame_multi(const EbPictureBufferDesc *src, EbPictureBufferDesc *const *dst,
+                                       int32_t num_dst, int bd, const int num_planes, const uint32_t ss_x,
+                                       const uint32_t ss_y, uint8_t is_packed, uint32_t buffer_enable_mask,
+                                       uint8_t is_2bcompress, SvtJobPool *job_pool);
+
+// One output plane of svt_aom_resize_plane_multi(), samples are uint16_t when bd > 8
+typedef struct ResizePlaneTarget {
+    uint8_t *output;
+    int32_t  stride;
+    int32_t  width;
+    int32_t  height;
+} ResizePlaneTarget;
+
+EbErrorType svt_aom_resize_plane_multi(const uint8_t *input, int32_t height, int32_t width, int32_t in_stride,
+                                       const ResizePlaneTarget *targets, int32_t num_targets, int32_t bd,
+                                       SvtJobPool *job_pool);
+
 static INLINE int coded_to_superres_mi(int mi_col, int denom) {
     return (mi_col * denom + SCALE_NUMERATOR / 2) / SCALE_NUMERATOR;
 }
@@ -387,9 +387,9 @@ static EbErrorType reset_pcs_av1(PictureParentControlSet *pcs) {
     frm_hdr->primary_ref_frame = PRIMARY_REF_NONE;
     if (pcs->scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CBR &&
         pcs->scs->static_config.intra_period_length != -1) {
-        pcs->frame_offset = pcs->picture_number % (pcs->scs->static_config.intra_period_length + 1);
+        pcs->frame_offset = svt_aom_stream_picture_number(pcs) % (pcs->scs->static_config.intra_period_length + 1);
     } else
-        pcs->frame_offset = pcs->picture_number;
+        pcs->frame_offset = svt_aom_stream_picture_number(pcs);
     frm_hdr->error_resilient_mode            = 0;
     cm->tiles_info.uniform_tile_spacing_flag = 1;
     pcs->large_scale_tile                    = 0;
@@ -426,7 +426,7 @@ static EbErrorType reset_pcs_av1(PictureParentControlSet *pcs) {
 
     svt_aom_atomic_set_u32(&pcs->pa_me_done, 0);
 
-    svt_create_cond_var(&pcs->me_ready);
+    svt_set_cond_var(&pcs->me_ready, 0);
 
     SequenceControlSet *scs           = pcs->scs;
     pcs->me_segments_completion_count = 0;
@@ -560,6 +560,9 @@ void svt_aom_setup_two_pass(SequenceControlSet *scs) {
             svt_av1_init_second_pass(scs);
             //less than 200 frames or gop_constraint_rc, used in VBR and set in multipass encode
             scs->is_short_clip = scs->twopass.stats_buf_ctx->total_stats->count < 200 ? 1 : scs->is_short_clip;
+            // a resumed stream starts at the key frame of its checkpoint, init checked the statistics cover it
+            if (svt_aom_checkpoint_rebase_stats(scs) != EB_ErrorNone)
+                SVT_ERROR("failed to rebase the two pass statistics to the checkpoint key frame\n");
         }
     } else if (scs->lap_rc)
         svt_av1_init_single_pass_lap(scs);
@@ -777,7 +780,11 @@ static void set_eos_terminating_signals(PictureParentControlSet *pcs) {
     // if all the pictures are already processed, send the EOS signal to the app
     if (enc_ctx->total_number_of_shown_frames == enc_ctx->terminating_picture_number + 1) {
         EbObjectWrapper *tmp_out_str_wrp;
-        svt_get_empty_object(scs->enc_ctx->stream_output_fifo_ptr, &tmp_out_str_wrp);
+        if (svt_get_empty_object(scs->enc_ctx->stream_output_fifo_ptr, &tmp_out_str_wrp) != EB_ErrorNone) {
+            svt_release_mutex(enc_ctx->total_number_of_shown_frames_mutex);
+            svt_aom_post_error_packet(enc_ctx);
+            return;
+        }
         EbBufferHeaderType *tmp_out_str = (EbBufferHeaderType *)tmp_out_str_wrp->object_ptr;
 
         tmp_out_str->flags        = EB_BUFFERFLAG_EOS;
@@ -906,8 +913,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             // Copy previous Active SequenceControlSetPtr to a place holder
             prev_scs_wrapper = context_ptr->scs_active_array[instance_index];
             // Get empty SequenceControlSet [BLOCKING]
-            svt_get_empty_object(context_ptr->scs_empty_fifo_ptr_array[instance_index],
-                                 &context_ptr->scs_active_array[instance_index]);
+            EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->scs_empty_fifo_ptr_array[instance_index],
+                                &context_ptr->scs_active_array[instance_index]);
 
             // Copy the contents of the active SequenceControlSet into the new empty SequenceControlSet
             // if (scs->enc_ctx->initial_picture)
@@ -946,7 +953,11 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             : 1;
         for (uint8_t loop_index = 0; loop_index <= has_overlay && !end_of_sequence_flag; loop_index++) {
             // Get a New ParentPCS where we will hold the new input_picture
-            svt_get_empty_object(context_ptr->picture_control_set_fifo_ptr_array[instance_index], &pcs_wrapper);
+            if (svt_get_empty_object(context_ptr->picture_control_set_fifo_ptr_array[instance_index], &pcs_wrapper) !=
+                EB_ErrorNone) {
+                svt_aom_post_error_packet(scs->enc_ctx);
+                return NULL;
+            }
 
             // Parent PCS is released by the Rate Control after passing through
             // MDC->MD->ENCDEC->Packetization
@@ -1028,7 +1039,11 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 svt_aom_reset_resized_picture(scs, pcs, pcs->enhanced_pic);
             pcs->superres_total_recode_loop = 0;
             pcs->superres_recode_loop       = 0;
+            pcs->recode_count               = 0;
             svt_av1_get_time(&pcs->start_time_seconds, &pcs->start_time_u_seconds);
+            memset(pcs->deadline_time_us, 0, sizeof(pcs->deadline_time_us));
+            svt_aom_deadline_stamp(&scs->enc_ctx->deadline_ctrl,
+                                   &pcs->deadline_time_us[SVT_AV1_DEADLINE_STAGE_LOOKAHEAD]);
             pcs->seq_param_changed = (context_ptr->seq_param_change) ? true : false;
             // set the scs wrapper to be released after the picture is done
             pcs->scs_wrapper = context_ptr->scs_active_array[instance_index];
@@ -1049,7 +1064,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 EbObjectWrapper *input_pic_wrapper_ptr;
 
                 // Get a new input picture for overlay.
-                svt_get_empty_object(scs->enc_ctx->overlay_input_picture_pool_fifo_ptr, &input_pic_wrapper_ptr);
+                EB_GET_EMPTY_OBJECT(scs->enc_ctx, scs->enc_ctx->overlay_input_picture_pool_fifo_ptr,
+                                    &input_pic_wrapper_ptr);
                 // if resolution has changed, and the overlay_buffer_header settings do not match scs settings, update overlay_buffer_header settings
                 if (buffer_update_needed((EbBufferHeaderType *)input_pic_wrapper_ptr->object_ptr, scs))
                     svt_overlay_buffer_header_update(
@@ -1115,7 +1131,11 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             scs->enc_ctx->initial_picture = FALSE;
 
             // Get Empty Reference Picture Object
-            svt_get_empty_object(scs->enc_ctx->pa_reference_picture_pool_fifo_ptr, &ref_pic_wrapper);
+            if (svt_get_empty_object(scs->enc_ctx->pa_reference_picture_pool_fifo_ptr, &ref_pic_wrapper) !=
+                EB_ErrorNone) {
+                svt_aom_post_error_packet(scs->enc_ctx);
+                return NULL;
+            }
 
             pcs->pa_ref_pic_wrapper = ref_pic_wrapper;
             // make pa_ref full sample buffer access the luma8bit part from the y8b Pool
@@ -1124,6 +1144,7 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             if (pa_ref_obj->input_padded_pic->max_width != scs->max_input_luma_width ||
                 pa_ref_obj->input_padded_pic->max_height != scs->max_input_luma_height)
                 svt_pa_reference_param_update(pa_ref_obj, scs);
+            svt_pa_reference_object_release_downscaled(pa_ref_obj);
             EbPictureBufferDesc *input_padded_pic = (EbPictureBufferDesc *)pa_ref_obj->input_padded_pic;
             input_padded_pic->buffer_y            = buff_y8b;
             svt_object_inc_live_count(pcs->pa_ref_pic_wrapper, 1);
@@ -1178,8 +1199,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
 
                 reset_pcs_av1(ppcs_out);
                 if (!ppcs_out->end_of_sequence_flag) {
-                    svt_get_empty_object(context_ptr->resource_coordination_results_output_fifo_ptr,
-                                         &output_wrapper_ptr);
+                    EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->resource_coordination_results_output_fifo_ptr,
+                                        &output_wrapper_ptr);
                     out_results = (ResourceCoordinationResults *)output_wrapper_ptr->object_ptr;
 
                     if (scs->static_config.enable_overlays == TRUE) {
@@ -1208,8 +1229,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
 
                     reset_pcs_av1(ppcs_out);
 
-                    svt_get_empty_object(context_ptr->resource_coordination_results_output_fifo_ptr,
-                                         &output_wrapper_ptr);
+                    EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->resource_coordination_results_output_fifo_ptr,
+                                        &output_wrapper_ptr);
                     out_results = (ResourceCoordinationResults *)output_wrapper_ptr->object_ptr;
 
                     if (scs->static_config.enable_overlays == TRUE) {
@@ -1244,7 +1265,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
 
                 reset_pcs_av1(ppcs_out);
 
-                svt_get_empty_object(context_ptr->resource_coordination_results_output_fifo_ptr, &output_wrapper_ptr);
+                EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->resource_coordination_results_output_fifo_ptr,
+                                    &output_wrapper_ptr);
                 out_results = (ResourceCoordinationResults *)output_wrapper_ptr->object_ptr;
 
                 if (scs->static_config.enable_overlays == TRUE) {
@@ -731,7 +731,8 @@ void *svt_aom_rest_kernel(void *input_ptr) {
                 // post reference picture task in packetization process if it's superres_recode
                 if (pcs->ppcs->is_ref) {
                     // Get Empty PicMgr Results
-                    svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
+                    EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->picture_demux_fifo_ptr,
+                                        &picture_demux_results_wrapper_ptr);
 
                     picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
                     picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
@@ -750,7 +751,7 @@ void *svt_aom_rest_kernel(void *input_ptr) {
             for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
                 for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
                     const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
-                    svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
+                    EB_GET_EMPTY_OBJECT(scs->enc_ctx, context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
                     rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
                     rest_results->pcs_wrapper = cdef_results->pcs_wrapper;
                     rest_results->tile_index  = tile_idx;
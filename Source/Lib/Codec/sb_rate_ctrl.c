@@ -0,0 +1,289 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "sb_rate_ctrl.h"
+#include "pcs.h"
+#include "sequence_control_set.h"
+#include "encode_context.h"
+#include "rc_process.h"
+#include "md_process.h"
+#include "me_context.h"
+#include "utility.h"
+
+// Weight of the prediction against the coded rate, in 1/SB_RC_PRIOR_DIV of the target of the tile group
+#define SB_RC_PRIOR_DIV 8
+// Tolerance of the frame size around the target
+#define SB_RC_OVERSHOOT 1.5
+#define SB_RC_UNDERSHOOT 0.67
+// Range of the rate needed from the remaining SBs, against their rate at the base qindex; the rate
+// can be cut further when the frame is projected to overflow the buffer
+#define SB_RC_MIN_RATIO 0.5
+#define SB_RC_MIN_RATIO_OVERFLOW 0.125
+#define SB_RC_MAX_RATIO 2.0
+
+static INLINE uint32_t pic_width_in_sb(const PictureControlSet *pcs) {
+    const uint32_t sb_size = pcs->scs->sb_size;
+    return (pcs->ppcs->aligned_width + sb_size - 1) / sb_size;
+}
+
+// Sum of rate over the SBs coded before the SB (tx, ty) of the tile group whatever the number of
+// threads: the SBs on its left and, through the top-right dependency of the wavefront, the SBs of
+// the k-th row above up to column tx + k
+static int64_t causal_rate(const int64_t *rate, const TileGroupInfo *tg, uint32_t width, uint32_t tx, uint32_t ty) {
+    const int64_t *row = rate + (tg->tile_group_sb_start_y + ty) * width + tg->tile_group_sb_start_x;
+    int64_t        sum = tx ? row[tx - 1] : 0;
+    for (uint32_t k = 1; k <= ty; k++) {
+        row -= width;
+        sum += row[MIN(tx + k, (uint32_t)tg->tile_group_width_in_sb - 1)];
+    }
+    return sum;
+}
+
+static int64_t tile_group_rate(const int64_t *rate, const TileGroupInfo *tg, uint32_t width) {
+    int64_t sum = 0;
+    for (uint32_t y = tg->tile_group_sb_start_y; y < tg->tile_group_sb_end_y; y++)
+        sum += rate[y * width + tg->tile_group_sb_end_x - 1];
+    return sum;
+}
+
+static int64_t frame_rate(const PictureControlSet *pcs, const int64_t *rate) {
+    const PictureParentControlSet *ppcs  = pcs->ppcs;
+    const uint32_t                 width = pic_width_in_sb(pcs);
+    int64_t                        sum   = 0;
+    for (int tg = 0; tg < ppcs->tile_group_cols * ppcs->tile_group_rows; tg++)
+        sum += tile_group_rate(rate, &ppcs->tile_group_info[tg], width);
+    return sum;
+}
+
+// Level of the learnt ratios, as the rate correction factors of VBR
+static INLINE int model_level(const PictureParentControlSet *ppcs) {
+    return ppcs->frm_hdr.frame_type == KEY_FRAME ? 0 : ppcs->temporal_layer_index + 1;
+}
+
+void svt_aom_sb_rate_ctrl_init(PictureControlSet *pcs, int expected_bits) {
+    PictureParentControlSet *ppcs = pcs->ppcs;
+    SequenceControlSet      *scs  = ppcs->scs;
+    SbRateCtrl              *ctrl = &pcs->sb_rate_ctrl;
+
+    ppcs->sb_rate_ctrl_base_ratio = 1.0;
+    ppcs->sb_rate_ctrl_md_bits    = 0;
+    ctrl->recoded                 = FALSE;
+    ctrl->enabled                 = scs->static_config.sb_rate_control && expected_bits > 0;
+    if (!ctrl->enabled)
+        return;
+
+    RATE_CONTROL *rc      = &scs->enc_ctx->rc;
+    FrameHeader  *frm_hdr = &ppcs->frm_hdr;
+    const uint8_t res     = frm_hdr->delta_q_params.delta_q_res;
+    svt_aom_sb_rate_ctrl_rebase(pcs);
+    ctrl->min_qindex = MAX(res, quantizer_to_qindex[scs->static_config.min_qp_allowed]);
+    ctrl->max_qindex = MIN(255 - res, quantizer_to_qindex[scs->static_config.max_qp_allowed]);
+
+    // The frame size the rate model expects, and the size that keeps the buffer above its critical
+    // level once the frame is in, both moved to mode decision rate. The rate model shares its
+    // correction factor between the temporal layers, the SBs are held to what the frames of the layer
+    // usually take instead
+    const int64_t critical_level = rc->optimal_buffer_level >> 3;
+    const int64_t max_bits       = MAX(expected_bits, rc->buffer_level + rc->avg_frame_bandwidth - critical_level);
+    const double  model_ratio    = rc->sb_rate_model_ratio[model_level(ppcs)]
+              ? rc->sb_rate_model_ratio[model_level(ppcs)]
+              : 1.0 / rc->sb_rate_bits_ratio;
+    ppcs->sb_rate_ctrl_expected_bits = expected_bits;
+    ctrl->target_rate                = (int64_t)(((int64_t)expected_bits << AV1_PROB_COST_SHIFT) * model_ratio);
+    ctrl->max_rate = (int64_t)((max_bits << AV1_PROB_COST_SHIFT) / rc->sb_rate_bits_ratio);
+
+    // Complexity of the SBs: ME distortion, or the source variance for intra pictures. A share of
+    // the average is added, so that the static SBs are not left without bits
+    const uint32_t width        = pic_width_in_sb(pcs);
+    const uint8_t  sb_size_log2 = (uint8_t)svt_log2f(scs->sb_size);
+    int64_t       *weight       = ctrl->pred_rate;
+    memset(weight, 0, sizeof(*weight) * pcs->sb_total_count);
+    for (uint32_t b64_idx = 0; b64_idx < ppcs->b64_total_count; b64_idx++) {
+        const B64Geom *b64_geom = &ppcs->b64_geom[b64_idx];
+        const uint32_t sb_index = (b64_geom->org_y >> sb_size_log2) * width + (b64_geom->org_x >> sb_size_log2);
+        if (sb_index >= pcs->sb_total_count)
+            continue;
+        if (pcs->slice_type != I_SLICE)
+            weight[sb_index] += ppcs->me_8x8_distortion[b64_idx];
+        else if (scs->calculate_variance)
+            weight[sb_index] += ppcs->variance[b64_idx][ME_TIER_ZERO_PU_64x64];
+    }
+    int64_t total_weight = 0;
+    for (uint32_t sb_index = 0; sb_index < pcs->sb_total_count; sb_index++) total_weight += weight[sb_index];
+    const int64_t floor_weight = total_weight / pcs->sb_total_count / 4 + 1;
+    total_weight += floor_weight * pcs->sb_total_count;
+
+    // Predicted rate, summed along the rows of each tile group
+    for (int tg_idx = 0; tg_idx < ppcs->tile_group_cols * ppcs->tile_group_rows; tg_idx++) {
+        const TileGroupInfo *tg = &ppcs->tile_group_info[tg_idx];
+        for (uint32_t y = tg->tile_group_sb_start_y; y < tg->tile_group_sb_end_y; y++) {
+            int64_t sum = 0;
+            for (uint32_t x = tg->tile_group_sb_start_x; x < tg->tile_group_sb_end_x; x++) {
+                const uint32_t sb_index = y * width + x;
+                sum += (int64_t)((double)ctrl->target_rate * (weight[sb_index] + floor_weight) / total_weight);
+                ctrl->pred_rate[sb_index] = sum;
+            }
+        }
+    }
+}
+
+void svt_aom_sb_rate_ctrl_rebase(PictureControlSet *pcs) {
+    SbRateCtrl  *ctrl    = &pcs->sb_rate_ctrl;
+    FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
+
+    ctrl->delta_q_present = frm_hdr->delta_q_params.delta_q_present;
+    for (uint32_t sb_index = 0; sb_index < pcs->sb_total_count; sb_index++)
+        ctrl->base_qindex[sb_index] = ctrl->delta_q_present ? pcs->sb_ptr_array[sb_index]->qindex
+                                                            : frm_hdr->quantization_params.base_q_idx;
+    // The SB qindex is read during enc-dec only when delta_q_present is set; the flag is cleared once
+    // the frame is coded if no SB moved
+    frm_hdr->delta_q_params.delta_q_present = 1;
+}
+
+// The frame signals delta q only when the frame level rate control asked for it or a SB moved
+static void settle_delta_q(PictureControlSet *pcs) {
+    SbRateCtrl  *ctrl    = &pcs->sb_rate_ctrl;
+    FrameHeader *frm_hdr = &pcs->ppcs->frm_hdr;
+    Bool         present = ctrl->delta_q_present;
+    for (uint32_t sb_index = 0; !present && sb_index < pcs->sb_total_count; sb_index++)
+        present = pcs->sb_ptr_array[sb_index]->qindex != frm_hdr->quantization_params.base_q_idx;
+    frm_hdr->delta_q_params.delta_q_present = present;
+}
+
+uint8_t svt_aom_sb_rate_ctrl_qindex(PictureControlSet *pcs, uint16_t tile_group_index, uint32_t sb_index) {
+    PictureParentControlSet *ppcs  = pcs->ppcs;
+    SbRateCtrl              *ctrl  = &pcs->sb_rate_ctrl;
+    const TileGroupInfo     *tg    = &ppcs->tile_group_info[tile_group_index];
+    const uint32_t           width = pic_width_in_sb(pcs);
+    const uint32_t           tx    = sb_index % width - tg->tile_group_sb_start_x;
+    const uint32_t           ty    = sb_index / width - tg->tile_group_sb_start_y;
+    const uint8_t            base  = ctrl->base_qindex[sb_index];
+
+    // The coding loop adds the rate of the SB blocks
+    ctrl->coded_rate[sb_index] = tx ? ctrl->coded_rate[sb_index - 1] : 0;
+
+    const int64_t tg_target = tile_group_rate(ctrl->pred_rate, tg, width);
+    const int64_t pred      = causal_rate(ctrl->pred_rate, tg, width, tx, ty);
+    if (tg_target <= pred)
+        return base;
+    const int64_t spent      = causal_rate(ctrl->coded_rate, tg, width, tx, ty);
+    const int64_t spent_base = causal_rate(ctrl->coded_base_rate, tg, width, tx, ty);
+    const int64_t tg_max     = (int64_t)((double)ctrl->max_rate * tg_target / ctrl->target_rate);
+
+    // How far the prediction is off at the base qindex, trusted as more of the tile group is coded
+    const int64_t prior     = tg_target / SB_RC_PRIOR_DIV;
+    const double  ratio     = (double)(spent_base + prior) / (pred + prior);
+    const double  remaining = (tg_target - pred) * ratio;
+    const double  projected = spent + remaining;
+    // The qindex is only moved when the frame is projected out of the tolerance around the target,
+    // to bring it back to the edge of the tolerance
+    const double hi = MIN(tg_target * SB_RC_OVERSHOOT, (double)tg_max);
+    const double lo = tg_target * SB_RC_UNDERSHOOT;
+    double       needed;
+    if (projected > hi)
+        needed = MAX((hi - spent) / remaining, projected > tg_max ? SB_RC_MIN_RATIO_OVERFLOW : SB_RC_MIN_RATIO);
+    else if (projected < lo)
+        needed = MIN((lo - spent) / remaining, SB_RC_MAX_RATIO);
+    else
+        return base;
+
+    const int delta = svt_av1_compute_qdelta_by_rate(&ppcs->scs->enc_ctx->rc,
+                                                     ppcs->frm_hdr.frame_type,
+                                                     base,
+                                                     needed,
+                                                     ppcs->scs->static_config.encoder_bit_depth,
+                                                     ppcs->sc_class1);
+    return (uint8_t)CLIP3(ctrl->min_qindex, ctrl->max_qindex, base + delta);
+}
+
+void svt_aom_sb_rate_ctrl_update(PictureControlSet *pcs, uint16_t tile_group_index, uint32_t sb_index) {
+    PictureParentControlSet *ppcs   = pcs->ppcs;
+    SbRateCtrl              *ctrl   = &pcs->sb_rate_ctrl;
+    const TileGroupInfo     *tg     = &ppcs->tile_group_info[tile_group_index];
+    const uint32_t           tx     = sb_index % pic_width_in_sb(pcs) - tg->tile_group_sb_start_x;
+    const int64_t            left   = tx ? ctrl->coded_rate[sb_index - 1] : 0;
+    const int64_t            rate   = ctrl->coded_rate[sb_index] - left;
+    const uint8_t            base   = ctrl->base_qindex[sb_index];
+    const uint8_t            qindex = pcs->sb_ptr_array[sb_index]->qindex;
+
+    // Rate of the SB at its base qindex, from the rate model of the frame level rate control
+    double scale = 1.0;
+    if (qindex != base) {
+        const int bit_depth = ppcs->scs->static_config.encoder_bit_depth;
+        const int onepass   = ppcs->scs->enc_ctx->rc.onepass_cbr_mode;
+        scale = (double)svt_av1_rc_bits_per_mb(
+                    ppcs->frm_hdr.frame_type, base, 1.0, bit_depth, ppcs->sc_class1, onepass) /
+            MAX(svt_av1_rc_bits_per_mb(ppcs->frm_hdr.frame_type, qindex, 1.0, bit_depth, ppcs->sc_class1, onepass),
+                1);
+    }
+    ctrl->coded_base_rate[sb_index] = (tx ? ctrl->coded_base_rate[sb_index - 1] : 0) + (int64_t)(rate * scale);
+}
+
+Bool svt_aom_sb_rate_ctrl_recode(PictureControlSet *pcs) {
+    PictureParentControlSet *ppcs       = pcs->ppcs;
+    SequenceControlSet      *scs        = ppcs->scs;
+    SbRateCtrl              *ctrl       = &pcs->sb_rate_ctrl;
+    const int64_t            coded      = frame_rate(pcs, ctrl->coded_rate);
+    const int64_t            coded_base = frame_rate(pcs, ctrl->coded_base_rate);
+
+    // Lets the frame level rate control update its model at the base qindex
+    ppcs->sb_rate_ctrl_base_ratio = coded ? (double)coded_base / coded : 1.0;
+    ppcs->sb_rate_ctrl_md_bits    = coded >> AV1_PROB_COST_SHIFT;
+    if (ctrl->recoded || coded <= ctrl->max_rate || !coded_base) {
+        settle_delta_q(pcs);
+        return FALSE;
+    }
+
+    FrameHeader  *frm_hdr  = &ppcs->frm_hdr;
+    const uint8_t base_q   = frm_hdr->quantization_params.base_q_idx;
+    const double  needed   = CLIP3(SB_RC_MIN_RATIO_OVERFLOW, 1.0, (double)ctrl->target_rate / coded_base);
+    const int     delta    = MAX(1,
+                          svt_av1_compute_qdelta_by_rate(&scs->enc_ctx->rc,
+                                                         frm_hdr->frame_type,
+                                                         base_q,
+                                                         needed,
+                                                         scs->static_config.encoder_bit_depth,
+                                                         ppcs->sc_class1));
+    const uint8_t new_base = (uint8_t)CLIP3(ctrl->min_qindex, ctrl->max_qindex, base_q + delta);
+    if (new_base == base_q) {
+        settle_delta_q(pcs);
+        return FALSE;
+    }
+
+    ctrl->recoded                           = TRUE;
+    frm_hdr->quantization_params.base_q_idx = new_base;
+    ppcs->picture_qp                        = (uint8_t)CLIP3((int32_t)scs->static_config.min_qp_allowed,
+                                          (int32_t)scs->static_config.max_qp_allowed,
+                                          (new_base + 2) >> 2);
+    pcs->picture_qp                         = ppcs->picture_qp;
+    for (uint32_t sb_index = 0; sb_index < pcs->sb_total_count; sb_index++) {
+        ctrl->base_qindex[sb_index] = (uint8_t)CLIP3(
+            ctrl->min_qindex, ctrl->max_qindex, ctrl->base_qindex[sb_index] + new_base - base_q);
+        pcs->sb_ptr_array[sb_index]->qindex = ctrl->base_qindex[sb_index];
+    }
+    return TRUE;
+}
+
+void svt_aom_sb_rate_ctrl_feedback(PictureParentControlSet *ppcs) {
+    RATE_CONTROL *rc      = &ppcs->scs->enc_ctx->rc;
+    const double  md_bits = (double)ppcs->sb_rate_ctrl_md_bits;
+
+    rc->sb_rate_bits_ratio = (3 * rc->sb_rate_bits_ratio + CLIP3(0.25, 4.0, ppcs->projected_frame_size / md_bits)) / 4;
+
+    // A frame far off the model only moves the ratio of its level by a bounded step, the rate model
+    // follows it as well through its correction factor
+    double      *model_ratio = &rc->sb_rate_model_ratio[model_level(ppcs)];
+    const double ratio       = md_bits * ppcs->sb_rate_ctrl_base_ratio / MAX(ppcs->sb_rate_ctrl_expected_bits, 1);
+    *model_ratio = *model_ratio ? (3 * *model_ratio + CLIP3(*model_ratio / 2, *model_ratio * 2, ratio)) / 4 : ratio;
+}
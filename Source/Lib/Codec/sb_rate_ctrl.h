@@ -0,0 +1,68 @@
+/*
+* Copyright(c) 2024 Alliance for Open Media
+*
+* This source code is subject to the terms of the BSD 3-Clause Clear License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbSbRateCtrl_h
+#define EbSbRateCtrl_h
+
+#include "definitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct PictureControlSet;
+struct PictureParentControlSet;
+
+/*
+ * In-frame rate control of CBR (sb_rate_control)
+ * Rate control splits the frame size its model expects at the base qindex over the SBs, from the
+ * ME complexity. During enc-dec, the qindex of each SB is moved from the rate mode decision spent
+ * on the SBs that are always coded before it (the left SBs of the row and the wavefront above,
+ * within the tile group), so the result does not depend on the number of threads. The frame is
+ * recoded once, as a last resort, when it overflows the rate control buffer.
+ * Rates are in the (1 << AV1_PROB_COST_SHIFT) units of mode decision.
+ */
+typedef struct SbRateCtrl {
+    Bool    enabled;
+    Bool    recoded;
+    Bool    delta_q_present; // set by the frame level rate control
+    int64_t target_rate; // frame target
+    int64_t max_rate; // largest frame the buffer can take
+    uint8_t min_qindex;
+    uint8_t max_qindex;
+    // Per SB, sums along the SB row from the left edge of the tile group, up to and including the SB
+    int64_t *pred_rate; // predicted at the base qindex
+    int64_t *coded_rate; // spent by mode decision
+    int64_t *coded_base_rate; // spent by mode decision, brought back to the base qindex
+    uint8_t *base_qindex; // qindex of the SB set by the frame level rate control
+} SbRateCtrl;
+
+// Rate control: split the frame size expected at the base qindex over the SBs, after the frame level
+// SB qindex is set
+void svt_aom_sb_rate_ctrl_init(struct PictureControlSet *pcs, int expected_bits);
+// Enc-dec: take the SB qindex as the base again, after the frame level recode loop moved them
+void svt_aom_sb_rate_ctrl_rebase(struct PictureControlSet *pcs);
+// Enc-dec: qindex of the SB, from the rate spent so far
+uint8_t svt_aom_sb_rate_ctrl_qindex(struct PictureControlSet *pcs, uint16_t tile_group_index, uint32_t sb_index);
+// Enc-dec: account for the rate of a coded SB
+void svt_aom_sb_rate_ctrl_update(struct PictureControlSet *pcs, uint16_t tile_group_index, uint32_t sb_index);
+// Enc-dec: once all the SBs are coded, raise the base qindex when the frame overflows the buffer;
+// returns TRUE when the frame has to be recoded. Otherwise, delta_q_present is kept only when a SB
+// qindex differs from the base qindex
+Bool svt_aom_sb_rate_ctrl_recode(struct PictureControlSet *pcs);
+// Rate control: learn how the rate of mode decision relates to the bitstream and to the rate model,
+// from the size of a coded frame
+void svt_aom_sb_rate_ctrl_feedback(struct PictureParentControlSet *ppcs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbSbRateCtrl_h
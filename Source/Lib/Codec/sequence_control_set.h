@@ -82,6 +82,9 @@ typedef struct SequenceControlSet {
     /*!< CDF (The signal changes per preset; 0: CDF update, 1: no CDF update) Default is 0.*/
     uint8_t  cdf_mode;
     uint32_t svt_aom_geom_idx; //geometry type
+    /*!< Pipelined two pass, at the first pass encoder: the final pass encoder, whose SB size and block
+         geometry are kept, as the block geometry table is shared by the encoders of the process */
+    struct SequenceControlSet *final_pass_scs;
 
     /*  1..15    | 17..31  | 33..47  |
               16 |       32|       48|
@@ -192,6 +195,10 @@ typedef struct SequenceControlSet {
     uint32_t overlay_input_picture_buffer_init_count;
     uint32_t output_stream_buffer_fifo_init_count;
     uint32_t output_recon_buffer_fifo_init_count;
+    /*!< Memory of the encoder once the pools above are complete, estimated from one object of each pool */
+    uint64_t estimated_memory_bytes;
+    /*!< Buffer reduction steps applied to fit max_memory_mb (0: none), see apply_memory_budget_level() */
+    uint8_t mem_budget_level;
 
     /*!< Inter processes fifos count */
     uint32_t resource_coordination_fifo_init_count;
@@ -232,6 +239,7 @@ typedef struct SequenceControlSet {
     VqCtrls      vq_ctrls;
     uint8_t      calc_hist;
     TfControls   tf_params_per_type[3]; // [I_SLICE][BASE][L1]
+    TfControls   deadline_tf_params[MAX_ENC_PRESET + 2][3]; // [enc_mode - static enc_mode][I_SLICE][BASE][L1]
     MrpCtrls     mrp_ctrls;
     /*!< The RC stat generation pass mode (0: The default, 1: optimized)*/
     uint8_t rc_stat_gen_pass_mode;
@@ -1317,7 +1317,11 @@ static Bool assign_tpl_segments(EncDecSegments *segmentPtr, uint16_t *segmentInO
         if (feedback_row_index > 0) {
             EbObjectWrapper *out_results_wrapper;
 
-            svt_get_empty_object(srmFifoPtr, &out_results_wrapper);
+            if (svt_get_empty_object(srmFifoPtr, &out_results_wrapper) != EB_ErrorNone) {
+                // The pipeline stopped, the rows are not fed back anymore
+                svt_aom_post_error_packet(taskPtr->pcs->scs->enc_ctx);
+                return continue_processing_flag;
+            }
 
             TplDispResults *out_results = (TplDispResults *)out_results_wrapper->object_ptr;
             out_results->input_type     = TPL_TASKS_ENCDEC_INPUT;
@@ -1345,9 +1349,9 @@ static Bool assign_tpl_segments(EncDecSegments *segmentPtr, uint16_t *segmentInO
  ** LAD Window: sliding window size
  ************************************************/
 
-static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *scs, int32_t *base_rdmult,
-                                  PictureParentControlSet *pcs, int32_t frame_idx,
-                                  SourceBasedOperationsContext *context_ptr) {
+static EbErrorType tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *scs, int32_t *base_rdmult,
+                                         PictureParentControlSet *pcs, int32_t frame_idx,
+                                         SourceBasedOperationsContext *context_ptr) {
     EbPictureBufferDesc *recon_pic = enc_ctx->mc_flow_rec_picture_buffer[frame_idx];
 
     int32_t qIndex = quantizer_to_qindex[(uint8_t)scs->static_config.qp];
@@ -1381,7 +1385,9 @@ static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *sc
             EbObjectWrapper *out_results_wrapper;
 
             // TPL dispenser kernel
-            svt_get_empty_object(context_ptr->sbo_output_fifo_ptr, &out_results_wrapper);
+            EbErrorType return_error = svt_get_empty_object(context_ptr->sbo_output_fifo_ptr, &out_results_wrapper);
+            if (return_error != EB_ErrorNone)
+                return return_error;
 
             TplDispResults *out_results = (TplDispResults *)out_results_wrapper->object_ptr;
             // out_results->pcs_wrapper = pcs->p_pcs_wrapper_ptr;
@@ -1395,6 +1401,9 @@ static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *sc
             svt_post_full_object(out_results_wrapper);
 
             svt_block_on_semaphore(pcs->tpl_disp_done_semaphore); // we can do all in // ?
+            // Woken by a stopped pipeline, the segments are not all done
+            if (svt_aom_pipeline_stopped(enc_ctx))
+                return EB_ErrorUndefined;
         }
     }
 
@@ -1406,7 +1415,7 @@ static void tpl_mc_flow_dispenser(EncodeContext *enc_ctx, SequenceControlSet *sc
                              recon_pic->org_x,
                              recon_pic->org_y);
 
-    return;
+    return EB_ErrorNone;
 }
 
 static int get_overlap_area(int grid_pos_row, int grid_pos_col, int ref_pos_row, int ref_pos_col, int block,
@@ -1796,6 +1805,9 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
     }
     // wait for PA ME to be done.
     for (uint32_t i = 1; i < pcs->tpl_group_size; i++) { svt_wait_cond_var(&pcs->tpl_group[i]->me_ready, 0); }
+    // Woken by a stopped pipeline, the ME of the group is not all done
+    if (svt_aom_pipeline_stopped(enc_ctx))
+        return EB_ErrorUndefined;
     pcs->tpl_is_valid = 0;
     init_tpl_buffers(enc_ctx);
 
@@ -1815,7 +1827,10 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
             // NREF need recon buffer for intra pred
             EbObjectWrapper *ref_pic_wrapper;
             // Get Empty Reference Picture Object
-            svt_get_empty_object(scs->enc_ctx->tpl_reference_picture_pool_fifo_ptr, &ref_pic_wrapper);
+            EbErrorType return_error = svt_get_empty_object(scs->enc_ctx->tpl_reference_picture_pool_fifo_ptr,
+                                                            &ref_pic_wrapper);
+            if (return_error != EB_ErrorNone)
+                return return_error;
             // if resolution has changed, and the tpl_reference_picture settings do not match scs settings, update tpl reference params
             if (((EbTplReferenceObject *)ref_pic_wrapper->object_ptr)->ref_picture_ptr->max_width !=
                     scs->max_input_luma_width ||
@@ -1845,13 +1860,16 @@ static EbErrorType tpl_mc_flow(EncodeContext *enc_ctx, SequenceControlSet *scs,
                        (picture_width_in_mb) * sizeof(TplStats));
             }
             tpl_on = pcs->tpl_valid_pic[frame_idx];
-            if (tpl_on)
-                tpl_mc_flow_dispenser(enc_ctx,
-                                      scs,
-                                      &pcs->tpl_group[frame_idx]->pa_me_data->base_rdmult,
-                                      pcs->tpl_group[frame_idx],
-                                      frame_idx,
-                                      context_ptr);
+            if (tpl_on) {
+                return_error = tpl_mc_flow_dispenser(enc_ctx,
+                                                     scs,
+                                                     &pcs->tpl_group[frame_idx]->pa_me_data->base_rdmult,
+                                                     pcs->tpl_group[frame_idx],
+                                                     frame_idx,
+                                                     context_ptr);
+                if (return_error != EB_ErrorNone)
+                    return return_error;
+            }
 
             if (scs->tpl_lad_mg > 0)
                 if (tpl_on)
@@ -2083,12 +2101,15 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
     return NULL;
 }
 
-static void sbo_send_picture_out(SourceBasedOperationsContext *context_ptr, PictureParentControlSet *pcs,
-                                 Bool superres_recode) {
+static EbErrorType sbo_send_picture_out(SourceBasedOperationsContext *context_ptr, PictureParentControlSet *pcs,
+                                        Bool superres_recode) {
     EbObjectWrapper *out_results_wrapper;
 
     // Get Empty Results Object
-    svt_get_empty_object(context_ptr->picture_demux_results_output_fifo_ptr, &out_results_wrapper);
+    EbErrorType return_error = svt_get_empty_object(context_ptr->picture_demux_results_output_fifo_ptr,
+                                                    &out_results_wrapper);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
     PictureDemuxResults *out_results = (PictureDemuxResults *)out_results_wrapper->object_ptr;
     out_results->pcs_wrapper         = pcs->p_pcs_wrapper_ptr;
@@ -2096,6 +2117,7 @@ static void sbo_send_picture_out(SourceBasedOperationsContext *context_ptr, Pict
 
     // Post the Full Results Object
     svt_post_full_object(out_results_wrapper);
+    return EB_ErrorNone;
 }
 
 // This is used as a reference when computing the source variance for the
@@ -2222,7 +2244,10 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
         PictureParentControlSet   *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
         SequenceControlSet        *scs            = pcs->scs;
         if (in_results_ptr->superres_recode) {
-            sbo_send_picture_out(context_ptr, pcs, TRUE);
+            if (sbo_send_picture_out(context_ptr, pcs, TRUE) != EB_ErrorNone) {
+                svt_aom_post_error_packet(scs->enc_ctx);
+                return NULL;
+            }
 
             // Release the Input Results
             svt_release_object(in_results_wrapper_ptr);
@@ -2234,7 +2259,10 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
             // tpl ME can be performed on unscaled frames in super-res q-threshold and auto mode
             if (!pcs->frame_superres_enabled && pcs->temporal_layer_index == 0) {
                 tpl_prep_info(pcs);
-                tpl_mc_flow(scs->enc_ctx, scs, pcs, context_ptr);
+                if (tpl_mc_flow(scs->enc_ctx, scs, pcs, context_ptr) != EB_ErrorNone) {
+                    svt_aom_post_error_packet(scs->enc_ctx);
+                    return NULL;
+                }
             }
             Bool release_pa_ref = (scs->static_config.superres_mode <= SUPERRES_RANDOM) ? TRUE : FALSE;
             // Release Pa Ref if lad_mg is 0 and P slice and not flat struct (not belonging to any TPL group)
@@ -2247,7 +2275,10 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
         if (scs->static_config.tune == 2) {
             aom_av1_set_mb_ssim_rdmult_scaling(pcs);
         }
-        sbo_send_picture_out(context_ptr, pcs, FALSE);
+        if (sbo_send_picture_out(context_ptr, pcs, FALSE) != EB_ErrorNone) {
+            svt_aom_post_error_packet(scs->enc_ctx);
+            return NULL;
+        }
 
         // Release the Input Results
         svt_release_object(in_results_wrapper_ptr);
@@ -20,6 +20,16 @@ void svt_print_alloc_fail_impl(const char* file, int line) {
     SVT_FATAL("allocate memory failed, at %s:%d\n", file, line);
 }
 
+#ifdef _MSC_VER
+static __declspec(thread) uint64_t thread_alloc_bytes;
+#else
+static __thread uint64_t thread_alloc_bytes;
+#endif
+
+void svt_add_thread_alloc_bytes(size_t size) { thread_alloc_bytes += size; }
+
+uint64_t svt_get_thread_alloc_bytes(void) { return thread_alloc_bytes; }
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static EbHandle g_malloc_mutex;
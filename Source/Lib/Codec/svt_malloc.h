@@ -62,12 +62,21 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 
 #endif //DEBUG_MEMORY_USAGE
 
+/* Bytes allocated by the calling thread through the macros below. The encoder
+ * allocates its pools and contexts from the thread calling svt_av1_enc_init(),
+ * so the difference between two reads attributes memory to what was created
+ * in between, without tracking individual allocations. */
+void     svt_add_thread_alloc_bytes(size_t size);
+uint64_t svt_get_thread_alloc_bytes(void);
+
 #define EB_NO_THROW_ADD_MEM(p, size, type)            \
     do {                                              \
         if (!p)                                       \
             svt_print_alloc_fail(__FILE__, __LINE__); \
-        else                                          \
+        else {                                        \
             EB_ADD_MEM_ENTRY(p, type, size);          \
+            svt_add_thread_alloc_bytes(size);         \
+        }                                             \
     } while (0)
 
 #define EB_CHECK_MEM(p)                           \
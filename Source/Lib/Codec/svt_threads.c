@@ -25,6 +25,11 @@
 #define EB_THREAD_SANITIZER_ENABLED 0
 #endif
 
+// Needed for pthread_setname_np
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 /****************************************
  * Universal Includes
  ****************************************/
@@ -178,6 +183,25 @@ EbHandle svt_create_thread(void *thread_function(void *), void *thread_context)
     return thread_handle;
 }
 
+/****************************************
+ * svt_set_thread_name
+ *  Names the thread after its pipeline stage so that per-stage CPU time
+ *  can be read by profilers and by /proc/<pid>/task/<tid>/comm.
+ *  The name is truncated to 15 characters on Linux.
+ ****************************************/
+void svt_set_thread_name(EbHandle thread_handle, const char *name) {
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (thread_handle == NULL)
+        return;
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%s", name);
+    pthread_setname_np(*((pthread_t *)thread_handle), buf);
+#else
+    (void)thread_handle;
+    (void)name;
+#endif
+}
+
 ///****************************************
 // * svt_start_thread
 // ****************************************/
@@ -400,6 +424,88 @@ EbErrorType svt_destroy_mutex(EbHandle mutex_handle) {
 
     return return_error;
 }
+static int32_t svt_jobs_thread_count(int32_t thread_count, int32_t num_jobs) {
+    thread_count = thread_count < num_jobs ? thread_count : num_jobs;
+    return thread_count < 1 ? 1 : thread_count > SVT_JOBS_MAX_THREADS ? SVT_JOBS_MAX_THREADS : thread_count;
+}
+
+typedef struct SvtJobWorker {
+    SvtJobPool *pool;
+    int32_t     thread_idx;
+    EbHandle    thread;
+    EbHandle    start_semaphore;
+} SvtJobWorker;
+
+static void run_worker_jobs(SvtJobPool *pool, int32_t thread_idx) {
+    for (int32_t job = thread_idx; job < pool->num_jobs; job += pool->active_count)
+        pool->fn(pool->ctx, thread_idx, job);
+}
+
+static void *svt_job_worker_kernel(void *input_ptr) {
+    SvtJobWorker *worker = (SvtJobWorker *)input_ptr;
+    SvtJobPool   *pool   = worker->pool;
+    for (;;) {
+        svt_block_on_semaphore(worker->start_semaphore);
+        if (pool->quit)
+            break;
+        run_worker_jobs(pool, worker->thread_idx);
+        svt_post_semaphore(pool->done_semaphore);
+    }
+    return NULL;
+}
+
+static void svt_job_pool_dctor(EbPtr p) {
+    SvtJobPool *pool = (SvtJobPool *)p;
+    if (!pool->workers)
+        return;
+    pool->quit = TRUE;
+    for (int32_t t = 1; t < pool->thread_count; ++t) {
+        SvtJobWorker *worker = &pool->workers[t];
+        if (worker->thread) {
+            svt_post_semaphore(worker->start_semaphore);
+            EB_DESTROY_THREAD(worker->thread);
+        }
+        EB_DESTROY_SEMAPHORE(worker->start_semaphore);
+    }
+    EB_DESTROY_SEMAPHORE(pool->done_semaphore);
+    EB_FREE_ARRAY(pool->workers);
+}
+
+EbErrorType svt_job_pool_ctor(SvtJobPool *pool, int32_t thread_count) {
+    pool->dctor        = svt_job_pool_dctor;
+    pool->thread_count = svt_jobs_thread_count(thread_count, SVT_JOBS_MAX_THREADS);
+    EB_CALLOC_ARRAY(pool->workers, pool->thread_count);
+    EB_CREATE_SEMAPHORE(pool->done_semaphore, 0, pool->thread_count);
+    for (int32_t t = 1; t < pool->thread_count; ++t) {
+        SvtJobWorker *worker = &pool->workers[t];
+        worker->pool         = pool;
+        worker->thread_idx   = t;
+        EB_CREATE_SEMAPHORE(worker->start_semaphore, 0, 1);
+        worker->thread = svt_create_thread(svt_job_worker_kernel, worker);
+        EB_ADD_MEM(worker->thread, 1, EB_THREAD);
+        svt_set_thread_name(worker->thread, "job_worker");
+    }
+    return EB_ErrorNone;
+}
+
+int32_t svt_job_pool_thread_count(const SvtJobPool *pool, int32_t num_jobs) {
+    return svt_jobs_thread_count(pool ? pool->thread_count : 1, num_jobs);
+}
+
+void svt_job_pool_run(SvtJobPool *pool, SvtJobFn fn, void *ctx, int32_t num_jobs) {
+    if (!pool) {
+        for (int32_t job = 0; job < num_jobs; ++job) fn(ctx, 0, job);
+        return;
+    }
+    pool->fn           = fn;
+    pool->ctx          = ctx;
+    pool->num_jobs     = num_jobs;
+    pool->active_count = svt_job_pool_thread_count(pool, num_jobs);
+    for (int32_t t = 1; t < pool->active_count; ++t) svt_post_semaphore(pool->workers[t].start_semaphore);
+    run_worker_jobs(pool, 0);
+    for (int32_t t = 1; t < pool->active_count; ++t) svt_block_on_semaphore(pool->done_semaphore);
+}
+
 /*
     set an atomic variable to an input value
 */
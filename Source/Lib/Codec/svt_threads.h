@@ -13,6 +13,7 @@
 #define EbThreads_h
 
 #include "definitions.h"
+#include "object.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -30,6 +31,8 @@ extern "C" {
      **************************************/
 extern EbHandle svt_create_thread(void *thread_function(void *), void *thread_context);
 
+extern void svt_set_thread_name(EbHandle thread_handle, const char *name);
+
 extern EbErrorType svt_start_thread(EbHandle thread_handle);
 
 extern EbErrorType svt_stop_thread(EbHandle thread_handle);
@@ -54,6 +57,41 @@ extern EbHandle    svt_create_mutex(void);
 extern EbErrorType svt_release_mutex(EbHandle mutex_handle);
 extern EbErrorType svt_block_on_mutex(EbHandle mutex_handle);
 extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
+/**************************************
+     * Fork-join jobs
+     **************************************/
+#define SVT_JOBS_MAX_THREADS 64
+
+typedef void (*SvtJobFn)(void *ctx, int32_t thread_idx, int32_t job_idx);
+
+struct SvtJobWorker;
+
+// Persistent workers running fork-join jobs. The thread calling
+// svt_job_pool_run() is worker 0, the other workers wait between runs.
+typedef struct SvtJobPool {
+    EbDctor              dctor;
+    int32_t              thread_count;
+    struct SvtJobWorker *workers;
+    EbHandle             done_semaphore;
+    SvtJobFn             fn;
+    void                *ctx;
+    int32_t              num_jobs;
+    int32_t              active_count;
+    Bool                 quit;
+} SvtJobPool;
+
+// Starts thread_count - 1 workers, thread_count is capped at SVT_JOBS_MAX_THREADS
+extern EbErrorType svt_job_pool_ctor(SvtJobPool *pool, int32_t thread_count);
+
+// Number of workers svt_job_pool_run() uses for num_jobs jobs, 1 when pool is NULL
+extern int32_t svt_job_pool_thread_count(const SvtJobPool *pool, int32_t num_jobs);
+
+// Runs fn() for jobs [0, num_jobs) on svt_job_pool_thread_count() workers and
+// returns once all jobs are done. Worker t runs jobs t, t + thread_count, ...
+// so jobs must write disjoint outputs. A NULL pool runs every job on the
+// calling thread. Runs of one pool must not overlap.
+extern void svt_job_pool_run(SvtJobPool *pool, SvtJobFn fn, void *ctx, int32_t num_jobs);
+
 #ifdef _WIN32
 
 #define EB_CREATE_THREAD(pointer, thread_function, thread_context)               \
@@ -110,6 +148,11 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
         for (uint32_t i = 0; i < count; i++) EB_CREATE_THREAD(pa[i], thread_function, thread_contexts[i]); \
     } while (0)
 
+#define EB_NAME_THREAD_ARRAY(pa, count, name)                                  \
+    do {                                                                       \
+        for (uint32_t i = 0; i < count; i++) svt_set_thread_name(pa[i], name); \
+    } while (0)
+
 #define EB_DESTROY_THREAD_ARRAY(pa, count)                                 \
     do {                                                                   \
         if (pa) {                                                          \
@@ -26,6 +26,10 @@
 #include <sys/time.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 #include "svt_time.h"
 
 double svt_av1_compute_overall_elapsed_time_ms(const uint64_t start_seconds, const uint64_t start_useconds,
@@ -53,3 +57,27 @@ void svt_av1_get_time(uint64_t *const seconds, uint64_t *const useconds) {
     *useconds = curr_time.tv_usec;
 #endif
 }
+
+uint64_t svt_av1_get_time_us(void) {
+    uint64_t seconds, useconds;
+    svt_av1_get_time(&seconds, &useconds);
+    return seconds * 1000000 + useconds;
+}
+
+uint64_t svt_av1_get_process_cpu_time_us(void) {
+#ifdef _WIN32
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+        return 0;
+    const uint64_t kernel = ((uint64_t)kernel_time.dwHighDateTime << 32) | kernel_time.dwLowDateTime;
+    const uint64_t user   = ((uint64_t)user_time.dwHighDateTime << 32) | user_time.dwLowDateTime;
+    // FILETIME is in 100 ns units
+    return (kernel + user) / 10;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+        return 0;
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec +
+        usage.ru_stime.tv_usec;
+#endif
+}
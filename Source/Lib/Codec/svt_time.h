@@ -21,6 +21,10 @@ extern "C" {
 double svt_av1_compute_overall_elapsed_time_ms(const uint64_t start_seconds, const uint64_t start_useconds,
                                                const uint64_t finish_seconds, const uint64_t finish_useconds);
 void   svt_av1_get_time(uint64_t *const seconds, uint64_t *const useconds);
+/* Monotonic time in microseconds */
+uint64_t svt_av1_get_time_us(void);
+/* CPU time used by all the threads of the process, user and kernel, in microseconds */
+uint64_t svt_av1_get_process_cpu_time_us(void);
 
 #ifdef __cplusplus
 }
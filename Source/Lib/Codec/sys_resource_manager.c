@@ -11,13 +11,12 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "sys_resource_manager.h"
 #include "definitions.h"
 #include "svt_threads.h"
-#if SRM_REPORT
 #include "svt_log.h"
-#endif
 static void svt_fifo_dctor(EbPtr p) {
     EbFifo *obj = (EbFifo *)p;
     EB_DESTROY_SEMAPHORE(obj->counting_semaphore);
@@ -375,19 +374,23 @@ typedef struct DctorAble {
     EbDctor dctor;
 } DctorAble;
 
-void svt_object_wrapper_dctor(EbPtr p) {
-    EbObjectWrapper *wrapper = (EbObjectWrapper *)p;
-    if (wrapper->object_destroyer) {
+void svt_destroy_object(EbPtr object_ptr, EbDctor object_destroyer) {
+    if (object_destroyer) {
         //customized destoryer
-        if (wrapper->object_ptr)
-            wrapper->object_destroyer(wrapper->object_ptr);
+        if (object_ptr)
+            object_destroyer(object_ptr);
     } else {
         //hack....
-        DctorAble *obj = (DctorAble *)wrapper->object_ptr;
+        DctorAble *obj = (DctorAble *)object_ptr;
         EB_DELETE(obj);
     }
 }
 
+void svt_object_wrapper_dctor(EbPtr p) {
+    EbObjectWrapper *wrapper = (EbObjectWrapper *)p;
+    svt_destroy_object(wrapper->object_ptr, wrapper->object_destroyer);
+}
+
 static EbErrorType svt_object_wrapper_ctor(EbObjectWrapper *wrapper, EbSystemResource *resource,
                                            EbCreator object_creator, EbPtr object_init_data_ptr,
                                            EbDctor object_destroyer) {
@@ -408,6 +411,8 @@ static void svt_system_resource_dctor(EbPtr p) {
     EB_DELETE(obj->full_queue);
     EB_DELETE(obj->empty_queue);
     EB_DELETE_PTR_ARRAY(obj->wrapper_ptr_pool, obj->object_total_count);
+    if (obj->object_init_data_copied)
+        EB_FREE(obj->object_init_data_ptr);
 }
 
 /*********************************************************************
@@ -438,17 +443,52 @@ static void svt_system_resource_dctor(EbPtr p) {
 EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
                                      uint32_t producer_process_total_count, uint32_t consumer_process_total_count,
                                      EbCreator object_creator, EbPtr object_init_data_ptr, EbDctor object_destroyer) {
+    return svt_system_resource_lazy_ctor(resource_ptr,
+                                         object_total_count,
+                                         object_total_count,
+                                         producer_process_total_count,
+                                         consumer_process_total_count,
+                                         object_creator,
+                                         object_init_data_ptr,
+                                         0,
+                                         object_destroyer);
+}
+
+/*********************************************************************
+ * svt_system_resource_lazy_ctor
+ *   Constructor for EbSystemResource that only constructs
+ *   object_init_count objects, the others are constructed on demand by
+ *   svt_get_empty_object.
+ *
+ *   object_init_data_size
+ *     size of the data pointed to by object_init_data_ptr, copied to
+ *     construct the objects later. The pointer is kept if this is 0.
+ *********************************************************************/
+EbErrorType svt_system_resource_lazy_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
+                                          uint32_t object_init_count, uint32_t producer_process_total_count,
+                                          uint32_t consumer_process_total_count, EbCreator object_creator,
+                                          EbPtr object_init_data_ptr, size_t object_init_data_size,
+                                          EbDctor object_destroyer) {
     uint32_t    wrapper_index;
     EbErrorType return_error = EB_ErrorNone;
     resource_ptr->dctor      = svt_system_resource_dctor;
 
-    resource_ptr->object_total_count = object_total_count;
+    resource_ptr->object_total_count   = object_total_count;
+    resource_ptr->object_created_count = object_init_count < object_total_count ? object_init_count : object_total_count;
+    resource_ptr->object_creator       = object_creator;
+    resource_ptr->object_destroyer     = object_destroyer;
+    resource_ptr->object_init_data_ptr = object_init_data_ptr;
+    if (resource_ptr->object_created_count < object_total_count && object_init_data_size) {
+        EB_MALLOC(resource_ptr->object_init_data_ptr, object_init_data_size);
+        resource_ptr->object_init_data_copied = TRUE;
+        memcpy(resource_ptr->object_init_data_ptr, object_init_data_ptr, object_init_data_size);
+    }
 
     // Allocate array for wrapper pointers
     EB_ALLOC_PTR_ARRAY(resource_ptr->wrapper_ptr_pool, resource_ptr->object_total_count);
 
     // Initialize each wrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+    for (wrapper_index = 0; wrapper_index < resource_ptr->object_created_count; ++wrapper_index) {
         EB_NEW(resource_ptr->wrapper_ptr_pool[wrapper_index],
                svt_object_wrapper_ctor,
                resource_ptr,
@@ -466,13 +506,15 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
            svt_muxing_queue_ctor,
            resource_ptr->object_total_count,
            producer_process_total_count);
+    if (resource_ptr->object_created_count < object_total_count)
+        resource_ptr->empty_queue->grow_resource = resource_ptr;
     // Fill the Empty Fifo with every ObjectWrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+    for (wrapper_index = 0; wrapper_index < resource_ptr->object_created_count; ++wrapper_index) {
         svt_muxing_queue_object_push_back(resource_ptr->empty_queue, resource_ptr->wrapper_ptr_pool[wrapper_index]);
     }
 #if SRM_REPORT
     //at init time, the SRM is full
-    resource_ptr->empty_queue->curr_count = resource_ptr->object_total_count;
+    resource_ptr->empty_queue->curr_count = resource_ptr->object_created_count;
     resource_ptr->empty_queue->log        = 0;
 #endif
     // Initialize the Full Queue
@@ -488,6 +530,55 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
     return return_error;
 }
 
+static EbErrorType svt_system_resource_new_object(EbSystemResource *resource_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
+    EbObjectWrapper *wrapper_ptr;
+    EB_NEW(wrapper_ptr,
+           svt_object_wrapper_ctor,
+           resource_ptr,
+           resource_ptr->object_creator,
+           resource_ptr->object_init_data_ptr,
+           resource_ptr->object_destroyer);
+    *wrapper_dbl_ptr = wrapper_ptr;
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * svt_system_resource_grow
+ *   Constructs the object reserved by empty_fifo_ptr, without holding
+ *   the lock, then queues it to the empty queue with the requesting
+ *   fifo. On failure the reservation is cancelled.
+ *********************************************************************/
+static EbErrorType svt_system_resource_grow(EbSystemResource *resource_ptr, EbFifo *empty_fifo_ptr) {
+    EbMuxingQueue   *queue_ptr   = resource_ptr->empty_queue;
+    const uint64_t   alloc_mark  = svt_get_thread_alloc_bytes();
+    EbObjectWrapper *wrapper_ptr = NULL;
+    EbErrorType      return_error = svt_system_resource_new_object(resource_ptr, &wrapper_ptr);
+    if (return_error != EB_ErrorNone) {
+        svt_block_on_mutex(queue_ptr->lockout_mutex);
+        resource_ptr->object_created_count--;
+        svt_release_mutex(queue_ptr->lockout_mutex);
+        return return_error;
+    }
+#if SRM_REPORT
+    wrapper_ptr->pic_number = 99999999;
+#endif
+
+    svt_block_on_mutex(queue_ptr->lockout_mutex);
+    // Objects of failed reservations leave holes: take the first free entry
+    uint32_t wrapper_index = 0;
+    while (resource_ptr->wrapper_ptr_pool[wrapper_index]) wrapper_index++;
+    resource_ptr->wrapper_ptr_pool[wrapper_index] = wrapper_ptr;
+    resource_ptr->grown_bytes += svt_get_thread_alloc_bytes() - alloc_mark;
+    svt_circular_buffer_push_front(queue_ptr->process_queue, empty_fifo_ptr);
+    svt_muxing_queue_object_push_back(queue_ptr, wrapper_ptr);
+#if SRM_REPORT
+    queue_ptr->curr_count++;
+#endif
+    svt_release_mutex(queue_ptr->lockout_mutex);
+
+    return return_error;
+}
+
 EbFifo *svt_system_resource_get_producer_fifo(const EbSystemResource *resource_ptr, uint32_t index) {
     return svt_muxing_queue_get_fifo(resource_ptr->empty_queue, index);
 }
@@ -509,6 +600,18 @@ EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
     return EB_ErrorNone;
 }
 
+EbErrorType svt_shutdown_producer(EbFifo *empty_fifo_ptr) { return svt_fifo_shutdown(empty_fifo_ptr); }
+
+EbErrorType svt_shutdown_producers(const EbSystemResource *resource_ptr) {
+    //not fully constructed
+    if (!resource_ptr || !resource_ptr->empty_queue)
+        return EB_ErrorNone;
+
+    for (unsigned int i = 0; i < resource_ptr->empty_queue->process_total_count; i++)
+        svt_fifo_shutdown(svt_system_resource_get_producer_fifo(resource_ptr, i));
+    return EB_ErrorNone;
+}
+
 /*********************************************************************
  * EbSystemResourceReleaseProcess
  *********************************************************************/
@@ -637,7 +740,8 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
     if (log) {
         SVT_LOG("SRM content:\n\n");
         for (uint32_t wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
-            SVT_LOG("%lld ", resource_ptr->wrapper_ptr_pool[wrapper_index]->pic_number);
+            if (resource_ptr->wrapper_ptr_pool[wrapper_index])
+                SVT_LOG("%lld ", resource_ptr->wrapper_ptr_pool[wrapper_index]->pic_number);
         }
     }
     return return_error;
@@ -661,8 +765,42 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
 EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    // Queue the Fifo requesting the empty fifo
-    svt_release_process(empty_fifo_ptr);
+    EbMuxingQueue    *queue_ptr    = empty_fifo_ptr->queue_ptr;
+    EbSystemResource *resource_ptr = queue_ptr->grow_resource;
+
+    svt_block_on_mutex(empty_fifo_ptr->lockout_mutex);
+    const Bool quit = empty_fifo_ptr->quit_signal;
+    svt_release_mutex(empty_fifo_ptr->lockout_mutex);
+    if (quit) {
+        *wrapper_dbl_ptr = NULL;
+        return EB_NoErrorFifoShutdown;
+    }
+
+    if (resource_ptr) {
+        // When no object is left and the pool is not complete, reserve a new object, so that every
+        // waiting process has an object coming as it would if the pool were complete. The Fifo is
+        // queued with the new object, or right away when no object is reserved
+        Bool grow = FALSE;
+        svt_block_on_mutex(queue_ptr->lockout_mutex);
+        if (resource_ptr->object_created_count < resource_ptr->object_total_count &&
+            svt_circular_buffer_empty_check(queue_ptr->object_queue)) {
+            resource_ptr->object_created_count++;
+            grow = TRUE;
+        } else {
+            svt_circular_buffer_push_front(queue_ptr->process_queue, empty_fifo_ptr);
+            svt_muxing_queue_assignation(queue_ptr);
+        }
+        svt_release_mutex(queue_ptr->lockout_mutex);
+
+        if (grow && (return_error = svt_system_resource_grow(resource_ptr, empty_fifo_ptr)) != EB_ErrorNone) {
+            SVT_ERROR("failed to allocate an object of the pool\n");
+            *wrapper_dbl_ptr = NULL;
+            return return_error;
+        }
+    } else {
+        // Queue the Fifo requesting the empty fifo
+        svt_release_process(empty_fifo_ptr);
+    }
 
     // Block on the counting Semaphore until an empty buffer is available
     svt_block_on_semaphore(empty_fifo_ptr->counting_semaphore);
@@ -670,6 +808,12 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
     // Acquire lockout Mutex
     svt_block_on_mutex(empty_fifo_ptr->lockout_mutex);
 
+    if (empty_fifo_ptr->quit_signal) {
+        svt_release_mutex(empty_fifo_ptr->lockout_mutex);
+        *wrapper_dbl_ptr = NULL;
+        return EB_NoErrorFifoShutdown;
+    }
+
     // Get the empty object
     svt_fifo_pop_front(empty_fifo_ptr, wrapper_dbl_ptr);
 
@@ -112,6 +112,10 @@ typedef struct EbMuxingQueue {
     EbCircularBuffer *process_queue;
     uint32_t          process_total_count;
     EbFifo          **process_fifo_ptr_array;
+    // grow_resource - the SystemResource to create objects in when a
+    //   process finds the queue empty.  Only set for the empty queue of
+    //   a SystemResource constructed with svt_system_resource_lazy_ctor.
+    struct EbSystemResource *grow_resource;
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
@@ -133,9 +137,22 @@ typedef struct EbSystemResource {
     //   System Resoruce.
     uint32_t object_total_count;
 
+    // object_created_count - A count of the objects constructed so far,
+    //   including those being constructed on demand.  The constructed
+    //   objects are the non NULL entries of wrapper_ptr_pool.
+    uint32_t object_created_count;
     // wrapper_ptr_pool - An array of pointers to the EbObjectWrappers used
     //   to construct and destruct the SystemResource.
     EbObjectWrapper **wrapper_ptr_pool;
+    // object_creator, object_init_data_ptr & object_destroyer - kept to
+    //   construct the objects that are created on demand.
+    //   object_init_data_copied is set when object_init_data_ptr is owned.
+    EbCreator object_creator;
+    EbPtr     object_init_data_ptr;
+    Bool      object_init_data_copied;
+    EbDctor   object_destroyer;
+    // grown_bytes - Memory allocated by the objects created on demand.
+    uint64_t grown_bytes;
 
     // The empty FIFO contains a queue of empty buffers
     EbMuxingQueue *empty_queue;
@@ -222,6 +239,36 @@ extern EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint
                                             uint32_t consumer_process_total_count, EbCreator object_ctor,
                                             EbPtr object_init_data_ptr, EbDctor object_destroyer);
 
+/*********************************************************************
+     * svt_system_resource_lazy_ctor
+     *   Constructor for EbSystemResource whose objects are constructed on
+     *   demand: object_init_count objects are constructed here, the others
+     *   by the first processes that find no empty object, until there are
+     *   object_total_count of them.  A process only waits for an object to
+     *   be released once all the objects are constructed.
+     *
+     *   object_init_count
+     *     Number of objects constructed by svt_system_resource_lazy_ctor.
+     *
+     *   object_init_data_size
+     *     Size of the data pointed to by object_init_data_ptr, which is
+     *     copied since the objects can be constructed after the caller
+     *     returns.  The pointer is kept as is when the size is 0.
+     *********************************************************************/
+extern EbErrorType svt_system_resource_lazy_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
+                                                 uint32_t object_init_count, uint32_t producer_process_total_count,
+                                                 uint32_t consumer_process_total_count, EbCreator object_ctor,
+                                                 EbPtr object_init_data_ptr, size_t object_init_data_size,
+                                                 EbDctor object_destroyer);
+/*********************************************************************
+     * svt_destroy_object
+     *   Destructs an object constructed by the object_creator of a
+     *   SystemResource outside of it, as the SystemResource would.
+     *
+     *   object_destroyer
+     *     Destroyer the SystemResource would be given, or NULL.
+     *********************************************************************/
+extern void svt_destroy_object(EbPtr object_ptr, EbDctor object_destroyer);
 /*********************************************************************
      * svt_system_resource_get_producer_fifo
      *   get producer fifo
@@ -260,7 +307,9 @@ EbFifo *svt_system_resource_get_consumer_fifo(const EbSystemResource *resource_p
      *
      *   wrapper_dbl_ptr
      *      Double pointer used to pass the pointer to the empty
-     *      EbObjectWrapper pointer.
+     *      EbObjectWrapper pointer.  Set to NULL, without blocking, when
+     *      the object constructed on demand could not be allocated, or
+     *      once the producer is shut down.
      *********************************************************************/
 extern EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr);
 #if SRM_REPORT
@@ -326,6 +375,27 @@ extern EbErrorType svt_release_object(EbObjectWrapper *object_ptr);
      *********************************************************************/
 extern EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr);
 
+/*********************************************************************
+     * svt_shutdown_producer
+     *   Notify shut down signal to a producer of EbSystemResource, its
+     *   waiting and later svt_get_empty_object calls return
+     *   EB_NoErrorFifoShutdown without an object.
+     *
+     *   empty_fifo_ptr
+     *      pointer to the producer fifo.
+     *********************************************************************/
+extern EbErrorType svt_shutdown_producer(EbFifo *empty_fifo_ptr);
+
+/*********************************************************************
+     * svt_shutdown_producers
+     *   Notify shut down signal to all the producers of EbSystemResource,
+     *   as svt_shutdown_producer does.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *********************************************************************/
+extern EbErrorType svt_shutdown_producers(const EbSystemResource *resource_ptr);
+
 #define EB_GET_FULL_OBJECT(full_fifo_ptr, wrapper_dbl_ptr)                     \
     do {                                                                       \
         EbErrorType err = svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr); \
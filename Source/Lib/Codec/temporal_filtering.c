@@ -160,14 +160,15 @@ void svt_aom_pack_highbd_pic(const EbPictureBufferDesc *pic_ptr, uint16_t *buffe
 
     uint32_t comp_stride_y = pic_ptr->stride_y / 4;
 
-    svt_aom_compressed_pack_sb(pic_ptr->buffer_y,
-                       pic_ptr->stride_y,
-                       pic_ptr->buffer_bit_inc_y,
-                       comp_stride_y,
-                       buffer_16bit[C_Y],
-                       pic_ptr->stride_y,
-                       width,
-                       height);
+    if (buffer_16bit[C_Y])
+        svt_aom_compressed_pack_sb(pic_ptr->buffer_y,
+                           pic_ptr->stride_y,
+                           pic_ptr->buffer_bit_inc_y,
+                           comp_stride_y,
+                           buffer_16bit[C_Y],
+                           pic_ptr->stride_y,
+                           width,
+                           height);
 
     uint32_t comp_stride_uv = pic_ptr->stride_cb / 4;
     if (buffer_16bit[C_U])
@@ -233,6 +234,75 @@ void svt_aom_unpack_highbd_pic(uint16_t *buffer_highbd[3], EbPictureBufferDesc *
             (height + ss_y) >> ss_y);
 }
 
+static void tf_unlist_highbd_view(EncodeContext *enc_ctx, PictureParentControlSet *pcs) {
+    if (!pcs->altref_highbd_cached)
+        return;
+    for (uint32_t i = 0; i < enc_ctx->tf_highbd_view_count; i++) {
+        if (enc_ctx->tf_highbd_view_pcs[i] == pcs) {
+            enc_ctx->tf_highbd_view_pcs[i] = enc_ctx->tf_highbd_view_pcs[--enc_ctx->tf_highbd_view_count];
+            break;
+        }
+    }
+    pcs->altref_highbd_cached = FALSE;
+}
+
+/*
+ * Get the 16-bit view of the source picture of pcs, packing only the planes it does not hold yet.
+ * keep: the picture is a reference of the window, its view is kept in the encode context for the
+ * following windows. Otherwise the picture is about to be filtered and owns its view, which goes
+ * stale with the filtering, and the view only holds the planes that are filtered.
+ */
+EbErrorType svt_aom_tf_get_highbd_view(EncodeContext *enc_ctx, PictureParentControlSet *pcs, Bool chroma, Bool keep) {
+    EbPictureBufferDesc *pic         = pcs->enhanced_pic;
+    uint16_t            *missing[3] = {NULL, NULL, NULL};
+
+    if (!pcs->altref_buffer_highbd[C_Y]) {
+        EB_MALLOC_ARRAY(pcs->altref_buffer_highbd[C_Y], pic->luma_size);
+        missing[C_Y] = pcs->altref_buffer_highbd[C_Y];
+    }
+    if (chroma && !pcs->altref_buffer_highbd[C_U]) {
+        EB_MALLOC_ARRAY(pcs->altref_buffer_highbd[C_U], pic->chroma_size);
+        EB_MALLOC_ARRAY(pcs->altref_buffer_highbd[C_V], pic->chroma_size);
+        missing[C_U] = pcs->altref_buffer_highbd[C_U];
+        missing[C_V] = pcs->altref_buffer_highbd[C_V];
+    } else if (!chroma && !keep && pcs->altref_buffer_highbd[C_U]) {
+        EB_FREE_ARRAY(pcs->altref_buffer_highbd[C_U]);
+        EB_FREE_ARRAY(pcs->altref_buffer_highbd[C_V]);
+    }
+    if (missing[C_Y] || missing[C_U])
+        svt_aom_pack_highbd_pic(pic, missing, pcs->scs->subsampling_x, pcs->scs->subsampling_y, TRUE);
+
+    if (!keep)
+        tf_unlist_highbd_view(enc_ctx, pcs);
+    else if (!pcs->altref_highbd_cached && enc_ctx->tf_highbd_view_count < TF_HIGHBD_VIEW_MAX) {
+        enc_ctx->tf_highbd_view_pcs[enc_ctx->tf_highbd_view_count++] = pcs;
+        pcs->altref_highbd_cached                                   = TRUE;
+    }
+    return EB_ErrorNone;
+}
+
+// Free the 16-bit view of a picture that is not kept in the encode context
+void svt_aom_tf_free_highbd_view(PictureParentControlSet *pcs) {
+    if (pcs->altref_highbd_cached)
+        return;
+    for (int c = 0; c < 3; c++)
+        if (pcs->altref_buffer_highbd[c])
+            EB_FREE_ARRAY(pcs->altref_buffer_highbd[c]);
+}
+
+// Free the kept 16-bit views of the pictures up to last_picture_number, which no later window uses
+void svt_aom_tf_flush_highbd_views(EncodeContext *enc_ctx, uint64_t last_picture_number) {
+    uint32_t i = 0;
+    while (i < enc_ctx->tf_highbd_view_count) {
+        PictureParentControlSet *pcs = enc_ctx->tf_highbd_view_pcs[i];
+        if (pcs->picture_number <= last_picture_number) {
+            tf_unlist_highbd_view(enc_ctx, pcs);
+            svt_aom_tf_free_highbd_view(pcs);
+        } else
+            i++;
+    }
+}
+
 static void derive_tf_32x32_block_split_flag(MeContext *me_ctx) {
     int      subblock_errors[4];
     uint32_t idx_32x32   = me_ctx->idx_32x32;
@@ -3986,24 +4056,15 @@ EbErrorType svt_av1_init_temporal_filtering(
         for (int i = 0; i < (centre_pcs->past_altref_nframes +
                              centre_pcs->future_altref_nframes + 1);
              i++) {
-            EbPictureBufferDesc *pic_ptr_ref =
-                pcs_list[i]->enhanced_pic;
-            //10bit: for all the reference pictures do the packing once at the beggining.
+            //10bit: for all the reference pictures do the packing once at the beggining,
+            //unless an earlier window already did
             if (is_highbd && i != centre_pcs->past_altref_nframes) {
-                EB_MALLOC_ARRAY(pcs_list[i]->altref_buffer_highbd[C_Y],
-                                central_picture_ptr->luma_size);
-                if (centre_pcs->tf_ctrls.chroma_lvl) {
-                    EB_MALLOC_ARRAY(pcs_list[i]->altref_buffer_highbd[C_U],
-                                    central_picture_ptr->chroma_size);
-                    EB_MALLOC_ARRAY(pcs_list[i]->altref_buffer_highbd[C_V],
-                                    central_picture_ptr->chroma_size);
+                EbErrorType err = svt_aom_tf_get_highbd_view(
+                    centre_pcs->scs->enc_ctx, pcs_list[i], centre_pcs->tf_ctrls.chroma_lvl != 0, TRUE);
+                if (err != EB_ErrorNone) {
+                    svt_release_mutex(centre_pcs->temp_filt_mutex);
+                    return err;
                 }
-                // pack byte buffers to 16 bit buffer
-                svt_aom_pack_highbd_pic(pic_ptr_ref,
-                                pcs_list[i]->altref_buffer_highbd,
-                                ss_x,
-                                ss_y,
-                                TRUE);
             }
         }
 
@@ -4106,23 +4167,11 @@ EbErrorType svt_av1_init_temporal_filtering(
                               ss_x,
                               ss_y,
                               TRUE);
-            EB_FREE_ARRAY(centre_pcs->altref_buffer_highbd[C_Y]);
-            if (centre_pcs->tf_ctrls.chroma_lvl) {
-                EB_FREE_ARRAY(centre_pcs->altref_buffer_highbd[C_U]);
-                EB_FREE_ARRAY(centre_pcs->altref_buffer_highbd[C_V]);
-            }
+            // the views kept in the encode context are freed at the end of their mini-GOP
             for (int i = 0; i < (centre_pcs->past_altref_nframes +
                                  centre_pcs->future_altref_nframes + 1);
-                 i++) {
-                if (i != centre_pcs->past_altref_nframes) {
-
-                    EB_FREE_ARRAY(pcs_list[i]->altref_buffer_highbd[C_Y]);
-                    if (centre_pcs->tf_ctrls.chroma_lvl) {
-                        EB_FREE_ARRAY(pcs_list[i]->altref_buffer_highbd[C_U]);
-                        EB_FREE_ARRAY(pcs_list[i]->altref_buffer_highbd[C_V]);
-                    }
-                }
-            }
+                 i++)
+                svt_aom_tf_free_highbd_view(pcs_list[i]);
         }
 
         // padding + decimation: even if highbd src, this is only performed on the 8 bit buffer (excluding the LSBs)
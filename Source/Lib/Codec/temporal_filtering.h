@@ -132,6 +132,10 @@ void svt_av1_apply_temporal_filter_planewise_medium_hbd_c(
 
 int32_t svt_aom_noise_log1p_fp16(int32_t noise_level_fp16);
 
+EbErrorType svt_aom_tf_get_highbd_view(EncodeContext *enc_ctx, PictureParentControlSet *pcs, Bool chroma, Bool keep);
+void        svt_aom_tf_free_highbd_view(PictureParentControlSet *pcs);
+void        svt_aom_tf_flush_highbd_views(EncodeContext *enc_ctx, uint64_t last_picture_number);
+
 typedef struct {
     uint8_t      subpel_pel_mode;
     signed short xd;
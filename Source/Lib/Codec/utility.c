@@ -10,16 +10,17 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
-#include <stdlib.h>
 #include <sys/time.h>
 #endif
 
 #include "utility.h"
 #include "svt_log.h"
+#include "svt_threads.h"
 #include <math.h>
 
 /* assert a certain condition and report err if condition not met */
@@ -1273,24 +1274,50 @@ static uint32_t count_total_num_of_active_blks(uint8_t min_nsq_bsize) {
 
     return depth_scan_idx;
 }
-static void log_redundancy_similarity(uint32_t max_block_count) {
-    uint32_t blk_it, s_it;
+/* Order of the blocks with the same size and origin, by index */
+static int compare_blk_position(const void *a, const void *b) {
+    const BlockGeom *ga = &svt_aom_blk_geom_mds[*(const uint32_t *)a];
+    const BlockGeom *gb = &svt_aom_blk_geom_mds[*(const uint32_t *)b];
+    if (ga->bsize != gb->bsize)
+        return ga->bsize < gb->bsize ? -1 : 1;
+    if (ga->org_y != gb->org_y)
+        return ga->org_y < gb->org_y ? -1 : 1;
+    if (ga->org_x != gb->org_x)
+        return ga->org_x < gb->org_x ? -1 : 1;
+    return *(const uint32_t *)a < *(const uint32_t *)b ? -1 : 1;
+}
 
-    for (blk_it = 0; blk_it < max_block_count; blk_it++) {
-        BlockGeom* cur_geom             = &svt_aom_blk_geom_mds[blk_it];
+static void log_redundancy_similarity(uint32_t max_block_count) {
+    // Only the first shape of each partition can be redundant: sort those by size and origin, the
+    // blocks redundant to each other are then next to each other
+    uint32_t sorted[MAX_NUM_BLOCKS_ALLOC];
+    uint32_t count = 0;
+    for (uint32_t blk_it = 0; blk_it < max_block_count; blk_it++) {
+        BlockGeom *cur_geom             = &svt_aom_blk_geom_mds[blk_it];
         cur_geom->redund                = 0;
         cur_geom->redund_list.list_size = 0;
-
-        for (s_it = 0; s_it < max_block_count; s_it++) {
-            BlockGeom* search_geom = &svt_aom_blk_geom_mds[s_it];
-
-            if (cur_geom->bsize == search_geom->bsize && cur_geom->org_x == search_geom->org_x &&
-                cur_geom->org_y == search_geom->org_y && s_it != blk_it) {
-                if (cur_geom->nsi == 0 && search_geom->nsi == 0 && cur_geom->redund_list.list_size < 3) {
-                    cur_geom->redund                                                     = 1;
-                    cur_geom->redund_list.blk_mds_table[cur_geom->redund_list.list_size] = search_geom->blkidx_mds;
-                    cur_geom->redund_list.list_size++;
-                }
+        if (cur_geom->nsi == 0)
+            sorted[count++] = blk_it;
+    }
+    qsort(sorted, count, sizeof(sorted[0]), compare_blk_position);
+
+    for (uint32_t start = 0, end; start < count; start = end) {
+        const BlockGeom *first = &svt_aom_blk_geom_mds[sorted[start]];
+        for (end = start + 1; end < count; end++) {
+            const BlockGeom *geom = &svt_aom_blk_geom_mds[sorted[end]];
+            if (geom->bsize != first->bsize || geom->org_x != first->org_x || geom->org_y != first->org_y)
+                break;
+        }
+        // each block of the group lists the first 3 other blocks of the group
+        for (uint32_t i = start; i < end; i++) {
+            BlockGeom *cur_geom = &svt_aom_blk_geom_mds[sorted[i]];
+            for (uint32_t j = start; j < end && cur_geom->redund_list.list_size < 3; j++) {
+                if (j == i)
+                    continue;
+                cur_geom->redund                                                     = 1;
+                cur_geom->redund_list.blk_mds_table[cur_geom->redund_list.list_size] =
+                    svt_aom_blk_geom_mds[sorted[j]].blkidx_mds;
+                cur_geom->redund_list.list_size++;
             }
         }
     }
@@ -1299,7 +1326,7 @@ static void log_redundancy_similarity(uint32_t max_block_count) {
 /*
   Build Block Geometry
 */
-void svt_aom_build_blk_geom(GeomIndex geom) {
+static void build_blk_geom(GeomIndex geom) {
     uint32_t max_block_count;
     svt_aom_geom_idx = geom;
     uint32_t min_nsq_bsize;
@@ -1367,6 +1394,82 @@ void svt_aom_build_blk_geom(GeomIndex geom) {
     md_scan_all_blks(&idx_mds, max_sb, 0, 0, 0, 0, min_nsq_bsize);
     log_redundancy_similarity(max_block_count);
 }
+
+#ifndef MINIMAL_BUILD
+static EbHandle blk_geom_mutex;
+
+static void blk_geom_mutex_cleanup(void) { svt_destroy_mutex(blk_geom_mutex); }
+static void create_blk_geom_mutex(void) {
+    blk_geom_mutex = svt_create_mutex();
+    atexit(blk_geom_mutex_cleanup);
+}
+
+#ifdef _WIN32
+static INIT_ONCE blk_geom_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_blk_geom_mutex_wrapper(PINIT_ONCE InitOnce, PVOID Parameter, PVOID* lpContext) {
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    create_blk_geom_mutex();
+    return TRUE;
+}
+
+static EbHandle get_blk_geom_mutex(void) {
+    InitOnceExecuteOnce(&blk_geom_once, create_blk_geom_mutex_wrapper, NULL, NULL);
+    return blk_geom_mutex;
+}
+#else
+#include <pthread.h>
+
+static pthread_once_t blk_geom_once = PTHREAD_ONCE_INIT;
+
+static EbHandle get_blk_geom_mutex(void) {
+    pthread_once(&blk_geom_once, create_blk_geom_mutex);
+    return blk_geom_mutex;
+}
+#endif // _WIN32
+#endif // MINIMAL_BUILD
+
+#ifndef MINIMAL_BUILD
+// Encoders of the process using the table
+static uint32_t blk_geom_users;
+#endif
+
+EbErrorType svt_aom_build_blk_geom(GeomIndex geom) {
+#ifdef MINIMAL_BUILD
+    build_blk_geom(geom);
+    return EB_ErrorNone;
+#else
+    // The table is static and shared by the encoders of the process: it is only built again for
+    // another geometry once no encoder uses it. Encoders initialized from several threads build it
+    // one at a time.
+    EbErrorType return_error = EB_ErrorNone;
+    EbHandle    mutex        = get_blk_geom_mutex();
+    svt_block_on_mutex(mutex);
+    if (blk_geom_users && svt_aom_geom_idx != geom) {
+        SVT_ERROR("Block geometry %d is in use by another encoder of the process, %d cannot be used\n",
+                  svt_aom_geom_idx,
+                  geom);
+        return_error = EB_ErrorBadParameter;
+    } else {
+        if (!blk_geom_users)
+            build_blk_geom(geom);
+        blk_geom_users++;
+    }
+    svt_release_mutex(mutex);
+    return return_error;
+#endif
+}
+
+void svt_aom_release_blk_geom(void) {
+#ifndef MINIMAL_BUILD
+    EbHandle mutex = get_blk_geom_mutex();
+    svt_block_on_mutex(mutex);
+    blk_geom_users--;
+    svt_release_mutex(mutex);
+#endif
+}
 uint32_t get_mds_idx(uint32_t orgx, uint32_t orgy, uint32_t size, uint32_t use_128x128) {
     (void)use_128x128;
     uint32_t max_block_count = max_num_active_blocks;
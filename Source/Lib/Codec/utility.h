@@ -37,7 +37,10 @@ typedef enum GeomIndex {
     GEOM_8, //128x128->8x8  NSQ:ON  (only H, V, H4, V4 shapes)
     GEOM_TOT
 } GeomIndex;
-void svt_aom_build_blk_geom(GeomIndex geom);
+// Builds the block geometry table shared by the encoders of the process, fails while another
+// encoder uses another geometry. Each successful call is paired with svt_aom_release_blk_geom().
+EbErrorType svt_aom_build_blk_geom(GeomIndex geom);
+void        svt_aom_release_blk_geom(void);
 
 typedef struct BlockGeom {
     Part    shape; // P_N..P_V4 . P_S is not used.
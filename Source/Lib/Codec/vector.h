@@ -26,6 +26,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <stdbool.h>
 #include <stddef.h>
 #include "common_dsp_rtcd.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
 /***** DEFINITIONS *****/
 
 #define VECTOR_MINIMUM_CAPACITY 2
@@ -87,4 +90,7 @@ void  _vector_assign(Vector *vector, size_t index, void *element);
 int   _vector_adjust_capacity(Vector *vector);
 int   _vector_reallocate(Vector *vector, uint32_t new_capacity);
 
+#ifdef __cplusplus
+}
+#endif
 #endif /* VECTOR_H */
@@ -96,6 +96,8 @@
 #define EB_PictureManagerProcessInitCount               1
 #define EB_RateControlProcessInitCount                  1
 #define EB_PacketizationProcessInitCount                1
+// Objects created by svt_av1_enc_init() in the picture pools that grow on demand
+#define ENC_POOL_LAZY_INIT_COUNT                        1
 
 // Output Buffer Transfer Parameters
 #define TPL_INPUT_PORT_SOP                                0
@@ -524,6 +526,29 @@ void set_segments_numbers(SequenceControlSet    *scs) {
     scs->tf_segment_column_count = me_seg_w;
     scs->tf_segment_row_count = me_seg_h;
 }
+/* Buffer reduction steps taken, in order, while the estimated memory exceeds max_memory_mb, see fit_memory_budget() */
+typedef enum MemBudgetLevel {
+    MEM_BUDGET_NONE,
+    MEM_BUDGET_NO_EXTRA_MG, // no extra mini-gops buffered on top of the current one
+    MEM_BUDGET_MIN_CHILD,   // one picture in enc-dec at a time
+    MEM_BUDGET_TPL_LAD,     // lookahead limited to the mini-gops used by TPL
+    MEM_BUDGET_NO_TPL_LAD,  // TPL limited to the current mini-gop
+    MEM_BUDGET_LEVELS
+} MemBudgetLevel;
+/*
+Shortens the lookahead for the lookahead related budget levels
+*/
+static void apply_memory_budget_level(SequenceControlSet *scs) {
+    const uint32_t eos_delay = 1;
+    const uint32_t mg_size   = 1 << scs->static_config.hierarchical_levels;
+
+    if (scs->mem_budget_level >= MEM_BUDGET_NO_TPL_LAD)
+        scs->tpl_lad_mg = 0;
+    if (scs->mem_budget_level >= MEM_BUDGET_TPL_LAD && scs->lad_mg > scs->tpl_lad_mg) {
+        scs->lad_mg                            = scs->tpl_lad_mg;
+        scs->static_config.look_ahead_distance = (1 + mg_size) * (scs->lad_mg + 1) + scs->scd_delay + eos_delay;
+    }
+}
 static EbErrorType load_default_buffer_configuration_settings(
     SequenceControlSet       *scs) {
     EbErrorType           return_error = EB_ErrorNone;
@@ -643,10 +668,18 @@ static EbErrorType load_default_buffer_configuration_settings(
             min_paref  += low_delay_tf_frames;
 
         }
+        // Pipelined two pass: the first pass codes a mini-GOP once it has its own future pictures, which
+        // can go past the look-ahead window, so keep the input for one more mini-GOP and its TF pictures
+        if (scs->static_config.pipelined_two_pass) {
+            const uint32_t first_pass_frames = 1 + mg_size + TF_MAX_BASE_REF_PICS + TF_MAX_EXTENSION;
+            min_input += first_pass_frames;
+            min_parent += first_pass_frames;
+            min_paref += first_pass_frames;
+        }
         //Configure max needed buffers to process 1+n_extra_mg Mini-Gops in the pipeline. n extra MGs to feed to picMgr on top of current one.
         // Low delay mode has no extra minigops to process.
         uint32_t n_extra_mg;
-        if (core_count <= PARALLEL_LEVEL_3_RANGE || is_low_delay) {
+        if (core_count <= PARALLEL_LEVEL_3_RANGE || is_low_delay || scs->mem_budget_level >= MEM_BUDGET_NO_EXTRA_MG) {
             n_extra_mg = 0;
         }
         else if (core_count <= PARALLEL_LEVEL_4_RANGE) {
@@ -717,6 +750,8 @@ static EbErrorType load_default_buffer_configuration_settings(
     else {
         scs->picture_control_set_pool_init_count_child = scs->enc_dec_pool_init_count = clamp(18, min_child, max_child) + superres_count;
     }
+    if (scs->mem_budget_level >= MEM_BUDGET_MIN_CHILD)
+        scs->picture_control_set_pool_init_count_child = scs->enc_dec_pool_init_count = min_child + superres_count;
 
     //#====================== Inter process Fifos ======================
     scs->resource_coordination_fifo_init_count       = 300;
@@ -813,8 +848,11 @@ static EbErrorType load_default_buffer_configuration_settings(
     }
 
     scs->total_process_init_count += 6; // single processes count
+    return return_error;
+}
+static void print_buffer_configuration_settings(SequenceControlSet *scs) {
     if (scs->static_config.pass == 0 || scs->static_config.pass == 3){
-        SVT_INFO("Number of logical cores available: %u\n", core_count);
+        SVT_INFO("Number of logical cores available: %u\n", scs->core_count);
         SVT_INFO("Number of PPCS %u\n", scs->picture_control_set_pool_init_count);
 
         /******************************************************************
@@ -832,7 +870,6 @@ static EbErrorType load_default_buffer_configuration_settings(
         SVT_INFO("[asm level selected : up to %s]\n", get_asm_level_name_str(scs->static_config.use_cpu_flags));
 #endif
     }
-    return return_error;
 }
  // Rate Control
 static RateControlPorts rate_control_ports[] = {
@@ -955,6 +992,8 @@ static uint32_t enc_dec_port_total_count(void){
 static void lib_svt_encoder_send_error_exit(
     EbPtr                    hComponent,
     uint32_t                 error_code);
+static void lib_svt_encoder_stop_pipeline(
+    EbPtr                    hComponent);
 
 static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 {
@@ -1031,6 +1070,8 @@ static void svt_enc_handle_dctor(EbPtr p)
     if (enc_handle_ptr->input_buffer_resource_ptr) {
         for (uint32_t w_i = 0; w_i < enc_handle_ptr->input_buffer_resource_ptr->object_total_count; ++w_i) {
             EbObjectWrapper *wrp = enc_handle_ptr->input_buffer_resource_ptr->wrapper_ptr_pool[w_i];
+            if (!wrp)
+                continue;
             EbBufferHeaderType*obj = (EbBufferHeaderType*)wrp->object_ptr;
             EbPictureBufferDesc *desc = (EbPictureBufferDesc *)obj->p_buffer;
             desc->buffer_y = 0;
@@ -1073,7 +1114,8 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->packetization_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-
+    if (enc_handle_ptr->blk_geom_in_use)
+        svt_aom_release_blk_geom();
 }
 
 /**********************************
@@ -1093,6 +1135,7 @@ static EbErrorType svt_enc_handle_ctor(
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_MALLOC(enc_handle_ptr->app_callback_ptr_array[0], sizeof(EbCallback));
     enc_handle_ptr->app_callback_ptr_array[0]->error_handler = lib_svt_encoder_send_error_exit;
+    enc_handle_ptr->app_callback_ptr_array[0]->stop_handler = lib_svt_encoder_stop_pipeline;
     enc_handle_ptr->app_callback_ptr_array[0]->handle = ebHandlePtr;
 
     // Config Set Count
@@ -1120,6 +1163,12 @@ EbErrorType svt_overlay_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr  object_init_data_ptr);
 
+/* Output stream buffer header, with the allocator of its packet buffer */
+typedef struct EbOutputBufferHeader {
+    EbBufferHeaderType                 header; // first, it is the one handed to the application
+    const SvtAv1OutputBufferAllocator *allocator;
+} EbOutputBufferHeader;
+
 EbErrorType svt_output_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr object_init_data_ptr);
@@ -1255,78 +1304,195 @@ static EbErrorType rest_results_creator(
     return EB_ErrorNone;
 }
 
+/* Init data of the parent PCS and ME objects */
+static void set_parent_pcs_init_data(SequenceControlSet *scs, EbColorFormat color_format,
+                                     PictureControlSetInitData *input_data) {
+    // The segment Width & Height Arrays are in units of SBs, not samples
+    input_data->picture_width = scs->max_input_luma_width;
+    input_data->picture_height = scs->max_input_luma_height;
+    input_data->left_padding = scs->left_padding;
+    input_data->right_padding = scs->right_padding;
+    input_data->top_padding = scs->top_padding;
+    input_data->bot_padding = scs->bot_padding;
+    input_data->color_format = color_format;
+    input_data->b64_size = scs->b64_size;
+    input_data->ten_bit_format = scs->ten_bit_format;
+    input_data->enc_mode = scs->static_config.enc_mode;
+    input_data->speed_control = (uint8_t)scs->speed_control_flag;
+    input_data->hbd_md = scs->enable_hbd_mode_decision;
+    input_data->bit_depth = scs->static_config.encoder_bit_depth;
+    input_data->log2_tile_rows = scs->static_config.tile_rows;
+    input_data->log2_tile_cols = scs->static_config.tile_columns;
+    input_data->log2_sb_size = (scs->super_block_size == 128) ? 5 : 4;
+    input_data->is_16bit_pipeline = scs->is_16bit_pipeline;
+    input_data->non_m8_pad_w = scs->max_input_pad_right;
+    input_data->non_m8_pad_h = scs->max_input_pad_bottom;
+    input_data->enable_tpl_la = scs->tpl;
+    input_data->in_loop_ois = scs->in_loop_ois;
+    input_data->enc_dec_segment_col = (uint16_t)scs->tpl_segment_col_count_array;
+    input_data->enc_dec_segment_row = (uint16_t)scs->tpl_segment_row_count_array;
+    input_data->final_pass_preset = scs->final_pass_preset;
+    input_data->rate_control_mode = scs->static_config.rate_control_mode;
+    MrpCtrls *mrp_ctrl = &scs->mrp_ctrls;
+    input_data->ref_count_used_list0 =
+        MAX(mrp_ctrl->sc_base_ref_list0_count,
+            MAX(mrp_ctrl->base_ref_list0_count,
+                MAX(mrp_ctrl->sc_non_base_ref_list0_count, mrp_ctrl->non_base_ref_list0_count)));
+
+    input_data->ref_count_used_list1 =
+        MAX(mrp_ctrl->sc_base_ref_list1_count,
+            MAX(mrp_ctrl->base_ref_list1_count,
+                MAX(mrp_ctrl->sc_non_base_ref_list1_count, mrp_ctrl->non_base_ref_list1_count)));
+    input_data->tpl_synth_size = svt_aom_set_tpl_group(NULL,
+        svt_aom_get_tpl_group_level(
+            1,
+            scs->static_config.enc_mode,
+            scs->static_config.rate_control_mode),
+        input_data->picture_width, input_data->picture_height);
+    input_data->enable_adaptive_quantization = scs->static_config.enable_adaptive_quantization;
+    input_data->calculate_variance = scs->calculate_variance;
+    input_data->calc_hist = scs->calc_hist =
+        scs->static_config.scene_change_detection ||
+        scs->vq_ctrls.sharpness_ctrls.scene_transition ||
+        scs->tf_params_per_type[0].enabled ||
+        scs->tf_params_per_type[1].enabled ||
+        scs->tf_params_per_type[2].enabled;
+    input_data->tpl_lad_mg = scs->tpl_lad_mg;
+    input_data->input_resolution = scs->input_resolution;
+    input_data->is_scale = scs->static_config.superres_mode > SUPERRES_NONE ||
+                           scs->static_config.resize_mode > RESIZE_NONE;
+    input_data->rtc_tune = (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
+    input_data->enable_variance_boost = scs->static_config.enable_variance_boost;
+    input_data->variance_boost_strength = scs->static_config.variance_boost_strength;
+    input_data->variance_octile = scs->static_config.variance_octile;
+    input_data->static_config = scs->static_config;
+}
+
+/* Init data of the child PCS and enc-dec objects, av1_cm is the one of a parent PCS */
+static void set_child_pcs_init_data(SequenceControlSet *scs, EbColorFormat color_format, Av1Common *av1_cm,
+                                    PictureControlSetInitData *input_data) {
+    // The segment Width & Height Arrays are in units of SBs, not samples
+    unsigned i;
+
+    input_data->enc_dec_segment_col = 0;
+    input_data->enc_dec_segment_row = 0;
+    for (i = 0; i <= scs->static_config.hierarchical_levels; ++i) {
+        input_data->enc_dec_segment_col = scs->enc_dec_segment_col_count_array[i] > input_data->enc_dec_segment_col ?
+            (uint16_t)scs->enc_dec_segment_col_count_array[i] :
+            input_data->enc_dec_segment_col;
+        input_data->enc_dec_segment_row = scs->enc_dec_segment_row_count_array[i] > input_data->enc_dec_segment_row ?
+            (uint16_t)scs->enc_dec_segment_row_count_array[i] :
+            input_data->enc_dec_segment_row;
+    }
+
+    input_data->init_max_block_cnt = scs->max_block_cnt;
+    input_data->picture_width = scs->max_input_luma_width;
+    input_data->picture_height = scs->max_input_luma_height;
+    input_data->left_padding = scs->left_padding;
+    input_data->right_padding = scs->right_padding;
+    input_data->top_padding = scs->top_padding;
+    input_data->bot_padding = scs->bot_padding;
+    input_data->bit_depth = scs->encoder_bit_depth;
+    input_data->color_format = color_format;
+    input_data->b64_size = scs->b64_size;
+    input_data->sb_size = scs->super_block_size;
+    input_data->hbd_md = scs->enable_hbd_mode_decision;
+    input_data->cdf_mode = scs->cdf_mode;
+    input_data->mfmv = scs->mfmv_enabled;
+    input_data->cfg_palette = scs->static_config.screen_content_mode;
+    //Jing: Get tile info from parent_pcs
+    input_data->tile_row_count = av1_cm->tiles_info.tile_rows;
+    input_data->tile_column_count = av1_cm->tiles_info.tile_cols;
+    input_data->is_16bit_pipeline = scs->is_16bit_pipeline;
+    input_data->av1_cm = av1_cm;
+    input_data->enc_mode = scs->static_config.enc_mode;
+    input_data->static_config = scs->static_config;
+
+    input_data->input_resolution = scs->input_resolution;
+    input_data->is_scale = scs->static_config.superres_mode > SUPERRES_NONE ||
+                           scs->static_config.resize_mode > RESIZE_NONE;
+}
+
+/* Init data of the PA reference objects */
+static void set_pa_ref_obj_init_data(SequenceControlSet *scs, EbPaReferenceObjectDescInitData *init_data) {
+    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
+    EbPictureBufferDescInitData       quart_pic_buf_desc_init_data;
+    EbPictureBufferDescInitData       sixteenth_pic_buf_desc_init_data;
+    // PA Reference Picture Buffers
+    // Currently, only Luma samples are needed in the PA
+    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
+    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
+    ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
+    //No full-resolution pixel data is allocated for PA REF,
+    // it points directly to the Luma input samples of the app data
+    ref_pic_buf_desc_init_data.buffer_enable_mask = 0;
+
+
+    ref_pic_buf_desc_init_data.left_padding = scs->left_padding;
+    ref_pic_buf_desc_init_data.right_padding = scs->right_padding;
+    ref_pic_buf_desc_init_data.top_padding = scs->top_padding;
+    ref_pic_buf_desc_init_data.bot_padding = scs->bot_padding;
+    ref_pic_buf_desc_init_data.split_mode = FALSE;
+    ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    ref_pic_buf_desc_init_data.mfmv                = 0;
+    ref_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    ref_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    ref_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    quart_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 1;
+    quart_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 1;
+    quart_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    quart_pic_buf_desc_init_data.color_format = EB_YUV420;
+    quart_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    quart_pic_buf_desc_init_data.left_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.right_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.top_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.split_mode = FALSE;
+    quart_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    quart_pic_buf_desc_init_data.mfmv                = 0;
+    quart_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    quart_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    quart_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    sixteenth_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 2;
+    sixteenth_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 2;
+    sixteenth_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    sixteenth_pic_buf_desc_init_data.color_format = EB_YUV420;
+    sixteenth_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    sixteenth_pic_buf_desc_init_data.left_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.right_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.top_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.split_mode = FALSE;
+    sixteenth_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    sixteenth_pic_buf_desc_init_data.mfmv                = 0;
+    sixteenth_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    sixteenth_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    sixteenth_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    init_data->quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
+    init_data->sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+}
+
 static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
 {
         SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
         EbPaReferenceObjectDescInitData   eb_pa_ref_obj_ect_desc_init_data_structure;
-        EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
-        EbPictureBufferDescInitData       quart_pic_buf_desc_init_data;
-        EbPictureBufferDescInitData       sixteenth_pic_buf_desc_init_data;
-        // PA Reference Picture Buffers
-        // Currently, only Luma samples are needed in the PA
-        ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
-        ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
-        ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
-        //No full-resolution pixel data is allocated for PA REF,
-        // it points directly to the Luma input samples of the app data
-        ref_pic_buf_desc_init_data.buffer_enable_mask = 0;
-
-
-        ref_pic_buf_desc_init_data.left_padding = scs->left_padding;
-        ref_pic_buf_desc_init_data.right_padding = scs->right_padding;
-        ref_pic_buf_desc_init_data.top_padding = scs->top_padding;
-        ref_pic_buf_desc_init_data.bot_padding = scs->bot_padding;
-        ref_pic_buf_desc_init_data.split_mode = FALSE;
-        ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        ref_pic_buf_desc_init_data.mfmv                = 0;
-        ref_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        ref_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        ref_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        quart_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 1;
-        quart_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 1;
-        quart_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        quart_pic_buf_desc_init_data.color_format = EB_YUV420;
-        quart_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        quart_pic_buf_desc_init_data.left_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.right_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.top_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.split_mode = FALSE;
-        quart_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        quart_pic_buf_desc_init_data.mfmv                = 0;
-        quart_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        quart_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        quart_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        sixteenth_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 2;
-        sixteenth_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 2;
-        sixteenth_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        sixteenth_pic_buf_desc_init_data.color_format = EB_YUV420;
-        sixteenth_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        sixteenth_pic_buf_desc_init_data.left_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.right_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.top_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.split_mode = FALSE;
-        sixteenth_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        sixteenth_pic_buf_desc_init_data.mfmv                = 0;
-        sixteenth_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        sixteenth_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        sixteenth_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        eb_pa_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
-        eb_pa_ref_obj_ect_desc_init_data_structure.quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
-        eb_pa_ref_obj_ect_desc_init_data_structure.sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+
+        set_pa_ref_obj_init_data(scs, &eb_pa_ref_obj_ect_desc_init_data_structure);
         // Reference Picture Buffers
         EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_lazy_ctor,
             scs->pa_reference_picture_buffer_init_count,
+            ENC_POOL_LAZY_INIT_COUNT,
             EB_PictureDecisionProcessInitCount,
             0,
             svt_pa_reference_object_creator,
             &(eb_pa_ref_obj_ect_desc_init_data_structure),
+            sizeof(eb_pa_ref_obj_ect_desc_init_data_structure),
             NULL);
         // Set the SequenceControlSet Picture Pool Fifo Ptrs
         enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->pa_reference_picture_pool_fifo_ptr =
@@ -1337,10 +1503,8 @@ static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instanc
         return 0;
 }
 
-static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
-{
-    SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
-    EbTplReferenceObjectDescInitData   eb_tpl_ref_obj_ect_desc_init_data_structure;
+/* Init data of the TPL reference objects */
+static void set_tpl_ref_obj_init_data(SequenceControlSet *scs, EbTplReferenceObjectDescInitData *init_data) {
     EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
     // PA Reference Picture Buffers
     // Currently, only Luma samples are needed in the PA
@@ -1364,15 +1528,25 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
     ref_pic_buf_desc_init_data.rest_units_per_tile = 0;// rest not needed in tpl scs->rest_units_per_tile;
     ref_pic_buf_desc_init_data.sb_total_count = scs->sb_total_count;
 
-    eb_tpl_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+}
+
+static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
+{
+    SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
+    EbTplReferenceObjectDescInitData   eb_tpl_ref_obj_ect_desc_init_data_structure;
+
+    set_tpl_ref_obj_init_data(scs, &eb_tpl_ref_obj_ect_desc_init_data_structure);
     // Reference Picture Buffers
     EB_NEW(enc_handle_ptr->tpl_reference_picture_pool_ptr_array[instance_index],
-        svt_system_resource_ctor,
+        svt_system_resource_lazy_ctor,
         scs->tpl_reference_picture_buffer_init_count,
+        ENC_POOL_LAZY_INIT_COUNT,
         EB_PictureDecisionProcessInitCount,
         0,
         svt_tpl_reference_object_creator,
         &(eb_tpl_ref_obj_ect_desc_init_data_structure),
+        sizeof(eb_tpl_ref_obj_ect_desc_init_data_structure),
         NULL);
     // Set the SequenceControlSet Picture Pool Fifo Ptrs
     enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->tpl_reference_picture_pool_fifo_ptr =
@@ -1382,11 +1556,10 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
 #endif
     return 0;
 }
-static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
-{
-    EbReferenceObjectDescInitData     eb_ref_obj_ect_desc_init_data_structure;
+
+/* Init data of the reference objects */
+static void set_ref_obj_init_data(SequenceControlSet *scs, EbReferenceObjectDescInitData *init_data) {
     EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
-    SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
     Bool is_16bit = (Bool)(scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
     // Initialize the various Picture types
     ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
@@ -1415,19 +1588,28 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
     if (is_16bit)
         ref_pic_buf_desc_init_data.bit_depth = EB_TEN_BIT;
 
-    eb_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
-    eb_ref_obj_ect_desc_init_data_structure.hbd_md =
-        scs->enable_hbd_mode_decision;
-    eb_ref_obj_ect_desc_init_data_structure.static_config = &scs->static_config;
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    init_data->hbd_md = scs->enable_hbd_mode_decision;
+    init_data->static_config = &scs->static_config;
+}
+
+static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
+{
+    EbReferenceObjectDescInitData     eb_ref_obj_ect_desc_init_data_structure;
+    SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
+
+    set_ref_obj_init_data(scs, &eb_ref_obj_ect_desc_init_data_structure);
     // Reference Picture Buffers
     EB_NEW(
             enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_lazy_ctor,
             scs->reference_picture_buffer_init_count,//enc_handle_ptr->ref_pic_pool_total_count,
+            ENC_POOL_LAZY_INIT_COUNT,
             EB_PictureManagerProcessInitCount,
             0,
             svt_reference_object_creator,
             &(eb_ref_obj_ect_desc_init_data_structure),
+            sizeof(eb_ref_obj_ect_desc_init_data_structure),
             NULL);
 
     // Create reference list for Picture Manager
@@ -1461,6 +1643,231 @@ void svt_av1_init_wedge_masks(void);
 /**********************************
 * Initialize Encoder Library
 **********************************/
+/* Adds the bytes allocated by the calling thread since *mark to the given pool */
+static void account_pool_memory(EbEncHandle *enc_handle_ptr, EncMemoryPool pool, uint64_t *mark) {
+    const uint64_t now = svt_get_thread_alloc_bytes();
+    enc_handle_ptr->pool_bytes[pool] += now - *mark;
+    *mark = now;
+}
+
+/* The pools of each EncMemoryPool, NULL for the groups that are not a pool */
+static void get_pool_resources(EbEncHandle *enc_handle, EbSystemResource *resources[ENC_MEM_POOL_COUNT]) {
+    memset(resources, 0, ENC_MEM_POOL_COUNT * sizeof(resources[0]));
+    if (enc_handle->picture_parent_control_set_pool_ptr_array)
+        resources[ENC_MEM_POOL_PARENT_PCS] = enc_handle->picture_parent_control_set_pool_ptr_array[0];
+    if (enc_handle->me_pool_ptr_array)
+        resources[ENC_MEM_POOL_ME] = enc_handle->me_pool_ptr_array[0];
+    if (enc_handle->picture_control_set_pool_ptr_array)
+        resources[ENC_MEM_POOL_CHILD_PCS] = enc_handle->picture_control_set_pool_ptr_array[0];
+    if (enc_handle->enc_dec_pool_ptr_array)
+        resources[ENC_MEM_POOL_ENC_DEC] = enc_handle->enc_dec_pool_ptr_array[0];
+    if (enc_handle->reference_picture_pool_ptr_array)
+        resources[ENC_MEM_POOL_REFERENCE] = enc_handle->reference_picture_pool_ptr_array[0];
+    if (enc_handle->tpl_reference_picture_pool_ptr_array)
+        resources[ENC_MEM_POOL_TPL_REFERENCE] = enc_handle->tpl_reference_picture_pool_ptr_array[0];
+    if (enc_handle->pa_reference_picture_pool_ptr_array)
+        resources[ENC_MEM_POOL_PA_REFERENCE] = enc_handle->pa_reference_picture_pool_ptr_array[0];
+    if (enc_handle->overlay_input_picture_pool_ptr_array)
+        resources[ENC_MEM_POOL_OVERLAY_INPUT] = enc_handle->overlay_input_picture_pool_ptr_array[0];
+    resources[ENC_MEM_POOL_INPUT]     = enc_handle->input_buffer_resource_ptr;
+    resources[ENC_MEM_POOL_INPUT_Y8B] = enc_handle->input_y8b_buffer_resource_ptr;
+}
+
+/* The object count of each EncMemoryPool for the buffer counts of scs */
+static void get_pool_counts(const SequenceControlSet *scs, uint32_t counts[ENC_MEM_POOL_COUNT]) {
+    memset(counts, 0, ENC_MEM_POOL_COUNT * sizeof(counts[0]));
+    counts[ENC_MEM_POOL_PARENT_PCS]    = scs->picture_control_set_pool_init_count;
+    counts[ENC_MEM_POOL_ME]            = scs->me_pool_init_count;
+    counts[ENC_MEM_POOL_CHILD_PCS]     = scs->picture_control_set_pool_init_count_child;
+    counts[ENC_MEM_POOL_ENC_DEC]       = scs->enc_dec_pool_init_count;
+    counts[ENC_MEM_POOL_REFERENCE]     = scs->reference_picture_buffer_init_count;
+    counts[ENC_MEM_POOL_TPL_REFERENCE] = scs->tpl_reference_picture_buffer_init_count;
+    counts[ENC_MEM_POOL_PA_REFERENCE]  = scs->pa_reference_picture_buffer_init_count;
+    counts[ENC_MEM_POOL_OVERLAY_INPUT] = scs->overlay_input_picture_buffer_init_count;
+    counts[ENC_MEM_POOL_INPUT]         = scs->input_buffer_fifo_init_count;
+    counts[ENC_MEM_POOL_INPUT_Y8B]     = MAX(scs->input_buffer_fifo_init_count, scs->pa_reference_picture_buffer_init_count);
+}
+
+/*
+Estimates the memory of the encoder once its pools hold counts objects: the memory allocated by svt_av1_enc_init()
+before the pools, plus the objects of the pools, each costing what the object measured by measure_pool_objects()
+allocated
+*/
+static uint64_t estimate_memory_bytes(const EbEncHandle *enc_handle, const uint32_t counts[ENC_MEM_POOL_COUNT]) {
+    uint64_t bytes = 0;
+    for (int i = 0; i < ENC_MEM_POOL_COUNT; i++)
+        bytes += enc_handle->pool_bytes[i] + counts[i] * enc_handle->object_bytes[i];
+    return bytes;
+}
+
+/* Constructs the object of a pool measured by measure_pool_objects() */
+static EbErrorType measure_pool_object(EbEncHandle *enc_handle, EncMemoryPool pool, EbCreator creator,
+                                       EbPtr init_data, EbPtr objects[ENC_MEM_POOL_COUNT]) {
+    const uint64_t    alloc_mark   = svt_get_thread_alloc_bytes();
+    const EbErrorType return_error = creator(&objects[pool], init_data);
+    enc_handle->object_bytes[pool] = svt_get_thread_alloc_bytes() - alloc_mark;
+    return return_error;
+}
+
+/*
+Measures the memory of one object of each pool, constructed from the init data of the pools, before the pools
+exist. The child PCS also gives the restoration units and the 64x64 blocks of the references. The objects are
+released once measured.
+*/
+static EbErrorType measure_pool_objects(EbEncHandle *enc_handle, EbColorFormat color_format) {
+    SequenceControlSet              *scs                            = enc_handle->scs_instance_array[0]->scs;
+    EbPtr                            objects[ENC_MEM_POOL_COUNT]    = {NULL};
+    EbDctor                          destroyers[ENC_MEM_POOL_COUNT] = {NULL};
+    PictureControlSetInitData        parent_data, child_data;
+    EbReferenceObjectDescInitData    ref_data;
+    EbTplReferenceObjectDescInitData tpl_ref_data;
+    EbPaReferenceObjectDescInitData  pa_ref_data;
+    EbErrorType                      return_error;
+
+    set_parent_pcs_init_data(scs, color_format, &parent_data);
+    return_error = measure_pool_object(
+        enc_handle, ENC_MEM_POOL_PARENT_PCS, svt_aom_picture_parent_control_set_creator, &parent_data, objects);
+    if (return_error == EB_ErrorNone)
+        return_error = measure_pool_object(enc_handle, ENC_MEM_POOL_ME, svt_aom_me_creator, &parent_data, objects);
+    if (return_error == EB_ErrorNone) {
+        set_child_pcs_init_data(
+            scs, color_format, ((PictureParentControlSet *)objects[ENC_MEM_POOL_PARENT_PCS])->av1_cm, &child_data);
+        return_error = measure_pool_object(
+            enc_handle, ENC_MEM_POOL_ENC_DEC, svt_aom_recon_coef_creator, &child_data, objects);
+    }
+    if (return_error == EB_ErrorNone)
+        return_error = measure_pool_object(
+            enc_handle, ENC_MEM_POOL_CHILD_PCS, svt_aom_picture_control_set_creator, &child_data, objects);
+    if (return_error == EB_ErrorNone) {
+        // Must always allocate mem b/c don't know if restoration is on or off at this point
+        // The restoration assumes only 1 tile is used, so only allocate for 1 tile... see svt_av1_alloc_restoration_struct()
+        PictureControlSet *pcs   = (PictureControlSet *)objects[ENC_MEM_POOL_CHILD_PCS];
+        scs->rest_units_per_tile = pcs->rst_info[0 /*Y-plane*/].units_per_tile;
+        scs->b64_total_count     = pcs->b64_total_count;
+        set_ref_obj_init_data(scs, &ref_data);
+        return_error = measure_pool_object(
+            enc_handle, ENC_MEM_POOL_REFERENCE, svt_reference_object_creator, &ref_data, objects);
+    }
+    if (return_error == EB_ErrorNone) {
+        set_tpl_ref_obj_init_data(scs, &tpl_ref_data);
+        return_error = measure_pool_object(
+            enc_handle, ENC_MEM_POOL_TPL_REFERENCE, svt_tpl_reference_object_creator, &tpl_ref_data, objects);
+    }
+    if (return_error == EB_ErrorNone) {
+        set_pa_ref_obj_init_data(scs, &pa_ref_data);
+        return_error = measure_pool_object(
+            enc_handle, ENC_MEM_POOL_PA_REFERENCE, svt_pa_reference_object_creator, &pa_ref_data, objects);
+    }
+    if (return_error == EB_ErrorNone && scs->static_config.enable_overlays) {
+        destroyers[ENC_MEM_POOL_OVERLAY_INPUT] = svt_input_buffer_header_destroyer;
+        return_error                           = measure_pool_object(
+            enc_handle, ENC_MEM_POOL_OVERLAY_INPUT, svt_overlay_buffer_header_creator, scs, objects);
+    }
+    if (return_error == EB_ErrorNone) {
+        destroyers[ENC_MEM_POOL_INPUT] = svt_input_buffer_header_destroyer;
+        return_error = measure_pool_object(enc_handle, ENC_MEM_POOL_INPUT, svt_input_buffer_header_creator, scs, objects);
+    }
+    if (return_error == EB_ErrorNone) {
+        destroyers[ENC_MEM_POOL_INPUT_Y8B] = svt_input_y8b_destroyer;
+        return_error = measure_pool_object(enc_handle, ENC_MEM_POOL_INPUT_Y8B, svt_input_y8b_creator, scs, objects);
+    }
+    // the child PCS and enc-dec objects point to the av1_cm of the parent PCS
+    for (int i = ENC_MEM_POOL_COUNT - 1; i >= 0; i--)
+        if (objects[i])
+            svt_destroy_object(objects[i], destroyers[i]);
+    return return_error;
+}
+
+/*
+Applies the buffer reduction steps while the estimated memory exceeds max_memory_mb, and fails when the smallest
+buffering does not fit. Called before the pools are constructed, as they are sized from the buffer counts, and
+before the contexts, as the number of processes follows the buffer counts.
+*/
+static EbErrorType fit_memory_budget(EbEncHandle *enc_handle) {
+    SequenceControlSet *scs          = enc_handle->scs_instance_array[0]->scs;
+    const uint64_t      limit        = (uint64_t)scs->static_config.max_memory_mb << 20;
+    EbErrorType         return_error = EB_ErrorNone;
+    uint32_t            counts[ENC_MEM_POOL_COUNT];
+
+    get_pool_counts(scs, counts);
+    scs->estimated_memory_bytes = estimate_memory_bytes(enc_handle, counts);
+    while (limit && scs->estimated_memory_bytes > limit) {
+        if (scs->mem_budget_level + 1 == MEM_BUDGET_LEVELS) {
+            SVT_ERROR("max-memory %u MB is below the %u MB estimated for the smallest buffering\n",
+                      scs->static_config.max_memory_mb,
+                      (uint32_t)((scs->estimated_memory_bytes + (1 << 20) - 1) >> 20));
+            return EB_ErrorInsufficientResources;
+        }
+        scs->mem_budget_level++;
+        apply_memory_budget_level(scs);
+        return_error = load_default_buffer_configuration_settings(scs);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        get_pool_counts(scs, counts);
+        scs->estimated_memory_bytes = estimate_memory_bytes(enc_handle, counts);
+    }
+    if (limit)
+        SVT_INFO("SVT [config]: max memory / estimated memory / reduction level \t\t: %u MB / %u MB / %d\n",
+                 scs->static_config.max_memory_mb,
+                 (uint32_t)(scs->estimated_memory_bytes >> 20),
+                 scs->mem_budget_level);
+    return return_error;
+}
+
+/**********************************
+* Pipelined two pass
+**********************************/
+/* Drain the packets of the first pass encoder, and signal initial rate control that the first pass
+ * moved forward */
+static void *first_pass_drain_kernel(void *input_ptr) {
+    EbEncHandle   *enc_handle_ptr = (EbEncHandle *)input_ptr;
+    EbEncHandle   *fp_handle_ptr  = (EbEncHandle *)enc_handle_ptr->first_pass_handle->p_component_private;
+    EncodeContext *enc_ctx        = enc_handle_ptr->scs_instance_array[0]->enc_ctx;
+    Bool           eos            = FALSE;
+    while (!eos) {
+        EbObjectWrapper *wrapper_ptr;
+        svt_get_full_object(fp_handle_ptr->output_stream_buffer_consumer_fifo_ptr, &wrapper_ptr);
+        EbBufferHeaderType *packet = (EbBufferHeaderType *)wrapper_ptr->object_ptr;
+        eos                        = (packet->flags & (EB_BUFFERFLAG_EOS | EB_BUFFERFLAG_ERROR_MASK)) != 0;
+        packet->wrapper_ptr        = (void *)wrapper_ptr;
+        svt_av1_enc_release_out_buffer(&packet);
+        svt_post_semaphore(enc_ctx->first_pass_semaphore);
+    }
+    // the deinit of the first pass encoder has no packet left to wait for
+    fp_handle_ptr->eos_sent  = true;
+    enc_ctx->first_pass_ended = TRUE;
+    svt_post_semaphore(enc_ctx->first_pass_semaphore);
+    return NULL;
+}
+
+/* Create the first pass encoder, from the configuration of the application */
+static EbErrorType first_pass_init(EbEncHandle *enc_handle_ptr) {
+    EncodeContext           *enc_ctx = enc_handle_ptr->scs_instance_array[0]->enc_ctx;
+    EbSvtAv1EncConfiguration config;
+    EbErrorType return_error = svt_av1_enc_init_handle(&enc_handle_ptr->first_pass_handle, NULL, &config);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    EbEncHandle *fp_handle_ptr = (EbEncHandle *)enc_handle_ptr->first_pass_handle->p_component_private;
+    fp_handle_ptr->scs_instance_array[0]->scs->final_pass_scs = enc_handle_ptr->scs_instance_array[0]->scs;
+    config       = enc_handle_ptr->first_pass_config;
+    return_error = svt_av1_enc_set_parameter(enc_handle_ptr->first_pass_handle, &config);
+    if (return_error == EB_ErrorNone)
+        return_error = svt_av1_enc_init(enc_handle_ptr->first_pass_handle);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    enc_ctx->first_pass_enc_ctx = fp_handle_ptr->scs_instance_array[0]->enc_ctx;
+    EB_CREATE_SEMAPHORE(enc_ctx->first_pass_semaphore, 0, INT32_MAX);
+    return EB_ErrorNone;
+}
+
+/* Stop the first pass encoder, once it got the EOS */
+static void first_pass_deinit(EbEncHandle *enc_handle_ptr) {
+    EB_DESTROY_THREAD(enc_handle_ptr->first_pass_thread_handle);
+    svt_av1_enc_deinit(enc_handle_ptr->first_pass_handle);
+    svt_av1_enc_deinit_handle(enc_handle_ptr->first_pass_handle);
+    enc_handle_ptr->first_pass_handle = NULL;
+}
+
 EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 {
     if(svt_enc_component == NULL)
@@ -1471,7 +1878,10 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     uint32_t process_index;
     EbColorFormat color_format = enc_handle_ptr->scs_instance_array[0]->scs->static_config.encoder_color_format;
     SequenceControlSet* control_set_ptr;
+    uint64_t alloc_mark = svt_get_thread_alloc_bytes();
 
+    // The kernel tables are shared by the encoders of the process, which all run with the asm level
+    // of the last one initialized. The kernels of every level give the same output.
     svt_aom_setup_common_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
     svt_aom_setup_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
 
@@ -1482,10 +1892,16 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     svt_aom_asm_set_convolve_hbd_asm_table();
 
     svt_aom_init_intra_predictors_internal();
+    // The first pass encoder of the pipelined two pass uses the block geometry of the final pass
+    if (!enc_handle_ptr->scs_instance_array[0]->scs->final_pass_scs) {
     #ifdef MINIMAL_BUILD
-    svt_aom_blk_geom_mds = svt_aom_malloc(MAX_NUM_BLOCKS_ALLOC * sizeof(svt_aom_blk_geom_mds[0]));
+        svt_aom_blk_geom_mds = svt_aom_malloc(MAX_NUM_BLOCKS_ALLOC * sizeof(svt_aom_blk_geom_mds[0]));
     #endif
-    svt_aom_build_blk_geom(enc_handle_ptr->scs_instance_array[0]->scs->svt_aom_geom_idx);
+        return_error = svt_aom_build_blk_geom(enc_handle_ptr->scs_instance_array[0]->scs->svt_aom_geom_idx);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        enc_handle_ptr->blk_geom_in_use = true;
+    }
 
     svt_av1_init_me_luts();
     init_fn_ptr();
@@ -1506,94 +1922,73 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             NULL);
     }
     /************************************
+    * Deadline mode
+    ************************************/
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        SequenceControlSet *scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
+        const uint32_t num_logical_processors = get_num_processors();
+        const uint32_t lp = scs->static_config.logical_processors;
+        svt_aom_deadline_ctrl_init(&scs->enc_ctx->deadline_ctrl,
+                                   &scs->static_config,
+                                   lp ? MIN(lp, num_logical_processors) : num_logical_processors);
+    }
+    /************************************
+    * Key frame checkpoints
+    ************************************/
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
+        SequenceControlSet *scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
+        return_error = svt_aom_checkpoint_ctrl_init(&scs->enc_ctx->checkpoint_ctrl, scs);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    /************************************
+    * Memory budget
+    ************************************/
+    account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_OTHER, &alloc_mark);
+    return_error = measure_pool_objects(enc_handle_ptr, color_format);
+    // the measured objects are released, they are not part of the memory of the encoder
+    alloc_mark = svt_get_thread_alloc_bytes();
+    if (return_error == EB_ErrorNone)
+        return_error = fit_memory_budget(enc_handle_ptr);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    /************************************
     * Picture Control Set: Parent
     ************************************/
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->me_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-        // The segment Width & Height Arrays are in units of SBs, not samples
         PictureControlSetInitData input_data;
 
-        input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-        input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-        input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-        input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-        input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-        input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-        input_data.color_format = color_format;
-        input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-        input_data.ten_bit_format = enc_handle_ptr->scs_instance_array[instance_index]->scs->ten_bit_format;
-        input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
-        input_data.speed_control = (uint8_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->speed_control_flag;
-        input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-        input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.encoder_bit_depth;
-        input_data.log2_tile_rows = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tile_rows;
-        input_data.log2_tile_cols = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tile_columns;
-        input_data.log2_sb_size = (enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size == 128) ? 5 : 4;
-        input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-        input_data.non_m8_pad_w = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_pad_right;
-        input_data.non_m8_pad_h = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_pad_bottom;
-        input_data.enable_tpl_la = enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl;
-        input_data.in_loop_ois = enc_handle_ptr->scs_instance_array[instance_index]->scs->in_loop_ois;
-        input_data.enc_dec_segment_col = (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_segment_col_count_array;
-        input_data.enc_dec_segment_row = (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_segment_row_count_array;
-        input_data.final_pass_preset = enc_handle_ptr->scs_instance_array[instance_index]->scs->final_pass_preset;
-        input_data.rate_control_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.rate_control_mode;
-        MrpCtrls* mrp_ctrl = &(enc_handle_ptr->scs_instance_array[0]->scs->mrp_ctrls);
-        input_data.ref_count_used_list0 =
-            MAX(mrp_ctrl->sc_base_ref_list0_count,
-                MAX(mrp_ctrl->base_ref_list0_count,
-                    MAX(mrp_ctrl->sc_non_base_ref_list0_count, mrp_ctrl->non_base_ref_list0_count)));
-
-        input_data.ref_count_used_list1 =
-            MAX(mrp_ctrl->sc_base_ref_list1_count,
-                MAX(mrp_ctrl->base_ref_list1_count,
-                    MAX(mrp_ctrl->sc_non_base_ref_list1_count, mrp_ctrl->non_base_ref_list1_count)));
-        input_data.tpl_synth_size = svt_aom_set_tpl_group(NULL,
-            svt_aom_get_tpl_group_level(
-                1,
-                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode,
-                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.rate_control_mode),
-            input_data.picture_width, input_data.picture_height);
-        input_data.enable_adaptive_quantization = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enable_adaptive_quantization;
-        input_data.calculate_variance = enc_handle_ptr->scs_instance_array[instance_index]->scs->calculate_variance;
-        input_data.calc_hist = enc_handle_ptr->scs_instance_array[instance_index]->scs->calc_hist =
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.scene_change_detection ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->vq_ctrls.sharpness_ctrls.scene_transition ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[0].enabled ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[1].enabled ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[2].enabled;
-        input_data.tpl_lad_mg = enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_lad_mg;
-        input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-        input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                              enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
-        input_data.rtc_tune = (enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
-        input_data.enable_variance_boost = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enable_variance_boost;
-        input_data.variance_boost_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.variance_boost_strength;
-        input_data.variance_octile = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.variance_octile;
-        input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
+        set_parent_pcs_init_data(enc_handle_ptr->scs_instance_array[instance_index]->scs, color_format, &input_data);
 
         EB_NEW(
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_lazy_ctor,
             enc_handle_ptr->scs_instance_array[instance_index]->scs->picture_control_set_pool_init_count,//enc_handle_ptr->pcs_pool_total_count,
+            ENC_POOL_LAZY_INIT_COUNT,
             1,
             0,
             svt_aom_picture_parent_control_set_creator,
             &input_data,
+            sizeof(input_data),
             NULL);
+        account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_PARENT_PCS, &alloc_mark);
 #if SRM_REPORT
         enc_handle_ptr->picture_parent_control_set_pool_ptr_array[0]->empty_queue->log = 0;
 #endif
         EB_NEW(
             enc_handle_ptr->me_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_lazy_ctor,
             enc_handle_ptr->scs_instance_array[instance_index]->scs->me_pool_init_count,
+            ENC_POOL_LAZY_INIT_COUNT,
             1,
             0,
             svt_aom_me_creator,
             &input_data,
+            sizeof(input_data),
             NULL);
+        account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_ME, &alloc_mark);
 #if SRM_REPORT
         enc_handle_ptr->me_pool_ptr_array[instance_index]->empty_queue->log = 0;
         dump_srm_content(enc_handle_ptr->me_pool_ptr_array[instance_index], FALSE);
@@ -1605,55 +2000,24 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->enc_dec_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-            // The segment Width & Height Arrays are in units of SBs, not samples
             PictureControlSetInitData input_data;
-            unsigned i;
-            input_data.enc_dec_segment_col = 0;
-            input_data.enc_dec_segment_row = 0;
-            for (i = 0; i <= enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.hierarchical_levels; ++i) {
-                input_data.enc_dec_segment_col = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] > input_data.enc_dec_segment_col ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] :
-                    input_data.enc_dec_segment_col;
-                input_data.enc_dec_segment_row = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] > input_data.enc_dec_segment_row ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] :
-                    input_data.enc_dec_segment_row;
-            }
-
-            input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-            input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-            input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-            input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-            input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-            input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-            input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->encoder_bit_depth;
-            input_data.color_format = color_format;
-            input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-            input_data.sb_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size;
-            input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-            input_data.cdf_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->cdf_mode;
-            input_data.mfmv = enc_handle_ptr->scs_instance_array[instance_index]->scs->mfmv_enabled;
-            input_data.cfg_palette = enc_handle_ptr->scs_instance_array[0]->scs->static_config.screen_content_mode;
-            //Jing: Get tile info from parent_pcs
             PictureParentControlSet *parent_pcs = (PictureParentControlSet *)enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
-            input_data.tile_row_count = parent_pcs->av1_cm->tiles_info.tile_rows;
-            input_data.tile_column_count = parent_pcs->av1_cm->tiles_info.tile_cols;
-            input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-            input_data.av1_cm = parent_pcs->av1_cm;
-            input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
 
-            input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-            input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                                  enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
+            set_child_pcs_init_data(
+                enc_handle_ptr->scs_instance_array[instance_index]->scs, color_format, parent_pcs->av1_cm, &input_data);
 
             EB_NEW(
                 enc_handle_ptr->enc_dec_pool_ptr_array[instance_index],
-                svt_system_resource_ctor,
+                svt_system_resource_lazy_ctor,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_pool_init_count, //EB_PictureControlSetPoolInitCountChild,
+                ENC_POOL_LAZY_INIT_COUNT,
                 1,
                 0,
                 svt_aom_recon_coef_creator,
                 &input_data,
+                sizeof(input_data),
                 NULL);
+            account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_ENC_DEC, &alloc_mark);
         }
 
 
@@ -1665,58 +2029,24 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-            // The segment Width & Height Arrays are in units of SBs, not samples
             PictureControlSetInitData input_data;
-            unsigned i;
-
-            input_data.enc_dec_segment_col = 0;
-            input_data.enc_dec_segment_row = 0;
-            for (i = 0; i <= enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.hierarchical_levels; ++i) {
-                input_data.enc_dec_segment_col = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] > input_data.enc_dec_segment_col ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] :
-                    input_data.enc_dec_segment_col;
-                input_data.enc_dec_segment_row = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] > input_data.enc_dec_segment_row ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] :
-                    input_data.enc_dec_segment_row;
-            }
-
-            input_data.init_max_block_cnt = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_block_cnt;
-            input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-            input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-            input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-            input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-            input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-            input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-            input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->encoder_bit_depth;
-            input_data.color_format = color_format;
-            input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-            input_data.sb_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size;
-            input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-            input_data.cdf_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->cdf_mode;
-            input_data.mfmv = enc_handle_ptr->scs_instance_array[instance_index]->scs->mfmv_enabled;
-            input_data.cfg_palette = enc_handle_ptr->scs_instance_array[0]->scs->static_config.screen_content_mode;
-            //Jing: Get tile info from parent_pcs
             PictureParentControlSet *parent_pcs = (PictureParentControlSet *)enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
-            input_data.tile_row_count = parent_pcs->av1_cm->tiles_info.tile_rows;
-            input_data.tile_column_count = parent_pcs->av1_cm->tiles_info.tile_cols;
-            input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-            input_data.av1_cm = parent_pcs->av1_cm;
-            input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
-            input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
 
-            input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-            input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                                  enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
+            set_child_pcs_init_data(
+                enc_handle_ptr->scs_instance_array[instance_index]->scs, color_format, parent_pcs->av1_cm, &input_data);
 
             EB_NEW(
                 enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
-                svt_system_resource_ctor,
+                svt_system_resource_lazy_ctor,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
+                ENC_POOL_LAZY_INIT_COUNT,
                 1,
                 0,
                 svt_aom_picture_control_set_creator,
                 &input_data,
+                sizeof(input_data),
                 NULL);
+            account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_CHILD_PCS, &alloc_mark);
         }
 
     /************************************
@@ -1731,29 +2061,17 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->overlay_input_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
-    pic_mgr_ports[PIC_MGR_INPUT_PORT_SOP].count = enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count;
-    pic_mgr_ports[PIC_MGR_INPUT_PORT_PACKETIZATION].count = EB_PacketizationProcessInitCount;
-    pic_mgr_ports[PIC_MGR_INPUT_PORT_REST].count = enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count;
-    // Rate Control
-    rate_control_ports[RATE_CONTROL_INPUT_PORT_INLME].count = EB_PictureManagerProcessInitCount;
-    rate_control_ports[RATE_CONTROL_INPUT_PORT_PACKETIZATION].count = EB_PacketizationProcessInitCount;
-    rate_control_ports[RATE_CONTROL_INPUT_PORT_ENTROPY_CODING].count = enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count;
-
-    enc_dec_ports[ENCDEC_INPUT_PORT_MDC].count = enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count;
-    enc_dec_ports[ENCDEC_INPUT_PORT_ENCDEC].count = enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count;
-    tpl_ports[TPL_INPUT_PORT_SOP].count = enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count;
-    tpl_ports[TPL_INPUT_PORT_TPL].count = enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count;
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
 
-        // Must always allocate mem b/c don't know if restoration is on or off at this point
-        // The restoration assumes only 1 tile is used, so only allocate for 1 tile... see svt_av1_alloc_restoration_struct()
-        PictureControlSet *pcs = (PictureControlSet *)enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
-        enc_handle_ptr->scs_instance_array[instance_index]->scs->rest_units_per_tile = pcs->rst_info[0/*Y-plane*/].units_per_tile;
-        enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_total_count = pcs->b64_total_count;
+        // rest_units_per_tile and b64_total_count are set by measure_pool_objects()
+        account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_OTHER, &alloc_mark);
         create_ref_buf_descs(enc_handle_ptr, instance_index);
+        account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_REFERENCE, &alloc_mark);
 
         create_tpl_ref_buf_descs(enc_handle_ptr, instance_index);
+        account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_TPL_REFERENCE, &alloc_mark);
         create_pa_ref_buf_descs(enc_handle_ptr, instance_index);
+        account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_PA_REFERENCE, &alloc_mark);
 
         if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.enable_overlays) {
             // Overlay Input Picture Buffers
@@ -1766,6 +2084,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 svt_overlay_buffer_header_creator,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs,
                 svt_input_buffer_header_destroyer);
+            account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_OVERLAY_INPUT, &alloc_mark);
             // Set the SequenceControlSet Overlay input Picture Pool Fifo Ptrs
             enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->overlay_input_picture_pool_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->overlay_input_picture_pool_ptr_array[instance_index], 0);
         }
@@ -1786,29 +2105,50 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         enc_handle_ptr->scs_instance_array[0]->scs,
         NULL);
     enc_handle_ptr->input_cmd_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_cmd_resource_ptr, 0);
+    account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_OTHER, &alloc_mark);
 
     //Picture Buffer SRM to hold (uv8b + yuv2b)
+    //the input buffers created on demand are sized from a copy of the scs, as the resolution of the scs can
+    //change on the fly
     EB_NEW(
         enc_handle_ptr->input_buffer_resource_ptr,
-        svt_system_resource_ctor,
+        svt_system_resource_lazy_ctor,
         enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count,
+        ENC_POOL_LAZY_INIT_COUNT,
         1,
         0, //1/2 SRM; no consumer FIFO
         svt_input_buffer_header_creator,
         enc_handle_ptr->scs_instance_array[0]->scs,
+        sizeof(SequenceControlSet),
         svt_input_buffer_header_destroyer);
+    account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_INPUT, &alloc_mark);
     enc_handle_ptr->input_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_buffer_resource_ptr, 0);
 
     //Picture Buffer SRM to hold y8b to be shared by Pcs->enhanced and Pa_ref
     EB_NEW(
         enc_handle_ptr->input_y8b_buffer_resource_ptr,
-        svt_system_resource_ctor,
+        svt_system_resource_lazy_ctor,
         MAX(enc_handle_ptr->scs_instance_array[0]->scs->input_buffer_fifo_init_count, enc_handle_ptr->scs_instance_array[0]->scs->pa_reference_picture_buffer_init_count),
+        ENC_POOL_LAZY_INIT_COUNT,
         1,
         0, //1/2 SRM; no consumer FIFO
         svt_input_y8b_creator,
         enc_handle_ptr->scs_instance_array[0]->scs,
+        sizeof(SequenceControlSet),
         svt_input_y8b_destroyer);
+    account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_INPUT_Y8B, &alloc_mark);
+    pic_mgr_ports[PIC_MGR_INPUT_PORT_SOP].count = enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count;
+    pic_mgr_ports[PIC_MGR_INPUT_PORT_PACKETIZATION].count = EB_PacketizationProcessInitCount;
+    pic_mgr_ports[PIC_MGR_INPUT_PORT_REST].count = enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count;
+    // Rate Control
+    rate_control_ports[RATE_CONTROL_INPUT_PORT_INLME].count = EB_PictureManagerProcessInitCount;
+    rate_control_ports[RATE_CONTROL_INPUT_PORT_PACKETIZATION].count = EB_PacketizationProcessInitCount;
+    rate_control_ports[RATE_CONTROL_INPUT_PORT_ENTROPY_CODING].count = enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count;
+
+    enc_dec_ports[ENCDEC_INPUT_PORT_MDC].count = enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count;
+    enc_dec_ports[ENCDEC_INPUT_PORT_ENCDEC].count = enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count;
+    tpl_ports[TPL_INPUT_PORT_SOP].count = enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count;
+    tpl_ports[TPL_INPUT_PORT_TPL].count = enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count;
 
 #if SRM_REPORT
     enc_handle_ptr->input_y8b_buffer_resource_ptr->empty_queue->log = 1;
@@ -1826,7 +2166,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[instance_index]->scs->total_process_init_count,//EB_PacketizationProcessInitCount,
             1,
             svt_output_buffer_header_creator,
-            &enc_handle_ptr->scs_instance_array[0]->scs->static_config,
+            &enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->out_buffer_allocator,
             svt_output_buffer_header_destroyer);
     }
     enc_handle_ptr->output_stream_buffer_consumer_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->output_stream_buffer_resource_ptr_array[0], 0);
@@ -2096,6 +2436,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     /************************************
     * Contexts
     ************************************/
+    account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_OTHER, &alloc_mark);
 
     // Resource Coordination Context
     EB_NEW(
@@ -2261,6 +2602,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         rate_control_port_lookup(RATE_CONTROL_INPUT_PORT_PACKETIZATION, 0),
         pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_PACKETIZATION, 0),
         EB_PictureDecisionProcessInitCount + EB_RateControlProcessInitCount);  // me_port_index
+    account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_CONTEXTS, &alloc_mark);
     /************************************
     * Thread Handles
     ************************************/
@@ -2272,81 +2614,102 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     // Resource Coordination
     EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
+    svt_set_thread_name(enc_handle_ptr->resource_coordination_thread_handle, "svt-rsrc-coord");
     EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
         svt_aom_picture_analysis_kernel,
         enc_handle_ptr->picture_analysis_context_ptr_array);
+    EB_NAME_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array, control_set_ptr->picture_analysis_process_init_count, "svt-pic-anal");
 
     // Picture Decision
     EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, svt_aom_picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
+    svt_set_thread_name(enc_handle_ptr->picture_decision_thread_handle, "svt-pic-dec");
 
     // Motion Estimation
     EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
         svt_aom_motion_estimation_kernel,
         enc_handle_ptr->motion_estimation_context_ptr_array);
+    EB_NAME_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count, "svt-me");
 
         // Initial Rate Control
         EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, svt_aom_initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
+        svt_set_thread_name(enc_handle_ptr->initial_rate_control_thread_handle, "svt-init-rc");
 
         // Source Based Oprations
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
             svt_aom_source_based_operations_kernel,
             enc_handle_ptr->source_based_operations_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count, "svt-src-ops");
 
         // TPL dispenser
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
             svt_aom_tpl_disp_kernel,//TODOOMK
             enc_handle_ptr->tpl_disp_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count, "svt-tpl");
         // Picture Manager
         EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, svt_aom_picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
+        svt_set_thread_name(enc_handle_ptr->picture_manager_thread_handle, "svt-pic-mgr");
         // Rate Control
         EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, svt_aom_rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
+        svt_set_thread_name(enc_handle_ptr->rate_control_thread_handle, "svt-rc");
 
         // Mode Decision Configuration Process
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
             svt_aom_mode_decision_configuration_kernel,
             enc_handle_ptr->mode_decision_configuration_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count, "svt-md-config");
 
 
         // EncDec Process
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
             svt_aom_mode_decision_kernel,
             enc_handle_ptr->enc_dec_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count, "svt-enc-dec");
 
         // Dlf Process
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
             svt_aom_dlf_kernel,
             enc_handle_ptr->dlf_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count, "svt-dlf");
 
         // Cdef Process
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
             svt_aom_cdef_kernel,
             enc_handle_ptr->cdef_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count, "svt-cdef");
 
         // Rest Process
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
             svt_aom_rest_kernel,
             enc_handle_ptr->rest_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count, "svt-rest");
 
         // Entropy Coding Process
         EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
             svt_aom_entropy_coding_kernel,
             enc_handle_ptr->entropy_coding_context_ptr_array);
+        EB_NAME_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count, "svt-entropy");
 
     // Packetization
     EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
+    svt_set_thread_name(enc_handle_ptr->packetization_thread_handle, "svt-packetize");
 
+    account_pool_memory(enc_handle_ptr, ENC_MEM_POOL_OTHER, &alloc_mark);
     svt_print_memory_usage();
 
+    if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.pipelined_two_pass)
+        return_error = first_pass_init(enc_handle_ptr);
+
     return return_error;
 }
 
 static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
-    bool eos = false;
+    EbErrorType drain_error = EB_ErrorNone;
+    bool        eos         = false;
     do {
         EbBufferHeaderType *receive_buffer = NULL;
         EbErrorType         return_error;
         switch ((return_error = svt_av1_enc_get_packet(svt_enc_component, &receive_buffer, 1))) {
-        case EB_ErrorMax: return EB_ErrorMax;
+        case EB_ErrorMax: drain_error = EB_ErrorMax; break;
         case EB_NoErrorEmptyQueue: eos = true; break;
         default: break;
         }
@@ -2356,7 +2719,7 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
             receive_buffer = NULL;
         }
     } while (!eos);
-    return EB_ErrorNone;
+    return drain_error;
 }
 
 /**********************************
@@ -2366,7 +2729,8 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
     if (!svt_enc_component || !svt_enc_component->p_component_private)
         return EB_ErrorBadParameter;
 
-    EbEncHandle *handle = svt_enc_component->p_component_private;
+    EbEncHandle *handle       = svt_enc_component->p_component_private;
+    EbErrorType  return_error = EB_ErrorNone;
 
     if (handle->input_y8b_buffer_producer_fifo_ptr && handle->frame_received) {
         if (!handle->eos_received) {
@@ -2374,12 +2738,20 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
             svt_av1_enc_send_picture(svt_enc_component, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS});
         }
 
-        EbErrorType return_error = enc_drain_queue(svt_enc_component);
-        if (return_error != EB_ErrorNone)
-            return return_error;
+        // The drain ends on the error packet of a stopped pipeline, whose processes are shut down
+        // as the others
+        return_error = enc_drain_queue(svt_enc_component);
+        // The application may have taken the error packet already
+        if (svt_aom_pipeline_stopped(handle->scs_instance_array[0]->enc_ctx))
+            return_error = EB_ErrorMax;
+        if (return_error == EB_ErrorNone)
+            svt_aom_deadline_print_stats(&handle->scs_instance_array[0]->enc_ctx->deadline_ctrl);
     }
+    if (handle->first_pass_handle)
+        first_pass_deinit(handle);
     #ifdef MINIMAL_BUILD
-    svt_aom_free(svt_aom_blk_geom_mds);
+    if (!handle->scs_instance_array[0]->scs->final_pass_scs)
+        svt_aom_free(svt_aom_blk_geom_mds);
     #endif
     svt_shutdown_process(handle->input_buffer_resource_ptr);
     svt_shutdown_process(handle->input_cmd_resource_ptr);
@@ -2399,7 +2771,7 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
     svt_shutdown_process(handle->cdef_results_resource_ptr);
     svt_shutdown_process(handle->rest_results_resource_ptr);
 
-    return EB_ErrorNone;
+    return return_error;
 }
 
 static EbErrorType init_svt_av1_encoder_handle(
@@ -3297,11 +3669,10 @@ static void derive_vq_params(SequenceControlSet* scs) {
 /*
  * Derive TF Params
  */
-static void derive_tf_params(SequenceControlSet *scs) {
+static void derive_tf_params(SequenceControlSet *scs, EncMode enc_mode) {
     const EbInputResolution resolution = scs->input_resolution;
     // Do not perform TF if LD or 1 Layer or 1st pass
     Bool do_tf = scs->static_config.enable_tf && scs->static_config.hierarchical_levels >= 1;
-    const EncMode enc_mode = scs->static_config.enc_mode;
     const uint32_t hierarchical_levels = scs->static_config.hierarchical_levels;
     uint8_t tf_level = 0;
     if (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_P || scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) {
@@ -3338,6 +3709,29 @@ static void derive_tf_params(SequenceControlSet *scs) {
      }
     tf_controls(scs, tf_level);
 }
+/*
+ * Derive the TF params of the presets the deadline mode can code a picture at
+ */
+static void derive_deadline_tf_params(SequenceControlSet *scs) {
+    const EncMode min_enc_mode = scs->static_config.enc_mode;
+    const EncMode max_enc_mode = svt_aom_deadline_fastest_enc_mode(&scs->static_config);
+    TfControls    tf_params[3];
+    memcpy(tf_params, scs->tf_params_per_type, sizeof(tf_params));
+    for (EncMode enc_mode = min_enc_mode; enc_mode <= max_enc_mode; enc_mode++) {
+        derive_tf_params(scs, enc_mode);
+        for (int type = 0; type < 3; type++) {
+            TfControls *ctrls = &scs->deadline_tf_params[enc_mode - min_enc_mode][type];
+            *ctrls            = scs->tf_params_per_type[type];
+            // The lookahead and the TF buffers are sized for the configured preset
+            ctrls->enabled &= tf_params[type].enabled;
+            ctrls->num_past_pics       = MIN(ctrls->num_past_pics, tf_params[type].num_past_pics);
+            ctrls->num_future_pics     = MIN(ctrls->num_future_pics, tf_params[type].num_future_pics);
+            ctrls->max_num_past_pics   = MIN(ctrls->max_num_past_pics, tf_params[type].max_num_past_pics);
+            ctrls->max_num_future_pics = MIN(ctrls->max_num_future_pics, tf_params[type].max_num_future_pics);
+        }
+    }
+    memcpy(scs->tf_params_per_type, tf_params, sizeof(tf_params));
+}
 
 
 /*
@@ -3779,6 +4173,10 @@ static void validate_scaling_params(SequenceControlSet *scs) {
             scs->static_config.resize_mode = RESIZE_NONE;
         }
     }
+    if (scs->static_config.deadline_fps_numerator && scs->static_config.pass != ENC_SINGLE_PASS) {
+        SVT_WARN("Deadline mode only works in single pass, it is disabled!\n");
+        scs->static_config.deadline_fps_numerator = 0;
+    }
     if (scs->static_config.superres_mode == SUPERRES_QTHRESH &&
         scs->static_config.superres_qthres == MAX_QP_VALUE &&
         scs->static_config.superres_kf_qthres == MAX_QP_VALUE) {
@@ -3882,7 +4280,9 @@ static void set_param_based_on_input(SequenceControlSet *scs)
     derive_vq_params(scs);
 
     // Set TF level
-    derive_tf_params(scs);
+    derive_tf_params(scs, scs->static_config.enc_mode);
+    if (scs->static_config.deadline_fps_numerator)
+        derive_deadline_tf_params(scs);
 
     //Future frames window in Scene Change Detection (SCD) / TemporalFiltering
     scs->scd_delay = 0;
@@ -3976,6 +4376,8 @@ static void set_param_based_on_input(SequenceControlSet *scs)
     // When switch frame is on, all renditions must have same super block size. See spec 5.5.1, 5.9.15.
     if (scs->static_config.sframe_dist != 0)
         scs->super_block_size = 64;
+    if (scs->final_pass_scs)
+        scs->super_block_size = scs->final_pass_scs->super_block_size;
     // Set config info related to SB size
     if (scs->super_block_size == 128) {
         scs->seq_header.sb_size = BLOCK_128X128;
@@ -4077,6 +4479,10 @@ static void set_param_based_on_input(SequenceControlSet *scs)
             scs->max_block_cnt = 1101;
         }
     }
+    if (scs->final_pass_scs) {
+        scs->svt_aom_geom_idx = scs->final_pass_scs->svt_aom_geom_idx;
+        scs->max_block_cnt    = scs->final_pass_scs->max_block_cnt;
+    }
     //printf("\n\nGEOM:%i \n", scs->svt_aom_geom_idx);
     // Configure the padding
     scs->left_padding = BLOCK_SIZE_64 + 4;
@@ -4233,6 +4639,15 @@ static void set_param_based_on_input(SequenceControlSet *scs)
 
     scs->max_heirachical_level = scs->static_config.hierarchical_levels;
 }
+// Fastest preset the encoder runs for the configuration, faster presets are mapped to it
+static EncMode fastest_supported_enc_mode(const SequenceControlSet *scs) {
+    EbInputResolution input_resolution;
+    svt_aom_derive_input_resolution(&input_resolution, scs->max_input_luma_width * scs->max_input_luma_height);
+    if (scs->static_config.pred_structure == SVT_AV1_PRED_RANDOM_ACCESS && input_resolution >= INPUT_SIZE_4K_RANGE)
+        return ENC_M10;
+    return ENC_M11;
+}
+
 static void copy_api_from_app(
     SequenceControlSet       *scs,
     EbSvtAv1EncConfiguration   *config_struct){
@@ -4561,6 +4976,25 @@ static void copy_api_from_app(
     scs->static_config.enable_variance_boost = config_struct->enable_variance_boost;
     scs->static_config.variance_boost_strength = config_struct->variance_boost_strength;
     scs->static_config.variance_octile = config_struct->variance_octile;
+
+    scs->static_config.max_memory_mb = config_struct->max_memory_mb;
+
+    // Deadline mode
+    scs->static_config.deadline_fps_numerator   = config_struct->deadline_fps_numerator;
+    scs->static_config.deadline_fps_denominator = config_struct->deadline_fps_denominator;
+    scs->static_config.deadline_max_preset      = config_struct->deadline_max_preset;
+    // The fastest preset is mapped like the preset, out of range values are left to svt_av1_verify_settings()
+    if (scs->static_config.deadline_max_preset <= MAX_ENC_PRESET)
+        scs->static_config.deadline_max_preset = (uint8_t)MIN(scs->static_config.deadline_max_preset,
+                                                              fastest_supported_enc_mode(scs));
+
+    scs->static_config.compressed_ten_bit_format = config_struct->compressed_ten_bit_format;
+    scs->static_config.sb_rate_control           = config_struct->sb_rate_control;
+    scs->static_config.tile_group_output         = config_struct->tile_group_output;
+    scs->static_config.pipelined_two_pass        = config_struct->pipelined_two_pass;
+    scs->static_config.resume_checkpoint         = config_struct->resume_checkpoint;
+    scs->static_config.picture_stats_cb          = config_struct->picture_stats_cb;
+    scs->static_config.picture_stats_user_data   = config_struct->picture_stats_user_data;
     return;
 }
 
@@ -4580,6 +5014,8 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
     copy_api_from_app(
         enc_handle->scs_instance_array[instance_index]->scs,
         (EbSvtAv1EncConfiguration*)config_struct);
+    svt_aom_checkpoint_set_config(&enc_handle->scs_instance_array[instance_index]->enc_ctx->checkpoint_ctrl,
+                                  config_struct);
 
     EbErrorType return_error = svt_av1_verify_settings(
         enc_handle->scs_instance_array[instance_index]->scs);
@@ -4587,6 +5023,25 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
     if (return_error == EB_ErrorBadParameter)
         return EB_ErrorBadParameter;
 
+    // The first pass encoder of the pipelined two pass codes the same input at a first pass preset
+    if (config_struct->pipelined_two_pass) {
+        EbSvtAv1EncConfiguration *fp_config = &enc_handle->first_pass_config;
+        *fp_config                          = *config_struct;
+        fp_config->pass                     = ENC_FIRST_PASS;
+        fp_config->pipelined_two_pass       = 0;
+        fp_config->recon_enabled            = FALSE;
+        fp_config->stat_report              = 0;
+        fp_config->enable_roi_map           = FALSE;
+        fp_config->deadline_fps_numerator   = 0;
+        fp_config->picture_stats_cb         = NULL;
+        // Without lookahead, the first pass codes a picture from the input of its mini-GOP, which
+        // the encoder got before the picture enters its look-ahead window
+        fp_config->look_ahead_distance = 0;
+        memset(&fp_config->rc_stats_buffer, 0, sizeof(fp_config->rc_stats_buffer));
+        memset(&fp_config->resume_checkpoint, 0, sizeof(fp_config->resume_checkpoint));
+        memset(&fp_config->frame_scale_evts, 0, sizeof(fp_config->frame_scale_evts));
+    }
+
     set_param_based_on_input(
         enc_handle->scs_instance_array[instance_index]->scs);
     // Initialize the Prediction Structure Group
@@ -4596,8 +5051,10 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
     if (!enc_handle->scs_instance_array[instance_index]->enc_ctx->prediction_structure_group_ptr) {
         return EB_ErrorInsufficientResources;
     }
+    enc_handle->scs_instance_array[instance_index]->scs->mem_budget_level = MEM_BUDGET_NONE;
     return_error = load_default_buffer_configuration_settings(
         enc_handle->scs_instance_array[instance_index]->scs);
+    print_buffer_configuration_settings(enc_handle->scs_instance_array[instance_index]->scs);
 
     svt_av1_print_lib_params(
         enc_handle->scs_instance_array[instance_index]->scs);
@@ -4829,6 +5286,36 @@ static EbErrorType downsample_copy_frame_buffer(
         uint16_t source_cr_stride = (uint16_t)(input_ptr->cr_stride);
         uint16_t source_cb_stride = (uint16_t)(input_ptr->cb_stride);
 
+        if (config->compressed_ten_bit_format) {
+            // the 8 MSBs of the split input are the samples the 16-bit path keeps
+            downsample_2d_c_skipall(input_ptr->luma,
+                                    source_luma_stride,
+                                    luma_width << 1,
+                                    luma_height << 1,
+                                    y8b_input_picture_ptr->buffer_y + luma_buffer_offset,
+                                    y8b_input_picture_ptr->stride_y,
+                                    2);
+            memset(input_pic->buffer_bit_inc_y, 0, input_pic->luma_size / 4);
+            if (pass != ENCODE_FIRST_PASS) {
+                downsample_2d_c_skipall(input_ptr->cb,
+                                        source_cb_stride,
+                                        luma_width,
+                                        luma_height,
+                                        input_pic->buffer_cb + chroma_buffer_offset,
+                                        y8b_input_picture_ptr->stride_cb,
+                                        2);
+                memset(input_pic->buffer_bit_inc_cb, 0, input_pic->chroma_size / 4);
+                downsample_2d_c_skipall(input_ptr->cr,
+                                        source_cr_stride,
+                                        luma_width,
+                                        luma_height,
+                                        input_pic->buffer_cr + chroma_buffer_offset,
+                                        y8b_input_picture_ptr->stride_cr,
+                                        2);
+                memset(input_pic->buffer_bit_inc_cr, 0, input_pic->chroma_size / 4);
+            }
+            return return_error;
+        }
         downsample_2d_c_16_zero2bit_skipall(
             (uint16_t*)(uint16_t*)(input_ptr->luma + luma_offset),
             source_luma_stride,
@@ -4868,6 +5355,27 @@ static EbErrorType downsample_copy_frame_buffer(
     }
     return return_error;
 }
+/*
+ Copy one plane of 10bit input in the compressed format: 8 MSBs, and the 2 LSBs of 4 samples per byte
+*/
+static void copy_compressed_ten_bit_plane(const uint8_t *src, uint32_t src_stride, const uint8_t *src_lsb,
+                                          uint32_t src_lsb_stride, uint8_t *dst, uint32_t dst_stride,
+                                          uint8_t *dst_lsb, uint32_t dst_lsb_stride, uint32_t width,
+                                          uint32_t height) {
+    const uint32_t lsb_width = (width + 3) >> 2;
+    // the bits past the last sample are 0, as svt_unpack_and_2bcompress leaves them
+    const uint8_t last_mask = (uint8_t)(0xFF << (2 * ((4 - (width & 3)) & 3)));
+    for (uint32_t i = 0; i < height; i++) {
+        svt_memcpy(dst, src, width);
+        svt_memcpy(dst_lsb, src_lsb, lsb_width);
+        dst_lsb[lsb_width - 1] &= last_mask;
+        src += src_stride;
+        src_lsb += src_lsb_stride;
+        dst += dst_stride;
+        dst_lsb += dst_lsb_stride;
+    }
+}
+
 /*
  Copy the input buffer
 from the sample application to the library buffers
@@ -4946,6 +5454,42 @@ static EbErrorType copy_frame_buffer(
         uint32_t comp_stride_uv = input_pic->stride_cb / 4;
         uint32_t comp_chroma_buffer_offset = comp_stride_uv * (input_pic->org_y/2) + input_pic->org_x /2 / 4;
 
+        if (config->compressed_ten_bit_format) {
+            // already in the internal layout, no unpacking
+            copy_compressed_ten_bit_plane(input_ptr->luma,
+                                          source_luma_stride,
+                                          input_ptr->luma_lsb,
+                                          input_ptr->y_lsb_stride,
+                                          y8b_input_picture_ptr->buffer_y + luma_buffer_offset,
+                                          y8b_input_picture_ptr->stride_y,
+                                          input_pic->buffer_bit_inc_y + comp_luma_buffer_offset,
+                                          comp_stride_y,
+                                          luma_width,
+                                          luma_height);
+            if (pass != ENCODE_FIRST_PASS) {
+                copy_compressed_ten_bit_plane(input_ptr->cb,
+                                              source_cb_stride,
+                                              input_ptr->cb_lsb,
+                                              input_ptr->cb_lsb_stride,
+                                              input_pic->buffer_cb + chroma_buffer_offset,
+                                              input_pic->stride_cb,
+                                              input_pic->buffer_bit_inc_cb + comp_chroma_buffer_offset,
+                                              comp_stride_uv,
+                                              luma_width / 2,
+                                              luma_height / 2);
+                copy_compressed_ten_bit_plane(input_ptr->cr,
+                                              source_cr_stride,
+                                              input_ptr->cr_lsb,
+                                              input_ptr->cr_lsb_stride,
+                                              input_pic->buffer_cr + chroma_buffer_offset,
+                                              input_pic->stride_cr,
+                                              input_pic->buffer_bit_inc_cr + comp_chroma_buffer_offset,
+                                              comp_stride_uv,
+                                              luma_width / 2,
+                                              luma_height / 2);
+            }
+            return return_error;
+        }
         svt_unpack_and_2bcompress(
             (uint16_t*)(input_ptr->luma + luma_offset),
             source_luma_stride,
@@ -5328,6 +5872,13 @@ static EbErrorType validate_on_the_fly_settings(EbBufferHeaderType *input_ptr, S
     }
     return EB_ErrorNone;
 }
+/* No input buffer could be taken: the stream ends with an error packet, unless it already did */
+static EbErrorType input_buffer_error(EbEncHandle *enc_handle_ptr, EbErrorType get_error) {
+    if (get_error != EB_NoErrorFifoShutdown)
+        svt_aom_post_error_packet(enc_handle_ptr->scs_instance_array[0]->enc_ctx);
+    return EB_ErrorInsufficientResources;
+}
+
 /**********************************
 * Empty This Buffer
 **********************************/
@@ -5341,6 +5892,15 @@ EB_API EbErrorType svt_av1_enc_send_picture(
     EbBufferHeaderType   *app_hdr = p_buffer;
     enc_handle_ptr->frame_received = true;
 
+    // Pipelined two pass: the first pass codes the same input
+    if (enc_handle_ptr->first_pass_handle) {
+        svt_av1_enc_send_picture(enc_handle_ptr->first_pass_handle, p_buffer);
+        if (!enc_handle_ptr->first_pass_thread_handle) {
+            EB_CREATE_THREAD(enc_handle_ptr->first_pass_thread_handle, first_pass_drain_kernel, enc_handle_ptr);
+            svt_set_thread_name(enc_handle_ptr->first_pass_thread_handle, "svt-first-pass");
+        }
+    }
+
     // Exit the library if we detect an invalid API input buffer @ the previous library call
     if (enc_handle_ptr->is_prev_valid == false) {
         p_buffer->flags = EB_BUFFERFLAG_EOS;
@@ -5352,9 +5912,11 @@ EB_API EbErrorType svt_av1_enc_send_picture(
 
     // Get new Luma-8b buffer & a new (Chroma-8b + Luma-Chroma-2bit) buffers; Lib will release once done.
     EbObjectWrapper  *y8b_wrapper;
-    svt_get_empty_object(
+    EbErrorType get_error = svt_get_empty_object(
         enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr,
         &y8b_wrapper);
+    if (get_error != EB_ErrorNone)
+        return input_buffer_error(enc_handle_ptr, get_error);
     // Update the input picture definitions: resolution of the sequence
     if(validate_on_the_fly_settings(p_buffer, enc_handle_ptr->scs_instance_array[0]->scs, enc_handle_ptr->scs_instance_array[0]->config_mutex)){
         return_val = EB_ErrorBadParameter;
@@ -5368,9 +5930,13 @@ EB_API EbErrorType svt_av1_enc_send_picture(
 
    // svt_object_inc_live_count(y8b_wrapper, 1);
 
-    svt_get_empty_object(
+    get_error = svt_get_empty_object(
         enc_handle_ptr->input_buffer_producer_fifo_ptr,
         &eb_wrapper_ptr);
+    if (get_error != EB_ErrorNone) {
+        svt_release_object(y8b_wrapper);
+        return input_buffer_error(enc_handle_ptr, get_error);
+    }
     // if resolution has changed, and the input_buffer settings do not match scs settings, update input_buffer settings
     if (buffer_update_needed((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs))
         svt_input_buffer_header_update((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs, TRUE);
@@ -5393,6 +5959,9 @@ EB_API EbErrorType svt_av1_enc_send_picture(
         Bool is_16bit_input = (Bool)(config->encoder_bit_depth > EB_EIGHT_BIT);
         size_t read_size = (size_t)SIZE_OF_ONE_FRAME_IN_BYTES(
             input_pic->width - scs->max_input_pad_right, input_pic->height - scs->max_input_pad_bottom, config->encoder_color_format, is_16bit_input);
+        // the compressed 10bit format takes a byte for the MSBs and a quarter of a byte for the LSBs of a sample
+        if (config->compressed_ten_bit_format)
+            read_size = read_size / 2 * 5 / 4;
         if (app_hdr->p_buffer != NULL && read_size > app_hdr->n_filled_len) {
 
             // memset the library input buffer(s) if the API input buffer is not large enough
@@ -5418,9 +5987,14 @@ EB_API EbErrorType svt_av1_enc_send_picture(
 
     //Take a new App-RessCoord command
     EbObjectWrapper *input_cmd_wrp;
-    svt_get_empty_object(
+    get_error = svt_get_empty_object(
         enc_handle_ptr->input_cmd_producer_fifo_ptr,
         &input_cmd_wrp);
+    if (get_error != EB_ErrorNone) {
+        svt_release_object(eb_wrapper_ptr);
+        svt_release_object(y8b_wrapper);
+        return input_buffer_error(enc_handle_ptr, get_error);
+    }
     InputCommand *input_cmd_obj = (InputCommand*)input_cmd_wrp->object_ptr;
     //Fill the command with two picture buffers
     input_cmd_obj->eb_input_wrapper_ptr = eb_wrapper_ptr;
@@ -5492,7 +6066,7 @@ EB_API EbErrorType svt_av1_enc_get_packet(
 
     if (eb_wrapper_ptr) {
         packet = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
-        if ( packet->flags & 0xfffffff0 )
+        if ( packet->flags & EB_BUFFERFLAG_ERROR_MASK )
             return_error = EB_ErrorMax;
         // return the output stream buffer
         *p_buffer = packet;
@@ -5500,6 +6074,9 @@ EB_API EbErrorType svt_av1_enc_get_packet(
         // check if we have reached the end of the output stream
         enc_handle->eos_sent += packet->flags & EB_BUFFERFLAG_EOS;
 
+        svt_aom_checkpoint_packet(
+            &enc_handle->scs_instance_array[0]->enc_ctx->checkpoint_ctrl, packet, cfg->tile_group_output);
+
         // save the wrapper pointer for the release
         (*p_buffer)->wrapper_ptr = (void*)eb_wrapper_ptr;
     }
@@ -5513,14 +6090,39 @@ EB_API void svt_av1_enc_release_out_buffer(
 {
     if (p_buffer && (*p_buffer)->wrapper_ptr)
     {
-        if((*p_buffer)->p_buffer)
-           EB_FREE((*p_buffer)->p_buffer);
+        // Return the packet buffer to its allocator
+        svt_aom_out_buffer_free(((EbOutputBufferHeader*)*p_buffer)->allocator, &(*p_buffer)->p_buffer);
         // Release out put buffer back into the pool
         svt_release_object((EbObjectWrapper  *)(*p_buffer)->wrapper_ptr);
      }
     return;
 }
 
+/**********************************
+* Set the output buffer allocator
+**********************************/
+EB_API EbErrorType svt_av1_enc_set_output_buffer_allocator(
+    EbComponentType                   *svt_enc_component,
+    const SvtAv1OutputBufferAllocator *allocator)
+{
+    if (!svt_enc_component || !svt_enc_component->p_component_private)
+        return EB_ErrorBadParameter;
+    if (allocator && (!allocator->alloc || !allocator->release))
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    // The output buffer headers keep a pointer to the allocator from svt_av1_enc_init on
+    if (enc_handle->output_stream_buffer_resource_ptr_array) {
+        SVT_ERROR("The output buffer allocator must be set before svt_av1_enc_init\n");
+        return EB_ErrorBadParameter;
+    }
+    EncodeContext *enc_ctx = enc_handle->scs_instance_array[0]->enc_ctx;
+    if (allocator)
+        enc_ctx->out_buffer_allocator = *allocator;
+    else
+        memset(&enc_ctx->out_buffer_allocator, 0, sizeof(enc_ctx->out_buffer_allocator));
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Fill This Buffer
 **********************************/
@@ -5572,9 +6174,10 @@ static void lib_svt_encoder_send_error_exit(
     EbObjectWrapper      *eb_wrapper_ptr = NULL;
     EbBufferHeaderType    *output_packet;
 
-    svt_get_empty_object(
+    if (svt_get_empty_object(
         enc_handle->output_stream_buffer_consumer_fifo_ptr,
-        &eb_wrapper_ptr);
+        &eb_wrapper_ptr) != EB_ErrorNone)
+        return;
 
     output_packet            = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
 
@@ -5585,6 +6188,66 @@ static void lib_svt_encoder_send_error_exit(
     svt_post_full_object(eb_wrapper_ptr);
 }
 
+/**********************************
+* Encoder Pipeline Stop
+**********************************/
+// Once a process stopped on an error, the processes waiting for an empty object are woken through
+// the quit signal of the producers, and the ones waiting for the pictures the stopped processes will
+// not complete see the pipeline stopped. svt_av1_enc_deinit() then shuts down the consumers, and the
+// threads are joined as usual
+static void lib_svt_encoder_stop_pipeline(
+    EbPtr                    hComponent)
+{
+    EbComponentType      *svt_enc_component = (EbComponentType*)hComponent;
+    EbEncHandle          *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    SequenceControlSet   *scs = enc_handle->scs_instance_array[0]->scs;
+    EncodeContext        *enc_ctx = enc_handle->scs_instance_array[0]->enc_ctx;
+    EbSystemResource     *resources[ENC_MEM_POOL_COUNT];
+
+    get_pool_resources(enc_handle, resources);
+    for (int i = 0; i < ENC_MEM_POOL_COUNT; i++)
+        svt_shutdown_producers(resources[i]);
+    svt_shutdown_producers(enc_handle->scs_pool_ptr_array[0]);
+    svt_shutdown_producers(enc_handle->input_cmd_resource_ptr);
+    svt_shutdown_producers(enc_handle->output_stream_buffer_resource_ptr_array[0]);
+    if (enc_handle->output_recon_buffer_resource_ptr_array)
+        svt_shutdown_producers(enc_handle->output_recon_buffer_resource_ptr_array[0]);
+    svt_shutdown_producers(enc_handle->resource_coordination_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->picture_analysis_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->picture_decision_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->motion_estimation_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->initial_rate_control_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->picture_demux_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->tpl_disp_res_srm);
+    svt_shutdown_producers(enc_handle->rate_control_tasks_resource_ptr);
+    svt_shutdown_producers(enc_handle->rate_control_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->enc_dec_tasks_resource_ptr);
+    svt_shutdown_producers(enc_handle->enc_dec_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->entropy_coding_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->dlf_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->cdef_results_resource_ptr);
+    svt_shutdown_producers(enc_handle->rest_results_resource_ptr);
+
+    // The waits for the segments of a picture, and for the pictures of the other processes, check
+    // the pipeline stopped once woken
+    svt_post_semaphore(scs->ref_buffer_available_semaphore);
+    if (enc_ctx->first_pass_semaphore)
+        svt_post_semaphore(enc_ctx->first_pass_semaphore);
+    EbSystemResource *ppcs_pool = resources[ENC_MEM_POOL_PARENT_PCS];
+    svt_block_on_mutex(ppcs_pool->empty_queue->lockout_mutex);
+    for (uint32_t i = 0; i < ppcs_pool->object_total_count; i++) {
+        if (!ppcs_pool->wrapper_ptr_pool[i])
+            continue;
+        PictureParentControlSet *ppcs = (PictureParentControlSet *)ppcs_pool->wrapper_ptr_pool[i]->object_ptr;
+        svt_post_semaphore(ppcs->temp_filt_done_semaphore);
+        svt_post_semaphore(ppcs->tpl_disp_done_semaphore);
+        if (ppcs->dg_detector)
+            svt_post_semaphore(ppcs->dg_detector->frame_done_sem);
+        svt_set_cond_var(&ppcs->me_ready, 1);
+    }
+    svt_release_mutex(ppcs_pool->empty_queue->lockout_mutex);
+}
+
 EB_API const char *svt_av1_get_version(void) {
     return SVT_AV1_CVS_VERSION;
 }
@@ -5861,11 +6524,12 @@ EbErrorType svt_output_buffer_header_creator(
     EbPtr *object_dbl_ptr,
     EbPtr object_init_data_ptr)
 {
-    (void)object_init_data_ptr;
-    EbBufferHeaderType* out_buf_ptr;
+    EbOutputBufferHeader* out_hdr_ptr;
 
     *object_dbl_ptr = NULL;
-    EB_CALLOC(out_buf_ptr, 1, sizeof(EbBufferHeaderType));
+    EB_CALLOC(out_hdr_ptr, 1, sizeof(EbOutputBufferHeader));
+    out_hdr_ptr->allocator = (const SvtAv1OutputBufferAllocator*)object_init_data_ptr;
+    EbBufferHeaderType* out_buf_ptr = &out_hdr_ptr->header;
     *object_dbl_ptr = (EbPtr)out_buf_ptr;
 
     // Initialize Header
@@ -5923,6 +6587,42 @@ void svt_output_recon_buffer_header_destroyer(    EbPtr p)
     EB_FREE(obj);
 }
 
+/* Objects created in a pool, how many are currently held by the pipeline (i.e. not in its empty queue), and
+ * the memory of the objects created after svt_av1_enc_init() */
+static void get_pool_usage(EbSystemResource *resource, SvtAv1MemoryPoolUsage *pool) {
+    if (!resource)
+        return;
+    EbMuxingQueue *empty_queue = resource->empty_queue;
+    svt_block_on_mutex(empty_queue->lockout_mutex);
+    pool->total_count  = resource->object_created_count;
+    pool->in_use_count = resource->object_created_count - empty_queue->object_queue->current_count;
+    pool->bytes += resource->grown_bytes;
+    svt_release_mutex(empty_queue->lockout_mutex);
+}
+
+static void get_memory_usage(EbEncHandle *enc_handle, SvtAv1MemoryUsage *usage) {
+    static const char *const pool_names[ENC_MEM_POOL_COUNT] = {
+        "parent_pcs", "me", "child_pcs", "enc_dec", "reference", "tpl_reference",
+        "pa_reference", "overlay_input", "input", "input_y8b", "contexts", "other"};
+    SequenceControlSet *scs = enc_handle->scs_instance_array[0]->scs;
+    EbSystemResource   *resources[ENC_MEM_POOL_COUNT];
+
+    get_pool_resources(enc_handle, resources);
+
+    memset(usage, 0, sizeof(*usage));
+    usage->budget_bytes    = (uint64_t)scs->static_config.max_memory_mb << 20;
+    usage->estimated_bytes = scs->estimated_memory_bytes;
+    usage->pool_count      = ENC_MEM_POOL_COUNT;
+    for (int i = 0; i < ENC_MEM_POOL_COUNT; i++) {
+        SvtAv1MemoryPoolUsage *pool = &usage->pools[i];
+        pool->name                  = pool_names[i];
+        pool->bytes                 = enc_handle->pool_bytes[i];
+        get_pool_usage(resources[i], pool);
+        usage->total_bytes += pool->bytes;
+    }
+    usage->pools[ENC_MEM_POOL_CONTEXTS].total_count = scs->total_process_init_count;
+}
+
 /**********************************
 * svt_av1_enc_get_stream_info get stream information from encoder
 **********************************/
@@ -5940,6 +6640,19 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_MEMORY_USAGE) {
+        get_memory_usage(enc_handle, (SvtAv1MemoryUsage*)info);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_DEADLINE_STATS) {
+        svt_aom_deadline_get_stats(&enc_handle->scs_instance_array[0]->enc_ctx->deadline_ctrl,
+                                   (SvtAv1DeadlineStats*)info);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_CHECKPOINT) {
+        return svt_aom_checkpoint_get(&enc_handle->scs_instance_array[0]->enc_ctx->checkpoint_ctrl,
+                                      (SvtAv1Checkpoint*)info);
+    }
     return EB_ErrorBadParameter;
 }
 // clang-format on
@@ -24,6 +24,26 @@ struct _EbThreadContext {
     EbPtr   priv;
 };
 
+/**************************************
+ * Memory accounting groups, reported through
+ * SVT_AV1_STREAM_INFO_MEMORY_USAGE
+ **************************************/
+typedef enum EncMemoryPool {
+    ENC_MEM_POOL_PARENT_PCS,
+    ENC_MEM_POOL_ME,
+    ENC_MEM_POOL_CHILD_PCS,
+    ENC_MEM_POOL_ENC_DEC,
+    ENC_MEM_POOL_REFERENCE,
+    ENC_MEM_POOL_TPL_REFERENCE,
+    ENC_MEM_POOL_PA_REFERENCE,
+    ENC_MEM_POOL_OVERLAY_INPUT,
+    ENC_MEM_POOL_INPUT,
+    ENC_MEM_POOL_INPUT_Y8B,
+    ENC_MEM_POOL_CONTEXTS,
+    ENC_MEM_POOL_OTHER,
+    ENC_MEM_POOL_COUNT
+} EncMemoryPool;
+
 /**************************************
  * Component Private Data
  **************************************/
@@ -130,6 +150,18 @@ struct _EbEncHandle {
     bool eos_sent; // used to signal we sent the EOS to the app
     bool frame_received; // used to signal we received any frame from the app
     bool is_prev_valid; // whether the previous input is valid or not
+    bool blk_geom_in_use; // whether the encoder holds the block geometry table of the process
+
+    // Bytes allocated by svt_av1_enc_init() for each EncMemoryPool
+    uint64_t pool_bytes[ENC_MEM_POOL_COUNT];
+    // Bytes allocated by one object of each EncMemoryPool, measured before the pools are constructed
+    uint64_t object_bytes[ENC_MEM_POOL_COUNT];
+
+    // Pipelined two pass: first pass encoder fed with the same input, and the thread that drains its
+    // packets
+    EbSvtAv1EncConfiguration first_pass_config;
+    EbComponentType         *first_pass_handle;
+    EbHandle                 first_pass_thread_handle;
 };
 void set_segments_numbers(SequenceControlSet *scs);
 #endif // EbEncHandle_h
@@ -22,6 +22,7 @@
 #include "EbSvtAv1Enc.h"
 #include "EbSvtAv1Metadata.h"
 #include "enc_settings.h"
+#include "checkpoint.h"
 
 #include "svt_log.h"
 
@@ -854,6 +855,64 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->deadline_fps_numerator && !config->deadline_fps_denominator) {
+        SVT_ERROR("Instance %u: The deadline_fps_denominator must be greater than 0\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->deadline_fps_numerator &&
+        (config->deadline_max_preset > MAX_ENC_PRESET || (int8_t)config->deadline_max_preset < config->enc_mode)) {
+        SVT_ERROR("Instance %u: Deadline max preset must be in the range of [preset-%d]\n",
+                  channel_number + 1,
+                  MAX_ENC_PRESET);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->sb_rate_control && config->rate_control_mode != SVT_AV1_RC_MODE_CBR) {
+        SVT_ERROR("Instance %u: The superblock rate control is only available with CBR\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->tile_group_output && config->pred_structure == SVT_AV1_PRED_RANDOM_ACCESS) {
+        SVT_ERROR("Instance %u: The tile group output is only available with the low-delay prediction structures\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->tile_group_output && config->superres_mode == SUPERRES_AUTO) {
+        SVT_ERROR("Instance %u: The tile group output is not available with the superres auto mode\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->pipelined_two_pass &&
+        (config->rate_control_mode != SVT_AV1_RC_MODE_VBR || config->pass != ENC_SINGLE_PASS)) {
+        SVT_ERROR("Instance %u: The pipelined two pass is only available with VBR in single pass\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->resume_checkpoint.buf) {
+        if (config->intra_refresh_type != SVT_AV1_KF_REFRESH || config->pass == ENC_FIRST_PASS ||
+            config->pipelined_two_pass || config->max_bit_rate) {
+            SVT_ERROR(
+                "Instance %u: Resuming from a checkpoint is only available with closed GOP key frames, without "
+                "max_bit_rate, pipelined_two_pass or the first pass\n",
+                channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        } else if (svt_aom_checkpoint_check(&scs->enc_ctx->checkpoint_ctrl, &config->resume_checkpoint) !=
+                   EB_ErrorNone) {
+            SVT_ERROR("Instance %u: The checkpoint does not match the encoder configuration\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+    if (config->compressed_ten_bit_format && config->encoder_bit_depth != 10) {
+        SVT_ERROR("Instance %u: The compressed 10bit input format is only available with a 10bit encoder bit depth\n",
+                  channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     return return_error;
 }
 
@@ -1003,6 +1062,18 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->enable_variance_boost             = FALSE;
     config_ptr->variance_boost_strength           = 2;
     config_ptr->variance_octile                   = 6;
+    config_ptr->max_memory_mb                     = 0;
+    config_ptr->deadline_fps_numerator            = 0;
+    config_ptr->deadline_fps_denominator          = 1;
+    config_ptr->deadline_max_preset               = MAX_ENC_PRESET;
+    config_ptr->compressed_ten_bit_format         = 0;
+    config_ptr->sb_rate_control                   = 0;
+    config_ptr->tile_group_output                 = 0;
+    config_ptr->pipelined_two_pass                = 0;
+    config_ptr->resume_checkpoint.buf             = NULL;
+    config_ptr->resume_checkpoint.sz              = 0;
+    config_ptr->picture_stats_cb                  = NULL;
+    config_ptr->picture_stats_user_data           = NULL;
     return return_error;
 }
 
@@ -1118,6 +1189,13 @@ void svt_av1_print_lib_params(SequenceControlSet *scs) {
                      config->film_grain_denoise_apply,
                      config->film_grain_denoise_strength);
         }
+
+        if (config->deadline_fps_numerator != 0) {
+            SVT_INFO("SVT [config]: deadline fps / preset range \t\t\t\t\t: %.2f / %d-%d\n",
+                     (double)config->deadline_fps_numerator / config->deadline_fps_denominator,
+                     config->enc_mode,
+                     config->deadline_max_preset);
+        }
     }
 #ifdef DEBUG_BUFFERS
     SVT_INFO("SVT [config]: INPUT / OUTPUT \t\t\t\t\t\t: %d / %d\n",
@@ -1431,6 +1509,33 @@ static EbErrorType str_to_bitrate(const char *nptr, uint32_t *out) {
     return EB_ErrorNone;
 }
 
+// Frame rate as an integer (30), a decimal (29.97) or a fraction (30000/1001)
+static EbErrorType str_to_fps(const char *nptr, uint32_t *numerator, uint32_t *denominator) {
+    char        *suff;
+    const double fps = strtod(nptr, &suff);
+
+    if (suff == nptr || fps < 0 || fps > UINT32_MAX) {
+        SVT_ERROR("Invalid frame rate value: %s\n", nptr);
+        return EB_ErrorBadParameter;
+    }
+    if (*suff == '/') {
+        uint32_t den;
+        if (fps != (uint32_t)fps || str_to_uint(suff + 1, &den, NULL) != EB_ErrorNone || !den) {
+            SVT_ERROR("Invalid frame rate value: %s\n", nptr);
+            return EB_ErrorBadParameter;
+        }
+        *numerator   = (uint32_t)fps;
+        *denominator = den;
+        return EB_ErrorNone;
+    }
+    if (*suff)
+        return EB_ErrorBadParameter;
+    // keep 3 decimals
+    *denominator = fps == (uint32_t)fps || fps * 1000 > UINT32_MAX ? 1 : 1000;
+    *numerator   = (uint32_t)(fps * *denominator + 0.5);
+    return EB_ErrorNone;
+}
+
 static EbErrorType str_to_profile(const char *nptr, EbAv1SeqProfile *out) {
     const struct {
         const char     *name;
@@ -1882,6 +1987,9 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
     if (!strcmp(name, "lambda-scale-factors"))
         return parse_list_s32(value, config_struct->lambda_scale_factors, SVT_AV1_FRAME_UPDATE_TYPES);
 
+    if (!strcmp(name, "deadline-fps"))
+        return str_to_fps(value, &config_struct->deadline_fps_numerator, &config_struct->deadline_fps_denominator);
+
     if (!strcmp(name, "frame-resz-events"))
         return str_to_frm_resz_evts(value, &config_struct->frame_scale_evts);
 
@@ -1928,6 +2036,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"input-depth", &config_struct->encoder_bit_depth},
         {"forced-max-frame-width", &config_struct->forced_max_frame_width},
         {"forced-max-frame-height", &config_struct->forced_max_frame_height},
+        {"max-memory", &config_struct->max_memory_mb},
     };
     const size_t uint_opts_size = sizeof(uint_opts) / sizeof(uint_opts[0]);
 
@@ -1963,6 +2072,10 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"variance-boost-strength", &config_struct->variance_boost_strength},
         {"variance-octile", &config_struct->variance_octile},
         {"fast-decode", &config_struct->fast_decode},
+        {"deadline-max-preset", &config_struct->deadline_max_preset},
+        {"sb-rate-control", &config_struct->sb_rate_control},
+        {"tile-group-output", &config_struct->tile_group_output},
+        {"pipelined-two-pass", &config_struct->pipelined_two_pass},
     };
     const size_t uint8_opts_size = sizeof(uint8_opts) / sizeof(uint8_opts[0]);
 
@@ -0,0 +1,131 @@
+/*
+ * Copyright(c) 2024 Alliance for Open Media
+ *
+ * This source code is subject to the terms of the BSD 3-Clause Clear License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 3-Clause Clear License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file DeadlineCtrlTest.cc
+ *
+ * @brief Unit test of the wall-clock deadline mode:
+ * - svt_aom_deadline_fastest_enc_mode
+ * - svt_aom_deadline_pic_enc_mode
+ * - svt_aom_deadline_picture_done
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "deadline_ctrl.h"
+#include "svt_threads.h"
+
+namespace {
+
+class DeadlineCtrlTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        memset(&cfg_, 0, sizeof(cfg_));
+        cfg_.enc_mode = ENC_M4;
+        cfg_.deadline_fps_numerator = 30000;
+        cfg_.deadline_fps_denominator = 1001;
+        cfg_.deadline_max_preset = ENC_M10;
+        memset(&ctrl_, 0, sizeof(ctrl_));
+        ctrl_.mutex = svt_create_mutex();
+        svt_aom_deadline_ctrl_init(&ctrl_, &cfg_, 4);
+    }
+
+    void TearDown() override {
+        svt_destroy_mutex(ctrl_.mutex);
+    }
+
+    EbSvtAv1EncConfiguration cfg_;
+    DeadlineCtrl ctrl_;
+};
+
+TEST_F(DeadlineCtrlTest, Init) {
+    EXPECT_TRUE(ctrl_.enabled);
+    EXPECT_NE(ctrl_.mutex, nullptr);
+    EXPECT_NEAR(ctrl_.target_fps, 29.97, 0.01);
+    EXPECT_EQ(ctrl_.min_enc_mode, ENC_M4);
+    EXPECT_EQ(ctrl_.max_enc_mode, ENC_M10);
+
+    cfg_.deadline_fps_numerator = 0;
+    svt_aom_deadline_ctrl_init(&ctrl_, &cfg_, 4);
+    EXPECT_FALSE(ctrl_.enabled);
+}
+
+TEST_F(DeadlineCtrlTest, FastestEncMode) {
+    EXPECT_EQ(svt_aom_deadline_fastest_enc_mode(&cfg_), ENC_M10);
+    // never slower than the configured preset
+    cfg_.deadline_max_preset = ENC_M2;
+    EXPECT_EQ(svt_aom_deadline_fastest_enc_mode(&cfg_), ENC_M4);
+    // off
+    cfg_.deadline_max_preset = ENC_M10;
+    cfg_.deadline_fps_numerator = 0;
+    EXPECT_EQ(svt_aom_deadline_fastest_enc_mode(&cfg_), ENC_M4);
+}
+
+TEST_F(DeadlineCtrlTest, PicEncModeWholePresets) {
+    const uint8_t hierarchical_levels = 4;
+    for (int32_t presets = 0; presets <= 8; presets++) {
+        ctrl_.speed = presets * DEADLINE_SPEED_ONE;
+        for (uint8_t layer = 0; layer <= hierarchical_levels; layer++)
+            EXPECT_EQ(svt_aom_deadline_pic_enc_mode(&ctrl_, layer, hierarchical_levels),
+                      std::min(ENC_M4 + presets, (int32_t)ENC_M10));
+    }
+}
+
+TEST_F(DeadlineCtrlTest, PicEncModeFractionToTopLayers) {
+    const uint8_t hierarchical_levels = 4;
+    // 1/2 preset: the top layer, half of the pictures, is coded one preset faster
+    ctrl_.speed = DEADLINE_SPEED_ONE + DEADLINE_SPEED_ONE / 2;
+    for (uint8_t layer = 0; layer <= hierarchical_levels; layer++)
+        EXPECT_EQ(svt_aom_deadline_pic_enc_mode(&ctrl_, layer, hierarchical_levels),
+                  layer == hierarchical_levels ? ENC_M6 : ENC_M5);
+    // 3/4 preset: the two top layers
+    ctrl_.speed = 3 * DEADLINE_SPEED_ONE / 4;
+    for (uint8_t layer = 0; layer <= hierarchical_levels; layer++)
+        EXPECT_EQ(svt_aom_deadline_pic_enc_mode(&ctrl_, layer, hierarchical_levels),
+                  layer + 1 >= hierarchical_levels ? ENC_M5 : ENC_M4);
+    // a small fraction is rounded down
+    ctrl_.speed = DEADLINE_SPEED_ONE / 8;
+    for (uint8_t layer = 0; layer <= hierarchical_levels; layer++)
+        EXPECT_EQ(svt_aom_deadline_pic_enc_mode(&ctrl_, layer, hierarchical_levels), ENC_M4);
+}
+
+TEST_F(DeadlineCtrlTest, PictureDoneStats) {
+    uint64_t stage_time_us[SVT_AV1_DEADLINE_STAGES + 1];
+    for (int s = 0; s <= SVT_AV1_DEADLINE_STAGES; s++)
+        stage_time_us[s] = 1000 * (s + 1);
+    svt_aom_deadline_picture_done(&ctrl_, 0, ENC_M4, FALSE, stage_time_us);
+    svt_aom_deadline_picture_done(&ctrl_, 0, ENC_M6, FALSE, stage_time_us);
+    // overlays are not counted
+    svt_aom_deadline_picture_done(&ctrl_, 0, ENC_M6, TRUE, stage_time_us);
+    // the window is opened by the first picture of the current epoch
+    EXPECT_TRUE(ctrl_.window_open);
+    EXPECT_EQ(ctrl_.window_frames, 1u);
+
+    SvtAv1DeadlineStats stats;
+    svt_aom_deadline_get_stats(&ctrl_, &stats);
+    EXPECT_EQ(stats.frame_count, 2u);
+    EXPECT_DOUBLE_EQ(stats.average_preset, 5.0);
+    EXPECT_EQ(stats.preset_frame_count[ENC_M4 + 1], 1u);
+    EXPECT_EQ(stats.preset_frame_count[ENC_M6 + 1], 1u);
+    for (int s = 0; s < SVT_AV1_DEADLINE_STAGES; s++)
+        EXPECT_DOUBLE_EQ(stats.stage_ms[s], 1.0);
+}
+
+TEST_F(DeadlineCtrlTest, SpeedKeptWithoutWindow) {
+    ctrl_.speed = DEADLINE_SPEED_ONE;
+    svt_aom_deadline_update_speed(&ctrl_, 16);
+    EXPECT_EQ(ctrl_.speed, DEADLINE_SPEED_ONE);
+    EXPECT_EQ(ctrl_.epoch, 0u);
+}
+
+}  // namespace
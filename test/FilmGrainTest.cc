@@ -263,6 +263,330 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+typedef void (*FgnLumaNoiseFunc)(uint8_t *luma, int32_t luma_stride,
+                                 const int32_t *grain, int32_t grain_stride,
+                                 int32_t width, int32_t height,
+                                 const FgnScaling *scaling);
+typedef void (*FgnLumaNoiseHbdFunc)(uint16_t *luma, int32_t luma_stride,
+                                    const int32_t *grain, int32_t grain_stride,
+                                    int32_t width, int32_t height,
+                                    const FgnScaling *scaling);
+typedef void (*FgnChromaNoiseFunc)(uint8_t *chroma, int32_t chroma_stride,
+                                   const uint8_t *luma, int32_t luma_stride,
+                                   const int32_t *grain, int32_t grain_stride,
+                                   int32_t width, int32_t height,
+                                   int32_t chroma_subsamp_x,
+                                   int32_t chroma_subsamp_y,
+                                   const FgnScaling *scaling);
+typedef void (*FgnChromaNoiseHbdFunc)(
+    uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+    int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+    int32_t width, int32_t height, int32_t chroma_subsamp_x,
+    int32_t chroma_subsamp_y, const FgnScaling *scaling);
+typedef void (*FgnHorOverlapFunc)(const int32_t *top_block, int32_t top_stride,
+                                  const int32_t *bottom_block,
+                                  int32_t bottom_stride, int32_t *dst_block,
+                                  int32_t dst_stride, int32_t width,
+                                  int32_t height, int32_t grain_min,
+                                  int32_t grain_max);
+
+/**
+ * @brief Unit test of the grain application kernels: the luma and chroma
+ * noise of 8-bit and high bit depth samples and the horizontal blending of
+ * the grain blocks. The SIMD output must match the C output for random
+ * samples, grain, scaling luts and block sizes, including widths that are
+ * not a multiple of the vector size.
+ */
+template <typename Sample, typename LumaFunc, typename ChromaFunc>
+class FgnAddNoiseTest
+    : public ::testing::TestWithParam<std::tuple<LumaFunc, ChromaFunc, int>> {
+  public:
+    static const int kStride = 160;
+    static const int kMaxHeight = 64;
+    static const int kSize = kStride * kMaxHeight;
+
+    FgnAddNoiseTest()
+        : tst_luma_(std::get<0>(this->GetParam())),
+          tst_chroma_(std::get<1>(this->GetParam())),
+          bd_(std::get<2>(this->GetParam())) {
+    }
+
+    void run_test() {
+        const int grain_min = -(128 << (bd_ - 8));
+        const int grain_max = (128 << (bd_ - 8)) - 1;
+        for (int iter = 0; iter < 1000 && !::testing::Test::HasFailure();
+             iter++) {
+            for (int i = 0; i < 256; i++) lut_[i] = rnd_.Rand8();
+            FgnScaling scaling;
+            scaling.scaling_lut = lut_;
+            scaling.scaling_shift = 8 + rnd_.PseudoUniform(4);
+            scaling.bit_depth = bd_;
+            scaling.min_value = rnd_.PseudoUniform(2) ? 16 << (bd_ - 8) : 0;
+            scaling.max_value = rnd_.PseudoUniform(2)
+                                    ? 235 << (bd_ - 8)
+                                    : (256 << (bd_ - 8)) - 1;
+            scaling.luma_mult = rnd_.PseudoUniform(256) - 128;
+            scaling.mult = rnd_.PseudoUniform(256) - 128;
+            scaling.offset = rnd_.PseudoUniform(512 << (bd_ - 8)) -
+                             (256 << (bd_ - 8));
+            for (int i = 0; i < kSize; i++) {
+                luma_ref_[i] = luma_tst_[i] = rnd_.Rand16() & ((1 << bd_) - 1);
+                chroma_ref_[i] = chroma_tst_[i] =
+                    rnd_.Rand16() & ((1 << bd_) - 1);
+                grain_[i] = grain_min +
+                            rnd_.PseudoUniform(grain_max - grain_min + 1);
+            }
+            const int width = 1 + rnd_.PseudoUniform(70);
+            const int height = 1 + rnd_.PseudoUniform(32);
+            const int ss_x = rnd_.PseudoUniform(2);
+            const int ss_y = rnd_.PseudoUniform(2);
+
+            // chroma first, like the encoder, with the luma before grain
+            run_ref_chroma(chroma_ref_,
+                           kStride - 7,
+                           luma_ref_ + 3,
+                           kStride,
+                           grain_,
+                           kStride - 3,
+                           width,
+                           height,
+                           ss_x,
+                           ss_y,
+                           &scaling);
+            tst_chroma_(chroma_tst_,
+                        kStride - 7,
+                        luma_tst_ + 3,
+                        kStride,
+                        grain_,
+                        kStride - 3,
+                        width,
+                        height,
+                        ss_x,
+                        ss_y,
+                        &scaling);
+            run_ref_luma(luma_ref_ + 1,
+                         kStride,
+                         grain_ + 5,
+                         kStride - 3,
+                         width,
+                         height,
+                         &scaling);
+            tst_luma_(luma_tst_ + 1,
+                      kStride,
+                      grain_ + 5,
+                      kStride - 3,
+                      width,
+                      height,
+                      &scaling);
+            ASSERT_EQ(0, memcmp(luma_ref_, luma_tst_, sizeof(luma_ref_)))
+                << "luma mismatch, width " << width << " height " << height;
+            ASSERT_EQ(0, memcmp(chroma_ref_, chroma_tst_, sizeof(chroma_ref_)))
+                << "chroma mismatch, width " << width << " height " << height
+                << " subsampling " << ss_x << ss_y;
+        }
+    }
+
+  protected:
+    virtual void run_ref_luma(Sample *luma, int32_t luma_stride,
+                              const int32_t *grain, int32_t grain_stride,
+                              int32_t width, int32_t height,
+                              const FgnScaling *scaling) = 0;
+    virtual void run_ref_chroma(Sample *chroma, int32_t chroma_stride,
+                                const Sample *luma, int32_t luma_stride,
+                                const int32_t *grain, int32_t grain_stride,
+                                int32_t width, int32_t height, int32_t ss_x,
+                                int32_t ss_y, const FgnScaling *scaling) = 0;
+
+    LumaFunc tst_luma_;
+    ChromaFunc tst_chroma_;
+    int bd_;
+    libaom_test::ACMRandom rnd_;
+    int32_t lut_[256];
+    Sample luma_ref_[kSize];
+    Sample luma_tst_[kSize];
+    Sample chroma_ref_[kSize];
+    Sample chroma_tst_[kSize];
+    int32_t grain_[kSize];
+};
+
+class FgnAddNoiseLbdTest
+    : public FgnAddNoiseTest<uint8_t, FgnLumaNoiseFunc, FgnChromaNoiseFunc> {
+  protected:
+    void run_ref_luma(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                      int32_t grain_stride, int32_t width, int32_t height,
+                      const FgnScaling *scaling) override {
+        svt_av1_fgn_add_luma_noise_c(
+            luma, luma_stride, grain, grain_stride, width, height, scaling);
+    }
+    void run_ref_chroma(uint8_t *chroma, int32_t chroma_stride,
+                        const uint8_t *luma, int32_t luma_stride,
+                        const int32_t *grain, int32_t grain_stride,
+                        int32_t width, int32_t height, int32_t ss_x,
+                        int32_t ss_y, const FgnScaling *scaling) override {
+        svt_av1_fgn_add_chroma_noise_c(chroma,
+                                       chroma_stride,
+                                       luma,
+                                       luma_stride,
+                                       grain,
+                                       grain_stride,
+                                       width,
+                                       height,
+                                       ss_x,
+                                       ss_y,
+                                       scaling);
+    }
+};
+
+class FgnAddNoiseHbdTest
+    : public FgnAddNoiseTest<uint16_t, FgnLumaNoiseHbdFunc,
+                             FgnChromaNoiseHbdFunc> {
+  protected:
+    void run_ref_luma(uint16_t *luma, int32_t luma_stride,
+                      const int32_t *grain, int32_t grain_stride,
+                      int32_t width, int32_t height,
+                      const FgnScaling *scaling) override {
+        svt_av1_fgn_add_luma_noise_hbd_c(
+            luma, luma_stride, grain, grain_stride, width, height, scaling);
+    }
+    void run_ref_chroma(uint16_t *chroma, int32_t chroma_stride,
+                        const uint16_t *luma, int32_t luma_stride,
+                        const int32_t *grain, int32_t grain_stride,
+                        int32_t width, int32_t height, int32_t ss_x,
+                        int32_t ss_y, const FgnScaling *scaling) override {
+        svt_av1_fgn_add_chroma_noise_hbd_c(chroma,
+                                           chroma_stride,
+                                           luma,
+                                           luma_stride,
+                                           grain,
+                                           grain_stride,
+                                           width,
+                                           height,
+                                           ss_x,
+                                           ss_y,
+                                           scaling);
+    }
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(FgnAddNoiseLbdTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(FgnAddNoiseHbdTest);
+
+TEST_P(FgnAddNoiseLbdTest, MatchTest) {
+    run_test();
+}
+
+TEST_P(FgnAddNoiseHbdTest, MatchTest) {
+    run_test();
+}
+
+class FgnHorOverlapTest : public ::testing::TestWithParam<FgnHorOverlapFunc> {
+  public:
+    static const int kStride = 80;
+
+    void run_test() {
+        FgnHorOverlapFunc tst_func = GetParam();
+        for (int bd = 8; bd <= 12; bd += 2) {
+            const int grain_min = -(128 << (bd - 8));
+            const int grain_max = (128 << (bd - 8)) - 1;
+            for (int iter = 0; iter < 1000 && !HasFailure(); iter++) {
+                for (int i = 0; i < 2 * kStride; i++) {
+                    // out of range values, so that the clipping is tested
+                    top_ref_[i] = top_tst_[i] =
+                        2 * grain_min +
+                        rnd_.PseudoUniform(4 * (grain_max - grain_min + 1));
+                    bottom_[i] = grain_min + rnd_.PseudoUniform(
+                                                 grain_max - grain_min + 1);
+                }
+                const int width = 1 + rnd_.PseudoUniform(kStride - 1);
+                const int height = 1 + rnd_.PseudoUniform(2);
+                // the encoder blends in place in the top block
+                svt_av1_fgn_hor_boundary_overlap_c(top_ref_,
+                                                   kStride,
+                                                   bottom_,
+                                                   kStride,
+                                                   top_ref_,
+                                                   kStride,
+                                                   width,
+                                                   height,
+                                                   grain_min,
+                                                   grain_max);
+                tst_func(top_tst_,
+                         kStride,
+                         bottom_,
+                         kStride,
+                         top_tst_,
+                         kStride,
+                         width,
+                         height,
+                         grain_min,
+                         grain_max);
+                ASSERT_EQ(0, memcmp(top_ref_, top_tst_, sizeof(top_ref_)))
+                    << "width " << width << " height " << height;
+            }
+        }
+    }
+
+  protected:
+    libaom_test::ACMRandom rnd_;
+    int32_t top_ref_[2 * kStride];
+    int32_t top_tst_[2 * kStride];
+    int32_t bottom_[2 * kStride];
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(FgnHorOverlapTest);
+
+TEST_P(FgnHorOverlapTest, MatchTest) {
+    run_test();
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FgnAddNoiseLbdTest,
+    ::testing::Values(std::make_tuple(svt_av1_fgn_add_luma_noise_avx2,
+                                      svt_av1_fgn_add_chroma_noise_avx2, 8)));
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FgnAddNoiseHbdTest,
+    ::testing::Values(
+        std::make_tuple(svt_av1_fgn_add_luma_noise_hbd_avx2,
+                        svt_av1_fgn_add_chroma_noise_hbd_avx2, 10),
+        std::make_tuple(svt_av1_fgn_add_luma_noise_hbd_avx2,
+                        svt_av1_fgn_add_chroma_noise_hbd_avx2, 12)));
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FgnHorOverlapTest,
+    ::testing::Values(svt_av1_fgn_hor_boundary_overlap_avx2));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, FgnAddNoiseLbdTest,
+    ::testing::Values(std::make_tuple(svt_av1_fgn_add_luma_noise_avx512,
+                                      svt_av1_fgn_add_chroma_noise_avx512,
+                                      8)));
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, FgnAddNoiseHbdTest,
+    ::testing::Values(
+        std::make_tuple(svt_av1_fgn_add_luma_noise_hbd_avx512,
+                        svt_av1_fgn_add_chroma_noise_hbd_avx512, 10),
+        std::make_tuple(svt_av1_fgn_add_luma_noise_hbd_avx512,
+                        svt_av1_fgn_add_chroma_noise_hbd_avx512, 12)));
+#endif  // EN_AVX512_SUPPORT
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, FgnAddNoiseLbdTest,
+    ::testing::Values(std::make_tuple(svt_av1_fgn_add_luma_noise_neon,
+                                      svt_av1_fgn_add_chroma_noise_neon, 8)));
+INSTANTIATE_TEST_SUITE_P(
+    NEON, FgnAddNoiseHbdTest,
+    ::testing::Values(
+        std::make_tuple(svt_av1_fgn_add_luma_noise_hbd_neon,
+                        svt_av1_fgn_add_chroma_noise_hbd_neon, 10),
+        std::make_tuple(svt_av1_fgn_add_luma_noise_hbd_neon,
+                        svt_av1_fgn_add_chroma_noise_hbd_neon, 12)));
+INSTANTIATE_TEST_SUITE_P(
+    NEON, FgnHorOverlapTest,
+    ::testing::Values(svt_av1_fgn_hor_boundary_overlap_neon));
+#endif  // ARCH_AARCH64
+
 extern "C" {
 #include "pcs.h"
 #include "pic_buffer_desc.h"
@@ -384,6 +708,7 @@ class DenoiseModelRunTest : public ::testing::Test {
         fg_init_data.encoder_color_format = EB_YUV420;
         fg_init_data.noise_level = 4;  // TODO: check the range;
         fg_init_data.denoise_apply = FALSE;
+        fg_init_data.job_pool = NULL;
         fg_init_data.width = width_;
         fg_init_data.height = height_;
         fg_init_data.stride_y = width_;
@@ -460,3 +785,16 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+// The block rows are denoised and modelled on several threads, the estimate
+// must not depend on the thread count.
+TEST_F(DenoiseModelRunTest, OutputFilmGrainCheckMultiThread) {
+    SvtJobPool job_pool;
+    memset(&job_pool, 0, sizeof(job_pool));
+    ASSERT_EQ(svt_job_pool_ctor(&job_pool, 4), EB_ErrorNone);
+    noise_model.job_pool = &job_pool;
+    run_test();
+    check_filmgrain();
+    job_pool.dctor(&job_pool);
+    EXPECT_FALSE(HasFailure());
+}
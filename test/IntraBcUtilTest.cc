@@ -15,6 +15,8 @@
  *
  * @brief Unit test of Intra BC utility:
  * - svt_aom_is_dv_valid
+ * - svt_av1_hash_index_update
+ * - svt_av1_get_b64_block_hashes
  *
  * @author Cidana-Edmond
  *
@@ -24,6 +26,11 @@
 #include "definitions.h"
 #include "adaptive_mv_pred.h"
 #include "util.h"
+#include "hash_motion.h"
+#include "random.h"
+
+/** setup_test_env is implemented in test/TestEnv.c */
+extern "C" void setup_test_env();
 
 namespace {
 using std::make_tuple;
@@ -131,4 +138,202 @@ TEST_P(DvValiationTest, IsDvValidate) {
 INSTANTIATE_TEST_SUITE_P(AV1, DvValiationTest,
                          ::testing::ValuesIn(dv_validation_params));
 
+typedef std::tuple<int,    /**< max block size */
+                   uint8_t /**< hash 4x4 blocks */
+                   >
+    HashIndexParam;
+
+/**
+ * @brief Unit test of the block hash index kept across pictures:
+ * a picture is indexed, then pictures with local edits, a scrolled area
+ * and whole new content follow. After each update the table must hold,
+ * bucket by bucket and in the same order, what an index built from
+ * scratch on that picture holds.
+ */
+class HashIndexTest : public ::testing::TestWithParam<HashIndexParam> {
+  protected:
+    static const int kWidth = 328;
+    static const int kHeight = 200;
+    static const int kStride = kWidth + 16;
+
+    HashIndexTest() : rnd_(0, 255) {
+        picture_.resize(kStride * kHeight);
+    }
+
+    void SetUp() override {
+        setup_test_env();
+    }
+
+    // text-like content: flat background with random glyph rectangles
+    void fill_screen(int x0, int y0, int w, int h) {
+        const uint8_t background = rnd_.random() & 0xf0;
+        for (int y = y0; y < y0 + h; y++)
+            memset(&picture_[y * kStride + x0], background, w);
+        for (int glyph = 0; glyph < w * h / 256; glyph++) {
+            const int gw = 3 + rnd_.random() % 12, gh = 3 + rnd_.random() % 12;
+            const int gx = x0 + rnd_.random() % (w - gw + 1);
+            const int gy = y0 + rnd_.random() % (h - gh + 1);
+            for (int y = gy; y < gy + gh; y++)
+                for (int x = gx; x < gx + gw; x++)
+                    picture_[y * kStride + x] = rnd_.random() & 0xfc;
+        }
+    }
+
+    void scroll(int x0, int y0, int w, int h, int dy) {
+        for (int y = y0; y < y0 + h - dy; y++)
+            memcpy(&picture_[y * kStride + x0],
+                   &picture_[(y + dy) * kStride + x0],
+                   w);
+        fill_screen(x0, y0 + h - dy, w, dy);
+    }
+
+    void link_picture(Yv12BufferConfig *config) {
+        memset(config, 0, sizeof(*config));
+        config->y_buffer = picture_.data();
+        config->y_stride = kStride;
+        config->y_crop_width = kWidth;
+        config->y_crop_height = kHeight;
+    }
+
+    void check_index(HashIndex *index) {
+        HashIndex ref_index;
+        Yv12BufferConfig config;
+        memset(&ref_index, 0, sizeof(ref_index));
+        link_picture(&config);
+        ASSERT_EQ(svt_av1_hash_index_update(&ref_index,
+                                            &config,
+                                            TEST_GET_PARAM(0),
+                                            TEST_GET_PARAM(1)),
+                  EB_ErrorNone);
+        for (uint32_t hash_value = 0; hash_value < (1u << 19);
+             hash_value++) {
+            const int32_t count =
+                svt_av1_hash_table_count(&index->table, hash_value);
+            ASSERT_EQ(
+                count, svt_av1_hash_table_count(&ref_index.table, hash_value))
+                << "hash " << hash_value;
+            if (!count)
+                continue;
+            Iterator it =
+                svt_av1_hash_get_first_iterator(&index->table, hash_value);
+            Iterator ref_it =
+                svt_av1_hash_get_first_iterator(&ref_index.table, hash_value);
+            for (int32_t i = 0; i < count; i++) {
+                const BlockHash *block = (BlockHash *)svt_aom_iterator_get(&it);
+                const BlockHash *ref_block =
+                    (BlockHash *)svt_aom_iterator_get(&ref_it);
+                ASSERT_EQ(block->x, ref_block->x) << "hash " << hash_value;
+                ASSERT_EQ(block->y, ref_block->y) << "hash " << hash_value;
+                ASSERT_EQ(block->hash_value2, ref_block->hash_value2);
+                svt_aom_iterator_increment(&it);
+                svt_aom_iterator_increment(&ref_it);
+            }
+        }
+        svt_av1_hash_index_destroy(&ref_index);
+    }
+
+    void update_and_check(HashIndex *index) {
+        Yv12BufferConfig config;
+        link_picture(&config);
+        ASSERT_EQ(svt_av1_hash_index_update(
+                      index, &config, TEST_GET_PARAM(0), TEST_GET_PARAM(1)),
+                  EB_ErrorNone);
+        check_index(index);
+    }
+
+    void run_update_test() {
+        HashIndex index;
+        memset(&index, 0, sizeof(index));
+        fill_screen(0, 0, kWidth, kHeight);
+        update_and_check(&index);
+        // unchanged picture
+        update_and_check(&index);
+        // local edits, one of them at the bottom right corner
+        fill_screen(70, 30, 20, 9);
+        fill_screen(kWidth - 13, kHeight - 7, 13, 7);
+        update_and_check(&index);
+        // scrolled window
+        scroll(130, 40, 120, 100, 11);
+        update_and_check(&index);
+        // new content everywhere
+        fill_screen(0, 0, kWidth, kHeight);
+        update_and_check(&index);
+        svt_av1_hash_index_destroy(&index);
+    }
+
+    void run_b64_hash_test() {
+        HashIndex index;
+        Yv12BufferConfig config;
+        CRC_CALCULATOR crc_calculator1, crc_calculator2;
+        B64BlockHashes hashes;
+        memset(&index, 0, sizeof(index));
+        // noise, so that no block is skipped as a flat one
+        for (int y = 0; y < kHeight; y++)
+            for (int x = 0; x < kWidth; x++)
+                picture_[y * kStride + x] = rnd_.random();
+        link_picture(&config);
+        ASSERT_EQ(svt_av1_hash_index_update(
+                      &index, &config, TEST_GET_PARAM(0), TEST_GET_PARAM(1)),
+                  EB_ErrorNone);
+        svt_av1_crc_calculator_init(&crc_calculator1, 24, 0x5D6DCB);
+        svt_av1_crc_calculator_init(&crc_calculator2, 24, 0x864CFB);
+        for (int b64_y = 0; b64_y + 64 <= kHeight; b64_y += 64) {
+            for (int b64_x = 0; b64_x + 64 <= kWidth; b64_x += 64) {
+                svt_av1_get_b64_block_hashes(&picture_[b64_y * kStride + b64_x],
+                                             kStride,
+                                             &crc_calculator1,
+                                             &crc_calculator2,
+                                             &hashes);
+                for (int level = 0, size = 4; size <= TEST_GET_PARAM(0);
+                     level++, size <<= 1) {
+                    if (size == 4 && !TEST_GET_PARAM(1))
+                        continue;
+                    if (size > 64)
+                        break;
+                    for (int pos = 0; pos < (64 / size) * (64 / size);
+                         pos++) {
+                        const int x = b64_x + (pos % (64 / size)) * size;
+                        const int y = b64_y + (pos / (64 / size)) * size;
+                        const uint32_t hash_value1 =
+                            hashes.hash_value1[level][pos];
+                        const int32_t count = svt_av1_hash_table_count(
+                            &index.table, hash_value1);
+                        Iterator it = svt_av1_hash_get_first_iterator(
+                            &index.table, hash_value1);
+                        bool found = false;
+                        for (int32_t i = 0; i < count && !found; i++) {
+                            const BlockHash *block =
+                                (BlockHash *)svt_aom_iterator_get(&it);
+                            found = block->x == x && block->y == y &&
+                                    block->hash_value2 ==
+                                        hashes.hash_value2[level][pos];
+                            svt_aom_iterator_increment(&it);
+                        }
+                        ASSERT_TRUE(found) << "size " << size << " at " << x
+                                           << "," << y;
+                    }
+                }
+            }
+        }
+        svt_av1_hash_index_destroy(&index);
+    }
+
+    svt_av1_test_tool::SVTRandom rnd_;
+    std::vector<uint8_t> picture_;
+};
+
+TEST_P(HashIndexTest, MatchesFullRebuild) {
+    run_update_test();
+}
+
+TEST_P(HashIndexTest, B64HashesMatchIndex) {
+    run_b64_hash_test();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AV1, HashIndexTest,
+    ::testing::Values(HashIndexParam(8, 1), HashIndexParam(16, 0),
+                      HashIndexParam(32, 1), HashIndexParam(64, 0),
+                      HashIndexParam(128, 1)));
+
 }  // namespace
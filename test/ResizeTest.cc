@@ -16,6 +16,7 @@
  * @brief Unit test for resize of downsampling functions:
  * - svt_av1_resize_plane
  * - svt_av1_highbd_resize_plane
+ * - svt_aom_resize_plane_multi
  *
  * @author Cidana-Edmond
  *
@@ -28,6 +29,7 @@
 #include "unit_test_utility.h"
 #include "random.h"
 #include "util.h"
+#include "resize.h"
 
 extern "C" void calculate_scaled_size_helper(uint16_t *dim, uint8_t denom);
 
@@ -530,4 +532,157 @@ INSTANTIATE_TEST_SUITE_P(
     Resize, ResizePlaneHbdTest,
     ::testing::Combine(::testing::ValuesIn(pic_size_vector),
                        ::testing::Range(8, 16), ::testing::Values(10, 12)));
+typedef std::tuple<PicSizeParam, int> /**< bit depth: 8, 10, 12 */
+    ResizeMultiTestParam;
+
+/**
+ * @brief Unit test for svt_aom_resize_plane_multi
+ *
+ * Test strategy:
+ * Resize one picture to the full and the width-only sizes of every
+ * denominator 9~16, plus one upscale, in a single call with optimized
+ * kernels, on the calling thread or on a pool of 3 workers, and compare
+ * each target with a separate svt_av1_resize_plane_c() /
+ * svt_av1_highbd_resize_plane_c() run.
+ *
+ * Expected result:
+ * Every target is the same as the c reference, whatever the worker count.
+ */
+class ResizePlaneMultiTest
+    : public ::testing::TestWithParam<ResizeMultiTestParam> {
+  public:
+    ResizePlaneMultiTest()
+        : width_(std::get<0>(TEST_GET_PARAM(0))),
+          height_(std::get<1>(TEST_GET_PARAM(0))),
+          stride_(std::get<2>(TEST_GET_PARAM(0))),
+          bd_(TEST_GET_PARAM(1)),
+          sample_size_(bd_ > 8 ? sizeof(uint16_t) : sizeof(uint8_t)),
+          rnd_(bd_, false) {
+    }
+
+    void SetUp() override {
+        src_.resize((size_t)stride_ * height_ * sample_size_);
+        for (int denom = 9; denom <= 16; ++denom) {
+            uint16_t scaled_width = (uint16_t)width_;
+            uint16_t scaled_height = (uint16_t)height_;
+            calculate_scaled_size_helper(&scaled_width, denom);
+            calculate_scaled_size_helper(&scaled_height, denom);
+            add_target(scaled_width, scaled_height);
+            add_target(scaled_width, height_);
+        }
+        add_target(width_ * 2, height_ * 3 / 2);
+    }
+
+    void run_test(SvtJobPool *job_pool) {
+        for (size_t i = 0; i < src_.size(); i += sample_size_)
+            set_sample(src_.data(), i / sample_size_, rnd_.random());
+
+        reset_test_env();
+        for (size_t t = 0; t < targets_.size(); ++t) {
+            const ResizePlaneTarget &target = targets_[t];
+            if (bd_ > 8)
+                svt_av1_highbd_resize_plane_c((const uint16_t *)src_.data(),
+                                              height_,
+                                              width_,
+                                              stride_,
+                                              (uint16_t *)ref_[t].data(),
+                                              target.height,
+                                              target.width,
+                                              target.stride,
+                                              bd_);
+            else
+                svt_av1_resize_plane_c(src_.data(),
+                                       height_,
+                                       width_,
+                                       stride_,
+                                       ref_[t].data(),
+                                       target.height,
+                                       target.width,
+                                       target.stride);
+        }
+
+        setup_test_env();
+        for (size_t t = 0; t < targets_.size(); ++t)
+            memset(tst_[t].data(), TST_STUFF, tst_[t].size());
+        ASSERT_EQ(svt_aom_resize_plane_multi(src_.data(),
+                                             height_,
+                                             width_,
+                                             stride_,
+                                             targets_.data(),
+                                             (int32_t)targets_.size(),
+                                             bd_,
+                                             job_pool),
+                  EB_ErrorNone);
+
+        for (size_t t = 0; t < targets_.size(); ++t) {
+            const ResizePlaneTarget &target = targets_[t];
+            for (int y = 0; y < target.height; ++y) {
+                const size_t row = (size_t)y * target.stride * sample_size_;
+                ASSERT_EQ(memcmp(ref_[t].data() + row,
+                                 tst_[t].data() + row,
+                                 target.width * sample_size_),
+                          0)
+                    << "target " << target.width << "x" << target.height
+                    << (job_pool ? " on the pool" : " on the caller")
+                    << " row " << y;
+            }
+        }
+    }
+
+  private:
+    void add_target(int width, int height) {
+        ResizePlaneTarget target;
+        const size_t size = (size_t)(width + 8) * height * sample_size_;
+        ref_.push_back(std::vector<uint8_t>(size, REF_STUFF));
+        tst_.push_back(std::vector<uint8_t>(size, TST_STUFF));
+        target.output = NULL;
+        target.stride = width + 8;
+        target.width = width;
+        target.height = height;
+        targets_.push_back(target);
+        for (size_t t = 0; t < targets_.size(); ++t)
+            targets_[t].output = tst_[t].data();
+    }
+
+    void set_sample(uint8_t *buf, size_t i, uint16_t value) {
+        if (bd_ > 8)
+            ((uint16_t *)buf)[i] = value;
+        else
+            buf[i] = (uint8_t)value;
+    }
+
+    const int width_;
+    const int height_;
+    const int stride_;
+    const int bd_;
+    const size_t sample_size_;
+    SVTRandom rnd_;
+    std::vector<uint8_t> src_;
+    std::vector<std::vector<uint8_t>> ref_;
+    std::vector<std::vector<uint8_t>> tst_;
+    std::vector<ResizePlaneTarget> targets_;
+};
+
+TEST_P(ResizePlaneMultiTest, MatchTestWithRandomValue) {
+    SvtJobPool job_pool;
+    memset(&job_pool, 0, sizeof(job_pool));
+    ASSERT_EQ(svt_job_pool_ctor(&job_pool, 3), EB_ErrorNone);
+    for (int iter = 0; iter < 2 && !HasFatalFailure(); ++iter) {
+        run_test(NULL);
+        run_test(&job_pool);
+    }
+    job_pool.dctor(&job_pool);
+}
+
+static PicSizeParam multi_pic_size_vector[] = {
+    make_tuple(1, 1, 1),
+    make_tuple(37, 19, 40),
+    make_tuple(202, 118, 224),
+    make_tuple(640, 360, 704),
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Resize, ResizePlaneMultiTest,
+    ::testing::Combine(::testing::ValuesIn(multi_pic_size_vector),
+                       ::testing::Values(8, 10, 12)));
 }  // namespace
@@ -18,6 +18,11 @@
  * @author Cidana-Edmond, Cidana-Ryan, Cidana-Wenyao
  *
  ******************************************************************************/
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1EncApiTest.h"
@@ -100,6 +105,9 @@ TEST(EncApiTest, check_null_pointer) {
     // return value, just feed nullptr as parameter. release output buffer with
     // null pointer
     svt_av1_enc_release_out_buffer(nullptr);
+    // set the output buffer allocator with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_set_output_buffer_allocator(nullptr, nullptr));
     // close encoder with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, svt_av1_enc_deinit(nullptr));
     // destory encoder handle with null pointer
@@ -203,4 +211,779 @@ TEST(EncApiTest, DISABLED_repeat_normal_setup) {
     }
 }
 
+/** Caller pool of the output_buffer_allocator test, tracking the buffers
+ * handed to the encoder */
+struct OutputBufferPool {
+    std::mutex mutex;
+    std::map<uint8_t *, uint32_t> live;
+    uint32_t alloc_count;
+    uint32_t release_count;
+    // buffers given before alloc fails, 0 for never
+    uint32_t fail_after;
+
+    static uint8_t *alloc(void *context, uint32_t size) {
+        OutputBufferPool *pool = static_cast<OutputBufferPool *>(context);
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->fail_after && pool->alloc_count >= pool->fail_after)
+            return nullptr;
+        uint8_t *buffer = new uint8_t[size];
+        pool->live[buffer] = size;
+        pool->alloc_count++;
+        return buffer;
+    }
+
+    static void release(void *context, uint8_t *buffer) {
+        OutputBufferPool *pool = static_cast<OutputBufferPool *>(context);
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        EXPECT_EQ(pool->live.count(buffer), 1u);
+        pool->live.erase(buffer);
+        pool->release_count++;
+        delete[] buffer;
+    }
+};
+
+/** Splits 10bit samples into the 8 MSBs and the 2 LSBs packed 4 samples per
+ * byte, first sample in bits 7:6 */
+static void split_ten_bit_plane(const std::vector<uint16_t> &samples,
+                                uint32_t width, uint32_t height,
+                                std::vector<uint8_t> &msb,
+                                std::vector<uint8_t> &lsb) {
+    const uint32_t lsb_stride = (width + 3) / 4;
+    msb.assign(width * height, 0);
+    lsb.assign(lsb_stride * height, 0);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            const uint16_t v = samples[y * width + x];
+            msb[y * width + x] = (uint8_t)(v >> 2);
+            lsb[y * lsb_stride + x / 4] |= (uint8_t)((v & 3) << (6 - 2 * (x & 3)));
+        }
+    }
+}
+
+/** Picture statistics received by the picture_stats_cb of encode_frames */
+static void collect_picture_stats(const SvtAv1PictureStats *stats,
+                                  void *user_data) {
+    static_cast<std::vector<SvtAv1PictureStats> *>(user_data)->push_back(
+        *stats);
+}
+
+/** Changes the parameters of the encoder of encode_frames */
+typedef std::function<void(EbSvtAv1EncConfiguration &)> ConfigureFn;
+/** Inspects the encoder of encode_frames once the frames are encoded */
+typedef std::function<void(EbComponentType *)> InspectFn;
+
+/** Encodes a few synthetic frames, with the caller pool when one is given,
+ * and returns the bitstream. 10bit frames are sent as 16-bit samples, or in
+ * the compressed format when compressed is set. The picture statistics are
+ * appended to picture_stats when it is given. configure is called before
+ * the parameters are set, and inspect before the encoder is deinitialized */
+static std::vector<uint8_t> encode_frames(
+    OutputBufferPool *pool, uint32_t width = 64, bool ten_bit = false,
+    bool compressed = false,
+    std::vector<SvtAv1PictureStats> *picture_stats = nullptr,
+    const ConfigureFn &configure = nullptr,
+    const InspectFn &inspect = nullptr) {
+    const uint32_t height = 64;
+    const int frame_count = 10;
+    SvtAv1Context context;
+    std::vector<uint8_t> stream;
+    memset(&context, 0, sizeof(context));
+
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params));
+    context.enc_params.source_width = width;
+    context.enc_params.source_height = height;
+    context.enc_params.enc_mode = 10;
+    context.enc_params.logical_processors = 1;
+    if (ten_bit)
+        context.enc_params.encoder_bit_depth = 10;
+    context.enc_params.compressed_ten_bit_format = compressed;
+    if (picture_stats) {
+        context.enc_params.picture_stats_cb = collect_picture_stats;
+        context.enc_params.picture_stats_user_data = picture_stats;
+    }
+    if (configure)
+        configure(context.enc_params);
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params));
+    if (pool) {
+        const SvtAv1OutputBufferAllocator allocator = {
+            OutputBufferPool::alloc, OutputBufferPool::release, pool};
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_set_output_buffer_allocator(context.enc_handle,
+                                                          &allocator));
+    }
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle));
+    if (pool) {
+        // too late once the encoder is initialized
+        EXPECT_EQ(EB_ErrorBadParameter,
+                  svt_av1_enc_set_output_buffer_allocator(context.enc_handle,
+                                                          nullptr));
+    }
+
+    const uint32_t chroma_width = width / 2;
+    // in quarters of a byte
+    const uint32_t sample_size = !ten_bit ? 4 : compressed ? 5 : 8;
+    std::vector<uint8_t> luma(width * height);
+    std::vector<uint8_t> chroma(chroma_width * height / 2, 128);
+    std::vector<uint16_t> luma16(width * height);
+    std::vector<uint16_t> cb16(chroma_width * height / 2);
+    std::vector<uint16_t> cr16(chroma_width * height / 2);
+    std::vector<uint8_t> cb(chroma.size()), cr(chroma.size());
+    std::vector<uint8_t> luma_lsb, cb_lsb, cr_lsb;
+    EbSvtIOFormat frame;
+    EbBufferHeaderType input;
+    memset(&frame, 0, sizeof(frame));
+    memset(&input, 0, sizeof(input));
+    frame.y_stride = width;
+    frame.cb_stride = chroma_width;
+    frame.cr_stride = chroma_width;
+    frame.y_lsb_stride = (width + 3) / 4;
+    frame.cb_lsb_stride = (chroma_width + 3) / 4;
+    frame.cr_lsb_stride = (chroma_width + 3) / 4;
+    input.size = sizeof(input);
+    input.p_buffer = reinterpret_cast<uint8_t *>(&frame);
+    input.n_filled_len = width * height * 3 / 2 * sample_size / 4;
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+
+    for (int i = 0; i < frame_count; i++) {
+        if (!ten_bit) {
+            for (uint32_t p = 0; p < width * height; p++)
+                luma[p] = (uint8_t)((p % width) * 2 + (p / width) + i * 3);
+            frame.luma = luma.data();
+            frame.cb = chroma.data();
+            frame.cr = chroma.data();
+        } else {
+            for (uint32_t p = 0; p < width * height; p++)
+                luma16[p] = (uint16_t)((((p % width) * 2 + (p / width) + i * 3) * 4 +
+                                        p * 7 + i) & 0x3ff);
+            for (uint32_t p = 0; p < cb16.size(); p++) {
+                cb16[p] = (uint16_t)(512 + (p * 5 + i) % 7);
+                cr16[p] = (uint16_t)(500 + (p * 3 + i) % 5);
+            }
+            if (compressed) {
+                split_ten_bit_plane(luma16, width, height, luma, luma_lsb);
+                split_ten_bit_plane(cb16, chroma_width, height / 2, cb, cb_lsb);
+                split_ten_bit_plane(cr16, chroma_width, height / 2, cr, cr_lsb);
+                frame.luma = luma.data();
+                frame.cb = cb.data();
+                frame.cr = cr.data();
+                frame.luma_lsb = luma_lsb.data();
+                frame.cb_lsb = cb_lsb.data();
+                frame.cr_lsb = cr_lsb.data();
+            } else {
+                frame.luma = reinterpret_cast<uint8_t *>(luma16.data());
+                frame.cb = reinterpret_cast<uint8_t *>(cb16.data());
+                frame.cr = reinterpret_cast<uint8_t *>(cr16.data());
+            }
+        }
+        input.pts = i;
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_send_picture(context.enc_handle, &input));
+    }
+    EbBufferHeaderType eos;
+    memset(&eos, 0, sizeof(eos));
+    eos.flags = EB_BUFFERFLAG_EOS;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(context.enc_handle, &eos));
+
+    bool done = false;
+    while (!done) {
+        EbBufferHeaderType *packet = nullptr;
+        if (svt_av1_enc_get_packet(context.enc_handle, &packet, 1) !=
+            EB_ErrorNone)
+            break;
+        done = packet->flags & EB_BUFFERFLAG_EOS;
+        if (packet->n_filled_len) {
+            if (pool) {
+                // the packet is written in the caller memory
+                std::lock_guard<std::mutex> lock(pool->mutex);
+                auto entry = pool->live.find(packet->p_buffer);
+                EXPECT_NE(entry, pool->live.end());
+                if (entry != pool->live.end()) {
+                    EXPECT_LE(packet->n_filled_len, entry->second);
+                }
+            }
+            stream.insert(stream.end(),
+                          packet->p_buffer,
+                          packet->p_buffer + packet->n_filled_len);
+        }
+        svt_av1_enc_release_out_buffer(&packet);
+    }
+    EXPECT_TRUE(done);
+    if (inspect)
+        inspect(context.enc_handle);
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+    return stream;
+}
+
+/** @brief output_buffer_allocator is a api test case
+ * EncApiTest.output_buffer_allocator checks the packets are written in the
+ * buffers of a caller allocator
+ *
+ * Test strategy: <br>
+ * Encode the same frames with the internal allocator and with a caller pool.
+ *
+ * Expected result: <br>
+ * The bitstreams match, every packet is in a buffer of the pool and every
+ * buffer of the pool is given back.
+ *
+ * Test coverage:
+ * svt_av1_enc_set_output_buffer_allocator, svt_av1_enc_release_out_buffer.
+ */
+TEST(EncApiTest, output_buffer_allocator) {
+    OutputBufferPool pool;
+    pool.alloc_count = 0;
+    pool.release_count = 0;
+    pool.fail_after = 0;
+
+    const std::vector<uint8_t> ref_stream = encode_frames(nullptr);
+    const std::vector<uint8_t> pool_stream = encode_frames(&pool);
+    EXPECT_FALSE(ref_stream.empty());
+    EXPECT_EQ(ref_stream, pool_stream);
+    EXPECT_GT(pool.alloc_count, 0u);
+    EXPECT_EQ(pool.alloc_count, pool.release_count);
+    EXPECT_TRUE(pool.live.empty());
+}
+
+/** @brief output_buffer_allocator_failure is a api test case
+ * EncApiTest.output_buffer_allocator_failure checks a packet the caller
+ * allocator cannot provide is reported as an error
+ *
+ * Test strategy: <br>
+ * Encode with a caller pool that fails once it gave two buffers.
+ *
+ * Expected result: <br>
+ * svt_av1_enc_get_packet returns an error with an empty packet flagged with
+ * EB_BUFFERFLAG_ERROR_MASK, the encoder still reaches EOS and is
+ * deinitialized.
+ *
+ * Test coverage:
+ * svt_av1_enc_set_output_buffer_allocator, svt_av1_enc_get_packet.
+ */
+TEST(EncApiTest, output_buffer_allocator_failure) {
+    const uint32_t width = 64;
+    const uint32_t height = 64;
+    OutputBufferPool pool;
+    pool.alloc_count = 0;
+    pool.release_count = 0;
+    pool.fail_after = 2;
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params));
+    context.enc_params.source_width = width;
+    context.enc_params.source_height = height;
+    context.enc_params.enc_mode = 10;
+    context.enc_params.logical_processors = 1;
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params));
+    const SvtAv1OutputBufferAllocator allocator = {
+        OutputBufferPool::alloc, OutputBufferPool::release, &pool};
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_output_buffer_allocator(context.enc_handle,
+                                                      &allocator));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle));
+
+    std::vector<uint8_t> luma(width * height);
+    std::vector<uint8_t> chroma(width / 2 * height / 2, 128);
+    EbSvtIOFormat frame;
+    EbBufferHeaderType input;
+    memset(&frame, 0, sizeof(frame));
+    memset(&input, 0, sizeof(input));
+    frame.luma = luma.data();
+    frame.cb = chroma.data();
+    frame.cr = chroma.data();
+    frame.y_stride = width;
+    frame.cb_stride = width / 2;
+    frame.cr_stride = width / 2;
+    input.size = sizeof(input);
+    input.p_buffer = reinterpret_cast<uint8_t *>(&frame);
+    input.n_filled_len = width * height * 3 / 2;
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+    for (int i = 0; i < 10; i++) {
+        for (uint32_t p = 0; p < width * height; p++)
+            luma[p] = (uint8_t)((p % width) * 2 + (p / width) + i * 3);
+        input.pts = i;
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_send_picture(context.enc_handle, &input));
+    }
+    EbBufferHeaderType eos;
+    memset(&eos, 0, sizeof(eos));
+    eos.flags = EB_BUFFERFLAG_EOS;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(context.enc_handle, &eos));
+
+    // drain past the error packets so the encoder reaches EOS
+    bool failed = false;
+    bool done = false;
+    while (!done) {
+        EbBufferHeaderType *packet = nullptr;
+        const bool error =
+            svt_av1_enc_get_packet(context.enc_handle, &packet, 1) !=
+            EB_ErrorNone;
+        ASSERT_NE(packet, nullptr);
+        if (error) {
+            EXPECT_NE(packet->flags & EB_BUFFERFLAG_ERROR_MASK, 0u);
+            EXPECT_EQ(packet->n_filled_len, 0u);
+        }
+        failed |= error;
+        done = packet->flags & EB_BUFFERFLAG_EOS;
+        svt_av1_enc_release_out_buffer(&packet);
+    }
+    EXPECT_TRUE(failed);
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+}
+
+/** @brief compressed_ten_bit_format is a api test case
+ * EncApiTest.compressed_ten_bit_format checks 10bit input in the compressed
+ * format of the encoder is encoded as the same input in 16-bit samples
+ *
+ * Test strategy: <br>
+ * Encode the same 10bit frames from 16-bit samples and from the split 8 MSBs
+ * and compressed 2 LSBs, with a chroma width that is not a multiple of 4.
+ *
+ * Expected result: <br>
+ * The bitstreams match.
+ *
+ * Test coverage:
+ * compressed_ten_bit_format, EbSvtIOFormat luma_lsb / cb_lsb / cr_lsb.
+ */
+TEST(EncApiTest, compressed_ten_bit_format) {
+    for (const uint32_t width : {64u, 66u}) {
+        const std::vector<uint8_t> ref_stream =
+            encode_frames(nullptr, width, true, false);
+        const std::vector<uint8_t> split_stream =
+            encode_frames(nullptr, width, true, true);
+        EXPECT_FALSE(ref_stream.empty());
+        EXPECT_EQ(ref_stream, split_stream) << "width " << width;
+    }
+}
+
+/** @brief picture_stats is a api test case
+ * EncApiTest.picture_stats checks the statistics passed to picture_stats_cb
+ *
+ * Test strategy: <br>
+ * Encode the same frames with and without the callback.
+ *
+ * Expected result: <br>
+ * The bitstreams match. Every input picture is reported once, the first one
+ * as a key frame, with its size, its qindex and the stage times adding up to
+ * its latency, and only references coded before it.
+ *
+ * Test coverage:
+ * picture_stats_cb, SvtAv1PictureStats.
+ */
+TEST(EncApiTest, picture_stats) {
+    std::vector<SvtAv1PictureStats> stats;
+    const std::vector<uint8_t> ref_stream = encode_frames(nullptr);
+    const std::vector<uint8_t> stats_stream =
+        encode_frames(nullptr, 64, false, false, &stats);
+    EXPECT_EQ(ref_stream, stats_stream);
+
+    std::map<uint64_t, uint64_t> decode_order;
+    uint64_t bits = 0;
+    for (const SvtAv1PictureStats &s : stats) {
+        if (s.is_overlay)
+            continue;
+        EXPECT_TRUE(decode_order.emplace(s.picture_number, s.decode_order).second)
+            << "picture " << s.picture_number << " reported twice";
+        EXPECT_EQ((int64_t)s.picture_number, s.pts);
+        EXPECT_GT(s.bits, 0u);
+        EXPECT_LE(s.qindex, 255);
+        EXPECT_EQ(s.qp, (s.qindex + 2) >> 2);
+        uint64_t stage_sum = 0;
+        for (int i = 0; i < SVT_AV1_DEADLINE_STAGES; i++)
+            stage_sum += s.stage_us[i];
+        EXPECT_EQ(s.latency_us, stage_sum);
+        bits += s.bits;
+    }
+    ASSERT_EQ(decode_order.size(), 10u);
+    EXPECT_EQ(decode_order.rbegin()->first, 9u);
+    EXPECT_LE(bits, stats_stream.size() * 8);
+    for (const SvtAv1PictureStats &s : stats) {
+        if (s.picture_number == 0) {
+            EXPECT_EQ(s.pic_type, EB_AV1_KEY_PICTURE);
+        }
+        for (int list = 0; list < 2; list++) {
+            for (int i = 0; i < s.ref_count[list]; i++) {
+                const uint64_t ref = s.ref_picture_number[list][i];
+                ASSERT_TRUE(decode_order.count(ref)) << "reference " << ref;
+                EXPECT_LT(decode_order[ref], s.decode_order);
+            }
+        }
+    }
+}
+
+/** @brief memory_budget is a api test case
+ * EncApiTest.memory_budget checks max_memory_mb limits the buffering of the
+ * encoder, and is checked against the smallest buffering at init
+ *
+ * Test strategy: <br>
+ * Encode the same frames without a budget, with a budget the encoder fits in
+ * and with a budget just below its estimate, then initialize an encoder with
+ * a budget below the smallest buffering.
+ *
+ * Expected result: <br>
+ * The budget the encoder fits in changes neither the estimate nor the
+ * bitstream. The budget below the estimate lowers the estimate and every
+ * frame is still encoded. svt_av1_enc_init() fails with the budget below the
+ * smallest buffering.
+ *
+ * Test coverage:
+ * max_memory_mb, SVT_AV1_STREAM_INFO_MEMORY_USAGE.
+ */
+TEST(EncApiTest, memory_budget) {
+    auto get_usage = [](SvtAv1MemoryUsage *usage) {
+        return [usage](EbComponentType *handle) {
+            EXPECT_EQ(EB_ErrorNone,
+                      svt_av1_enc_get_stream_info(
+                          handle, SVT_AV1_STREAM_INFO_MEMORY_USAGE, usage));
+        };
+    };
+    auto set_budget = [](uint32_t max_memory_mb) {
+        return [max_memory_mb](EbSvtAv1EncConfiguration &config) {
+            config.max_memory_mb = max_memory_mb;
+        };
+    };
+    SvtAv1MemoryUsage ref_usage, fit_usage, low_usage;
+    const std::vector<uint8_t> ref_stream = encode_frames(
+        nullptr, 64, false, false, nullptr, nullptr, get_usage(&ref_usage));
+    const uint32_t fit_mb = (uint32_t)(ref_usage.estimated_bytes >> 20) * 2 + 1;
+    const std::vector<uint8_t> fit_stream = encode_frames(nullptr,
+                                                          64,
+                                                          false,
+                                                          false,
+                                                          nullptr,
+                                                          set_budget(fit_mb),
+                                                          get_usage(&fit_usage));
+    EXPECT_EQ(ref_stream, fit_stream);
+    EXPECT_EQ(fit_usage.budget_bytes, (uint64_t)fit_mb << 20);
+    EXPECT_EQ(fit_usage.estimated_bytes, ref_usage.estimated_bytes);
+
+    const uint32_t low_mb = (uint32_t)(ref_usage.estimated_bytes >> 20);
+    const std::vector<uint8_t> low_stream = encode_frames(nullptr,
+                                                          64,
+                                                          false,
+                                                          false,
+                                                          nullptr,
+                                                          set_budget(low_mb),
+                                                          get_usage(&low_usage));
+    EXPECT_FALSE(low_stream.empty());
+    EXPECT_LE(low_usage.estimated_bytes, (uint64_t)low_mb << 20);
+    for (uint32_t i = 0; i < low_usage.pool_count; i++) {
+        EXPECT_LE(low_usage.pools[i].in_use_count,
+                  low_usage.pools[i].total_count)
+            << low_usage.pools[i].name;
+    }
+
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration config;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init_handle(&handle, nullptr, &config));
+    config.source_width = 64;
+    config.source_height = 64;
+    config.enc_mode = 10;
+    config.logical_processors = 1;
+    config.max_memory_mb = 1;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(handle, &config));
+    EXPECT_EQ(EB_ErrorInsufficientResources, svt_av1_enc_init(handle));
+    svt_av1_enc_deinit(handle);
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(handle));
+}
+
+/** Key frame checkpoint kept by encode_with_checkpoints */
+struct KeyFrameCheckpoint {
+    uint64_t picture_number;
+    uint64_t byte_offset;
+    std::vector<uint8_t> state;
+};
+
+/** Encodes the synthetic frames from first_frame on, resuming from the state
+ * when one is given, and returns the bitstream and the checkpoints of the key
+ * frames output */
+static std::vector<uint8_t> encode_with_checkpoints(
+    uint32_t first_frame, const std::vector<uint8_t> *resume_state,
+    std::vector<KeyFrameCheckpoint> &checkpoints) {
+    const uint32_t width = 64;
+    const uint32_t height = 64;
+    const uint32_t frame_count = 20;
+    SvtAv1Context context;
+    std::vector<uint8_t> stream;
+    memset(&context, 0, sizeof(context));
+
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params));
+    context.enc_params.source_width = width;
+    context.enc_params.source_height = height;
+    context.enc_params.enc_mode = 10;
+    context.enc_params.logical_processors = 1;
+    context.enc_params.intra_period_length = 7;
+    context.enc_params.intra_refresh_type = SVT_AV1_KF_REFRESH;
+    if (resume_state) {
+        context.enc_params.resume_checkpoint.buf =
+            const_cast<uint8_t *>(resume_state->data());
+        context.enc_params.resume_checkpoint.sz = resume_state->size();
+    }
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle));
+
+    SvtAv1Checkpoint checkpoint;
+    // no key frame output yet
+    EXPECT_EQ(EB_NoErrorEmptyQueue,
+              svt_av1_enc_get_stream_info(context.enc_handle,
+                                          SVT_AV1_STREAM_INFO_CHECKPOINT,
+                                          &checkpoint));
+
+    std::vector<uint8_t> luma(width * height);
+    std::vector<uint8_t> chroma(width * height / 4, 128);
+    EbSvtIOFormat frame;
+    EbBufferHeaderType input;
+    memset(&frame, 0, sizeof(frame));
+    memset(&input, 0, sizeof(input));
+    frame.luma = luma.data();
+    frame.cb = chroma.data();
+    frame.cr = chroma.data();
+    frame.y_stride = width;
+    frame.cb_stride = width / 2;
+    frame.cr_stride = width / 2;
+    input.size = sizeof(input);
+    input.p_buffer = reinterpret_cast<uint8_t *>(&frame);
+    input.n_filled_len = width * height * 3 / 2;
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+
+    for (uint32_t i = first_frame; i < frame_count; i++) {
+        for (uint32_t p = 0; p < width * height; p++)
+            luma[p] = (uint8_t)((p % width) * 2 + (p / width) + i * 3);
+        input.pts = i;
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_send_picture(context.enc_handle, &input));
+    }
+    EbBufferHeaderType eos;
+    memset(&eos, 0, sizeof(eos));
+    eos.flags = EB_BUFFERFLAG_EOS;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(context.enc_handle, &eos));
+
+    bool done = false;
+    while (!done) {
+        EbBufferHeaderType *packet = nullptr;
+        if (svt_av1_enc_get_packet(context.enc_handle, &packet, 1) !=
+            EB_ErrorNone)
+            break;
+        done = packet->flags & EB_BUFFERFLAG_EOS;
+        stream.insert(stream.end(),
+                      packet->p_buffer,
+                      packet->p_buffer + packet->n_filled_len);
+        if (packet->pic_type == EB_AV1_KEY_PICTURE) {
+            EXPECT_EQ(EB_ErrorNone,
+                      svt_av1_enc_get_stream_info(
+                          context.enc_handle,
+                          SVT_AV1_STREAM_INFO_CHECKPOINT,
+                          &checkpoint));
+            EXPECT_EQ(checkpoint.picture_number, (uint64_t)packet->pts);
+            const uint8_t *state =
+                static_cast<const uint8_t *>(checkpoint.state.buf);
+            checkpoints.push_back(
+                {checkpoint.picture_number,
+                 checkpoint.byte_offset,
+                 std::vector<uint8_t>(state, state + checkpoint.state.sz)});
+        }
+        svt_av1_enc_release_out_buffer(&packet);
+    }
+    EXPECT_TRUE(done);
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+    return stream;
+}
+
+/** @brief resume_checkpoint is a api test case
+ * EncApiTest.resume_checkpoint checks an encoder resumed from a key frame
+ * checkpoint continues the stream of the checkpointed encoder
+ *
+ * Test strategy: <br>
+ * Encode frames with closed GOP key frames and keep the checkpoint of each
+ * key frame, then resume from each checkpoint with the frames from its key
+ * frame on. Resume with a state of another configuration.
+ *
+ * Expected result: <br>
+ * The resumed bitstreams match the first one from the checkpoint offset on, a
+ * state of another configuration is rejected.
+ *
+ * Test coverage:
+ * SVT_AV1_STREAM_INFO_CHECKPOINT, resume_checkpoint.
+ */
+TEST(EncApiTest, resume_checkpoint) {
+    std::vector<KeyFrameCheckpoint> checkpoints;
+    const std::vector<uint8_t> ref_stream =
+        encode_with_checkpoints(0, nullptr, checkpoints);
+    ASSERT_GE(checkpoints.size(), 2u);
+    EXPECT_EQ(checkpoints[0].picture_number, 0u);
+    EXPECT_EQ(checkpoints[0].byte_offset, 0u);
+
+    for (const KeyFrameCheckpoint &checkpoint : checkpoints) {
+        std::vector<KeyFrameCheckpoint> resumed_checkpoints;
+        const std::vector<uint8_t> resumed_stream =
+            encode_with_checkpoints((uint32_t)checkpoint.picture_number,
+                                    &checkpoint.state,
+                                    resumed_checkpoints);
+        ASSERT_LE(checkpoint.byte_offset, ref_stream.size());
+        EXPECT_EQ(std::vector<uint8_t>(
+                      ref_stream.begin() + checkpoint.byte_offset,
+                      ref_stream.end()),
+                  resumed_stream)
+            << "resumed at " << checkpoint.picture_number;
+    }
+
+    // the state only resumes the configuration it was saved with
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params));
+    context.enc_params.source_width = 64;
+    context.enc_params.source_height = 64;
+    context.enc_params.enc_mode = 8;
+    context.enc_params.intra_period_length = 7;
+    context.enc_params.intra_refresh_type = SVT_AV1_KF_REFRESH;
+    context.enc_params.resume_checkpoint.buf = checkpoints[1].state.data();
+    context.enc_params.resume_checkpoint.sz = checkpoints[1].state.size();
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+}
+
+/** @brief sb_rate_control is a api test case
+ * EncApiTest.sb_rate_control checks the superblock rate control of CBR does
+ * not depend on the thread count and keeps the frames near their target
+ *
+ * Test strategy: <br>
+ * Encode the same low-delay CBR frames with the superblock rate control on
+ * one and on several logical processors.
+ *
+ * Expected result: <br>
+ * The bitstreams match, no inter frame takes more than twice its target and
+ * the stream stays within half again the sum of the targets.
+ *
+ * Test coverage:
+ * sb_rate_control.
+ */
+TEST(EncApiTest, sb_rate_control) {
+    auto cbr = [](uint32_t logical_processors) {
+        return [logical_processors](EbSvtAv1EncConfiguration &config) {
+            config.pred_structure = SVT_AV1_PRED_LOW_DELAY_B;
+            config.rate_control_mode = SVT_AV1_RC_MODE_CBR;
+            config.target_bit_rate = 100000;
+            config.sb_rate_control = 1;
+            config.logical_processors = logical_processors;
+        };
+    };
+    std::vector<SvtAv1PictureStats> stats;
+    const std::vector<uint8_t> ref_stream =
+        encode_frames(nullptr, 256, false, false, &stats, cbr(1));
+    const std::vector<uint8_t> mt_stream =
+        encode_frames(nullptr, 256, false, false, nullptr, cbr(4));
+    EXPECT_FALSE(ref_stream.empty());
+    EXPECT_EQ(ref_stream, mt_stream);
+
+    // the synthetic frames are cheap, so only the overshoot is bounded
+    ASSERT_EQ(stats.size(), 10u);
+    uint64_t bits = 0;
+    int64_t target_bits = 0;
+    for (const SvtAv1PictureStats &s : stats) {
+        EXPECT_GT(s.target_bits, 0) << "picture " << s.picture_number;
+        EXPECT_GT(s.bits, 0u) << "picture " << s.picture_number;
+        if (s.pic_type != EB_AV1_KEY_PICTURE) {
+            EXPECT_LE(s.bits, (uint64_t)s.target_bits * 2)
+                << "picture " << s.picture_number;
+        }
+        bits += s.bits;
+        target_bits += s.target_bits;
+    }
+    EXPECT_LE(bits, (uint64_t)target_bits * 3 / 2);
+}
+
+/** @brief pipelined_two_pass is a api test case
+ * EncApiTest.pipelined_two_pass checks the encoder with a first pass running
+ * ahead of it codes every picture and shuts down
+ *
+ * Test strategy: <br>
+ * Encode VBR frames with pipelined_two_pass.
+ *
+ * Expected result: <br>
+ * The encoder reaches EOS with every picture coded, and is deinitialized
+ * along with its first pass.
+ *
+ * Test coverage:
+ * pipelined_two_pass.
+ */
+TEST(EncApiTest, pipelined_two_pass) {
+    std::vector<SvtAv1PictureStats> stats;
+    const std::vector<uint8_t> stream = encode_frames(
+        nullptr, 64, false, false, &stats,
+        [](EbSvtAv1EncConfiguration &config) {
+            config.rate_control_mode = SVT_AV1_RC_MODE_VBR;
+            config.target_bit_rate = 100000;
+            config.pipelined_two_pass = 1;
+        });
+    EXPECT_FALSE(stream.empty());
+
+    std::set<uint64_t> pictures;
+    for (const SvtAv1PictureStats &s : stats) {
+        if (!s.is_overlay)
+            pictures.insert(s.picture_number);
+    }
+    EXPECT_EQ(pictures.size(), 10u);
+}
+
+/** @brief block_geometry_sharing is a api test case
+ * EncApiTest.block_geometry_sharing checks that the encoders of a process
+ * share the block geometry table
+ *
+ * Test strategy: <br>
+ * Initialize an encoder, then encoders using the same and another block
+ * geometry while it is initialized, and once it is deinitialized.
+ *
+ * Expected result: <br>
+ * An encoder using another geometry fails to initialize while the first one
+ * is initialized, and initializes once it is deinitialized.
+ *
+ * Test coverage:
+ * svt_av1_enc_init() of several encoders.
+ */
+TEST(EncApiTest, block_geometry_sharing) {
+    auto init_encoder = [](EbComponentType **handle, uint8_t preset) {
+        EbSvtAv1EncConfiguration config;
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_init_handle(handle, nullptr, &config));
+        config.source_width = 64;
+        config.source_height = 64;
+        config.enc_mode = preset;
+        config.logical_processors = 1;
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_set_parameter(*handle, &config));
+        return svt_av1_enc_init(*handle);
+    };
+    auto deinit_encoder = [](EbComponentType *handle) {
+        svt_av1_enc_deinit(handle);
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(handle));
+    };
+
+    EbComponentType *first = nullptr, *same = nullptr, *other = nullptr;
+    ASSERT_EQ(EB_ErrorNone, init_encoder(&first, 10));
+    EXPECT_EQ(EB_ErrorNone, init_encoder(&same, 10));
+    EXPECT_EQ(EB_ErrorBadParameter, init_encoder(&other, 0));
+    deinit_encoder(other);
+    deinit_encoder(same);
+    deinit_encoder(first);
+    EXPECT_EQ(EB_ErrorNone, init_encoder(&other, 0));
+    deinit_encoder(other);
+}
+
 }  // namespace
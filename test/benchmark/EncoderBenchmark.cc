@@ -0,0 +1,469 @@
+/*
+ * Copyright(c) 2024 Alliance for Open Media
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file EncoderBenchmark.cc
+ *
+ * @brief End-to-end encoder throughput benchmark.
+ *
+ * Encodes the synthetic DummyVideoSource over a sweep of preset x resolution x
+ * bit depth x thread count and reports, for each point, fps, CPU seconds per
+ * frame, peak RSS and the CPU time spent in each pipeline stage. The stage
+ * times are read from the encoder threads, which are named after their stage.
+ *
+ * Usage: SvtAv1EncBench [--presets 4,8,12] [--resolutions 640x360,1280x720]
+ *                       [--bit-depths 8,10] [--threads 1,0] [--frames <n>]
+ *                       [--output <report.json>] [--save-baseline <file>]
+ *                       [--baseline <file>] [--tolerance <percent>]
+ *
+ * With --baseline, fps is compared against the file written by an earlier
+ * --save-baseline run and the exit code is 1 if any point is slower by more
+ * than the tolerance. Everything runs offline, without test vectors.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "EbSvtAv1Enc.h"
+#include "DummyVideoSource.h"
+
+using svt_av1_video_source::DummyVideoSource;
+
+namespace {
+
+struct BenchPoint {
+    int preset;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bit_depth;
+    uint32_t threads;
+
+    std::string name() const {
+        return "m" + std::to_string(preset) + "_" + std::to_string(width) +
+               "x" + std::to_string(height) + "_" + std::to_string(bit_depth) +
+               "bit_lp" + std::to_string(threads);
+    }
+};
+
+struct BenchResult {
+    BenchPoint point;
+    uint32_t frames;
+    double wall_s;
+    double cpu_s;
+    uint64_t peak_rss_kb;
+    uint64_t bytes;
+    // CPU seconds per pipeline stage, keyed by thread name
+    std::map<std::string, double> stage_cpu_s;
+};
+
+double cpu_seconds() {
+#ifdef __linux__
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru))
+        return 0;
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+           (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e-6;
+#else
+    return 0;
+#endif
+}
+
+// Resets the peak RSS of the process so that each point reports its own
+// peak. Needs Linux 4.0 or newer; on failure the peak is the process peak.
+void reset_peak_rss() {
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+#endif
+}
+
+uint64_t peak_rss_kb() {
+    uint64_t kb = 0;
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f)
+        return 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+        if (!strncmp(line, "VmHWM:", 6))
+            kb = strtoull(line + 6, nullptr, 10);
+    fclose(f);
+#endif
+    return kb;
+}
+
+// CPU time of each live encoder thread, summed per thread name. Uses the
+// nanosecond run time from schedstat when available, and the tick based
+// utime + stime otherwise.
+std::map<std::string, double> stage_cpu_seconds() {
+    std::map<std::string, double> stages;
+#ifdef __linux__
+    DIR *dir = opendir("/proc/self/task");
+    if (!dir)
+        return stages;
+    const double tick_s = 1.0 / sysconf(_SC_CLK_TCK);
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.')
+            continue;
+        const std::string task = std::string("/proc/self/task/") + entry->d_name;
+        char name[64] = {0};
+        FILE *f = fopen((task + "/comm").c_str(), "r");
+        if (!f)
+            continue;
+        if (!fgets(name, sizeof(name), f))
+            name[0] = 0;
+        fclose(f);
+        name[strcspn(name, "\n")] = 0;
+        if (strncmp(name, "svt-", 4))
+            continue;
+
+        double seconds = -1;
+        f = fopen((task + "/schedstat").c_str(), "r");
+        if (f) {
+            unsigned long long run_ns;
+            if (fscanf(f, "%llu", &run_ns) == 1)
+                seconds = run_ns * 1e-9;
+            fclose(f);
+        }
+        if (seconds < 0) {
+            f = fopen((task + "/stat").c_str(), "r");
+            if (!f)
+                continue;
+            char buf[1024];
+            const size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+            fclose(f);
+            buf[len] = 0;
+            // Fields after the command name, which is in parentheses
+            const char *p = strrchr(buf, ')');
+            unsigned long long utime, stime;
+            if (!p ||
+                sscanf(p + 1,
+                       " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu",
+                       &utime,
+                       &stime) != 2)
+                continue;
+            seconds = (utime + stime) * tick_s;
+        }
+        stages[name + 4] += seconds;
+    }
+    closedir(dir);
+#endif
+    return stages;
+}
+
+bool run_point(const BenchPoint &point, uint32_t frames, BenchResult &result) {
+    DummyVideoSource source(
+        point.bit_depth > 8 ? IMG_FMT_420P10_PACKED : IMG_FMT_420,
+        point.width,
+        point.height,
+        (uint8_t)point.bit_depth);
+    if (source.open_source(0, frames) != EB_ErrorNone)
+        return false;
+
+    EbComponentType *handle = nullptr;
+    EbSvtAv1EncConfiguration config;
+    if (svt_av1_enc_init_handle(&handle, nullptr, &config) != EB_ErrorNone)
+        return false;
+    config.enc_mode = (int8_t)point.preset;
+    config.logical_processors = point.threads;
+    config.source_width = source.get_width_with_padding();
+    config.source_height = source.get_height_with_padding();
+    config.encoder_bit_depth = point.bit_depth;
+    config.encoder_color_format = EB_YUV420;
+    if (svt_av1_enc_set_parameter(handle, &config) != EB_ErrorNone ||
+        svt_av1_enc_init(handle) != EB_ErrorNone) {
+        svt_av1_enc_deinit_handle(handle);
+        return false;
+    }
+
+    reset_peak_rss();
+    const double cpu_start = cpu_seconds();
+    const auto wall_start = std::chrono::steady_clock::now();
+
+    // DummyVideoSource does not report a frame size, compute it for 4:2:0
+    const uint32_t frame_size = source.get_width_with_padding() *
+                                source.get_height_with_padding() * 3 / 2 *
+                                (point.bit_depth > 8 ? 2 : 1);
+    EbBufferHeaderType input;
+    memset(&input, 0, sizeof(input));
+    input.size = sizeof(EbBufferHeaderType);
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+    bool ok = true, eos = false;
+    uint32_t sent = 0;
+    result.bytes = 0;
+    while (!eos) {
+        if (sent <= frames) {
+            EbSvtIOFormat *frame = sent < frames ? source.get_next_frame()
+                                                 : nullptr;
+            if (frame) {
+                input.p_buffer = (uint8_t *)frame;
+                input.n_filled_len = frame_size;
+                input.flags = 0;
+                input.pts = sent;
+            } else {
+                input.p_buffer = nullptr;
+                input.n_filled_len = 0;
+                input.flags = EB_BUFFERFLAG_EOS;
+            }
+            if (svt_av1_enc_send_picture(handle, &input) != EB_ErrorNone) {
+                ok = false;
+                break;
+            }
+            sent++;
+        }
+        const uint8_t done = sent > frames;
+        for (;;) {
+            EbBufferHeaderType *out = nullptr;
+            const EbErrorType err = svt_av1_enc_get_packet(handle, &out, done);
+            if (err == EB_NoErrorEmptyQueue)
+                break;
+            if (err != EB_ErrorNone) {
+                ok = false;
+                eos = true;
+                break;
+            }
+            result.bytes += out->n_filled_len;
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            svt_av1_enc_release_out_buffer(&out);
+            if (eos || !done)
+                break;
+        }
+    }
+
+    result.wall_s = std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - wall_start)
+                        .count();
+    result.cpu_s = cpu_seconds() - cpu_start;
+    result.peak_rss_kb = peak_rss_kb();
+    // Read before deinit, which joins the encoder threads
+    result.stage_cpu_s = stage_cpu_seconds();
+    result.point = point;
+    result.frames = frames;
+
+    svt_av1_enc_deinit(handle);
+    svt_av1_enc_deinit_handle(handle);
+    source.close_source();
+    return ok;
+}
+
+std::vector<std::string> split(const std::string &list) {
+    std::vector<std::string> items;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
+        if (end > start)
+            items.push_back(list.substr(start, end - start));
+        start = end + 1;
+    }
+    return items;
+}
+
+std::map<std::string, double> load_baseline(const char *path) {
+    std::map<std::string, double> fps;
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return fps;
+    char name[128];
+    double value;
+    while (fscanf(f, "%127s %lf", name, &value) == 2)
+        fps[name] = value;
+    fclose(f);
+    return fps;
+}
+
+void write_report(FILE *f, const std::vector<BenchResult> &results,
+                  const std::map<std::string, double> &baseline) {
+    fprintf(f, "{\n  \"version\": \"%s\",\n", svt_av1_get_version());
+    fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        const double fps = r.frames / r.wall_s;
+        fprintf(f,
+                "    {\"name\": \"%s\", \"preset\": %d, \"width\": %u, "
+                "\"height\": %u, \"bit_depth\": %u, \"threads\": %u, "
+                "\"frames\": %u, \"fps\": %.3f, \"cpu_s_per_frame\": %.4f, "
+                "\"peak_rss_kb\": %llu, \"bytes\": %llu",
+                r.point.name().c_str(),
+                r.point.preset,
+                r.point.width,
+                r.point.height,
+                r.point.bit_depth,
+                r.point.threads,
+                r.frames,
+                fps,
+                r.cpu_s / r.frames,
+                (unsigned long long)r.peak_rss_kb,
+                (unsigned long long)r.bytes);
+        const auto base = baseline.find(r.point.name());
+        if (base != baseline.end())
+            fprintf(f,
+                    ", \"baseline_fps\": %.3f, \"fps_ratio\": %.4f",
+                    base->second,
+                    fps / base->second);
+        fprintf(f, ",\n     \"stage_cpu_s\": {");
+        bool first = true;
+        for (const auto &s : r.stage_cpu_s) {
+            fprintf(f,
+                    "%s\"%s\": %.4f",
+                    first ? "" : ", ",
+                    s.first.c_str(),
+                    s.second);
+            first = false;
+        }
+        fprintf(f, "}}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [--presets <list>] [--resolutions <WxH,...>] "
+            "[--bit-depths <list>] [--threads <list>] [--frames <n>] "
+            "[--output <file>] [--save-baseline <file>] [--baseline <file>] "
+            "[--tolerance <percent>]\n",
+            prog);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string presets = "8", resolutions = "640x360", bit_depths = "8",
+                threads = "1";
+    uint32_t frames = 30;
+    double tolerance = 5.0;
+    const char *output = nullptr;
+    const char *save_baseline = nullptr;
+    const char *baseline_path = nullptr;
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (!strcmp(argv[i], "--presets") && has_value)
+            presets = argv[++i];
+        else if (!strcmp(argv[i], "--resolutions") && has_value)
+            resolutions = argv[++i];
+        else if (!strcmp(argv[i], "--bit-depths") && has_value)
+            bit_depths = argv[++i];
+        else if (!strcmp(argv[i], "--threads") && has_value)
+            threads = argv[++i];
+        else if (!strcmp(argv[i], "--frames") && has_value)
+            frames = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--output") && has_value)
+            output = argv[++i];
+        else if (!strcmp(argv[i], "--save-baseline") && has_value)
+            save_baseline = argv[++i];
+        else if (!strcmp(argv[i], "--baseline") && has_value)
+            baseline_path = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance") && has_value)
+            tolerance = atof(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<BenchPoint> points;
+    for (const std::string &p : split(presets))
+        for (const std::string &res : split(resolutions))
+            for (const std::string &bd : split(bit_depths))
+                for (const std::string &lp : split(threads)) {
+                    BenchPoint point;
+                    point.preset = atoi(p.c_str());
+                    if (sscanf(res.c_str(),
+                               "%ux%u",
+                               &point.width,
+                               &point.height) != 2) {
+                        fprintf(stderr, "Invalid resolution %s\n", res.c_str());
+                        return 1;
+                    }
+                    point.bit_depth = (uint32_t)atoi(bd.c_str());
+                    point.threads = (uint32_t)atoi(lp.c_str());
+                    points.push_back(point);
+                }
+    if (points.empty() || frames == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const std::map<std::string, double> baseline =
+        baseline_path ? load_baseline(baseline_path)
+                      : std::map<std::string, double>();
+    if (baseline_path && baseline.empty()) {
+        fprintf(stderr, "Cannot read baseline %s\n", baseline_path);
+        return 1;
+    }
+
+    std::vector<BenchResult> results;
+    int regressions = 0;
+    for (const BenchPoint &point : points) {
+        BenchResult r;
+        if (!run_point(point, frames, r)) {
+            fprintf(stderr, "%s: encode failed\n", point.name().c_str());
+            return 1;
+        }
+        const double fps = r.frames / r.wall_s;
+        fprintf(stderr,
+                "%-28s %8.2f fps %8.4f cpu-s/frame %8llu KiB",
+                point.name().c_str(),
+                fps,
+                r.cpu_s / r.frames,
+                (unsigned long long)r.peak_rss_kb);
+        const auto base = baseline.find(point.name());
+        if (base != baseline.end()) {
+            const double change = (fps / base->second - 1) * 100;
+            const bool regressed = change < -tolerance;
+            regressions += regressed;
+            fprintf(stderr,
+                    " %+6.1f%% vs baseline%s",
+                    change,
+                    regressed ? " REGRESSION" : "");
+        }
+        fprintf(stderr, "\n");
+        results.push_back(r);
+    }
+
+    FILE *f = output ? fopen(output, "w") : stdout;
+    if (!f) {
+        fprintf(stderr, "Cannot open %s\n", output);
+        return 1;
+    }
+    write_report(f, results, baseline);
+    if (output)
+        fclose(f);
+
+    if (save_baseline) {
+        f = fopen(save_baseline, "w");
+        if (!f) {
+            fprintf(stderr, "Cannot open %s\n", save_baseline);
+            return 1;
+        }
+        for (const BenchResult &r : results)
+            fprintf(f, "%s %.3f\n", r.point.name().c_str(), r.frames / r.wall_s);
+        fclose(f);
+    }
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,750 @@
+/*
+ * Copyright(c) 2024 Alliance for Open Media
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file KernelBenchmark.cc
+ *
+ * @brief Micro-benchmark of the RTCD kernels.
+ *
+ * Every registered kernel is timed for each block size and for each ISA level
+ * supported by both the build and the CPU, by re-running the RTCD setup with
+ * the flags of that level. The results (ns/call, throughput and speedup over
+ * C) are written as JSON, to stdout or to the file given with --output.
+ *
+ * Usage: SvtAv1KernelBench [--filter <substring>] [--isa <name,...>]
+ *                          [--min-time-ms <ms>] [--repeat <n>]
+ *                          [--output <file.json>] [--list]
+ *
+ * A kernel is only re-timed at a level if the level changes the function the
+ * RTCD pointer resolves to; otherwise the result of the lower level is
+ * reported with "inherited_from" set.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
+#include "definitions.h"
+#include "cdef.h"
+#include "convolve.h"
+#include "inter_prediction.h"
+#include "utility.h"
+
+namespace {
+
+const int kStride = 2 * MAX_SB_SIZE;
+const int kBufRows = 2 * MAX_SB_SIZE;
+
+struct Buffers {
+    uint8_t *src8;
+    uint8_t *ref8;
+    uint8_t *dst8;
+    int16_t *residual;
+    int32_t *coeff;
+    int32_t *coeff2;
+    uint16_t *dst16;
+    uint16_t *cdef_in;
+    int16_t *scan;
+    int16_t *iscan;
+};
+
+struct KernelCase {
+    std::string name;
+    std::string family;
+    int width;
+    int height;
+    // Share of the family's calls made with this block size, used for the
+    // per-family weighted results
+    double weight;
+    // Current target of the RTCD pointer, to detect levels that do not
+    // specialize the kernel
+    std::function<const void *()> impl;
+    // Runs the kernel iters times and returns a value depending on the
+    // results so that the calls cannot be optimized away
+    std::function<uint64_t(Buffers &, uint64_t iters)> run;
+};
+
+struct IsaLevel {
+    const char *name;
+    EbCpuFlags flags;
+};
+
+struct Result {
+    const KernelCase *kc;
+    const char *isa;
+    const char *inherited_from;
+    double ns_per_call;
+};
+
+// Weight of a block size within a family. The MD evaluates many more small
+// blocks than large ones; this roughly follows the share of calls per block
+// area observed at the default preset.
+double size_weight(int w, int h) {
+    const int area = w * h;
+    if (area <= 32)
+        return 0.20;
+    if (area <= 128)
+        return 0.30;
+    if (area <= 512)
+        return 0.25;
+    if (area <= 2048)
+        return 0.15;
+    if (area <= 4096)
+        return 0.07;
+    return 0.03;
+}
+
+template <typename Fn>
+std::function<const void *()> impl_of(Fn *const *slot) {
+    return [slot]() { return reinterpret_cast<const void *>(*slot); };
+}
+
+typedef uint32_t (*SadFn)(const uint8_t *, int, const uint8_t *, int);
+typedef unsigned int (*VarianceFn)(const uint8_t *, int, const uint8_t *, int,
+                                   unsigned int *);
+typedef void (*FwdTxfmFn)(int16_t *, int32_t *, uint32_t, TxType, uint8_t);
+typedef void (*InvTxfmFn)(const int32_t *, uint16_t *, int32_t, uint16_t *,
+                          int32_t, TxType, int32_t);
+
+void add_sad(std::vector<KernelCase> &cases, const char *name, SadFn *slot,
+             int w, int h) {
+    cases.push_back({name,
+                     "sad",
+                     w,
+                     h,
+                     size_weight(w, h),
+                     impl_of(slot),
+                     [slot](Buffers &b, uint64_t iters) {
+                         const SadFn fn = *slot;
+                         uint64_t sum = 0;
+                         for (uint64_t i = 0; i < iters; i++)
+                             sum += fn(b.src8, kStride, b.ref8 + (i & 7),
+                                       kStride);
+                         return sum;
+                     }});
+}
+
+void add_variance(std::vector<KernelCase> &cases, const char *name,
+                  VarianceFn *slot, int w, int h) {
+    cases.push_back({name,
+                     "variance",
+                     w,
+                     h,
+                     size_weight(w, h),
+                     impl_of(slot),
+                     [slot](Buffers &b, uint64_t iters) {
+                         const VarianceFn fn = *slot;
+                         uint64_t sum = 0;
+                         unsigned int sse;
+                         for (uint64_t i = 0; i < iters; i++)
+                             sum += fn(b.src8, kStride, b.ref8 + (i & 7),
+                                       kStride, &sse);
+                         return sum + sse;
+                     }});
+}
+
+void add_fwd_txfm(std::vector<KernelCase> &cases, const char *name,
+                  FwdTxfmFn *slot, int w, int h) {
+    cases.push_back({name,
+                     "fwd_txfm2d",
+                     w,
+                     h,
+                     size_weight(w, h),
+                     impl_of(slot),
+                     [slot](Buffers &b, uint64_t iters) {
+                         const FwdTxfmFn fn = *slot;
+                         for (uint64_t i = 0; i < iters; i++)
+                             fn(b.residual, b.coeff, kStride, DCT_DCT, 8);
+                         return (uint64_t)b.coeff[0];
+                     }});
+}
+
+void add_inv_txfm(std::vector<KernelCase> &cases, const char *name,
+                  InvTxfmFn *slot, int w, int h) {
+    cases.push_back({name,
+                     "inv_txfm2d_add",
+                     w,
+                     h,
+                     size_weight(w, h),
+                     impl_of(slot),
+                     [slot](Buffers &b, uint64_t iters) {
+                         const InvTxfmFn fn = *slot;
+                         for (uint64_t i = 0; i < iters; i++)
+                             fn(b.coeff2,
+                                b.dst16,
+                                kStride,
+                                b.dst16,
+                                kStride,
+                                DCT_DCT,
+                                10);
+                         return (uint64_t)b.dst16[0];
+                     }});
+}
+
+#define SAD_CASE(w, h) add_sad(cases, "svt_aom_sad" #w "x" #h, &svt_aom_sad##w##x##h, w, h)
+#define VAR_CASE(w, h) \
+    add_variance(cases, "svt_aom_variance" #w "x" #h, &svt_aom_variance##w##x##h, w, h)
+#define FWD_CASE(w, h) \
+    add_fwd_txfm(cases, "svt_av1_fwd_txfm2d_" #w "x" #h, &svt_av1_fwd_txfm2d_##w##x##h, w, h)
+#define INV_CASE(w, h) \
+    add_inv_txfm(        \
+        cases, "svt_av1_inv_txfm2d_add_" #w "x" #h, &svt_av1_inv_txfm2d_add_##w##x##h, w, h)
+
+std::vector<KernelCase> build_cases() {
+    std::vector<KernelCase> cases;
+
+    SAD_CASE(4, 4);
+    SAD_CASE(4, 8);
+    SAD_CASE(8, 4);
+    SAD_CASE(8, 8);
+    SAD_CASE(8, 16);
+    SAD_CASE(16, 8);
+    SAD_CASE(16, 16);
+    SAD_CASE(16, 32);
+    SAD_CASE(32, 16);
+    SAD_CASE(32, 32);
+    SAD_CASE(64, 64);
+    SAD_CASE(128, 128);
+
+    VAR_CASE(4, 4);
+    VAR_CASE(8, 8);
+    VAR_CASE(8, 16);
+    VAR_CASE(16, 8);
+    VAR_CASE(16, 16);
+    VAR_CASE(32, 32);
+    VAR_CASE(64, 64);
+    VAR_CASE(128, 128);
+
+    FWD_CASE(4, 4);
+    FWD_CASE(8, 8);
+    FWD_CASE(8, 16);
+    FWD_CASE(16, 8);
+    FWD_CASE(16, 16);
+    FWD_CASE(32, 32);
+    FWD_CASE(64, 64);
+
+    INV_CASE(4, 4);
+    INV_CASE(8, 8);
+    INV_CASE(16, 16);
+    INV_CASE(32, 32);
+    INV_CASE(64, 64);
+
+    static const int sizes[][2] = {
+        {4, 4}, {8, 8}, {16, 16}, {32, 32}, {64, 64}, {128, 128}};
+    for (const auto &s : sizes) {
+        const int w = s[0], h = s[1];
+        const std::string dim = std::to_string(w) + "x" + std::to_string(h);
+        cases.push_back({"svt_nxm_sad_kernel_" + dim,
+                         "nxm_sad",
+                         w,
+                         h,
+                         size_weight(w, h),
+                         impl_of(&svt_nxm_sad_kernel),
+                         [w, h](Buffers &b, uint64_t iters) {
+                             uint64_t sum = 0;
+                             for (uint64_t i = 0; i < iters; i++)
+                                 sum += svt_nxm_sad_kernel(b.src8,
+                                                           kStride,
+                                                           b.ref8 + (i & 7),
+                                                           kStride,
+                                                           h,
+                                                           w);
+                             return sum;
+                         }});
+        cases.push_back({"svt_residual_kernel8bit_" + dim,
+                         "residual",
+                         w,
+                         h,
+                         size_weight(w, h),
+                         impl_of(&svt_residual_kernel8bit),
+                         [w, h](Buffers &b, uint64_t iters) {
+                             for (uint64_t i = 0; i < iters; i++)
+                                 svt_residual_kernel8bit(b.src8,
+                                                         kStride,
+                                                         b.ref8,
+                                                         kStride,
+                                                         b.residual,
+                                                         kStride,
+                                                         w,
+                                                         h);
+                             return (uint64_t)b.residual[0];
+                         }});
+        cases.push_back({"svt_spatial_full_distortion_kernel_" + dim,
+                         "spatial_full_distortion",
+                         w,
+                         h,
+                         size_weight(w, h),
+                         impl_of(&svt_spatial_full_distortion_kernel),
+                         [w, h](Buffers &b, uint64_t iters) {
+                             uint64_t sum = 0;
+                             for (uint64_t i = 0; i < iters; i++)
+                                 sum += svt_spatial_full_distortion_kernel(
+                                     b.src8, 0, kStride, b.ref8, (int32_t)(i & 7), kStride, w, h);
+                             return sum;
+                         }});
+        if (w <= 64) {
+            cases.push_back({"svt_aom_satd_" + dim,
+                             "satd",
+                             w,
+                             h,
+                             size_weight(w, h),
+                             impl_of(&svt_aom_satd),
+                             [w, h](Buffers &b, uint64_t iters) {
+                                 uint64_t sum = 0;
+                                 for (uint64_t i = 0; i < iters; i++)
+                                     sum += svt_aom_satd(b.coeff2, w * h);
+                                 return sum;
+                             }});
+            cases.push_back({"svt_aom_quantize_b_" + dim,
+                             "quantize_b",
+                             w,
+                             h,
+                             size_weight(w, h),
+                             impl_of(&svt_aom_quantize_b),
+                             [w, h](Buffers &b, uint64_t iters) {
+                                 // qindex ~128 for 8-bit: DC/AC quant step 96/104
+                                 static const int16_t zbin[2] = {58, 62};
+                                 static const int16_t round[2] = {38, 41};
+                                 static const int16_t quant[2] = {-10923, -26214};
+                                 static const int16_t shift[2] = {16384, 16384};
+                                 static const int16_t dequant[2] = {96, 104};
+                                 uint16_t eob = 0;
+                                 uint64_t sum = 0;
+                                 for (uint64_t i = 0; i < iters; i++) {
+                                     svt_aom_quantize_b(b.coeff2,
+                                                        w * h,
+                                                        zbin,
+                                                        round,
+                                                        quant,
+                                                        shift,
+                                                        b.coeff,
+                                                        b.coeff + 64 * 64,
+                                                        dequant,
+                                                        &eob,
+                                                        b.scan,
+                                                        b.iscan,
+                                                        NULL,
+                                                        NULL,
+                                                        w * h > 256 ? 1 : 0);
+                                     sum += eob;
+                                 }
+                                 return sum;
+                             }});
+            cases.push_back({"svt_av1_convolve_2d_sr_" + dim,
+                             "convolve_2d_sr",
+                             w,
+                             h,
+                             size_weight(w, h),
+                             impl_of(&svt_av1_convolve_2d_sr),
+                             [w, h](Buffers &b, uint64_t iters) {
+                                 InterpFilterParams fx = av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR,
+                                                                                                      w);
+                                 InterpFilterParams fy = av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR,
+                                                                                                      h);
+                                 ConvolveParams conv_params = get_conv_params_no_round(0, 0, 0, NULL, 0, 0, 8);
+                                 for (uint64_t i = 0; i < iters; i++)
+                                     svt_av1_convolve_2d_sr(b.ref8 + 8 * kStride + 8,
+                                                            kStride,
+                                                            b.dst8,
+                                                            kStride,
+                                                            w,
+                                                            h,
+                                                            &fx,
+                                                            &fy,
+                                                            8,
+                                                            8,
+                                                            &conv_params);
+                                 return (uint64_t)b.dst8[0];
+                             }});
+        }
+    }
+
+    cases.push_back({"svt_cdef_filter_block_8x8",
+                     "cdef_filter_block",
+                     8,
+                     8,
+                     1.0,
+                     impl_of(&svt_cdef_filter_block),
+                     [](Buffers &b, uint64_t iters) {
+                         for (uint64_t i = 0; i < iters; i++)
+                             svt_cdef_filter_block(b.dst8,
+                                                   NULL,
+                                                   8,
+                                                   b.cdef_in + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER,
+                                                   4,
+                                                   1,
+                                                   (int32_t)(i & 7),
+                                                   5,
+                                                   3,
+                                                   BLOCK_8X8,
+                                                   0,
+                                                   1);
+                         return (uint64_t)b.dst8[0];
+                     }});
+    return cases;
+}
+
+EbCpuFlags available_cpu_flags() {
+#if defined(ARCH_X86_64) || defined(ARCH_AARCH64)
+    return svt_aom_get_cpu_flags_to_use();
+#else
+    return 0;
+#endif
+}
+
+std::vector<IsaLevel> supported_isa_levels() {
+    std::vector<IsaLevel> levels;
+    levels.push_back({"c", 0});
+#if defined(ARCH_X86_64)
+    static const struct {
+        const char *name;
+        EbCpuFlags flags;
+    } x86[] = {
+        {"sse2", EB_CPU_FLAGS_MMX | EB_CPU_FLAGS_SSE | EB_CPU_FLAGS_SSE2},
+        {"sse3", EB_CPU_FLAGS_SSE3},
+        {"ssse3", EB_CPU_FLAGS_SSSE3},
+        {"sse4_1", EB_CPU_FLAGS_SSE4_1},
+        {"sse4_2", EB_CPU_FLAGS_SSE4_2},
+        {"avx", EB_CPU_FLAGS_AVX},
+        {"avx2", EB_CPU_FLAGS_AVX2},
+        {"avx512",
+         EB_CPU_FLAGS_AVX512F | EB_CPU_FLAGS_AVX512CD | EB_CPU_FLAGS_AVX512DQ |
+             EB_CPU_FLAGS_AVX512BW | EB_CPU_FLAGS_AVX512VL},
+    };
+    const EbCpuFlags available = available_cpu_flags();
+    EbCpuFlags flags = 0;
+    for (const auto &l : x86) {
+        flags |= l.flags;
+        if ((flags & available) != flags)
+            break;
+        levels.push_back({l.name, flags});
+    }
+#elif defined(ARCH_AARCH64)
+    static const struct {
+        const char *name;
+        EbCpuFlags flags;
+    } arm[] = {
+        {"neon", EB_CPU_FLAGS_NEON},
+        {"arm_crc32", EB_CPU_FLAGS_ARM_CRC32},
+        {"neon_dotprod", EB_CPU_FLAGS_NEON_DOTPROD},
+        {"neon_i8mm", EB_CPU_FLAGS_NEON_I8MM},
+        {"sve", EB_CPU_FLAGS_SVE},
+        {"sve2", EB_CPU_FLAGS_SVE2},
+    };
+    const EbCpuFlags available = available_cpu_flags();
+    EbCpuFlags flags = 0;
+    for (const auto &l : arm) {
+        flags |= l.flags;
+        if ((flags & available) != flags)
+            break;
+        levels.push_back({l.name, flags});
+    }
+#endif
+    return levels;
+}
+
+void setup_rtcd(EbCpuFlags flags) {
+    svt_aom_setup_common_rtcd_internal(flags);
+    svt_aom_setup_rtcd_internal(flags);
+}
+
+volatile uint64_t g_sink;
+
+// Doubles the iteration count until one batch lasts at least min_time_ms,
+// then keeps the fastest of repeat batches
+double time_kernel(const KernelCase &kc, Buffers &b, double min_time_ms,
+                   int repeat) {
+    typedef std::chrono::steady_clock Clock;
+    uint64_t iters = 1;
+    double best_ns = 0;
+    for (;;) {
+        const Clock::time_point start = Clock::now();
+        g_sink = g_sink + kc.run(b, iters);
+        const double ns =
+            std::chrono::duration<double, std::nano>(Clock::now() - start)
+                .count();
+        if (ns >= min_time_ms * 1e6 || iters >= (1ull << 40)) {
+            best_ns = ns;
+            break;
+        }
+        iters *= 2;
+    }
+    for (int r = 1; r < repeat; r++) {
+        const Clock::time_point start = Clock::now();
+        g_sink = g_sink + kc.run(b, iters);
+        const double ns =
+            std::chrono::duration<double, std::nano>(Clock::now() - start)
+                .count();
+        if (ns < best_ns)
+            best_ns = ns;
+    }
+    return best_ns / (double)iters;
+}
+
+void init_buffers(Buffers &b) {
+    b.src8 = (uint8_t *)svt_aom_memalign(64, kStride * kBufRows);
+    b.ref8 = (uint8_t *)svt_aom_memalign(64, kStride * kBufRows);
+    b.dst8 = (uint8_t *)svt_aom_memalign(64, kStride * kBufRows);
+    b.residual = (int16_t *)svt_aom_memalign(
+        64, kStride * kBufRows * sizeof(*b.residual));
+    b.coeff = (int32_t *)svt_aom_memalign(64, 2 * 64 * 64 * sizeof(*b.coeff));
+    b.coeff2 = (int32_t *)svt_aom_memalign(64, 64 * 64 * sizeof(*b.coeff2));
+    b.dst16 = (uint16_t *)svt_aom_memalign(
+        64, kStride * kBufRows * sizeof(*b.dst16));
+    b.cdef_in = (uint16_t *)svt_aom_memalign(
+        64, CDEF_INBUF_SIZE * sizeof(*b.cdef_in));
+    b.scan = (int16_t *)svt_aom_memalign(64, 64 * 64 * sizeof(*b.scan));
+    b.iscan = (int16_t *)svt_aom_memalign(64, 64 * 64 * sizeof(*b.iscan));
+
+    // Natural-image-like content: a smooth gradient plus a small amount of
+    // noise, with the reference a noisy copy of the source
+    uint32_t seed = 0x12345678;
+    for (int i = 0; i < kStride * kBufRows; i++) {
+        seed = seed * 1103515245 + 12345;
+        const int x = i % kStride, y = i / kStride;
+        const int base = (x + 2 * y) & 0xff;
+        b.src8[i] = (uint8_t)CLIP3(0, 255, base + (int)((seed >> 16) & 7) - 4);
+        b.ref8[i] = (uint8_t)CLIP3(0, 255, base + (int)((seed >> 20) & 15) - 8);
+        b.dst8[i] = b.ref8[i];
+        b.residual[i] = (int16_t)(b.src8[i] - b.ref8[i]);
+        b.dst16[i] = (uint16_t)(b.ref8[i] << 2);
+    }
+    for (int i = 0; i < 64 * 64; i++) {
+        seed = seed * 1103515245 + 12345;
+        // Sparse coefficients with most of the energy at low frequencies
+        b.coeff2[i] = (i < 64 || (seed >> 24) < 16)
+            ? (int32_t)((seed >> 8) & 0x3ff) - 512
+            : 0;
+        b.scan[i] = b.iscan[i] = (int16_t)i;
+    }
+    memset(b.coeff, 0, 2 * 64 * 64 * sizeof(*b.coeff));
+    for (int i = 0; i < CDEF_INBUF_SIZE; i++)
+        b.cdef_in[i] = b.ref8[i % (kStride * kBufRows)];
+}
+
+void free_buffers(Buffers &b) {
+    svt_aom_free(b.src8);
+    svt_aom_free(b.ref8);
+    svt_aom_free(b.dst8);
+    svt_aom_free(b.residual);
+    svt_aom_free(b.coeff);
+    svt_aom_free(b.coeff2);
+    svt_aom_free(b.dst16);
+    svt_aom_free(b.cdef_in);
+    svt_aom_free(b.scan);
+    svt_aom_free(b.iscan);
+}
+
+bool isa_selected(const std::string &list, const char *isa) {
+    if (list.empty())
+        return true;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos)
+            end = list.size();
+        if (list.compare(start, end - start, isa) == 0)
+            return true;
+        start = end + 1;
+    }
+    return false;
+}
+
+void write_json(FILE *f, const std::vector<Result> &results,
+                const std::vector<IsaLevel> &levels, double min_time_ms,
+                int repeat) {
+    fprintf(f, "{\n");
+    fprintf(f,
+            "  \"cpu_flags\": \"0x%llx\",\n",
+            (unsigned long long)available_cpu_flags());
+    fprintf(f, "  \"min_time_ms\": %g,\n", min_time_ms);
+    fprintf(f, "  \"repeat\": %d,\n", repeat);
+    fprintf(f, "  \"isa_levels\": [");
+    for (size_t i = 0; i < levels.size(); i++)
+        fprintf(f, "%s\"%s\"", i ? ", " : "", levels[i].name);
+    fprintf(f, "],\n");
+
+    fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        double c_ns = 0;
+        for (const Result &c : results)
+            if (c.kc == r.kc && !strcmp(c.isa, "c"))
+                c_ns = c.ns_per_call;
+        const double pixels = (double)r.kc->width * r.kc->height;
+        fprintf(f,
+                "    {\"kernel\": \"%s\", \"family\": \"%s\", \"width\": %d, "
+                "\"height\": %d, \"isa\": \"%s\", \"ns_per_call\": %.3f, "
+                "\"mpixels_per_s\": %.2f, \"speedup_vs_c\": %s",
+                r.kc->name.c_str(),
+                r.kc->family.c_str(),
+                r.kc->width,
+                r.kc->height,
+                r.isa,
+                r.ns_per_call,
+                pixels * 1e3 / r.ns_per_call,
+                c_ns > 0 ? std::to_string(c_ns / r.ns_per_call).c_str()
+                         : "null");
+        if (r.inherited_from)
+            fprintf(f, ", \"inherited_from\": \"%s\"", r.inherited_from);
+        fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ],\n");
+
+    // Per family and ISA, the cost of a call drawn from the block-size
+    // distribution of the family
+    std::vector<std::string> families;
+    for (const Result &r : results) {
+        bool found = false;
+        for (const std::string &fam : families)
+            found |= fam == r.kc->family;
+        if (!found)
+            families.push_back(r.kc->family);
+    }
+    fprintf(f, "  \"families\": [\n");
+    bool first = true;
+    for (const std::string &fam : families) {
+        for (const IsaLevel &l : levels) {
+            double w_sum = 0, ns = 0, c_ns = 0;
+            for (const Result &r : results) {
+                if (r.kc->family != fam)
+                    continue;
+                if (!strcmp(r.isa, l.name)) {
+                    w_sum += r.kc->weight;
+                    ns += r.kc->weight * r.ns_per_call;
+                }
+                if (!strcmp(r.isa, "c"))
+                    c_ns += r.kc->weight * r.ns_per_call;
+            }
+            if (w_sum == 0)
+                continue;
+            fprintf(f,
+                    "%s    {\"family\": \"%s\", \"isa\": \"%s\", "
+                    "\"weighted_ns_per_call\": %.3f, "
+                    "\"weighted_speedup_vs_c\": %s}",
+                    first ? "" : ",\n",
+                    fam.c_str(),
+                    l.name,
+                    ns / w_sum,
+                    c_ns > 0 ? std::to_string(c_ns / ns).c_str() : "null");
+            first = false;
+        }
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+
+void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [--filter <substring>] [--isa <name,...>] "
+            "[--min-time-ms <ms>] [--repeat <n>] [--output <file.json>] "
+            "[--list]\n",
+            prog);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::string filter, isa_list;
+    const char *output = NULL;
+    double min_time_ms = 20;
+    int repeat = 3;
+    bool list_only = false;
+    for (int i = 1; i < argc; i++) {
+        const bool has_value = i + 1 < argc;
+        if (!strcmp(argv[i], "--filter") && has_value)
+            filter = argv[++i];
+        else if (!strcmp(argv[i], "--isa") && has_value)
+            isa_list = argv[++i];
+        else if (!strcmp(argv[i], "--min-time-ms") && has_value)
+            min_time_ms = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--repeat") && has_value)
+            repeat = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--output") && has_value)
+            output = argv[++i];
+        else if (!strcmp(argv[i], "--list"))
+            list_only = true;
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (min_time_ms <= 0 || repeat < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Set up the C level first so that every RTCD pointer is valid
+    setup_rtcd(0);
+    const std::vector<KernelCase> all_cases = build_cases();
+    std::vector<const KernelCase *> cases;
+    for (const KernelCase &kc : all_cases)
+        if (filter.empty() || kc.name.find(filter) != std::string::npos ||
+            kc.family.find(filter) != std::string::npos)
+            cases.push_back(&kc);
+    const std::vector<IsaLevel> levels = supported_isa_levels();
+
+    if (list_only) {
+        for (const KernelCase *kc : cases)
+            printf("%s\n", kc->name.c_str());
+        return 0;
+    }
+
+    Buffers b;
+    init_buffers(b);
+    std::vector<Result> results;
+    // Function timed at the previous selected level, per case
+    std::vector<const void *> last_impl(cases.size(), NULL);
+    std::vector<size_t> last_result(cases.size(), 0);
+    for (const IsaLevel &l : levels) {
+        // C is always timed as the speedup reference
+        if (l.flags && !isa_selected(isa_list, l.name))
+            continue;
+        setup_rtcd(l.flags);
+        for (size_t i = 0; i < cases.size(); i++) {
+            const void *impl = cases[i]->impl();
+            if (impl == last_impl[i]) {
+                Result r = results[last_result[i]];
+                r.inherited_from = r.inherited_from ? r.inherited_from : r.isa;
+                r.isa = l.name;
+                results.push_back(r);
+                continue;
+            }
+            const double ns = time_kernel(*cases[i], b, min_time_ms, repeat);
+            results.push_back({cases[i], l.name, NULL, ns});
+            last_impl[i] = impl;
+            last_result[i] = results.size() - 1;
+            fprintf(stderr,
+                    "%-44s %-8s %10.2f ns/call\n",
+                    cases[i]->name.c_str(),
+                    l.name,
+                    ns);
+        }
+    }
+    free_buffers(b);
+
+    FILE *f = output ? fopen(output, "w") : stdout;
+    if (!f) {
+        fprintf(stderr, "Cannot open %s\n", output);
+        return 1;
+    }
+    write_json(f, results, levels, min_time_ms, repeat);
+    if (output)
+        fclose(f);
+    return 0;
+}
@@ -17,6 +17,8 @@
  *        source file.
  *        Dummy source will generate a color bars and keep moving to right side,
  *        FRAME_PER_LOOP defined the frame count in on loop.
+ *        Synthetic source will generate the scenes of moving gradients, noise
+ *        and text of the app synthetic input, with scene cuts.
  *
  * @author Cidana-Ryan
  *
@@ -24,10 +26,14 @@
 #ifndef _SVT_TEST_DUMMY_VIDEO_SOURCE_H_
 #define _SVT_TEST_DUMMY_VIDEO_SOURCE_H_
 #include "VideoSource.h"
+extern "C" {
+#include "app_input_synthetic.h"
+}
 
 namespace svt_av1_video_source {
 
 #define FRAME_PER_LOOP 300
+#define SYNTHETIC_SCENE_LENGTH 30
 
 static const uint8_t color_bar[3][8] = {
     {255, 173, 131, 115, 96, 83, 34, 0},   /**< luma */
@@ -172,5 +178,84 @@ class DummyVideoSource : public VideoSource {
   protected:
     uint8_t *single_line_pattern[3];
 };
+
+class SyntheticVideoSource : public VideoSource {
+  public:
+    SyntheticVideoSource(const VideoColorFormat format, const uint32_t width,
+                         const uint32_t height, const uint8_t bit_depth)
+        : VideoSource(format, width, height, bit_depth), synthetic_(nullptr) {
+        src_name_ = "Synthetic Source";
+    }
+
+    virtual ~SyntheticVideoSource() {
+        synthetic_source_destroy(synthetic_);
+    }
+
+    EbErrorType open_source(const uint32_t init_pos,
+                            const uint32_t frame_count) override {
+        cal_yuv_plane_param();
+        if (init_frame_buffer() != EB_ErrorNone)
+            return EB_ErrorInsufficientResources;
+        synthetic_ = synthetic_source_create(width_with_padding_,
+                                             height_with_padding_,
+                                             bit_depth_,
+                                             width_downsize_,
+                                             height_downsize_,
+                                             SYNTHETIC_SCENE_LENGTH);
+        if (synthetic_ == nullptr)
+            return EB_ErrorInsufficientResources;
+
+        init_pos_ = init_pos;
+        if (frame_count == 0)
+            frame_count_ = FRAME_PER_LOOP;
+        else
+            frame_count_ = frame_count;
+
+        current_frame_index_ = -1;
+        return EB_ErrorNone;
+    }
+
+    /*!\brief Close stream. */
+    void close_source() override {
+        synthetic_source_destroy(synthetic_);
+        synthetic_ = nullptr;
+        deinit_frame_buffer();
+    }
+
+    /*!\brief Get next frame. */
+    EbSvtIOFormat *get_next_frame() override {
+        if ((uint32_t)(current_frame_index_ + 1) >= frame_count_)
+            return nullptr;
+
+        // current_frame_index_ is start from -1, here plus 1 before generate
+        generate_frame(current_frame_index_ + 1 + init_pos_);
+        current_frame_index_++;
+        return frame_buffer_;
+    }
+
+    /*!\brief Get frame by index. */
+    EbSvtIOFormat *get_frame_by_index(const uint32_t index) override {
+        if (index >= frame_count_)
+            return nullptr;
+        generate_frame(index + init_pos_);
+        current_frame_index_ = index;
+        return frame_buffer_;
+    }
+
+  protected:
+    void generate_frame(const uint32_t index) {
+        synthetic_source_fill(synthetic_,
+                              index,
+                              frame_buffer_->luma,
+                              frame_buffer_->cb,
+                              frame_buffer_->cr,
+                              frame_buffer_->y_stride,
+                              frame_buffer_->cb_stride,
+                              frame_buffer_->cr_stride);
+    }
+
+  protected:
+    SyntheticSource *synthetic_;
+};
 }  // namespace svt_av1_video_source
 #endif  //_SVT_TEST_DUMMY_VIDEO_SOURCE_H_
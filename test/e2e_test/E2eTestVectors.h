@@ -41,7 +41,8 @@ namespace svt_av1_e2e_test_vector {
 typedef enum TestVectorFormat {
     YUV_VIDEO_FILE,
     Y4M_VIDEO_FILE,
-    DUMMY_SOURCE
+    DUMMY_SOURCE,
+    SYNTHETIC_SOURCE
 } TestVectorFormat;
 
 /** TestVideoVector is tuple of test params in a test case */
@@ -113,6 +114,18 @@ const std::vector<TestVideoVector> dummy_444_test_vectors = {
                     8, 0, 0, 100),
 };
 
+const std::vector<TestVideoVector> synthetic_test_vectors = {
+    std::make_tuple("synthetic_360p_8_420", SYNTHETIC_SOURCE, IMG_FMT_420, 640,
+                    360, 8, 0, 0, 120),
+    std::make_tuple("synthetic_360p_10_420", SYNTHETIC_SOURCE, IMG_FMT_420,
+                    640, 360, 10, 0, 0, 60),
+};
+
+const std::vector<TestVideoVector> synthetic_soak_test_vectors = {
+    std::make_tuple("synthetic_1080p_8_420", SYNTHETIC_SOURCE, IMG_FMT_420,
+                    1920, 1080, 8, 0, 0, 36000),
+};
+
 const std::vector<TestVideoVector> segment_test_vectors = {
     std::make_tuple("niklas_1280_720_30.y4m", Y4M_VIDEO_FILE, IMG_FMT_420, 1280,
                     720, 8, 0, 0, 0),
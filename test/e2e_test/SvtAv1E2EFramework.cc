@@ -64,6 +64,12 @@ VideoSource *SvtAv1E2ETestFramework::prepare_video_src(
                                          std::get<4>(vector),
                                          (uint8_t)std::get<5>(vector));
         break;
+    case SYNTHETIC_SOURCE:
+        video_src = new SyntheticVideoSource(std::get<2>(vector),
+                                             std::get<3>(vector),
+                                             std::get<4>(vector),
+                                             (uint8_t)std::get<5>(vector));
+        break;
     default: assert(0); break;
     }
     return video_src;
@@ -649,22 +655,34 @@ static void write_ivf_frame_header(
         fwrite(header, 1, IVF_FRAME_HEADER_SIZE, ivf->file);
 }
 
-void SvtAv1E2ETestFramework::write_compress_data(
-    const EbBufferHeaderType *output) {
-    write_ivf_frame_header(output_file_, output->n_filled_len);
-    fwrite(output->p_buffer, 1, output->n_filled_len, output_file_->file);
+void SvtAv1E2ETestFramework::write_compress_data(const uint8_t *data,
+                                                 const uint32_t size) {
+    write_ivf_frame_header(output_file_, size);
+    fwrite(data, 1, size, output_file_->file);
 }
 
 void SvtAv1E2ETestFramework::process_compress_data(
     const EbBufferHeaderType *data) {
     ASSERT_NE(data, nullptr);
-    if (refer_dec_ == nullptr) {
-        if (output_file_)
-            write_compress_data(data);
-        return;
+    const uint8_t *frame = data->p_buffer;
+    uint32_t size = data->n_filled_len;
+    // with tile group output, the frame is joined from its fragments
+    if (av1enc_ctx_.enc_params.tile_group_output) {
+        fragments_.insert(fragments_.end(),
+                          data->p_buffer,
+                          data->p_buffer + data->n_filled_len);
+        if (!(data->flags & EB_BUFFERFLAG_LAST_FRAGMENT))
+            return;
+        frame = fragments_.data();
+        size = (uint32_t)fragments_.size();
     }
 
-    decode_compress_data(data->p_buffer, data->n_filled_len);
+    if (refer_dec_ == nullptr) {
+        if (output_file_)
+            write_compress_data(frame, size);
+    } else
+        decode_compress_data(frame, size);
+    fragments_.clear();
 }
 
 void SvtAv1E2ETestFramework::decode_compress_data(const uint8_t *data,
@@ -144,10 +144,12 @@ class SvtAv1E2ETestFramework : public ::testing::TestWithParam<EncTestSetting> {
     /** write ivf header to output file */
     void write_output_header();
     /** write compressed data into file
-     * @param output  compressed data from encoder
+     * @param data  compressed frame from encoder
+     * @param size  size of compressed frame
      */
-    void write_compress_data(const EbBufferHeaderType *output);
-    /** process compressed data by write to file for send to decoder
+    void write_compress_data(const uint8_t *data, const uint32_t size);
+    /** process compressed data by write to file for send to decoder, the
+     * fragments of tile group output are joined into the frame first
      * @param data  compressed data from encoder
      */
     void process_compress_data(const EbBufferHeaderType *data);
@@ -173,6 +175,8 @@ class SvtAv1E2ETestFramework : public ::testing::TestWithParam<EncTestSetting> {
     RefDecoder *refer_dec_;    /**< reference decoder context */
     IvfFile *output_file_;     /**< file handle for save encoder output data */
     uint8_t obu_frame_header_size_; /**< size of obu frame header */
+    std::vector<uint8_t> fragments_; /**< fragments of the frame received so
+                                        far with tile group output */
     PerformanceCollect *collect_;   /**< performance and time collection*/
     VideoSource *psnr_src_;         /**< video source context for psnr */
     ICompareQueue *ref_compare_; /**< sink of reference to compare with recon*/
@@ -73,6 +73,37 @@ INSTANTIATE_TEST_SUITE_P(SvtAv1, CrashDeathTest,
                          ::testing::ValuesIn(generate_enc_mode_settings()),
                          EncTestSetting::GetSettingName);
 
+/**
+ * @brief SVT-AV1 encoder soak test: encode a long synthetic sequence of
+ * scenes with cuts and report the throughput
+ *
+ * Test strategy:
+ * Setup SVT-AV1 encoder with fast presets and encode the frames of the
+ * synthetic source, without reference decoder
+ *
+ * Expected result:
+ * No crash should occur and the throughput should stay stable along the
+ * sequence.
+ *
+ * Test coverage:
+ * Synthetic soak test vectors
+ */
+static const std::vector<EncTestSetting> soak_settings = {
+    {"SoakTest1", {{"EncoderMode", "10"}}, synthetic_soak_test_vectors},
+    {"SoakTest2",
+     {{"EncoderMode", "12"}, {"PredStructure", "1"}},
+     synthetic_soak_test_vectors},
+};
+
+class SoakTest : public CrashDeathTest {};
+
+TEST_P(SoakTest, DISABLED_SoakTest) {
+    run_death_test();
+}
+
+INSTANTIATE_TEST_SUITE_P(SvtAv1, SoakTest, ::testing::ValuesIn(soak_settings),
+                         EncTestSetting::GetSettingName);
+
 /**
  * @brief SVT-AV1 encoder E2E test with comparing the reconstructed frame with
  * output frame from decoder buffer list
@@ -168,6 +199,10 @@ static const std::vector<EncTestSetting> default_enc_settings = {
     {"TileTest2", {{"TileCol", "1"}}, default_test_vectors},
     {"TileTest3", {{"TileCol", "1"}, {"TileRow", "1"}}, default_test_vectors},
 
+    // test tile group output, the fragments are joined before decoding
+    {"TileGroupOutputTest1", {{"TileGroupOutput", "1"}, {"PredStructure", "1"}, {"TileCol", "1"}}, default_test_vectors},
+    {"TileGroupOutputTest2", {{"TileGroupOutput", "1"}, {"PredStructure", "1"}, {"TileCol", "1"}, {"TileRow", "1"}}, default_test_vectors},
+
     // Validate by setting a high bitrate and MinQpAllowed, push the encoder to producing
     // small partitions.
 
@@ -232,6 +267,8 @@ static const std::vector<EncTestSetting> default_enc_settings = {
 
     // test by using a dummy source of color bar
     {"DummySrcTest1", {{"EncoderMode", "8"}}, dummy_test_vectors},
+    // test by using the synthetic source of gradients, noise and text with scene cuts
+    {"SyntheticSrcTest1", {{"EncoderMode", "8"}}, synthetic_test_vectors},
 
     // only 420 input is supported
     //{"DummySrcTest2", {{"EncoderMode", "8"}, {"Profile", "2"}}, dummy_422_test_vectors},